@@ -1,7 +1,9 @@
 #pragma once
 
+#include <stddef.h>
 #include "App_InRangeCheck.h"
 #include "App_SharedExitCode.h"
+#include "configs/App_AccumulatorConfigs.h"
 
 struct Accumulator;
 
@@ -19,18 +21,9 @@ struct Accumulator;
  * @param get_average_cell_voltage A function that returns the average cell
  * voltage for the accumulator.
  * @param get_pack_voltage A function that returns the accumulator pack voltage.
- * @param get_segment_0_voltage A function that returns the voltage of the 0th
- * accumulator segment.
- * @param get_segment_1_voltage A function that returns the voltage of the 1st
- * accumulator segment.
- * @param get_segment_2_voltage A function that returns the voltage of the 2nd
- * accumulator segment.
- * @param get_segment_3_voltage A function that returns the voltage of the 3rd
- * accumulator segment.
- * @param get_segment_4_voltage A function that returns the voltage of the 4th
- * accumulator segment.
- * @param get_segment_5_voltage A function that returns the voltage of the 5th
- * accumulator segment.
+ * @param get_segment_voltage A function that returns the voltage of the given
+ * accumulator segment, which is called for every segment from 0 to
+ * NUM_OF_ACCUMULATOR_SEGMENTS - 1.
  *
  * @param min_cell_voltage The minimum cell voltage for the given accumulator.
  * @param max_cell_voltage The maximum cell voltage for the given accumulator.
@@ -52,12 +45,7 @@ struct Accumulator *App_Accumulator_Create(
     float (*get_max_cell_voltage)(void),
     float (*get_average_cell_voltage)(void),
     float (*get_pack_voltage)(void),
-    float (*get_segment_0_voltage)(void),
-    float (*get_segment_1_voltage)(void),
-    float (*get_segment_2_voltage)(void),
-    float (*get_segment_3_voltage)(void),
-    float (*get_segment_4_voltage)(void),
-    float (*get_segment_5_voltage)(void),
+    float (*get_segment_voltage)(size_t segment),
 
     float min_cell_voltage,
     float max_cell_voltage,
@@ -125,55 +113,14 @@ struct InRangeCheck *App_Accumulator_GetPackVoltageInRangeCheck(
     const struct Accumulator *accumulator);
 
 /**
- * Get the accumulator's 0th segment voltage in-range check.
- * @param accumulator The given accumulator to get the 0th segment voltage
- * in-range check.
- * @return The 0th segment voltage in-range check for the given accumulator.
- */
-struct InRangeCheck *App_Accumulator_GetSegment0VoltageInRangeCheck(
-    const struct Accumulator *accumulator);
-
-/**
- * Get the accumulator's 1st segment voltage in-range check.
- * @param accumulator The given accumulator to get the 1st segment voltage
- * in-range check.
- * @return The 1st segment voltage in-range check for the given accumulator.
- */
-struct InRangeCheck *App_Accumulator_GetSegment1VoltageInRangeCheck(
-    const struct Accumulator *accumulator);
-
-/**
- * Get the accumulator's 2nd segment voltage in-range check.
- * @param accumulator The given accumulator to get the 2nd segment voltage
- * in-range check.
- * @return The 2nd segment voltage in-range check for the given accumulator.
- */
-struct InRangeCheck *App_Accumulator_GetSegment2VoltageInRangeCheck(
-    const struct Accumulator *accumulator);
-
-/**
- * Get the accumulator's 3rd segment voltage in-range check.
- * @param accumulator The given accumulator to get the 3rd segment voltage
- * in-range check.
- * @return The 3rd segment voltage in-range check for the given accumulator.
- */
-struct InRangeCheck *App_Accumulator_GetSegment3VoltageInRangeCheck(
-    const struct Accumulator *accumulator);
-
-/**
- * Get the accumulator's 4th segment voltage in-range check.
- * @param accumulator The given accumulator to get the 4th segment voltage
- * in-range check.
- * @return The 4th segment voltage in-range check for the given accumulator.
- */
-struct InRangeCheck *App_Accumulator_GetSegment4VoltageInRangeCheck(
-    const struct Accumulator *accumulator);
-
-/**
- * Get the accumulator's 5th segment voltage in-range check.
- * @param accumulator The given accumulator to get the 5th segment voltage
- * in-range check.
- * @return The 5th segment voltage in-range check for the given accumulator.
+ * Get the accumulator's voltage in-range check for the given segment.
+ * @param accumulator The given accumulator to get the segment voltage in-range
+ * check.
+ * @param segment The segment to get the voltage in-range check for, which must
+ * be less than NUM_OF_ACCUMULATOR_SEGMENTS.
+ * @return The voltage in-range check for the given segment of the given
+ * accumulator.
  */
-struct InRangeCheck *App_Accumulator_GetSegment5VoltageInRangeCheck(
-    const struct Accumulator *accumulator);
+struct InRangeCheck *App_Accumulator_GetSegmentVoltageInRangeCheck(
+    const struct Accumulator *accumulator,
+    size_t                    segment);
@@ -1,51 +1,46 @@
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
+#include "App_CellStatistics.h"
+#include "App_SharedExitCode.h"
 
 /**
  * Initialize a set of functions used to calculate voltages for the accumulator.
- * @param get_cell_voltages A pointer to a 2D array containing raw cell voltages
- * measured from all cell monitors.
+ * @param read_raw_cell_voltages A function to read the latest raw cell voltages
+ * from all cell monitors into the 2D array given by get_raw_cell_voltages.
+ * @param get_raw_cell_voltages A function that returns a pointer to a 2D array
+ * containing raw cell voltages measured from all cell monitors.
  * @note The raw cell voltages are represented in 100µV. The raw voltages are
  * divided by 10000 to compute voltages in V.
  */
-void App_AccumulatorVoltages_Init(uint16_t *(*get_raw_cell_voltages)(size_t *));
+void App_AccumulatorVoltages_Init(
+    ExitCode (*read_raw_cell_voltages)(void),
+    uint16_t *(*get_raw_cell_voltages)(size_t *));
 
 /**
- * Get the average voltage for the 0th accumulator segment.
- * @return Get the average voltage for the 0th accumulator segment in V.
+ * Read the latest raw cell voltages, and compute their statistics once for
+ * every getter below.
+ * @return The exit code of reading the raw cell voltages. The statistics are
+ * only updated once raw cell voltages have been read back at least once.
  */
-float App_AccumulatorVoltages_GetSegment0Voltage(void);
+ExitCode App_AccumulatorVoltages_ReadCellVoltages(void);
 
 /**
- * Get the average voltage for the 1st accumulator segment.
- * @return Get the average voltage for the 1st accumulator segment in V.
+ * Get the statistics of the last raw cell voltages read, which include each
+ * cell's delta from the mean and the location of the minimum and maximum cells.
+ * @return The statistics of the last raw cell voltages read (100µV).
  */
-float App_AccumulatorVoltages_GetSegment1Voltage(void);
+const struct CellStatistics *App_AccumulatorVoltages_GetStatistics(void);
 
 /**
- * Get the average voltage for the 2nd accumulator segment.
- * @return Get the average voltage for the 2nd accumulator segment in V.
+ * Get the voltage of the given accumulator segment.
+ * @param segment The segment to get the voltage of, from 0 to
+ * NUM_OF_ACCUMULATOR_SEGMENTS - 1.
+ * @return The voltage of the given accumulator segment in V, or 0V if the
+ * segment isn't monitored by a cell monitoring chip.
  */
-float App_AccumulatorVoltages_GetSegment2Voltage(void);
-
-/**
- * Get the average voltage for the 3rd accumulator segment.
- * @return The average voltage of the 3rd accumulator segment in V.
- */
-float App_AccumulatorVoltages_GetSegment3Voltage(void);
-
-/**
- * Get the average voltage for the 4th accumulator segment.
- * @return The average voltage of the 4th accumulator segment in V.
- */
-float App_AccumulatorVoltages_GetSegment4Voltage(void);
-
-/**
- * Get the average voltage for the 5th accumulator segment.
- * @return The average voltage of the 5th accumulator segment in V.
- */
-float App_AccumulatorVoltages_GetSegment5Voltage(void);
+float App_AccumulatorVoltages_GetSegmentVoltage(size_t segment);
 
 /**
  * Get the pack voltage for the accumulator.
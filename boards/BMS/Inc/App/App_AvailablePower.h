@@ -0,0 +1,108 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "App_CellStatistics.h"
+#include "App_SharedExitCode.h"
+#include "configs/App_AvailablePowerConfigs.h"
+
+struct AvailablePower;
+
+/**
+ * Allocate and initialize the available power estimator of the accumulator. It
+ * estimates the internal resistance of every cell group incrementally, with one
+ * recursive least squares (RLS) step per cell group whenever the main current
+ * changes by at least MIN_RESISTANCE_ESTIMATION_CURRENT_STEP_A between two cell
+ * voltage reads. The open circuit voltage of every cell group is then backed
+ * out from its voltage and resistance, and the weakest cell group bounds the
+ * current the accumulator can discharge or regen without a cell group leaving
+ * MIN_CELL_VOLTAGE to MAX_CELL_VOLTAGE. That current is further derated by cell
+ * temperature and SoC, as set in configs/App_AvailablePowerConfigs.h.
+ * @param get_cell_statistics A function that returns the statistics of the last
+ * raw cell voltages read (100µV)
+ * @param get_main_current A function that returns the main current (A) sampled
+ * as the last raw cell voltages read were converted, which is positive when the
+ * accumulator is discharging
+ * @param read_cell_temperatures A function that reads the cell temperatures,
+ * returning EXIT_CODE_OK only if every cell temperature was read
+ * @param get_min_cell_temperature A function that returns the minimum cell
+ * temperature read (0.1°C)
+ * @param get_max_cell_temperature A function that returns the maximum cell
+ * temperature read (0.1°C)
+ * @return The created available power estimator, whose ownership is given to
+ * the caller
+ */
+struct AvailablePower *App_AvailablePower_Create(
+    const struct CellStatistics *(*get_cell_statistics)(void),
+    float (*get_main_current)(void),
+    ExitCode (*read_cell_temperatures)(void),
+    int32_t (*get_min_cell_temperature)(void),
+    int32_t (*get_max_cell_temperature)(void));
+
+/**
+ * Deallocate the memory used by the given available power estimator
+ * @param available_power The available power estimator to deallocate
+ */
+void App_AvailablePower_Destroy(struct AvailablePower *available_power);
+
+/**
+ * Update the resistance estimates of the given available power estimator with
+ * the cell voltages read this tick, and compute its power limits again
+ * @note This function must be called at 100Hz, after the cell voltages have
+ * been read for the tick
+ * @param available_power The available power estimator to tick
+ * @param has_read_cell_voltages Whether new cell voltages were read this tick.
+ * Nothing is updated without new cell voltages.
+ * @param soc The state of charge of the accumulator, in %
+ */
+void App_AvailablePower_Tick100Hz(
+    struct AvailablePower *available_power,
+    bool                   has_read_cell_voltages,
+    float                  soc);
+
+/**
+ * Get the estimated internal resistance of the given cell group
+ * @param available_power The available power estimator to get the estimate from
+ * @param segment The segment of the cell group
+ * @param cell The cell group in the segment, starting from the bottom of the
+ * segment
+ * @return The estimated internal resistance of the cell group, in ohms
+ */
+float App_AvailablePower_GetCellResistance(
+    const struct AvailablePower *available_power,
+    size_t                       segment,
+    size_t                       cell);
+
+/**
+ * Get the power the accumulator can discharge continuously
+ * @param available_power The available power estimator to get the limit from
+ * @return The continuous discharge power limit, in W
+ */
+float App_AvailablePower_GetContinuousDischargePower(
+    const struct AvailablePower *available_power);
+
+/**
+ * Get the power the accumulator can discharge for PULSE_POWER_DURATION_S
+ * @param available_power The available power estimator to get the limit from
+ * @return The pulse discharge power limit, in W
+ */
+float App_AvailablePower_GetPulseDischargePower(
+    const struct AvailablePower *available_power);
+
+/**
+ * Get the power the accumulator can be charged with continuously by regen
+ * @param available_power The available power estimator to get the limit from
+ * @return The continuous regen power limit, in W
+ */
+float App_AvailablePower_GetContinuousRegenPower(
+    const struct AvailablePower *available_power);
+
+/**
+ * Get the power the accumulator can be charged with by regen for
+ * PULSE_POWER_DURATION_S
+ * @param available_power The available power estimator to get the limit from
+ * @return The pulse regen power limit, in W
+ */
+float App_AvailablePower_GetPulseRegenPower(
+    const struct AvailablePower *available_power);
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <stdbool.h>
+
+// The sensor values sampled once at the start of a tick, so every reader
+// during that tick sees the same values
+struct BmsSensorSnapshot
+{
+    bool is_air_negative_closed;
+    bool is_air_positive_closed;
+    bool is_bms_ok_enabled;
+    bool is_imd_ok_enabled;
+    bool is_bspd_ok_enabled;
+    bool is_charger_connected;
+};
@@ -9,10 +9,16 @@
 #include "App_OkStatus.h"
 #include "App_Accumulator.h"
 #include "App_CellMonitors.h"
+#include "App_CellBalancing.h"
+#include "App_SocEstimator.h"
+#include "App_CellDiagnostics.h"
+#include "App_AvailablePower.h"
 #include "App_Airs.h"
 #include "App_PreChargeSequence.h"
 #include "App_SharedErrorTable.h"
 #include "App_SharedClock.h"
+#include "App_SharedSensorSnapshot.h"
+#include "App_BmsSensorSnapshot.h"
 
 struct BmsWorld;
 
@@ -37,6 +43,10 @@ struct BmsWorld *App_BmsWorld_Create(
     struct OkStatus *         bspd_ok,
     struct Accumulator *      accumulator,
     struct CellMonitors *     cell_monitors,
+    struct CellBalancing *    cell_balancing,
+    struct SocEstimator *     soc_estimator,
+    struct CellDiagnostics *  cell_diagnostics,
+    struct AvailablePower *   available_power,
     struct Airs *             airs,
     struct PreChargeSequence *pre_charge_sequence,
     struct ErrorTable *       error_table,
@@ -127,6 +137,37 @@ struct Accumulator *App_BmsWorld_GetAccumulator(const struct BmsWorld *world);
  */
 struct CellMonitors *App_BmsWorld_GetCellMonitors(const struct BmsWorld *world);
 
+/**
+ * Get the cell balancing scheduler for the given world
+ * @param world The world to get the cell balancing scheduler for
+ * @return The cell balancing scheduler for the given world
+ */
+struct CellBalancing *
+    App_BmsWorld_GetCellBalancing(const struct BmsWorld *world);
+
+/**
+ * Get the state of charge estimator for the given world
+ * @param world The world to get the state of charge estimator for
+ * @return The state of charge estimator for the given world
+ */
+struct SocEstimator *App_BmsWorld_GetSocEstimator(const struct BmsWorld *world);
+
+/**
+ * Get the cell diagnostics for the given world
+ * @param world The world to get the cell diagnostics for
+ * @return The cell diagnostics for the given world
+ */
+struct CellDiagnostics *
+    App_BmsWorld_GetCellDiagnostics(const struct BmsWorld *world);
+
+/**
+ * Get the available power estimator for the given world
+ * @param world The world to get the available power estimator for
+ * @return The available power estimator for the given world
+ */
+struct AvailablePower *
+    App_BmsWorld_GetAvailablePower(const struct BmsWorld *world);
+
 /**
  * Get the AIRs for the given world
  * @param world The world to get the AIRs for
@@ -155,3 +196,18 @@ struct ErrorTable *App_BmsWorld_GetErrorTable(const struct BmsWorld *world);
  * @return The clock for the given world
  */
 struct Clock *App_BmsWorld_GetClock(const struct BmsWorld *world);
+
+/**
+ * Sample the 100Hz sensor snapshot for the given world
+ * @note This should be called at the start of every 100Hz tick
+ * @param world The world to sample the 100Hz sensor snapshot for
+ */
+void App_BmsWorld_SampleSensors100Hz(const struct BmsWorld *world);
+
+/**
+ * Get the sensor snapshot sampled at the start of the current 100Hz tick
+ * @param world The world to get the 100Hz sensor snapshot for
+ * @return The 100Hz sensor snapshot for the given world
+ */
+const struct BmsSensorSnapshot *
+    App_BmsWorld_GetSensorSnapshot100Hz(const struct BmsWorld *world);
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "App_CellStatistics.h"
+#include "App_SharedExitCode.h"
+#include "configs/App_AccumulatorConfigs.h"
+#include "configs/App_CellBalancingConfigs.h"
+
+struct CellBalancing;
+
+/**
+ * Allocate and initialize a passive cell balancing scheduler, which discharges
+ * the cells that are above the minimum cell voltage through the discharge
+ * switches of the cell monitors. Cells only discharge for part of every
+ * balancing period, so the cell voltages used to pick the cells to discharge
+ * are read while every discharge switch is off.
+ * @param write_discharge_cells A function that turns on the discharge switches
+ * of the given cells and turns off every other discharge switch. It is given
+ * NUM_OF_CELL_MONITOR_CHIPS bitmasks, where bit n of each bitmask is the nth
+ * cell of that chip's segment.
+ * @param get_cell_statistics A function that returns the statistics of the last
+ * raw cell voltages read (100µV)
+ * @param get_max_die_temp A function that returns the current maximum internal
+ * die temperature (°C) out of all the cell monitors
+ * @param balancing_threshold Cells are discharged while they are more than this
+ * far above the minimum cell voltage (100µV)
+ * @param die_temp_to_throttle_degc The die temperature (°C) above which the
+ * time spent discharging in every balancing period is reduced linearly
+ * @param die_temp_to_re_enable_degc The die temperature (°C) to re-enable cell
+ * balancing, after it was disabled
+ * @param die_temp_to_disable_degc The die temperature (°C) to disable cell
+ * balancing
+ * @return The created cell balancing scheduler, whose ownership is given to the
+ * caller
+ */
+struct CellBalancing *App_CellBalancing_Create(
+    ExitCode (*write_discharge_cells)(const uint32_t *discharge_cells),
+    const struct CellStatistics *(*get_cell_statistics)(void),
+    float (*get_max_die_temp)(void),
+    uint16_t balancing_threshold,
+    float    die_temp_to_throttle_degc,
+    float    die_temp_to_re_enable_degc,
+    float    die_temp_to_disable_degc);
+
+/**
+ * Deallocate the memory used by the given cell balancing scheduler
+ * @param cell_balancing The cell balancing scheduler to deallocate
+ */
+void App_CellBalancing_Destroy(struct CellBalancing *cell_balancing);
+
+/**
+ * Advance the given cell balancing scheduler by one tick. The cells to
+ * discharge are picked at the start of every balancing period from the last
+ * cell voltages read, and every discharge switch is turned off once the
+ * discharge time of the period has elapsed. A balancing period only starts once
+ * the cell voltages read are settled.
+ * @note This function must be called at 100Hz, after the cell voltages have
+ * been read for the tick
+ * @param cell_balancing The cell balancing scheduler to tick
+ * @param current_ms The current time, in milliseconds
+ */
+void App_CellBalancing_Tick100Hz(
+    struct CellBalancing *cell_balancing,
+    uint32_t              current_ms);
+
+/**
+ * Turn off every discharge switch and restart the given cell balancing
+ * scheduler from the start of a balancing period
+ * @param cell_balancing The cell balancing scheduler to stop
+ * @param current_ms The current time, in milliseconds
+ */
+void App_CellBalancing_Stop(
+    struct CellBalancing *cell_balancing,
+    uint32_t              current_ms);
+
+/**
+ * Check whether the cell voltages read are settled, which is when no cell is
+ * discharging and the cell voltages have had time to recover since the last
+ * cell stopped discharging. Only settled cell voltages can be used to estimate
+ * the state of the cells.
+ * @param cell_balancing The cell balancing scheduler to check
+ * @param current_ms The current time, in milliseconds
+ * @return true if the cell voltages read are settled, false otherwise
+ */
+bool App_CellBalancing_CanReadCellVoltages(
+    const struct CellBalancing *cell_balancing,
+    uint32_t                    current_ms);
+
+/**
+ * Get the maximum cell voltage of the last cell voltages read, where the cells
+ * that are discharging or recovering from discharging are raised by
+ * BALANCING_DISCHARGE_VOLTAGE_DROP_100UV. This is never below the open-circuit
+ * voltage of any cell, so it can be checked against the maximum cell voltage
+ * while cells discharge.
+ * @param cell_balancing The cell balancing scheduler to get the maximum cell
+ * voltage from
+ * @param current_ms The current time, in milliseconds
+ * @return The compensated maximum cell voltage (100µV)
+ */
+uint32_t App_CellBalancing_GetCompensatedMaxCellVoltage(
+    const struct CellBalancing *cell_balancing,
+    uint32_t                    current_ms);
+
+/**
+ * Get the cells picked to discharge in the current balancing period
+ * @param cell_balancing The cell balancing scheduler to get the cells from
+ * @return NUM_OF_CELL_MONITOR_CHIPS bitmasks, where bit n of each bitmask is
+ * the nth cell of that chip's segment
+ */
+const uint32_t *App_CellBalancing_GetDischargeCells(
+    const struct CellBalancing *cell_balancing);
+
+/**
+ * Get the number of ticks the picked cells discharge for in the current
+ * balancing period, which is reduced as the die temperature rises
+ * @param cell_balancing The cell balancing scheduler to get the number of ticks
+ * from
+ * @return The number of ticks the picked cells discharge for, up to
+ * MAX_BALANCING_DISCHARGE_TICKS
+ */
+uint32_t App_CellBalancing_GetDischargeTicks(
+    const struct CellBalancing *cell_balancing);
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "App_SharedExitCode.h"
+#include "configs/App_AccumulatorConfigs.h"
+#include "configs/App_CellDiagnosticsConfigs.h"
+
+// The diagnostic conversions of the cell monitors. Each of them is read back
+// into the cell voltage registers of every chip.
+enum CellDiagnostic
+{
+    // Cell voltages converted with the open wire pull-up current on every pin
+    CELL_DIAGNOSTIC_OPEN_WIRE_PULL_UP,
+    // Cell voltages converted with the open wire pull-down current on every pin
+    CELL_DIAGNOSTIC_OPEN_WIRE_PULL_DOWN,
+    // Cell 7 converted by ADC 1 and ADC 2 into the registers of cells 7 and 8,
+    // and cell 13 converted by ADC 2 and ADC 3 into those of cells 13 and 14
+    CELL_DIAGNOSTIC_ADC_OVERLAP,
+    NUM_OF_CELL_DIAGNOSTICS,
+};
+
+enum CellDiagnosticStatus
+{
+    // Not every diagnostic of the cell has been evaluated yet
+    CELL_DIAGNOSTIC_STATUS_UNTESTED,
+    CELL_DIAGNOSTIC_STATUS_OK,
+    // One of the two wires that sense the cell is open
+    CELL_DIAGNOSTIC_STATUS_OPEN_WIRE,
+    // The ADCs of the cell's monitor disagree, so none of its cell voltages can
+    // be trusted
+    CELL_DIAGNOSTIC_STATUS_ADC_MISMATCH,
+    NUM_OF_CELL_DIAGNOSTIC_STATUSES,
+};
+
+struct CellDiagnostics;
+
+/**
+ * Allocate and initialize the cell diagnostics, which accumulate the results of
+ * the open wire and ADC overlap conversions that the cell monitors run in the
+ * background into a diagnostic status for every cell
+ * @param read_diagnostic A function that reads the raw cell voltage registers
+ * (100µV) of the latest result of the given diagnostic into
+ * NUM_OF_CELL_MONITOR_CHIPS rows of NUM_OF_CELLS_PER_SEGMENT registers. It
+ * returns EXIT_CODE_OK if there is a result that wasn't read yet, else
+ * EXIT_CODE_TIMEOUT.
+ * @param open_wire_threshold A wire is open when the cell above it reads more
+ * than this much lower (100µV) with the pull-up current than with the
+ * pull-down current
+ * @param adc_overlap_threshold The maximum difference (100µV) between two ADCs
+ * converting the same cell
+ * @param num_consecutive_results The number of consecutive evaluations that
+ * must agree to set or clear a diagnostic status
+ * @return The created cell diagnostics, whose ownership is given to the caller
+ */
+struct CellDiagnostics *App_CellDiagnostics_Create(
+    ExitCode (*read_diagnostic)(
+        enum CellDiagnostic diagnostic,
+        uint16_t (*voltages)[NUM_OF_CELLS_PER_SEGMENT]),
+    uint16_t open_wire_threshold,
+    uint16_t adc_overlap_threshold,
+    uint32_t num_consecutive_results);
+
+/**
+ * Deallocate the memory used by the given cell diagnostics
+ * @param cell_diagnostics The cell diagnostics to deallocate
+ */
+void App_CellDiagnostics_Destroy(struct CellDiagnostics *cell_diagnostics);
+
+/**
+ * Read the diagnostic results that arrived since the last tick, and evaluate
+ * them once a pull-up and a pull-down result, or an overlap result, are
+ * available
+ * @note This function must be called at 100Hz
+ * @param cell_diagnostics The cell diagnostics to tick
+ * @param can_evaluate Whether the cell voltages can be read, which is false
+ * while cells are discharging. Results read while this is false are dropped.
+ */
+void App_CellDiagnostics_Tick100Hz(
+    struct CellDiagnostics *cell_diagnostics,
+    bool                    can_evaluate);
+
+/**
+ * Get the diagnostic status of the given cell
+ * @param cell_diagnostics The cell diagnostics to get the status from
+ * @param segment The segment of the cell
+ * @param cell The cell in the segment, starting from the bottom of the segment
+ * @return The diagnostic status of the cell
+ */
+enum CellDiagnosticStatus App_CellDiagnostics_GetCellStatus(
+    const struct CellDiagnostics *cell_diagnostics,
+    size_t                        segment,
+    size_t                        cell);
+
+/**
+ * Get the number of cells with the given diagnostic status
+ * @param cell_diagnostics The cell diagnostics to count the cells of
+ * @param status The diagnostic status to count
+ * @return The number of cells with the given diagnostic status
+ */
+uint32_t App_CellDiagnostics_GetNumOfCellsWithStatus(
+    const struct CellDiagnostics *cell_diagnostics,
+    enum CellDiagnosticStatus     status);
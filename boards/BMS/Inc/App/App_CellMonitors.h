@@ -1,6 +1,9 @@
 #pragma once
 
+#include <stddef.h>
+#include "App_InRangeCheck.h"
 #include "App_SharedExitCode.h"
+#include "configs/App_AccumulatorConfigs.h"
 
 struct CellMonitors;
 
@@ -29,18 +32,9 @@ enum ITMPInRangeCheck
  * Allocate and initialize a group of cell monitors
  * @param read_die_temps A function that can be called to read internal
  * die temperatures (°C) from all cell monitors
- * @param get_monitor_0_die_temp A function that returns the internal die
- * temperature (°C) for the 0th cell monitor
- * @param get_monitor_1_die_temp A function that returns the internal die
- * temperature (°C) for the 1st cell monitor
- * @param get_monitor_2_die_temp A function that returns the internal die
- * temperature (°C) for the 2nd cell monitor
- * @param get_monitor_3_die_temp A function that returns the internal die
- * temperature (°C) for the 3rd cell monitor
- * @param get_monitor_4_die_temp A function that returns the internal die
- * temperature (°C) for the 4th cell monitor
- * @param get_monitor_5_die_temp A function that returns the internal die
- * temperature (°C) for the 5th cell monitor
+ * @param get_die_temp A function that returns the internal die temperature
+ * (°C) of the given cell monitor, which is called for every cell monitor from 0
+ * to NUM_OF_CELL_MONITOR_CHIPS - 1
  * @param get_max_die_temp A function that returns the current maximum internal
  * die temperature (°C) out of all the cell monitors
  * @param min_die_temp_degc The minimum die temperature (°C) threshold for the
@@ -60,12 +54,7 @@ enum ITMPInRangeCheck
  */
 struct CellMonitors *App_CellMonitors_Create(
     ExitCode (*read_die_temps)(void),
-    float (*get_monitor_0_die_temp)(void),
-    float (*get_monitor_1_die_temp)(void),
-    float (*get_monitor_2_die_temp)(void),
-    float (*get_monitor_3_die_temp)(void),
-    float (*get_monitor_4_die_temp)(void),
-    float (*get_monitor_5_die_temp)(void),
+    float (*get_die_temp)(size_t chip),
     float (*get_max_die_temp)(void),
     float min_die_temp_degc,
     float max_die_temp_degc,
@@ -91,64 +80,17 @@ ExitCode
     App_CellMonitors_ReadDieTemps(const struct CellMonitors *cell_monitors);
 
 /**
- * Get the cell monitor 0 die temp in-range check from the group of cell
- * monitors
- * @param cell_monitors The given group of cell monitors to get the cell monitor
- * 0 die temp in-range check from
- * @return The cell monitor 0 die temp in-range check
+ * Get the die temp in-range check of the given cell monitor from the group of
+ * cell monitors
+ * @param cell_monitors The given group of cell monitors to get the die temp
+ * in-range check from
+ * @param chip The cell monitor to get the die temp in-range check for, which
+ * must be less than NUM_OF_CELL_MONITOR_CHIPS
+ * @return The die temp in-range check of the given cell monitor
  */
-struct InRangeCheck *App_CellMonitors_GetCellMonitor0DieTempInRangeCheck(
-    const struct CellMonitors *cell_monitors);
-
-/**
- * Get the cell monitor 1 die temp in-range check from the group of cell
- * monitors
- * @param cell_monitors The given group of cell monitors to get the cell monitor
- * 1 die temp in-range check from
- * @return The cell monitor 1 die temp in-range check
- */
-struct InRangeCheck *App_CellMonitors_GetCellMonitor1DieTempInRangeCheck(
-    const struct CellMonitors *cell_monitors);
-
-/**
- * Get the cell monitor 2 die temp in-range check from the group of cell
- * monitors
- * @param cell_monitors The given group of cell monitors to get the cell monitor
- * 2 die temp in-range check from.
- * @return The cell monitor 2 die temp in-range check
- */
-struct InRangeCheck *App_CellMonitors_GetCellMonitor2DieTempInRangeCheck(
-    const struct CellMonitors *cell_monitors);
-
-/**
- * Get the cell monitor 3 die temp in-range check from the group of cell
- * monitors
- * @param cell_monitors The given group of cell monitors to get the cell monitor
- * 3 die temp in-range check from
- * @return The cell monitor 3 die temp in-range check
- */
-struct InRangeCheck *App_CellMonitors_GetCellMonitor3DieTempInRangeCheck(
-    const struct CellMonitors *cell_monitors);
-
-/**
- * Get the cell monitor 4 die temp in-range check from the group of cell
- * monitors
- * @param cell_monitors The given group of cell monitors to get the cell monitor
- * 4 die temp in-range check from
- * @return The cell monitor 4 die temp in-range check
- */
-struct InRangeCheck *App_CellMonitors_GetCellMonitor4DieTempInRangeCheck(
-    const struct CellMonitors *cell_monitors);
-
-/**
- * Get the cell monitor 5 die temp in-range check from the group of cell
- * monitors
- * @param cell_monitors The given group of cell monitors to get the cell monitor
- * 5 die temp in-range check from
- * @return The cell monitor 5 die temp in-range check
- */
-struct InRangeCheck *App_CellMonitors_GetCellMonitor5DieTempInRangeCheck(
-    const struct CellMonitors *cell_monitors);
+struct InRangeCheck *App_CellMonitors_GetDieTempInRangeCheck(
+    const struct CellMonitors *cell_monitors,
+    size_t                     chip);
 
 /**
  * Get the current maximum die temperature from the group of cell monitors.
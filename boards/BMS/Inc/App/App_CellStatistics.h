@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "configs/App_AccumulatorConfigs.h"
+
+struct CellLocation
+{
+    size_t segment;
+    size_t cell;
+};
+
+struct CellStatistics
+{
+    // The minimum and maximum cell values, and the first cell each was seen at
+    uint16_t            min;
+    struct CellLocation min_location;
+    uint16_t            max;
+    struct CellLocation max_location;
+
+    // The difference between the maximum and minimum cell values
+    uint16_t spread;
+
+    // The sum of every cell value, and of the cell values of each segment
+    uint32_t sum;
+    uint32_t segment_sums[NUM_OF_CELL_MONITOR_CHIPS];
+
+    // The mean cell value, rounded to the nearest integer, and the difference
+    // between each cell value and the mean
+    uint16_t mean;
+    int32_t  deltas_from_mean[NUM_OF_CELL_MONITOR_CHIPS]
+                            [NUM_OF_CELLS_PER_SEGMENT];
+};
+
+/**
+ * Compute the statistics of the given cell values in one pass over the cells,
+ * so every consumer can read them from the returned statistics rather than
+ * walking the cells again
+ * @param cells The value of every cell, indexed by segment and then by cell
+ * @param statistics This will be set to the statistics of the given cells
+ */
+void App_CellStatistics_Compute(
+    const uint16_t cells[NUM_OF_CELL_MONITOR_CHIPS][NUM_OF_CELLS_PER_SEGMENT],
+    struct CellStatistics *statistics);
@@ -0,0 +1,28 @@
+#pragma once
+
+/**
+ * Get the open circuit voltage of a cell at the given state of charge (SoC),
+ * interpolated from the cell's open circuit voltage curve
+ * @param soc The SoC to get the open circuit voltage at, in %. It is clamped
+ * to between 0% and 100%.
+ * @return The open circuit voltage of a cell at the given SoC, in V
+ */
+float App_OpenCircuitVoltage_GetCellVoltage(float soc);
+
+/**
+ * Get the slope of the open circuit voltage curve of a cell at the given state
+ * of charge (SoC)
+ * @param soc The SoC to get the slope at, in %. It is clamped to between 0%
+ * and 100%.
+ * @return The slope of the open circuit voltage curve at the given SoC, in V/%
+ */
+float App_OpenCircuitVoltage_GetSlope(float soc);
+
+/**
+ * Get the state of charge (SoC) of a cell at rest from its open circuit
+ * voltage, interpolated from the cell's open circuit voltage curve
+ * @param cell_voltage The open circuit voltage of the cell, in V. It is
+ * clamped to the voltages at 0% and 100% SoC.
+ * @return The SoC of the cell, in %
+ */
+float App_OpenCircuitVoltage_GetSoc(float cell_voltage);
@@ -1,21 +1,58 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdlib.h>
+#include "configs/App_PreChargeSequenceConfigs.h"
 
 struct PreChargeSequence;
 
+enum PreChargeSequenceStatus
+{
+    // The tractive system is still charging
+    PRE_CHARGE_SEQUENCE_IN_PROGRESS,
+    // The tractive system has charged along a plausible charging curve, so
+    // AIR+ may be closed
+    PRE_CHARGE_SEQUENCE_COMPLETE,
+    // The tractive system was still charged when the sequence was enabled,
+    // such as when the AIRs are closed again shortly after opening, so AIR+
+    // may be closed
+    PRE_CHARGE_SEQUENCE_ALREADY_CHARGED,
+    // The tractive system charged faster than the precharge resistor allows
+    PRE_CHARGE_SEQUENCE_TIME_CONSTANT_TOO_SHORT,
+    // The tractive system charged slower than the precharge resistor allows,
+    // or didn't charge at all
+    PRE_CHARGE_SEQUENCE_TIME_CONSTANT_TOO_LONG,
+};
+
 /**
- * Allocate and initialize a pre-charge sequence
+ * Allocate and initialize a pre-charge sequence. Instead of waiting a fixed
+ * time, it fits the RC charging curve of the tractive system voltage sample by
+ * sample, and completes as soon as the tractive system voltage reaches
+ * PRE_CHARGE_COMPLETE_VOLTAGE_RATIO of the pack voltage along a curve whose
+ * time constant is plausible. It fails as soon as the fitted time constant is
+ * outside MIN_PRE_CHARGE_TIME_CONSTANT_S to MAX_PRE_CHARGE_TIME_CONSTANT_S. If
+ * the first samples are already above that fraction of the pack voltage, which
+ * is before the precharge relay can have closed, it completes without a fit.
  * @param enable_pre_charge_sequence A function that can be called to enable
  * the pre-charge sequence
  * @param disable_pre_charge_sequence A function that can be called to disable
  * the pre-charge sequence
+ * @param read_tractive_system_voltages A function that copies the tractive
+ * system voltages (V) sampled since it was last called into the given buffer,
+ * oldest first, and returns the number of voltages copied. It copies at most
+ * the given number of voltages.
+ * @param get_pack_voltage A function that returns the pack voltage (V)
+ * @param sample_frequency_hz The frequency the tractive system voltage is
+ * sampled at, in Hz
  * @return The created pre-charge sequence, whose ownership is given to the
  * caller
  */
 struct PreChargeSequence *App_PreChargeSequence_Create(
     void (*enable_pre_charge_sequence)(void),
-    void (*disable_pre_charge_sequence)(void));
+    void (*disable_pre_charge_sequence)(void),
+    size_t (*read_tractive_system_voltages)(float *, size_t),
+    float (*get_pack_voltage)(void),
+    float sample_frequency_hz);
 
 /**
  * Deallocate the memory used by the pre-charge sequence
@@ -25,11 +62,12 @@ void App_PreChargeSequence_Destroy(
     struct PreChargeSequence *pre_charge_sequence);
 
 /**
- * Enable the given pre-charge sequence
+ * Enable the given pre-charge sequence, and start fitting the charging curve
+ * from the next tractive system voltage sampled
  * @param pre_charge_sequence The pre-charge sequence to enable
  */
 void App_PreChargeSequence_Enable(
-    const struct PreChargeSequence *pre_charge_sequence);
+    struct PreChargeSequence *pre_charge_sequence);
 
 /**
  * Disable the given pre-charge sequence
@@ -37,3 +75,26 @@ void App_PreChargeSequence_Enable(
  */
 void App_PreChargeSequence_Disable(
     const struct PreChargeSequence *pre_charge_sequence);
+
+/**
+ * Fit the charging curve of the given pre-charge sequence on the tractive
+ * system voltages sampled since the last tick
+ * @note This function must be called at 100Hz while the pre-charge sequence is
+ *       enabled. Once it stops returning PRE_CHARGE_SEQUENCE_IN_PROGRESS, it
+ *       keeps returning the same status until the sequence is enabled again.
+ * @param pre_charge_sequence The pre-charge sequence to tick
+ * @return The status of the given pre-charge sequence
+ */
+enum PreChargeSequenceStatus App_PreChargeSequence_Tick100Hz(
+    struct PreChargeSequence *pre_charge_sequence);
+
+/**
+ * Get the time constant fitted on the charging curve of the given pre-charge
+ * sequence
+ * @param pre_charge_sequence The pre-charge sequence to get the time constant
+ * from
+ * @return The fitted time constant in s, or NAN until the charging curve has
+ * been fitted on MIN_NUM_OF_PRE_CHARGE_FIT_SAMPLES samples
+ */
+float App_PreChargeSequence_GetTimeConstant(
+    const struct PreChargeSequence *pre_charge_sequence);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "App_BmsWorld.h"
+#include "App_SharedStateMachine.h"
 
 void App_SetPeriodicCanSignals_Imd(
     struct BmsCanTxInterface *can_tx,
@@ -9,8 +10,22 @@ void App_SetPeriodicCanSignals_Imd(
 void App_SetPeriodicSignals_AccumulatorInRangeChecks(
     struct BmsCanTxInterface *can_tx,
     const struct Accumulator *accumulator,
-    struct ErrorTable *       error_table);
+    struct ErrorTable *       error_table,
+    size_t                    segment_to_send);
 
 void App_SetPeriodicSignals_CellMonitorsInRangeChecks(
     struct BmsCanTxInterface * can_tx,
-    const struct CellMonitors *cell_monitors);
+    const struct CellMonitors *cell_monitors,
+    size_t                     chip_to_send);
+
+void App_SetPeriodicCanSignals_StateMachineTrace(
+    struct BmsCanTxInterface * can_tx,
+    const struct StateMachine *state_machine);
+
+void App_SetPeriodicCanSignals_CellDiagnostics(
+    struct BmsCanTxInterface *    can_tx,
+    const struct CellDiagnostics *cell_diagnostics);
+
+void App_SetPeriodicCanSignals_AvailablePower(
+    struct BmsCanTxInterface *   can_tx,
+    const struct AvailablePower *available_power);
@@ -0,0 +1,74 @@
+#pragma once
+
+struct SocEkf;
+
+/**
+ * Allocate and initialize an extended Kalman filter (EKF) that estimates the
+ * state of charge (SoC) of a cell group from its current and voltage. The cell
+ * group is modelled as its open circuit voltage in series with a resistance
+ * and one RC pair, and the filter's states are the SoC and the voltage across
+ * the RC pair. Every step is a fixed number of single-precision operations.
+ * @param capacity_ah The capacity of the cell group, in Ah
+ * @param series_resistance_ohms The series resistance of the cell group, in
+ * ohms
+ * @param polarization_resistance_ohms The resistance of the RC pair, in ohms
+ * @param polarization_capacitance_f The capacitance of the RC pair, in F
+ * @param period_s The time between two predictions, in s
+ * @param soc_process_noise The process noise of the SoC per prediction, in %^2
+ * @param polarization_process_noise The process noise of the voltage across the
+ * RC pair per prediction, in V^2
+ * @param measurement_noise The noise of the cell group's voltage measurement,
+ * in V^2
+ * @param initial_soc_variance The variance of the SoC the filter is set to, in
+ * %^2
+ * @return The created EKF, whose ownership is given to the caller
+ */
+struct SocEkf *App_SocEkf_Create(
+    float capacity_ah,
+    float series_resistance_ohms,
+    float polarization_resistance_ohms,
+    float polarization_capacitance_f,
+    float period_s,
+    float soc_process_noise,
+    float polarization_process_noise,
+    float measurement_noise,
+    float initial_soc_variance);
+
+/**
+ * Deallocate the memory used by the given EKF
+ * @param soc_ekf The EKF to deallocate
+ */
+void App_SocEkf_Destroy(struct SocEkf *soc_ekf);
+
+/**
+ * Set the SoC of the given EKF, with the cell group at rest and the initial
+ * SoC variance
+ * @param soc_ekf The EKF to set the SoC of
+ * @param soc The SoC to set, in %
+ */
+void App_SocEkf_SetSoc(struct SocEkf *soc_ekf, float soc);
+
+/**
+ * Advance the given EKF by one period with the given current
+ * @param soc_ekf The EKF to advance
+ * @param current_a The mean current out of the cell group over the period, in
+ * A. It is positive when the cell group is discharging.
+ */
+void App_SocEkf_Predict(struct SocEkf *soc_ekf, float current_a);
+
+/**
+ * Correct the SoC of the given EKF with a measurement of the cell group's
+ * voltage
+ * @param soc_ekf The EKF to correct
+ * @param current_a The current out of the cell group when its voltage was
+ * measured, in A. It is positive when the cell group is discharging.
+ * @param voltage The measured voltage of the cell group, in V
+ */
+void App_SocEkf_Correct(struct SocEkf *soc_ekf, float current_a, float voltage);
+
+/**
+ * Get the SoC estimated by the given EKF
+ * @param soc_ekf The EKF to get the SoC from
+ * @return The SoC estimated by the given EKF, in %, from 0% to 100%
+ */
+float App_SocEkf_GetSoc(const struct SocEkf *soc_ekf);
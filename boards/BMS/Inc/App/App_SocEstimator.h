@@ -0,0 +1,108 @@
+#pragma once
+
+#include <stdbool.h>
+#include "App_CellStatistics.h"
+#include "App_SharedExitCode.h"
+#include "configs/App_SocConfigs.h"
+
+struct SocEstimator;
+
+/**
+ * Allocate and initialize a state of charge (SoC) estimator for the
+ * accumulator, which votes between three independent SoC estimates using
+ * App_Soc_Vote():
+ *
+ *   1. Coulomb counting, which integrates the main current sampled at the
+ *      ADC's rate
+ *   2. An EKF on the mean cell voltage and the main current
+ *   3. An open circuit voltage (OCV) lookup of the mean cell voltage, which is
+ *      only updated while the accumulator is at rest. Coulomb counting is
+ *      re-anchored to it every time it is updated, to cancel out drift.
+ *
+ * The estimates start from the SoC persisted before the last power cycle, or
+ * from the OCV lookup if no SoC was persisted or if the persisted SoC disagrees
+ * with the OCV lookup. The cell groups and the EKF are
+ * modelled with the parameters in configs/App_SocConfigs.h.
+ * @param get_and_clear_charge A function that returns the charge that flowed
+ * out of the accumulator since it was last called, in C, and starts
+ * integrating the main current again from zero
+ * @param get_cell_statistics A function that returns the statistics of the last
+ * raw cell voltages read (100µV)
+ * @param read_persisted_soc A function that reads the SoC persisted in
+ * non-volatile memory, in %. It returns EXIT_CODE_OK only if a valid SoC was
+ * read.
+ * @param write_persisted_soc A function that writes the given SoC (%) to
+ * non-volatile memory
+ * @return The created SoC estimator, whose ownership is given to the caller
+ */
+struct SocEstimator *App_SocEstimator_Create(
+    float (*get_and_clear_charge)(void),
+    const struct CellStatistics *(*get_cell_statistics)(void),
+    ExitCode (*read_persisted_soc)(float *soc),
+    ExitCode (*write_persisted_soc)(float soc));
+
+/**
+ * Deallocate the memory used by the given SoC estimator and its EKF
+ * @param soc_estimator The SoC estimator to deallocate
+ */
+void App_SocEstimator_Destroy(struct SocEstimator *soc_estimator);
+
+/**
+ * Update every SoC estimate of the given SoC estimator with the charge that
+ * flowed out of the accumulator since the last tick, and vote between them
+ * @note This function must be called at 100Hz, after the cell voltages have
+ * been read for the tick
+ * @param soc_estimator The SoC estimator to tick
+ * @param has_read_cell_voltages Whether new cell voltages were read this tick.
+ * The voltage-based estimates are only updated with new cell voltages.
+ */
+void App_SocEstimator_Tick100Hz(
+    struct SocEstimator *soc_estimator,
+    bool                 has_read_cell_voltages);
+
+/**
+ * Write the SoC of the given SoC estimator to non-volatile memory, if it has
+ * moved far enough since it was last written
+ * @note This function must be called at 1Hz
+ * @param soc_estimator The SoC estimator to persist the SoC of
+ */
+void App_SocEstimator_Tick1Hz(struct SocEstimator *soc_estimator);
+
+/**
+ * Check whether the given SoC estimator has been initialized, which happens on
+ * the first tick with new cell voltages
+ * @param soc_estimator The SoC estimator to check
+ * @return true if the SoC estimator has been initialized, false otherwise
+ */
+bool App_SocEstimator_IsInitialized(const struct SocEstimator *soc_estimator);
+
+/**
+ * Get the SoC voted from the estimates of the given SoC estimator
+ * @param soc_estimator The SoC estimator to get the SoC from
+ * @return The mean of the first pair of estimates that agree, in %. If no two
+ * estimates agree, this is the EKF's estimate.
+ */
+float App_SocEstimator_GetSoc(const struct SocEstimator *soc_estimator);
+
+/**
+ * Get the SoC estimated by coulomb counting
+ * @param soc_estimator The SoC estimator to get the estimate from
+ * @return The SoC estimated by coulomb counting, in %
+ */
+float App_SocEstimator_GetCoulombCountingSoc(
+    const struct SocEstimator *soc_estimator);
+
+/**
+ * Get the SoC estimated by the EKF
+ * @param soc_estimator The SoC estimator to get the estimate from
+ * @return The SoC estimated by the EKF, in %
+ */
+float App_SocEstimator_GetEkfSoc(const struct SocEstimator *soc_estimator);
+
+/**
+ * Get the SoC looked up from the open circuit voltage the last time the
+ * accumulator was at rest
+ * @param soc_estimator The SoC estimator to get the estimate from
+ * @return The SoC looked up from the open circuit voltage, in %
+ */
+float App_SocEstimator_GetOcvSoc(const struct SocEstimator *soc_estimator);
@@ -1,8 +1,13 @@
 #pragma once
 
-enum CellMonitorChip
-{
-    CELL_MONITOR_CHIP_0,
-    CELL_MONITOR_CHIP_1,
-    NUM_OF_CELL_MONITOR_CHIPS
-};
+// The number of segments in the accumulator. Segments without a cell
+// monitoring chip on the daisy chain read back 0V.
+#define NUM_OF_ACCUMULATOR_SEGMENTS 6U
+
+// The number of cell monitoring chips on the daisy chain. Each chip monitors
+// one accumulator segment, starting from the 0th segment.
+#define NUM_OF_CELL_MONITOR_CHIPS 2U
+
+// The number of cells monitored by each cell monitoring chip, which is the
+// number of cells in each accumulator segment
+#define NUM_OF_CELLS_PER_SEGMENT 16U
@@ -0,0 +1,48 @@
+#pragma once
+
+// The internal resistance of every cell group is estimated by recursive least
+// squares (RLS) from the change in its voltage across a change in the main
+// current. Smaller changes in the main current are drowned out by the noise of
+// the cell voltages, so they aren't used (A).
+#define MIN_RESISTANCE_ESTIMATION_CURRENT_STEP_A 5.0f
+
+// The forgetting factor of the RLS, which weighs the latest current steps more
+// so the estimates follow the resistance as it changes with temperature and SoC
+#define RESISTANCE_ESTIMATION_FORGETTING_FACTOR 0.98f
+
+// The variance of the initial resistance estimates (ohm^2), which start from
+// CELL_GROUP_SERIES_RESISTANCE_OHMS
+#define RESISTANCE_ESTIMATION_INITIAL_VARIANCE 1e-3f
+
+// The resistance estimates are clamped to the resistances a healthy cell group
+// can plausibly have (ohm)
+#define MIN_CELL_GROUP_RESISTANCE_OHMS 0.002f
+#define MAX_CELL_GROUP_RESISTANCE_OHMS 0.100f
+
+// The duration of the pulse power limits (s). The polarization voltage builds
+// up over the pulse, while it has fully built up under the continuous limits.
+#define PULSE_POWER_DURATION_S 10.0f
+
+// The maximum current of each cell group, before derating (A)
+#define MAX_CONTINUOUS_DISCHARGE_CURRENT_A 45.0f
+#define MAX_PULSE_DISCHARGE_CURRENT_A 60.0f
+#define MAX_CONTINUOUS_REGEN_CURRENT_A 8.4f
+#define MAX_PULSE_REGEN_CURRENT_A 12.6f
+
+// The discharge current limits are derated linearly from their maximum at the
+// first temperature (°C) or SoC (%) of each pair, down to 0 at the second
+#define DISCHARGE_FULL_MAX_TEMPERATURE_DEGC 50.0f
+#define DISCHARGE_ZERO_MAX_TEMPERATURE_DEGC 60.0f
+#define DISCHARGE_FULL_MIN_TEMPERATURE_DEGC -10.0f
+#define DISCHARGE_ZERO_MIN_TEMPERATURE_DEGC -20.0f
+#define DISCHARGE_FULL_SOC 15.0f
+#define DISCHARGE_ZERO_SOC 5.0f
+
+// The regen current limits are derated the same way. Cells can't be charged
+// when cold, or when nearly full.
+#define REGEN_FULL_MAX_TEMPERATURE_DEGC 50.0f
+#define REGEN_ZERO_MAX_TEMPERATURE_DEGC 60.0f
+#define REGEN_FULL_MIN_TEMPERATURE_DEGC 10.0f
+#define REGEN_ZERO_MIN_TEMPERATURE_DEGC 0.0f
+#define REGEN_FULL_SOC 90.0f
+#define REGEN_ZERO_SOC 98.0f
@@ -0,0 +1,26 @@
+#pragma once
+
+// Cell balancing runs in periods of 1s on the 100Hz tick. Cells discharge for
+// up to MAX_BALANCING_DISCHARGE_TICKS at the start of every period, and spend
+// the rest of the period in a measurement window with every discharge switch
+// off.
+#define BALANCING_PERIOD_TICKS 100U
+#define MAX_BALANCING_DISCHARGE_TICKS 90U
+
+// The time it takes for the cell voltages to recover once the discharge
+// switches are turned off, including the time for the configuration to be
+// written to the daisy chain and for a full scan of the daisy chain to
+// complete. Cell voltages are only read once this has elapsed.
+#define BALANCING_SETTLE_TIME_MS 50U
+
+// Cells are discharged while they are more than this far above the minimum cell
+// voltage (100µV)
+#define BALANCING_THRESHOLD_100UV 100U
+
+// The most a cell voltage reads below the cell's open-circuit voltage while the
+// cell is discharging or recovering from discharging (100µV). Cell voltages are
+// still read while cells discharge, so the maximum cell voltage is checked
+// without waiting for the measurement window, with the discharged cells raised
+// by this much. 4.2V across a 33Ω balancing resistor drops 64mV across 0.5Ω of
+// sense wire and connector resistance, which must be confirmed on the pack.
+#define BALANCING_DISCHARGE_VOLTAGE_DROP_100UV 700U
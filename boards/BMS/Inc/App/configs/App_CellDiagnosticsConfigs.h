@@ -0,0 +1,13 @@
+#pragma once
+
+// A wire is open when the cell above it reads this much lower with the open
+// wire pull-up current than with the pull-down current (100µV)
+#define OPEN_WIRE_THRESHOLD_100UV 4000U
+
+// The two ADCs that convert the same cell in the overlap conversion must agree
+// to within this much (100µV)
+#define ADC_OVERLAP_THRESHOLD_100UV 200U
+
+// A diagnostic status is only set or cleared once this many consecutive
+// evaluations agree, so a single disturbed conversion doesn't change it
+#define NUM_OF_CONSECUTIVE_DIAGNOSTIC_RESULTS 3U
@@ -1,5 +1,8 @@
 #pragma once
 
+// Cell balancing is throttled linearly from full duty at this die temperature
+// down to no duty at DIE_TEMP_TO_DISABLE_CELL_BALANCING_DEGC
+#define DIE_TEMP_TO_THROTTLE_CELL_BALANCING_DEGC 100.0f
 #define DIE_TEMP_TO_REENABLE_CELL_BALANCING_DEGC 110.0f
 #define DIE_TEMP_TO_REENABLE_CHARGER_DEGC 115.0f
 #define DIE_TEMP_TO_DISABLE_CELL_BALANCING_DEGC 115.0f
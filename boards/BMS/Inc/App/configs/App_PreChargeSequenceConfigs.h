@@ -0,0 +1,37 @@
+#pragma once
+
+// The tractive system is precharged through the precharge resistor into the
+// capacitance of the inverters, so its voltage rises along an RC charging curve
+// with this time constant (s)
+#define PRE_CHARGE_RESISTANCE_OHMS 1000.0f
+#define TRACTIVE_SYSTEM_CAPACITANCE_F 300e-6f
+#define NOMINAL_PRE_CHARGE_TIME_CONSTANT_S \
+    (PRE_CHARGE_RESISTANCE_OHMS * TRACTIVE_SYSTEM_CAPACITANCE_F)
+
+// The time constants the tractive system can plausibly charge with, given the
+// tolerances of the precharge resistor and the inverter capacitance (s). A
+// shorter time constant means the precharge resistor is shorted, and a longer
+// one means it is open or the tractive system is loaded.
+#define MIN_PRE_CHARGE_TIME_CONSTANT_S \
+    (0.5f * NOMINAL_PRE_CHARGE_TIME_CONSTANT_S)
+#define MAX_PRE_CHARGE_TIME_CONSTANT_S \
+    (2.0f * NOMINAL_PRE_CHARGE_TIME_CONSTANT_S)
+
+// AIR+ may be closed once the tractive system voltage reaches this fraction of
+// the pack voltage, averaged over enough of the latest samples that noise
+// doesn't complete the precharge early
+#define PRE_CHARGE_COMPLETE_VOLTAGE_RATIO 0.95f
+#define NUM_OF_PRE_CHARGE_COMPLETE_SAMPLES 5U
+
+// The charging curve is fitted on the samples in this band of the pack voltage
+// only. Below it the samples are drowned out by noise, and above it the
+// logarithm of the remaining voltage is.
+#define MIN_PRE_CHARGE_FIT_VOLTAGE_RATIO 0.05f
+#define MAX_PRE_CHARGE_FIT_VOLTAGE_RATIO 0.90f
+
+// The number of samples the charging curve is fitted on before its time
+// constant is trusted
+#define MIN_NUM_OF_PRE_CHARGE_FIT_SAMPLES 100U
+
+// The time the precharge relay takes to close after it is enabled (s)
+#define PRE_CHARGE_RELAY_CLOSE_TIME_S 0.02f
@@ -0,0 +1,5 @@
+#pragma once
+
+struct BmsWorld;
+
+#define World BmsWorld
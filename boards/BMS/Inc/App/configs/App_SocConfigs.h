@@ -0,0 +1,35 @@
+#pragma once
+
+// The state of charge (SoC) is estimated on the 100Hz tick
+#define SOC_TICK_PERIOD_S 0.01f
+
+// The capacity of each series-connected cell group in the accumulator
+#define CELL_GROUP_CAPACITY_AH 4.2f
+
+// The equivalent circuit of each cell group used by the EKF: a series
+// resistance, and one RC pair for the polarization voltage
+#define CELL_GROUP_SERIES_RESISTANCE_OHMS 0.015f
+#define CELL_GROUP_POLARIZATION_RESISTANCE_OHMS 0.010f
+#define CELL_GROUP_POLARIZATION_CAPACITANCE_F 2000.0f
+
+// The EKF's process noise, per tick, of the SoC (%^2) and of the polarization
+// voltage (V^2), its measurement noise of the mean cell voltage (V^2), and its
+// initial SoC variance (%^2)
+#define SOC_EKF_SOC_PROCESS_NOISE 1e-6f
+#define SOC_EKF_POLARIZATION_PROCESS_NOISE 1e-8f
+#define SOC_EKF_MEASUREMENT_NOISE 4e-4f
+#define SOC_EKF_INITIAL_SOC_VARIANCE 25.0f
+
+// The accumulator is at rest once the main current has stayed below this
+// magnitude for this many ticks, at which point the cell voltages are close
+// enough to their open circuit voltages to look up the SoC from
+#define SOC_REST_CURRENT_A 0.5f
+#define SOC_REST_TICKS (5U * 60U * 100U)
+
+// The maximum difference (%) between two SoC estimates for them to agree
+#define SOC_MAX_ABS_DIFFERENCE 5.0f
+
+// The SoC is only written to non-volatile memory once it has moved this far
+// (%) from the last SoC written, which bounds the wear on the flash page it is
+// stored in
+#define SOC_PERSIST_DELTA 1.0f
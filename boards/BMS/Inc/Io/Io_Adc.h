@@ -1,17 +1,14 @@
 #pragma once
 
-#include <stdint.h>
+#include <stm32f3xx_hal.h>
 
 /**
- * Get the buffer for DMA controller to write raw ADC1 values into
- * @return Pointer to the buffer
+ * Initialize ADC1 and ADC2, and start converting the tractive system voltage
+ * and main current sense voltages by DMA
+ * @param hadc1: The handle of ADC1
+ * @param hadc2: The handle of ADC2
  */
-uint16_t *Io_Adc_GetRawAdc1Values(void);
-/**
- * Get the buffer for DMA controller to write raw ADC2 values into
- * @return Pointer to the buffer
- */
-uint16_t *Io_Adc_GetRawAdc2Values(void);
+void Io_Adc_Init(ADC_HandleTypeDef *hadc1, ADC_HandleTypeDef *hadc2);
 
 /**
  * Get the voltage measured at ADC1 channel 3
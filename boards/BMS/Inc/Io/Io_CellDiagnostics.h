@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+#include "App_SharedExitCode.h"
+#include "App_CellDiagnostics.h"
+#include "Io_LTC6813Engine.h"
+
+/**
+ * Update the latest result of the diagnostic converted in a completed scan of
+ * the cell monitoring chips, if any
+ * @param scan The completed scan of the cell monitoring chips
+ * @note This is called from the LTC6813 engine's scan complete callback. The
+ * result is dropped if any register group of the scan failed its PEC15 check,
+ * since it could then mix registers from two different diagnostics.
+ */
+void Io_CellDiagnostics_UpdateFromScan(const struct LTC6813Scan *scan);
+
+/**
+ * Read the raw cell voltage registers of the latest result of the given
+ * diagnostic
+ * @param diagnostic The diagnostic to read the result of
+ * @param voltages NUM_OF_CELL_MONITOR_CHIPS rows of NUM_OF_CELLS_PER_SEGMENT
+ * registers (100µV) to read the result into
+ * @return EXIT_CODE_OK if a result arrived since the last time this diagnostic
+ * was read, else EXIT_CODE_TIMEOUT
+ */
+ExitCode Io_CellDiagnostics_ReadDiagnostic(
+    enum CellDiagnostic diagnostic,
+    uint16_t (*voltages)[NUM_OF_CELLS_PER_SEGMENT]);
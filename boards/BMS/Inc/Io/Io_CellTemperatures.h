@@ -1,11 +1,22 @@
 #pragma once
 
 #include "App_SharedExitCode.h"
+#include "Io_LTC6813Engine.h"
+
+/**
+ * Update the latest raw thermistor voltages from a completed scan of the cell
+ * monitoring chips
+ * @param scan The completed scan of the cell monitoring chips
+ * @note This is called from the LTC6813 engine's scan complete callback
+ */
+void Io_CellTemperatures_UpdateFromScan(const struct LTC6813Scan *scan);
 
 /**
  * Read cell temperatures from all thermistors connected to the accumulator
  * @return EXIT_CODE_OK if cell temperatures (0.1°C) were acquired successfully
- * from all thermistors connected to the accumulator. Else, EXIT_CODE_ERROR
+ * from all thermistors connected to the accumulator. EXIT_CODE_OUT_OF_RANGE if
+ * any thermistor is outside its -40°C to 125°C operating range, which means it
+ * is shorted or disconnected. Else, EXIT_CODE_TIMEOUT or EXIT_CODE_ERROR
  */
 ExitCode Io_CellTemperatures_ReadTemperatures(void);
 
@@ -14,14 +25,14 @@ ExitCode Io_CellTemperatures_ReadTemperatures(void);
  * temperatures
  * @return The current minimum cell temperature (0.1°C)
  */
-uint32_t Io_CellTemperatures_GetMinCellTemperature(void);
+int32_t Io_CellTemperatures_GetMinCellTemperature(void);
 
 /**
  * Get the current maximum accumulator cell temperature out of all cell
  * temperatures
  * @return The current maximum cell temperature (0.1°C)
  */
-uint32_t Io_CellTemperatures_GetMaxCellTemperature(void);
+int32_t Io_CellTemperatures_GetMaxCellTemperature(void);
 
 /**
  * Get the average accumulator cell temperature
@@ -3,11 +3,23 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include "App_SharedExitCode.h"
+#include "Io_LTC6813Engine.h"
 
 /**
- * Read raw cell voltages from the cell monitoring chips.
- * @return EXIT_CODE_OK if the raw cell voltages (100µV) were acquired
- * successfully from all cell monitoring chips. Else, EXIT_CODE_ERROR.
+ * Update the latest cell voltages from a completed scan of the cell monitoring
+ * chips.
+ * @param scan The completed scan of the cell monitoring chips.
+ * @note This is called from the LTC6813 engine's scan complete callback.
+ */
+void Io_CellVoltages_UpdateFromScan(const struct LTC6813Scan *scan);
+
+/**
+ * Read the raw cell voltages of the latest scan of the cell monitoring chips.
+ * This doesn't block on the cell monitoring chips, which are scanned in the
+ * background by the LTC6813 engine.
+ * @return EXIT_CODE_OK if the raw cell voltages (100µV) of the latest scan were
+ * acquired successfully from all cell monitoring chips. EXIT_CODE_TIMEOUT if no
+ * scan has completed yet. Else, EXIT_CODE_ERROR.
  */
 ExitCode Io_CellVoltages_ReadRawCellVoltages(void);
 
@@ -21,3 +33,14 @@ ExitCode Io_CellVoltages_ReadRawCellVoltages(void);
  * voltages (100µV).
  */
 uint16_t *Io_CellVoltages_GetRawCellVoltages(size_t *column_length);
+
+/**
+ * Get the main current sampled as the raw cell voltages read last started
+ * converting, so a change in the cell voltages can be paired with the change in
+ * the main current that caused it
+ * @note Call Io_CellVoltages_ReadRawCellVoltages to get the most recent raw
+ * cell voltages from the cell monitoring chips before calling this function.
+ * @return The main current, in A. It is positive when the accumulator is
+ * discharging.
+ */
+float Io_CellVoltages_GetMainCurrent(void);
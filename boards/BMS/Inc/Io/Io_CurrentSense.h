@@ -27,6 +27,21 @@ ExitCode Io_CurrentSense_ConvertToHighResolutionMainCurrent(
     float  adc_voltage,
     float *high_res_main_current);
 
+/**
+ * Convert the given ADC voltages of both outputs of the HSNBV-D06 to main
+ * current, using the low-resolution output while it is well within its range
+ * and the high-resolution output otherwise
+ * @param low_res_adc_voltage The ADC voltage of output 1 (+/- 50A)
+ * @param high_res_adc_voltage The ADC voltage of output 2 (+/- 300A)
+ * @param main_current This will be set to main current, in amps
+ * @return EXIT_CODE_OUT_OF_RANGE if either ADC voltage is negative
+ *         EXIT_CODE_INVALID_ARGS if main_current is NULL
+ */
+ExitCode Io_CurrentSense_ConvertToMainCurrent(
+    float  low_res_adc_voltage,
+    float  high_res_adc_voltage,
+    float *main_current);
+
 /**
  * Convert the given ADC voltage to AIR loop current
  * @param adc_voltage The ADC voltage to convert
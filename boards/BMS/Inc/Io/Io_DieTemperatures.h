@@ -1,61 +1,33 @@
 #pragma once
 
+#include <stddef.h>
 #include "App_SharedExitCode.h"
+#include "Io_LTC6813Engine.h"
 
 /**
- * Read internal die temperatures for all cell monitoring chips
- * @return EXIT_CODE_OK if internal die temperatures (°C) were acquired
- * successfully from all cell monitoring chips. Else, EXIT_CODE_ERROR
- */
-ExitCode Io_DieTemperatures_ReadTemp(void);
-
-/**
- * Get the internal die temperature of the cell monitoring chip for the 0th
- * accumulator segment
- * @return The internal die temperature (°C) of the cell monitoring chip for the
- * 0th accumulator segment
- */
-float Io_DieTemperatures_GetSegment0DieTemp(void);
-
-/**
- * Get the internal die temperature of the cell monitoring chip for the 1st
- * accumulator segment
- * @return The internal die temperature (°C) of the cell monitoring chip for the
- * 1st accumulator segment
+ * Update the latest internal die temperatures from a completed scan of the cell
+ * monitoring chips
+ * @param scan The completed scan of the cell monitoring chips
+ * @note This is called from the LTC6813 engine's scan complete callback
  */
-float Io_DieTemperatures_GetSegment1DieTemp(void);
+void Io_DieTemperatures_UpdateFromScan(const struct LTC6813Scan *scan);
 
 /**
- * Get the internal die temperature of the cell monitoring chip for the 2nd
- * accumulator segment
- * @return The internal die temperature (°C) of the cell monitoring chip for the
- * 2nd accumulator segment
- */
-float Io_DieTemperatures_GetSegment2DieTemp(void);
-
-/**
- * Get the internal die temperature of the cell monitoring chip for the 3rd
- * accumulator segment
- * @return The internal die temperature (°C) of the cell monitoring chip for the
- * 3rd accumulator segment
- */
-float Io_DieTemperatures_GetSegment3DieTemp(void);
-
-/**
- * Get the internal die temperature of the cell monitoring chip for the 4th
- * accumulator segment
- * @return The internal die temperature (°C) of the cell monitoring chip for the
- * 4th accumulator segment
+ * Read the internal die temperatures of the latest scan of the cell monitoring
+ * chips, without blocking on the cell monitoring chips
+ * @return EXIT_CODE_OK if internal die temperatures (°C) were acquired
+ * successfully from all cell monitoring chips. EXIT_CODE_TIMEOUT if no scan has
+ * completed yet. Else, EXIT_CODE_ERROR
  */
-float Io_DieTemperatures_GetSegment4DieTemp(void);
+ExitCode Io_DieTemperatures_ReadTemp(void);
 
 /**
- * Get the internal die temperature of the cell monitoring chip for the 5th
- * accumulator segment
- * @return The internal die temperature (°C) of the cell monitoring chip for the
- * 5th accumulator segment
+ * Get the internal die temperature of the given cell monitoring chip
+ * @param chip The cell monitoring chip to get the internal die temperature of,
+ * from 0 to NUM_OF_CELL_MONITOR_CHIPS - 1
+ * @return The internal die temperature (°C) of the given cell monitoring chip
  */
-float Io_DieTemperatures_GetSegment5DieTemp(void);
+float Io_DieTemperatures_GetDieTemp(size_t chip);
 
 /**
  * Get the current maximum internal die temperature out of all the cell monitors
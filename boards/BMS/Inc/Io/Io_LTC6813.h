@@ -1,7 +1,7 @@
 #pragma once
 
+#include <stdbool.h>
 #include <stm32f3xx_hal.h>
-#include "App_SharedExitCode.h"
 
 /**
  * Initialize all chips on the LTC6813 daisy chain.
@@ -15,47 +15,53 @@ void Io_LTC6813_Init(
     uint16_t           nss_pin);
 
 /**
- * Calculate the 15-bit packet error code (PEC15) for the given data buffer.
+ * Calculate the 15-bit packet error code (PEC15) for the given data buffer
+ * with the CRC calculation unit.
  * @param data_buffer A pointer to the buffer containing data used to calculate
  * the PEC15 code.
  * @param size The number of data elements used to calculate the PEC15 code
  * @note The size can be a positive integer less than or equal to the size
  * of the data buffer.
+ * @note This must only be called by the transfers of the LTC6813 engine, which
+ * own the CRC calculation unit.
  * @return The calculated PEC15 code for the given data buffer.
  */
-uint16_t Io_LTC6813_CalculatePec15(uint8_t *data_buffer, uint32_t size);
+uint16_t Io_LTC6813_CalculatePec15(const uint8_t *data_buffer, uint32_t size);
 
 /**
- * Transition all LTC6813 chips on the daisy chain from the IDLE state to the
- * READY state
- * @return EXIT_CODE_OK if the SCK and NSS pin can be toggled successfully.
- * Else, EXIT_CODE_ERROR
+ * Check the PEC15 of the register group read back from every chip on the daisy
+ * chain in one pass over the received buffer.
+ * @param rx_data The register groups received from the daisy chain, made of
+ * NUM_OF_RX_BYTES bytes per chip, each ending with its PEC15
+ * @param is_pec15_ok The array of NUM_OF_CELL_MONITOR_CHIPS elements set to
+ * whether the PEC15 of each chip's register group is correct
+ * @return The number of chips whose register group failed its PEC15 check
  */
-ExitCode Io_LTC6813_EnterReadyState(void);
+uint32_t Io_LTC6813_CheckRegisterGroupPec15s(
+    const uint8_t *rx_data,
+    bool *         is_pec15_ok);
 
 /**
- * Send a command to all LTC6813 chips on the daisy chain
- * @param tx_cmd The given command that is transmitted to the LTC6813 chips on
- * the daisy chain
- * @return EXIT_CODE_OK if the command was transmitted successfully. Else,
- * EXIT_CODE_ERROR
+ * Get the configuration of register A for one LTC6813 chip, followed by its
+ * PEC15. The PEC15 is calculated in software, so this can be called from any
+ * task while the LTC6813 engine is transferring.
+ * @param discharge_cells The discharge switches to turn on, where bit n is the
+ * discharge switch of cell n + 1. Only the switches of cells 1 to 12 are in
+ * register A.
+ * @param tx_payload The buffer of NUM_OF_RX_BYTES bytes to store the payload in
  */
-ExitCode Io_LTC6813_SendCommand(uint32_t tx_cmd);
+void Io_LTC6813_GetRegisterA(uint32_t discharge_cells, uint8_t *tx_payload);
 
 /**
- * Wait for the completion of all ADC conversions for the LTC6813 chips on the
- * daisy chain.
- * @return EXIT_CODE_OK if all ADC conversions have completed successfully.
- * Else, EXIT_CODE_TIMEOUT.
+ * Get the configuration of register B for one LTC6813 chip, followed by its
+ * PEC15. The PEC15 is calculated in software, so this can be called from any
+ * task while the LTC6813 engine is transferring.
+ * @param discharge_cells The discharge switches to turn on, where bit n is the
+ * discharge switch of cell n + 1. Only the switches of cells 13 to 18 are in
+ * register B.
+ * @param tx_payload The buffer of NUM_OF_RX_BYTES bytes to store the payload in
  */
-ExitCode Io_LTC6813_PollConversions(void);
-
-/**
- * Configure register A for all LTC6813 chips on the LTC6813 daisy chain.
- * @return EXIT_CODE_OK if all chips on the daisy chain are configured
- * successfully. Else, EXIT_CODE_ERROR.
- */
-ExitCode Io_LTC6813_ConfigureRegisterA(void);
+void Io_LTC6813_GetRegisterB(uint32_t discharge_cells, uint8_t *tx_payload);
 
 /**
  * Get the SPI interface configured for the LTC6813 daisy chain.
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "App_SharedExitCode.h"
+#include "App_CellDiagnostics.h"
+#include "configs/App_AccumulatorConfigs.h"
+
+// The number of registers read back by the engine for each chip
+#define NUM_OF_CELL_VOLTAGE_REGISTERS 18U
+#define NUM_OF_AUX_REGISTERS 9U
+#define NUM_OF_STATUS_REGISTERS 6U
+
+struct LTC6813Scan
+{
+    // The raw register values of every chip on the daisy chain, in the order
+    // they are stored on the chip: C1V-C18V, G1V-G5V, REF, G6V-G8V (100µV), and
+    // SC, ITMP, VA, VD followed by the two status B flag registers
+    uint16_t cell_voltages[NUM_OF_CELL_MONITOR_CHIPS]
+                          [NUM_OF_CELL_VOLTAGE_REGISTERS];
+    uint16_t aux_voltages[NUM_OF_CELL_MONITOR_CHIPS][NUM_OF_AUX_REGISTERS];
+    uint16_t statuses[NUM_OF_CELL_MONITOR_CHIPS][NUM_OF_STATUS_REGISTERS];
+
+    // Whether a diagnostic was converted in this scan, and the cell voltage
+    // registers the diagnostic was read back from (100µV)
+    bool                has_diagnostic;
+    enum CellDiagnostic diagnostic;
+    uint16_t            diagnostic_voltages[NUM_OF_CELL_MONITOR_CHIPS]
+                                [NUM_OF_CELL_VOLTAGE_REGISTERS];
+
+    // The value sampled by the engine's sample callback as the cell voltages of
+    // this scan started converting, which lets a measurement taken outside the
+    // chips be paired with the cell voltages it was taken alongside
+    float cell_voltage_conversion_sample;
+
+    // Whether every register group of this scan passed its PEC15 check. The
+    // registers of a register group that failed its PEC15 check keep the values
+    // from the last scan.
+    bool is_pec15_ok;
+
+    // The number of register groups that failed their PEC15 check since the
+    // engine was initialized
+    uint32_t num_pec15_errors;
+};
+
+/**
+ * Initialize the asynchronous LTC6813 engine, which continuously scans the cell
+ * voltages, the auxiliary (GPIO) voltages and the status registers of every
+ * chip on the daisy chain without blocking the caller. Register groups are read
+ * back with SPI DMA transfers while the next conversion is already running.
+ * Every SCANS_PER_DIAGNOSTIC scans, one open wire or ADC overlap diagnostic is
+ * converted in place of the auxiliary voltages, so every scan takes the same
+ * time and the auxiliary voltages of a scan with a diagnostic keep the values
+ * from the last scan.
+ * @note Io_LTC6813_Init() must be called before this function. Configuration
+ * register A is written to every chip before the first conversion.
+ * @param scan_complete_callback The function called from the SPI DMA interrupt
+ * every time a scan of the whole daisy chain completes. The given scan is only
+ * valid until the callback returns, so it should copy whatever it needs.
+ * @param sample_callback The function called from the SPI DMA interrupt as soon
+ * as the cell voltage conversion command has been sent. Its return value is
+ * reported in the scan of those cell voltages.
+ */
+void Io_LTC6813Engine_Init(
+    void (*scan_complete_callback)(const struct LTC6813Scan *),
+    float (*sample_callback)(void));
+
+/**
+ * Start the next conversion and the read back of the last one once the last
+ * conversion has completed. This replaces polling the chips with PLADC: a
+ * conversion is considered complete once its conversion time has elapsed.
+ * @note This function must be called every millisecond
+ * @param current_ms The current time, in milliseconds
+ */
+void Io_LTC6813Engine_Tick1kHz(uint32_t current_ms);
+
+/**
+ * Request configuration registers A and B to be written to every chip on the
+ * daisy chain before the next conversion starts
+ * @return EXIT_CODE_OK, since the configuration is written asynchronously
+ */
+ExitCode Io_LTC6813Engine_ConfigureCellMonitors(void);
+
+/**
+ * Set the discharge switches of every chip on the daisy chain, which are
+ * written before the next conversion starts. Only the configuration registers
+ * whose contents change are written.
+ * @param discharge_cells NUM_OF_CELL_MONITOR_CHIPS bitmasks of the discharge
+ * switches to turn on, where bit n of each bitmask is the discharge switch of
+ * cell n + 1 of that chip
+ * @return EXIT_CODE_OK, since the configuration is written asynchronously
+ */
+ExitCode Io_LTC6813Engine_WriteDischargeCells(const uint32_t *discharge_cells);
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+
+// The PEC15 polynomial x^15 + x^14 + x^10 + x^8 + x^7 + x^4 + x^3 + 1
+#define PEC15_POLYNOMIAL 0xC599U
+
+// The 16-bit polynomial (x + 1) * PEC15_POLYNOMIAL without its x^16 term, and
+// the initial value, for a CRC16 from which the PEC15 can be recovered with
+// Io_LTC6813Pec15_ConvertFromCrc16(). The CRC16 is an odd polynomial, which
+// the STM32F3 CRC calculation unit supports, unlike the PEC15 itself.
+#define PEC15_CRC16_POLYNOMIAL 0x4EABU
+#define PEC15_CRC16_INITIAL_VALUE 0x0020U
+
+/**
+ * Calculate the PEC15 for the given data buffer one byte at a time, as in the
+ * LTC6813 datasheet. This is the reference the other implementations are
+ * tested against.
+ * @param data_buffer A pointer to the buffer containing data used to calculate
+ * the PEC15 code.
+ * @param size The number of bytes used to calculate the PEC15 code
+ * @return The calculated PEC15 code, shifted left by 1 bit
+ */
+uint16_t Io_LTC6813Pec15_CalculateBytewise(
+    const uint8_t *data_buffer,
+    uint32_t       size);
+
+/**
+ * Calculate the PEC15 for the given data buffer four bytes at a time, using
+ * slicing-by-4 lookup tables. This is used where the CRC calculation unit
+ * isn't available, such as in the x86 tests, and outside of the transfers of
+ * the LTC6813 engine, which own the CRC calculation unit.
+ * @param data_buffer A pointer to the buffer containing data used to calculate
+ * the PEC15 code.
+ * @param size The number of bytes used to calculate the PEC15 code
+ * @return The calculated PEC15 code, shifted left by 1 bit
+ */
+uint16_t Io_LTC6813Pec15_CalculateSlicingBy4(
+    const uint8_t *data_buffer,
+    uint32_t       size);
+
+/**
+ * Convert the CRC16 calculated with PEC15_CRC16_POLYNOMIAL and
+ * PEC15_CRC16_INITIAL_VALUE, most significant bit first, to the PEC15 of the
+ * same data
+ * @param crc16 The CRC16 of the data
+ * @return The PEC15 code of the data, shifted left by 1 bit
+ */
+uint16_t Io_LTC6813Pec15_ConvertFromCrc16(uint16_t crc16);
@@ -0,0 +1,27 @@
+#pragma once
+
+// The cost of calculating the PEC15 of one register group of 6 data bytes with
+// each implementation, in cycle counter units. The cycle counter is the DWT
+// cycle counter on ARM and a nanosecond monotonic clock on x86.
+struct LTC6813Pec15BenchmarkResults
+{
+    float bytewise;
+    float slicing_by_4;
+
+    // Only measured on ARM, and 0 on x86
+    float crc_calculation_unit;
+};
+
+/**
+ * Measure the cost of calculating the PEC15 of one register group with each
+ * implementation of the PEC15
+ * @note On ARM, this should be run with interrupts disabled (e.g. from the
+ *       debugger before the scheduler starts) and after `Io_LTC6813_Init()`,
+ *       which sets up the CRC calculation unit
+ * @param num_register_groups The number of register groups to calculate the
+ *                            PEC15 of with each implementation
+ * @param results Set to the cost of one PEC15 with each implementation
+ */
+void Io_LTC6813Pec15Benchmark_Run(
+    unsigned int                         num_register_groups,
+    struct LTC6813Pec15BenchmarkResults *results);
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "App_CellDiagnostics.h"
+
+// The conversions started by the LTC6813 engine
+enum LTC6813Conversion
+{
+    LTC6813_CELL_VOLTAGE_CONVERSION,
+    LTC6813_AUX_CONVERSION,
+    LTC6813_STATUS_CONVERSION,
+    LTC6813_OPEN_WIRE_PULL_UP_CONVERSION,
+    LTC6813_OPEN_WIRE_PULL_DOWN_CONVERSION,
+    LTC6813_ADC_OVERLAP_CONVERSION,
+    NUM_OF_LTC6813_CONVERSIONS,
+};
+
+/**
+ * Get the conversion to start after the conversion that just completed. A scan
+ * converts the cell voltages, then the auxiliary voltages, and then the status
+ * registers. Every SCANS_PER_DIAGNOSTIC scans, a diagnostic is converted in
+ * place of the auxiliary voltages, so every scan takes the same time and the
+ * cell voltages are converted at a fixed period.
+ * @param is_converting Whether a conversion has been started since the scan
+ * was last restarted
+ * @param completed_conversion The conversion that just completed, if any
+ * @param num_scans The number of scans started, including the current one
+ * @param diagnostic The diagnostic converted in the next scan that converts a
+ * diagnostic
+ * @return The next conversion
+ */
+enum LTC6813Conversion Io_LTC6813Schedule_GetNextConversion(
+    bool                   is_converting,
+    enum LTC6813Conversion completed_conversion,
+    uint32_t               num_scans,
+    enum CellDiagnostic    diagnostic);
+
+/**
+ * Get the conversion that converts the given diagnostic
+ * @param diagnostic The diagnostic to convert
+ * @return The conversion of the diagnostic
+ */
+enum LTC6813Conversion
+    Io_LTC6813Schedule_GetDiagnosticConversion(enum CellDiagnostic diagnostic);
+
+/**
+ * Get the time the given conversion is given to complete, after which the next
+ * conversion is started
+ * @param conversion The conversion to get the time of
+ * @return The conversion time, in milliseconds
+ */
+uint32_t
+    Io_LTC6813Schedule_GetConversionTimeMs(enum LTC6813Conversion conversion);
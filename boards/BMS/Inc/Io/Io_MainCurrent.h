@@ -0,0 +1,23 @@
+#pragma once
+
+/**
+ * Integrate the main current measured by the latest ADC2 conversion sequence
+ * @note This function must be called from the ADC2 conversion complete
+ *       callback, so every sample of the main current is counted
+ */
+void Io_MainCurrent_IntegrateCurrent(void);
+
+/**
+ * Get the charge that flowed out of the accumulator since this function was
+ * last called, and start integrating the main current again from zero
+ * @return The charge that flowed out of the accumulator, in C. It is positive
+ * when the accumulator is discharging.
+ */
+float Io_MainCurrent_GetAndClearCharge(void);
+
+/**
+ * Get the main current measured by the latest ADC2 conversion sequence
+ * @return The main current, in A. It is positive when the accumulator is
+ * discharging.
+ */
+float Io_MainCurrent_GetMainCurrent(void);
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "App_SharedExitCode.h"
+
+/**
+ * Find the latest state of charge (SoC) written to flash, and erase the flash
+ * pages that need to be erased for this power cycle. Flash is never erased
+ * after this, since the CPU stalls for up to 40ms while a flash page is
+ * erased.
+ * @note This must be called once before the scheduler is started, and before
+ *       any other function in this file
+ */
+void Io_SocStorage_Init(void);
+
+/**
+ * Read the state of charge (SoC) last written to flash
+ * @param soc This will be set to the SoC last written to flash, in %
+ * @return EXIT_CODE_ERROR if no valid SoC has been written to flash
+ */
+ExitCode Io_SocStorage_ReadSoc(float *soc);
+
+/**
+ * Write the given state of charge (SoC) to flash. Every SoC written is
+ * appended to the active flash page, which has room for at least a full
+ * charge or a full discharge at power on. The page is never erased here, so
+ * once it is full the SoC isn't written again until the next power cycle.
+ * @note The CPU stalls while the flash is being programmed, for up to 280µs,
+ *       so this must only be called from a low-rate task
+ * @param soc The SoC to write, in %
+ * @return EXIT_CODE_ERROR if the flash could not be programmed, or if the
+ *         active flash page is full
+ */
+ExitCode Io_SocStorage_WriteSoc(float soc);
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stdint.h>
+#include "App_SharedExitCode.h"
+
+/**
+ * Convert the voltage across a Vishay NTCALUG03A103G thermistor, read back by
+ * an LTC6813 auxiliary ADC, to the thermistor's temperature. The thermistor is
+ * biased with a 10kΩ resistor to the 3.0V reference.
+ * @param raw_thermistor_voltage The voltage across the thermistor (100µV)
+ * @param temperature This is set to the temperature of the thermistor (0.1°C),
+ * linearly interpolated from a table indexed by the thermistor voltage
+ * @return EXIT_CODE_OUT_OF_RANGE if the voltage is outside the thermistor's
+ * -40°C to 125°C operating range, which means the thermistor is shorted or
+ * disconnected. Else, EXIT_CODE_OK
+ */
+ExitCode Io_Thermistor_GetTemperature(
+    uint16_t raw_thermistor_voltage,
+    int32_t *temperature);
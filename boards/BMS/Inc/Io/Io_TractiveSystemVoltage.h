@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stddef.h>
+
+/**
+ * Sample the tractive system voltage measured by the latest ADC1 conversion
+ * @note This function must be called from the ADC1 callbacks, once each of
+ *       its conversion sets has been converted, so the tractive system voltage
+ *       is sampled at ADC1_ADC2_FREQUENCY
+ */
+void Io_TractiveSystemVoltage_SampleVoltage(void);
+
+/**
+ * Copy the tractive system voltages sampled since this function was last called
+ * into the given buffer, oldest first
+ * @note Only the voltages sampled in the last 64ms are kept, so this function
+ *       must be called at least that often
+ * @param voltages The buffer to copy the tractive system voltages into, in V
+ * @param max_num_voltages The maximum number of voltages to copy
+ * @return The number of voltages copied
+ */
+size_t Io_TractiveSystemVoltage_ReadVoltages(
+    float *voltages,
+    size_t max_num_voltages);
@@ -6,12 +6,32 @@
 
 #define SPI_INTERFACE_TIMEOUT_MS_LTC6813 2U
 
-// ADC timeout threshold of 10 was chosen arbitrarily.
-// TODO: Determine the ADC conversion timeout threshold #674
-#define ADC_TIMEOUT_CYCLES_THRESHOLD 10U
-
 #define MD 1U
 #define DCP 0U
 #define CH 0U
 #define CHG 0U
 #define CHST 0U
+
+// The LTC6813 conversion times for MD = 1 (7kHz mode) from the datasheet are
+// 2.335ms (ADCV), 3.906ms (ADAX) and 1.604ms (ADSTAT). Since conversions are
+// only checked for completion on every 1kHz tick, each time is rounded up to
+// the next millisecond and one more millisecond is added.
+#define ADCV_CONVERSION_TIME_MS 4U
+#define ADAX_CONVERSION_TIME_MS 5U
+#define ADSTAT_CONVERSION_TIME_MS 3U
+
+// Every nth scan converts one diagnostic in place of the auxiliary voltages,
+// cycling through the open wire pull-up, open wire pull-down and ADC overlap
+// conversions. ADOW converts every cell like ADCV, and ADOL only converts two
+// cells, so either fits in the ADAX time, with the millisecond over the ADCV
+// time spent reading back the cell voltages before the diagnostic starts. Every
+// scan takes 12ms, so the cell voltages are converted every 12ms, the auxiliary
+// voltages are converted in every other scan, and a whole cycle of diagnostics
+// completes every 72ms.
+#define SCANS_PER_DIAGNOSTIC 2U
+#define ADOW_CONVERSION_TIME_MS ADAX_CONVERSION_TIME_MS
+#define ADOL_CONVERSION_TIME_MS ADAX_CONVERSION_TIME_MS
+
+// The queue of DMA transfers started on a 1kHz tick takes about 1ms to complete
+// for two chips, so give up on it if it hasn't completed after this long
+#define SPI_DMA_TIMEOUT_MS_LTC6813 5U
@@ -60,11 +60,14 @@ extern "C"
     void UsageFault_Handler(void);
     void DebugMon_Handler(void);
     void DMA1_Channel1_IRQHandler(void);
+    void DMA1_Channel4_IRQHandler(void);
+    void DMA1_Channel5_IRQHandler(void);
     void USB_HP_CAN_TX_IRQHandler(void);
     void USB_LP_CAN_RX0_IRQHandler(void);
     void CAN_RX1_IRQHandler(void);
     void TIM2_IRQHandler(void);
     void TIM3_IRQHandler(void);
+    void SPI2_IRQHandler(void);
     void TIM6_DAC_IRQHandler(void);
     void DMA2_Channel1_IRQHandler(void);
     /* USER CODE BEGIN EFP */
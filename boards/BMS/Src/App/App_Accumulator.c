@@ -12,12 +12,8 @@ struct Accumulator
     struct InRangeCheck *min_cell_voltage_in_range_check;
     struct InRangeCheck *max_cell_voltage_in_range_check;
     struct InRangeCheck *average_cell_voltage_in_range_check;
-    struct InRangeCheck *segment_0_voltage_in_range_check;
-    struct InRangeCheck *segment_1_voltage_in_range_check;
-    struct InRangeCheck *segment_2_voltage_in_range_check;
-    struct InRangeCheck *segment_3_voltage_in_range_check;
-    struct InRangeCheck *segment_4_voltage_in_range_check;
-    struct InRangeCheck *segment_5_voltage_in_range_check;
+    struct InRangeCheck
+        *segment_voltage_in_range_checks[NUM_OF_ACCUMULATOR_SEGMENTS];
 };
 
 struct Accumulator *App_Accumulator_Create(
@@ -27,12 +23,7 @@ struct Accumulator *App_Accumulator_Create(
     float (*get_max_cell_voltage)(void),
     float (*get_average_cell_voltage)(void),
     float (*get_pack_voltage)(void),
-    float (*get_segment_0_voltage)(void),
-    float (*get_segment_1_voltage)(void),
-    float (*get_segment_2_voltage)(void),
-    float (*get_segment_3_voltage)(void),
-    float (*get_segment_4_voltage)(void),
-    float (*get_segment_5_voltage)(void),
+    float (*get_segment_voltage)(size_t),
 
     float min_cell_voltage,
     float max_cell_voltage,
@@ -56,30 +47,23 @@ struct Accumulator *App_Accumulator_Create(
     accumulator->pack_voltage_in_range_check = App_InRangeCheck_Create(
         get_pack_voltage, min_pack_voltage, max_pack_voltage);
 
-    accumulator->segment_0_voltage_in_range_check = App_InRangeCheck_Create(
-        get_segment_0_voltage, min_segment_voltage, max_segment_voltage);
-    accumulator->segment_1_voltage_in_range_check = App_InRangeCheck_Create(
-        get_segment_1_voltage, min_segment_voltage, max_segment_voltage);
-    accumulator->segment_2_voltage_in_range_check = App_InRangeCheck_Create(
-        get_segment_2_voltage, min_segment_voltage, max_segment_voltage);
-    accumulator->segment_3_voltage_in_range_check = App_InRangeCheck_Create(
-        get_segment_3_voltage, min_segment_voltage, max_segment_voltage);
-    accumulator->segment_4_voltage_in_range_check = App_InRangeCheck_Create(
-        get_segment_4_voltage, min_segment_voltage, max_segment_voltage);
-    accumulator->segment_5_voltage_in_range_check = App_InRangeCheck_Create(
-        get_segment_5_voltage, min_segment_voltage, max_segment_voltage);
+    for (size_t segment = 0U; segment < NUM_OF_ACCUMULATOR_SEGMENTS; segment++)
+    {
+        accumulator->segment_voltage_in_range_checks[segment] =
+            App_InRangeCheck_CreateForIndex(
+                get_segment_voltage, segment, min_segment_voltage,
+                max_segment_voltage);
+    }
 
     return accumulator;
 }
 
 void App_Accumulator_Destroy(struct Accumulator *accumulator)
 {
-    free(accumulator->segment_0_voltage_in_range_check);
-    free(accumulator->segment_1_voltage_in_range_check);
-    free(accumulator->segment_2_voltage_in_range_check);
-    free(accumulator->segment_3_voltage_in_range_check);
-    free(accumulator->segment_4_voltage_in_range_check);
-    free(accumulator->segment_5_voltage_in_range_check);
+    for (size_t segment = 0U; segment < NUM_OF_ACCUMULATOR_SEGMENTS; segment++)
+    {
+        free(accumulator->segment_voltage_in_range_checks[segment]);
+    }
     free(accumulator->max_cell_voltage_in_range_check);
     free(accumulator->min_cell_voltage_in_range_check);
     free(accumulator->average_cell_voltage_in_range_check);
@@ -123,38 +107,10 @@ struct InRangeCheck *App_Accumulator_GetAverageCellVoltageInRangeCheck(
     return accumulator->average_cell_voltage_in_range_check;
 }
 
-struct InRangeCheck *App_Accumulator_GetSegment0VoltageInRangeCheck(
-    const struct Accumulator *const accumulator)
-{
-    return accumulator->segment_0_voltage_in_range_check;
-}
-
-struct InRangeCheck *App_Accumulator_GetSegment1VoltageInRangeCheck(
-    const struct Accumulator *const accumulator)
-{
-    return accumulator->segment_1_voltage_in_range_check;
-}
-
-struct InRangeCheck *App_Accumulator_GetSegment2VoltageInRangeCheck(
-    const struct Accumulator *const accumulator)
-{
-    return accumulator->segment_2_voltage_in_range_check;
-}
-
-struct InRangeCheck *App_Accumulator_GetSegment3VoltageInRangeCheck(
-    const struct Accumulator *const accumulator)
-{
-    return accumulator->segment_3_voltage_in_range_check;
-}
-
-struct InRangeCheck *App_Accumulator_GetSegment4VoltageInRangeCheck(
-    const struct Accumulator *const accumulator)
-{
-    return accumulator->segment_4_voltage_in_range_check;
-}
-
-struct InRangeCheck *App_Accumulator_GetSegment5VoltageInRangeCheck(
-    const struct Accumulator *const accumulator)
+struct InRangeCheck *App_Accumulator_GetSegmentVoltageInRangeCheck(
+    const struct Accumulator *const accumulator,
+    size_t                          segment)
 {
-    return accumulator->segment_5_voltage_in_range_check;
+    assert(segment < NUM_OF_ACCUMULATOR_SEGMENTS);
+    return accumulator->segment_voltage_in_range_checks[segment];
 }
@@ -1,136 +1,90 @@
+#include <assert.h>
 #include <stddef.h>
 #include "App_AccumulatorVoltages.h"
-#include "configs/App_AccumulatorConfigs.h"
 
 // This conversion factor is used to convert raw voltages (100µV) to voltages
 // (V).
 #define V_PER_100UV 1E-4f
 
+static_assert(
+    NUM_OF_CELL_MONITOR_CHIPS <= NUM_OF_ACCUMULATOR_SEGMENTS,
+    "Each cell monitoring chip must monitor its own accumulator segment.");
+
 struct AccumulatorVoltages
 {
-    uint16_t *raw_cell_voltages;
-    size_t    total_num_of_cells;
-    size_t    num_of_cells_per_segment;
+    ExitCode (*read_raw_cell_voltages)(void);
+    const uint16_t (*raw_cell_voltages)[NUM_OF_CELLS_PER_SEGMENT];
+
+    // The statistics of the last raw cell voltages read, which every getter
+    // below reads from instead of walking the raw cell voltages again
+    struct CellStatistics statistics;
 };
 
 static struct AccumulatorVoltages cell_voltages;
 
-/**
- * A function used to compute the sum of array elements.
- * @param array A pointer to the given array.
- * @param length The length of the given array.
- * @return The sum of elements for the given array.
- */
-static uint32_t App_SumOfArrayElements(uint16_t array[], size_t length);
-
-static uint32_t App_SumOfArrayElements(uint16_t array[], size_t length)
-{
-    uint32_t array_sum = 0U;
-    for (size_t i = 0U; i < length; i++)
-    {
-        array_sum += array[i];
-    }
-
-    return array_sum;
-}
-
-void App_AccumulatorVoltages_Init(uint16_t *(*get_raw_cell_voltages)(size_t *))
+void App_AccumulatorVoltages_Init(
+    ExitCode (*read_raw_cell_voltages)(void),
+    uint16_t *(*get_raw_cell_voltages)(size_t *))
 {
     size_t raw_cell_voltages_column_length;
 
+    cell_voltages.read_raw_cell_voltages = read_raw_cell_voltages;
+
     // Get the pointer to the 2D array of cell voltages read back from the cell
     // monitoring daisy chain.
     cell_voltages.raw_cell_voltages =
-        get_raw_cell_voltages(&raw_cell_voltages_column_length);
-    cell_voltages.num_of_cells_per_segment = raw_cell_voltages_column_length;
-    cell_voltages.total_num_of_cells =
-        raw_cell_voltages_column_length * NUM_OF_CELL_MONITOR_CHIPS;
+        (const uint16_t(*)[NUM_OF_CELLS_PER_SEGMENT])get_raw_cell_voltages(
+            &raw_cell_voltages_column_length);
+    assert(raw_cell_voltages_column_length == NUM_OF_CELLS_PER_SEGMENT);
 }
 
-float App_AccumulatorVoltages_GetMinCellVoltage(void)
+ExitCode App_AccumulatorVoltages_ReadCellVoltages(void)
 {
-    uint16_t min_cell_voltage = cell_voltages.raw_cell_voltages[0];
-    for (size_t current_cell = 1U;
-         current_cell < cell_voltages.total_num_of_cells; current_cell++)
-    {
-        uint16_t current_cell_voltage =
-            cell_voltages.raw_cell_voltages[current_cell];
-        if (min_cell_voltage > current_cell_voltage)
-        {
-            min_cell_voltage = current_cell_voltage;
-        }
-    }
-
-    return min_cell_voltage * V_PER_100UV;
-}
+    const ExitCode exit_code = cell_voltages.read_raw_cell_voltages();
 
-float App_AccumulatorVoltages_GetMaxCellVoltage(void)
-{
-    float max_cell_voltage = cell_voltages.raw_cell_voltages[0];
-    for (size_t current_cell = 1U;
-         current_cell < cell_voltages.total_num_of_cells; current_cell++)
+    // Even if some register groups failed their PEC15 check, the raw cell
+    // voltages hold the last value successfully read back for every cell
+    if (exit_code != EXIT_CODE_TIMEOUT)
     {
-        float current_cell_voltage =
-            cell_voltages.raw_cell_voltages[current_cell];
-        if (max_cell_voltage < current_cell_voltage)
-        {
-            max_cell_voltage = current_cell_voltage;
-        }
+        App_CellStatistics_Compute(
+            cell_voltages.raw_cell_voltages, &cell_voltages.statistics);
     }
 
-    return max_cell_voltage * V_PER_100UV;
-}
-
-float App_AccumulatorVoltages_GetPackVoltage(void)
-{
-    return (float)App_SumOfArrayElements(
-               cell_voltages.raw_cell_voltages,
-               cell_voltages.total_num_of_cells) *
-           V_PER_100UV;
+    return exit_code;
 }
 
-float App_AccumulatorVoltages_GetAverageCellVoltage(void)
+const struct CellStatistics *App_AccumulatorVoltages_GetStatistics(void)
 {
-    return App_AccumulatorVoltages_GetPackVoltage() /
-           (float)cell_voltages.total_num_of_cells;
+    return &cell_voltages.statistics;
 }
 
-float App_AccumulatorVoltages_GetSegment0Voltage(void)
+float App_AccumulatorVoltages_GetMinCellVoltage(void)
 {
-    return (float)App_SumOfArrayElements(
-               &cell_voltages.raw_cell_voltages
-                    [CELL_MONITOR_CHIP_0 *
-                     cell_voltages.num_of_cells_per_segment],
-               cell_voltages.num_of_cells_per_segment) *
-           V_PER_100UV;
+    return (float)cell_voltages.statistics.min * V_PER_100UV;
 }
 
-float App_AccumulatorVoltages_GetSegment1Voltage(void)
+float App_AccumulatorVoltages_GetMaxCellVoltage(void)
 {
-    return (float)App_SumOfArrayElements(
-               &cell_voltages.raw_cell_voltages
-                    [CELL_MONITOR_CHIP_1 *
-                     cell_voltages.num_of_cells_per_segment],
-               cell_voltages.num_of_cells_per_segment) *
-           V_PER_100UV;
+    return (float)cell_voltages.statistics.max * V_PER_100UV;
 }
 
-float App_AccumulatorVoltages_GetSegment2Voltage(void)
+float App_AccumulatorVoltages_GetPackVoltage(void)
 {
-    return 0.0f;
+    return (float)cell_voltages.statistics.sum * V_PER_100UV;
 }
 
-float App_AccumulatorVoltages_GetSegment3Voltage(void)
+float App_AccumulatorVoltages_GetAverageCellVoltage(void)
 {
-    return 0.0f;
+    return App_AccumulatorVoltages_GetPackVoltage() /
+           (float)(NUM_OF_CELL_MONITOR_CHIPS * NUM_OF_CELLS_PER_SEGMENT);
 }
 
-float App_AccumulatorVoltages_GetSegment4Voltage(void)
+float App_AccumulatorVoltages_GetSegmentVoltage(size_t segment)
 {
-    return 0.0f;
-}
+    if (segment >= NUM_OF_CELL_MONITOR_CHIPS)
+    {
+        return 0.0f;
+    }
 
-float App_AccumulatorVoltages_GetSegment5Voltage(void)
-{
-    return 0.0f;
+    return (float)cell_voltages.statistics.segment_sums[segment] * V_PER_100UV;
 }
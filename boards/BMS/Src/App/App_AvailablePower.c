@@ -0,0 +1,370 @@
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+#include "App_AvailablePower.h"
+#include "configs/App_AccumulatorThresholds.h"
+#include "configs/App_SocConfigs.h"
+
+struct AvailablePower
+{
+    const struct CellStatistics *(*get_cell_statistics)(void);
+    float (*get_main_current)(void);
+    ExitCode (*read_cell_temperatures)(void);
+    int32_t (*get_min_cell_temperature)(void);
+    int32_t (*get_max_cell_temperature)(void);
+
+    // The factors the series resistance of a cell group is scaled by to add
+    // the polarization resistance that has built up under the continuous and
+    // the pulse power limits
+    float continuous_resistance_factor;
+    float pulse_resistance_factor;
+
+    // The cell voltages (100µV) and the main current (A) of the last read,
+    // which the next read is differenced against
+    bool    has_last_read;
+    int32_t last_cell_voltages[NUM_OF_CELL_MONITOR_CHIPS]
+                              [NUM_OF_CELLS_PER_SEGMENT];
+    float last_main_current;
+
+    // The resistance estimate of every cell group (ohm), and its variance
+    // (ohm^2)
+    float resistances[NUM_OF_CELL_MONITOR_CHIPS][NUM_OF_CELLS_PER_SEGMENT];
+    float variances[NUM_OF_CELL_MONITOR_CHIPS][NUM_OF_CELLS_PER_SEGMENT];
+
+    float continuous_discharge_power;
+    float pulse_discharge_power;
+    float continuous_regen_power;
+    float pulse_regen_power;
+};
+
+/**
+ * Get the factor a current limit is derated by, which ramps linearly from 1 at
+ * the full value to 0 at the zero value
+ * @param value The value to derate the current limit by
+ * @param full_value The value at which the current limit isn't derated
+ * @param zero_value The value at which the current limit is derated to 0
+ * @return The derating factor, from 0 to 1
+ */
+static float App_GetDerating(float value, float full_value, float zero_value)
+{
+    const float derating = (value - zero_value) / (full_value - zero_value);
+    return fminf(fmaxf(derating, 0.0f), 1.0f);
+}
+
+/**
+ * Get the power the accumulator can supply or take at the highest current the
+ * weakest cell group allows
+ * @param cell_current_limit The lowest current (A) at which a cell group
+ * reaches its voltage limit, if its resistance isn't scaled
+ * @param resistance_factor The factor the series resistance of every cell group
+ * is scaled by
+ * @param max_current The derated maximum current (A)
+ * @param sum_open_circuit_voltages The sum of the open circuit voltages of
+ * every cell group (V)
+ * @param sum_resistances The sum of the series resistances of every cell group
+ * (ohm)
+ * @param is_regen Whether the accumulator is charged rather than discharged
+ * @return The power limit, in W
+ */
+static float App_GetPowerLimit(
+    float cell_current_limit,
+    float resistance_factor,
+    float max_current,
+    float sum_open_circuit_voltages,
+    float sum_resistances,
+    bool  is_regen)
+{
+    const float resistance = resistance_factor * sum_resistances;
+
+    float current = fminf(cell_current_limit / resistance_factor, max_current);
+    if (!is_regen)
+    {
+        // Discharging past this current only delivers less power
+        current =
+            fminf(current, sum_open_circuit_voltages / (2.0f * resistance));
+    }
+    if (current <= 0.0f)
+    {
+        return 0.0f;
+    }
+
+    const float terminal_voltage =
+        is_regen ? sum_open_circuit_voltages + current * resistance
+                 : sum_open_circuit_voltages - current * resistance;
+    return current * terminal_voltage;
+}
+
+/**
+ * Update the resistance estimate of every cell group with one RLS step on the
+ * change in its voltage across the change in the main current, for the model
+ * ΔV = -R * ΔI
+ * @param available_power The available power estimator to update
+ * @param cell_voltages The cell voltages of this read (100µV)
+ * @param main_current_step The change in the main current since the last read
+ * (A)
+ */
+static void App_UpdateResistances(
+    struct AvailablePower *const available_power,
+    int32_t cell_voltages[NUM_OF_CELL_MONITOR_CHIPS][NUM_OF_CELLS_PER_SEGMENT],
+    float   main_current_step)
+{
+    const float regressor = -main_current_step;
+
+    for (size_t segment = 0U; segment < NUM_OF_CELL_MONITOR_CHIPS; segment++)
+    {
+        for (size_t cell = 0U; cell < NUM_OF_CELLS_PER_SEGMENT; cell++)
+        {
+            float *const resistance =
+                &available_power->resistances[segment][cell];
+            float *const variance = &available_power->variances[segment][cell];
+
+            const int32_t voltage_step =
+                cell_voltages[segment][cell] -
+                available_power->last_cell_voltages[segment][cell];
+
+            const float denominator = RESISTANCE_ESTIMATION_FORGETTING_FACTOR +
+                                      regressor * regressor * *variance;
+            const float gain = *variance * regressor / denominator;
+            *resistance +=
+                gain * ((float)voltage_step * 1e-4f - regressor * *resistance);
+            *variance /= denominator;
+
+            *resistance = fminf(
+                fmaxf(*resistance, MIN_CELL_GROUP_RESISTANCE_OHMS),
+                MAX_CELL_GROUP_RESISTANCE_OHMS);
+        }
+    }
+}
+
+/**
+ * Compute the power limits of the accumulator from the voltage and the
+ * resistance estimate of every cell group
+ * @param available_power The available power estimator to compute the power
+ * limits of
+ * @param cell_voltages The cell voltages of this read (100µV)
+ * @param main_current The main current of this read (A)
+ * @param soc The state of charge of the accumulator, in %
+ */
+static void App_UpdatePowerLimits(
+    struct AvailablePower *const available_power,
+    int32_t cell_voltages[NUM_OF_CELL_MONITOR_CHIPS][NUM_OF_CELLS_PER_SEGMENT],
+    float   main_current,
+    float   soc)
+{
+    available_power->continuous_discharge_power = 0.0f;
+    available_power->pulse_discharge_power      = 0.0f;
+    available_power->continuous_regen_power     = 0.0f;
+    available_power->pulse_regen_power          = 0.0f;
+
+    // Without every cell temperature, the cells can't be kept in their
+    // operating range
+    if (available_power->read_cell_temperatures() != EXIT_CODE_OK)
+    {
+        return;
+    }
+    const float min_temperature =
+        (float)available_power->get_min_cell_temperature() / 10.0f;
+    const float max_temperature =
+        (float)available_power->get_max_cell_temperature() / 10.0f;
+
+    const float discharge_derating =
+        App_GetDerating(
+            max_temperature, DISCHARGE_FULL_MAX_TEMPERATURE_DEGC,
+            DISCHARGE_ZERO_MAX_TEMPERATURE_DEGC) *
+        App_GetDerating(
+            min_temperature, DISCHARGE_FULL_MIN_TEMPERATURE_DEGC,
+            DISCHARGE_ZERO_MIN_TEMPERATURE_DEGC) *
+        App_GetDerating(soc, DISCHARGE_FULL_SOC, DISCHARGE_ZERO_SOC);
+    const float regen_derating =
+        App_GetDerating(
+            max_temperature, REGEN_FULL_MAX_TEMPERATURE_DEGC,
+            REGEN_ZERO_MAX_TEMPERATURE_DEGC) *
+        App_GetDerating(
+            min_temperature, REGEN_FULL_MIN_TEMPERATURE_DEGC,
+            REGEN_ZERO_MIN_TEMPERATURE_DEGC) *
+        App_GetDerating(soc, REGEN_FULL_SOC, REGEN_ZERO_SOC);
+
+    // The lowest current at which a cell group reaches its minimum or maximum
+    // voltage, from the open circuit voltage backed out of its voltage under
+    // the main current
+    float sum_open_circuit_voltages = 0.0f;
+    float sum_resistances           = 0.0f;
+    float discharge_current_limit   = INFINITY;
+    float regen_current_limit       = INFINITY;
+    for (size_t segment = 0U; segment < NUM_OF_CELL_MONITOR_CHIPS; segment++)
+    {
+        for (size_t cell = 0U; cell < NUM_OF_CELLS_PER_SEGMENT; cell++)
+        {
+            const float resistance =
+                available_power->resistances[segment][cell];
+            const float open_circuit_voltage =
+                (float)cell_voltages[segment][cell] * 1e-4f +
+                resistance * main_current;
+
+            sum_open_circuit_voltages += open_circuit_voltage;
+            sum_resistances += resistance;
+            discharge_current_limit = fminf(
+                discharge_current_limit,
+                (open_circuit_voltage - MIN_CELL_VOLTAGE) / resistance);
+            regen_current_limit = fminf(
+                regen_current_limit,
+                (MAX_CELL_VOLTAGE - open_circuit_voltage) / resistance);
+        }
+    }
+
+    available_power->continuous_discharge_power = App_GetPowerLimit(
+        discharge_current_limit, available_power->continuous_resistance_factor,
+        MAX_CONTINUOUS_DISCHARGE_CURRENT_A * discharge_derating,
+        sum_open_circuit_voltages, sum_resistances, false);
+    available_power->pulse_discharge_power = App_GetPowerLimit(
+        discharge_current_limit, available_power->pulse_resistance_factor,
+        MAX_PULSE_DISCHARGE_CURRENT_A * discharge_derating,
+        sum_open_circuit_voltages, sum_resistances, false);
+    available_power->continuous_regen_power = App_GetPowerLimit(
+        regen_current_limit, available_power->continuous_resistance_factor,
+        MAX_CONTINUOUS_REGEN_CURRENT_A * regen_derating,
+        sum_open_circuit_voltages, sum_resistances, true);
+    available_power->pulse_regen_power = App_GetPowerLimit(
+        regen_current_limit, available_power->pulse_resistance_factor,
+        MAX_PULSE_REGEN_CURRENT_A * regen_derating, sum_open_circuit_voltages,
+        sum_resistances, true);
+}
+
+struct AvailablePower *App_AvailablePower_Create(
+    const struct CellStatistics *(*get_cell_statistics)(void),
+    float (*get_main_current)(void),
+    ExitCode (*read_cell_temperatures)(void),
+    int32_t (*get_min_cell_temperature)(void),
+    int32_t (*get_max_cell_temperature)(void))
+{
+    struct AvailablePower *available_power =
+        malloc(sizeof(struct AvailablePower));
+    assert(available_power != NULL);
+
+    available_power->get_cell_statistics      = get_cell_statistics;
+    available_power->get_main_current         = get_main_current;
+    available_power->read_cell_temperatures   = read_cell_temperatures;
+    available_power->get_min_cell_temperature = get_min_cell_temperature;
+    available_power->get_max_cell_temperature = get_max_cell_temperature;
+
+    // The polarization voltage of the RC pair has fully built up under a
+    // continuous current, and has built up by 1 - e^(-t/RC) after a pulse
+    const float polarization_ratio = CELL_GROUP_POLARIZATION_RESISTANCE_OHMS /
+                                     CELL_GROUP_SERIES_RESISTANCE_OHMS;
+    const float time_constant = CELL_GROUP_POLARIZATION_RESISTANCE_OHMS *
+                                CELL_GROUP_POLARIZATION_CAPACITANCE_F;
+    available_power->continuous_resistance_factor = 1.0f + polarization_ratio;
+    available_power->pulse_resistance_factor =
+        1.0f + polarization_ratio *
+                   (1.0f - expf(-PULSE_POWER_DURATION_S / time_constant));
+
+    available_power->has_last_read     = false;
+    available_power->last_main_current = 0.0f;
+    memset(
+        available_power->last_cell_voltages, 0,
+        sizeof(available_power->last_cell_voltages));
+    for (size_t segment = 0U; segment < NUM_OF_CELL_MONITOR_CHIPS; segment++)
+    {
+        for (size_t cell = 0U; cell < NUM_OF_CELLS_PER_SEGMENT; cell++)
+        {
+            available_power->resistances[segment][cell] =
+                CELL_GROUP_SERIES_RESISTANCE_OHMS;
+            available_power->variances[segment][cell] =
+                RESISTANCE_ESTIMATION_INITIAL_VARIANCE;
+        }
+    }
+
+    available_power->continuous_discharge_power = 0.0f;
+    available_power->pulse_discharge_power      = 0.0f;
+    available_power->continuous_regen_power     = 0.0f;
+    available_power->pulse_regen_power          = 0.0f;
+
+    return available_power;
+}
+
+void App_AvailablePower_Destroy(struct AvailablePower *available_power)
+{
+    free(available_power);
+}
+
+void App_AvailablePower_Tick100Hz(
+    struct AvailablePower *const available_power,
+    bool                         has_read_cell_voltages,
+    float                        soc)
+{
+    if (!has_read_cell_voltages)
+    {
+        return;
+    }
+
+    const struct CellStatistics *const statistics =
+        available_power->get_cell_statistics();
+    const float main_current = available_power->get_main_current();
+
+    int32_t cell_voltages[NUM_OF_CELL_MONITOR_CHIPS][NUM_OF_CELLS_PER_SEGMENT];
+    for (size_t segment = 0U; segment < NUM_OF_CELL_MONITOR_CHIPS; segment++)
+    {
+        for (size_t cell = 0U; cell < NUM_OF_CELLS_PER_SEGMENT; cell++)
+        {
+            cell_voltages[segment][cell] =
+                (int32_t)statistics->mean +
+                statistics->deltas_from_mean[segment][cell];
+        }
+    }
+
+    // Only a large enough step in the main current excites the resistance of
+    // the cell groups above the noise of the cell voltages. The same cell
+    // voltages read twice have no step, since their main current was sampled
+    // with them.
+    const float main_current_step =
+        main_current - available_power->last_main_current;
+    if (available_power->has_last_read &&
+        fabsf(main_current_step) >= MIN_RESISTANCE_ESTIMATION_CURRENT_STEP_A)
+    {
+        App_UpdateResistances(
+            available_power, cell_voltages, main_current_step);
+    }
+
+    memcpy(
+        available_power->last_cell_voltages, cell_voltages,
+        sizeof(cell_voltages));
+    available_power->last_main_current = main_current;
+    available_power->has_last_read     = true;
+
+    App_UpdatePowerLimits(available_power, cell_voltages, main_current, soc);
+}
+
+float App_AvailablePower_GetCellResistance(
+    const struct AvailablePower *const available_power,
+    size_t                             segment,
+    size_t                             cell)
+{
+    assert(segment < NUM_OF_CELL_MONITOR_CHIPS);
+    assert(cell < NUM_OF_CELLS_PER_SEGMENT);
+
+    return available_power->resistances[segment][cell];
+}
+
+float App_AvailablePower_GetContinuousDischargePower(
+    const struct AvailablePower *const available_power)
+{
+    return available_power->continuous_discharge_power;
+}
+
+float App_AvailablePower_GetPulseDischargePower(
+    const struct AvailablePower *const available_power)
+{
+    return available_power->pulse_discharge_power;
+}
+
+float App_AvailablePower_GetContinuousRegenPower(
+    const struct AvailablePower *const available_power)
+{
+    return available_power->continuous_regen_power;
+}
+
+float App_AvailablePower_GetPulseRegenPower(
+    const struct AvailablePower *const available_power)
+{
+    return available_power->pulse_regen_power;
+}
@@ -1,8 +1,12 @@
+#include <stddef.h>
 #include <stdlib.h>
 #include <assert.h>
 
 #include "App_BmsWorld.h"
 
+// The number of inputs sampled into the sensor snapshot
+#define NUM_SENSOR_SNAPSHOT_INPUTS 6U
+
 struct BmsWorld
 {
     struct BmsCanTxInterface *can_tx_interface;
@@ -16,12 +20,50 @@ struct BmsWorld
     struct OkStatus *         bspd_ok;
     struct Accumulator *      accumulator;
     struct CellMonitors *     cell_monitors;
+    struct CellBalancing *    cell_balancing;
+    struct SocEstimator *     soc_estimator;
+    struct CellDiagnostics *  cell_diagnostics;
+    struct AvailablePower *   available_power;
     struct Airs *             airs;
     struct PreChargeSequence *pre_charge_sequence;
     struct ErrorTable *       error_table;
     struct Clock *            clock;
+    struct SensorSnapshot *   sensor_snapshot_100Hz;
 };
 
+// The functions used to sample each input of the sensor snapshot
+static bool App_SampleIsAirNegativeClosed(struct BmsWorld *const world)
+{
+    return App_SharedBinaryStatus_IsActive(
+        App_Airs_GetAirNegative(world->airs));
+}
+
+static bool App_SampleIsAirPositiveClosed(struct BmsWorld *const world)
+{
+    return App_SharedBinaryStatus_IsActive(
+        App_Airs_GetAirPositive(world->airs));
+}
+
+static bool App_SampleIsBmsOkEnabled(struct BmsWorld *const world)
+{
+    return App_OkStatus_IsEnabled(world->bms_ok);
+}
+
+static bool App_SampleIsImdOkEnabled(struct BmsWorld *const world)
+{
+    return App_OkStatus_IsEnabled(world->imd_ok);
+}
+
+static bool App_SampleIsBspdOkEnabled(struct BmsWorld *const world)
+{
+    return App_OkStatus_IsEnabled(world->bspd_ok);
+}
+
+static bool App_SampleIsChargerConnected(struct BmsWorld *const world)
+{
+    return App_Charger_IsConnected(world->charger);
+}
+
 struct BmsWorld *App_BmsWorld_Create(
     struct BmsCanTxInterface *const can_tx_interface,
     struct BmsCanRxInterface *const can_rx_interface,
@@ -34,6 +76,10 @@ struct BmsWorld *App_BmsWorld_Create(
     struct OkStatus *const          bspd_ok,
     struct Accumulator *const       accumulator,
     struct CellMonitors *const      cell_monitors,
+    struct CellBalancing *const     cell_balancing,
+    struct SocEstimator *const      soc_estimator,
+    struct CellDiagnostics *const   cell_diagnostics,
+    struct AvailablePower *const    available_power,
     struct Airs *const              airs,
     struct PreChargeSequence *const pre_charge_sequence,
     struct ErrorTable *const        error_table,
@@ -53,16 +99,46 @@ struct BmsWorld *App_BmsWorld_Create(
     world->bspd_ok             = bspd_ok;
     world->accumulator         = accumulator;
     world->cell_monitors       = cell_monitors;
+    world->cell_balancing      = cell_balancing;
+    world->soc_estimator       = soc_estimator;
+    world->cell_diagnostics    = cell_diagnostics;
+    world->available_power     = available_power;
     world->airs                = airs;
     world->pre_charge_sequence = pre_charge_sequence;
     world->error_table         = error_table;
     world->clock               = clock;
 
+    struct SensorSnapshot *sensor_snapshot = App_SharedSensorSnapshot_Create(
+        world, sizeof(struct BmsSensorSnapshot), NUM_SENSOR_SNAPSHOT_INPUTS);
+    App_SharedSensorSnapshot_AddBoolInput(
+        sensor_snapshot,
+        offsetof(struct BmsSensorSnapshot, is_air_negative_closed),
+        App_SampleIsAirNegativeClosed);
+    App_SharedSensorSnapshot_AddBoolInput(
+        sensor_snapshot,
+        offsetof(struct BmsSensorSnapshot, is_air_positive_closed),
+        App_SampleIsAirPositiveClosed);
+    App_SharedSensorSnapshot_AddBoolInput(
+        sensor_snapshot, offsetof(struct BmsSensorSnapshot, is_bms_ok_enabled),
+        App_SampleIsBmsOkEnabled);
+    App_SharedSensorSnapshot_AddBoolInput(
+        sensor_snapshot, offsetof(struct BmsSensorSnapshot, is_imd_ok_enabled),
+        App_SampleIsImdOkEnabled);
+    App_SharedSensorSnapshot_AddBoolInput(
+        sensor_snapshot, offsetof(struct BmsSensorSnapshot, is_bspd_ok_enabled),
+        App_SampleIsBspdOkEnabled);
+    App_SharedSensorSnapshot_AddBoolInput(
+        sensor_snapshot,
+        offsetof(struct BmsSensorSnapshot, is_charger_connected),
+        App_SampleIsChargerConnected);
+    world->sensor_snapshot_100Hz = sensor_snapshot;
+
     return world;
 }
 
 void App_BmsWorld_Destroy(struct BmsWorld *world)
 {
+    App_SharedSensorSnapshot_Destroy(world->sensor_snapshot_100Hz);
     free(world);
 }
 
@@ -128,6 +204,30 @@ struct CellMonitors *
     return world->cell_monitors;
 }
 
+struct CellBalancing *
+    App_BmsWorld_GetCellBalancing(const struct BmsWorld *const world)
+{
+    return world->cell_balancing;
+}
+
+struct SocEstimator *
+    App_BmsWorld_GetSocEstimator(const struct BmsWorld *const world)
+{
+    return world->soc_estimator;
+}
+
+struct CellDiagnostics *
+    App_BmsWorld_GetCellDiagnostics(const struct BmsWorld *const world)
+{
+    return world->cell_diagnostics;
+}
+
+struct AvailablePower *
+    App_BmsWorld_GetAvailablePower(const struct BmsWorld *const world)
+{
+    return world->available_power;
+}
+
 struct Airs *App_BmsWorld_GetAirs(const struct BmsWorld *const world)
 {
     return world->airs;
@@ -149,3 +249,14 @@ struct Clock *App_BmsWorld_GetClock(const struct BmsWorld *const world)
 {
     return world->clock;
 }
+
+void App_BmsWorld_SampleSensors100Hz(const struct BmsWorld *const world)
+{
+    App_SharedSensorSnapshot_Sample(world->sensor_snapshot_100Hz);
+}
+
+const struct BmsSensorSnapshot *
+    App_BmsWorld_GetSensorSnapshot100Hz(const struct BmsWorld *const world)
+{
+    return App_SharedSensorSnapshot_Get(world->sensor_snapshot_100Hz);
+}
@@ -0,0 +1,329 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "App_CellBalancing.h"
+
+// The LTC6813 has 18 discharge switches, and every segment's bitmask must fit
+// into one of them
+static_assert(
+    NUM_OF_CELLS_PER_SEGMENT <= 18U,
+    "Every cell must have a discharge switch on its cell monitor");
+static_assert(
+    MAX_BALANCING_DISCHARGE_TICKS < BALANCING_PERIOD_TICKS,
+    "Every balancing period must end with a measurement window");
+
+struct CellBalancing
+{
+    ExitCode (*write_discharge_cells)(const uint32_t *);
+    const struct CellStatistics *(*get_cell_statistics)(void);
+    float (*get_max_die_temp)(void);
+    uint16_t balancing_threshold;
+    float    die_temp_to_throttle_degc;
+    float    die_temp_to_re_enable_degc;
+    float    die_temp_to_disable_degc;
+
+    // The tick of the current balancing period, and the number of ticks the
+    // picked cells discharge for at the start of it
+    uint32_t tick;
+    uint32_t discharge_ticks;
+    uint32_t discharge_cells[NUM_OF_CELL_MONITOR_CHIPS];
+
+    // The cells that last discharged, which read low until they have recovered
+    uint32_t discharged_cells[NUM_OF_CELL_MONITOR_CHIPS];
+
+    // The discharge switches that were last written to the cell monitors, so
+    // they are only written again when they change
+    uint32_t written_discharge_cells[NUM_OF_CELL_MONITOR_CHIPS];
+
+    bool     is_disabled_by_die_temp;
+    bool     is_discharging;
+    bool     is_settling;
+    uint32_t discharge_stop_ms;
+};
+
+/**
+ * Write the given discharge switches to the cell monitors, unless they are
+ * already set
+ * @param cell_balancing The cell balancing scheduler to write the discharge
+ * switches for
+ * @param discharge_cells The discharge switches to write
+ */
+static void App_WriteDischargeCells(
+    struct CellBalancing *const cell_balancing,
+    const uint32_t *const       discharge_cells)
+{
+    if (memcmp(
+            cell_balancing->written_discharge_cells, discharge_cells,
+            sizeof(cell_balancing->written_discharge_cells)) == 0)
+    {
+        return;
+    }
+
+    if (cell_balancing->write_discharge_cells(discharge_cells) == EXIT_CODE_OK)
+    {
+        memcpy(
+            cell_balancing->written_discharge_cells, discharge_cells,
+            sizeof(cell_balancing->written_discharge_cells));
+    }
+}
+
+/**
+ * Turn off every discharge switch, and start waiting for the cell voltages to
+ * recover if any cell was discharging
+ * @param cell_balancing The cell balancing scheduler to stop discharging for
+ * @param current_ms The current time, in milliseconds
+ */
+static void App_StopDischarging(
+    struct CellBalancing *const cell_balancing,
+    uint32_t                    current_ms)
+{
+    const uint32_t no_discharge_cells[NUM_OF_CELL_MONITOR_CHIPS] = { 0U };
+    App_WriteDischargeCells(cell_balancing, no_discharge_cells);
+
+    if (cell_balancing->is_discharging)
+    {
+        cell_balancing->is_discharging    = false;
+        cell_balancing->is_settling       = true;
+        cell_balancing->discharge_stop_ms = current_ms;
+    }
+}
+
+/**
+ * Get the number of ticks to discharge for in the next balancing period, which
+ * is reduced linearly from the throttle die temperature until balancing is
+ * disabled at the disable die temperature
+ * @param cell_balancing The cell balancing scheduler to get the number of ticks
+ * for
+ * @return The number of ticks to discharge for
+ */
+static uint32_t
+    App_GetDischargeTicks(struct CellBalancing *const cell_balancing)
+{
+    const float max_die_temp = cell_balancing->get_max_die_temp();
+
+    if (max_die_temp >= cell_balancing->die_temp_to_disable_degc)
+    {
+        cell_balancing->is_disabled_by_die_temp = true;
+    }
+    else if (max_die_temp < cell_balancing->die_temp_to_re_enable_degc)
+    {
+        cell_balancing->is_disabled_by_die_temp = false;
+    }
+
+    if (cell_balancing->is_disabled_by_die_temp)
+    {
+        return 0U;
+    }
+
+    if (max_die_temp <= cell_balancing->die_temp_to_throttle_degc)
+    {
+        return MAX_BALANCING_DISCHARGE_TICKS;
+    }
+
+    return (uint32_t)(
+        MAX_BALANCING_DISCHARGE_TICKS *
+        (cell_balancing->die_temp_to_disable_degc - max_die_temp) /
+        (cell_balancing->die_temp_to_disable_degc -
+         cell_balancing->die_temp_to_throttle_degc));
+}
+
+/**
+ * Pick the cells that are more than the balancing threshold above the minimum
+ * cell voltage
+ * @param cell_balancing The cell balancing scheduler to pick the cells for
+ * @return true if at least one cell was picked, false otherwise
+ */
+static bool App_PickDischargeCells(struct CellBalancing *const cell_balancing)
+{
+    const struct CellStatistics *const statistics =
+        cell_balancing->get_cell_statistics();
+
+    // Compare each cell's delta from the mean against the minimum cell's, so
+    // the cell voltages don't have to be read again
+    const int32_t threshold_delta =
+        (int32_t)statistics->min - (int32_t)statistics->mean +
+        (int32_t)cell_balancing->balancing_threshold;
+
+    bool is_any_cell_picked = false;
+    for (size_t segment = 0U; segment < NUM_OF_CELL_MONITOR_CHIPS; segment++)
+    {
+        uint32_t discharge_cells = 0U;
+        for (size_t cell = 0U; cell < NUM_OF_CELLS_PER_SEGMENT; cell++)
+        {
+            if (statistics->deltas_from_mean[segment][cell] > threshold_delta)
+            {
+                discharge_cells |= 1U << cell;
+            }
+        }
+
+        cell_balancing->discharge_cells[segment] = discharge_cells;
+        is_any_cell_picked |= discharge_cells != 0U;
+    }
+
+    return is_any_cell_picked;
+}
+
+struct CellBalancing *App_CellBalancing_Create(
+    ExitCode (*write_discharge_cells)(const uint32_t *),
+    const struct CellStatistics *(*get_cell_statistics)(void),
+    float (*get_max_die_temp)(void),
+    uint16_t balancing_threshold,
+    float    die_temp_to_throttle_degc,
+    float    die_temp_to_re_enable_degc,
+    float    die_temp_to_disable_degc)
+{
+    assert(die_temp_to_throttle_degc < die_temp_to_disable_degc);
+    assert(die_temp_to_re_enable_degc <= die_temp_to_disable_degc);
+
+    struct CellBalancing *cell_balancing = malloc(sizeof(struct CellBalancing));
+    assert(cell_balancing != NULL);
+
+    cell_balancing->write_discharge_cells      = write_discharge_cells;
+    cell_balancing->get_cell_statistics        = get_cell_statistics;
+    cell_balancing->get_max_die_temp           = get_max_die_temp;
+    cell_balancing->balancing_threshold        = balancing_threshold;
+    cell_balancing->die_temp_to_throttle_degc  = die_temp_to_throttle_degc;
+    cell_balancing->die_temp_to_re_enable_degc = die_temp_to_re_enable_degc;
+    cell_balancing->die_temp_to_disable_degc   = die_temp_to_disable_degc;
+
+    cell_balancing->tick            = 0U;
+    cell_balancing->discharge_ticks = 0U;
+    memset(
+        cell_balancing->discharge_cells, 0,
+        sizeof(cell_balancing->discharge_cells));
+    memset(
+        cell_balancing->discharged_cells, 0,
+        sizeof(cell_balancing->discharged_cells));
+    memset(
+        cell_balancing->written_discharge_cells, 0,
+        sizeof(cell_balancing->written_discharge_cells));
+    cell_balancing->is_disabled_by_die_temp = false;
+    cell_balancing->is_discharging          = false;
+    cell_balancing->is_settling             = false;
+    cell_balancing->discharge_stop_ms       = 0U;
+
+    return cell_balancing;
+}
+
+void App_CellBalancing_Destroy(struct CellBalancing *cell_balancing)
+{
+    free(cell_balancing);
+}
+
+void App_CellBalancing_Tick100Hz(
+    struct CellBalancing *const cell_balancing,
+    uint32_t                    current_ms)
+{
+    if (cell_balancing->tick == 0U)
+    {
+        // Wait for the cell voltages to recover if the scheduler was stopped
+        // while cells were discharging
+        if (!App_CellBalancing_CanReadCellVoltages(cell_balancing, current_ms))
+        {
+            return;
+        }
+
+        // The cell voltages were last read in the measurement window at the end
+        // of the previous balancing period
+        cell_balancing->discharge_ticks = App_GetDischargeTicks(cell_balancing);
+        if (App_PickDischargeCells(cell_balancing) &&
+            cell_balancing->discharge_ticks > 0U)
+        {
+            App_WriteDischargeCells(
+                cell_balancing, cell_balancing->discharge_cells);
+            memcpy(
+                cell_balancing->discharged_cells,
+                cell_balancing->discharge_cells,
+                sizeof(cell_balancing->discharged_cells));
+            cell_balancing->is_discharging = true;
+        }
+        else
+        {
+            memset(
+                cell_balancing->discharge_cells, 0,
+                sizeof(cell_balancing->discharge_cells));
+        }
+    }
+    else if (
+        cell_balancing->is_discharging &&
+        cell_balancing->tick >= cell_balancing->discharge_ticks)
+    {
+        App_StopDischarging(cell_balancing, current_ms);
+    }
+
+    cell_balancing->tick = (cell_balancing->tick + 1U) % BALANCING_PERIOD_TICKS;
+}
+
+void App_CellBalancing_Stop(
+    struct CellBalancing *const cell_balancing,
+    uint32_t                    current_ms)
+{
+    App_StopDischarging(cell_balancing, current_ms);
+
+    cell_balancing->tick            = 0U;
+    cell_balancing->discharge_ticks = 0U;
+    memset(
+        cell_balancing->discharge_cells, 0,
+        sizeof(cell_balancing->discharge_cells));
+}
+
+bool App_CellBalancing_CanReadCellVoltages(
+    const struct CellBalancing *const cell_balancing,
+    uint32_t                          current_ms)
+{
+    if (cell_balancing->is_discharging)
+    {
+        return false;
+    }
+
+    return !cell_balancing->is_settling ||
+           current_ms - cell_balancing->discharge_stop_ms >=
+               BALANCING_SETTLE_TIME_MS;
+}
+
+uint32_t App_CellBalancing_GetCompensatedMaxCellVoltage(
+    const struct CellBalancing *const cell_balancing,
+    uint32_t                          current_ms)
+{
+    const struct CellStatistics *const statistics =
+        cell_balancing->get_cell_statistics();
+
+    if (App_CellBalancing_CanReadCellVoltages(cell_balancing, current_ms))
+    {
+        return statistics->max;
+    }
+
+    int32_t max_delta_from_mean =
+        (int32_t)statistics->max - (int32_t)statistics->mean;
+    for (size_t segment = 0U; segment < NUM_OF_CELL_MONITOR_CHIPS; segment++)
+    {
+        for (size_t cell = 0U; cell < NUM_OF_CELLS_PER_SEGMENT; cell++)
+        {
+            if ((cell_balancing->discharged_cells[segment] & (1U << cell)) !=
+                0U)
+            {
+                const int32_t delta_from_mean =
+                    statistics->deltas_from_mean[segment][cell] +
+                    (int32_t)BALANCING_DISCHARGE_VOLTAGE_DROP_100UV;
+                if (delta_from_mean > max_delta_from_mean)
+                {
+                    max_delta_from_mean = delta_from_mean;
+                }
+            }
+        }
+    }
+
+    return (uint32_t)((int32_t)statistics->mean + max_delta_from_mean);
+}
+
+const uint32_t *App_CellBalancing_GetDischargeCells(
+    const struct CellBalancing *const cell_balancing)
+{
+    return cell_balancing->discharge_cells;
+}
+
+uint32_t App_CellBalancing_GetDischargeTicks(
+    const struct CellBalancing *const cell_balancing)
+{
+    return cell_balancing->discharge_ticks;
+}
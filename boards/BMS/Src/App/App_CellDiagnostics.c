@@ -0,0 +1,275 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "App_CellDiagnostics.h"
+
+// The registers the overlap conversion reads cells 7 and 13 back into
+#define CELL_7_ADC_1_REGISTER 6U
+#define CELL_7_ADC_2_REGISTER 7U
+#define CELL_13_ADC_2_REGISTER 12U
+#define CELL_13_ADC_3_REGISTER 13U
+
+static_assert(
+    NUM_OF_CELLS_PER_SEGMENT > CELL_13_ADC_3_REGISTER,
+    "The overlap conversion is read back from cells the segment monitors");
+
+struct DiagnosticResult
+{
+    // Whether the result has been set by enough consecutive evaluations, and
+    // whether it failed
+    bool is_tested;
+    bool is_failed;
+
+    // The last evaluation, and the number of consecutive evaluations with the
+    // same outcome
+    bool     last_is_failed;
+    uint32_t num_consecutive;
+};
+
+struct CellDiagnostics
+{
+    ExitCode (*read_diagnostic)(
+        enum CellDiagnostic,
+        uint16_t (*)[NUM_OF_CELLS_PER_SEGMENT]);
+    uint16_t open_wire_threshold;
+    uint16_t adc_overlap_threshold;
+    uint32_t num_consecutive_results;
+
+    // The latest result of every diagnostic, and whether it is waiting to be
+    // evaluated
+    uint16_t voltages[NUM_OF_CELL_DIAGNOSTICS][NUM_OF_CELL_MONITOR_CHIPS]
+                     [NUM_OF_CELLS_PER_SEGMENT];
+    bool is_pending[NUM_OF_CELL_DIAGNOSTICS];
+
+    struct DiagnosticResult open_wire_results[NUM_OF_CELL_MONITOR_CHIPS]
+                                             [NUM_OF_CELLS_PER_SEGMENT];
+    struct DiagnosticResult adc_overlap_results[NUM_OF_CELL_MONITOR_CHIPS];
+};
+
+/**
+ * Add an evaluation to the given diagnostic result, which only changes once
+ * enough consecutive evaluations agree
+ * @param result The diagnostic result to add the evaluation to
+ * @param is_failed Whether the evaluation failed
+ * @param num_consecutive_results The number of consecutive evaluations that
+ * must agree to change the result
+ */
+static void App_AddEvaluation(
+    struct DiagnosticResult *const result,
+    bool                           is_failed,
+    uint32_t                       num_consecutive_results)
+{
+    if (result->num_consecutive > 0U && result->last_is_failed == is_failed)
+    {
+        if (result->num_consecutive < num_consecutive_results)
+        {
+            result->num_consecutive++;
+        }
+    }
+    else
+    {
+        result->last_is_failed  = is_failed;
+        result->num_consecutive = 1U;
+    }
+
+    if (result->num_consecutive >= num_consecutive_results)
+    {
+        result->is_tested = true;
+        result->is_failed = is_failed;
+    }
+}
+
+/**
+ * Evaluate the latest pull-up and pull-down results for open wires. Pin C(n)
+ * is open when cell n + 1 reads lower with the pull-up current than with the
+ * pull-down current, except for the bottom pin, which is open when the bottom
+ * cell reads 0V with the pull-up current, and the top pin, which is open when
+ * the top cell reads 0V with the pull-down current.
+ * @param cell_diagnostics The cell diagnostics to evaluate
+ */
+static void App_EvaluateOpenWire(struct CellDiagnostics *const cell_diagnostics)
+{
+    uint16_t(*const pull_up)[NUM_OF_CELLS_PER_SEGMENT] =
+        cell_diagnostics->voltages[CELL_DIAGNOSTIC_OPEN_WIRE_PULL_UP];
+    uint16_t(*const pull_down)[NUM_OF_CELLS_PER_SEGMENT] =
+        cell_diagnostics->voltages[CELL_DIAGNOSTIC_OPEN_WIRE_PULL_DOWN];
+
+    for (size_t chip = 0U; chip < NUM_OF_CELL_MONITOR_CHIPS; chip++)
+    {
+        bool is_pin_open[NUM_OF_CELLS_PER_SEGMENT + 1U];
+
+        is_pin_open[0] = pull_up[chip][0] == 0U;
+        for (size_t pin = 1U; pin < NUM_OF_CELLS_PER_SEGMENT; pin++)
+        {
+            is_pin_open[pin] =
+                (int32_t)pull_up[chip][pin] - (int32_t)pull_down[chip][pin] <
+                -(int32_t)cell_diagnostics->open_wire_threshold;
+        }
+        is_pin_open[NUM_OF_CELLS_PER_SEGMENT] =
+            pull_down[chip][NUM_OF_CELLS_PER_SEGMENT - 1U] == 0U;
+
+        // Each cell is sensed by the pin below it and the pin above it
+        for (size_t cell = 0U; cell < NUM_OF_CELLS_PER_SEGMENT; cell++)
+        {
+            App_AddEvaluation(
+                &cell_diagnostics->open_wire_results[chip][cell],
+                is_pin_open[cell] || is_pin_open[cell + 1U],
+                cell_diagnostics->num_consecutive_results);
+        }
+    }
+}
+
+/**
+ * Evaluate the latest overlap result, where the two ADCs converting cell 7
+ * and the two ADCs converting cell 13 must agree
+ * @param cell_diagnostics The cell diagnostics to evaluate
+ */
+static void
+    App_EvaluateAdcOverlap(struct CellDiagnostics *const cell_diagnostics)
+{
+    uint16_t(*const overlap)[NUM_OF_CELLS_PER_SEGMENT] =
+        cell_diagnostics->voltages[CELL_DIAGNOSTIC_ADC_OVERLAP];
+
+    for (size_t chip = 0U; chip < NUM_OF_CELL_MONITOR_CHIPS; chip++)
+    {
+        const int32_t cell_7_difference =
+            (int32_t)overlap[chip][CELL_7_ADC_1_REGISTER] -
+            (int32_t)overlap[chip][CELL_7_ADC_2_REGISTER];
+        const int32_t cell_13_difference =
+            (int32_t)overlap[chip][CELL_13_ADC_2_REGISTER] -
+            (int32_t)overlap[chip][CELL_13_ADC_3_REGISTER];
+
+        App_AddEvaluation(
+            &cell_diagnostics->adc_overlap_results[chip],
+            abs(cell_7_difference) > cell_diagnostics->adc_overlap_threshold ||
+                abs(cell_13_difference) >
+                    cell_diagnostics->adc_overlap_threshold,
+            cell_diagnostics->num_consecutive_results);
+    }
+}
+
+struct CellDiagnostics *App_CellDiagnostics_Create(
+    ExitCode (*read_diagnostic)(
+        enum CellDiagnostic,
+        uint16_t (*)[NUM_OF_CELLS_PER_SEGMENT]),
+    uint16_t open_wire_threshold,
+    uint16_t adc_overlap_threshold,
+    uint32_t num_consecutive_results)
+{
+    assert(num_consecutive_results > 0U);
+
+    struct CellDiagnostics *cell_diagnostics =
+        malloc(sizeof(struct CellDiagnostics));
+    assert(cell_diagnostics != NULL);
+
+    cell_diagnostics->read_diagnostic         = read_diagnostic;
+    cell_diagnostics->open_wire_threshold     = open_wire_threshold;
+    cell_diagnostics->adc_overlap_threshold   = adc_overlap_threshold;
+    cell_diagnostics->num_consecutive_results = num_consecutive_results;
+
+    memset(cell_diagnostics->voltages, 0, sizeof(cell_diagnostics->voltages));
+    memset(
+        cell_diagnostics->is_pending, 0, sizeof(cell_diagnostics->is_pending));
+    memset(
+        cell_diagnostics->open_wire_results, 0,
+        sizeof(cell_diagnostics->open_wire_results));
+    memset(
+        cell_diagnostics->adc_overlap_results, 0,
+        sizeof(cell_diagnostics->adc_overlap_results));
+
+    return cell_diagnostics;
+}
+
+void App_CellDiagnostics_Destroy(struct CellDiagnostics *cell_diagnostics)
+{
+    free(cell_diagnostics);
+}
+
+void App_CellDiagnostics_Tick100Hz(
+    struct CellDiagnostics *const cell_diagnostics,
+    bool                          can_evaluate)
+{
+    for (size_t diagnostic = 0U; diagnostic < NUM_OF_CELL_DIAGNOSTICS;
+         diagnostic++)
+    {
+        if (cell_diagnostics->read_diagnostic(
+                (enum CellDiagnostic)diagnostic,
+                cell_diagnostics->voltages[diagnostic]) == EXIT_CODE_OK)
+        {
+            cell_diagnostics->is_pending[diagnostic] = true;
+        }
+
+        // Discharging cells disturb every diagnostic, and a pull-up result
+        // from before a discharge mustn't be paired with a pull-down result
+        // from after it
+        if (!can_evaluate)
+        {
+            cell_diagnostics->is_pending[diagnostic] = false;
+        }
+    }
+
+    bool *const is_pending = cell_diagnostics->is_pending;
+    if (is_pending[CELL_DIAGNOSTIC_OPEN_WIRE_PULL_UP] &&
+        is_pending[CELL_DIAGNOSTIC_OPEN_WIRE_PULL_DOWN])
+    {
+        App_EvaluateOpenWire(cell_diagnostics);
+        is_pending[CELL_DIAGNOSTIC_OPEN_WIRE_PULL_UP]   = false;
+        is_pending[CELL_DIAGNOSTIC_OPEN_WIRE_PULL_DOWN] = false;
+    }
+    if (is_pending[CELL_DIAGNOSTIC_ADC_OVERLAP])
+    {
+        App_EvaluateAdcOverlap(cell_diagnostics);
+        is_pending[CELL_DIAGNOSTIC_ADC_OVERLAP] = false;
+    }
+}
+
+enum CellDiagnosticStatus App_CellDiagnostics_GetCellStatus(
+    const struct CellDiagnostics *const cell_diagnostics,
+    size_t                              segment,
+    size_t                              cell)
+{
+    assert(segment < NUM_OF_CELL_MONITOR_CHIPS);
+    assert(cell < NUM_OF_CELLS_PER_SEGMENT);
+
+    const struct DiagnosticResult *const adc_overlap =
+        &cell_diagnostics->adc_overlap_results[segment];
+    const struct DiagnosticResult *const open_wire =
+        &cell_diagnostics->open_wire_results[segment][cell];
+
+    // An ADC mismatch takes precedence, since the open wire check is converted
+    // by the same ADCs
+    if (adc_overlap->is_tested && adc_overlap->is_failed)
+    {
+        return CELL_DIAGNOSTIC_STATUS_ADC_MISMATCH;
+    }
+    if (open_wire->is_tested && open_wire->is_failed)
+    {
+        return CELL_DIAGNOSTIC_STATUS_OPEN_WIRE;
+    }
+    if (adc_overlap->is_tested && open_wire->is_tested)
+    {
+        return CELL_DIAGNOSTIC_STATUS_OK;
+    }
+
+    return CELL_DIAGNOSTIC_STATUS_UNTESTED;
+}
+
+uint32_t App_CellDiagnostics_GetNumOfCellsWithStatus(
+    const struct CellDiagnostics *const cell_diagnostics,
+    enum CellDiagnosticStatus           status)
+{
+    uint32_t num_cells = 0U;
+    for (size_t segment = 0U; segment < NUM_OF_CELL_MONITOR_CHIPS; segment++)
+    {
+        for (size_t cell = 0U; cell < NUM_OF_CELLS_PER_SEGMENT; cell++)
+        {
+            if (App_CellDiagnostics_GetCellStatus(
+                    cell_diagnostics, segment, cell) == status)
+            {
+                num_cells++;
+            }
+        }
+    }
+
+    return num_cells;
+}
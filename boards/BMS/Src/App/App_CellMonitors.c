@@ -12,22 +12,12 @@ struct CellMonitors
     float die_temp_disable_charger_degc;
     float die_temp_disable_cell_balancing_degc;
 
-    struct InRangeCheck *cell_monitor_0_die_temp_in_range_check;
-    struct InRangeCheck *cell_monitor_1_die_temp_in_range_check;
-    struct InRangeCheck *cell_monitor_2_die_temp_in_range_check;
-    struct InRangeCheck *cell_monitor_3_die_temp_in_range_check;
-    struct InRangeCheck *cell_monitor_4_die_temp_in_range_check;
-    struct InRangeCheck *cell_monitor_5_die_temp_in_range_check;
+    struct InRangeCheck *die_temp_in_range_checks[NUM_OF_CELL_MONITOR_CHIPS];
 };
 
 struct CellMonitors *App_CellMonitors_Create(
     ExitCode (*read_die_temps)(void),
-    float (*get_monitor_0_die_temp)(void),
-    float (*get_monitor_1_die_temp)(void),
-    float (*get_monitor_2_die_temp)(void),
-    float (*get_monitor_3_die_temp)(void),
-    float (*get_monitor_4_die_temp)(void),
-    float (*get_monitor_5_die_temp)(void),
+    float (*get_die_temp)(size_t),
     float (*get_max_die_temp)(void),
     float min_die_temp_degc,
     float max_die_temp_degc,
@@ -51,36 +41,22 @@ struct CellMonitors *App_CellMonitors_Create(
     cell_monitors->die_temp_disable_charger_degc =
         die_temp_to_disable_charger_degc;
 
-    cell_monitors->cell_monitor_0_die_temp_in_range_check =
-        App_InRangeCheck_Create(
-            get_monitor_0_die_temp, min_die_temp_degc, max_die_temp_degc);
-    cell_monitors->cell_monitor_1_die_temp_in_range_check =
-        App_InRangeCheck_Create(
-            get_monitor_1_die_temp, min_die_temp_degc, max_die_temp_degc);
-    cell_monitors->cell_monitor_2_die_temp_in_range_check =
-        App_InRangeCheck_Create(
-            get_monitor_2_die_temp, min_die_temp_degc, max_die_temp_degc);
-    cell_monitors->cell_monitor_3_die_temp_in_range_check =
-        App_InRangeCheck_Create(
-            get_monitor_3_die_temp, min_die_temp_degc, max_die_temp_degc);
-    cell_monitors->cell_monitor_4_die_temp_in_range_check =
-        App_InRangeCheck_Create(
-            get_monitor_4_die_temp, min_die_temp_degc, max_die_temp_degc);
-    cell_monitors->cell_monitor_5_die_temp_in_range_check =
-        App_InRangeCheck_Create(
-            get_monitor_5_die_temp, min_die_temp_degc, max_die_temp_degc);
+    for (size_t chip = 0U; chip < NUM_OF_CELL_MONITOR_CHIPS; chip++)
+    {
+        cell_monitors->die_temp_in_range_checks[chip] =
+            App_InRangeCheck_CreateForIndex(
+                get_die_temp, chip, min_die_temp_degc, max_die_temp_degc);
+    }
 
     return cell_monitors;
 }
 
 void App_CellMonitors_Destroy(struct CellMonitors *cell_monitors)
 {
-    free(cell_monitors->cell_monitor_0_die_temp_in_range_check);
-    free(cell_monitors->cell_monitor_1_die_temp_in_range_check);
-    free(cell_monitors->cell_monitor_2_die_temp_in_range_check);
-    free(cell_monitors->cell_monitor_3_die_temp_in_range_check);
-    free(cell_monitors->cell_monitor_4_die_temp_in_range_check);
-    free(cell_monitors->cell_monitor_5_die_temp_in_range_check);
+    for (size_t chip = 0U; chip < NUM_OF_CELL_MONITOR_CHIPS; chip++)
+    {
+        free(cell_monitors->die_temp_in_range_checks[chip]);
+    }
     free(cell_monitors);
 }
 
@@ -90,40 +66,12 @@ ExitCode App_CellMonitors_ReadDieTemps(
     return cell_monitors->read_die_temps();
 }
 
-struct InRangeCheck *App_CellMonitors_GetCellMonitor0DieTempInRangeCheck(
-    const struct CellMonitors *const cell_monitors)
-{
-    return cell_monitors->cell_monitor_0_die_temp_in_range_check;
-}
-
-struct InRangeCheck *App_CellMonitors_GetCellMonitor1DieTempInRangeCheck(
-    const struct CellMonitors *const cell_monitors)
-{
-    return cell_monitors->cell_monitor_1_die_temp_in_range_check;
-}
-
-struct InRangeCheck *App_CellMonitors_GetCellMonitor2DieTempInRangeCheck(
-    const struct CellMonitors *const cell_monitors)
-{
-    return cell_monitors->cell_monitor_2_die_temp_in_range_check;
-}
-
-struct InRangeCheck *App_CellMonitors_GetCellMonitor3DieTempInRangeCheck(
-    const struct CellMonitors *const cell_monitors)
-{
-    return cell_monitors->cell_monitor_3_die_temp_in_range_check;
-}
-
-struct InRangeCheck *App_CellMonitors_GetCellMonitor4DieTempInRangeCheck(
-    const struct CellMonitors *const cell_monitors)
-{
-    return cell_monitors->cell_monitor_4_die_temp_in_range_check;
-}
-
-struct InRangeCheck *App_CellMonitors_GetCellMonitor5DieTempInRangeCheck(
-    const struct CellMonitors *const cell_monitors)
+struct InRangeCheck *App_CellMonitors_GetDieTempInRangeCheck(
+    const struct CellMonitors *const cell_monitors,
+    size_t                           chip)
 {
-    return cell_monitors->cell_monitor_5_die_temp_in_range_check;
+    assert(chip < NUM_OF_CELL_MONITOR_CHIPS);
+    return cell_monitors->die_temp_in_range_checks[chip];
 }
 
 enum ITMPInRangeCheck App_CellMonitors_GetMaxDieTempDegC(
@@ -0,0 +1,62 @@
+#include "App_CellStatistics.h"
+
+#define NUM_OF_CELLS (NUM_OF_CELL_MONITOR_CHIPS * NUM_OF_CELLS_PER_SEGMENT)
+
+void App_CellStatistics_Compute(
+    const uint16_t cells[NUM_OF_CELL_MONITOR_CHIPS][NUM_OF_CELLS_PER_SEGMENT],
+    struct CellStatistics *const statistics)
+{
+    uint16_t            min          = cells[0][0];
+    uint16_t            max          = cells[0][0];
+    struct CellLocation min_location = { 0U, 0U };
+    struct CellLocation max_location = { 0U, 0U };
+    uint32_t            sum          = 0U;
+
+    for (size_t segment = 0U; segment < NUM_OF_CELL_MONITOR_CHIPS; segment++)
+    {
+        const uint16_t *const segment_cells = cells[segment];
+        uint32_t              segment_sum   = 0U;
+
+        for (size_t cell = 0U; cell < NUM_OF_CELLS_PER_SEGMENT; cell++)
+        {
+            const uint16_t value = segment_cells[cell];
+            segment_sum += value;
+
+            if (value < min)
+            {
+                min                  = value;
+                min_location.segment = segment;
+                min_location.cell    = cell;
+            }
+            if (value > max)
+            {
+                max                  = value;
+                max_location.segment = segment;
+                max_location.cell    = cell;
+            }
+        }
+
+        statistics->segment_sums[segment] = segment_sum;
+        sum += segment_sum;
+    }
+
+    statistics->min          = min;
+    statistics->min_location = min_location;
+    statistics->max          = max;
+    statistics->max_location = max_location;
+    statistics->spread       = (uint16_t)(max - min);
+    statistics->sum          = sum;
+    statistics->mean = (uint16_t)((sum + NUM_OF_CELLS / 2U) / NUM_OF_CELLS);
+
+    // The mean is only known once every cell has been summed, so the deltas
+    // from the mean take a second, branchless pass over the cells
+    const int32_t mean = statistics->mean;
+    for (size_t segment = 0U; segment < NUM_OF_CELL_MONITOR_CHIPS; segment++)
+    {
+        for (size_t cell = 0U; cell < NUM_OF_CELLS_PER_SEGMENT; cell++)
+        {
+            statistics->deltas_from_mean[segment][cell] =
+                (int32_t)cells[segment][cell] - mean;
+        }
+    }
+}
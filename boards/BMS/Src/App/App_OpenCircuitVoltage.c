@@ -0,0 +1,98 @@
+#include <stddef.h>
+#include "App_OpenCircuitVoltage.h"
+
+// The open circuit voltage table has an entry every 5% SoC, from 0% to 100%
+#define SOC_PER_ENTRY 5.0f
+#define NUM_OF_ENTRIES 21U
+
+// The open circuit voltages (V) of a Molicel INR21700-P42A cell at rest, at
+// every 5% SoC from 0% to 100%. The voltages strictly increase with SoC, so
+// the table can be searched in either direction.
+static const float open_circuit_voltages[NUM_OF_ENTRIES] = {
+    3.000f, 3.300f, 3.420f, 3.500f, 3.550f, 3.590f, 3.620f,
+    3.650f, 3.680f, 3.710f, 3.740f, 3.780f, 3.820f, 3.860f,
+    3.900f, 3.940f, 3.980f, 4.030f, 4.080f, 4.140f, 4.200f,
+};
+
+/**
+ * Get the index of the table entry at or below the given SoC, and how far the
+ * SoC is from that entry towards the next
+ * @param soc The SoC to look up, in %
+ * @param fraction This will be set to how far the SoC is from the returned
+ * entry towards the next, from 0 to 1
+ * @return The index of the table entry at or below the given SoC, from 0 to
+ * NUM_OF_ENTRIES - 2
+ */
+static size_t App_GetEntryIndex(float soc, float *const fraction)
+{
+    if (soc <= 0.0f)
+    {
+        *fraction = 0.0f;
+        return 0U;
+    }
+
+    const float position = soc / SOC_PER_ENTRY;
+    if (position >= (float)(NUM_OF_ENTRIES - 1U))
+    {
+        *fraction = 1.0f;
+        return NUM_OF_ENTRIES - 2U;
+    }
+
+    const size_t index = (size_t)position;
+    *fraction          = position - (float)index;
+    return index;
+}
+
+float App_OpenCircuitVoltage_GetCellVoltage(float soc)
+{
+    float        fraction;
+    const size_t index = App_GetEntryIndex(soc, &fraction);
+
+    return open_circuit_voltages[index] +
+           fraction * (open_circuit_voltages[index + 1U] -
+                       open_circuit_voltages[index]);
+}
+
+float App_OpenCircuitVoltage_GetSlope(float soc)
+{
+    float        fraction;
+    const size_t index = App_GetEntryIndex(soc, &fraction);
+
+    return (open_circuit_voltages[index + 1U] - open_circuit_voltages[index]) /
+           SOC_PER_ENTRY;
+}
+
+float App_OpenCircuitVoltage_GetSoc(float cell_voltage)
+{
+    if (cell_voltage <= open_circuit_voltages[0])
+    {
+        return 0.0f;
+    }
+
+    if (cell_voltage >= open_circuit_voltages[NUM_OF_ENTRIES - 1U])
+    {
+        return 100.0f;
+    }
+
+    // Binary search for the entry at or below the given voltage, which takes
+    // at most 5 iterations for 21 entries
+    size_t low  = 0U;
+    size_t high = NUM_OF_ENTRIES - 1U;
+    while (high - low > 1U)
+    {
+        const size_t middle = (low + high) / 2U;
+        if (open_circuit_voltages[middle] <= cell_voltage)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return ((float)low +
+            (cell_voltage - open_circuit_voltages[low]) /
+                (open_circuit_voltages[high] - open_circuit_voltages[low])) *
+           SOC_PER_ENTRY;
+}
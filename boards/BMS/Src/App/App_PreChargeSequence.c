@@ -1,17 +1,191 @@
 #include <assert.h>
+#include <math.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include "App_PreChargeSequence.h"
 
+// The number of tractive system voltages read at once
+#define NUM_OF_VOLTAGES_PER_READ 16U
+
+// The period App_PreChargeSequence_Tick100Hz() is called at (s)
+#define TICK_PERIOD_S 0.01f
+
 struct PreChargeSequence
 {
     void (*enable_pre_charge_sequence)(void);
     void (*disable_pre_charge_sequence)(void);
+    size_t (*read_tractive_system_voltages)(float *, size_t);
+    float (*get_pack_voltage)(void);
+    float sample_period_s;
+
+    // An open precharge resistor is detected once the tractive system voltage
+    // hasn't started rising by the time the slowest plausible charging curve
+    // would have, and a precharge that stalls is detected once it hasn't
+    // completed by the time the slowest plausible charging curve would have
+    float max_rise_time_s;
+    float max_pre_charge_time_s;
+
+    enum PreChargeSequenceStatus status;
+    uint32_t                     num_ticks;
+    uint32_t                     num_samples;
+
+    // The latest samples, whose average is compared against the pack voltage
+    float latest_voltages[NUM_OF_PRE_CHARGE_COMPLETE_SAMPLES];
+    float sum_of_latest_voltages;
+    float initial_voltage;
+
+    // The sums of the least squares fit of y = ln(V_charge / (V_charge - V))
+    // against the time t since the first sample, whose slope is 1 / tau. The
+    // intercept absorbs the time the precharge relay takes to close.
+    uint32_t num_fit_samples;
+    float    sum_t;
+    float    sum_y;
+    float    sum_ty;
+    float    sum_tt;
 };
 
+/**
+ * Check the fitted time constant of the given pre-charge sequence against the
+ * plausible time constants
+ * @param pre_charge_sequence The pre-charge sequence to check
+ * @param status The status to return if the fitted time constant is plausible
+ * @return The given status if the fitted time constant is plausible, or why it
+ * isn't
+ */
+static enum PreChargeSequenceStatus App_CheckTimeConstant(
+    const struct PreChargeSequence *const pre_charge_sequence,
+    enum PreChargeSequenceStatus          status)
+{
+    const float time_constant =
+        App_PreChargeSequence_GetTimeConstant(pre_charge_sequence);
+
+    if (time_constant < MIN_PRE_CHARGE_TIME_CONSTANT_S)
+    {
+        return PRE_CHARGE_SEQUENCE_TIME_CONSTANT_TOO_SHORT;
+    }
+    if (time_constant > MAX_PRE_CHARGE_TIME_CONSTANT_S)
+    {
+        return PRE_CHARGE_SEQUENCE_TIME_CONSTANT_TOO_LONG;
+    }
+    return status;
+}
+
+/**
+ * Fit the charging curve of the given pre-charge sequence on one more tractive
+ * system voltage sample
+ * @param pre_charge_sequence The pre-charge sequence to fit
+ * @param tractive_system_voltage The tractive system voltage sampled, in V
+ * @param pack_voltage The pack voltage, in V
+ * @return The status of the given pre-charge sequence after the sample
+ */
+static enum PreChargeSequenceStatus App_FitVoltage(
+    struct PreChargeSequence *const pre_charge_sequence,
+    float                           tractive_system_voltage,
+    float                           pack_voltage)
+{
+    const float t = (float)pre_charge_sequence->num_samples *
+                    pre_charge_sequence->sample_period_s;
+
+    if (pre_charge_sequence->num_samples == 0U)
+    {
+        pre_charge_sequence->initial_voltage = tractive_system_voltage;
+    }
+    pre_charge_sequence->num_samples++;
+
+    float *const latest_voltage = &pre_charge_sequence->latest_voltages
+                                       [pre_charge_sequence->num_samples %
+                                        NUM_OF_PRE_CHARGE_COMPLETE_SAMPLES];
+    pre_charge_sequence->sum_of_latest_voltages +=
+        tractive_system_voltage - *latest_voltage;
+    *latest_voltage = tractive_system_voltage;
+
+    // Nothing can be told from the tractive system voltage until the pack
+    // voltage it charges towards has been read, other than that it stalled
+    if (pack_voltage <= 0.0f)
+    {
+        return t > pre_charge_sequence->max_pre_charge_time_s
+                   ? PRE_CHARGE_SEQUENCE_TIME_CONSTANT_TOO_LONG
+                   : PRE_CHARGE_SEQUENCE_IN_PROGRESS;
+    }
+
+    if (pre_charge_sequence->num_samples >=
+            NUM_OF_PRE_CHARGE_COMPLETE_SAMPLES &&
+        pre_charge_sequence->sum_of_latest_voltages >=
+            PRE_CHARGE_COMPLETE_VOLTAGE_RATIO * pack_voltage *
+                (float)NUM_OF_PRE_CHARGE_COMPLETE_SAMPLES)
+    {
+        // The first samples are taken before the precharge relay can have
+        // closed, so a tractive system that is charged by then was charged
+        // before the sequence was enabled and needn't be precharged
+        if (pre_charge_sequence->num_samples ==
+            NUM_OF_PRE_CHARGE_COMPLETE_SAMPLES)
+        {
+            return PRE_CHARGE_SEQUENCE_ALREADY_CHARGED;
+        }
+
+        // Charging through the whole fitting band in fewer samples than the
+        // fit needs is far faster than any plausible charging curve
+        if (pre_charge_sequence->num_fit_samples <
+            MIN_NUM_OF_PRE_CHARGE_FIT_SAMPLES)
+        {
+            return PRE_CHARGE_SEQUENCE_TIME_CONSTANT_TOO_SHORT;
+        }
+        return App_CheckTimeConstant(
+            pre_charge_sequence, PRE_CHARGE_SEQUENCE_COMPLETE);
+    }
+
+    // The fraction of the voltage the tractive system had left to charge by
+    // that it has charged by
+    const float charge_voltage =
+        pack_voltage - pre_charge_sequence->initial_voltage;
+    const float ratio =
+        (tractive_system_voltage - pre_charge_sequence->initial_voltage) /
+        charge_voltage;
+
+    if (ratio >= MIN_PRE_CHARGE_FIT_VOLTAGE_RATIO &&
+        ratio <= MAX_PRE_CHARGE_FIT_VOLTAGE_RATIO)
+    {
+        const float y = -logf(1.0f - ratio);
+
+        pre_charge_sequence->num_fit_samples++;
+        pre_charge_sequence->sum_t += t;
+        pre_charge_sequence->sum_y += y;
+        pre_charge_sequence->sum_ty += t * y;
+        pre_charge_sequence->sum_tt += t * t;
+    }
+    else if (
+        !(ratio >= MIN_PRE_CHARGE_FIT_VOLTAGE_RATIO) &&
+        t > pre_charge_sequence->max_rise_time_s)
+    {
+        return PRE_CHARGE_SEQUENCE_TIME_CONSTANT_TOO_LONG;
+    }
+
+    if (t > pre_charge_sequence->max_pre_charge_time_s)
+    {
+        return PRE_CHARGE_SEQUENCE_TIME_CONSTANT_TOO_LONG;
+    }
+
+    if (pre_charge_sequence->num_fit_samples >=
+        MIN_NUM_OF_PRE_CHARGE_FIT_SAMPLES)
+    {
+        return App_CheckTimeConstant(
+            pre_charge_sequence, PRE_CHARGE_SEQUENCE_IN_PROGRESS);
+    }
+    return PRE_CHARGE_SEQUENCE_IN_PROGRESS;
+}
+
 struct PreChargeSequence *App_PreChargeSequence_Create(
     void (*enable_pre_charge_sequence)(void),
-    void (*disable_pre_charge_sequence)(void))
+    void (*disable_pre_charge_sequence)(void),
+    size_t (*read_tractive_system_voltages)(float *, size_t),
+    float (*get_pack_voltage)(void),
+    float sample_frequency_hz)
 {
+    assert(sample_frequency_hz > 0.0f);
+    assert(
+        (float)NUM_OF_PRE_CHARGE_COMPLETE_SAMPLES / sample_frequency_hz <
+        PRE_CHARGE_RELAY_CLOSE_TIME_S);
+
     struct PreChargeSequence *pre_charge_sequence =
         malloc(sizeof(struct PreChargeSequence));
     assert(pre_charge_sequence != NULL);
@@ -20,6 +194,34 @@ struct PreChargeSequence *App_PreChargeSequence_Create(
         enable_pre_charge_sequence;
     pre_charge_sequence->disable_pre_charge_sequence =
         disable_pre_charge_sequence;
+    pre_charge_sequence->read_tractive_system_voltages =
+        read_tractive_system_voltages;
+    pre_charge_sequence->get_pack_voltage = get_pack_voltage;
+    pre_charge_sequence->sample_period_s  = 1.0f / sample_frequency_hz;
+
+    pre_charge_sequence->max_rise_time_s =
+        PRE_CHARGE_RELAY_CLOSE_TIME_S -
+        MAX_PRE_CHARGE_TIME_CONSTANT_S *
+            logf(1.0f - MIN_PRE_CHARGE_FIT_VOLTAGE_RATIO);
+    pre_charge_sequence->max_pre_charge_time_s =
+        PRE_CHARGE_RELAY_CLOSE_TIME_S -
+        MAX_PRE_CHARGE_TIME_CONSTANT_S *
+            logf(1.0f - PRE_CHARGE_COMPLETE_VOLTAGE_RATIO);
+
+    pre_charge_sequence->status      = PRE_CHARGE_SEQUENCE_IN_PROGRESS;
+    pre_charge_sequence->num_ticks   = 0U;
+    pre_charge_sequence->num_samples = 0U;
+    pre_charge_sequence->sum_of_latest_voltages = 0.0f;
+    for (size_t i = 0U; i < NUM_OF_PRE_CHARGE_COMPLETE_SAMPLES; i++)
+    {
+        pre_charge_sequence->latest_voltages[i] = 0.0f;
+    }
+    pre_charge_sequence->initial_voltage = 0.0f;
+    pre_charge_sequence->num_fit_samples = 0U;
+    pre_charge_sequence->sum_t           = 0.0f;
+    pre_charge_sequence->sum_y           = 0.0f;
+    pre_charge_sequence->sum_ty          = 0.0f;
+    pre_charge_sequence->sum_tt          = 0.0f;
 
     return pre_charge_sequence;
 }
@@ -31,8 +233,29 @@ void App_PreChargeSequence_Destroy(
 }
 
 void App_PreChargeSequence_Enable(
-    const struct PreChargeSequence *const pre_charge_sequence)
+    struct PreChargeSequence *const pre_charge_sequence)
 {
+    // Drop the voltages sampled before the sequence was enabled
+    float voltages[NUM_OF_VOLTAGES_PER_READ];
+    while (pre_charge_sequence->read_tractive_system_voltages(
+               voltages, NUM_OF_VOLTAGES_PER_READ) > 0U)
+    {
+    }
+
+    pre_charge_sequence->status      = PRE_CHARGE_SEQUENCE_IN_PROGRESS;
+    pre_charge_sequence->num_ticks   = 0U;
+    pre_charge_sequence->num_samples = 0U;
+    pre_charge_sequence->sum_of_latest_voltages = 0.0f;
+    for (size_t i = 0U; i < NUM_OF_PRE_CHARGE_COMPLETE_SAMPLES; i++)
+    {
+        pre_charge_sequence->latest_voltages[i] = 0.0f;
+    }
+    pre_charge_sequence->num_fit_samples = 0U;
+    pre_charge_sequence->sum_t           = 0.0f;
+    pre_charge_sequence->sum_y           = 0.0f;
+    pre_charge_sequence->sum_ty          = 0.0f;
+    pre_charge_sequence->sum_tt          = 0.0f;
+
     pre_charge_sequence->enable_pre_charge_sequence();
 }
 
@@ -41,3 +264,59 @@ void App_PreChargeSequence_Disable(
 {
     pre_charge_sequence->disable_pre_charge_sequence();
 }
+
+enum PreChargeSequenceStatus App_PreChargeSequence_Tick100Hz(
+    struct PreChargeSequence *const pre_charge_sequence)
+{
+    const float pack_voltage = pre_charge_sequence->get_pack_voltage();
+
+    float  voltages[NUM_OF_VOLTAGES_PER_READ];
+    size_t num_voltages;
+    while (pre_charge_sequence->status == PRE_CHARGE_SEQUENCE_IN_PROGRESS &&
+           (num_voltages = pre_charge_sequence->read_tractive_system_voltages(
+                voltages, NUM_OF_VOLTAGES_PER_READ)) > 0U)
+    {
+        for (size_t i = 0U;
+             i < num_voltages &&
+             pre_charge_sequence->status == PRE_CHARGE_SEQUENCE_IN_PROGRESS;
+             i++)
+        {
+            pre_charge_sequence->status =
+                App_FitVoltage(pre_charge_sequence, voltages[i], pack_voltage);
+        }
+    }
+
+    // The samples lag the ticks by up to a tick, so only a precharge that
+    // stalled because the tractive system voltage stopped being sampled
+    // outlasts the samples by more than that
+    pre_charge_sequence->num_ticks++;
+    if (pre_charge_sequence->status == PRE_CHARGE_SEQUENCE_IN_PROGRESS &&
+        (float)pre_charge_sequence->num_ticks * TICK_PERIOD_S >
+            pre_charge_sequence->max_pre_charge_time_s + TICK_PERIOD_S)
+    {
+        pre_charge_sequence->status =
+            PRE_CHARGE_SEQUENCE_TIME_CONSTANT_TOO_LONG;
+    }
+
+    return pre_charge_sequence->status;
+}
+
+float App_PreChargeSequence_GetTimeConstant(
+    const struct PreChargeSequence *const pre_charge_sequence)
+{
+    if (pre_charge_sequence->num_fit_samples <
+        MIN_NUM_OF_PRE_CHARGE_FIT_SAMPLES)
+    {
+        return NAN;
+    }
+
+    const float n = (float)pre_charge_sequence->num_fit_samples;
+    const float slope =
+        (n * pre_charge_sequence->sum_ty -
+         pre_charge_sequence->sum_t * pre_charge_sequence->sum_y) /
+        (n * pre_charge_sequence->sum_tt -
+         pre_charge_sequence->sum_t * pre_charge_sequence->sum_t);
+
+    // A curve that isn't rising would take forever to charge
+    return slope > 0.0f ? 1.0f / slope : INFINITY;
+}
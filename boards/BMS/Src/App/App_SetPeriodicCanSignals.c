@@ -1,8 +1,110 @@
+#include <assert.h>
+#include <math.h>
 #include "App_SetPeriodicCanSignals.h"
 #include "App_SharedSetPeriodicCanSignals.h"
 #include "App_InRangeCheck.h"
+#include "App_SharedMacros.h"
+#include "states/App_AirOpenState.h"
+#include "states/App_ChargeState.h"
+#include "states/App_DriveState.h"
+#include "states/App_FaultState.h"
+#include "states/App_InitState.h"
+#include "states/App_PreChargeState.h"
 
-STATIC_DEFINE_APP_SET_PERIODIC_CAN_SIGNALS_IN_RANGE_CHECK(BmsCanTxInterface)
+STATIC_DEFINE_APP_SET_PERIODIC_CAN_SIGNALS_IN_RANGE_CHECKS(BmsCanTxInterface)
+STATIC_DEFINE_APP_SET_PERIODIC_CAN_SIGNALS_STATE_MACHINE_TRACE(
+    BmsCanTxInterface)
+
+/**
+ * Convert the given power limit to the value of its CAN signal
+ * @param power The power limit, in W
+ * @return The power limit in W, saturated to the 16-bit CAN signal
+ */
+static uint16_t App_GetPowerLimitSignal(float power)
+{
+    return (uint16_t)fminf(fmaxf(power, 0.0f), (float)UINT16_MAX);
+}
+
+// The segment and chip indices are sent in 8-bit CAN signals, and the number
+// of out-of-range checks in 7-bit CAN signals
+#define MAX_NUM_OUT_OF_RANGE_CHECKS 127U
+static_assert(
+    NUM_OF_ACCUMULATOR_SEGMENTS <= MAX_NUM_OUT_OF_RANGE_CHECKS,
+    "The number of accumulator segments must fit in a CAN signal.");
+static_assert(
+    NUM_OF_CELL_MONITOR_CHIPS <= MAX_NUM_OUT_OF_RANGE_CHECKS,
+    "The number of cell monitoring chips must fit in a CAN signal.");
+
+// The first two accumulator in-range checks open the AIRs when they fail
+enum
+{
+    MIN_CELL_VOLTAGE_IN_RANGE_CHECK,
+    MAX_CELL_VOLTAGE_IN_RANGE_CHECK,
+    NUM_ACCUMULATOR_IN_RANGE_CHECKS = 4,
+};
+
+static const struct InRangeCheckCanSignals
+    accumulator_can_signals[NUM_ACCUMULATOR_IN_RANGE_CHECKS] = {
+        IN_RANGE_CHECK_CAN_SIGNALS(
+            BMS_AIR_SHUTDOWN_ERRORS,
+            MIN_CELL_VOLTAGE,
+            MIN_CELL_VOLTAGE_OUT_OF_RANGE),
+        IN_RANGE_CHECK_CAN_SIGNALS(
+            BMS_AIR_SHUTDOWN_ERRORS,
+            MAX_CELL_VOLTAGE,
+            MAX_CELL_VOLTAGE_OUT_OF_RANGE),
+        IN_RANGE_CHECK_CAN_SIGNALS(
+            BMS_NON_CRITICAL_ERRORS,
+            AVERAGE_CELL_VOLTAGE,
+            AVERAGE_CELL_VOLTAGE_OUT_OF_RANGE),
+        IN_RANGE_CHECK_CAN_SIGNALS(
+            BMS_NON_CRITICAL_ERRORS,
+            PACK_VOLTAGE,
+            PACK_VOLTAGE_OUT_OF_RANGE),
+    };
+
+static const struct InRangeCheckCanChoices segment_voltage_can_choices =
+    IN_RANGE_CHECK_CAN_CHOICES(
+        BMS_SEGMENT_VOLTAGE,
+        SEGMENT_VOLTAGE_OUT_OF_RANGE);
+static const struct InRangeCheckCanChoices die_temp_can_choices =
+    IN_RANGE_CHECK_CAN_CHOICES(
+        BMS_CELL_MONITOR_DIE_TEMPERATURE,
+        CELL_MONITOR_DIE_TEMP_OUT_OF_RANGE);
+
+/**
+ * Get the CAN choice used to identify the given state in the state machine
+ * trace, which is the same choice used by the BMS_STATE_MACHINE message
+ * @param state The state to get the CAN choice for
+ * @return The CAN choice for the given state
+ */
+static uint8_t App_GetStateChoice(const struct State *const state)
+{
+    if (state == App_GetInitState())
+    {
+        return CANMSGS_BMS_STATE_MACHINE_STATE_INIT_CHOICE;
+    }
+    else if (state == App_GetAirOpenState())
+    {
+        return CANMSGS_BMS_STATE_MACHINE_STATE_AIR_OPEN_CHOICE;
+    }
+    else if (state == App_GetPreChargeState())
+    {
+        return CANMSGS_BMS_STATE_MACHINE_STATE_PRE_CHARGE_CHOICE;
+    }
+    else if (state == App_GetChargeState())
+    {
+        return CANMSGS_BMS_STATE_MACHINE_STATE_CHARGE_CHOICE;
+    }
+    else if (state == App_GetDriveState())
+    {
+        return CANMSGS_BMS_STATE_MACHINE_STATE_DRIVE_CHOICE;
+    }
+    else
+    {
+        return CANMSGS_BMS_STATE_MACHINE_STATE_FAULT_CHOICE;
+    }
+}
 
 void App_SetPeriodicCanSignals_Imd(
     struct BmsCanTxInterface *can_tx,
@@ -62,156 +164,148 @@ void App_SetPeriodicCanSignals_Imd(
 void App_SetPeriodicSignals_AccumulatorInRangeChecks(
     struct BmsCanTxInterface *const can_tx,
     const struct Accumulator *const accumulator,
-    struct ErrorTable *const        error_table)
+    struct ErrorTable *const        error_table,
+    const size_t                    segment_to_send)
 {
-    App_Accumulator_ReadCellVoltages(accumulator);
-
-    if (App_SetPeriodicCanSignals_InRangeCheck(
-            can_tx, App_Accumulator_GetMinCellVoltageInRangeCheck(accumulator),
-            App_CanTx_SetPeriodicSignal_MIN_CELL_VOLTAGE,
-            App_CanTx_SetPeriodicSignal_MIN_CELL_VOLTAGE_OUT_OF_RANGE,
-            CANMSGS_BMS_AIR_SHUTDOWN_ERRORS_MIN_CELL_VOLTAGE_OUT_OF_RANGE_OK_CHOICE,
-            CANMSGS_BMS_AIR_SHUTDOWN_ERRORS_MIN_CELL_VOLTAGE_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-            CANMSGS_BMS_AIR_SHUTDOWN_ERRORS_MIN_CELL_VOLTAGE_OUT_OF_RANGE_OVERFLOW_CHOICE) !=
-        VALUE_IN_RANGE)
+    assert(segment_to_send < NUM_OF_ACCUMULATOR_SEGMENTS);
+
+    struct InRangeCheck *const in_range_checks[] = {
+        App_Accumulator_GetMinCellVoltageInRangeCheck(accumulator),
+        App_Accumulator_GetMaxCellVoltageInRangeCheck(accumulator),
+        App_Accumulator_GetAverageCellVoltageInRangeCheck(accumulator),
+        App_Accumulator_GetPackVoltageInRangeCheck(accumulator),
+    };
+    enum InRangeCheck_Status statuses[NUM_ACCUMULATOR_IN_RANGE_CHECKS];
+
+    App_SetPeriodicCanSignals_InRangeChecks(
+        can_tx, in_range_checks, accumulator_can_signals,
+        NUM_ACCUMULATOR_IN_RANGE_CHECKS, statuses);
+
+    if (statuses[MIN_CELL_VOLTAGE_IN_RANGE_CHECK] != VALUE_IN_RANGE)
     {
         App_SharedErrorTable_SetError(
             error_table, BMS_AIR_SHUTDOWN_MIN_CELL_VOLTAGE_OUT_OF_RANGE, true);
     }
 
-    if (App_SetPeriodicCanSignals_InRangeCheck(
-            can_tx, App_Accumulator_GetMaxCellVoltageInRangeCheck(accumulator),
-            App_CanTx_SetPeriodicSignal_MAX_CELL_VOLTAGE,
-            App_CanTx_SetPeriodicSignal_MAX_CELL_VOLTAGE_OUT_OF_RANGE,
-            CANMSGS_BMS_AIR_SHUTDOWN_ERRORS_MAX_CELL_VOLTAGE_OUT_OF_RANGE_OK_CHOICE,
-            CANMSGS_BMS_AIR_SHUTDOWN_ERRORS_MAX_CELL_VOLTAGE_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-            CANMSGS_BMS_AIR_SHUTDOWN_ERRORS_MAX_CELL_VOLTAGE_OUT_OF_RANGE_OVERFLOW_CHOICE) !=
-        VALUE_IN_RANGE)
+    if (statuses[MAX_CELL_VOLTAGE_IN_RANGE_CHECK] != VALUE_IN_RANGE)
     {
         App_SharedErrorTable_SetError(
             error_table, BMS_AIR_SHUTDOWN_MAX_CELL_VOLTAGE_OUT_OF_RANGE, true);
     }
 
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, App_Accumulator_GetAverageCellVoltageInRangeCheck(accumulator),
-        App_CanTx_SetPeriodicSignal_AVERAGE_CELL_VOLTAGE,
-        App_CanTx_SetPeriodicSignal_AVERAGE_CELL_VOLTAGE_OUT_OF_RANGE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_AVERAGE_CELL_VOLTAGE_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_AVERAGE_CELL_VOLTAGE_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_AVERAGE_CELL_VOLTAGE_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, App_Accumulator_GetPackVoltageInRangeCheck(accumulator),
-        App_CanTx_SetPeriodicSignal_PACK_VOLTAGE,
-        App_CanTx_SetPeriodicSignal_PACK_VOLTAGE_OUT_OF_RANGE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_PACK_VOLTAGE_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_PACK_VOLTAGE_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_PACK_VOLTAGE_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, App_Accumulator_GetSegment0VoltageInRangeCheck(accumulator),
-        App_CanTx_SetPeriodicSignal_SEGMENT_0_VOLTAGE,
-        App_CanTx_SetPeriodicSignal_SEGMENT_0_VOLTAGE_OUT_OF_RANGE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_SEGMENT_0_VOLTAGE_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_SEGMENT_0_VOLTAGE_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_SEGMENT_0_VOLTAGE_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, App_Accumulator_GetSegment1VoltageInRangeCheck(accumulator),
-        App_CanTx_SetPeriodicSignal_SEGMENT_1_VOLTAGE,
-        App_CanTx_SetPeriodicSignal_SEGMENT_1_VOLTAGE_OUT_OF_RANGE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_SEGMENT_1_VOLTAGE_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_SEGMENT_1_VOLTAGE_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_SEGMENT_1_VOLTAGE_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, App_Accumulator_GetSegment2VoltageInRangeCheck(accumulator),
-        App_CanTx_SetPeriodicSignal_SEGMENT_2_VOLTAGE,
-        App_CanTx_SetPeriodicSignal_SEGMENT_2_VOLTAGE_OUT_OF_RANGE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_SEGMENT_2_VOLTAGE_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_SEGMENT_2_VOLTAGE_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_SEGMENT_2_VOLTAGE_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, App_Accumulator_GetSegment3VoltageInRangeCheck(accumulator),
-        App_CanTx_SetPeriodicSignal_SEGMENT_3_VOLTAGE,
-        App_CanTx_SetPeriodicSignal_SEGMENT_3_VOLTAGE_OUT_OF_RANGE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_SEGMENT_3_VOLTAGE_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_SEGMENT_3_VOLTAGE_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_SEGMENT_3_VOLTAGE_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, App_Accumulator_GetSegment4VoltageInRangeCheck(accumulator),
-        App_CanTx_SetPeriodicSignal_SEGMENT_4_VOLTAGE,
-        App_CanTx_SetPeriodicSignal_SEGMENT_4_VOLTAGE_OUT_OF_RANGE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_SEGMENT_4_VOLTAGE_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_SEGMENT_4_VOLTAGE_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_SEGMENT_4_VOLTAGE_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, App_Accumulator_GetSegment5VoltageInRangeCheck(accumulator),
-        App_CanTx_SetPeriodicSignal_SEGMENT_5_VOLTAGE,
-        App_CanTx_SetPeriodicSignal_SEGMENT_5_VOLTAGE_OUT_OF_RANGE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_SEGMENT_5_VOLTAGE_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_SEGMENT_5_VOLTAGE_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_SEGMENT_5_VOLTAGE_OUT_OF_RANGE_OVERFLOW_CHOICE);
+    // Every segment is checked on every tick, but only one segment voltage is
+    // sent per tick so the frames don't overflow the CAN TX FIFO
+    uint8_t num_segment_voltages_out_of_range = 0U;
+    for (size_t segment = 0U; segment < NUM_OF_ACCUMULATOR_SEGMENTS; segment++)
+    {
+        struct InRangeCheck *const segment_voltage_in_range_check =
+            App_Accumulator_GetSegmentVoltageInRangeCheck(accumulator, segment);
+        App_InRangeCheck_Evaluate(segment_voltage_in_range_check);
+
+        float                          segment_voltage;
+        const enum InRangeCheck_Status status = App_InRangeCheck_GetValue(
+            segment_voltage_in_range_check, &segment_voltage);
+
+        if (status != VALUE_IN_RANGE)
+        {
+            num_segment_voltages_out_of_range++;
+        }
+
+        if (segment == segment_to_send)
+        {
+            App_CanTx_SetPeriodicSignal_SEGMENT_INDEX(can_tx, (uint8_t)segment);
+            App_CanTx_SetPeriodicSignal_SEGMENT_VOLTAGE(
+                can_tx, segment_voltage);
+            App_CanTx_SetPeriodicSignal_SEGMENT_VOLTAGE_OUT_OF_RANGE(
+                can_tx,
+                App_GetOutOfRangeChoice(&segment_voltage_can_choices, status));
+        }
+    }
+
+    App_CanTx_SetPeriodicSignal_NUM_SEGMENT_VOLTAGES_OUT_OF_RANGE(
+        can_tx, num_segment_voltages_out_of_range);
 }
 
 void App_SetPeriodicSignals_CellMonitorsInRangeChecks(
     struct BmsCanTxInterface *const  can_tx,
-    const struct CellMonitors *const cell_monitors)
+    const struct CellMonitors *const cell_monitors,
+    const size_t                     chip_to_send)
 {
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx,
-        App_CellMonitors_GetCellMonitor0DieTempInRangeCheck(cell_monitors),
-        App_CanTx_SetPeriodicSignal_CELL_MONITOR_0_DIE_TEMPERATURE,
-        App_CanTx_SetPeriodicSignal_CELL_MONITOR_0_DIE_TEMP_OUT_OF_RANGE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_0_DIE_TEMP_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_0_DIE_TEMP_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_0_DIE_TEMP_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx,
-        App_CellMonitors_GetCellMonitor1DieTempInRangeCheck(cell_monitors),
-        App_CanTx_SetPeriodicSignal_CELL_MONITOR_1_DIE_TEMPERATURE,
-        App_CanTx_SetPeriodicSignal_CELL_MONITOR_1_DIE_TEMP_OUT_OF_RANGE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_1_DIE_TEMP_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_1_DIE_TEMP_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_1_DIE_TEMP_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx,
-        App_CellMonitors_GetCellMonitor2DieTempInRangeCheck(cell_monitors),
-        App_CanTx_SetPeriodicSignal_CELL_MONITOR_2_DIE_TEMPERATURE,
-        App_CanTx_SetPeriodicSignal_CELL_MONITOR_2_DIE_TEMP_OUT_OF_RANGE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_2_DIE_TEMP_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_2_DIE_TEMP_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_2_DIE_TEMP_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
+    assert(chip_to_send < NUM_OF_CELL_MONITOR_CHIPS);
+
+    // Every chip is checked on every tick, but only one die temperature is
+    // sent per tick
+    uint8_t num_die_temps_out_of_range = 0U;
+    for (size_t chip = 0U; chip < NUM_OF_CELL_MONITOR_CHIPS; chip++)
+    {
+        struct InRangeCheck *const die_temp_in_range_check =
+            App_CellMonitors_GetDieTempInRangeCheck(cell_monitors, chip);
+        App_InRangeCheck_Evaluate(die_temp_in_range_check);
+
+        float                          die_temp;
+        const enum InRangeCheck_Status status =
+            App_InRangeCheck_GetValue(die_temp_in_range_check, &die_temp);
+
+        if (status != VALUE_IN_RANGE)
+        {
+            num_die_temps_out_of_range++;
+        }
+
+        if (chip == chip_to_send)
+        {
+            App_CanTx_SetPeriodicSignal_CELL_MONITOR_INDEX(
+                can_tx, (uint8_t)chip);
+            App_CanTx_SetPeriodicSignal_CELL_MONITOR_DIE_TEMPERATURE(
+                can_tx, die_temp);
+            App_CanTx_SetPeriodicSignal_CELL_MONITOR_DIE_TEMP_OUT_OF_RANGE(
+                can_tx, App_GetOutOfRangeChoice(&die_temp_can_choices, status));
+        }
+    }
+
+    App_CanTx_SetPeriodicSignal_NUM_CELL_MONITOR_DIE_TEMPS_OUT_OF_RANGE(
+        can_tx, num_die_temps_out_of_range);
+}
+
+void App_SetPeriodicCanSignals_StateMachineTrace(
+    struct BmsCanTxInterface *const  can_tx,
+    const struct StateMachine *const state_machine)
+{
+    App_SetPeriodicCanSignals_SharedStateMachineTrace(
+        can_tx, state_machine, App_GetStateChoice);
+}
+
+void App_SetPeriodicCanSignals_CellDiagnostics(
+    struct BmsCanTxInterface *const     can_tx,
+    const struct CellDiagnostics *const cell_diagnostics)
+{
+    App_CanTx_SetPeriodicSignal_NUM_UNTESTED_CELLS(
+        can_tx, (uint16_t)App_CellDiagnostics_GetNumOfCellsWithStatus(
+                    cell_diagnostics, CELL_DIAGNOSTIC_STATUS_UNTESTED));
+    App_CanTx_SetPeriodicSignal_NUM_OPEN_WIRE_CELLS(
+        can_tx, (uint16_t)App_CellDiagnostics_GetNumOfCellsWithStatus(
+                    cell_diagnostics, CELL_DIAGNOSTIC_STATUS_OPEN_WIRE));
+    App_CanTx_SetPeriodicSignal_NUM_ADC_MISMATCH_CELLS(
+        can_tx, (uint16_t)App_CellDiagnostics_GetNumOfCellsWithStatus(
+                    cell_diagnostics, CELL_DIAGNOSTIC_STATUS_ADC_MISMATCH));
+}
+
+void App_SetPeriodicCanSignals_AvailablePower(
+    struct BmsCanTxInterface *const    can_tx,
+    const struct AvailablePower *const available_power)
+{
+    App_CanTx_SetPeriodicSignal_CONTINUOUS_DISCHARGE_POWER(
         can_tx,
-        App_CellMonitors_GetCellMonitor3DieTempInRangeCheck(cell_monitors),
-        App_CanTx_SetPeriodicSignal_CELL_MONITOR_3_DIE_TEMPERATURE,
-        App_CanTx_SetPeriodicSignal_CELL_MONITOR_3_DIE_TEMP_OUT_OF_RANGE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_3_DIE_TEMP_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_3_DIE_TEMP_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_3_DIE_TEMP_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
+        App_GetPowerLimitSignal(
+            App_AvailablePower_GetContinuousDischargePower(available_power)));
+    App_CanTx_SetPeriodicSignal_PULSE_DISCHARGE_POWER(
         can_tx,
-        App_CellMonitors_GetCellMonitor4DieTempInRangeCheck(cell_monitors),
-        App_CanTx_SetPeriodicSignal_CELL_MONITOR_4_DIE_TEMPERATURE,
-        App_CanTx_SetPeriodicSignal_CELL_MONITOR_4_DIE_TEMP_OUT_OF_RANGE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_4_DIE_TEMP_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_4_DIE_TEMP_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_4_DIE_TEMP_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
+        App_GetPowerLimitSignal(
+            App_AvailablePower_GetPulseDischargePower(available_power)));
+    App_CanTx_SetPeriodicSignal_CONTINUOUS_REGEN_POWER(
         can_tx,
-        App_CellMonitors_GetCellMonitor5DieTempInRangeCheck(cell_monitors),
-        App_CanTx_SetPeriodicSignal_CELL_MONITOR_5_DIE_TEMPERATURE,
-        App_CanTx_SetPeriodicSignal_CELL_MONITOR_5_DIE_TEMP_OUT_OF_RANGE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_5_DIE_TEMP_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_5_DIE_TEMP_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_5_DIE_TEMP_OUT_OF_RANGE_OVERFLOW_CHOICE);
+        App_GetPowerLimitSignal(
+            App_AvailablePower_GetContinuousRegenPower(available_power)));
+    App_CanTx_SetPeriodicSignal_PULSE_REGEN_POWER(
+        can_tx, App_GetPowerLimitSignal(
+                    App_AvailablePower_GetPulseRegenPower(available_power)));
 }
@@ -0,0 +1,156 @@
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include "App_SocEkf.h"
+#include "App_OpenCircuitVoltage.h"
+
+#define SECONDS_PER_HOUR 3600.0f
+
+struct SocEkf
+{
+    // The change in SoC (%) per coulomb out of the cell group
+    float soc_per_coulomb;
+    float series_resistance_ohms;
+    float period_s;
+
+    // The voltage across the RC pair decays by this factor every period, and
+    // the rest of each period's current charges it through its resistance
+    float polarization_decay;
+    float polarization_resistance_ohms;
+
+    float soc_process_noise;
+    float polarization_process_noise;
+    float measurement_noise;
+    float initial_soc_variance;
+
+    // The state is the SoC (%) and the voltage across the RC pair (V), and p is
+    // the covariance of the state
+    float soc;
+    float polarization_voltage;
+    float p[2][2];
+};
+
+/**
+ * Clamp the SoC of the given EKF to between 0% and 100%
+ * @param soc_ekf The EKF to clamp the SoC of
+ */
+static void App_ClampSoc(struct SocEkf *const soc_ekf)
+{
+    soc_ekf->soc = fminf(fmaxf(soc_ekf->soc, 0.0f), 100.0f);
+}
+
+struct SocEkf *App_SocEkf_Create(
+    float capacity_ah,
+    float series_resistance_ohms,
+    float polarization_resistance_ohms,
+    float polarization_capacitance_f,
+    float period_s,
+    float soc_process_noise,
+    float polarization_process_noise,
+    float measurement_noise,
+    float initial_soc_variance)
+{
+    assert(capacity_ah > 0.0f);
+    assert(polarization_resistance_ohms > 0.0f);
+    assert(polarization_capacitance_f > 0.0f);
+    assert(period_s > 0.0f);
+    assert(measurement_noise > 0.0f);
+
+    struct SocEkf *soc_ekf = malloc(sizeof(struct SocEkf));
+    assert(soc_ekf != NULL);
+
+    soc_ekf->soc_per_coulomb        = 100.0f / (capacity_ah * SECONDS_PER_HOUR);
+    soc_ekf->series_resistance_ohms = series_resistance_ohms;
+    soc_ekf->period_s               = period_s;
+    soc_ekf->polarization_decay     = expf(
+        -period_s /
+        (polarization_resistance_ohms * polarization_capacitance_f));
+    soc_ekf->polarization_resistance_ohms = polarization_resistance_ohms;
+    soc_ekf->soc_process_noise            = soc_process_noise;
+    soc_ekf->polarization_process_noise   = polarization_process_noise;
+    soc_ekf->measurement_noise            = measurement_noise;
+    soc_ekf->initial_soc_variance         = initial_soc_variance;
+
+    App_SocEkf_SetSoc(soc_ekf, 0.0f);
+
+    return soc_ekf;
+}
+
+void App_SocEkf_Destroy(struct SocEkf *soc_ekf)
+{
+    free(soc_ekf);
+}
+
+void App_SocEkf_SetSoc(struct SocEkf *const soc_ekf, float soc)
+{
+    soc_ekf->soc                  = soc;
+    soc_ekf->polarization_voltage = 0.0f;
+    soc_ekf->p[0][0]              = soc_ekf->initial_soc_variance;
+    soc_ekf->p[0][1]              = 0.0f;
+    soc_ekf->p[1][0]              = 0.0f;
+    soc_ekf->p[1][1]              = 0.0f;
+
+    App_ClampSoc(soc_ekf);
+}
+
+void App_SocEkf_Predict(struct SocEkf *const soc_ekf, float current_a)
+{
+    const float decay = soc_ekf->polarization_decay;
+
+    soc_ekf->soc -= soc_ekf->soc_per_coulomb * current_a * soc_ekf->period_s;
+    soc_ekf->polarization_voltage =
+        decay * soc_ekf->polarization_voltage +
+        (1.0f - decay) * soc_ekf->polarization_resistance_ohms * current_a;
+    App_ClampSoc(soc_ekf);
+
+    // The state transition is diag(1, decay), so P = F * P * F^T + Q reduces
+    // to scaling the covariance terms of the polarization voltage
+    soc_ekf->p[0][0] += soc_ekf->soc_process_noise;
+    soc_ekf->p[0][1] *= decay;
+    soc_ekf->p[1][0] *= decay;
+    soc_ekf->p[1][1] =
+        decay * decay * soc_ekf->p[1][1] + soc_ekf->polarization_process_noise;
+}
+
+void App_SocEkf_Correct(
+    struct SocEkf *const soc_ekf,
+    float                current_a,
+    float                voltage)
+{
+    // The measured voltage is the open circuit voltage, less the voltage across
+    // the RC pair and the series resistance, so the measurement Jacobian is
+    // H = [dOCV/dSoC, -1]
+    const float h0 = App_OpenCircuitVoltage_GetSlope(soc_ekf->soc);
+    const float predicted_voltage =
+        App_OpenCircuitVoltage_GetCellVoltage(soc_ekf->soc) -
+        soc_ekf->polarization_voltage -
+        soc_ekf->series_resistance_ohms * current_a;
+
+    // P * H^T
+    const float ph0 = soc_ekf->p[0][0] * h0 - soc_ekf->p[0][1];
+    const float ph1 = soc_ekf->p[1][0] * h0 - soc_ekf->p[1][1];
+
+    // S = H * P * H^T + R, and K = P * H^T / S
+    const float s  = h0 * ph0 - ph1 + soc_ekf->measurement_noise;
+    const float k0 = ph0 / s;
+    const float k1 = ph1 / s;
+
+    const float innovation = voltage - predicted_voltage;
+    soc_ekf->soc += k0 * innovation;
+    soc_ekf->polarization_voltage += k1 * innovation;
+    App_ClampSoc(soc_ekf);
+
+    // P = (I - K * H) * P, which is P - K * (P * H^T)^T since P is symmetric
+    const float p00  = soc_ekf->p[0][0] - k0 * ph0;
+    const float p01  = soc_ekf->p[0][1] - k0 * ph1;
+    const float p11  = soc_ekf->p[1][1] - k1 * ph1;
+    soc_ekf->p[0][0] = p00;
+    soc_ekf->p[0][1] = p01;
+    soc_ekf->p[1][0] = p01;
+    soc_ekf->p[1][1] = p11;
+}
+
+float App_SocEkf_GetSoc(const struct SocEkf *const soc_ekf)
+{
+    return soc_ekf->soc;
+}
@@ -0,0 +1,224 @@
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include "App_SocEstimator.h"
+#include "App_Soc.h"
+#include "App_SocEkf.h"
+#include "App_OpenCircuitVoltage.h"
+
+#define SECONDS_PER_HOUR 3600.0f
+#define V_PER_100UV 1E-4f
+
+struct SocEstimator
+{
+    float (*get_and_clear_charge)(void);
+    const struct CellStatistics *(*get_cell_statistics)(void);
+    ExitCode (*read_persisted_soc)(float *);
+    ExitCode (*write_persisted_soc)(float);
+
+    struct SocEkf *soc_ekf;
+
+    // The change in SoC (%) per coulomb out of the accumulator
+    float soc_per_coulomb;
+
+    bool     is_initialized;
+    float    coulomb_counting_soc;
+    float    ocv_soc;
+    uint32_t rest_ticks;
+    float    soc;
+    float    persisted_soc;
+};
+
+/**
+ * Clamp the given SoC to the range accepted by App_Soc_Vote()
+ * @param soc The SoC to clamp, in %
+ * @return The given SoC, clamped to between 0% and 100%
+ */
+static float App_ClampSoc(float soc)
+{
+    return fminf(fmaxf(soc, 0.0f), 100.0f);
+}
+
+/**
+ * Get the mean cell voltage of the last raw cell voltages read
+ * @param soc_estimator The SoC estimator to get the mean cell voltage for
+ * @return The mean cell voltage, in V
+ */
+static float
+    App_GetMeanCellVoltage(const struct SocEstimator *const soc_estimator)
+{
+    return (float)soc_estimator->get_cell_statistics()->mean * V_PER_100UV;
+}
+
+/**
+ * Initialize every SoC estimate from the persisted SoC, or from the open
+ * circuit voltage if no SoC was persisted or if the persisted SoC disagrees
+ * with it. The accumulator is assumed to be at rest, since the AIRs are open
+ * when the BMS starts up, so a disagreement means the accumulator was charged
+ * or discharged while the BMS was off.
+ * @param soc_estimator The SoC estimator to initialize
+ */
+static void App_Initialize(struct SocEstimator *const soc_estimator)
+{
+    soc_estimator->ocv_soc =
+        App_OpenCircuitVoltage_GetSoc(App_GetMeanCellVoltage(soc_estimator));
+
+    float persisted_soc;
+    if (soc_estimator->read_persisted_soc(&persisted_soc) == EXIT_CODE_OK &&
+        fabsf(persisted_soc - soc_estimator->ocv_soc) <= SOC_MAX_ABS_DIFFERENCE)
+    {
+        soc_estimator->persisted_soc = App_ClampSoc(persisted_soc);
+    }
+    else
+    {
+        soc_estimator->persisted_soc = soc_estimator->ocv_soc;
+    }
+
+    soc_estimator->coulomb_counting_soc = soc_estimator->persisted_soc;
+    soc_estimator->soc                  = soc_estimator->persisted_soc;
+    App_SocEkf_SetSoc(soc_estimator->soc_ekf, soc_estimator->persisted_soc);
+    soc_estimator->rest_ticks     = 0U;
+    soc_estimator->is_initialized = true;
+}
+
+struct SocEstimator *App_SocEstimator_Create(
+    float (*get_and_clear_charge)(void),
+    const struct CellStatistics *(*get_cell_statistics)(void),
+    ExitCode (*read_persisted_soc)(float *),
+    ExitCode (*write_persisted_soc)(float))
+{
+    struct SocEstimator *soc_estimator = malloc(sizeof(struct SocEstimator));
+    assert(soc_estimator != NULL);
+
+    soc_estimator->get_and_clear_charge = get_and_clear_charge;
+    soc_estimator->get_cell_statistics  = get_cell_statistics;
+    soc_estimator->read_persisted_soc   = read_persisted_soc;
+    soc_estimator->write_persisted_soc  = write_persisted_soc;
+
+    soc_estimator->soc_ekf = App_SocEkf_Create(
+        CELL_GROUP_CAPACITY_AH, CELL_GROUP_SERIES_RESISTANCE_OHMS,
+        CELL_GROUP_POLARIZATION_RESISTANCE_OHMS,
+        CELL_GROUP_POLARIZATION_CAPACITANCE_F, SOC_TICK_PERIOD_S,
+        SOC_EKF_SOC_PROCESS_NOISE, SOC_EKF_POLARIZATION_PROCESS_NOISE,
+        SOC_EKF_MEASUREMENT_NOISE, SOC_EKF_INITIAL_SOC_VARIANCE);
+    soc_estimator->soc_per_coulomb =
+        100.0f / (CELL_GROUP_CAPACITY_AH * SECONDS_PER_HOUR);
+
+    soc_estimator->is_initialized       = false;
+    soc_estimator->coulomb_counting_soc = 0.0f;
+    soc_estimator->ocv_soc              = 0.0f;
+    soc_estimator->rest_ticks           = 0U;
+    soc_estimator->soc                  = 0.0f;
+    soc_estimator->persisted_soc        = 0.0f;
+
+    return soc_estimator;
+}
+
+void App_SocEstimator_Destroy(struct SocEstimator *soc_estimator)
+{
+    App_SocEkf_Destroy(soc_estimator->soc_ekf);
+    free(soc_estimator);
+}
+
+void App_SocEstimator_Tick100Hz(
+    struct SocEstimator *const soc_estimator,
+    bool                       has_read_cell_voltages)
+{
+    // Always take the charge, so the charge that flowed before the estimates
+    // were initialized isn't counted afterwards
+    const float charge_c = soc_estimator->get_and_clear_charge();
+
+    if (!soc_estimator->is_initialized)
+    {
+        if (has_read_cell_voltages)
+        {
+            App_Initialize(soc_estimator);
+        }
+        return;
+    }
+
+    const float current_a = charge_c / SOC_TICK_PERIOD_S;
+
+    soc_estimator->coulomb_counting_soc = App_ClampSoc(
+        soc_estimator->coulomb_counting_soc -
+        soc_estimator->soc_per_coulomb * charge_c);
+
+    App_SocEkf_Predict(soc_estimator->soc_ekf, current_a);
+    if (has_read_cell_voltages)
+    {
+        App_SocEkf_Correct(
+            soc_estimator->soc_ekf, current_a,
+            App_GetMeanCellVoltage(soc_estimator));
+    }
+
+    if (fabsf(current_a) < SOC_REST_CURRENT_A)
+    {
+        if (soc_estimator->rest_ticks < SOC_REST_TICKS)
+        {
+            soc_estimator->rest_ticks++;
+        }
+    }
+    else
+    {
+        soc_estimator->rest_ticks = 0U;
+    }
+
+    if (soc_estimator->rest_ticks >= SOC_REST_TICKS && has_read_cell_voltages)
+    {
+        soc_estimator->ocv_soc = App_OpenCircuitVoltage_GetSoc(
+            App_GetMeanCellVoltage(soc_estimator));
+        soc_estimator->coulomb_counting_soc = soc_estimator->ocv_soc;
+    }
+
+    const float ekf_soc = App_SocEkf_GetSoc(soc_estimator->soc_ekf);
+    float       voted_soc;
+    App_Soc_Vote(
+        SOC_MAX_ABS_DIFFERENCE, soc_estimator->coulomb_counting_soc, ekf_soc,
+        soc_estimator->ocv_soc, &voted_soc);
+
+    // The EKF weighs coulomb counting against the cell voltages, so it is the
+    // best single estimate when no two estimates agree
+    soc_estimator->soc = isnan(voted_soc) ? ekf_soc : voted_soc;
+}
+
+void App_SocEstimator_Tick1Hz(struct SocEstimator *const soc_estimator)
+{
+    if (!soc_estimator->is_initialized ||
+        fabsf(soc_estimator->soc - soc_estimator->persisted_soc) <
+            SOC_PERSIST_DELTA)
+    {
+        return;
+    }
+
+    if (soc_estimator->write_persisted_soc(soc_estimator->soc) == EXIT_CODE_OK)
+    {
+        soc_estimator->persisted_soc = soc_estimator->soc;
+    }
+}
+
+bool App_SocEstimator_IsInitialized(
+    const struct SocEstimator *const soc_estimator)
+{
+    return soc_estimator->is_initialized;
+}
+
+float App_SocEstimator_GetSoc(const struct SocEstimator *const soc_estimator)
+{
+    return soc_estimator->soc;
+}
+
+float App_SocEstimator_GetCoulombCountingSoc(
+    const struct SocEstimator *const soc_estimator)
+{
+    return soc_estimator->coulomb_counting_soc;
+}
+
+float App_SocEstimator_GetEkfSoc(const struct SocEstimator *const soc_estimator)
+{
+    return App_SocEkf_GetSoc(soc_estimator->soc_ekf);
+}
+
+float App_SocEstimator_GetOcvSoc(const struct SocEstimator *const soc_estimator)
+{
+    return soc_estimator->ocv_soc;
+}
@@ -21,10 +21,9 @@ static void AirOpenStateRunOnTick100Hz(struct StateMachine *const state_machine)
     App_AllStatesRunOnTick100Hz(state_machine);
 
     struct BmsWorld *world = App_SharedStateMachine_GetWorld(state_machine);
-    struct Airs *    airs  = App_BmsWorld_GetAirs(world);
 
     // Begin the precharge sequence if AIR- is closed
-    if (App_SharedBinaryStatus_IsActive(App_Airs_GetAirNegative(airs)))
+    if (App_BmsWorld_GetSensorSnapshot100Hz(world)->is_air_negative_closed)
     {
         App_SharedStateMachine_SetNextState(
             state_machine, App_GetPreChargeState());
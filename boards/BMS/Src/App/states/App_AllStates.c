@@ -1,6 +1,7 @@
 #include "states/App_AllStates.h"
 #include "states/App_FaultState.h"
 #include "App_SetPeriodicCanSignals.h"
+#include "configs/App_AccumulatorThresholds.h"
 
 void App_AllStatesRunOnTick1Hz(struct StateMachine *const state_machine)
 {
@@ -8,9 +9,15 @@ void App_AllStatesRunOnTick1Hz(struct StateMachine *const state_machine)
     struct BmsCanTxInterface *can_tx = App_BmsWorld_GetCanTx(world);
     struct RgbLedSequence *   rgb_led_sequence =
         App_BmsWorld_GetRgbLedSequence(world);
-    struct Charger *charger = App_BmsWorld_GetCharger(world);
+    struct Charger *     charger       = App_BmsWorld_GetCharger(world);
+    struct SocEstimator *soc_estimator = App_BmsWorld_GetSocEstimator(world);
+    const struct CellDiagnostics *cell_diagnostics =
+        App_BmsWorld_GetCellDiagnostics(world);
 
     App_SharedRgbLedSequence_Tick(rgb_led_sequence);
+    App_SocEstimator_Tick1Hz(soc_estimator);
+    App_SetPeriodicCanSignals_StateMachineTrace(can_tx, state_machine);
+    App_SetPeriodicCanSignals_CellDiagnostics(can_tx, cell_diagnostics);
 
     bool charger_is_connected = App_Charger_IsConnected(charger);
     App_CanTx_SetPeriodicSignal_IS_CONNECTED(can_tx, charger_is_connected);
@@ -21,21 +28,32 @@ void App_AllStatesRunOnTick100Hz(struct StateMachine *const state_machine)
     struct BmsWorld *world = App_SharedStateMachine_GetWorld(state_machine);
     struct BmsCanTxInterface *can_tx      = App_BmsWorld_GetCanTx(world);
     struct Imd *              imd         = App_BmsWorld_GetImd(world);
-    struct OkStatus *         bms_ok      = App_BmsWorld_GetBmsOkStatus(world);
-    struct OkStatus *         imd_ok      = App_BmsWorld_GetImdOkStatus(world);
-    struct OkStatus *         bspd_ok     = App_BmsWorld_GetBspdOkStatus(world);
     struct Accumulator *      accumulator = App_BmsWorld_GetAccumulator(world);
-    struct Airs *             airs        = App_BmsWorld_GetAirs(world);
     struct ErrorTable *       error_table = App_BmsWorld_GetErrorTable(world);
+    const struct CellBalancing *cell_balancing =
+        App_BmsWorld_GetCellBalancing(world);
+    struct SocEstimator *   soc_estimator = App_BmsWorld_GetSocEstimator(world);
+    struct CellDiagnostics *cell_diagnostics =
+        App_BmsWorld_GetCellDiagnostics(world);
+    struct AvailablePower *available_power =
+        App_BmsWorld_GetAvailablePower(world);
+    const uint32_t current_ms = App_SharedClock_GetCurrentTimeInMilliseconds(
+        App_BmsWorld_GetClock(world));
+
+    // Sample the sensors first so every reader in this tick sees the same
+    // values
+    App_BmsWorld_SampleSensors100Hz(world);
+    const struct BmsSensorSnapshot *sensors =
+        App_BmsWorld_GetSensorSnapshot100Hz(world);
 
     App_SetPeriodicCanSignals_Imd(can_tx, imd);
 
     App_CanTx_SetPeriodicSignal_AIR_NEGATIVE(
-        can_tx, App_SharedBinaryStatus_IsActive(App_Airs_GetAirNegative(airs)));
+        can_tx, sensors->is_air_negative_closed);
     App_CanTx_SetPeriodicSignal_AIR_POSITIVE(
-        can_tx, App_SharedBinaryStatus_IsActive(App_Airs_GetAirPositive(airs)));
+        can_tx, sensors->is_air_positive_closed);
 
-    if (App_OkStatus_IsEnabled(bms_ok))
+    if (sensors->is_bms_ok_enabled)
     {
         App_CanTx_SetPeriodicSignal_BMS_OK(can_tx, true);
     }
@@ -44,7 +62,7 @@ void App_AllStatesRunOnTick100Hz(struct StateMachine *const state_machine)
         App_CanTx_SetPeriodicSignal_BMS_OK(can_tx, false);
     }
 
-    if (App_OkStatus_IsEnabled(imd_ok))
+    if (sensors->is_imd_ok_enabled)
     {
         App_CanTx_SetPeriodicSignal_IMD_OK(can_tx, true);
     }
@@ -53,7 +71,7 @@ void App_AllStatesRunOnTick100Hz(struct StateMachine *const state_machine)
         App_CanTx_SetPeriodicSignal_IMD_OK(can_tx, false);
     }
 
-    if (App_OkStatus_IsEnabled(bspd_ok))
+    if (sensors->is_bspd_ok_enabled)
     {
         App_CanTx_SetPeriodicSignal_BSPD_OK(can_tx, true);
     }
@@ -62,8 +80,43 @@ void App_AllStatesRunOnTick100Hz(struct StateMachine *const state_machine)
         App_CanTx_SetPeriodicSignal_BSPD_OK(can_tx, false);
     }
 
+    // Cells that are discharging pull their cell voltages down, so only the
+    // settled cell voltages are used to estimate the state of the cells. The
+    // cell voltages are still read every tick, so a cell that is overcharged
+    // while balancing is caught within a tick rather than in the next
+    // measurement window.
+    const bool has_read_cell_voltages =
+        App_Accumulator_ReadCellVoltages(accumulator) == EXIT_CODE_OK;
+    const bool are_cell_voltages_settled =
+        App_CellBalancing_CanReadCellVoltages(cell_balancing, current_ms);
+
+    // The segment voltages are sent one per 10ms tick, in turn
     App_SetPeriodicSignals_AccumulatorInRangeChecks(
-        can_tx, accumulator, error_table);
+        can_tx, accumulator, error_table,
+        (current_ms / 10U) % NUM_OF_ACCUMULATOR_SEGMENTS);
+    if (!are_cell_voltages_settled &&
+        (float)App_CellBalancing_GetCompensatedMaxCellVoltage(
+            cell_balancing, current_ms) *
+                1e-4f >
+            MAX_CELL_VOLTAGE)
+    {
+        App_SharedErrorTable_SetError(
+            error_table, BMS_AIR_SHUTDOWN_MAX_CELL_VOLTAGE_OUT_OF_RANGE, true);
+    }
+
+    const bool has_read_settled_cell_voltages =
+        has_read_cell_voltages && are_cell_voltages_settled;
+    App_SocEstimator_Tick100Hz(soc_estimator, has_read_settled_cell_voltages);
+    App_CellDiagnostics_Tick100Hz(cell_diagnostics, are_cell_voltages_settled);
+    App_AvailablePower_Tick100Hz(
+        available_power, has_read_settled_cell_voltages,
+        App_SocEstimator_GetSoc(soc_estimator));
+    App_SetPeriodicCanSignals_AvailablePower(can_tx, available_power);
+    if (App_SocEstimator_IsInitialized(soc_estimator))
+    {
+        App_CanTx_SetPeriodicSignal_STATE_OF_CHARGE(
+            can_tx, App_SocEstimator_GetSoc(soc_estimator));
+    }
 
     if (App_SharedErrorTable_HasAnyCriticalErrorSet(error_table))
     {
@@ -21,10 +21,15 @@ static void ChargeStateRunOnTick1Hz(struct StateMachine *const state_machine)
     struct BmsCanTxInterface * can_tx = App_BmsWorld_GetCanTx(world);
     const struct CellMonitors *cell_monitors =
         App_BmsWorld_GetCellMonitors(world);
-    struct Charger *charger = App_BmsWorld_GetCharger(world);
+    struct Charger *charger    = App_BmsWorld_GetCharger(world);
+    const uint32_t  current_ms = App_SharedClock_GetCurrentTimeInMilliseconds(
+        App_BmsWorld_GetClock(world));
 
     App_CellMonitors_ReadDieTemps(cell_monitors);
-    App_SetPeriodicSignals_CellMonitorsInRangeChecks(can_tx, cell_monitors);
+    // The die temperatures are sent one per 1s tick, in turn
+    App_SetPeriodicSignals_CellMonitorsInRangeChecks(
+        can_tx, cell_monitors,
+        (current_ms / 1000U) % NUM_OF_CELL_MONITOR_CHIPS);
 
     float                 max_die_temperature;
     enum ITMPInRangeCheck cell_monitor_itmp_in_range_check =
@@ -61,10 +66,16 @@ static void ChargeStateRunOnTick100Hz(struct StateMachine *const state_machine)
     App_AllStatesRunOnTick100Hz(state_machine);
 
     struct BmsWorld *world = App_SharedStateMachine_GetWorld(state_machine);
-    struct BmsCanTxInterface *can_tx  = App_BmsWorld_GetCanTx(world);
-    struct Charger *          charger = App_BmsWorld_GetCharger(world);
+    struct BmsCanTxInterface *can_tx = App_BmsWorld_GetCanTx(world);
 
-    if (!App_Charger_IsConnected(charger))
+    // The cell voltages were read by every state's 100Hz tick, so the cells to
+    // discharge are picked from this tick's cell voltages
+    App_CellBalancing_Tick100Hz(
+        App_BmsWorld_GetCellBalancing(world),
+        App_SharedClock_GetCurrentTimeInMilliseconds(
+            App_BmsWorld_GetClock(world)));
+
+    if (!App_BmsWorld_GetSensorSnapshot100Hz(world)->is_charger_connected)
     {
         App_CanTx_SetPeriodicSignal_CHARGER_DISCONNECTED_IN_CHARGE_STATE(
             can_tx, true);
@@ -74,7 +85,13 @@ static void ChargeStateRunOnTick100Hz(struct StateMachine *const state_machine)
 
 static void ChargeStateRunOnExit(struct StateMachine *const state_machine)
 {
-    UNUSED(state_machine);
+    struct BmsWorld *world = App_SharedStateMachine_GetWorld(state_machine);
+
+    // Cells are only balanced while charging
+    App_CellBalancing_Stop(
+        App_BmsWorld_GetCellBalancing(world),
+        App_SharedClock_GetCurrentTimeInMilliseconds(
+            App_BmsWorld_GetClock(world)));
 }
 
 const struct State *App_GetChargeState(void)
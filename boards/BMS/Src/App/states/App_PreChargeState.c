@@ -1,4 +1,8 @@
 #include "states/App_AllStates.h"
+#include "states/App_AirOpenState.h"
+#include "states/App_ChargeState.h"
+#include "states/App_DriveState.h"
+#include "states/App_FaultState.h"
 
 #include "App_SetPeriodicCanSignals.h"
 #include "App_SharedMacros.h"
@@ -9,6 +13,8 @@ static void PreChargeStateRunOnEntry(struct StateMachine *const state_machine)
     struct BmsCanTxInterface *can_tx_interface = App_BmsWorld_GetCanTx(world);
     App_CanTx_SetPeriodicSignal_STATE(
         can_tx_interface, CANMSGS_BMS_STATE_MACHINE_STATE_PRE_CHARGE_CHOICE);
+
+    App_PreChargeSequence_Enable(App_BmsWorld_GetPreChargeSequence(world));
 }
 
 static void PreChargeStateRunOnTick1Hz(struct StateMachine *const state_machine)
@@ -20,11 +26,64 @@ static void
     PreChargeStateRunOnTick100Hz(struct StateMachine *const state_machine)
 {
     App_AllStatesRunOnTick100Hz(state_machine);
+
+    struct BmsWorld *world = App_SharedStateMachine_GetWorld(state_machine);
+    struct BmsCanTxInterface *can_tx      = App_BmsWorld_GetCanTx(world);
+    struct ErrorTable *       error_table = App_BmsWorld_GetErrorTable(world);
+    const struct BmsSensorSnapshot *sensors =
+        App_BmsWorld_GetSensorSnapshot100Hz(world);
+
+    // Every state's 100Hz tick already transitions to the fault state on a
+    // critical error, so AIR+ must not be closed over it
+    if (App_SharedErrorTable_HasAnyCriticalErrorSet(error_table))
+    {
+        return;
+    }
+
+    if (!sensors->is_air_negative_closed)
+    {
+        App_SharedStateMachine_SetNextState(
+            state_machine, App_GetAirOpenState());
+        return;
+    }
+
+    switch (App_PreChargeSequence_Tick100Hz(
+        App_BmsWorld_GetPreChargeSequence(world)))
+    {
+        case PRE_CHARGE_SEQUENCE_IN_PROGRESS:
+        {
+        }
+        break;
+        case PRE_CHARGE_SEQUENCE_COMPLETE:
+        case PRE_CHARGE_SEQUENCE_ALREADY_CHARGED:
+        {
+            App_Airs_CloseAirPositive(App_BmsWorld_GetAirs(world));
+            App_SharedStateMachine_SetNextState(
+                state_machine, sensors->is_charger_connected
+                                   ? App_GetChargeState()
+                                   : App_GetDriveState());
+        }
+        break;
+        case PRE_CHARGE_SEQUENCE_TIME_CONSTANT_TOO_SHORT:
+        case PRE_CHARGE_SEQUENCE_TIME_CONSTANT_TOO_LONG:
+        {
+            App_CanTx_SetPeriodicSignal_PRE_CHARGE_FAILED(can_tx, true);
+            App_SharedErrorTable_SetError(
+                error_table, BMS_AIR_SHUTDOWN_PRE_CHARGE_FAILED, true);
+            App_SharedStateMachine_SetNextState(
+                state_machine, App_GetFaultState());
+        }
+        break;
+    }
 }
 
 static void PreChargeStateRunOnExit(struct StateMachine *const state_machine)
 {
-    UNUSED(state_machine);
+    struct BmsWorld *world = App_SharedStateMachine_GetWorld(state_machine);
+
+    // AIR+ carries the current once the tractive system has been precharged,
+    // and nothing may flow through the precharge resistor otherwise
+    App_PreChargeSequence_Disable(App_BmsWorld_GetPreChargeSequence(world));
 }
 
 const struct State *App_GetPreChargeState(void)
@@ -1,6 +1,7 @@
-#include <stm32f3xx.h>
-#include "Io_SharedAdc.h"
+#include "Io_SharedDmaAdc.h"
 #include "Io_Adc.h"
+#include "Io_MainCurrent.h"
+#include "Io_TractiveSystemVoltage.h"
 
 // In STM32 terminology, each ADC pin corresponds to an ADC channel (See:
 // ADCEx_channels). If there are multiple ADC channels being measured, the ADC
@@ -10,12 +11,12 @@
 // For example, suppose we are measuring ADC channel 2, 4, and 7, which have
 // rank 3, 1, and 2 respectively. The ADC will measure the channel 4, then
 // channel 7, and finally channel 2. This order is important because it
-// determines the order in which the DMA writes data to our raw_adc2_values
-// buffer.
+// determines the order in which the DMA writes each conversion set into the
+// buffer of raw ADC values.
 //
-// The following enum is used to index into raw_adc2_values, which means it must
-// be ordered in ascending ranks. If we were writing an enum for the earlier
-// example, it would look like:
+// The following enum is used to index into each conversion set, which means it
+// must be ordered in ascending ranks. If we were writing an enum for the
+// earlier example, it would look like:
 //
 // enum
 // {
@@ -38,59 +39,90 @@ enum
     NUM_ADC2_CHANNELS
 };
 
-static uint16_t raw_adc1_values[NUM_ADC1_CHANNELS];
-static uint16_t raw_adc2_values[NUM_ADC2_CHANNELS];
-static float    adc1_voltages[NUM_ADC1_CHANNELS];
-static float    adc2_voltages[NUM_ADC2_CHANNELS];
+// The number of conversion sets converted at a time. The tractive system
+// voltage is sampled, and the main current integrated, once per conversion set
+// at ADC1_ADC2_FREQUENCY, so they are converted one at a time. The DMA still
+// writes the other half of the buffer while one is converted.
+#define NUM_CONVERSION_SETS 1U
 
-void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+static const struct AdcChannelConfig adc1_channel_configs[NUM_ADC1_CHANNELS] = {
+    [ADC1_CHANNEL_3] = { .oversampling_ratio = 1U,
+                         .gain               = 1.0f,
+                         .offset             = 0.0f },
+};
+
+static const struct AdcChannelConfig adc2_channel_configs[NUM_ADC2_CHANNELS] = {
+    [ADC2_CHANNEL_1] = { .oversampling_ratio = 1U,
+                         .gain               = 1.0f,
+                         .offset             = 0.0f },
+    [ADC2_CHANNEL_3] = { .oversampling_ratio = 1U,
+                         .gain               = 1.0f,
+                         .offset             = 0.0f },
+    [ADC2_CHANNEL_4] = { .oversampling_ratio = 1U,
+                         .gain               = 1.0f,
+                         .offset             = 0.0f },
+};
+
+static struct DmaAdc *adc1;
+static struct DmaAdc *adc2;
+
+/**
+ * Process the values of the given ADC, once its latest conversion sets have
+ * been converted
+ * @param hadc: The handle of the ADC
+ */
+static void Io_ProcessConvertedValues(const ADC_HandleTypeDef *hadc);
+
+static void Io_ProcessConvertedValues(const ADC_HandleTypeDef *const hadc)
 {
     if (hadc->Instance == ADC1)
     {
-        adc1_voltages[ADC1_CHANNEL_3] =
-            Io_SharedAdc_ConvertRawAdcValueToVoltage(
-                hadc, raw_adc1_values[ADC1_CHANNEL_3]);
+        Io_TractiveSystemVoltage_SampleVoltage();
     }
     else if (hadc->Instance == ADC2)
     {
-        adc2_voltages[ADC2_CHANNEL_1] =
-            Io_SharedAdc_ConvertRawAdcValueToVoltage(
-                hadc, raw_adc2_values[ADC2_CHANNEL_1]);
-        adc2_voltages[ADC2_CHANNEL_3] =
-            Io_SharedAdc_ConvertRawAdcValueToVoltage(
-                hadc, raw_adc2_values[ADC2_CHANNEL_3]);
-        adc2_voltages[ADC2_CHANNEL_4] =
-            Io_SharedAdc_ConvertRawAdcValueToVoltage(
-                hadc, raw_adc2_values[ADC2_CHANNEL_4]);
+        Io_MainCurrent_IntegrateCurrent();
     }
 }
 
-uint16_t *Io_Adc_GetRawAdc1Values(void)
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    Io_SharedDmaAdc_ConvertFirstHalf(
+        Io_SharedDmaAdc_IsHandle(adc1, hadc) ? adc1 : adc2);
+    Io_ProcessConvertedValues(hadc);
+}
+
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
 {
-    return raw_adc1_values;
+    Io_SharedDmaAdc_ConvertSecondHalf(
+        Io_SharedDmaAdc_IsHandle(adc1, hadc) ? adc1 : adc2);
+    Io_ProcessConvertedValues(hadc);
 }
 
-uint16_t *Io_Adc_GetRawAdc2Values(void)
+void Io_Adc_Init(ADC_HandleTypeDef *const hadc1, ADC_HandleTypeDef *const hadc2)
 {
-    return raw_adc2_values;
+    adc1 = Io_SharedDmaAdc_Create(
+        hadc1, NUM_CONVERSION_SETS, adc1_channel_configs);
+    adc2 = Io_SharedDmaAdc_Create(
+        hadc2, NUM_CONVERSION_SETS, adc2_channel_configs);
 }
 
 float Io_Adc_GetAdc1Channel3Voltage(void)
 {
-    return adc1_voltages[ADC1_CHANNEL_3];
+    return Io_SharedDmaAdc_GetValue(adc1, ADC1_CHANNEL_3);
 }
 
 float Io_Adc_GetAdc2Channel1Voltage(void)
 {
-    return adc2_voltages[ADC2_CHANNEL_1];
+    return Io_SharedDmaAdc_GetValue(adc2, ADC2_CHANNEL_1);
 }
 
 float Io_Adc_GetAdc2Channel3Voltage(void)
 {
-    return adc2_voltages[ADC2_CHANNEL_3];
+    return Io_SharedDmaAdc_GetValue(adc2, ADC2_CHANNEL_3);
 }
 
 float Io_Adc_GetAdc2Channel4Voltage(void)
 {
-    return adc2_voltages[ADC2_CHANNEL_4];
+    return Io_SharedDmaAdc_GetValue(adc2, ADC2_CHANNEL_4);
 }
@@ -0,0 +1,55 @@
+#include <FreeRTOS.h>
+#include <task.h>
+#include <string.h>
+#include "Io_CellDiagnostics.h"
+
+// The latest result of every diagnostic, which is updated from the SPI DMA
+// interrupt
+static uint16_t latest_voltages[NUM_OF_CELL_DIAGNOSTICS]
+                               [NUM_OF_CELL_MONITOR_CHIPS]
+                               [NUM_OF_CELLS_PER_SEGMENT];
+static uint32_t num_results[NUM_OF_CELL_DIAGNOSTICS];
+
+// The number of results of every diagnostic the application has read
+static uint32_t num_results_read[NUM_OF_CELL_DIAGNOSTICS];
+
+void Io_CellDiagnostics_UpdateFromScan(const struct LTC6813Scan *const scan)
+{
+    if (!scan->has_diagnostic || !scan->is_pec15_ok)
+    {
+        return;
+    }
+
+    for (size_t current_chip = 0U; current_chip < NUM_OF_CELL_MONITOR_CHIPS;
+         current_chip++)
+    {
+        memcpy(
+            latest_voltages[scan->diagnostic][current_chip],
+            scan->diagnostic_voltages[current_chip],
+            sizeof(latest_voltages[scan->diagnostic][current_chip]));
+    }
+
+    num_results[scan->diagnostic]++;
+}
+
+ExitCode Io_CellDiagnostics_ReadDiagnostic(
+    enum CellDiagnostic diagnostic,
+    uint16_t (*const voltages)[NUM_OF_CELLS_PER_SEGMENT])
+{
+    // Mask the SPI DMA interrupt while copying, so the application never sees
+    // a result from two different scans
+    taskENTER_CRITICAL();
+    memcpy(
+        voltages, latest_voltages[diagnostic],
+        sizeof(latest_voltages[diagnostic]));
+    const uint32_t num_results_copied = num_results[diagnostic];
+    taskEXIT_CRITICAL();
+
+    if (num_results_copied == num_results_read[diagnostic])
+    {
+        return EXIT_CODE_TIMEOUT;
+    }
+
+    num_results_read[diagnostic] = num_results_copied;
+    return EXIT_CODE_OK;
+}
@@ -1,3 +1,4 @@
+#include <math.h>
 #include <stddef.h>
 #include "Io_CurrentSense.h"
 
@@ -81,6 +82,35 @@ ExitCode Io_CurrentSense_ConvertToHighResolutionMainCurrent(
     return EXIT_CODE_OK;
 }
 
+ExitCode Io_CurrentSense_ConvertToMainCurrent(
+    float  low_res_adc_voltage,
+    float  high_res_adc_voltage,
+    float *main_current)
+{
+    if (main_current == NULL)
+        return EXIT_CODE_INVALID_ARGS;
+
+    float          low_res_main_current;
+    const ExitCode exit_code =
+        Io_CurrentSense_ConvertToLowResolutionMainCurrent(
+            low_res_adc_voltage, &low_res_main_current);
+    if (exit_code != EXIT_CODE_OK)
+        return exit_code;
+
+    // Output 1 saturates at +/- 50A, so switch to output 2 with some margin
+    // before that, where output 1 is still linear
+    const float max_low_res_main_current = 45.0f;
+
+    if (fabsf(low_res_main_current) <= max_low_res_main_current)
+    {
+        *main_current = low_res_main_current;
+        return EXIT_CODE_OK;
+    }
+
+    return Io_CurrentSense_ConvertToHighResolutionMainCurrent(
+        high_res_adc_voltage, main_current);
+}
+
 ExitCode Io_CurrentSense_ConvertToAirLoopCurrent(
     float  adc_voltage,
     float *air_loop_current)
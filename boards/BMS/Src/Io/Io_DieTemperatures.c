@@ -1,50 +1,54 @@
+#include <FreeRTOS.h>
+#include <task.h>
 #include <stdint.h>
+#include <string.h>
 #include "Io_DieTemperatures.h"
-#include "Io_SharedSpi.h"
-#include "Io_LTC6813.h"
 #include "configs/App_AccumulatorConfigs.h"
-#include "configs/Io_LTC6813Configs.h"
+
+// The index of the internal die temperature (ITMP) in the status registers
+#define ITMP_STATUS_REGISTER 1U
 
 static float internal_die_temp[NUM_OF_CELL_MONITOR_CHIPS];
 
-ExitCode Io_DieTemperatures_ReadTemp(void)
+// The raw internal die temperatures of the latest scan, which are updated from
+// the SPI DMA interrupt
+static uint16_t latest_raw_die_temp[NUM_OF_CELL_MONITOR_CHIPS];
+static bool     is_latest_scan_pec15_ok;
+static uint32_t num_scans;
+
+void Io_DieTemperatures_UpdateFromScan(const struct LTC6813Scan *const scan)
 {
-    // The command used to start internal device conversions.
-    const uint16_t ADSTAT = (0x468 + (MD << 7) + CHST);
+    for (size_t current_chip = 0U; current_chip < NUM_OF_CELL_MONITOR_CHIPS;
+         current_chip++)
+    {
+        latest_raw_die_temp[current_chip] =
+            scan->statuses[current_chip][ITMP_STATUS_REGISTER];
+    }
 
-    RETURN_CODE_IF_EXIT_NOT_OK(Io_LTC6813_EnterReadyState());
-    RETURN_CODE_IF_EXIT_NOT_OK(Io_LTC6813_SendCommand(ADSTAT));
-    RETURN_CODE_IF_EXIT_NOT_OK(Io_LTC6813_PollConversions());
+    is_latest_scan_pec15_ok = scan->is_pec15_ok;
+    num_scans++;
+}
 
-    uint8_t rx_internal_die_temp[NUM_OF_RX_BYTES * NUM_OF_CELL_MONITOR_CHIPS];
+ExitCode Io_DieTemperatures_ReadTemp(void)
+{
+    uint16_t raw_die_temp[NUM_OF_CELL_MONITOR_CHIPS];
 
-    // The command used to read data from status register A.
-    const uint16_t RDSTATA = 0x0010;
-    uint8_t        tx_cmd[NUM_OF_CMD_BYTES];
-    tx_cmd[0] = (uint8_t)(RDSTATA >> 8);
-    tx_cmd[1] = (uint8_t)(RDSTATA);
-    uint16_t tx_cmd_pec15 =
-        Io_LTC6813_CalculatePec15(tx_cmd, NUM_OF_PEC15_BYTES_PER_CMD);
-    tx_cmd[2] = (uint8_t)(tx_cmd_pec15 >> 8);
-    tx_cmd[3] = (uint8_t)(tx_cmd_pec15);
+    // Mask the SPI DMA interrupt while copying, so every die temperature is
+    // from the same scan
+    taskENTER_CRITICAL();
+    memcpy(raw_die_temp, latest_raw_die_temp, sizeof(raw_die_temp));
+    const bool     is_pec15_ok      = is_latest_scan_pec15_ok;
+    const uint32_t num_scans_copied = num_scans;
+    taskEXIT_CRITICAL();
+
+    if (num_scans_copied == 0U)
+    {
+        return EXIT_CODE_TIMEOUT;
+    }
 
     for (size_t current_chip = 0U; current_chip < NUM_OF_CELL_MONITOR_CHIPS;
          current_chip++)
     {
-        if (Io_SharedSpi_TransmitAndReceive(
-                Io_LTC6813_GetSpiInterface(), tx_cmd, NUM_OF_CMD_BYTES,
-                rx_internal_die_temp,
-                NUM_OF_CELL_MONITOR_CHIPS * NUM_OF_RX_BYTES) != HAL_OK)
-        {
-            return EXIT_CODE_ERROR;
-        }
-
-        // The upper byte of the internal die temperature is stored in the
-        // 3rd byte, while the lower byte is stored in the 2nd byte.
-        const uint16_t _internal_die_temp = (uint16_t)(
-            (rx_internal_die_temp[2 + NUM_OF_RX_BYTES * current_chip]) |
-            (rx_internal_die_temp[3 + NUM_OF_RX_BYTES * current_chip] << 8));
-
         // Calculate the internal die temperature using the following equation:
         //
         //                                           (1°C * 100µV)
@@ -52,55 +56,20 @@ ExitCode Io_DieTemperatures_ReadTemp(void)
         //                                              7.6 mV
 
         internal_die_temp[current_chip] =
-            (float)_internal_die_temp * 100e-6f / 7.6e-3f - 276.0f;
-
-        // The received PEC15 bytes are stored in the 6th and 7th byte.
-        const uint16_t received_pec15 = (uint16_t)(
-            (rx_internal_die_temp[6 + NUM_OF_RX_BYTES * current_chip] << 8) |
-            (rx_internal_die_temp[7 + NUM_OF_RX_BYTES * current_chip]));
-
-        // Calculate the PEC15 using the first 6 bytes of data received from the
-        // chip.
-        const uint16_t calculated_pec15 = Io_LTC6813_CalculatePec15(
-            &rx_internal_die_temp[current_chip * NUM_OF_RX_BYTES], 6U);
-
-        if (received_pec15 != calculated_pec15)
-        {
-            return EXIT_CODE_ERROR;
-        }
+            (float)raw_die_temp[current_chip] * 100e-6f / 7.6e-3f - 276.0f;
     }
 
-    return EXIT_CODE_OK;
-}
-
-float Io_DieTemperatures_GetSegment0DieTemp(void)
-{
-    return internal_die_temp[0];
+    return is_pec15_ok ? EXIT_CODE_OK : EXIT_CODE_ERROR;
 }
 
-float Io_DieTemperatures_GetSegment1DieTemp(void)
+float Io_DieTemperatures_GetDieTemp(size_t chip)
 {
-    return internal_die_temp[1];
-}
-
-float Io_DieTemperatures_GetSegment2DieTemp(void)
-{
-    return 0.0f;
-}
-
-float Io_DieTemperatures_GetSegment3DieTemp(void)
-{
-    return 0.0f;
-}
-
-float Io_DieTemperatures_GetSegment4DieTemp(void)
-{
-    return 0.0f;
-}
+    if (chip >= NUM_OF_CELL_MONITOR_CHIPS)
+    {
+        return 0.0f;
+    }
 
-float Io_DieTemperatures_GetSegment5DieTemp(void)
-{
-    return 0.0f;
+    return internal_die_temp[chip];
 }
 
 float Io_DieTemperatures_GetMaxDieTemp(void)
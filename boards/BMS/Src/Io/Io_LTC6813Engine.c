@@ -0,0 +1,569 @@
+#include <FreeRTOS.h>
+#include <task.h>
+#include <string.h>
+#include "Io_LTC6813Engine.h"
+#include "Io_LTC6813.h"
+#include "Io_LTC6813Schedule.h"
+#include "Io_SharedSpi.h"
+#include "configs/Io_LTC6813Configs.h"
+
+#define NUM_OF_REGISTERS_PER_REGISTER_GROUP 3U
+#define MAX_NUM_OF_REGISTER_GROUPS_PER_CONVERSION 6U
+
+#define MAX_TRANSFER_SIZE \
+    (NUM_OF_CMD_BYTES + NUM_OF_RX_BYTES * NUM_OF_CELL_MONITOR_CHIPS)
+
+// The commands used to write to configuration registers A and B and to read
+// back the register groups
+#define WRCFGA 0x0001U
+#define WRCFGB 0x0024U
+#define RDCVA 0x0004U
+#define RDCVB 0x0006U
+#define RDCVC 0x0008U
+#define RDCVD 0x000AU
+#define RDCVE 0x0009U
+#define RDCVF 0x000BU
+#define RDAUXA 0x000CU
+#define RDAUXB 0x000EU
+#define RDAUXC 0x000DU
+#define RDSTATA 0x0010U
+#define RDSTATB 0x0012U
+
+// Every conversion is started by waking up each chip, writing each
+// configuration register if requested and sending the conversion command,
+// followed by the read back of the previous conversion
+#define MAX_NUM_OF_QUEUED_TRANSFERS \
+    (NUM_OF_CELL_MONITOR_CHIPS + 3U + MAX_NUM_OF_REGISTER_GROUPS_PER_CONVERSION)
+
+enum LTC6813TransferType
+{
+    LTC6813_TRANSFER_WAKE_UP,
+    LTC6813_TRANSFER_WRITE_CONFIGURATION,
+    LTC6813_TRANSFER_COMMAND,
+    LTC6813_TRANSFER_READ_REGISTER_GROUP,
+};
+
+struct LTC6813RegisterGroup
+{
+    uint16_t command;
+
+    // The registers of the 0th chip in the scan. The registers of every other
+    // chip follow every num_registers_per_chip registers.
+    uint16_t *registers;
+    size_t    num_registers_per_chip;
+};
+
+struct LTC6813ConversionConfig
+{
+    uint16_t                           command;
+    const struct LTC6813RegisterGroup *register_groups;
+    size_t                             num_register_groups;
+
+    // Whether the conversion overwrites the cell voltage registers, so it can't
+    // run while the cell voltages of another conversion are read back
+    bool writes_cell_voltage_registers;
+};
+
+struct LTC6813Transfer
+{
+    enum LTC6813TransferType           type;
+    uint16_t                           command;
+    const struct LTC6813RegisterGroup *register_group;
+    bool                               is_last_of_scan;
+};
+
+static struct LTC6813Scan scan;
+
+static const struct LTC6813RegisterGroup cell_voltage_register_groups[] = {
+    { RDCVA, &scan.cell_voltages[0][0], NUM_OF_CELL_VOLTAGE_REGISTERS },
+    { RDCVB, &scan.cell_voltages[0][3], NUM_OF_CELL_VOLTAGE_REGISTERS },
+    { RDCVC, &scan.cell_voltages[0][6], NUM_OF_CELL_VOLTAGE_REGISTERS },
+    { RDCVD, &scan.cell_voltages[0][9], NUM_OF_CELL_VOLTAGE_REGISTERS },
+    { RDCVE, &scan.cell_voltages[0][12], NUM_OF_CELL_VOLTAGE_REGISTERS },
+    { RDCVF, &scan.cell_voltages[0][15], NUM_OF_CELL_VOLTAGE_REGISTERS },
+};
+
+static const struct LTC6813RegisterGroup aux_register_groups[] = {
+    { RDAUXA, &scan.aux_voltages[0][0], NUM_OF_AUX_REGISTERS },
+    { RDAUXB, &scan.aux_voltages[0][3], NUM_OF_AUX_REGISTERS },
+    { RDAUXC, &scan.aux_voltages[0][6], NUM_OF_AUX_REGISTERS },
+};
+
+static const struct LTC6813RegisterGroup status_register_groups[] = {
+    { RDSTATA, &scan.statuses[0][0], NUM_OF_STATUS_REGISTERS },
+    { RDSTATB, &scan.statuses[0][3], NUM_OF_STATUS_REGISTERS },
+};
+
+// The diagnostics overwrite the cell voltage registers, so they are read back
+// from the same registers into the diagnostic voltages of the scan
+static const struct LTC6813RegisterGroup open_wire_register_groups[] = {
+    { RDCVA, &scan.diagnostic_voltages[0][0], NUM_OF_CELL_VOLTAGE_REGISTERS },
+    { RDCVB, &scan.diagnostic_voltages[0][3], NUM_OF_CELL_VOLTAGE_REGISTERS },
+    { RDCVC, &scan.diagnostic_voltages[0][6], NUM_OF_CELL_VOLTAGE_REGISTERS },
+    { RDCVD, &scan.diagnostic_voltages[0][9], NUM_OF_CELL_VOLTAGE_REGISTERS },
+    { RDCVE, &scan.diagnostic_voltages[0][12], NUM_OF_CELL_VOLTAGE_REGISTERS },
+    { RDCVF, &scan.diagnostic_voltages[0][15], NUM_OF_CELL_VOLTAGE_REGISTERS },
+};
+
+// The overlap conversion only writes cells 7, 8, 13 and 14
+static const struct LTC6813RegisterGroup adc_overlap_register_groups[] = {
+    { RDCVC, &scan.diagnostic_voltages[0][6], NUM_OF_CELL_VOLTAGE_REGISTERS },
+    { RDCVE, &scan.diagnostic_voltages[0][12], NUM_OF_CELL_VOLTAGE_REGISTERS },
+};
+
+static const struct LTC6813ConversionConfig
+    conversions[NUM_OF_LTC6813_CONVERSIONS] = {
+        [LTC6813_CELL_VOLTAGE_CONVERSION] = {
+            .command             = 0x260 + (MD << 7) + (DCP << 4) + CH, // ADCV
+            .register_groups     = cell_voltage_register_groups,
+            .num_register_groups = sizeof(cell_voltage_register_groups) /
+                                   sizeof(cell_voltage_register_groups[0]),
+            .writes_cell_voltage_registers = true,
+        },
+        [LTC6813_AUX_CONVERSION] = {
+            .command             = 0x460 + (MD << 7) + CHG, // ADAX
+            .register_groups     = aux_register_groups,
+            .num_register_groups = sizeof(aux_register_groups) /
+                                   sizeof(aux_register_groups[0]),
+        },
+        [LTC6813_STATUS_CONVERSION] = {
+            .command             = 0x468 + (MD << 7) + CHST, // ADSTAT
+            .register_groups     = status_register_groups,
+            .num_register_groups = sizeof(status_register_groups) /
+                                   sizeof(status_register_groups[0]),
+        },
+        [LTC6813_OPEN_WIRE_PULL_UP_CONVERSION] = {
+            .command = 0x228 + (MD << 7) + (1U << 6) + (DCP << 4) + CH, // ADOW
+            .register_groups     = open_wire_register_groups,
+            .num_register_groups = sizeof(open_wire_register_groups) /
+                                   sizeof(open_wire_register_groups[0]),
+            .writes_cell_voltage_registers = true,
+        },
+        [LTC6813_OPEN_WIRE_PULL_DOWN_CONVERSION] = {
+            .command = 0x228 + (MD << 7) + (0U << 6) + (DCP << 4) + CH, // ADOW
+            .register_groups     = open_wire_register_groups,
+            .num_register_groups = sizeof(open_wire_register_groups) /
+                                   sizeof(open_wire_register_groups[0]),
+            .writes_cell_voltage_registers = true,
+        },
+        [LTC6813_ADC_OVERLAP_CONVERSION] = {
+            .command             = 0x201 + (MD << 7) + (DCP << 4), // ADOL
+            .register_groups     = adc_overlap_register_groups,
+            .num_register_groups = sizeof(adc_overlap_register_groups) /
+                                   sizeof(adc_overlap_register_groups[0]),
+            .writes_cell_voltage_registers = true,
+        },
+    };
+
+static struct
+{
+    struct SharedSpi *spi_interface;
+    void (*scan_complete_callback)(const struct LTC6813Scan *);
+    float (*sample_callback)(void);
+
+    // Transfers are only queued while the queue is idle, after which they are
+    // started one after the other from the SPI DMA interrupt
+    struct LTC6813Transfer queue[MAX_NUM_OF_QUEUED_TRANSFERS];
+    size_t                 num_queued_transfers;
+    volatile size_t        current_transfer;
+    volatile bool          is_busy;
+    uint32_t               queue_start_ms;
+
+    // The configuration of every chip, followed by its PEC15. A configuration
+    // register is only written to the daisy chain when it was requested, which
+    // is when it changes or when every chip has to be configured again.
+    uint8_t       register_a[NUM_OF_CELL_MONITOR_CHIPS][NUM_OF_RX_BYTES];
+    uint8_t       register_b[NUM_OF_CELL_MONITOR_CHIPS][NUM_OF_RX_BYTES];
+    volatile bool is_register_a_write_requested;
+    volatile bool is_register_b_write_requested;
+
+    enum LTC6813Conversion conversion;
+    volatile bool          is_converting;
+    uint32_t               conversion_start_ms;
+
+    // The value sampled as the last cell voltage conversion started
+    volatile float cell_voltage_conversion_sample;
+
+    // The number of scans started, and the diagnostic converted in the next
+    // scan that converts a diagnostic
+    uint32_t            num_scans;
+    enum CellDiagnostic diagnostic;
+
+    uint8_t tx_buffer[MAX_TRANSFER_SIZE];
+    uint8_t rx_buffer[MAX_TRANSFER_SIZE];
+} engine;
+
+/**
+ * Restart the scan from the cell voltage conversion, after the queue of
+ * transfers was interrupted
+ */
+static void Io_LTC6813Engine_RestartScan(void)
+{
+    engine.is_busy       = false;
+    engine.is_converting = false;
+    scan.is_pec15_ok     = true;
+    scan.has_diagnostic  = false;
+}
+
+/**
+ * Add a transfer to the back of the queue of transfers
+ * @param type The type of the transfer
+ * @param command The command sent by the transfer, if any
+ * @param register_group The register group read back by the transfer, if any
+ * @param is_last_of_scan Whether the transfer completes the scan
+ */
+static void Io_LTC6813Engine_Enqueue(
+    enum LTC6813TransferType                 type,
+    uint16_t                                 command,
+    const struct LTC6813RegisterGroup *const register_group,
+    bool                                     is_last_of_scan)
+{
+    struct LTC6813Transfer *const transfer =
+        &engine.queue[engine.num_queued_transfers++];
+
+    transfer->type            = type;
+    transfer->command         = command;
+    transfer->register_group  = register_group;
+    transfer->is_last_of_scan = is_last_of_scan;
+}
+
+/**
+ * Queue the read back of every register group of the conversion that just
+ * completed
+ */
+static void Io_LTC6813Engine_EnqueueReadBack(void)
+{
+    const struct LTC6813ConversionConfig *const completed_conversion =
+        &conversions[engine.conversion];
+    for (size_t i = 0U; i < completed_conversion->num_register_groups; i++)
+    {
+        const bool is_last_of_scan =
+            engine.conversion == LTC6813_STATUS_CONVERSION &&
+            i == completed_conversion->num_register_groups - 1U;
+        Io_LTC6813Engine_Enqueue(
+            LTC6813_TRANSFER_READ_REGISTER_GROUP,
+            completed_conversion->register_groups[i].command,
+            &completed_conversion->register_groups[i], is_last_of_scan);
+    }
+
+    if (engine.conversion == LTC6813_CELL_VOLTAGE_CONVERSION)
+    {
+        scan.cell_voltage_conversion_sample =
+            engine.cell_voltage_conversion_sample;
+    }
+    if (engine.conversion ==
+        Io_LTC6813Schedule_GetDiagnosticConversion(engine.diagnostic))
+    {
+        scan.has_diagnostic = true;
+        scan.diagnostic     = engine.diagnostic;
+        engine.diagnostic   = (enum CellDiagnostic)(
+            (engine.diagnostic + 1U) % NUM_OF_CELL_DIAGNOSTICS);
+    }
+}
+
+/**
+ * Start the DMA transfer at the front of the queue of transfers
+ */
+static void Io_LTC6813Engine_StartTransfer(void)
+{
+    const struct LTC6813Transfer *const transfer =
+        &engine.queue[engine.current_transfer];
+
+    uint16_t size = MAX_TRANSFER_SIZE;
+    switch (transfer->type)
+    {
+        case LTC6813_TRANSFER_WAKE_UP:
+        {
+            engine.tx_buffer[0] = 0xFF;
+            size                = 1U;
+        }
+        break;
+        case LTC6813_TRANSFER_WRITE_CONFIGURATION:
+        {
+            // The configuration shifted in first ends up in the chip furthest
+            // down the daisy chain, so the chips are written in reverse
+            uint8_t(*const registers)[NUM_OF_RX_BYTES] =
+                transfer->command == WRCFGA ? engine.register_a
+                                            : engine.register_b;
+            for (size_t current_chip = 0U;
+                 current_chip < NUM_OF_CELL_MONITOR_CHIPS; current_chip++)
+            {
+                memcpy(
+                    &engine.tx_buffer
+                         [NUM_OF_CMD_BYTES +
+                          (NUM_OF_CELL_MONITOR_CHIPS - 1U - current_chip) *
+                              NUM_OF_RX_BYTES],
+                    registers[current_chip], NUM_OF_RX_BYTES);
+            }
+        }
+        break;
+        case LTC6813_TRANSFER_COMMAND:
+        {
+            size = NUM_OF_CMD_BYTES;
+        }
+        break;
+        case LTC6813_TRANSFER_READ_REGISTER_GROUP:
+        {
+            // Keep the data line high while the register groups are clocked
+            // out of the daisy chain
+            memset(
+                &engine.tx_buffer[NUM_OF_CMD_BYTES], 0xFF,
+                MAX_TRANSFER_SIZE - NUM_OF_CMD_BYTES);
+        }
+        break;
+    }
+
+    if (transfer->type != LTC6813_TRANSFER_WAKE_UP)
+    {
+        engine.tx_buffer[0]         = (uint8_t)(transfer->command >> 8);
+        engine.tx_buffer[1]         = (uint8_t)(transfer->command);
+        const uint16_t tx_cmd_pec15 = Io_LTC6813_CalculatePec15(
+            engine.tx_buffer, NUM_OF_PEC15_BYTES_PER_CMD);
+        engine.tx_buffer[2] = (uint8_t)(tx_cmd_pec15 >> 8);
+        engine.tx_buffer[3] = (uint8_t)(tx_cmd_pec15);
+    }
+
+    if (Io_SharedSpi_TransmitAndReceiveDma(
+            engine.spi_interface, engine.tx_buffer, engine.rx_buffer, size) !=
+        HAL_OK)
+    {
+        Io_LTC6813Engine_RestartScan();
+    }
+}
+
+/**
+ * Parse a register group read back from every chip into the scan, skipping the
+ * chips whose data fails its PEC15 check
+ * @param register_group The register group that was read back
+ */
+static void Io_LTC6813Engine_ParseRegisterGroup(
+    const struct LTC6813RegisterGroup *const register_group)
+{
+    const uint8_t *const rx_data = &engine.rx_buffer[NUM_OF_CMD_BYTES];
+
+    bool           is_pec15_ok[NUM_OF_CELL_MONITOR_CHIPS];
+    const uint32_t num_pec15_errors =
+        Io_LTC6813_CheckRegisterGroupPec15s(rx_data, is_pec15_ok);
+    if (num_pec15_errors > 0U)
+    {
+        scan.is_pec15_ok = false;
+        scan.num_pec15_errors += num_pec15_errors;
+    }
+
+    for (size_t current_chip = 0U; current_chip < NUM_OF_CELL_MONITOR_CHIPS;
+         current_chip++)
+    {
+        if (!is_pec15_ok[current_chip])
+        {
+            continue;
+        }
+
+        const uint8_t *const chip_rx_data =
+            &rx_data[current_chip * NUM_OF_RX_BYTES];
+
+        uint16_t *const registers =
+            &register_group->registers
+                 [current_chip * register_group->num_registers_per_chip];
+        for (size_t i = 0U; i < NUM_OF_REGISTERS_PER_REGISTER_GROUP; i++)
+        {
+            // Each register is sent as 2 bytes, with the lower byte first
+            registers[i] = (uint16_t)(
+                chip_rx_data[2U * i] | (chip_rx_data[2U * i + 1U] << 8));
+        }
+    }
+}
+
+void Io_LTC6813Engine_Init(
+    void (*scan_complete_callback)(const struct LTC6813Scan *),
+    float (*sample_callback)(void))
+{
+    engine.spi_interface          = Io_LTC6813_GetSpiInterface();
+    engine.scan_complete_callback = scan_complete_callback;
+    engine.sample_callback        = sample_callback;
+
+    for (size_t current_chip = 0U; current_chip < NUM_OF_CELL_MONITOR_CHIPS;
+         current_chip++)
+    {
+        Io_LTC6813_GetRegisterA(0U, engine.register_a[current_chip]);
+        Io_LTC6813_GetRegisterB(0U, engine.register_b[current_chip]);
+    }
+    engine.is_register_a_write_requested = true;
+    engine.is_register_b_write_requested = true;
+
+    Io_LTC6813Engine_RestartScan();
+}
+
+ExitCode Io_LTC6813Engine_ConfigureCellMonitors(void)
+{
+    engine.is_register_a_write_requested = true;
+    engine.is_register_b_write_requested = true;
+
+    return EXIT_CODE_OK;
+}
+
+ExitCode Io_LTC6813Engine_WriteDischargeCells(const uint32_t *discharge_cells)
+{
+    uint8_t register_a[NUM_OF_CELL_MONITOR_CHIPS][NUM_OF_RX_BYTES];
+    uint8_t register_b[NUM_OF_CELL_MONITOR_CHIPS][NUM_OF_RX_BYTES];
+    for (size_t current_chip = 0U; current_chip < NUM_OF_CELL_MONITOR_CHIPS;
+         current_chip++)
+    {
+        Io_LTC6813_GetRegisterA(
+            discharge_cells[current_chip], register_a[current_chip]);
+        Io_LTC6813_GetRegisterB(
+            discharge_cells[current_chip], register_b[current_chip]);
+    }
+
+    // Mask the SPI DMA interrupt while updating the configuration, so a
+    // configuration register is never written to the daisy chain half updated
+    taskENTER_CRITICAL();
+    if (memcmp(engine.register_a, register_a, sizeof(register_a)) != 0)
+    {
+        memcpy(engine.register_a, register_a, sizeof(register_a));
+        engine.is_register_a_write_requested = true;
+    }
+    if (memcmp(engine.register_b, register_b, sizeof(register_b)) != 0)
+    {
+        memcpy(engine.register_b, register_b, sizeof(register_b));
+        engine.is_register_b_write_requested = true;
+    }
+    taskEXIT_CRITICAL();
+
+    return EXIT_CODE_OK;
+}
+
+void Io_LTC6813Engine_Tick1kHz(uint32_t current_ms)
+{
+    if (engine.is_busy)
+    {
+        if (current_ms - engine.queue_start_ms >= SPI_DMA_TIMEOUT_MS_LTC6813)
+        {
+            HAL_SPI_Abort(Io_SharedSpi_GetSpiHandle(engine.spi_interface));
+            Io_SharedSpi_SetNssHigh(engine.spi_interface);
+            Io_LTC6813Engine_RestartScan();
+        }
+        return;
+    }
+
+    if (engine.is_converting &&
+        current_ms - engine.conversion_start_ms <
+            Io_LTC6813Schedule_GetConversionTimeMs(engine.conversion))
+    {
+        return;
+    }
+
+    // Start the next conversion before reading back the conversion that just
+    // completed, so the chips convert while the register groups are read back
+    const enum LTC6813Conversion next_conversion =
+        Io_LTC6813Schedule_GetNextConversion(
+            engine.is_converting, engine.conversion, engine.num_scans,
+            engine.diagnostic);
+    if (next_conversion == LTC6813_CELL_VOLTAGE_CONVERSION)
+    {
+        engine.num_scans++;
+    }
+
+    // A conversion that overwrites the cell voltage registers can't start until
+    // the cell voltages of the last conversion have been read back
+    const bool is_read_back_first =
+        engine.is_converting &&
+        conversions[engine.conversion].writes_cell_voltage_registers &&
+        conversions[next_conversion].writes_cell_voltage_registers;
+
+    engine.num_queued_transfers = 0U;
+    engine.current_transfer     = 0U;
+
+    // The isoSPI ports go idle between conversions, so generate traffic to
+    // wake up every chip on the daisy chain first
+    for (size_t i = 0U; i < NUM_OF_CELL_MONITOR_CHIPS; i++)
+    {
+        Io_LTC6813Engine_Enqueue(LTC6813_TRANSFER_WAKE_UP, 0U, NULL, false);
+    }
+    if (engine.is_register_a_write_requested)
+    {
+        engine.is_register_a_write_requested = false;
+        Io_LTC6813Engine_Enqueue(
+            LTC6813_TRANSFER_WRITE_CONFIGURATION, WRCFGA, NULL, false);
+    }
+    if (engine.is_register_b_write_requested)
+    {
+        engine.is_register_b_write_requested = false;
+        Io_LTC6813Engine_Enqueue(
+            LTC6813_TRANSFER_WRITE_CONFIGURATION, WRCFGB, NULL, false);
+    }
+    if (is_read_back_first)
+    {
+        Io_LTC6813Engine_EnqueueReadBack();
+    }
+    Io_LTC6813Engine_Enqueue(
+        LTC6813_TRANSFER_COMMAND, conversions[next_conversion].command, NULL,
+        false);
+    if (engine.is_converting && !is_read_back_first)
+    {
+        Io_LTC6813Engine_EnqueueReadBack();
+    }
+
+    engine.conversion          = next_conversion;
+    engine.is_converting       = true;
+    engine.conversion_start_ms = current_ms;
+    engine.queue_start_ms      = current_ms;
+    engine.is_busy             = true;
+
+    Io_LTC6813Engine_StartTransfer();
+}
+
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi != Io_SharedSpi_GetSpiHandle(engine.spi_interface) ||
+        !engine.is_busy)
+    {
+        return;
+    }
+
+    Io_SharedSpi_SetNssHigh(engine.spi_interface);
+
+    const struct LTC6813Transfer *const transfer =
+        &engine.queue[engine.current_transfer];
+    if (transfer->type == LTC6813_TRANSFER_COMMAND &&
+        transfer->command ==
+            conversions[LTC6813_CELL_VOLTAGE_CONVERSION].command &&
+        engine.sample_callback != NULL)
+    {
+        engine.cell_voltage_conversion_sample = engine.sample_callback();
+    }
+    else if (transfer->type == LTC6813_TRANSFER_READ_REGISTER_GROUP)
+    {
+        Io_LTC6813Engine_ParseRegisterGroup(transfer->register_group);
+
+        if (transfer->is_last_of_scan)
+        {
+            if (engine.scan_complete_callback != NULL)
+            {
+                engine.scan_complete_callback(&scan);
+            }
+            scan.is_pec15_ok    = true;
+            scan.has_diagnostic = false;
+        }
+    }
+
+    engine.current_transfer++;
+    if (engine.current_transfer < engine.num_queued_transfers)
+    {
+        Io_LTC6813Engine_StartTransfer();
+    }
+    else
+    {
+        engine.is_busy = false;
+    }
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi != Io_SharedSpi_GetSpiHandle(engine.spi_interface))
+    {
+        return;
+    }
+
+    Io_SharedSpi_SetNssHigh(engine.spi_interface);
+    Io_LTC6813Engine_RestartScan();
+}
@@ -0,0 +1,227 @@
+#include <stddef.h>
+#include "Io_LTC6813Pec15.h"
+
+// The lookup table used by the byte-at-a-time implementation, which processes
+// the 15-bit remainder without its implicit x^15 term masked off
+static const uint16_t bytewise_table[UINT8_MAX + 1] = {
+    0x0,    0xC599, 0xCEAB, 0xB32,  0xD8CF, 0x1D56, 0x1664, 0xD3FD, 0xF407,
+    0x319E, 0x3AAC, 0xFF35, 0x2CC8, 0xE951, 0xE263, 0x27FA, 0xAD97, 0x680E,
+    0x633C, 0xA6A5, 0x7558, 0xB0C1, 0xBBF3, 0x7E6A, 0x5990, 0x9C09, 0x973B,
+    0x52A2, 0x815F, 0x44C6, 0x4FF4, 0x8A6D, 0x5B2E, 0x9EB7, 0x9585, 0x501C,
+    0x83E1, 0x4678, 0x4D4A, 0x88D3, 0xAF29, 0x6AB0, 0x6182, 0xA41B, 0x77E6,
+    0xB27F, 0xB94D, 0x7CD4, 0xF6B9, 0x3320, 0x3812, 0xFD8B, 0x2E76, 0xEBEF,
+    0xE0DD, 0x2544, 0x2BE,  0xC727, 0xCC15, 0x98C,  0xDA71, 0x1FE8, 0x14DA,
+    0xD143, 0xF3C5, 0x365C, 0x3D6E, 0xF8F7, 0x2B0A, 0xEE93, 0xE5A1, 0x2038,
+    0x7C2,  0xC25B, 0xC969, 0xCF0,  0xDF0D, 0x1A94, 0x11A6, 0xD43F, 0x5E52,
+    0x9BCB, 0x90F9, 0x5560, 0x869D, 0x4304, 0x4836, 0x8DAF, 0xAA55, 0x6FCC,
+    0x64FE, 0xA167, 0x729A, 0xB703, 0xBC31, 0x79A8, 0xA8EB, 0x6D72, 0x6640,
+    0xA3D9, 0x7024, 0xB5BD, 0xBE8F, 0x7B16, 0x5CEC, 0x9975, 0x9247, 0x57DE,
+    0x8423, 0x41BA, 0x4A88, 0x8F11, 0x57C,  0xC0E5, 0xCBD7, 0xE4E,  0xDDB3,
+    0x182A, 0x1318, 0xD681, 0xF17B, 0x34E2, 0x3FD0, 0xFA49, 0x29B4, 0xEC2D,
+    0xE71F, 0x2286, 0xA213, 0x678A, 0x6CB8, 0xA921, 0x7ADC, 0xBF45, 0xB477,
+    0x71EE, 0x5614, 0x938D, 0x98BF, 0x5D26, 0x8EDB, 0x4B42, 0x4070, 0x85E9,
+    0xF84,  0xCA1D, 0xC12F, 0x4B6,  0xD74B, 0x12D2, 0x19E0, 0xDC79, 0xFB83,
+    0x3E1A, 0x3528, 0xF0B1, 0x234C, 0xE6D5, 0xEDE7, 0x287E, 0xF93D, 0x3CA4,
+    0x3796, 0xF20F, 0x21F2, 0xE46B, 0xEF59, 0x2AC0, 0xD3A,  0xC8A3, 0xC391,
+    0x608,  0xD5F5, 0x106C, 0x1B5E, 0xDEC7, 0x54AA, 0x9133, 0x9A01, 0x5F98,
+    0x8C65, 0x49FC, 0x42CE, 0x8757, 0xA0AD, 0x6534, 0x6E06, 0xAB9F, 0x7862,
+    0xBDFB, 0xB6C9, 0x7350, 0x51D6, 0x944F, 0x9F7D, 0x5AE4, 0x8919, 0x4C80,
+    0x47B2, 0x822B, 0xA5D1, 0x6048, 0x6B7A, 0xAEE3, 0x7D1E, 0xB887, 0xB3B5,
+    0x762C, 0xFC41, 0x39D8, 0x32EA, 0xF773, 0x248E, 0xE117, 0xEA25, 0x2FBC,
+    0x846,  0xCDDF, 0xC6ED, 0x374,  0xD089, 0x1510, 0x1E22, 0xDBBB, 0xAF8,
+    0xCF61, 0xC453, 0x1CA,  0xD237, 0x17AE, 0x1C9C, 0xD905, 0xFEFF, 0x3B66,
+    0x3054, 0xF5CD, 0x2630, 0xE3A9, 0xE89B, 0x2D02, 0xA76F, 0x62F6, 0x69C4,
+    0xAC5D, 0x7fA0, 0xBA39, 0xB10B, 0x7492, 0x5368, 0x96F1, 0x9DC3, 0x585A,
+    0x8BA7, 0x4E3E, 0x450C, 0x8095
+};
+
+// The lookup tables used by the slicing-by-4 implementation. The remainder is
+// kept shifted left by 1 bit, which is how the PEC15 is transmitted, so
+// slicing_by_4_tables[0] is the table of the 16-bit polynomial 0x8B32, and
+// slicing_by_4_tables[k] is the remainder of a byte followed by k zero bytes.
+static const uint16_t slicing_by_4_tables[4][UINT8_MAX + 1] = {
+    { 0x0000, 0x8B32, 0x9D56, 0x1664, 0xB19E, 0x3AAC, 0x2CC8, 0xA7FA, 0xE80E,
+      0x633C, 0x7558, 0xFE6A, 0x5990, 0xD2A2, 0xC4C6, 0x4FF4, 0x5B2E, 0xD01C,
+      0xC678, 0x4D4A, 0xEAB0, 0x6182, 0x77E6, 0xFCD4, 0xB320, 0x3812, 0x2E76,
+      0xA544, 0x02BE, 0x898C, 0x9FE8, 0x14DA, 0xB65C, 0x3D6E, 0x2B0A, 0xA038,
+      0x07C2, 0x8CF0, 0x9A94, 0x11A6, 0x5E52, 0xD560, 0xC304, 0x4836, 0xEFCC,
+      0x64FE, 0x729A, 0xF9A8, 0xED72, 0x6640, 0x7024, 0xFB16, 0x5CEC, 0xD7DE,
+      0xC1BA, 0x4A88, 0x057C, 0x8E4E, 0x982A, 0x1318, 0xB4E2, 0x3FD0, 0x29B4,
+      0xA286, 0xE78A, 0x6CB8, 0x7ADC, 0xF1EE, 0x5614, 0xDD26, 0xCB42, 0x4070,
+      0x0F84, 0x84B6, 0x92D2, 0x19E0, 0xBE1A, 0x3528, 0x234C, 0xA87E, 0xBCA4,
+      0x3796, 0x21F2, 0xAAC0, 0x0D3A, 0x8608, 0x906C, 0x1B5E, 0x54AA, 0xDF98,
+      0xC9FC, 0x42CE, 0xE534, 0x6E06, 0x7862, 0xF350, 0x51D6, 0xDAE4, 0xCC80,
+      0x47B2, 0xE048, 0x6B7A, 0x7D1E, 0xF62C, 0xB9D8, 0x32EA, 0x248E, 0xAFBC,
+      0x0846, 0x8374, 0x9510, 0x1E22, 0x0AF8, 0x81CA, 0x97AE, 0x1C9C, 0xBB66,
+      0x3054, 0x2630, 0xAD02, 0xE2F6, 0x69C4, 0x7FA0, 0xF492, 0x5368, 0xD85A,
+      0xCE3E, 0x450C, 0x4426, 0xCF14, 0xD970, 0x5242, 0xF5B8, 0x7E8A, 0x68EE,
+      0xE3DC, 0xAC28, 0x271A, 0x317E, 0xBA4C, 0x1DB6, 0x9684, 0x80E0, 0x0BD2,
+      0x1F08, 0x943A, 0x825E, 0x096C, 0xAE96, 0x25A4, 0x33C0, 0xB8F2, 0xF706,
+      0x7C34, 0x6A50, 0xE162, 0x4698, 0xCDAA, 0xDBCE, 0x50FC, 0xF27A, 0x7948,
+      0x6F2C, 0xE41E, 0x43E4, 0xC8D6, 0xDEB2, 0x5580, 0x1A74, 0x9146, 0x8722,
+      0x0C10, 0xABEA, 0x20D8, 0x36BC, 0xBD8E, 0xA954, 0x2266, 0x3402, 0xBF30,
+      0x18CA, 0x93F8, 0x859C, 0x0EAE, 0x415A, 0xCA68, 0xDC0C, 0x573E, 0xF0C4,
+      0x7BF6, 0x6D92, 0xE6A0, 0xA3AC, 0x289E, 0x3EFA, 0xB5C8, 0x1232, 0x9900,
+      0x8F64, 0x0456, 0x4BA2, 0xC090, 0xD6F4, 0x5DC6, 0xFA3C, 0x710E, 0x676A,
+      0xEC58, 0xF882, 0x73B0, 0x65D4, 0xEEE6, 0x491C, 0xC22E, 0xD44A, 0x5F78,
+      0x108C, 0x9BBE, 0x8DDA, 0x06E8, 0xA112, 0x2A20, 0x3C44, 0xB776, 0x15F0,
+      0x9EC2, 0x88A6, 0x0394, 0xA46E, 0x2F5C, 0x3938, 0xB20A, 0xFDFE, 0x76CC,
+      0x60A8, 0xEB9A, 0x4C60, 0xC752, 0xD136, 0x5A04, 0x4EDE, 0xC5EC, 0xD388,
+      0x58BA, 0xFF40, 0x7472, 0x6216, 0xE924, 0xA6D0, 0x2DE2, 0x3B86, 0xB0B4,
+      0x174E, 0x9C7C, 0x8A18, 0x012A },
+    { 0x0000, 0x884C, 0x9BAA, 0x13E6, 0xBC66, 0x342A, 0x27CC, 0xAF80, 0xF3FE,
+      0x7BB2, 0x6854, 0xE018, 0x4F98, 0xC7D4, 0xD432, 0x5C7E, 0x6CCE, 0xE482,
+      0xF764, 0x7F28, 0xD0A8, 0x58E4, 0x4B02, 0xC34E, 0x9F30, 0x177C, 0x049A,
+      0x8CD6, 0x2356, 0xAB1A, 0xB8FC, 0x30B0, 0xD99C, 0x51D0, 0x4236, 0xCA7A,
+      0x65FA, 0xEDB6, 0xFE50, 0x761C, 0x2A62, 0xA22E, 0xB1C8, 0x3984, 0x9604,
+      0x1E48, 0x0DAE, 0x85E2, 0xB552, 0x3D1E, 0x2EF8, 0xA6B4, 0x0934, 0x8178,
+      0x929E, 0x1AD2, 0x46AC, 0xCEE0, 0xDD06, 0x554A, 0xFACA, 0x7286, 0x6160,
+      0xE92C, 0x380A, 0xB046, 0xA3A0, 0x2BEC, 0x846C, 0x0C20, 0x1FC6, 0x978A,
+      0xCBF4, 0x43B8, 0x505E, 0xD812, 0x7792, 0xFFDE, 0xEC38, 0x6474, 0x54C4,
+      0xDC88, 0xCF6E, 0x4722, 0xE8A2, 0x60EE, 0x7308, 0xFB44, 0xA73A, 0x2F76,
+      0x3C90, 0xB4DC, 0x1B5C, 0x9310, 0x80F6, 0x08BA, 0xE196, 0x69DA, 0x7A3C,
+      0xF270, 0x5DF0, 0xD5BC, 0xC65A, 0x4E16, 0x1268, 0x9A24, 0x89C2, 0x018E,
+      0xAE0E, 0x2642, 0x35A4, 0xBDE8, 0x8D58, 0x0514, 0x16F2, 0x9EBE, 0x313E,
+      0xB972, 0xAA94, 0x22D8, 0x7EA6, 0xF6EA, 0xE50C, 0x6D40, 0xC2C0, 0x4A8C,
+      0x596A, 0xD126, 0x7014, 0xF858, 0xEBBE, 0x63F2, 0xCC72, 0x443E, 0x57D8,
+      0xDF94, 0x83EA, 0x0BA6, 0x1840, 0x900C, 0x3F8C, 0xB7C0, 0xA426, 0x2C6A,
+      0x1CDA, 0x9496, 0x8770, 0x0F3C, 0xA0BC, 0x28F0, 0x3B16, 0xB35A, 0xEF24,
+      0x6768, 0x748E, 0xFCC2, 0x5342, 0xDB0E, 0xC8E8, 0x40A4, 0xA988, 0x21C4,
+      0x3222, 0xBA6E, 0x15EE, 0x9DA2, 0x8E44, 0x0608, 0x5A76, 0xD23A, 0xC1DC,
+      0x4990, 0xE610, 0x6E5C, 0x7DBA, 0xF5F6, 0xC546, 0x4D0A, 0x5EEC, 0xD6A0,
+      0x7920, 0xF16C, 0xE28A, 0x6AC6, 0x36B8, 0xBEF4, 0xAD12, 0x255E, 0x8ADE,
+      0x0292, 0x1174, 0x9938, 0x481E, 0xC052, 0xD3B4, 0x5BF8, 0xF478, 0x7C34,
+      0x6FD2, 0xE79E, 0xBBE0, 0x33AC, 0x204A, 0xA806, 0x0786, 0x8FCA, 0x9C2C,
+      0x1460, 0x24D0, 0xAC9C, 0xBF7A, 0x3736, 0x98B6, 0x10FA, 0x031C, 0x8B50,
+      0xD72E, 0x5F62, 0x4C84, 0xC4C8, 0x6B48, 0xE304, 0xF0E2, 0x78AE, 0x9182,
+      0x19CE, 0x0A28, 0x8264, 0x2DE4, 0xA5A8, 0xB64E, 0x3E02, 0x627C, 0xEA30,
+      0xF9D6, 0x719A, 0xDE1A, 0x5656, 0x45B0, 0xCDFC, 0xFD4C, 0x7500, 0x66E6,
+      0xEEAA, 0x412A, 0xC966, 0xDA80, 0x52CC, 0x0EB2, 0x86FE, 0x9518, 0x1D54,
+      0xB2D4, 0x3A98, 0x297E, 0xA132 },
+    { 0x0000, 0xE028, 0x4B62, 0xAB4A, 0x96C4, 0x76EC, 0xDDA6, 0x3D8E, 0xA6BA,
+      0x4692, 0xEDD8, 0x0DF0, 0x307E, 0xD056, 0x7B1C, 0x9B34, 0xC646, 0x266E,
+      0x8D24, 0x6D0C, 0x5082, 0xB0AA, 0x1BE0, 0xFBC8, 0x60FC, 0x80D4, 0x2B9E,
+      0xCBB6, 0xF638, 0x1610, 0xBD5A, 0x5D72, 0x07BE, 0xE796, 0x4CDC, 0xACF4,
+      0x917A, 0x7152, 0xDA18, 0x3A30, 0xA104, 0x412C, 0xEA66, 0x0A4E, 0x37C0,
+      0xD7E8, 0x7CA2, 0x9C8A, 0xC1F8, 0x21D0, 0x8A9A, 0x6AB2, 0x573C, 0xB714,
+      0x1C5E, 0xFC76, 0x6742, 0x876A, 0x2C20, 0xCC08, 0xF186, 0x11AE, 0xBAE4,
+      0x5ACC, 0x0F7C, 0xEF54, 0x441E, 0xA436, 0x99B8, 0x7990, 0xD2DA, 0x32F2,
+      0xA9C6, 0x49EE, 0xE2A4, 0x028C, 0x3F02, 0xDF2A, 0x7460, 0x9448, 0xC93A,
+      0x2912, 0x8258, 0x6270, 0x5FFE, 0xBFD6, 0x149C, 0xF4B4, 0x6F80, 0x8FA8,
+      0x24E2, 0xC4CA, 0xF944, 0x196C, 0xB226, 0x520E, 0x08C2, 0xE8EA, 0x43A0,
+      0xA388, 0x9E06, 0x7E2E, 0xD564, 0x354C, 0xAE78, 0x4E50, 0xE51A, 0x0532,
+      0x38BC, 0xD894, 0x73DE, 0x93F6, 0xCE84, 0x2EAC, 0x85E6, 0x65CE, 0x5840,
+      0xB868, 0x1322, 0xF30A, 0x683E, 0x8816, 0x235C, 0xC374, 0xFEFA, 0x1ED2,
+      0xB598, 0x55B0, 0x1EF8, 0xFED0, 0x559A, 0xB5B2, 0x883C, 0x6814, 0xC35E,
+      0x2376, 0xB842, 0x586A, 0xF320, 0x1308, 0x2E86, 0xCEAE, 0x65E4, 0x85CC,
+      0xD8BE, 0x3896, 0x93DC, 0x73F4, 0x4E7A, 0xAE52, 0x0518, 0xE530, 0x7E04,
+      0x9E2C, 0x3566, 0xD54E, 0xE8C0, 0x08E8, 0xA3A2, 0x438A, 0x1946, 0xF96E,
+      0x5224, 0xB20C, 0x8F82, 0x6FAA, 0xC4E0, 0x24C8, 0xBFFC, 0x5FD4, 0xF49E,
+      0x14B6, 0x2938, 0xC910, 0x625A, 0x8272, 0xDF00, 0x3F28, 0x9462, 0x744A,
+      0x49C4, 0xA9EC, 0x02A6, 0xE28E, 0x79BA, 0x9992, 0x32D8, 0xD2F0, 0xEF7E,
+      0x0F56, 0xA41C, 0x4434, 0x1184, 0xF1AC, 0x5AE6, 0xBACE, 0x8740, 0x6768,
+      0xCC22, 0x2C0A, 0xB73E, 0x5716, 0xFC5C, 0x1C74, 0x21FA, 0xC1D2, 0x6A98,
+      0x8AB0, 0xD7C2, 0x37EA, 0x9CA0, 0x7C88, 0x4106, 0xA12E, 0x0A64, 0xEA4C,
+      0x7178, 0x9150, 0x3A1A, 0xDA32, 0xE7BC, 0x0794, 0xACDE, 0x4CF6, 0x163A,
+      0xF612, 0x5D58, 0xBD70, 0x80FE, 0x60D6, 0xCB9C, 0x2BB4, 0xB080, 0x50A8,
+      0xFBE2, 0x1BCA, 0x2644, 0xC66C, 0x6D26, 0x8D0E, 0xD07C, 0x3054, 0x9B1E,
+      0x7B36, 0x46B8, 0xA690, 0x0DDA, 0xEDF2, 0x76C6, 0x96EE, 0x3DA4, 0xDD8C,
+      0xE002, 0x002A, 0xAB60, 0x4B48 },
+    { 0x0000, 0x3DF0, 0x7BE0, 0x4610, 0xF7C0, 0xCA30, 0x8C20, 0xB1D0, 0x64B2,
+      0x5942, 0x1F52, 0x22A2, 0x9372, 0xAE82, 0xE892, 0xD562, 0xC964, 0xF494,
+      0xB284, 0x8F74, 0x3EA4, 0x0354, 0x4544, 0x78B4, 0xADD6, 0x9026, 0xD636,
+      0xEBC6, 0x5A16, 0x67E6, 0x21F6, 0x1C06, 0x19FA, 0x240A, 0x621A, 0x5FEA,
+      0xEE3A, 0xD3CA, 0x95DA, 0xA82A, 0x7D48, 0x40B8, 0x06A8, 0x3B58, 0x8A88,
+      0xB778, 0xF168, 0xCC98, 0xD09E, 0xED6E, 0xAB7E, 0x968E, 0x275E, 0x1AAE,
+      0x5CBE, 0x614E, 0xB42C, 0x89DC, 0xCFCC, 0xF23C, 0x43EC, 0x7E1C, 0x380C,
+      0x05FC, 0x33F4, 0x0E04, 0x4814, 0x75E4, 0xC434, 0xF9C4, 0xBFD4, 0x8224,
+      0x5746, 0x6AB6, 0x2CA6, 0x1156, 0xA086, 0x9D76, 0xDB66, 0xE696, 0xFA90,
+      0xC760, 0x8170, 0xBC80, 0x0D50, 0x30A0, 0x76B0, 0x4B40, 0x9E22, 0xA3D2,
+      0xE5C2, 0xD832, 0x69E2, 0x5412, 0x1202, 0x2FF2, 0x2A0E, 0x17FE, 0x51EE,
+      0x6C1E, 0xDDCE, 0xE03E, 0xA62E, 0x9BDE, 0x4EBC, 0x734C, 0x355C, 0x08AC,
+      0xB97C, 0x848C, 0xC29C, 0xFF6C, 0xE36A, 0xDE9A, 0x988A, 0xA57A, 0x14AA,
+      0x295A, 0x6F4A, 0x52BA, 0x87D8, 0xBA28, 0xFC38, 0xC1C8, 0x7018, 0x4DE8,
+      0x0BF8, 0x3608, 0x67E8, 0x5A18, 0x1C08, 0x21F8, 0x9028, 0xADD8, 0xEBC8,
+      0xD638, 0x035A, 0x3EAA, 0x78BA, 0x454A, 0xF49A, 0xC96A, 0x8F7A, 0xB28A,
+      0xAE8C, 0x937C, 0xD56C, 0xE89C, 0x594C, 0x64BC, 0x22AC, 0x1F5C, 0xCA3E,
+      0xF7CE, 0xB1DE, 0x8C2E, 0x3DFE, 0x000E, 0x461E, 0x7BEE, 0x7E12, 0x43E2,
+      0x05F2, 0x3802, 0x89D2, 0xB422, 0xF232, 0xCFC2, 0x1AA0, 0x2750, 0x6140,
+      0x5CB0, 0xED60, 0xD090, 0x9680, 0xAB70, 0xB776, 0x8A86, 0xCC96, 0xF166,
+      0x40B6, 0x7D46, 0x3B56, 0x06A6, 0xD3C4, 0xEE34, 0xA824, 0x95D4, 0x2404,
+      0x19F4, 0x5FE4, 0x6214, 0x541C, 0x69EC, 0x2FFC, 0x120C, 0xA3DC, 0x9E2C,
+      0xD83C, 0xE5CC, 0x30AE, 0x0D5E, 0x4B4E, 0x76BE, 0xC76E, 0xFA9E, 0xBC8E,
+      0x817E, 0x9D78, 0xA088, 0xE698, 0xDB68, 0x6AB8, 0x5748, 0x1158, 0x2CA8,
+      0xF9CA, 0xC43A, 0x822A, 0xBFDA, 0x0E0A, 0x33FA, 0x75EA, 0x481A, 0x4DE6,
+      0x7016, 0x3606, 0x0BF6, 0xBA26, 0x87D6, 0xC1C6, 0xFC36, 0x2954, 0x14A4,
+      0x52B4, 0x6F44, 0xDE94, 0xE364, 0xA574, 0x9884, 0x8482, 0xB972, 0xFF62,
+      0xC292, 0x7342, 0x4EB2, 0x08A2, 0x3552, 0xE030, 0xDDC0, 0x9BD0, 0xA620,
+      0x17F0, 0x2A00, 0x6C10, 0x51E0 },
+};
+
+uint16_t Io_LTC6813Pec15_CalculateBytewise(
+    const uint8_t *const data_buffer,
+    uint32_t             size)
+{
+    size_t pec15_lut_index;
+
+    // Initialize the value of the PEC15 remainder to 16.
+    uint16_t pec15_remainder = 16U;
+
+    for (size_t i = 0U; i < size; i++)
+    {
+        pec15_lut_index = ((pec15_remainder >> 7) ^ data_buffer[i]) & 0xFF;
+        pec15_remainder = (uint16_t)(
+            (pec15_remainder << 8) ^ bytewise_table[pec15_lut_index]);
+    }
+
+    // Set the LSB of the PEC15 remainder to 0.
+    return (uint16_t)(pec15_remainder << 1);
+}
+
+uint16_t Io_LTC6813Pec15_CalculateSlicingBy4(
+    const uint8_t *const data_buffer,
+    uint32_t             size)
+{
+    // The initial remainder of 16, shifted left by 1 bit
+    uint16_t remainder = PEC15_CRC16_INITIAL_VALUE;
+    uint32_t i         = 0U;
+
+    for (; size - i >= 4U; i += 4U)
+    {
+        remainder = (uint16_t)(
+            slicing_by_4_tables[3][data_buffer[i] ^ (remainder >> 8)] ^
+            slicing_by_4_tables[2][data_buffer[i + 1U] ^ (remainder & 0xFFU)] ^
+            slicing_by_4_tables[1][data_buffer[i + 2U]] ^
+            slicing_by_4_tables[0][data_buffer[i + 3U]]);
+    }
+
+    for (; i < size; i++)
+    {
+        remainder = (uint16_t)(
+            (remainder << 8) ^
+            slicing_by_4_tables[0][data_buffer[i] ^ (remainder >> 8)]);
+    }
+
+    return remainder;
+}
+
+uint16_t Io_LTC6813Pec15_ConvertFromCrc16(uint16_t crc16)
+{
+    // The CRC16 is congruent to the PEC15 remainder multiplied by x, modulo the
+    // PEC15 polynomial. Reduce it to 15 bits, then divide it by x: the PEC15
+    // polynomial has an x^0 term, so adding it first makes the remainder
+    // divisible by x without changing it modulo the polynomial.
+    uint16_t remainder = crc16;
+    if ((remainder & 0x8000U) != 0U)
+    {
+        remainder = (uint16_t)(remainder ^ PEC15_POLYNOMIAL);
+    }
+    if ((remainder & 0x0001U) != 0U)
+    {
+        remainder = (uint16_t)(remainder ^ PEC15_POLYNOMIAL);
+    }
+
+    // The PEC15 is the remainder divided by x and then shifted left by 1 bit,
+    // which is the remainder itself since its LSB is now 0
+    return remainder;
+}
@@ -0,0 +1,122 @@
+#include <assert.h>
+#include <stdint.h>
+
+#ifdef __arm__
+#include "Io_SharedCycleCounter.h"
+#include "Io_LTC6813.h"
+#elif __unix__ || __APPLE__
+#include <time.h>
+#elif _WIN32
+#include <windows.h>
+#else
+#error "Could not determine what CPU this is being compiled for."
+#endif
+
+#include "Io_LTC6813Pec15.h"
+#include "Io_LTC6813Pec15Benchmark.h"
+
+// The number of data bytes in a register group, as checked once per chip for
+// every register group read back from the daisy chain
+#define REGISTER_GROUP_SIZE 6U
+
+// The number of distinct register groups the PEC15s are calculated for
+#define NUM_REGISTER_GROUPS 64U
+
+static uint8_t register_groups[NUM_REGISTER_GROUPS][REGISTER_GROUP_SIZE];
+
+// The last PEC15 calculated, so the calculations can't be optimized out
+static volatile uint16_t pec15;
+
+/**
+ * Enable the cycle counter used to measure the cost of the PEC15s
+ */
+static void Io_EnableCycleCounter(void);
+
+/**
+ * Get the current value of the cycle counter. The counter is free-running and
+ * wraps around, so only the difference between two readings is meaningful.
+ * @return The CPU cycle count on ARM, or a nanosecond timestamp on x86
+ */
+static uint32_t Io_GetCycleCount(void);
+
+/**
+ * Measure the cost of calculating the PEC15 of one register group with the
+ * given function
+ * @param calculate_pec15 The function calculating the PEC15 of a buffer
+ * @param num_register_groups The number of register groups to calculate the
+ *                            PEC15 of
+ * @return The cost of one PEC15, in cycle counter units
+ */
+static float Io_MeasureCostPerPec15(
+    uint16_t (*calculate_pec15)(const uint8_t *, uint32_t),
+    unsigned int num_register_groups);
+
+static void Io_EnableCycleCounter(void)
+{
+#ifdef __arm__
+    Io_SharedCycleCounter_Init();
+#endif
+}
+
+static uint32_t Io_GetCycleCount(void)
+{
+#ifdef __arm__
+    return Io_SharedCycleCounter_GetCycleCount();
+#elif __unix__ || __APPLE__
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)(
+        (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec);
+#elif _WIN32
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (uint32_t)counter.QuadPart;
+#endif
+}
+
+static float Io_MeasureCostPerPec15(
+    uint16_t (*const calculate_pec15)(const uint8_t *, uint32_t),
+    const unsigned int num_register_groups)
+{
+    uint64_t total_cost = 0U;
+
+    for (unsigned int i = 0U; i < num_register_groups; i++)
+    {
+        const uint32_t start = Io_GetCycleCount();
+        pec15                = calculate_pec15(
+            register_groups[i % NUM_REGISTER_GROUPS], REGISTER_GROUP_SIZE);
+        total_cost += Io_GetCycleCount() - start;
+    }
+
+    return (float)total_cost / (float)num_register_groups;
+}
+
+void Io_LTC6813Pec15Benchmark_Run(
+    const unsigned int                         num_register_groups,
+    struct LTC6813Pec15BenchmarkResults *const results)
+{
+    assert(num_register_groups > 0U);
+
+    Io_EnableCycleCounter();
+
+    uint32_t noise = 6813U;
+    for (uint32_t i = 0U; i < NUM_REGISTER_GROUPS; i++)
+    {
+        for (uint32_t j = 0U; j < REGISTER_GROUP_SIZE; j++)
+        {
+            noise                 = noise * 1664525U + 1013904223U;
+            register_groups[i][j] = (uint8_t)(noise >> 24);
+        }
+    }
+
+    results->bytewise = Io_MeasureCostPerPec15(
+        Io_LTC6813Pec15_CalculateBytewise, num_register_groups);
+    results->slicing_by_4 = Io_MeasureCostPerPec15(
+        Io_LTC6813Pec15_CalculateSlicingBy4, num_register_groups);
+#ifdef __arm__
+    results->crc_calculation_unit =
+        Io_MeasureCostPerPec15(Io_LTC6813_CalculatePec15, num_register_groups);
+#else
+    results->crc_calculation_unit = 0.0f;
+#endif
+}
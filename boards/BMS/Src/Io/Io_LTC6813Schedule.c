@@ -0,0 +1,81 @@
+#include <assert.h>
+#include "Io_LTC6813Schedule.h"
+#include "configs/Io_LTC6813Configs.h"
+
+static_assert(SCANS_PER_DIAGNOSTIC > 0U, "Scans per diagnostic can't be 0");
+
+// A diagnostic takes the slot of the auxiliary voltages, so it must not take
+// longer than them or the scans with a diagnostic would take longer
+static_assert(
+    ADOW_CONVERSION_TIME_MS <= ADAX_CONVERSION_TIME_MS,
+    "ADOW doesn't fit in the ADAX slot");
+static_assert(
+    ADOL_CONVERSION_TIME_MS <= ADAX_CONVERSION_TIME_MS,
+    "ADOL doesn't fit in the ADAX slot");
+
+static const uint32_t conversion_times_ms[NUM_OF_LTC6813_CONVERSIONS] = {
+    [LTC6813_CELL_VOLTAGE_CONVERSION]        = ADCV_CONVERSION_TIME_MS,
+    [LTC6813_AUX_CONVERSION]                 = ADAX_CONVERSION_TIME_MS,
+    [LTC6813_STATUS_CONVERSION]              = ADSTAT_CONVERSION_TIME_MS,
+    [LTC6813_OPEN_WIRE_PULL_UP_CONVERSION]   = ADOW_CONVERSION_TIME_MS,
+    [LTC6813_OPEN_WIRE_PULL_DOWN_CONVERSION] = ADOW_CONVERSION_TIME_MS,
+    [LTC6813_ADC_OVERLAP_CONVERSION]         = ADOL_CONVERSION_TIME_MS,
+};
+
+// The conversion of every diagnostic
+static const enum LTC6813Conversion
+    diagnostic_conversions[NUM_OF_CELL_DIAGNOSTICS] = {
+        [CELL_DIAGNOSTIC_OPEN_WIRE_PULL_UP] =
+            LTC6813_OPEN_WIRE_PULL_UP_CONVERSION,
+        [CELL_DIAGNOSTIC_OPEN_WIRE_PULL_DOWN] =
+            LTC6813_OPEN_WIRE_PULL_DOWN_CONVERSION,
+        [CELL_DIAGNOSTIC_ADC_OVERLAP] = LTC6813_ADC_OVERLAP_CONVERSION,
+    };
+
+enum LTC6813Conversion Io_LTC6813Schedule_GetNextConversion(
+    const bool                   is_converting,
+    const enum LTC6813Conversion completed_conversion,
+    const uint32_t               num_scans,
+    const enum CellDiagnostic    diagnostic)
+{
+    if (!is_converting)
+    {
+        return LTC6813_CELL_VOLTAGE_CONVERSION;
+    }
+
+    switch (completed_conversion)
+    {
+        case LTC6813_CELL_VOLTAGE_CONVERSION:
+        {
+            if (num_scans % SCANS_PER_DIAGNOSTIC == 0U)
+            {
+                return diagnostic_conversions[diagnostic];
+            }
+            return LTC6813_AUX_CONVERSION;
+        }
+        case LTC6813_STATUS_CONVERSION:
+        {
+            return LTC6813_CELL_VOLTAGE_CONVERSION;
+        }
+        default:
+        {
+            return LTC6813_STATUS_CONVERSION;
+        }
+    }
+}
+
+enum LTC6813Conversion Io_LTC6813Schedule_GetDiagnosticConversion(
+    const enum CellDiagnostic diagnostic)
+{
+    assert(diagnostic < NUM_OF_CELL_DIAGNOSTICS);
+
+    return diagnostic_conversions[diagnostic];
+}
+
+uint32_t Io_LTC6813Schedule_GetConversionTimeMs(
+    const enum LTC6813Conversion conversion)
+{
+    assert(conversion < NUM_OF_LTC6813_CONVERSIONS);
+
+    return conversion_times_ms[conversion];
+}
@@ -0,0 +1,45 @@
+#include <FreeRTOS.h>
+#include <task.h>
+#include "main.h"
+#include "Io_Adc.h"
+#include "Io_CurrentSense.h"
+#include "Io_MainCurrent.h"
+
+// The main current is sampled once per ADC2 conversion sequence, which is
+// triggered by TIM3
+#define SAMPLE_PERIOD_S (1.0f / (float)ADC1_ADC2_FREQUENCY)
+
+// The charge integrated from the ADC2 conversion complete interrupt
+static float charge_c;
+
+// The main current of the latest ADC2 conversion sequence
+static volatile float latest_main_current;
+
+void Io_MainCurrent_IntegrateCurrent(void)
+{
+    float main_current;
+    if (Io_CurrentSense_ConvertToMainCurrent(
+            Io_Adc_GetAdc2Channel1Voltage(), Io_Adc_GetAdc2Channel3Voltage(),
+            &main_current) == EXIT_CODE_OK)
+    {
+        charge_c += main_current * SAMPLE_PERIOD_S;
+        latest_main_current = main_current;
+    }
+}
+
+float Io_MainCurrent_GetAndClearCharge(void)
+{
+    // Mask the ADC2 interrupt while swapping out the charge, so no sample is
+    // counted twice or lost
+    taskENTER_CRITICAL();
+    const float charge = charge_c;
+    charge_c           = 0.0f;
+    taskEXIT_CRITICAL();
+
+    return charge;
+}
+
+float Io_MainCurrent_GetMainCurrent(void)
+{
+    return latest_main_current;
+}
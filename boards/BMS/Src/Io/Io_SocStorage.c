@@ -0,0 +1,290 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stm32f3xx_hal.h>
+#include "Io_SocStorage.h"
+
+// Each record is a word followed by its complement, so an erased or partially
+// programmed record is never mistaken for a valid one
+struct SocRecord
+{
+    uint32_t bits;
+    uint32_t inverted_bits;
+};
+
+// The two flash pages reserved for the SoC by the linker script. The first
+// record of each page holds the page's generation, and the SoCs are appended
+// after it. The SoCs are written to the page with the latest generation, and
+// the latest SoC is moved into the other page at power on once the page is
+// too full for another power cycle.
+extern const struct SocRecord _soc_storage_start[];
+extern const struct SocRecord _soc_storage_end[];
+
+#define ERASED_WORD 0xFFFFFFFFU
+#define NUM_OF_RECORDS_PER_PAGE (FLASH_PAGE_SIZE / sizeof(struct SocRecord))
+#define GENERATION_RECORD 0U
+#define FIRST_SOC_RECORD 1U
+
+// The SoCs that can be written in a power cycle, which is a full charge or a
+// full discharge with a SoC written every 1% of SoC. Fewer SoCs are reserved
+// than fit in a page, so the page isn't moved on every power on.
+#define MAX_RECORDS_PER_POWER_CYCLE 100U
+
+// The active page, and the index of the next record to write in it
+static const struct SocRecord *active_page;
+static size_t                  next_record;
+
+/**
+ * Get the given flash page reserved for the SoC
+ * @param page The index of the page, which is 0 or 1
+ * @return The first record of the given page
+ */
+static const struct SocRecord *Io_GetPage(size_t page)
+{
+    return &_soc_storage_start[page * NUM_OF_RECORDS_PER_PAGE];
+}
+
+/**
+ * Check if the given record is erased
+ * @param record The record to check
+ * @return true if the given record is erased, false otherwise
+ */
+static bool Io_IsRecordErased(const struct SocRecord *const record)
+{
+    return record->bits == ERASED_WORD && record->inverted_bits == ERASED_WORD;
+}
+
+/**
+ * Check if the given record was fully programmed
+ * @param record The record to check
+ * @return true if the given record was fully programmed, false otherwise
+ */
+static bool Io_IsRecordValid(const struct SocRecord *const record)
+{
+    return record->bits == ~record->inverted_bits;
+}
+
+/**
+ * Check if every record in the given page is erased
+ * @param page The first record of the page to check
+ * @return true if the given page is erased, false otherwise
+ */
+static bool Io_IsPageErased(const struct SocRecord *const page)
+{
+    for (size_t record = 0U; record < NUM_OF_RECORDS_PER_PAGE; record++)
+    {
+        if (!Io_IsRecordErased(&page[record]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Find the first SoC record in the given page that has not been written, since
+ * SoCs are written in order after the generation record
+ * @param page The first record of the page to search
+ * @return The index of the first SoC record that has not been written
+ */
+static size_t Io_FindNextRecord(const struct SocRecord *const page)
+{
+    size_t record = FIRST_SOC_RECORD;
+    while (record < NUM_OF_RECORDS_PER_PAGE &&
+           !Io_IsRecordErased(&page[record]))
+    {
+        record++;
+    }
+
+    return record;
+}
+
+/**
+ * Find the latest valid SoC in the given page, falling back to older SoCs if
+ * the latest record is corrupt, which happens if the power was lost while it
+ * was being programmed
+ * @param page The first record of the page to search
+ * @param end_record The index after the last SoC record written to the page
+ * @param soc_bits This will be set to the bits of the latest valid SoC
+ * @return true if a valid SoC was found, false otherwise
+ */
+static bool Io_FindLatestSocBits(
+    const struct SocRecord *const page,
+    size_t                        end_record,
+    uint32_t *const               soc_bits)
+{
+    for (size_t record = end_record; record > FIRST_SOC_RECORD; record--)
+    {
+        if (Io_IsRecordValid(&page[record - 1U]))
+        {
+            *soc_bits = page[record - 1U].bits;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Erase the given page
+ * @note The flash must be unlocked
+ * @param page The first record of the page to erase
+ * @return true if the page was erased, false otherwise
+ */
+static bool Io_ErasePage(const struct SocRecord *const page)
+{
+    FLASH_EraseInitTypeDef erase_init = {
+        .TypeErase   = FLASH_TYPEERASE_PAGES,
+        .PageAddress = (uint32_t)page,
+        .NbPages     = 1U,
+    };
+    uint32_t page_error;
+
+    return HAL_FLASHEx_Erase(&erase_init, &page_error) == HAL_OK;
+}
+
+/**
+ * Program the given bits into the given erased record
+ * @note The flash must be unlocked
+ * @param record The record to program
+ * @param bits The bits to program
+ * @return true if the record was programmed, false otherwise
+ */
+static bool
+    Io_ProgramRecord(const struct SocRecord *const record, uint32_t bits)
+{
+    const uint32_t address = (uint32_t)record;
+
+    return HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address, bits) == HAL_OK &&
+           HAL_FLASH_Program(
+               FLASH_TYPEPROGRAM_WORD, address + sizeof(uint32_t), ~bits) ==
+               HAL_OK;
+}
+
+/**
+ * Start a new generation in the given erased page, with the latest SoC of the
+ * active page as its first SoC. The generation is programmed last, so the page
+ * is only used once the SoC has been moved into it.
+ * @note The flash must be unlocked
+ * @param page The first record of the erased page
+ * @param generation The generation of the page
+ * @return true if the page was started, false otherwise
+ */
+static bool
+    Io_StartPage(const struct SocRecord *const page, uint32_t generation)
+{
+    uint32_t soc_bits;
+    size_t   end_record = FIRST_SOC_RECORD;
+    if (active_page != NULL &&
+        Io_FindLatestSocBits(active_page, next_record, &soc_bits))
+    {
+        if (!Io_ProgramRecord(&page[FIRST_SOC_RECORD], soc_bits))
+        {
+            return false;
+        }
+        end_record++;
+    }
+
+    if (!Io_ProgramRecord(&page[GENERATION_RECORD], generation))
+    {
+        return false;
+    }
+
+    active_page = page;
+    next_record = end_record;
+    return true;
+}
+
+void Io_SocStorage_Init(void)
+{
+    const struct SocRecord *const pages[2] = { Io_GetPage(0U), Io_GetPage(1U) };
+    const bool                    is_started[2] = {
+        Io_IsRecordValid(&pages[0][GENERATION_RECORD]),
+        Io_IsRecordValid(&pages[1][GENERATION_RECORD]),
+    };
+
+    // A page that was not started is blank, was being erased, or was being
+    // started when the power was lost, so the other page is still the latest
+    size_t active = is_started[1] ? 1U : 0U;
+    if (is_started[0] && is_started[1])
+    {
+        const uint32_t generation_difference =
+            pages[1][GENERATION_RECORD].bits - pages[0][GENERATION_RECORD].bits;
+        active = (int32_t)generation_difference > 0 ? 1U : 0U;
+    }
+    const size_t inactive = 1U - active;
+
+    active_page = NULL;
+    next_record = NUM_OF_RECORDS_PER_PAGE;
+    if (is_started[active])
+    {
+        active_page = pages[active];
+        next_record = Io_FindNextRecord(active_page);
+    }
+
+    HAL_FLASH_Unlock();
+
+    if (!Io_IsPageErased(pages[inactive]))
+    {
+        Io_ErasePage(pages[inactive]);
+    }
+
+    // Move the latest SoC into the erased page before erasing the active page,
+    // so the SoC isn't lost if the power is lost while the page is erased
+    if (NUM_OF_RECORDS_PER_PAGE - next_record < MAX_RECORDS_PER_POWER_CYCLE &&
+        Io_IsPageErased(pages[inactive]))
+    {
+        const uint32_t generation =
+            active_page == NULL ? 0U : active_page[GENERATION_RECORD].bits + 1U;
+        if (Io_StartPage(pages[inactive], generation))
+        {
+            // The page is erased again on the next power on if this fails
+            if (!Io_IsPageErased(pages[active]))
+            {
+                Io_ErasePage(pages[active]);
+            }
+        }
+    }
+
+    HAL_FLASH_Lock();
+}
+
+ExitCode Io_SocStorage_ReadSoc(float *const soc)
+{
+    uint32_t soc_bits;
+    if (active_page == NULL ||
+        !Io_FindLatestSocBits(active_page, next_record, &soc_bits))
+    {
+        return EXIT_CODE_ERROR;
+    }
+
+    memcpy(soc, &soc_bits, sizeof(*soc));
+    return EXIT_CODE_OK;
+}
+
+ExitCode Io_SocStorage_WriteSoc(float soc)
+{
+    // Pages are only erased at power on, where the stall doesn't starve any
+    // task, so the SoC isn't persisted again in this power cycle once the
+    // active page is full
+    if (active_page == NULL || next_record >= NUM_OF_RECORDS_PER_PAGE)
+    {
+        return EXIT_CODE_ERROR;
+    }
+
+    uint32_t soc_bits;
+    memcpy(&soc_bits, &soc, sizeof(soc_bits));
+
+    // Skip past the record even if programming it fails, since a partially
+    // programmed record can't be programmed again until the page is erased
+    const struct SocRecord *const record = &active_page[next_record];
+    next_record++;
+
+    HAL_FLASH_Unlock();
+    const bool is_programmed = Io_ProgramRecord(record, soc_bits);
+    HAL_FLASH_Lock();
+
+    return is_programmed ? EXIT_CODE_OK : EXIT_CODE_ERROR;
+}
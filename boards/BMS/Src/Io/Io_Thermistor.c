@@ -0,0 +1,83 @@
+#include "Io_Thermistor.h"
+
+// The thermistor voltages at 125°C and -40°C, in 100µV
+#define MIN_THERMISTOR_VOLTAGE 977U
+#define MAX_THERMISTOR_VOLTAGE 29129U
+
+// Each entry of the temperature table is the temperature at a multiple of 128
+// thermistor voltage codes, starting from the bucket holding the minimum
+// thermistor voltage
+#define THERMISTOR_VOLTAGE_BUCKET_SHIFT 7U
+#define THERMISTOR_VOLTAGE_BUCKET_SIZE (1U << THERMISTOR_VOLTAGE_BUCKET_SHIFT)
+#define FIRST_THERMISTOR_VOLTAGE_BUCKET \
+    (MIN_THERMISTOR_VOLTAGE >> THERMISTOR_VOLTAGE_BUCKET_SHIFT)
+#define SIZE_OF_TEMPERATURE_TABLE                                  \
+    ((MAX_THERMISTOR_VOLTAGE >> THERMISTOR_VOLTAGE_BUCKET_SHIFT) - \
+     FIRST_THERMISTOR_VOLTAGE_BUCKET + 2U)
+
+// The temperatures (0.01°C) of a Vishay NTCALUG03A103G thermistor at every
+// 128th thermistor voltage code, from Vishay's R/T characteristic for the
+// thermistor over its -40°C to 125°C operating range
+//
+//   R(T) = R25 * exp(A + B / T + C / T^2 + D / T^3)
+//
+// R25 = 10kΩ, A = -14.6567, B = 4798.43, C = -115219, D = -3741190
+//
+// whose coefficients reproduce Vishay's resistance table for the thermistor to
+// within 0.004%. Interpolating between the entries adds at most 0.09°C of
+// error.
+static const int16_t temperature_table[SIZE_OF_TEMPERATURE_TABLE] = {
+    12845, 12316, 11858, 11455, 11095, 10770, 10474, 10203, 9952,  9719,  9502,
+    9298,  9106,  8925,  8754,  8591,  8436,  8288,  8146,  8010,  7880,  7754,
+    7633,  7516,  7404,  7295,  7189,  7086,  6987,  6890,  6796,  6705,  6616,
+    6529,  6444,  6361,  6280,  6201,  6123,  6047,  5973,  5900,  5828,  5758,
+    5689,  5622,  5555,  5490,  5425,  5362,  5300,  5238,  5178,  5118,  5059,
+    5001,  4944,  4888,  4832,  4777,  4723,  4669,  4616,  4563,  4511,  4460,
+    4409,  4359,  4309,  4260,  4211,  4163,  4115,  4067,  4020,  3973,  3927,
+    3881,  3835,  3790,  3745,  3701,  3656,  3612,  3569,  3525,  3482,  3439,
+    3397,  3354,  3312,  3270,  3229,  3187,  3146,  3105,  3064,  3023,  2983,
+    2942,  2902,  2862,  2822,  2782,  2743,  2703,  2664,  2625,  2585,  2546,
+    2507,  2468,  2430,  2391,  2352,  2314,  2275,  2237,  2198,  2160,  2122,
+    2083,  2045,  2007,  1968,  1930,  1892,  1854,  1815,  1777,  1739,  1701,
+    1662,  1624,  1585,  1547,  1508,  1470,  1431,  1392,  1354,  1315,  1276,
+    1237,  1197,  1158,  1118,  1079,  1039,  999,   959,   919,   879,   838,
+    797,   756,   715,   674,   632,   590,   548,   506,   463,   420,   377,
+    333,   289,   245,   200,   155,   110,   64,    18,    -29,   -76,   -123,
+    -171,  -220,  -269,  -319,  -369,  -420,  -472,  -524,  -578,  -632,  -686,
+    -742,  -798,  -856,  -914,  -974,  -1034, -1096, -1159, -1223, -1289, -1356,
+    -1425, -1496, -1568, -1643, -1719, -1798, -1880, -1964, -2051, -2141, -2235,
+    -2332, -2434, -2541, -2653, -2771, -2896, -3030, -3172, -3325, -3491, -3673,
+    -3875, -4102
+};
+
+ExitCode Io_Thermistor_GetTemperature(
+    uint16_t       raw_thermistor_voltage,
+    int32_t *const temperature)
+{
+    if ((raw_thermistor_voltage < MIN_THERMISTOR_VOLTAGE) ||
+        (raw_thermistor_voltage > MAX_THERMISTOR_VOLTAGE))
+    {
+        return EXIT_CODE_OUT_OF_RANGE;
+    }
+
+    const uint32_t index =
+        (raw_thermistor_voltage >> THERMISTOR_VOLTAGE_BUCKET_SHIFT) -
+        FIRST_THERMISTOR_VOLTAGE_BUCKET;
+    const int32_t fraction = (int32_t)(
+        raw_thermistor_voltage & (THERMISTOR_VOLTAGE_BUCKET_SIZE - 1U));
+    const int32_t lower_temperature = temperature_table[index];
+    const int32_t upper_temperature = temperature_table[index + 1U];
+
+    // The interpolated temperature, in 0.01°C / THERMISTOR_VOLTAGE_BUCKET_SIZE
+    const int32_t interpolated_temperature =
+        lower_temperature * (int32_t)THERMISTOR_VOLTAGE_BUCKET_SIZE +
+        (upper_temperature - lower_temperature) * fraction;
+
+    // Round to the nearest 0.1°C
+    const int32_t divisor = 10 * (int32_t)THERMISTOR_VOLTAGE_BUCKET_SIZE;
+    const int32_t rounding =
+        interpolated_temperature >= 0 ? divisor / 2 : -divisor / 2;
+    *temperature = (interpolated_temperature + rounding) / divisor;
+
+    return EXIT_CODE_OK;
+}
@@ -0,0 +1,51 @@
+#include <stdint.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "Io_Adc.h"
+#include "Io_TractiveSystemVoltage.h"
+#include "Io_VoltageSense.h"
+
+// The number of tractive system voltages kept between reads, which is 64ms of
+// samples at ADC1_ADC2_FREQUENCY. It must be a power of 2.
+#define NUM_OF_TRACTIVE_SYSTEM_VOLTAGE_SAMPLES 64U
+
+// The tractive system voltages sampled from the ADC1 conversion complete
+// interrupt. The indices only ever increase, and wrap around the buffer.
+static float    voltages_v[NUM_OF_TRACTIVE_SYSTEM_VOLTAGE_SAMPLES];
+static uint32_t write_index;
+static uint32_t read_index;
+
+void Io_TractiveSystemVoltage_SampleVoltage(void)
+{
+    voltages_v[write_index % NUM_OF_TRACTIVE_SYSTEM_VOLTAGE_SAMPLES] =
+        Io_VoltageSense_GetTractiveSystemVoltage(
+            Io_Adc_GetAdc1Channel3Voltage());
+    write_index++;
+}
+
+size_t Io_TractiveSystemVoltage_ReadVoltages(
+    float *const voltages,
+    size_t       max_num_voltages)
+{
+    // Mask the ADC1 interrupt while copying the voltages out, so none is
+    // overwritten halfway through
+    taskENTER_CRITICAL();
+
+    // Skip the voltages that were overwritten before they were read
+    if (write_index - read_index > NUM_OF_TRACTIVE_SYSTEM_VOLTAGE_SAMPLES)
+    {
+        read_index = write_index - NUM_OF_TRACTIVE_SYSTEM_VOLTAGE_SAMPLES;
+    }
+
+    size_t num_voltages = 0U;
+    while (num_voltages < max_num_voltages && read_index != write_index)
+    {
+        voltages[num_voltages] =
+            voltages_v[read_index % NUM_OF_TRACTIVE_SYSTEM_VOLTAGE_SAMPLES];
+        read_index++;
+        num_voltages++;
+    }
+    taskEXIT_CRITICAL();
+
+    return num_voltages;
+}
@@ -30,6 +30,7 @@
 #include "Io_CanRx.h"
 #include "Io_SharedSoftwareWatchdog.h"
 #include "Io_SharedCan.h"
+#include "Io_SharedCycleCounter.h"
 #include "Io_SharedErrorTable.h"
 #include "Io_SharedHardFaultHandler.h"
 #include "Io_StackWaterMark.h"
@@ -40,11 +41,17 @@
 #include "Io_Charger.h"
 #include "Io_OkStatuses.h"
 #include "Io_LTC6813.h"
+#include "Io_LTC6813Engine.h"
 #include "Io_CellVoltages.h"
+#include "Io_CellTemperatures.h"
 #include "Io_DieTemperatures.h"
 #include "Io_Airs.h"
 #include "Io_PreCharge.h"
+#include "Io_TractiveSystemVoltage.h"
 #include "Io_Adc.h"
+#include "Io_MainCurrent.h"
+#include "Io_SocStorage.h"
+#include "Io_CellDiagnostics.h"
 
 #include "App_BmsWorld.h"
 #include "App_AccumulatorVoltages.h"
@@ -54,6 +61,8 @@
 #include "configs/App_ImdConfig.h"
 #include "configs/App_AccumulatorThresholds.h"
 #include "configs/App_CellMonitorsThresholds.h"
+#include "configs/App_CellBalancingConfigs.h"
+#include "configs/App_CellDiagnosticsConfigs.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -82,6 +91,8 @@ CAN_HandleTypeDef hcan;
 IWDG_HandleTypeDef hiwdg;
 
 SPI_HandleTypeDef hspi2;
+DMA_HandleTypeDef hdma_spi2_rx;
+DMA_HandleTypeDef hdma_spi2_tx;
 
 TIM_HandleTypeDef htim2;
 TIM_HandleTypeDef htim3;
@@ -115,6 +126,10 @@ struct OkStatus *         imd_ok;
 struct OkStatus *         bspd_ok;
 struct Accumulator *      accumulator;
 struct CellMonitors *     cell_monitors;
+struct CellBalancing *    cell_balancing;
+struct SocEstimator *     soc_estimator;
+struct CellDiagnostics *  cell_diagnostics;
+struct AvailablePower *   available_power;
 struct Airs *             airs;
 struct PreChargeSequence *pre_charge_sequence;
 struct ErrorTable *       error_table;
@@ -142,6 +157,7 @@ void        RunTask100Hz(void const *argument);
 
 static void CanRxQueueOverflowCallBack(size_t overflow_count);
 static void CanTxQueueOverflowCallBack(size_t overflow_count);
+static void LTC6813ScanCompleteCallback(const struct LTC6813Scan *scan);
 
 /* USER CODE END PFP */
 
@@ -158,6 +174,14 @@ static void CanTxQueueOverflowCallBack(size_t overflow_count)
     App_CanTx_SetPeriodicSignal_TX_OVERFLOW_COUNT(can_tx, overflow_count);
 }
 
+static void LTC6813ScanCompleteCallback(const struct LTC6813Scan *scan)
+{
+    Io_CellVoltages_UpdateFromScan(scan);
+    Io_CellTemperatures_UpdateFromScan(scan);
+    Io_DieTemperatures_UpdateFromScan(scan);
+    Io_CellDiagnostics_UpdateFromScan(scan);
+}
+
 /* USER CODE END 0 */
 
 /**
@@ -201,12 +225,7 @@ int main(void)
     /* USER CODE BEGIN 2 */
     __HAL_DBGMCU_FREEZE_IWDG();
 
-    HAL_ADC_Start_DMA(
-        &hadc1, (uint32_t *)Io_Adc_GetRawAdc1Values(),
-        hadc1.Init.NbrOfConversion);
-    HAL_ADC_Start_DMA(
-        &hadc2, (uint32_t *)Io_Adc_GetRawAdc2Values(),
-        hadc2.Init.NbrOfConversion);
+    Io_Adc_Init(&hadc1, &hadc2);
     HAL_TIM_Base_Start(&htim3);
 
     Io_SharedHardFaultHandler_Init();
@@ -246,40 +265,60 @@ int main(void)
         Io_OkStatuses_IsBspdOkEnabled);
 
     Io_LTC6813_Init(&hspi2, SPI2_NSS_GPIO_Port, SPI2_NSS_Pin);
-    App_AccumulatorVoltages_Init(Io_CellVoltages_GetRawCellVoltages);
+    Io_LTC6813Engine_Init(
+        LTC6813ScanCompleteCallback, Io_MainCurrent_GetMainCurrent);
+    App_AccumulatorVoltages_Init(
+        Io_CellVoltages_ReadRawCellVoltages,
+        Io_CellVoltages_GetRawCellVoltages);
     accumulator = App_Accumulator_Create(
-        Io_LTC6813_ConfigureRegisterA, Io_CellVoltages_ReadRawCellVoltages,
+        Io_LTC6813Engine_ConfigureCellMonitors,
+        App_AccumulatorVoltages_ReadCellVoltages,
         App_AccumulatorVoltages_GetMinCellVoltage,
         App_AccumulatorVoltages_GetMaxCellVoltage,
         App_AccumulatorVoltages_GetAverageCellVoltage,
         App_AccumulatorVoltages_GetPackVoltage,
-        App_AccumulatorVoltages_GetSegment0Voltage,
-        App_AccumulatorVoltages_GetSegment1Voltage,
-        App_AccumulatorVoltages_GetSegment2Voltage,
-        App_AccumulatorVoltages_GetSegment3Voltage,
-        App_AccumulatorVoltages_GetSegment4Voltage,
-        App_AccumulatorVoltages_GetSegment5Voltage, MIN_CELL_VOLTAGE,
+        App_AccumulatorVoltages_GetSegmentVoltage, MIN_CELL_VOLTAGE,
         MAX_CELL_VOLTAGE, MIN_SEGMENT_VOLTAGE, MAX_SEGMENT_VOLTAGE,
         MIN_PACK_VOLTAGE, MAX_PACK_VOLTAGE);
 
     cell_monitors = App_CellMonitors_Create(
-        Io_DieTemperatures_ReadTemp, Io_DieTemperatures_GetSegment0DieTemp,
-        Io_DieTemperatures_GetSegment1DieTemp,
-        Io_DieTemperatures_GetSegment2DieTemp,
-        Io_DieTemperatures_GetSegment3DieTemp,
-        Io_DieTemperatures_GetSegment4DieTemp,
-        Io_DieTemperatures_GetSegment5DieTemp, Io_DieTemperatures_GetMaxDieTemp,
-        MIN_ITMP_DEGC, MAX_ITMP_DEGC, DIE_TEMP_TO_REENABLE_CHARGER_DEGC,
+        Io_DieTemperatures_ReadTemp, Io_DieTemperatures_GetDieTemp,
+        Io_DieTemperatures_GetMaxDieTemp, MIN_ITMP_DEGC, MAX_ITMP_DEGC,
+        DIE_TEMP_TO_REENABLE_CHARGER_DEGC,
         DIE_TEMP_TO_REENABLE_CELL_BALANCING_DEGC,
         DIE_TEMP_TO_DISABLE_CELL_BALANCING_DEGC,
         DIE_TEMP_TO_DISABLE_CHARGER_DEGC);
 
+    cell_balancing = App_CellBalancing_Create(
+        Io_LTC6813Engine_WriteDischargeCells,
+        App_AccumulatorVoltages_GetStatistics, Io_DieTemperatures_GetMaxDieTemp,
+        BALANCING_THRESHOLD_100UV, DIE_TEMP_TO_THROTTLE_CELL_BALANCING_DEGC,
+        DIE_TEMP_TO_REENABLE_CELL_BALANCING_DEGC,
+        DIE_TEMP_TO_DISABLE_CELL_BALANCING_DEGC);
+
+    Io_SocStorage_Init();
+    soc_estimator = App_SocEstimator_Create(
+        Io_MainCurrent_GetAndClearCharge, App_AccumulatorVoltages_GetStatistics,
+        Io_SocStorage_ReadSoc, Io_SocStorage_WriteSoc);
+
+    cell_diagnostics = App_CellDiagnostics_Create(
+        Io_CellDiagnostics_ReadDiagnostic, OPEN_WIRE_THRESHOLD_100UV,
+        ADC_OVERLAP_THRESHOLD_100UV, NUM_OF_CONSECUTIVE_DIAGNOSTIC_RESULTS);
+
+    available_power = App_AvailablePower_Create(
+        App_AccumulatorVoltages_GetStatistics, Io_CellVoltages_GetMainCurrent,
+        Io_CellTemperatures_ReadTemperatures,
+        Io_CellTemperatures_GetMinCellTemperature,
+        Io_CellTemperatures_GetMaxCellTemperature);
+
     airs = App_Airs_Create(
         Io_Airs_IsAirPositiveClosed, Io_Airs_IsAirNegativeClosed,
         Io_Airs_CloseAirPositive, Io_Airs_OpenAirPositive);
 
-    pre_charge_sequence =
-        App_PreChargeSequence_Create(Io_PreCharge_Enable, Io_PreCharge_Disable);
+    pre_charge_sequence = App_PreChargeSequence_Create(
+        Io_PreCharge_Enable, Io_PreCharge_Disable,
+        Io_TractiveSystemVoltage_ReadVoltages,
+        App_AccumulatorVoltages_GetPackVoltage, (float)ADC1_ADC2_FREQUENCY);
 
     error_table = App_SharedErrorTable_Create();
 
@@ -287,13 +326,17 @@ int main(void)
 
     world = App_BmsWorld_Create(
         can_tx, can_rx, imd, heartbeat_monitor, rgb_led_sequence, charger,
-        bms_ok, imd_ok, bspd_ok, accumulator, cell_monitors, airs,
+        bms_ok, imd_ok, bspd_ok, accumulator, cell_monitors, cell_balancing,
+        soc_estimator, cell_diagnostics, available_power, airs,
         pre_charge_sequence, error_table, clock);
 
     Io_StackWaterMark_Init(can_tx);
     Io_SoftwareWatchdog_Init(can_tx);
 
     state_machine = App_SharedStateMachine_Create(world, App_GetInitState());
+    Io_SharedCycleCounter_Init();
+    App_SharedStateMachine_SetCycleCounter(
+        state_machine, Io_SharedCycleCounter_GetCycleCount);
 
     struct CanMsgs_bms_startup_t payload = { .dummy = 0 };
     App_CanTx_SendNonPeriodicMsg_BMS_STARTUP(can_tx, &payload);
@@ -771,6 +814,12 @@ static void MX_DMA_Init(void)
     /* DMA1_Channel1_IRQn interrupt configuration */
     HAL_NVIC_SetPriority(DMA1_Channel1_IRQn, 5, 0);
     HAL_NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+    /* DMA1_Channel4_IRQn interrupt configuration */
+    HAL_NVIC_SetPriority(DMA1_Channel4_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Channel4_IRQn);
+    /* DMA1_Channel5_IRQn interrupt configuration */
+    HAL_NVIC_SetPriority(DMA1_Channel5_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Channel5_IRQn);
     /* DMA2_Channel1_IRQn interrupt configuration */
     HAL_NVIC_SetPriority(DMA2_Channel1_IRQn, 5, 0);
     HAL_NVIC_EnableIRQ(DMA2_Channel1_IRQn);
@@ -928,6 +977,7 @@ void RunTask1kHz(void const *argument)
 
         App_SharedClock_SetCurrentTimeInMilliseconds(clock, current_time_ms);
         Io_CanTx_EnqueuePeriodicMsgs(can_tx, current_time_ms);
+        Io_LTC6813Engine_Tick1kHz(current_time_ms);
 
         // Watchdog check-in must be the last function called before putting the
         // task to sleep.
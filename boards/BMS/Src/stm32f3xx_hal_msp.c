@@ -28,6 +28,10 @@ extern DMA_HandleTypeDef hdma_adc1;
 
 extern DMA_HandleTypeDef hdma_adc2;
 
+extern DMA_HandleTypeDef hdma_spi2_rx;
+
+extern DMA_HandleTypeDef hdma_spi2_tx;
+
 /* Private typedef -----------------------------------------------------------*/
 /* USER CODE BEGIN TD */
 
@@ -346,6 +350,42 @@ void HAL_SPI_MspInit(SPI_HandleTypeDef *hspi)
         GPIO_InitStruct.Alternate = GPIO_AF5_SPI2;
         HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
 
+        /* SPI2 DMA Init */
+        /* SPI2_RX Init */
+        hdma_spi2_rx.Instance                 = DMA1_Channel4;
+        hdma_spi2_rx.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+        hdma_spi2_rx.Init.PeriphInc           = DMA_PINC_DISABLE;
+        hdma_spi2_rx.Init.MemInc              = DMA_MINC_ENABLE;
+        hdma_spi2_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+        hdma_spi2_rx.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+        hdma_spi2_rx.Init.Mode                = DMA_NORMAL;
+        hdma_spi2_rx.Init.Priority            = DMA_PRIORITY_MEDIUM;
+        if (HAL_DMA_Init(&hdma_spi2_rx) != HAL_OK)
+        {
+            Error_Handler();
+        }
+
+        __HAL_LINKDMA(hspi, hdmarx, hdma_spi2_rx);
+
+        /* SPI2_TX Init */
+        hdma_spi2_tx.Instance                 = DMA1_Channel5;
+        hdma_spi2_tx.Init.Direction           = DMA_MEMORY_TO_PERIPH;
+        hdma_spi2_tx.Init.PeriphInc           = DMA_PINC_DISABLE;
+        hdma_spi2_tx.Init.MemInc              = DMA_MINC_ENABLE;
+        hdma_spi2_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+        hdma_spi2_tx.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+        hdma_spi2_tx.Init.Mode                = DMA_NORMAL;
+        hdma_spi2_tx.Init.Priority            = DMA_PRIORITY_MEDIUM;
+        if (HAL_DMA_Init(&hdma_spi2_tx) != HAL_OK)
+        {
+            Error_Handler();
+        }
+
+        __HAL_LINKDMA(hspi, hdmatx, hdma_spi2_tx);
+
+        /* SPI2 interrupt Init */
+        HAL_NVIC_SetPriority(SPI2_IRQn, 5, 0);
+        HAL_NVIC_EnableIRQ(SPI2_IRQn);
         /* USER CODE BEGIN SPI2_MspInit 1 */
 
         /* USER CODE END SPI2_MspInit 1 */
@@ -375,6 +415,12 @@ void HAL_SPI_MspDeInit(SPI_HandleTypeDef *hspi)
         */
         HAL_GPIO_DeInit(GPIOB, GPIO_PIN_13 | GPIO_PIN_14 | GPIO_PIN_15);
 
+        /* SPI2 DMA DeInit */
+        HAL_DMA_DeInit(hspi->hdmarx);
+        HAL_DMA_DeInit(hspi->hdmatx);
+
+        /* SPI2 interrupt DeInit */
+        HAL_NVIC_DisableIRQ(SPI2_IRQn);
         /* USER CODE BEGIN SPI2_MspDeInit 1 */
 
         /* USER CODE END SPI2_MspDeInit 1 */
@@ -61,7 +61,10 @@
 /* External variables --------------------------------------------------------*/
 extern DMA_HandleTypeDef hdma_adc1;
 extern DMA_HandleTypeDef hdma_adc2;
+extern DMA_HandleTypeDef hdma_spi2_rx;
+extern DMA_HandleTypeDef hdma_spi2_tx;
 extern CAN_HandleTypeDef hcan;
+extern SPI_HandleTypeDef hspi2;
 extern TIM_HandleTypeDef htim2;
 extern TIM_HandleTypeDef htim3;
 extern TIM_HandleTypeDef htim6;
@@ -180,6 +183,34 @@ void DMA1_Channel1_IRQHandler(void)
     /* USER CODE END DMA1_Channel1_IRQn 1 */
 }
 
+/**
+ * @brief This function handles DMA1 channel4 global interrupt.
+ */
+void DMA1_Channel4_IRQHandler(void)
+{
+    /* USER CODE BEGIN DMA1_Channel4_IRQn 0 */
+
+    /* USER CODE END DMA1_Channel4_IRQn 0 */
+    HAL_DMA_IRQHandler(&hdma_spi2_rx);
+    /* USER CODE BEGIN DMA1_Channel4_IRQn 1 */
+
+    /* USER CODE END DMA1_Channel4_IRQn 1 */
+}
+
+/**
+ * @brief This function handles DMA1 channel5 global interrupt.
+ */
+void DMA1_Channel5_IRQHandler(void)
+{
+    /* USER CODE BEGIN DMA1_Channel5_IRQn 0 */
+
+    /* USER CODE END DMA1_Channel5_IRQn 0 */
+    HAL_DMA_IRQHandler(&hdma_spi2_tx);
+    /* USER CODE BEGIN DMA1_Channel5_IRQn 1 */
+
+    /* USER CODE END DMA1_Channel5_IRQn 1 */
+}
+
 /**
  * @brief This function handles USB high priority or CAN_TX interrupts.
  */
@@ -250,6 +281,20 @@ void TIM3_IRQHandler(void)
     /* USER CODE END TIM3_IRQn 1 */
 }
 
+/**
+ * @brief This function handles SPI2 global interrupt.
+ */
+void SPI2_IRQHandler(void)
+{
+    /* USER CODE BEGIN SPI2_IRQn 0 */
+
+    /* USER CODE END SPI2_IRQn 0 */
+    HAL_SPI_IRQHandler(&hspi2);
+    /* USER CODE BEGIN SPI2_IRQn 1 */
+
+    /* USER CODE END SPI2_IRQn 1 */
+}
+
 /**
  * @brief This function handles Timer 6 interrupt and DAC underrun interrupts.
  */
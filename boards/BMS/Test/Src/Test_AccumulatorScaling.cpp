@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <string>
+#include <vector>
+#include "Test_Bms.h"
+
+extern "C"
+{
+#include "App_InRangeCheck.h"
+}
+
+static constexpr float MIN_SEGMENT_VOLTAGE = 48.0f;
+static constexpr float MAX_SEGMENT_VOLTAGE = 67.2f;
+
+static std::vector<float> segment_voltages;
+
+static float GetSegmentVoltage(size_t segment)
+{
+    return segment_voltages[segment];
+}
+
+// Build one in-range check per segment the way the accumulator does, and get
+// the shortest time taken to evaluate every check once
+static long long GetNsPerScan(size_t num_segments)
+{
+    segment_voltages.assign(num_segments, 57.6f);
+    segment_voltages[num_segments - 1] = 70.0f;
+
+    std::vector<struct InRangeCheck *> in_range_checks;
+    for (size_t segment = 0; segment < num_segments; segment++)
+    {
+        in_range_checks.push_back(App_InRangeCheck_CreateForIndex(
+            GetSegmentVoltage, segment, MIN_SEGMENT_VOLTAGE,
+            MAX_SEGMENT_VOLTAGE));
+    }
+
+    constexpr uint32_t num_iterations  = 20000;
+    constexpr int      num_repetitions = 5;
+
+    long long       min_ns        = LLONG_MAX;
+    volatile size_t num_overflows = 0;
+    for (int repetition = 0; repetition < num_repetitions; repetition++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < num_iterations; i++)
+        {
+            for (struct InRangeCheck *in_range_check : in_range_checks)
+            {
+                App_InRangeCheck_Evaluate(in_range_check);
+                if (App_InRangeCheck_GetStatus(in_range_check) ==
+                    VALUE_OVERFLOW)
+                {
+                    num_overflows = num_overflows + 1;
+                }
+            }
+        }
+        min_ns = std::min<long long>(
+            min_ns, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start)
+                        .count());
+    }
+    EXPECT_EQ(num_repetitions * num_iterations, num_overflows);
+
+    for (struct InRangeCheck *in_range_check : in_range_checks)
+    {
+        App_InRangeCheck_Destroy(in_range_check);
+    }
+
+    return min_ns / num_iterations;
+}
+
+TEST(AccumulatorScalingTest, per_scan_cost_scales_linearly_with_segments)
+{
+    const size_t segment_counts[] = { 6, 12, 24, 48 };
+
+    long long ns_per_check[4];
+    for (size_t i = 0; i < 4; i++)
+    {
+        const long long ns_per_scan = GetNsPerScan(segment_counts[i]);
+        ns_per_check[i] =
+            std::max<long long>(1, ns_per_scan / (long long)segment_counts[i]);
+
+        RecordProperty(
+            "ns_per_scan_of_" + std::to_string(segment_counts[i]) + "_segments",
+            (int)ns_per_scan);
+        printf(
+            "In-range checks of %zu segments: %lld ns per scan, %lld ns per "
+            "segment\n",
+            segment_counts[i], ns_per_scan, ns_per_check[i]);
+    }
+
+    // The cost of each check should not grow with the number of segments. The
+    // bound is loose so that a busy host doesn't fail the test.
+    ASSERT_LE(ns_per_check[3], 4 * ns_per_check[0]);
+}
@@ -0,0 +1,420 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include "Test_Bms.h"
+
+extern "C"
+{
+#include "App_AvailablePower.h"
+#include "App_OpenCircuitVoltage.h"
+#include "configs/App_AccumulatorThresholds.h"
+#include "configs/App_SocConfigs.h"
+}
+
+namespace AvailablePowerTest
+{
+FAKE_VALUE_FUNC(const struct CellStatistics *, get_cell_statistics);
+FAKE_VALUE_FUNC(float, get_main_current);
+FAKE_VALUE_FUNC(ExitCode, read_cell_temperatures);
+FAKE_VALUE_FUNC(int32_t, get_min_cell_temperature);
+FAKE_VALUE_FUNC(int32_t, get_max_cell_temperature);
+
+static constexpr size_t NUM_OF_CELLS =
+    NUM_OF_CELL_MONITOR_CHIPS * NUM_OF_CELLS_PER_SEGMENT;
+
+// Every cell group of the accumulator, modelled with a series resistance and
+// one RC pair for the polarization voltage on top of its open circuit voltage
+class AccumulatorPlant
+{
+  public:
+    AccumulatorPlant(float soc, float resistance) : soc(soc)
+    {
+        std::fill(
+            &resistances[0][0], &resistances[0][0] + NUM_OF_CELLS, resistance);
+        std::fill(
+            &polarization_voltages[0][0],
+            &polarization_voltages[0][0] + NUM_OF_CELLS, 0.0f);
+    }
+
+    // Draw the given current (A) for one tick, and get the cell voltages at
+    // the end of it (100µV) with the given standard deviation of noise (V)
+    void Tick(
+        float    current,
+        float    voltage_noise,
+        uint16_t cell_voltages[NUM_OF_CELL_MONITOR_CHIPS]
+                              [NUM_OF_CELLS_PER_SEGMENT])
+    {
+        soc -= current * SOC_TICK_PERIOD_S /
+               (CELL_GROUP_CAPACITY_AH * 3600.0f / 100.0f);
+        const float ocv = App_OpenCircuitVoltage_GetCellVoltage(soc);
+
+        std::normal_distribution<float> noise{ 0.0f, voltage_noise };
+        for (size_t segment = 0U; segment < NUM_OF_CELL_MONITOR_CHIPS;
+             segment++)
+        {
+            for (size_t cell = 0U; cell < NUM_OF_CELLS_PER_SEGMENT; cell++)
+            {
+                const float resistance = resistances[segment][cell];
+                const float decay      = std::exp(
+                    -SOC_TICK_PERIOD_S /
+                    (POLARIZATION_RATIO * resistance *
+                     CELL_GROUP_POLARIZATION_CAPACITANCE_F));
+                float &polarization_voltage =
+                    polarization_voltages[segment][cell];
+                polarization_voltage =
+                    decay * polarization_voltage +
+                    (1.0f - decay) * POLARIZATION_RATIO * resistance * current;
+
+                const float voltage =
+                    ocv - resistance * current - polarization_voltage +
+                    (voltage_noise > 0.0f ? noise(random_engine) : 0.0f);
+                cell_voltages[segment][cell] =
+                    (uint16_t)std::lround(voltage * 1e4f);
+            }
+        }
+    }
+
+    static constexpr float POLARIZATION_RATIO =
+        CELL_GROUP_POLARIZATION_RESISTANCE_OHMS /
+        CELL_GROUP_SERIES_RESISTANCE_OHMS;
+
+    float soc;
+    float resistances[NUM_OF_CELL_MONITOR_CHIPS][NUM_OF_CELLS_PER_SEGMENT];
+    float polarization_voltages[NUM_OF_CELL_MONITOR_CHIPS]
+                               [NUM_OF_CELLS_PER_SEGMENT];
+    std::mt19937 random_engine{ 39 };
+};
+
+class AvailablePowerTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        available_power = App_AvailablePower_Create(
+            get_cell_statistics, get_main_current, read_cell_temperatures,
+            get_min_cell_temperature, get_max_cell_temperature);
+
+        RESET_FAKE(get_cell_statistics);
+        RESET_FAKE(get_main_current);
+        RESET_FAKE(read_cell_temperatures);
+        RESET_FAKE(get_min_cell_temperature);
+        RESET_FAKE(get_max_cell_temperature);
+
+        statistics                               = {};
+        get_cell_statistics_fake.return_val      = &statistics;
+        read_cell_temperatures_fake.return_val   = EXIT_CODE_OK;
+        get_min_cell_temperature_fake.return_val = 250;
+        get_max_cell_temperature_fake.return_val = 250;
+    }
+
+    void TearDown() override
+    {
+        TearDownObject(available_power, App_AvailablePower_Destroy);
+    }
+
+    // Run the plant with the given current for one tick, and tick the
+    // available power estimator with the cell voltages and the current of the
+    // plant
+    void
+        Tick(AccumulatorPlant &plant, float current, float voltage_noise = 0.0f)
+    {
+        uint16_t cell_voltages[NUM_OF_CELL_MONITOR_CHIPS]
+                              [NUM_OF_CELLS_PER_SEGMENT];
+        plant.Tick(current, voltage_noise, cell_voltages);
+        App_CellStatistics_Compute(cell_voltages, &statistics);
+        get_main_current_fake.return_val = current;
+
+        App_AvailablePower_Tick100Hz(available_power, true, plant.soc);
+    }
+
+    // Get the largest relative error of the resistance estimates of every cell
+    // group of the given plant
+    float GetMaxResistanceError(const AccumulatorPlant &plant)
+    {
+        float max_error = 0.0f;
+        for (size_t segment = 0U; segment < NUM_OF_CELL_MONITOR_CHIPS;
+             segment++)
+        {
+            for (size_t cell = 0U; cell < NUM_OF_CELLS_PER_SEGMENT; cell++)
+            {
+                const float resistance = plant.resistances[segment][cell];
+                max_error              = std::max(
+                    max_error, std::fabs(
+                                   App_AvailablePower_GetCellResistance(
+                                       available_power, segment, cell) -
+                                   resistance) /
+                                   resistance);
+            }
+        }
+        return max_error;
+    }
+
+    // Get the power the accumulator can discharge at rest when every cell
+    // group has the same voltage and resistance, for the given factor on the
+    // series resistance and the given maximum current
+    static float GetExpectedDischargePower(
+        float cell_voltage,
+        float resistance,
+        float resistance_factor,
+        float max_current)
+    {
+        const float current = std::min(
+            (cell_voltage - MIN_CELL_VOLTAGE) /
+                (resistance_factor * resistance),
+            max_current);
+        return current * NUM_OF_CELLS *
+               (cell_voltage - current * resistance_factor * resistance);
+    }
+
+    struct AvailablePower *available_power;
+    struct CellStatistics  statistics;
+};
+
+TEST_F(AvailablePowerTest, resistances_converge_on_synthetic_drive_cycle)
+{
+    // Every cell group is a little different, and one has aged badly
+    AccumulatorPlant plant(80.0f, 0.0f);
+    for (size_t segment = 0U; segment < NUM_OF_CELL_MONITOR_CHIPS; segment++)
+    {
+        for (size_t cell = 0U; cell < NUM_OF_CELLS_PER_SEGMENT; cell++)
+        {
+            plant.resistances[segment][cell] =
+                0.012f + 0.0005f * (float)((segment * 7U + cell) % 13U);
+        }
+    }
+    plant.resistances[1][7] = 0.040f;
+
+    // Launches, cruising, regen braking and coasting, with the current
+    // stepping at the edges and ramping in between
+    std::mt19937                          random_engine{ 680 };
+    std::uniform_real_distribution<float> launch_current{ 30.0f, 55.0f };
+    std::uniform_real_distribution<float> regen_current{ -12.0f, -4.0f };
+
+    long long max_ns_per_tick = 0;
+    long long sum_ns          = 0;
+    uint32_t  num_ticks       = 0;
+    for (int lap = 0; lap < 20; lap++)
+    {
+        const float launch = launch_current(random_engine);
+        const float regen  = regen_current(random_engine);
+        for (int tick = 0; tick < 400; tick++)
+        {
+            float current = 0.0f;
+            if (tick < 100)
+            {
+                current = launch;
+            }
+            else if (tick < 250)
+            {
+                current = 0.5f * launch - 0.05f * (float)(tick - 100);
+            }
+            else if (tick < 320)
+            {
+                current = regen;
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            Tick(plant, current, 1e-3f);
+            const long long ns =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+            sum_ns += ns;
+            max_ns_per_tick = std::max(max_ns_per_tick, ns);
+            num_ticks++;
+        }
+    }
+
+    const float max_error = GetMaxResistanceError(plant);
+    RecordProperty(
+        "max_resistance_error_milli_percent", (int)(max_error * 1e5f));
+    RecordProperty("mean_ns_per_tick", (int)(sum_ns / num_ticks));
+    RecordProperty("max_ns_per_tick", (int)max_ns_per_tick);
+    printf(
+        "Available power tick: %lld ns mean, %lld ns max, max resistance error "
+        "%.2f%%\n",
+        sum_ns / num_ticks, max_ns_per_tick, max_error * 100.0f);
+
+    ASSERT_LT(max_error, 0.02f);
+    ASSERT_NEAR(
+        0.040f, App_AvailablePower_GetCellResistance(available_power, 1U, 7U),
+        0.0005f);
+}
+
+TEST_F(AvailablePowerTest, resistances_are_only_updated_on_current_steps)
+{
+    AccumulatorPlant plant(50.0f, 0.030f);
+
+    // A steady current, and a current ramping slower than the minimum step,
+    // don't excite the resistances
+    for (int tick = 0; tick < 500; tick++)
+    {
+        Tick(plant, 20.0f, 1e-3f);
+    }
+    for (int tick = 0; tick < 500; tick++)
+    {
+        Tick(plant, 20.0f + 0.05f * (float)tick, 1e-3f);
+    }
+    ASSERT_EQ(
+        CELL_GROUP_SERIES_RESISTANCE_OHMS,
+        App_AvailablePower_GetCellResistance(available_power, 0U, 0U));
+
+    // A step does, but the same cell voltages read twice don't, since their
+    // current was sampled with them
+    Tick(plant, 0.0f);
+    const float resistance =
+        App_AvailablePower_GetCellResistance(available_power, 0U, 0U);
+    ASSERT_GT(resistance, CELL_GROUP_SERIES_RESISTANCE_OHMS);
+    App_AvailablePower_Tick100Hz(available_power, true, plant.soc);
+    ASSERT_EQ(
+        resistance,
+        App_AvailablePower_GetCellResistance(available_power, 0U, 0U));
+
+    // Cell voltages that weren't read this tick are ignored entirely
+    const unsigned int call_count    = get_cell_statistics_fake.call_count;
+    get_main_current_fake.return_val = 50.0f;
+    App_AvailablePower_Tick100Hz(available_power, false, plant.soc);
+    ASSERT_EQ(call_count, get_cell_statistics_fake.call_count);
+    ASSERT_EQ(
+        resistance,
+        App_AvailablePower_GetCellResistance(available_power, 0U, 0U));
+}
+
+TEST_F(AvailablePowerTest, power_limits_match_equivalent_circuit_at_rest)
+{
+    // The resistances stay at their initial estimates at rest
+    const float      resistance = CELL_GROUP_SERIES_RESISTANCE_OHMS;
+    AccumulatorPlant plant(50.0f, resistance);
+    Tick(plant, 0.0f);
+    const float cell_voltage = (float)statistics.mean * 1e-4f;
+
+    const float polarization_ratio = AccumulatorPlant::POLARIZATION_RATIO;
+    const float continuous_factor  = 1.0f + polarization_ratio;
+    const float pulse_factor =
+        1.0f + polarization_ratio *
+                   (1.0f - std::exp(
+                               -PULSE_POWER_DURATION_S /
+                               (CELL_GROUP_POLARIZATION_RESISTANCE_OHMS *
+                                CELL_GROUP_POLARIZATION_CAPACITANCE_F)));
+
+    // Discharging is bounded by the minimum cell voltage, and regen by the
+    // maximum regen current
+    ASSERT_NEAR(
+        GetExpectedDischargePower(
+            cell_voltage, resistance, continuous_factor,
+            MAX_CONTINUOUS_DISCHARGE_CURRENT_A),
+        App_AvailablePower_GetContinuousDischargePower(available_power), 1.0f);
+    ASSERT_NEAR(
+        GetExpectedDischargePower(
+            cell_voltage, resistance, pulse_factor,
+            MAX_PULSE_DISCHARGE_CURRENT_A),
+        App_AvailablePower_GetPulseDischargePower(available_power), 1.0f);
+    ASSERT_LT(
+        App_AvailablePower_GetContinuousDischargePower(available_power),
+        App_AvailablePower_GetPulseDischargePower(available_power));
+    ASSERT_NEAR(
+        MAX_PULSE_REGEN_CURRENT_A * NUM_OF_CELLS *
+            (cell_voltage +
+             MAX_PULSE_REGEN_CURRENT_A * pulse_factor * resistance),
+        App_AvailablePower_GetPulseRegenPower(available_power), 1.0f);
+    ASSERT_NEAR(
+        MAX_CONTINUOUS_REGEN_CURRENT_A * NUM_OF_CELLS *
+            (cell_voltage +
+             MAX_CONTINUOUS_REGEN_CURRENT_A * continuous_factor * resistance),
+        App_AvailablePower_GetContinuousRegenPower(available_power), 1.0f);
+}
+
+TEST_F(AvailablePowerTest, weakest_cell_group_bounds_power_limits)
+{
+    AccumulatorPlant plant(50.0f, CELL_GROUP_SERIES_RESISTANCE_OHMS);
+    Tick(plant, 0.0f);
+    const float pulse_discharge_power =
+        App_AvailablePower_GetPulseDischargePower(available_power);
+    const float pulse_regen_power =
+        App_AvailablePower_GetPulseRegenPower(available_power);
+
+    // One cell group close to the minimum cell voltage, and one close to the
+    // maximum cell voltage
+    uint16_t cell_voltages[NUM_OF_CELL_MONITOR_CHIPS][NUM_OF_CELLS_PER_SEGMENT];
+    std::fill(
+        &cell_voltages[0][0], &cell_voltages[0][0] + NUM_OF_CELLS,
+        statistics.mean);
+    cell_voltages[0][3] = (uint16_t)(MIN_CELL_VOLTAGE * 1e4f) + 500U;
+    App_CellStatistics_Compute(cell_voltages, &statistics);
+    App_AvailablePower_Tick100Hz(available_power, true, 50.0f);
+    ASSERT_LT(
+        App_AvailablePower_GetPulseDischargePower(available_power),
+        0.5f * pulse_discharge_power);
+
+    cell_voltages[0][3] = statistics.mean;
+    cell_voltages[1][9] = (uint16_t)(MAX_CELL_VOLTAGE * 1e4f) - 200U;
+    App_CellStatistics_Compute(cell_voltages, &statistics);
+    App_AvailablePower_Tick100Hz(available_power, true, 50.0f);
+    ASSERT_LT(
+        App_AvailablePower_GetPulseRegenPower(available_power),
+        0.5f * pulse_regen_power);
+
+    // A cell group past its voltage limit leaves no power in that direction
+    cell_voltages[1][9] = (uint16_t)(MAX_CELL_VOLTAGE * 1e4f) + 100U;
+    App_CellStatistics_Compute(cell_voltages, &statistics);
+    App_AvailablePower_Tick100Hz(available_power, true, 50.0f);
+    ASSERT_EQ(0.0f, App_AvailablePower_GetPulseRegenPower(available_power));
+    ASSERT_EQ(
+        0.0f, App_AvailablePower_GetContinuousRegenPower(available_power));
+    ASSERT_GT(App_AvailablePower_GetPulseDischargePower(available_power), 0.0f);
+}
+
+TEST_F(AvailablePowerTest, power_limits_are_derated_by_temperature_and_soc)
+{
+    AccumulatorPlant plant(50.0f, CELL_GROUP_SERIES_RESISTANCE_OHMS);
+    Tick(plant, 0.0f);
+    const float discharge_power =
+        App_AvailablePower_GetPulseDischargePower(available_power);
+    const float regen_power =
+        App_AvailablePower_GetPulseRegenPower(available_power);
+    ASSERT_GT(regen_power, 0.0f);
+
+    // Regen is derated to half its current halfway down the cold ramp, while
+    // discharging isn't derated yet
+    get_min_cell_temperature_fake.return_val = (int32_t)std::lround(
+        5.0f *
+        (REGEN_FULL_MIN_TEMPERATURE_DEGC + REGEN_ZERO_MIN_TEMPERATURE_DEGC));
+    App_AvailablePower_Tick100Hz(available_power, true, 50.0f);
+    ASSERT_NEAR(
+        0.5f * regen_power,
+        App_AvailablePower_GetPulseRegenPower(available_power),
+        0.02f * regen_power);
+    ASSERT_EQ(
+        discharge_power,
+        App_AvailablePower_GetPulseDischargePower(available_power));
+
+    // Nothing is available once the hottest cell is too hot
+    get_min_cell_temperature_fake.return_val = 250;
+    get_max_cell_temperature_fake.return_val =
+        (int32_t)(10.0f * DISCHARGE_ZERO_MAX_TEMPERATURE_DEGC);
+    App_AvailablePower_Tick100Hz(available_power, true, 50.0f);
+    ASSERT_EQ(0.0f, App_AvailablePower_GetPulseDischargePower(available_power));
+    ASSERT_EQ(0.0f, App_AvailablePower_GetPulseRegenPower(available_power));
+
+    // Regen is cut off close to full, and discharging close to empty
+    get_max_cell_temperature_fake.return_val = 250;
+    App_AvailablePower_Tick100Hz(available_power, true, REGEN_ZERO_SOC);
+    ASSERT_EQ(0.0f, App_AvailablePower_GetPulseRegenPower(available_power));
+    ASSERT_GT(App_AvailablePower_GetPulseDischargePower(available_power), 0.0f);
+    App_AvailablePower_Tick100Hz(available_power, true, DISCHARGE_ZERO_SOC);
+    ASSERT_EQ(0.0f, App_AvailablePower_GetPulseDischargePower(available_power));
+    ASSERT_GT(App_AvailablePower_GetPulseRegenPower(available_power), 0.0f);
+
+    // Without every cell temperature, nothing is available
+    read_cell_temperatures_fake.return_val = EXIT_CODE_OUT_OF_RANGE;
+    App_AvailablePower_Tick100Hz(available_power, true, 50.0f);
+    ASSERT_EQ(
+        0.0f, App_AvailablePower_GetContinuousDischargePower(available_power));
+    ASSERT_EQ(0.0f, App_AvailablePower_GetPulseDischargePower(available_power));
+    ASSERT_EQ(
+        0.0f, App_AvailablePower_GetContinuousRegenPower(available_power));
+    ASSERT_EQ(0.0f, App_AvailablePower_GetPulseRegenPower(available_power));
+}
+
+} // namespace AvailablePowerTest
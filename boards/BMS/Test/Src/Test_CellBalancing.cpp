@@ -0,0 +1,451 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include "Test_Bms.h"
+
+extern "C"
+{
+#include "App_CellBalancing.h"
+#include "configs/App_CellBalancingConfigs.h"
+#include "configs/App_CellMonitorsThresholds.h"
+}
+
+namespace CellBalancingTest
+{
+FAKE_VALUE_FUNC(ExitCode, write_discharge_cells, const uint32_t *);
+FAKE_VALUE_FUNC(const struct CellStatistics *, get_cell_statistics);
+FAKE_VALUE_FUNC(float, get_max_die_temp);
+
+static uint32_t written_discharge_cells[NUM_OF_CELL_MONITOR_CHIPS];
+
+static ExitCode RecordDischargeCells(const uint32_t *discharge_cells)
+{
+    std::copy(
+        discharge_cells, discharge_cells + NUM_OF_CELL_MONITOR_CHIPS,
+        written_discharge_cells);
+    return EXIT_CODE_OK;
+}
+
+class CellBalancingTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        cell_balancing = App_CellBalancing_Create(
+            write_discharge_cells, get_cell_statistics, get_max_die_temp,
+            BALANCING_THRESHOLD_100UV, DIE_TEMP_TO_THROTTLE_CELL_BALANCING_DEGC,
+            DIE_TEMP_TO_REENABLE_CELL_BALANCING_DEGC,
+            DIE_TEMP_TO_DISABLE_CELL_BALANCING_DEGC);
+
+        RESET_FAKE(write_discharge_cells);
+        RESET_FAKE(get_cell_statistics);
+        RESET_FAKE(get_max_die_temp);
+
+        std::fill(
+            std::begin(written_discharge_cells),
+            std::end(written_discharge_cells), 0U);
+        write_discharge_cells_fake.custom_fake = RecordDischargeCells;
+        get_cell_statistics_fake.return_val    = &statistics;
+        get_max_die_temp_fake.return_val       = 25.0f;
+
+        SetCells(40000U);
+    }
+
+    void TearDown() override
+    {
+        TearDownObject(cell_balancing, App_CellBalancing_Destroy);
+    }
+
+    // Set every cell to the given value, and compute their statistics
+    void SetCells(uint16_t value)
+    {
+        for (auto &segment : cells)
+        {
+            std::fill(std::begin(segment), std::end(segment), value);
+        }
+        App_CellStatistics_Compute(cells, &statistics);
+    }
+
+    // Tick the cell balancing scheduler the given number of times
+    void Tick(uint32_t num_ticks)
+    {
+        for (uint32_t i = 0; i < num_ticks; i++)
+        {
+            App_CellBalancing_Tick100Hz(cell_balancing, current_ms);
+            current_ms += 10U;
+        }
+    }
+
+    struct CellBalancing *cell_balancing;
+    uint16_t cells[NUM_OF_CELL_MONITOR_CHIPS][NUM_OF_CELLS_PER_SEGMENT];
+    struct CellStatistics statistics;
+    uint32_t              current_ms = 0U;
+};
+
+TEST_F(CellBalancingTest, no_cell_discharges_when_cells_are_within_threshold)
+{
+    cells[0][0] = 40000U + BALANCING_THRESHOLD_100UV;
+    App_CellStatistics_Compute(cells, &statistics);
+
+    Tick(3 * BALANCING_PERIOD_TICKS);
+
+    ASSERT_EQ(0, write_discharge_cells_fake.call_count);
+    ASSERT_TRUE(
+        App_CellBalancing_CanReadCellVoltages(cell_balancing, current_ms));
+}
+
+TEST_F(CellBalancingTest, cells_above_threshold_discharge_then_settle)
+{
+    cells[0][2] = 40000U + BALANCING_THRESHOLD_100UV + 1U;
+    cells[NUM_OF_CELL_MONITOR_CHIPS - 1][15] = 41000U;
+    App_CellStatistics_Compute(cells, &statistics);
+
+    Tick(1);
+    ASSERT_EQ(1, write_discharge_cells_fake.call_count);
+    ASSERT_EQ(1U << 2, written_discharge_cells[0]);
+    ASSERT_EQ(1U << 15, written_discharge_cells[NUM_OF_CELL_MONITOR_CHIPS - 1]);
+    ASSERT_EQ(
+        MAX_BALANCING_DISCHARGE_TICKS,
+        App_CellBalancing_GetDischargeTicks(cell_balancing));
+    ASSERT_FALSE(
+        App_CellBalancing_CanReadCellVoltages(cell_balancing, current_ms));
+
+    Tick(MAX_BALANCING_DISCHARGE_TICKS - 1);
+    ASSERT_EQ(1, write_discharge_cells_fake.call_count);
+
+    // Every discharge switch turns off at the start of the measurement window
+    Tick(1);
+    ASSERT_EQ(2, write_discharge_cells_fake.call_count);
+    for (uint32_t discharge_cells : written_discharge_cells)
+    {
+        ASSERT_EQ(0U, discharge_cells);
+    }
+
+    const uint32_t discharge_stop_ms = current_ms - 10U;
+    ASSERT_FALSE(App_CellBalancing_CanReadCellVoltages(
+        cell_balancing, discharge_stop_ms + BALANCING_SETTLE_TIME_MS - 1U));
+    ASSERT_TRUE(App_CellBalancing_CanReadCellVoltages(
+        cell_balancing, discharge_stop_ms + BALANCING_SETTLE_TIME_MS));
+
+    // Once the cells are balanced, nothing else is written
+    SetCells(40000U);
+    Tick(2 * BALANCING_PERIOD_TICKS);
+    ASSERT_EQ(2, write_discharge_cells_fake.call_count);
+}
+
+TEST_F(CellBalancingTest, discharge_time_is_throttled_by_die_temp)
+{
+    cells[0][0] = 42000U;
+    App_CellStatistics_Compute(cells, &statistics);
+
+    const auto GetDischargeTicks = [&](float max_die_temp) {
+        get_max_die_temp_fake.return_val = max_die_temp;
+        Tick(BALANCING_PERIOD_TICKS);
+        return App_CellBalancing_GetDischargeTicks(cell_balancing);
+    };
+
+    ASSERT_EQ(
+        MAX_BALANCING_DISCHARGE_TICKS,
+        GetDischargeTicks(DIE_TEMP_TO_THROTTLE_CELL_BALANCING_DEGC));
+    ASSERT_EQ(
+        MAX_BALANCING_DISCHARGE_TICKS / 2,
+        GetDischargeTicks(
+            (DIE_TEMP_TO_THROTTLE_CELL_BALANCING_DEGC +
+             DIE_TEMP_TO_DISABLE_CELL_BALANCING_DEGC) /
+            2));
+    ASSERT_EQ(0U, GetDischargeTicks(DIE_TEMP_TO_DISABLE_CELL_BALANCING_DEGC));
+    ASSERT_EQ(0U, App_CellBalancing_GetDischargeCells(cell_balancing)[0]);
+
+    // Balancing stays disabled until the die cools down below the re-enable
+    // temperature
+    ASSERT_EQ(
+        0U, GetDischargeTicks(DIE_TEMP_TO_REENABLE_CELL_BALANCING_DEGC + 0.1f));
+    ASSERT_LT(
+        0U, GetDischargeTicks(DIE_TEMP_TO_REENABLE_CELL_BALANCING_DEGC - 0.1f));
+    ASSERT_EQ(1U, App_CellBalancing_GetDischargeCells(cell_balancing)[0]);
+}
+
+TEST_F(CellBalancingTest, stop_turns_off_discharge_and_restarts_period)
+{
+    cells[0][0] = 42000U;
+    App_CellStatistics_Compute(cells, &statistics);
+
+    Tick(10);
+    App_CellBalancing_Stop(cell_balancing, current_ms);
+    ASSERT_EQ(2, write_discharge_cells_fake.call_count);
+    ASSERT_EQ(0U, written_discharge_cells[0]);
+    ASSERT_FALSE(
+        App_CellBalancing_CanReadCellVoltages(cell_balancing, current_ms));
+
+    // Stopping again doesn't write anything, since nothing is discharging
+    App_CellBalancing_Stop(cell_balancing, current_ms);
+    ASSERT_EQ(2, write_discharge_cells_fake.call_count);
+
+    // A new balancing period starts once the cell voltages have recovered
+    Tick(BALANCING_SETTLE_TIME_MS / 10U);
+    ASSERT_EQ(2, write_discharge_cells_fake.call_count);
+    Tick(1);
+    ASSERT_EQ(3, write_discharge_cells_fake.call_count);
+    ASSERT_EQ(1U, written_discharge_cells[0]);
+}
+
+TEST_F(CellBalancingTest, discharging_cells_are_compensated_in_max_cell_voltage)
+{
+    cells[0][0]                              = 41000U;
+    cells[NUM_OF_CELL_MONITOR_CHIPS - 1][15] = 40900U;
+    App_CellStatistics_Compute(cells, &statistics);
+
+    // Nothing is compensated before any cell discharges
+    ASSERT_EQ(
+        41000U, App_CellBalancing_GetCompensatedMaxCellVoltage(
+                    cell_balancing, current_ms));
+
+    // While discharging, a cell that reads lower than another cell can still
+    // be the maximum once compensated
+    Tick(1);
+    cells[0][0]                              = 40800U;
+    cells[NUM_OF_CELL_MONITOR_CHIPS - 1][15] = 40700U;
+    cells[1][0]                              = 40850U;
+    App_CellStatistics_Compute(cells, &statistics);
+    ASSERT_EQ(
+        40800U + BALANCING_DISCHARGE_VOLTAGE_DROP_100UV,
+        App_CellBalancing_GetCompensatedMaxCellVoltage(
+            cell_balancing, current_ms));
+
+    // The discharged cells are still compensated until they have recovered
+    Tick(MAX_BALANCING_DISCHARGE_TICKS);
+    ASSERT_EQ(
+        40800U + BALANCING_DISCHARGE_VOLTAGE_DROP_100UV,
+        App_CellBalancing_GetCompensatedMaxCellVoltage(
+            cell_balancing, current_ms));
+    Tick(BALANCING_SETTLE_TIME_MS / 10U);
+    ASSERT_EQ(
+        40850U, App_CellBalancing_GetCompensatedMaxCellVoltage(
+                    cell_balancing, current_ms));
+}
+
+// A model of a resting accumulator whose cells are discharged through the
+// balancing resistors, used to simulate how long it takes to balance the pack
+class CellBalancingSimulation
+{
+  public:
+    explicit CellBalancingSimulation(uint32_t seed)
+    {
+        std::mt19937                           random_engine(seed);
+        std::uniform_real_distribution<double> soc_distribution(0.90, 0.95);
+        for (auto &segment : socs)
+        {
+            for (double &soc : segment)
+            {
+                soc = soc_distribution(random_engine);
+            }
+        }
+    }
+
+    // Discharge the given cells for one 100Hz tick
+    void Discharge(const uint32_t *discharge_cells)
+    {
+        for (size_t segment = 0; segment < NUM_OF_CELL_MONITOR_CHIPS; segment++)
+        {
+            for (size_t cell = 0; cell < NUM_OF_CELLS_PER_SEGMENT; cell++)
+            {
+                if ((discharge_cells[segment] >> cell) & 1U)
+                {
+                    socs[segment][cell] -=
+                        GetOpenCircuitVoltage(socs[segment][cell]) /
+                        BALANCING_RESISTANCE_OHMS * 0.01 /
+                        CELL_CAPACITY_COULOMBS;
+                }
+            }
+        }
+    }
+
+    // Get the raw cell voltages (100µV) that would be read back, including
+    // the drop across the sense wires of the cells that are discharging
+    void ReadCells(
+        const uint32_t *discharge_cells,
+        uint16_t cells[NUM_OF_CELL_MONITOR_CHIPS][NUM_OF_CELLS_PER_SEGMENT])
+        const
+    {
+        for (size_t segment = 0; segment < NUM_OF_CELL_MONITOR_CHIPS; segment++)
+        {
+            for (size_t cell = 0; cell < NUM_OF_CELLS_PER_SEGMENT; cell++)
+            {
+                const double voltage =
+                    GetOpenCircuitVoltage(socs[segment][cell]);
+                const double drop = ((discharge_cells[segment] >> cell) & 1U)
+                                        ? voltage / BALANCING_RESISTANCE_OHMS *
+                                              SENSE_WIRE_RESISTANCE_OHMS
+                                        : 0.0;
+                cells[segment][cell] =
+                    (uint16_t)std::lround((voltage - drop) * 10000.0);
+            }
+        }
+    }
+
+    // Get the spread of the open circuit cell voltages (100µV)
+    double GetSpread() const
+    {
+        const auto [min, max] =
+            std::minmax_element(&socs[0][0], &socs[0][0] + NUM_OF_CELLS);
+        return (GetOpenCircuitVoltage(*max) - GetOpenCircuitVoltage(*min)) *
+               10000.0;
+    }
+
+  private:
+    static double GetOpenCircuitVoltage(double soc) { return 3.0 + 1.2 * soc; }
+
+    static constexpr size_t NUM_OF_CELLS =
+        NUM_OF_CELL_MONITOR_CHIPS * NUM_OF_CELLS_PER_SEGMENT;
+    static constexpr double CELL_CAPACITY_COULOMBS     = 3.0 * 3600.0;
+    static constexpr double BALANCING_RESISTANCE_OHMS  = 33.0;
+    static constexpr double SENSE_WIRE_RESISTANCE_OHMS = 0.5;
+
+    double socs[NUM_OF_CELL_MONITOR_CHIPS][NUM_OF_CELLS_PER_SEGMENT];
+};
+
+static constexpr uint32_t MAX_SIMULATED_TICKS = 10U * 3600U * 100U;
+
+// Simulate the cell balancing scheduler until no cell is picked to discharge
+// for a whole balancing period, and get the number of simulated ticks taken
+static uint32_t SimulateCellBalancing(
+    CellBalancingSimulation &simulation,
+    struct CellBalancing *   cell_balancing,
+    struct CellStatistics &  statistics)
+{
+    const uint32_t no_discharge_cells[NUM_OF_CELL_MONITOR_CHIPS] = { 0U };
+    uint16_t       cells[NUM_OF_CELL_MONITOR_CHIPS][NUM_OF_CELLS_PER_SEGMENT];
+
+    uint32_t tick = 0U;
+    for (; tick < MAX_SIMULATED_TICKS; tick++)
+    {
+        const uint32_t current_ms = tick * 10U;
+        simulation.ReadCells(written_discharge_cells, cells);
+        App_CellStatistics_Compute(cells, &statistics);
+
+        App_CellBalancing_Tick100Hz(cell_balancing, current_ms);
+        simulation.Discharge(written_discharge_cells);
+
+        if (tick % BALANCING_PERIOD_TICKS == 0U &&
+            std::equal(
+                no_discharge_cells,
+                no_discharge_cells + NUM_OF_CELL_MONITOR_CHIPS,
+                App_CellBalancing_GetDischargeCells(cell_balancing)))
+        {
+            break;
+        }
+    }
+
+    return tick;
+}
+
+// What balancing without measurement windows does: the cells to discharge are
+// picked once a second from cell voltages read while the cells are discharging
+static uint32_t SimulateContinuousBalancing(CellBalancingSimulation &simulation)
+{
+    uint32_t discharge_cells[NUM_OF_CELL_MONITOR_CHIPS] = { 0U };
+    uint16_t cells[NUM_OF_CELL_MONITOR_CHIPS][NUM_OF_CELLS_PER_SEGMENT];
+    struct CellStatistics statistics;
+
+    uint32_t tick = 0U;
+    for (; tick < MAX_SIMULATED_TICKS; tick++)
+    {
+        if (tick % BALANCING_PERIOD_TICKS == 0U)
+        {
+            simulation.ReadCells(discharge_cells, cells);
+            App_CellStatistics_Compute(cells, &statistics);
+
+            bool is_any_cell_picked = false;
+            for (size_t segment = 0; segment < NUM_OF_CELL_MONITOR_CHIPS;
+                 segment++)
+            {
+                discharge_cells[segment] = 0U;
+                for (size_t cell = 0; cell < NUM_OF_CELLS_PER_SEGMENT; cell++)
+                {
+                    if (cells[segment][cell] - statistics.min >
+                        (int)BALANCING_THRESHOLD_100UV)
+                    {
+                        discharge_cells[segment] |= 1U << cell;
+                        is_any_cell_picked = true;
+                    }
+                }
+            }
+
+            if (!is_any_cell_picked)
+            {
+                break;
+            }
+        }
+
+        simulation.Discharge(discharge_cells);
+    }
+
+    return tick;
+}
+
+TEST_F(CellBalancingTest, simulate_time_to_balance_pack)
+{
+    const auto ToMinutes = [](uint32_t ticks) { return ticks / 100.0 / 60.0; };
+
+    CellBalancingSimulation continuous_simulation(36);
+    const double            initial_spread = continuous_simulation.GetSpread();
+    const uint32_t          continuous_ticks =
+        SimulateContinuousBalancing(continuous_simulation);
+
+    RecordProperty("initial_spread_100uv", (int)initial_spread);
+    RecordProperty(
+        "continuous_minutes_to_balance", (int)ToMinutes(continuous_ticks));
+    RecordProperty(
+        "continuous_final_spread_100uv",
+        (int)continuous_simulation.GetSpread());
+    printf(
+        "Balancing a spread of %.0f x 100uV: continuous %.1f min, final spread "
+        "%.0f x 100uV\n",
+        initial_spread, ToMinutes(continuous_ticks),
+        continuous_simulation.GetSpread());
+
+    for (const float max_die_temp :
+         { 25.0f, 105.0f, 110.0f, DIE_TEMP_TO_DISABLE_CELL_BALANCING_DEGC })
+    {
+        TearDownObject(cell_balancing, App_CellBalancing_Destroy);
+        cell_balancing = App_CellBalancing_Create(
+            write_discharge_cells, get_cell_statistics, get_max_die_temp,
+            BALANCING_THRESHOLD_100UV, DIE_TEMP_TO_THROTTLE_CELL_BALANCING_DEGC,
+            DIE_TEMP_TO_REENABLE_CELL_BALANCING_DEGC,
+            DIE_TEMP_TO_DISABLE_CELL_BALANCING_DEGC);
+        std::fill(
+            std::begin(written_discharge_cells),
+            std::end(written_discharge_cells), 0U);
+        get_max_die_temp_fake.return_val = max_die_temp;
+
+        CellBalancingSimulation simulation(36);
+        const uint32_t          ticks =
+            SimulateCellBalancing(simulation, cell_balancing, statistics);
+
+        const std::string name =
+            "scheduler_at_" + std::to_string((int)max_die_temp) + "_degc";
+        RecordProperty(name + "_minutes_to_balance", (int)ToMinutes(ticks));
+        RecordProperty(
+            name + "_final_spread_100uv", (int)simulation.GetSpread());
+        printf(
+            "Balancing with the die at %.0f degC: %.1f min, final spread %.0f "
+            "x "
+            "100uV\n",
+            max_die_temp, ToMinutes(ticks), simulation.GetSpread());
+
+        if (max_die_temp >= DIE_TEMP_TO_DISABLE_CELL_BALANCING_DEGC)
+        {
+            // Nothing is discharged, so the pack never balances
+            ASSERT_NEAR(initial_spread, simulation.GetSpread(), 1.0);
+        }
+        else
+        {
+            // Every cell is measured at rest, so the pack balances to within
+            // the threshold
+            ASSERT_LT(ticks, MAX_SIMULATED_TICKS);
+            ASSERT_LE(simulation.GetSpread(), BALANCING_THRESHOLD_100UV + 1.0);
+        }
+    }
+}
+} // namespace CellBalancingTest
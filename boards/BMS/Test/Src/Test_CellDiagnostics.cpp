@@ -0,0 +1,217 @@
+#include <algorithm>
+#include "Test_Bms.h"
+
+extern "C"
+{
+#include "App_CellDiagnostics.h"
+#include "configs/App_CellDiagnosticsConfigs.h"
+}
+
+namespace CellDiagnosticsTest
+{
+typedef uint16_t (*DiagnosticVoltages)[NUM_OF_CELLS_PER_SEGMENT];
+FAKE_VALUE_FUNC(
+    ExitCode,
+    read_diagnostic,
+    enum CellDiagnostic,
+    DiagnosticVoltages);
+
+// The latest result of every diagnostic, and whether it hasn't been read yet
+static uint16_t results[NUM_OF_CELL_DIAGNOSTICS][NUM_OF_CELL_MONITOR_CHIPS]
+                       [NUM_OF_CELLS_PER_SEGMENT];
+static bool is_result_new[NUM_OF_CELL_DIAGNOSTICS];
+
+static ExitCode ReadFakeDiagnostic(
+    enum CellDiagnostic diagnostic,
+    DiagnosticVoltages  voltages)
+{
+    std::copy(
+        &results[diagnostic][0][0],
+        &results[diagnostic][0][0] +
+            NUM_OF_CELL_MONITOR_CHIPS * NUM_OF_CELLS_PER_SEGMENT,
+        &voltages[0][0]);
+
+    if (!is_result_new[diagnostic])
+    {
+        return EXIT_CODE_TIMEOUT;
+    }
+    is_result_new[diagnostic] = false;
+    return EXIT_CODE_OK;
+}
+
+class CellDiagnosticsTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        cell_diagnostics = App_CellDiagnostics_Create(
+            read_diagnostic, OPEN_WIRE_THRESHOLD_100UV,
+            ADC_OVERLAP_THRESHOLD_100UV, NUM_OF_CONSECUTIVE_DIAGNOSTIC_RESULTS);
+
+        RESET_FAKE(read_diagnostic);
+        read_diagnostic_fake.custom_fake = ReadFakeDiagnostic;
+
+        // Every diagnostic reads 4.0V on every cell of a healthy segment
+        std::fill(
+            &results[0][0][0],
+            &results[0][0][0] + sizeof(results) / sizeof(results[0][0][0]),
+            40000U);
+        std::fill(std::begin(is_result_new), std::end(is_result_new), false);
+    }
+
+    void TearDown() override
+    {
+        TearDownObject(cell_diagnostics, App_CellDiagnostics_Destroy);
+    }
+
+    // Deliver one result of every diagnostic, then tick the cell diagnostics
+    void TickWithResults(uint32_t num_ticks, bool can_evaluate = true)
+    {
+        for (uint32_t i = 0; i < num_ticks; i++)
+        {
+            std::fill(std::begin(is_result_new), std::end(is_result_new), true);
+            App_CellDiagnostics_Tick100Hz(cell_diagnostics, can_evaluate);
+        }
+    }
+
+    enum CellDiagnosticStatus GetStatus(size_t segment, size_t cell)
+    {
+        return App_CellDiagnostics_GetCellStatus(
+            cell_diagnostics, segment, cell);
+    }
+
+    struct CellDiagnostics *cell_diagnostics;
+};
+
+TEST_F(CellDiagnosticsTest, cells_are_untested_until_enough_results_agree)
+{
+    // No result has arrived yet
+    App_CellDiagnostics_Tick100Hz(cell_diagnostics, true);
+    ASSERT_EQ(
+        NUM_OF_CELL_MONITOR_CHIPS * NUM_OF_CELLS_PER_SEGMENT,
+        App_CellDiagnostics_GetNumOfCellsWithStatus(
+            cell_diagnostics, CELL_DIAGNOSTIC_STATUS_UNTESTED));
+
+    TickWithResults(NUM_OF_CONSECUTIVE_DIAGNOSTIC_RESULTS - 1U);
+    ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_UNTESTED, GetStatus(0U, 0U));
+
+    TickWithResults(1U);
+    ASSERT_EQ(
+        NUM_OF_CELL_MONITOR_CHIPS * NUM_OF_CELLS_PER_SEGMENT,
+        App_CellDiagnostics_GetNumOfCellsWithStatus(
+            cell_diagnostics, CELL_DIAGNOSTIC_STATUS_OK));
+}
+
+TEST_F(CellDiagnosticsTest, open_wire_is_reported_on_the_cells_of_the_pin)
+{
+    uint16_t(*const pull_up)[NUM_OF_CELLS_PER_SEGMENT] =
+        results[CELL_DIAGNOSTIC_OPEN_WIRE_PULL_UP];
+    uint16_t(*const pull_down)[NUM_OF_CELLS_PER_SEGMENT] =
+        results[CELL_DIAGNOSTIC_OPEN_WIRE_PULL_DOWN];
+    const size_t last_cell = NUM_OF_CELLS_PER_SEGMENT - 1U;
+
+    // An open pin in the middle of the segment reads the cell above it lower
+    // with the pull-up current than with the pull-down current
+    pull_up[0][5]   = 38000U;
+    pull_down[0][5] = 42500U;
+
+    // The bottom pin reads the bottom cell as 0V with the pull-up current, and
+    // the top pin reads the top cell as 0V with the pull-down current
+    pull_up[1][0]           = 0U;
+    pull_down[1][last_cell] = 0U;
+
+    TickWithResults(NUM_OF_CONSECUTIVE_DIAGNOSTIC_RESULTS);
+    ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_OK, GetStatus(0U, 3U));
+    ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_OPEN_WIRE, GetStatus(0U, 4U));
+    ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_OPEN_WIRE, GetStatus(0U, 5U));
+    ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_OK, GetStatus(0U, 6U));
+    ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_OPEN_WIRE, GetStatus(1U, 0U));
+    ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_OK, GetStatus(1U, 1U));
+    ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_OK, GetStatus(1U, last_cell - 1U));
+    ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_OPEN_WIRE, GetStatus(1U, last_cell));
+    ASSERT_EQ(
+        4U, App_CellDiagnostics_GetNumOfCellsWithStatus(
+                cell_diagnostics, CELL_DIAGNOSTIC_STATUS_OPEN_WIRE));
+
+    // A difference within the threshold isn't an open wire
+    pull_up[0][5]   = 40000U;
+    pull_down[0][5] = 40000U + OPEN_WIRE_THRESHOLD_100UV;
+    TickWithResults(NUM_OF_CONSECUTIVE_DIAGNOSTIC_RESULTS);
+    ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_OK, GetStatus(0U, 5U));
+}
+
+TEST_F(CellDiagnosticsTest, adc_mismatch_is_reported_on_every_cell_of_segment)
+{
+    uint16_t(*const overlap)[NUM_OF_CELLS_PER_SEGMENT] =
+        results[CELL_DIAGNOSTIC_ADC_OVERLAP];
+
+    // ADC 2 reads cell 13 differently from ADC 3 on the 1st segment, which
+    // also has an open wire
+    overlap[1][12] = 40000U + ADC_OVERLAP_THRESHOLD_100UV + 1U;
+    results[CELL_DIAGNOSTIC_OPEN_WIRE_PULL_UP][1][0] = 0U;
+
+    TickWithResults(NUM_OF_CONSECUTIVE_DIAGNOSTIC_RESULTS);
+    for (size_t cell = 0U; cell < NUM_OF_CELLS_PER_SEGMENT; cell++)
+    {
+        ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_OK, GetStatus(0U, cell));
+        ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_ADC_MISMATCH, GetStatus(1U, cell));
+    }
+
+    // Once the ADCs agree again, the open wire is reported
+    overlap[1][12] = 40000U;
+    overlap[1][6]  = 40000U + ADC_OVERLAP_THRESHOLD_100UV;
+    TickWithResults(NUM_OF_CONSECUTIVE_DIAGNOSTIC_RESULTS);
+    ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_OPEN_WIRE, GetStatus(1U, 0U));
+    ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_OK, GetStatus(1U, 1U));
+}
+
+TEST_F(CellDiagnosticsTest, status_only_changes_after_consecutive_results)
+{
+    TickWithResults(NUM_OF_CONSECUTIVE_DIAGNOSTIC_RESULTS);
+    ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_OK, GetStatus(0U, 0U));
+
+    // Too few consecutive disturbed results don't set an open wire
+    results[CELL_DIAGNOSTIC_OPEN_WIRE_PULL_UP][0][0] = 0U;
+    TickWithResults(NUM_OF_CONSECUTIVE_DIAGNOSTIC_RESULTS - 1U);
+    results[CELL_DIAGNOSTIC_OPEN_WIRE_PULL_UP][0][0] = 40000U;
+    TickWithResults(1U);
+    ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_OK, GetStatus(0U, 0U));
+
+    results[CELL_DIAGNOSTIC_OPEN_WIRE_PULL_UP][0][0] = 0U;
+    TickWithResults(NUM_OF_CONSECUTIVE_DIAGNOSTIC_RESULTS);
+    ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_OPEN_WIRE, GetStatus(0U, 0U));
+
+    // Nor do too few consecutive healthy results clear it
+    results[CELL_DIAGNOSTIC_OPEN_WIRE_PULL_UP][0][0] = 40000U;
+    TickWithResults(NUM_OF_CONSECUTIVE_DIAGNOSTIC_RESULTS - 1U);
+    ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_OPEN_WIRE, GetStatus(0U, 0U));
+    TickWithResults(1U);
+    ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_OK, GetStatus(0U, 0U));
+}
+
+TEST_F(CellDiagnosticsTest, results_are_dropped_while_cells_discharge)
+{
+    // Results that arrive while cells discharge are read, but never evaluated
+    results[CELL_DIAGNOSTIC_OPEN_WIRE_PULL_UP][0][0] = 0U;
+    TickWithResults(10U * NUM_OF_CONSECUTIVE_DIAGNOSTIC_RESULTS, false);
+    ASSERT_EQ(
+        NUM_OF_CELL_DIAGNOSTICS * 10U * NUM_OF_CONSECUTIVE_DIAGNOSTIC_RESULTS,
+        read_diagnostic_fake.call_count);
+    ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_UNTESTED, GetStatus(0U, 0U));
+
+    // A pull-up result from while cells discharged isn't paired with the
+    // pull-down result that arrives after they stopped
+    is_result_new[CELL_DIAGNOSTIC_OPEN_WIRE_PULL_UP] = true;
+    App_CellDiagnostics_Tick100Hz(cell_diagnostics, false);
+    for (uint32_t i = 0; i < NUM_OF_CONSECUTIVE_DIAGNOSTIC_RESULTS; i++)
+    {
+        is_result_new[CELL_DIAGNOSTIC_OPEN_WIRE_PULL_DOWN] = true;
+        App_CellDiagnostics_Tick100Hz(cell_diagnostics, true);
+    }
+    ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_UNTESTED, GetStatus(0U, 0U));
+
+    TickWithResults(NUM_OF_CONSECUTIVE_DIAGNOSTIC_RESULTS);
+    ASSERT_EQ(CELL_DIAGNOSTIC_STATUS_OPEN_WIRE, GetStatus(0U, 0U));
+}
+
+} // namespace CellDiagnosticsTest
@@ -0,0 +1,204 @@
+#include <chrono>
+#include <random>
+#include "Test_Bms.h"
+
+extern "C"
+{
+#include "App_CellStatistics.h"
+}
+
+class CellStatisticsTest : public testing::Test
+{
+  protected:
+    void FillRandomCells(uint16_t min_value, uint16_t max_value)
+    {
+        std::uniform_int_distribution<int> distribution(min_value, max_value);
+        for (auto &segment : cells)
+        {
+            for (uint16_t &cell : segment)
+            {
+                cell = (uint16_t)distribution(random_engine);
+            }
+        }
+    }
+
+    uint16_t cells[NUM_OF_CELL_MONITOR_CHIPS][NUM_OF_CELLS_PER_SEGMENT] = {};
+    struct CellStatistics statistics;
+    std::mt19937          random_engine{ 34 };
+};
+
+TEST_F(CellStatisticsTest, statistics_match_separate_passes)
+{
+    for (int i = 0; i < 1000; i++)
+    {
+        FillRandomCells(25000, 42000);
+        App_CellStatistics_Compute(cells, &statistics);
+
+        uint16_t min = UINT16_MAX;
+        uint16_t max = 0;
+        uint32_t sum = 0;
+        for (size_t segment = 0; segment < NUM_OF_CELL_MONITOR_CHIPS; segment++)
+        {
+            uint32_t segment_sum = 0;
+            for (size_t cell = 0; cell < NUM_OF_CELLS_PER_SEGMENT; cell++)
+            {
+                min = std::min(min, cells[segment][cell]);
+                max = std::max(max, cells[segment][cell]);
+                segment_sum += cells[segment][cell];
+            }
+            ASSERT_EQ(segment_sum, statistics.segment_sums[segment]);
+            sum += segment_sum;
+        }
+
+        ASSERT_EQ(min, statistics.min);
+        ASSERT_EQ(max, statistics.max);
+        ASSERT_EQ(max - min, statistics.spread);
+        ASSERT_EQ(sum, statistics.sum);
+        ASSERT_NEAR(
+            (double)sum /
+                (NUM_OF_CELL_MONITOR_CHIPS * NUM_OF_CELLS_PER_SEGMENT),
+            statistics.mean, 0.5);
+        ASSERT_EQ(
+            min, cells[statistics.min_location.segment]
+                      [statistics.min_location.cell]);
+        ASSERT_EQ(
+            max, cells[statistics.max_location.segment]
+                      [statistics.max_location.cell]);
+
+        for (size_t segment = 0; segment < NUM_OF_CELL_MONITOR_CHIPS; segment++)
+        {
+            for (size_t cell = 0; cell < NUM_OF_CELLS_PER_SEGMENT; cell++)
+            {
+                ASSERT_EQ(
+                    cells[segment][cell] - statistics.mean,
+                    statistics.deltas_from_mean[segment][cell]);
+            }
+        }
+    }
+}
+
+TEST_F(CellStatisticsTest, min_and_max_locations_are_first_occurrences)
+{
+    for (auto &segment : cells)
+    {
+        for (uint16_t &cell : segment)
+        {
+            cell = 37000;
+        }
+    }
+    cells[0][3]                             = 30000;
+    cells[NUM_OF_CELL_MONITOR_CHIPS - 1][3] = 30000;
+    cells[0][NUM_OF_CELLS_PER_SEGMENT - 1]  = 41000;
+    cells[NUM_OF_CELL_MONITOR_CHIPS - 1][0] = 41000;
+
+    App_CellStatistics_Compute(cells, &statistics);
+
+    ASSERT_EQ(0, statistics.min_location.segment);
+    ASSERT_EQ(3, statistics.min_location.cell);
+    ASSERT_EQ(0, statistics.max_location.segment);
+    ASSERT_EQ(NUM_OF_CELLS_PER_SEGMENT - 1, statistics.max_location.cell);
+    ASSERT_EQ(11000, statistics.spread);
+}
+
+TEST_F(CellStatisticsTest, equal_cells_have_no_spread_or_deltas)
+{
+    for (auto &segment : cells)
+    {
+        for (uint16_t &cell : segment)
+        {
+            cell = UINT16_MAX;
+        }
+    }
+
+    App_CellStatistics_Compute(cells, &statistics);
+
+    ASSERT_EQ(UINT16_MAX, statistics.min);
+    ASSERT_EQ(UINT16_MAX, statistics.max);
+    ASSERT_EQ(0, statistics.spread);
+    ASSERT_EQ(UINT16_MAX, statistics.mean);
+    ASSERT_EQ(0, statistics.min_location.segment);
+    ASSERT_EQ(0, statistics.min_location.cell);
+    for (auto &segment : statistics.deltas_from_mean)
+    {
+        for (int32_t delta : segment)
+        {
+            ASSERT_EQ(0, delta);
+        }
+    }
+}
+
+TEST_F(CellStatisticsTest, benchmark_statistics)
+{
+    FillRandomCells(25000, 42000);
+
+    constexpr uint32_t num_iterations = 100000;
+
+    const auto statistics_start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < num_iterations; i++)
+    {
+        cells[i % NUM_OF_CELL_MONITOR_CHIPS][i % NUM_OF_CELLS_PER_SEGMENT]++;
+        App_CellStatistics_Compute(cells, &statistics);
+    }
+    const auto statistics_duration =
+        std::chrono::steady_clock::now() - statistics_start;
+
+    // What every getter used to do: walk the cells once for the minimum, the
+    // maximum, the pack voltage, the average and each segment voltage
+    volatile uint32_t result         = 0;
+    const auto        separate_start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < num_iterations; i++)
+    {
+        cells[i % NUM_OF_CELL_MONITOR_CHIPS][i % NUM_OF_CELLS_PER_SEGMENT]++;
+        const uint16_t * flat_cells = &cells[0][0];
+        constexpr size_t num_cells =
+            NUM_OF_CELL_MONITOR_CHIPS * NUM_OF_CELLS_PER_SEGMENT;
+
+        uint16_t min = flat_cells[0];
+        for (size_t j = 1; j < num_cells; j++)
+        {
+            min = std::min(min, flat_cells[j]);
+        }
+        uint16_t max = flat_cells[0];
+        for (size_t j = 1; j < num_cells; j++)
+        {
+            max = std::max(max, flat_cells[j]);
+        }
+        for (int pass = 0; pass < 2; pass++)
+        {
+            uint32_t sum = 0;
+            for (size_t j = 0; j < num_cells; j++)
+            {
+                sum += flat_cells[j];
+            }
+            result = result + sum;
+        }
+        for (size_t segment = 0; segment < NUM_OF_CELL_MONITOR_CHIPS; segment++)
+        {
+            uint32_t sum = 0;
+            for (size_t j = 0; j < NUM_OF_CELLS_PER_SEGMENT; j++)
+            {
+                sum += cells[segment][j];
+            }
+            result = result + sum;
+        }
+        result = result + min + max;
+    }
+    const auto separate_duration =
+        std::chrono::steady_clock::now() - separate_start;
+
+    const auto statistics_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            statistics_duration)
+            .count() /
+        num_iterations;
+    const auto separate_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(separate_duration)
+            .count() /
+        num_iterations;
+
+    RecordProperty("statistics_ns_per_scan", (int)statistics_ns);
+    RecordProperty("separate_getters_ns_per_scan", (int)separate_ns);
+    printf(
+        "Cell statistics: one pass %lld ns, separate getters %lld ns\n",
+        (long long)statistics_ns, (long long)separate_ns);
+}
@@ -90,6 +90,57 @@ TEST_F(CurrentSenseTest, high_res_main_current_calculation)
         Io_CurrentSense_ConvertToHighResolutionMainCurrent(adc_voltage, NULL));
 }
 
+TEST_F(CurrentSenseTest, main_current_calculation)
+{
+    const auto GetLowResAdcVoltage = [](float current) {
+        return (HSNBV_D06_OFFSET_VOLTAGE + current * 40e-3f) / voltage_ratio;
+    };
+    const auto GetHighResAdcVoltage = [](float current) {
+        return (HSNBV_D06_OFFSET_VOLTAGE + current * 6.67e-3f) / voltage_ratio;
+    };
+
+    // Negative ADC voltage
+    float main_current = 0.0f;
+    ASSERT_EQ(
+        EXIT_CODE_OUT_OF_RANGE,
+        Io_CurrentSense_ConvertToMainCurrent(
+            std::nextafter(0.0f, std::numeric_limits<float>::lowest()),
+            GetHighResAdcVoltage(0.0f), &main_current));
+    ASSERT_EQ(
+        EXIT_CODE_OUT_OF_RANGE,
+        Io_CurrentSense_ConvertToMainCurrent(
+            GetLowResAdcVoltage(100.0f),
+            std::nextafter(0.0f, std::numeric_limits<float>::lowest()),
+            &main_current));
+
+    // The low-resolution output is used while it is within its range, even if
+    // the high-resolution output reads differently
+    ASSERT_EQ(
+        EXIT_CODE_OK, Io_CurrentSense_ConvertToMainCurrent(
+                          GetLowResAdcVoltage(-40.0f),
+                          GetHighResAdcVoltage(-41.0f), &main_current));
+    ASSERT_NEAR(-40.0f, main_current, 1e-3f);
+
+    // The high-resolution output is used once the low-resolution output gets
+    // close to saturating
+    ASSERT_EQ(
+        EXIT_CODE_OK, Io_CurrentSense_ConvertToMainCurrent(
+                          GetLowResAdcVoltage(46.0f),
+                          GetHighResAdcVoltage(46.5f), &main_current));
+    ASSERT_NEAR(46.5f, main_current, 1e-3f);
+    ASSERT_EQ(
+        EXIT_CODE_OK, Io_CurrentSense_ConvertToMainCurrent(
+                          GetLowResAdcVoltage(-50.0f),
+                          GetHighResAdcVoltage(-200.0f), &main_current));
+    ASSERT_NEAR(-200.0f, main_current, 1e-2f);
+
+    // Null pointer
+    ASSERT_EQ(
+        EXIT_CODE_INVALID_ARGS,
+        Io_CurrentSense_ConvertToMainCurrent(
+            GetLowResAdcVoltage(0.0f), GetHighResAdcVoltage(0.0f), NULL));
+}
+
 TEST_F(CurrentSenseTest, air_loop_current_calculation)
 {
     // Negative ADC voltage
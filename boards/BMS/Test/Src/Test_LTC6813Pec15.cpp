@@ -0,0 +1,96 @@
+#include <random>
+#include <vector>
+#include "Test_Bms.h"
+
+extern "C"
+{
+#include "Io_LTC6813Pec15.h"
+}
+
+// A model of the STM32F3 CRC calculation unit configured with a 16-bit
+// polynomial, which processes every byte most significant bit first
+static uint16_t CalculateCrc16(const uint8_t *data_buffer, uint32_t size)
+{
+    uint16_t crc16 = PEC15_CRC16_INITIAL_VALUE;
+    for (uint32_t i = 0; i < size; i++)
+    {
+        crc16 = (uint16_t)(crc16 ^ (data_buffer[i] << 8));
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc16 = (crc16 & 0x8000U) != 0U
+                        ? (uint16_t)((crc16 << 1) ^ PEC15_CRC16_POLYNOMIAL)
+                        : (uint16_t)(crc16 << 1);
+        }
+    }
+    return crc16;
+}
+
+static uint16_t CalculateCrc16Pec15(const uint8_t *data_buffer, uint32_t size)
+{
+    return Io_LTC6813Pec15_ConvertFromCrc16(CalculateCrc16(data_buffer, size));
+}
+
+class LTC6813Pec15Test : public testing::Test
+{
+  protected:
+    std::vector<uint8_t> GetRandomBuffer(size_t size)
+    {
+        std::uniform_int_distribution<int> byte_distribution(0, UINT8_MAX);
+        std::vector<uint8_t>               buffer(size);
+        for (uint8_t &byte : buffer)
+        {
+            byte = (uint8_t)byte_distribution(random_engine);
+        }
+        return buffer;
+    }
+
+    std::mt19937 random_engine{ 6813 };
+};
+
+TEST_F(LTC6813Pec15Test, command_pec15s_match_datasheet)
+{
+    // The PEC15s of WRCFGA and RDCVA given in the LTC6813 datasheet
+    const uint8_t wrcfga[2] = { 0x00, 0x01 };
+    const uint8_t rdcva[2]  = { 0x00, 0x04 };
+
+    ASSERT_EQ(0x3D6E, Io_LTC6813Pec15_CalculateBytewise(wrcfga, 2));
+    ASSERT_EQ(0x07C2, Io_LTC6813Pec15_CalculateBytewise(rdcva, 2));
+    ASSERT_EQ(0x3D6E, Io_LTC6813Pec15_CalculateSlicingBy4(wrcfga, 2));
+    ASSERT_EQ(0x07C2, Io_LTC6813Pec15_CalculateSlicingBy4(rdcva, 2));
+    ASSERT_EQ(0x3D6E, CalculateCrc16Pec15(wrcfga, 2));
+    ASSERT_EQ(0x07C2, CalculateCrc16Pec15(rdcva, 2));
+}
+
+TEST_F(LTC6813Pec15Test, every_implementation_is_bit_exact_with_bytewise)
+{
+    // Cover every remainder of the slicing-by-4 loop, up to a whole daisy
+    // chain's worth of register groups
+    for (size_t size = 0; size <= 128; size++)
+    {
+        for (int i = 0; i < 100; i++)
+        {
+            const std::vector<uint8_t> buffer = GetRandomBuffer(size);
+            const uint16_t             expected_pec15 =
+                Io_LTC6813Pec15_CalculateBytewise(buffer.data(), size);
+
+            ASSERT_EQ(
+                expected_pec15,
+                Io_LTC6813Pec15_CalculateSlicingBy4(buffer.data(), size));
+            ASSERT_EQ(expected_pec15, CalculateCrc16Pec15(buffer.data(), size));
+        }
+    }
+}
+
+TEST_F(LTC6813Pec15Test, every_single_byte_is_bit_exact_with_bytewise)
+{
+    for (int byte = 0; byte <= UINT8_MAX; byte++)
+    {
+        const uint8_t data = (uint8_t)byte;
+        ASSERT_EQ(
+            Io_LTC6813Pec15_CalculateBytewise(&data, 1),
+            Io_LTC6813Pec15_CalculateSlicingBy4(&data, 1));
+        ASSERT_EQ(
+            Io_LTC6813Pec15_CalculateBytewise(&data, 1),
+            CalculateCrc16Pec15(&data, 1));
+    }
+}
@@ -0,0 +1,140 @@
+#include <vector>
+#include "Test_Bms.h"
+
+extern "C"
+{
+#include "Io_LTC6813Schedule.h"
+#include "configs/Io_LTC6813Configs.h"
+}
+
+// The length of every scan of the daisy chain: ADCV, then ADAX or a diagnostic,
+// then ADSTAT
+static constexpr uint32_t SCAN_PERIOD_MS = 12U;
+
+class LTC6813ScheduleTest : public testing::Test
+{
+  protected:
+    struct StartedConversion
+    {
+        uint32_t               start_ms;
+        enum LTC6813Conversion conversion;
+    };
+
+    // Start the conversions on 1kHz ticks like the LTC6813 engine, and record
+    // every conversion started up to the given time
+    std::vector<StartedConversion> Run(uint32_t duration_ms)
+    {
+        std::vector<StartedConversion> started_conversions;
+
+        bool                   is_converting       = false;
+        enum LTC6813Conversion conversion          = LTC6813_STATUS_CONVERSION;
+        uint32_t               conversion_start_ms = 0U;
+        uint32_t               num_scans           = 0U;
+        enum CellDiagnostic    diagnostic = CELL_DIAGNOSTIC_OPEN_WIRE_PULL_UP;
+
+        for (uint32_t current_ms = 0U; current_ms < duration_ms; current_ms++)
+        {
+            if (is_converting &&
+                current_ms - conversion_start_ms <
+                    Io_LTC6813Schedule_GetConversionTimeMs(conversion))
+            {
+                continue;
+            }
+
+            const enum LTC6813Conversion next_conversion =
+                Io_LTC6813Schedule_GetNextConversion(
+                    is_converting, conversion, num_scans, diagnostic);
+            if (next_conversion == LTC6813_CELL_VOLTAGE_CONVERSION)
+            {
+                num_scans++;
+            }
+            if (is_converting &&
+                conversion ==
+                    Io_LTC6813Schedule_GetDiagnosticConversion(diagnostic))
+            {
+                diagnostic = (enum CellDiagnostic)(
+                    (diagnostic + 1U) % NUM_OF_CELL_DIAGNOSTICS);
+            }
+
+            conversion          = next_conversion;
+            is_converting       = true;
+            conversion_start_ms = current_ms;
+            started_conversions.push_back({ current_ms, next_conversion });
+        }
+
+        return started_conversions;
+    }
+};
+
+TEST_F(LTC6813ScheduleTest, cell_voltage_conversions_start_every_scan_period)
+{
+    const std::vector<StartedConversion> started_conversions = Run(10000U);
+
+    std::vector<uint32_t> cell_voltage_start_times_ms;
+    for (const StartedConversion &started_conversion : started_conversions)
+    {
+        if (started_conversion.conversion == LTC6813_CELL_VOLTAGE_CONVERSION)
+        {
+            cell_voltage_start_times_ms.push_back(started_conversion.start_ms);
+        }
+    }
+
+    ASSERT_EQ(0U, cell_voltage_start_times_ms.front());
+    ASSERT_EQ(10000U / SCAN_PERIOD_MS + 1U, cell_voltage_start_times_ms.size());
+    for (size_t i = 1U; i < cell_voltage_start_times_ms.size(); i++)
+    {
+        ASSERT_EQ(
+            SCAN_PERIOD_MS, cell_voltage_start_times_ms[i] -
+                                cell_voltage_start_times_ms[i - 1U]);
+    }
+}
+
+TEST_F(LTC6813ScheduleTest, diagnostics_replace_aux_conversion_in_turn)
+{
+    const std::vector<StartedConversion> started_conversions = Run(10000U);
+
+    // Every scan is made up of the cell voltages, then the auxiliary voltages
+    // or a diagnostic, then the status registers
+    size_t              num_scans           = 0U;
+    enum CellDiagnostic expected_diagnostic = CELL_DIAGNOSTIC_OPEN_WIRE_PULL_UP;
+    size_t              num_diagnostic_scans = 0U;
+    for (size_t i = 0U; i + 2U < started_conversions.size(); i += 3U)
+    {
+        num_scans++;
+
+        ASSERT_EQ(
+            LTC6813_CELL_VOLTAGE_CONVERSION, started_conversions[i].conversion);
+        ASSERT_EQ(
+            LTC6813_STATUS_CONVERSION, started_conversions[i + 2U].conversion);
+
+        if (num_scans % SCANS_PER_DIAGNOSTIC == 0U)
+        {
+            ASSERT_EQ(
+                Io_LTC6813Schedule_GetDiagnosticConversion(expected_diagnostic),
+                started_conversions[i + 1U].conversion);
+            expected_diagnostic = (enum CellDiagnostic)(
+                (expected_diagnostic + 1U) % NUM_OF_CELL_DIAGNOSTICS);
+            num_diagnostic_scans++;
+        }
+        else
+        {
+            ASSERT_EQ(
+                LTC6813_AUX_CONVERSION, started_conversions[i + 1U].conversion);
+        }
+    }
+
+    ASSERT_GE(num_diagnostic_scans, 2U * NUM_OF_CELL_DIAGNOSTICS);
+}
+
+TEST_F(LTC6813ScheduleTest, restarted_scan_starts_with_cell_voltages)
+{
+    for (int conversion = 0; conversion < NUM_OF_LTC6813_CONVERSIONS;
+         conversion++)
+    {
+        ASSERT_EQ(
+            LTC6813_CELL_VOLTAGE_CONVERSION,
+            Io_LTC6813Schedule_GetNextConversion(
+                false, (enum LTC6813Conversion)conversion, 0U,
+                CELL_DIAGNOSTIC_OPEN_WIRE_PULL_UP));
+    }
+}
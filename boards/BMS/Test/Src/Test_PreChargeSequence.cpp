@@ -0,0 +1,271 @@
+#include <cmath>
+#include <deque>
+#include <random>
+#include "Test_Bms.h"
+
+extern "C"
+{
+#include "App_PreChargeSequence.h"
+}
+
+namespace PreChargeSequenceTest
+{
+FAKE_VOID_FUNC(enable_pre_charge);
+FAKE_VOID_FUNC(disable_pre_charge);
+FAKE_VALUE_FUNC(float, get_pack_voltage);
+
+static constexpr float SAMPLE_FREQUENCY_HZ = 1000.0f;
+static constexpr float PACK_VOLTAGE        = 400.0f;
+
+// The tractive system voltages sampled since the sequence last read them
+static std::deque<float> sampled_voltages;
+
+static size_t ReadFakeVoltages(float *voltages, size_t max_num_voltages)
+{
+    size_t num_voltages = 0U;
+    while (num_voltages < max_num_voltages && !sampled_voltages.empty())
+    {
+        voltages[num_voltages++] = sampled_voltages.front();
+        sampled_voltages.pop_front();
+    }
+    return num_voltages;
+}
+FAKE_VALUE_FUNC(size_t, read_tractive_system_voltages, float *, size_t);
+
+// The tractive system charging from the pack through the precharge resistor
+// once the precharge relay has closed, sampled with noise through the voltage
+// sense chain
+class TractiveSystemPlant
+{
+  public:
+    TractiveSystemPlant(
+        float time_constant,
+        float initial_voltage = 0.0f,
+        float voltage_noise   = 0.5f)
+      : time_constant(time_constant),
+        voltage(initial_voltage),
+        voltage_noise(voltage_noise)
+    {
+    }
+
+    // Sample the tractive system voltage for one 100Hz tick
+    void Tick(void)
+    {
+        std::normal_distribution<float> noise{ 0.0f, voltage_noise };
+        for (int i = 0; i < 10; i++)
+        {
+            if (t >= PRE_CHARGE_RELAY_CLOSE_TIME_S / 2.0f &&
+                std::isfinite(time_constant))
+            {
+                voltage +=
+                    (PACK_VOLTAGE - voltage) *
+                    (1.0f -
+                     std::exp(-1.0f / (SAMPLE_FREQUENCY_HZ * time_constant)));
+            }
+            t += 1.0f / SAMPLE_FREQUENCY_HZ;
+            sampled_voltages.push_back(voltage + noise(random_engine));
+        }
+    }
+
+    // The time the plant has run for (s)
+    float t = 0.0f;
+
+  private:
+    float        time_constant;
+    float        voltage;
+    float        voltage_noise;
+    std::mt19937 random_engine{ 40 };
+};
+
+class PreChargeSequenceTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        pre_charge_sequence = App_PreChargeSequence_Create(
+            enable_pre_charge, disable_pre_charge,
+            read_tractive_system_voltages, get_pack_voltage,
+            SAMPLE_FREQUENCY_HZ);
+
+        RESET_FAKE(enable_pre_charge);
+        RESET_FAKE(disable_pre_charge);
+        RESET_FAKE(get_pack_voltage);
+        RESET_FAKE(read_tractive_system_voltages);
+
+        sampled_voltages.clear();
+        get_pack_voltage_fake.return_val               = PACK_VOLTAGE;
+        read_tractive_system_voltages_fake.custom_fake = ReadFakeVoltages;
+    }
+
+    void TearDown() override
+    {
+        TearDownObject(pre_charge_sequence, App_PreChargeSequence_Destroy);
+    }
+
+    // Enable the pre-charge sequence, then tick it with the given plant until
+    // it has finished, or for at most the given time (s)
+    enum PreChargeSequenceStatus
+        RunPreCharge(TractiveSystemPlant &plant, float max_time = 10.0f)
+    {
+        App_PreChargeSequence_Enable(pre_charge_sequence);
+
+        enum PreChargeSequenceStatus status = PRE_CHARGE_SEQUENCE_IN_PROGRESS;
+        while (status == PRE_CHARGE_SEQUENCE_IN_PROGRESS && plant.t < max_time)
+        {
+            plant.Tick();
+            status = App_PreChargeSequence_Tick100Hz(pre_charge_sequence);
+        }
+        return status;
+    }
+
+    struct PreChargeSequence *pre_charge_sequence;
+};
+
+TEST_F(PreChargeSequenceTest, completes_as_soon_as_voltage_reaches_threshold)
+{
+    TractiveSystemPlant plant{ NOMINAL_PRE_CHARGE_TIME_CONSTANT_S };
+
+    ASSERT_EQ(PRE_CHARGE_SEQUENCE_COMPLETE, RunPreCharge(plant));
+    ASSERT_EQ(1U, enable_pre_charge_fake.call_count);
+
+    // The sequence completes within a couple of ticks of the voltage crossing
+    // the threshold, instead of after a fixed time with margin for the slowest
+    // plausible charging curve
+    const float completion_time =
+        PRE_CHARGE_RELAY_CLOSE_TIME_S / 2.0f -
+        NOMINAL_PRE_CHARGE_TIME_CONSTANT_S *
+            std::log(1.0f - PRE_CHARGE_COMPLETE_VOLTAGE_RATIO);
+    ASSERT_NEAR(completion_time, plant.t, 0.02f);
+    ASSERT_NEAR(
+        NOMINAL_PRE_CHARGE_TIME_CONSTANT_S,
+        App_PreChargeSequence_GetTimeConstant(pre_charge_sequence),
+        0.02f * NOMINAL_PRE_CHARGE_TIME_CONSTANT_S);
+}
+
+TEST_F(PreChargeSequenceTest, completes_with_every_plausible_time_constant)
+{
+    for (const float time_constant : { 1.05f * MIN_PRE_CHARGE_TIME_CONSTANT_S,
+                                       0.95f * MAX_PRE_CHARGE_TIME_CONSTANT_S })
+    {
+        TractiveSystemPlant plant{ time_constant };
+        ASSERT_EQ(PRE_CHARGE_SEQUENCE_COMPLETE, RunPreCharge(plant));
+        ASSERT_NEAR(
+            time_constant,
+            App_PreChargeSequence_GetTimeConstant(pre_charge_sequence),
+            0.02f * time_constant);
+    }
+}
+
+TEST_F(PreChargeSequenceTest, fits_the_curve_from_a_partly_charged_voltage)
+{
+    // The tractive system hadn't fully discharged before precharging again
+    TractiveSystemPlant plant{ NOMINAL_PRE_CHARGE_TIME_CONSTANT_S,
+                               0.3f * PACK_VOLTAGE };
+
+    ASSERT_EQ(PRE_CHARGE_SEQUENCE_COMPLETE, RunPreCharge(plant));
+    ASSERT_NEAR(
+        NOMINAL_PRE_CHARGE_TIME_CONSTANT_S,
+        App_PreChargeSequence_GetTimeConstant(pre_charge_sequence),
+        0.02f * NOMINAL_PRE_CHARGE_TIME_CONSTANT_S);
+}
+
+TEST_F(PreChargeSequenceTest, completes_straight_away_if_already_charged)
+{
+    // The AIRs were closed again before the inverters' capacitance discharged
+    TractiveSystemPlant plant{
+        NOMINAL_PRE_CHARGE_TIME_CONSTANT_S,
+        PRE_CHARGE_COMPLETE_VOLTAGE_RATIO * PACK_VOLTAGE + 2.0f
+    };
+
+    ASSERT_EQ(PRE_CHARGE_SEQUENCE_ALREADY_CHARGED, RunPreCharge(plant));
+    ASSERT_LE(plant.t, 0.01f + 1e-6f);
+
+    // A tractive system that is partly charged below the threshold is
+    // precharged along its curve instead
+    TractiveSystemPlant partly_charged_plant{
+        NOMINAL_PRE_CHARGE_TIME_CONSTANT_S,
+        (PRE_CHARGE_COMPLETE_VOLTAGE_RATIO - 0.2f) * PACK_VOLTAGE
+    };
+    ASSERT_EQ(PRE_CHARGE_SEQUENCE_COMPLETE, RunPreCharge(partly_charged_plant));
+}
+
+TEST_F(PreChargeSequenceTest, shorted_precharge_resistor_fails)
+{
+    // The voltage jumps to the pack voltage faster than the curve can be fit
+    TractiveSystemPlant shorted_plant{ 0.005f };
+    ASSERT_EQ(
+        PRE_CHARGE_SEQUENCE_TIME_CONSTANT_TOO_SHORT,
+        RunPreCharge(shorted_plant));
+    ASSERT_LE(shorted_plant.t, 0.05f);
+
+    // A partly shorted precharge resistor is caught by the fit before the
+    // voltage reaches the threshold
+    TractiveSystemPlant partly_shorted_plant{ 0.5f *
+                                              MIN_PRE_CHARGE_TIME_CONSTANT_S };
+    ASSERT_EQ(
+        PRE_CHARGE_SEQUENCE_TIME_CONSTANT_TOO_SHORT,
+        RunPreCharge(partly_shorted_plant));
+    ASSERT_LT(
+        partly_shorted_plant.t,
+        -0.5f * MIN_PRE_CHARGE_TIME_CONSTANT_S *
+            std::log(1.0f - PRE_CHARGE_COMPLETE_VOLTAGE_RATIO));
+}
+
+TEST_F(PreChargeSequenceTest, open_precharge_resistor_fails_early)
+{
+    // The voltage never starts rising, which is caught long before the slowest
+    // plausible charging curve would have completed
+    TractiveSystemPlant open_plant{ INFINITY };
+    ASSERT_EQ(
+        PRE_CHARGE_SEQUENCE_TIME_CONSTANT_TOO_LONG, RunPreCharge(open_plant));
+    ASSERT_LT(open_plant.t, 0.1f);
+
+    // A partly open precharge resistor is caught by the fit before the
+    // voltage reaches the threshold
+    TractiveSystemPlant partly_open_plant{ 2.0f *
+                                           MAX_PRE_CHARGE_TIME_CONSTANT_S };
+    ASSERT_EQ(
+        PRE_CHARGE_SEQUENCE_TIME_CONSTANT_TOO_LONG,
+        RunPreCharge(partly_open_plant));
+    ASSERT_LT(partly_open_plant.t, 0.5f);
+}
+
+TEST_F(PreChargeSequenceTest, fails_once_voltage_stops_being_sampled)
+{
+    App_PreChargeSequence_Enable(pre_charge_sequence);
+
+    enum PreChargeSequenceStatus status    = PRE_CHARGE_SEQUENCE_IN_PROGRESS;
+    int                          num_ticks = 0;
+    while (status == PRE_CHARGE_SEQUENCE_IN_PROGRESS && num_ticks < 1000)
+    {
+        status = App_PreChargeSequence_Tick100Hz(pre_charge_sequence);
+        num_ticks++;
+    }
+
+    ASSERT_EQ(PRE_CHARGE_SEQUENCE_TIME_CONSTANT_TOO_LONG, status);
+    ASSERT_LT(num_ticks, 1000);
+}
+
+TEST_F(PreChargeSequenceTest, enabling_again_restarts_the_fit)
+{
+    TractiveSystemPlant open_plant{ INFINITY };
+    ASSERT_EQ(
+        PRE_CHARGE_SEQUENCE_TIME_CONSTANT_TOO_LONG, RunPreCharge(open_plant));
+
+    // The status sticks until the sequence is enabled again, and the voltages
+    // sampled in between are dropped
+    open_plant.Tick();
+    ASSERT_EQ(
+        PRE_CHARGE_SEQUENCE_TIME_CONSTANT_TOO_LONG,
+        App_PreChargeSequence_Tick100Hz(pre_charge_sequence));
+    ASSERT_FALSE(sampled_voltages.empty());
+
+    App_PreChargeSequence_Disable(pre_charge_sequence);
+    ASSERT_EQ(1U, disable_pre_charge_fake.call_count);
+
+    TractiveSystemPlant plant{ NOMINAL_PRE_CHARGE_TIME_CONSTANT_S };
+    ASSERT_EQ(PRE_CHARGE_SEQUENCE_COMPLETE, RunPreCharge(plant));
+    ASSERT_EQ(2U, enable_pre_charge_fake.call_count);
+}
+
+} // namespace PreChargeSequenceTest
@@ -0,0 +1,414 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include "Test_Bms.h"
+
+extern "C"
+{
+#include "App_OpenCircuitVoltage.h"
+#include "App_SocEkf.h"
+#include "App_SocEstimator.h"
+#include "configs/App_SocConfigs.h"
+}
+
+namespace SocEstimatorTest
+{
+FAKE_VALUE_FUNC(float, get_and_clear_charge);
+FAKE_VALUE_FUNC(const struct CellStatistics *, get_cell_statistics);
+FAKE_VALUE_FUNC(ExitCode, read_persisted_soc, float *);
+FAKE_VALUE_FUNC(ExitCode, write_persisted_soc, float);
+
+static float fake_persisted_soc;
+
+static ExitCode ReadFakePersistedSoc(float *soc)
+{
+    *soc = fake_persisted_soc;
+    return EXIT_CODE_OK;
+}
+
+static constexpr float COULOMBS_PER_PERCENT =
+    CELL_GROUP_CAPACITY_AH * 3600.0f / 100.0f;
+
+class SocEstimatorTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        soc_estimator = App_SocEstimator_Create(
+            get_and_clear_charge, get_cell_statistics, read_persisted_soc,
+            write_persisted_soc);
+
+        RESET_FAKE(get_and_clear_charge);
+        RESET_FAKE(get_cell_statistics);
+        RESET_FAKE(read_persisted_soc);
+        RESET_FAKE(write_persisted_soc);
+
+        statistics                          = {};
+        get_cell_statistics_fake.return_val = &statistics;
+        read_persisted_soc_fake.return_val  = EXIT_CODE_ERROR;
+        SetMeanCellVoltage(App_OpenCircuitVoltage_GetCellVoltage(50.0f));
+    }
+
+    void TearDown() override
+    {
+        TearDownObject(soc_estimator, App_SocEstimator_Destroy);
+    }
+
+    void SetMeanCellVoltage(float voltage)
+    {
+        statistics.mean = (uint16_t)std::lround(voltage * 1e4f);
+    }
+
+    void Tick(uint32_t num_ticks, bool has_read_cell_voltages = true)
+    {
+        for (uint32_t i = 0; i < num_ticks; i++)
+        {
+            App_SocEstimator_Tick100Hz(soc_estimator, has_read_cell_voltages);
+        }
+    }
+
+    struct SocEstimator * soc_estimator;
+    struct CellStatistics statistics;
+};
+
+TEST(OpenCircuitVoltageTest, soc_lookup_inverts_voltage_lookup)
+{
+    for (float soc = 0.0f; soc <= 100.0f; soc += 0.5f)
+    {
+        ASSERT_NEAR(
+            soc,
+            App_OpenCircuitVoltage_GetSoc(
+                App_OpenCircuitVoltage_GetCellVoltage(soc)),
+            1e-3f);
+        ASSERT_GT(App_OpenCircuitVoltage_GetSlope(soc), 0.0f);
+    }
+
+    ASSERT_EQ(3.0f, App_OpenCircuitVoltage_GetCellVoltage(-1.0f));
+    ASSERT_EQ(4.2f, App_OpenCircuitVoltage_GetCellVoltage(101.0f));
+    ASSERT_EQ(0.0f, App_OpenCircuitVoltage_GetSoc(2.5f));
+    ASSERT_EQ(100.0f, App_OpenCircuitVoltage_GetSoc(4.3f));
+}
+
+TEST(SocEkfTest, converges_from_wrong_initial_soc)
+{
+    struct SocEkf *soc_ekf = App_SocEkf_Create(
+        CELL_GROUP_CAPACITY_AH, CELL_GROUP_SERIES_RESISTANCE_OHMS,
+        CELL_GROUP_POLARIZATION_RESISTANCE_OHMS,
+        CELL_GROUP_POLARIZATION_CAPACITANCE_F, SOC_TICK_PERIOD_S,
+        SOC_EKF_SOC_PROCESS_NOISE, SOC_EKF_POLARIZATION_PROCESS_NOISE,
+        SOC_EKF_MEASUREMENT_NOISE, SOC_EKF_INITIAL_SOC_VARIANCE);
+    App_SocEkf_SetSoc(soc_ekf, 40.0f);
+
+    // The cell group is really at 70%, and is discharged at 10A for two
+    // minutes
+    const float decay = std::exp(
+        -SOC_TICK_PERIOD_S / (CELL_GROUP_POLARIZATION_RESISTANCE_OHMS *
+                              CELL_GROUP_POLARIZATION_CAPACITANCE_F));
+    float soc                  = 70.0f;
+    float polarization_voltage = 0.0f;
+    for (int tick = 0; tick < 12000; tick++)
+    {
+        soc -= 10.0f * SOC_TICK_PERIOD_S / COULOMBS_PER_PERCENT;
+        polarization_voltage =
+            decay * polarization_voltage +
+            (1.0f - decay) * CELL_GROUP_POLARIZATION_RESISTANCE_OHMS * 10.0f;
+
+        App_SocEkf_Predict(soc_ekf, 10.0f);
+        App_SocEkf_Correct(
+            soc_ekf, 10.0f,
+            App_OpenCircuitVoltage_GetCellVoltage(soc) - polarization_voltage -
+                10.0f * CELL_GROUP_SERIES_RESISTANCE_OHMS);
+    }
+
+    ASSERT_NEAR(soc, App_SocEkf_GetSoc(soc_ekf), 1.0f);
+    App_SocEkf_Destroy(soc_ekf);
+}
+
+TEST_F(SocEstimatorTest, initializes_from_open_circuit_voltage_on_first_read)
+{
+    Tick(10, false);
+    ASSERT_FALSE(App_SocEstimator_IsInitialized(soc_estimator));
+    ASSERT_EQ(0, read_persisted_soc_fake.call_count);
+
+    Tick(1);
+    ASSERT_TRUE(App_SocEstimator_IsInitialized(soc_estimator));
+    ASSERT_NEAR(50.0f, App_SocEstimator_GetSoc(soc_estimator), 1e-2f);
+    ASSERT_NEAR(
+        50.0f, App_SocEstimator_GetCoulombCountingSoc(soc_estimator), 1e-2f);
+    ASSERT_NEAR(50.0f, App_SocEstimator_GetEkfSoc(soc_estimator), 1e-2f);
+    ASSERT_NEAR(50.0f, App_SocEstimator_GetOcvSoc(soc_estimator), 1e-2f);
+}
+
+TEST_F(SocEstimatorTest, initializes_from_persisted_soc)
+{
+    fake_persisted_soc                  = 55.0f;
+    read_persisted_soc_fake.custom_fake = ReadFakePersistedSoc;
+
+    Tick(1);
+    ASSERT_EQ(55.0f, App_SocEstimator_GetSoc(soc_estimator));
+    ASSERT_EQ(55.0f, App_SocEstimator_GetCoulombCountingSoc(soc_estimator));
+    ASSERT_NEAR(50.0f, App_SocEstimator_GetOcvSoc(soc_estimator), 1e-2f);
+
+    // Nothing is persisted until the SoC moves far enough
+    App_SocEstimator_Tick1Hz(soc_estimator);
+    ASSERT_EQ(0, write_persisted_soc_fake.call_count);
+}
+
+TEST_F(SocEstimatorTest, ignores_persisted_soc_that_disagrees_with_rest_voltage)
+{
+    // The accumulator was charged while the BMS was off
+    fake_persisted_soc                  = 50.0f - SOC_MAX_ABS_DIFFERENCE - 0.1f;
+    read_persisted_soc_fake.custom_fake = ReadFakePersistedSoc;
+
+    Tick(1);
+    ASSERT_NEAR(50.0f, App_SocEstimator_GetSoc(soc_estimator), 1e-2f);
+    ASSERT_NEAR(
+        50.0f, App_SocEstimator_GetCoulombCountingSoc(soc_estimator), 1e-2f);
+}
+
+TEST_F(SocEstimatorTest, coulomb_counting_is_re_anchored_at_rest)
+{
+    Tick(1);
+
+    // Discharge 10% without the cell voltages being read
+    get_and_clear_charge_fake.return_val = COULOMBS_PER_PERCENT / 100.0f;
+    Tick(1000, false);
+    ASSERT_NEAR(
+        40.0f, App_SocEstimator_GetCoulombCountingSoc(soc_estimator), 1e-2f);
+
+    App_SocEstimator_Tick1Hz(soc_estimator);
+    ASSERT_EQ(1, write_persisted_soc_fake.call_count);
+
+    // The cells recover to 42% SoC at rest, which coulomb counting is anchored
+    // to once the accumulator has been at rest for long enough
+    get_and_clear_charge_fake.return_val = 0.0f;
+    SetMeanCellVoltage(App_OpenCircuitVoltage_GetCellVoltage(42.0f));
+    Tick(SOC_REST_TICKS - 1U);
+    ASSERT_NEAR(
+        40.0f, App_SocEstimator_GetCoulombCountingSoc(soc_estimator), 1e-2f);
+    ASSERT_NEAR(50.0f, App_SocEstimator_GetOcvSoc(soc_estimator), 1e-2f);
+
+    Tick(1);
+    ASSERT_NEAR(
+        42.0f, App_SocEstimator_GetCoulombCountingSoc(soc_estimator), 1e-2f);
+    ASSERT_NEAR(42.0f, App_SocEstimator_GetOcvSoc(soc_estimator), 1e-2f);
+    ASSERT_NEAR(42.0f, App_SocEstimator_GetSoc(soc_estimator), 0.5f);
+}
+
+TEST_F(SocEstimatorTest, soc_is_clamped_to_valid_range)
+{
+    SetMeanCellVoltage(App_OpenCircuitVoltage_GetCellVoltage(1.0f));
+    Tick(1);
+
+    get_and_clear_charge_fake.return_val = 10.0f * COULOMBS_PER_PERCENT;
+    Tick(1);
+    ASSERT_EQ(0.0f, App_SocEstimator_GetCoulombCountingSoc(soc_estimator));
+    ASSERT_GE(App_SocEstimator_GetSoc(soc_estimator), 0.0f);
+
+    get_and_clear_charge_fake.return_val = -200.0f * COULOMBS_PER_PERCENT;
+    Tick(1);
+    ASSERT_EQ(100.0f, App_SocEstimator_GetCoulombCountingSoc(soc_estimator));
+    ASSERT_LE(App_SocEstimator_GetSoc(soc_estimator), 100.0f);
+}
+
+// A cell group whose parameters are off from the ones the estimators model,
+// measured through a current sensor with an offset and noise, and cell voltage
+// measurements with noise
+class CellGroupSimulation
+{
+  public:
+    explicit CellGroupSimulation(float initial_soc) : soc(initial_soc) {}
+
+    // Step the cell group by one tick with the given current, and get the
+    // charge measured by the current sensor
+    float Step(float current_a)
+    {
+        soc -= current_a * SOC_TICK_PERIOD_S / TRUE_COULOMBS_PER_PERCENT;
+        const float decay = std::exp(
+            -SOC_TICK_PERIOD_S / (TRUE_POLARIZATION_RESISTANCE_OHMS *
+                                  TRUE_POLARIZATION_CAPACITANCE_F));
+        polarization_voltage =
+            decay * polarization_voltage +
+            (1.0f - decay) * TRUE_POLARIZATION_RESISTANCE_OHMS * current_a;
+        voltage = App_OpenCircuitVoltage_GetCellVoltage(soc) -
+                  polarization_voltage -
+                  TRUE_SERIES_RESISTANCE_OHMS * current_a +
+                  voltage_noise(random_engine);
+
+        return (current_a + CURRENT_SENSOR_OFFSET_A +
+                current_noise(random_engine)) *
+               SOC_TICK_PERIOD_S;
+    }
+
+    float GetSoc() const { return soc; }
+    float GetVoltage() const { return voltage; }
+
+  private:
+    static constexpr float TRUE_COULOMBS_PER_PERCENT =
+        0.97f * COULOMBS_PER_PERCENT;
+    static constexpr float TRUE_SERIES_RESISTANCE_OHMS =
+        1.2f * CELL_GROUP_SERIES_RESISTANCE_OHMS;
+    static constexpr float TRUE_POLARIZATION_RESISTANCE_OHMS =
+        0.8f * CELL_GROUP_POLARIZATION_RESISTANCE_OHMS;
+    static constexpr float TRUE_POLARIZATION_CAPACITANCE_F =
+        1.5f * CELL_GROUP_POLARIZATION_CAPACITANCE_F;
+    static constexpr float CURRENT_SENSOR_OFFSET_A = 0.3f;
+
+    float                           soc;
+    float                           polarization_voltage = 0.0f;
+    float                           voltage              = 0.0f;
+    std::mt19937                    random_engine{ 37 };
+    std::normal_distribution<float> current_noise{ 0.0f, 1.0f };
+    std::normal_distribution<float> voltage_noise{ 0.0f, 2e-3f };
+};
+
+// The current drawn from each cell group on one lap of an endurance event, in A
+// per second of the lap: accelerating, cruising, braking with regen, and
+// coasting
+static std::vector<float> GetLapCurrentProfile()
+{
+    std::vector<float> profile;
+    for (int corner = 0; corner < 4; corner++)
+    {
+        profile.insert(profile.end(), 4, 40.0f);
+        profile.insert(profile.end(), 8, 12.0f);
+        profile.insert(profile.end(), 3, -15.0f);
+        profile.insert(profile.end(), 5, 0.5f);
+    }
+    return profile;
+}
+
+struct ReplayResult
+{
+    float     max_abs_error[4];
+    float     rms_error[4];
+    long long mean_ns_per_tick;
+    long long max_ns_per_tick;
+};
+
+static CellGroupSimulation *simulation;
+static float                charge_c;
+
+static float GetAndClearSimulatedCharge()
+{
+    return charge_c;
+}
+
+// Replay the given current profile, in A per second, through a simulated cell
+// group and the SoC estimator, and get the error of every estimate after the
+// given number of ticks have passed
+static ReplayResult ReplayCurrentProfile(
+    struct SocEstimator *     soc_estimator,
+    struct CellStatistics &   statistics,
+    const std::vector<float> &profile,
+    uint32_t                  num_ticks_to_skip)
+{
+    ReplayResult result                = {};
+    double       sum_squared_errors[4] = { 0.0 };
+    long long    sum_ns                = 0;
+    uint32_t     num_ticks             = 0;
+
+    for (size_t second = 0; second < profile.size(); second++)
+    {
+        for (uint32_t i = 0; i < 100U; i++)
+        {
+            charge_c = simulation->Step(profile[second]);
+            statistics.mean =
+                (uint16_t)std::lround(simulation->GetVoltage() * 1e4f);
+
+            const auto start = std::chrono::steady_clock::now();
+            App_SocEstimator_Tick100Hz(soc_estimator, true);
+            const long long ns =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+            sum_ns += ns;
+            result.max_ns_per_tick = std::max(result.max_ns_per_tick, ns);
+
+            if (++num_ticks <= num_ticks_to_skip)
+            {
+                continue;
+            }
+
+            const float estimates[4] = {
+                App_SocEstimator_GetCoulombCountingSoc(soc_estimator),
+                App_SocEstimator_GetEkfSoc(soc_estimator),
+                App_SocEstimator_GetOcvSoc(soc_estimator),
+                App_SocEstimator_GetSoc(soc_estimator),
+            };
+            for (size_t estimate = 0; estimate < 4; estimate++)
+            {
+                const float error =
+                    std::fabs(estimates[estimate] - simulation->GetSoc());
+                result.max_abs_error[estimate] =
+                    std::max(result.max_abs_error[estimate], error);
+                sum_squared_errors[estimate] += (double)error * error;
+            }
+        }
+    }
+
+    for (size_t estimate = 0; estimate < 4; estimate++)
+    {
+        result.rms_error[estimate] = (float)std::sqrt(
+            sum_squared_errors[estimate] / (num_ticks - num_ticks_to_skip));
+    }
+    result.mean_ns_per_tick = sum_ns / num_ticks;
+
+    return result;
+}
+
+TEST_F(SocEstimatorTest, replay_endurance_profile)
+{
+    // The BMS starts up at rest, but the persisted SoC is 3% off from the
+    // cell group's true SoC
+    CellGroupSimulation cell_group(90.0f);
+    simulation                            = &cell_group;
+    charge_c                              = 0.0f;
+    get_and_clear_charge_fake.custom_fake = GetAndClearSimulatedCharge;
+    fake_persisted_soc                    = 87.0f;
+    read_persisted_soc_fake.custom_fake   = ReadFakePersistedSoc;
+
+    // A minute at rest before driving off, 10 laps of driving, and 10 minutes
+    // at rest
+    std::vector<float>       profile(60, 0.0f);
+    const std::vector<float> lap = GetLapCurrentProfile();
+    for (int i = 0; i < 10; i++)
+    {
+        profile.insert(profile.end(), lap.begin(), lap.end());
+    }
+    profile.insert(profile.end(), 10 * 60, 0.0f);
+
+    // Skip the first minute, for the EKF to converge from the wrong SoC
+    // before driving off
+    const ReplayResult result =
+        ReplayCurrentProfile(soc_estimator, statistics, profile, 60U * 100U);
+
+    const char *names[4] = { "coulomb_counting", "ekf", "ocv", "voted" };
+    for (size_t estimate = 0; estimate < 4; estimate++)
+    {
+        RecordProperty(
+            std::string(names[estimate]) + "_max_abs_error_milli_percent",
+            (int)(result.max_abs_error[estimate] * 1000.0f));
+        RecordProperty(
+            std::string(names[estimate]) + "_rms_error_milli_percent",
+            (int)(result.rms_error[estimate] * 1000.0f));
+        printf(
+            "%s SoC: max error %.2f%%, RMS error %.2f%%\n", names[estimate],
+            result.max_abs_error[estimate], result.rms_error[estimate]);
+    }
+    RecordProperty("mean_ns_per_tick", (int)result.mean_ns_per_tick);
+    RecordProperty("max_ns_per_tick", (int)result.max_ns_per_tick);
+    printf(
+        "SoC estimator tick: %lld ns mean, %lld ns max, final SoC %.1f%%\n",
+        result.mean_ns_per_tick, result.max_ns_per_tick, cell_group.GetSoc());
+
+    // The EKF corrects the wrong persisted SoC and the capacity error, which
+    // coulomb counting alone can't
+    ASSERT_LT(result.max_abs_error[1], 2.0f);
+    ASSERT_LT(result.rms_error[3], 2.0f);
+    ASSERT_LT(result.max_abs_error[1], result.max_abs_error[0]);
+}
+} // namespace SocEstimatorTest
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <deque>
 #include <math.h>
 #include "Test_Bms.h"
 #include "Test_Imd.h"
@@ -18,6 +20,10 @@ extern "C"
 #include "configs/App_AccumulatorConfigs.h"
 #include "configs/App_AccumulatorThresholds.h"
 #include "configs/App_CellMonitorsThresholds.h"
+#include "configs/App_CellBalancingConfigs.h"
+#include "configs/App_CellDiagnosticsConfigs.h"
+#include "configs/App_AvailablePowerConfigs.h"
+#include "configs/App_PreChargeSequenceConfigs.h"
 }
 
 namespace StateMachineTest
@@ -57,28 +63,118 @@ FAKE_VALUE_FUNC(float, get_min_cell_voltage);
 FAKE_VALUE_FUNC(float, get_max_cell_voltage);
 FAKE_VALUE_FUNC(float, get_average_cell_voltage);
 FAKE_VALUE_FUNC(float, get_pack_voltage);
-FAKE_VALUE_FUNC(float, get_segment_0_voltage);
-FAKE_VALUE_FUNC(float, get_segment_1_voltage);
-FAKE_VALUE_FUNC(float, get_segment_2_voltage);
-FAKE_VALUE_FUNC(float, get_segment_3_voltage);
-FAKE_VALUE_FUNC(float, get_segment_4_voltage);
-FAKE_VALUE_FUNC(float, get_segment_5_voltage);
+FAKE_VALUE_FUNC(float, get_segment_voltage, size_t);
 FAKE_VALUE_FUNC(bool, is_air_negative_closed);
 FAKE_VALUE_FUNC(bool, is_air_positive_closed);
 FAKE_VALUE_FUNC(ExitCode, read_die_temperatures);
-FAKE_VALUE_FUNC(float, get_segment_0_die_temp);
-FAKE_VALUE_FUNC(float, get_segment_1_die_temp);
-FAKE_VALUE_FUNC(float, get_segment_2_die_temp);
-FAKE_VALUE_FUNC(float, get_segment_3_die_temp);
-FAKE_VALUE_FUNC(float, get_segment_4_die_temp);
-FAKE_VALUE_FUNC(float, get_segment_5_die_temp);
+FAKE_VALUE_FUNC(float, get_die_temp, size_t);
 FAKE_VALUE_FUNC(float, get_max_die_temp);
+FAKE_VALUE_FUNC(ExitCode, write_discharge_cells, const uint32_t *);
+FAKE_VALUE_FUNC(const struct CellStatistics *, get_cell_statistics);
+FAKE_VALUE_FUNC(float, get_and_clear_charge);
+FAKE_VALUE_FUNC(ExitCode, read_persisted_soc, float *);
+FAKE_VALUE_FUNC(ExitCode, write_persisted_soc, float);
+typedef uint16_t (*DiagnosticVoltages)[NUM_OF_CELLS_PER_SEGMENT];
+FAKE_VALUE_FUNC(
+    ExitCode,
+    read_cell_diagnostic,
+    enum CellDiagnostic,
+    DiagnosticVoltages);
+FAKE_VALUE_FUNC(float, get_main_current);
+FAKE_VALUE_FUNC(ExitCode, read_cell_temperatures);
+FAKE_VALUE_FUNC(int32_t, get_min_cell_temperature);
+FAKE_VALUE_FUNC(int32_t, get_max_cell_temperature);
 FAKE_VALUE_FUNC(bool, is_air_negative_on);
 FAKE_VALUE_FUNC(bool, is_air_positive_on);
 FAKE_VOID_FUNC(open_air_positive);
 FAKE_VOID_FUNC(close_air_positive);
 FAKE_VOID_FUNC(enable_pre_charge);
 FAKE_VOID_FUNC(disable_pre_charge);
+FAKE_VALUE_FUNC(size_t, read_tractive_system_voltages, float *, size_t);
+
+// The tractive system charging through the precharge resistor while the
+// precharge relay is closed, and the voltages sampled from it every 1ms since
+// the pre-charge sequence last read them
+static bool              is_fake_pre_charge_enabled;
+static float             fake_pre_charge_time_constant;
+static float             fake_tractive_system_voltage;
+static std::deque<float> fake_tractive_system_voltages;
+
+static void EnableFakePreCharge(void)
+{
+    is_fake_pre_charge_enabled = true;
+}
+
+static void DisableFakePreCharge(void)
+{
+    is_fake_pre_charge_enabled = false;
+}
+
+static size_t ReadFakeTractiveSystemVoltages(float *voltages, size_t max_num)
+{
+    size_t num_voltages = 0U;
+    while (num_voltages < max_num && !fake_tractive_system_voltages.empty())
+    {
+        voltages[num_voltages++] = fake_tractive_system_voltages.front();
+        fake_tractive_system_voltages.pop_front();
+    }
+    return num_voltages;
+}
+
+// The values returned for each segment and chip by the indexed fakes
+static float fake_segment_voltages[NUM_OF_ACCUMULATOR_SEGMENTS];
+static float fake_die_temps[NUM_OF_CELL_MONITOR_CHIPS];
+
+// The statistics of the cell voltages picked from by the cell balancing
+// scheduler, and the last discharge switches it wrote
+static struct CellStatistics fake_cell_statistics;
+static uint32_t              written_discharge_cells[NUM_OF_CELL_MONITOR_CHIPS];
+
+static ExitCode RecordDischargeCells(const uint32_t *discharge_cells)
+{
+    std::copy(
+        discharge_cells, discharge_cells + NUM_OF_CELL_MONITOR_CHIPS,
+        written_discharge_cells);
+    return EXIT_CODE_OK;
+}
+
+// The SoC returned by the persisted SoC fake
+static float fake_persisted_soc;
+
+static ExitCode ReadFakePersistedSoc(float *soc)
+{
+    *soc = fake_persisted_soc;
+    return EXIT_CODE_OK;
+}
+
+// Every diagnostic result reads 4.0V on every cell, except that the pull-up
+// result of this cell reads low when the pin below it is open
+static size_t fake_open_wire_cell;
+
+static ExitCode ReadFakeCellDiagnostic(
+    enum CellDiagnostic diagnostic,
+    DiagnosticVoltages  voltages)
+{
+    for (size_t chip = 0U; chip < NUM_OF_CELL_MONITOR_CHIPS; chip++)
+    {
+        std::fill_n(voltages[chip], NUM_OF_CELLS_PER_SEGMENT, 40000U);
+    }
+    if (diagnostic == CELL_DIAGNOSTIC_OPEN_WIRE_PULL_UP)
+    {
+        voltages[0][fake_open_wire_cell] = 35000U;
+    }
+    return EXIT_CODE_OK;
+}
+
+static float GetFakeSegmentVoltage(size_t segment)
+{
+    return fake_segment_voltages[segment];
+}
+
+static float GetFakeDieTemp(size_t chip)
+{
+    return fake_die_temps[chip];
+}
 
 class BmsStateMachineTest : public BaseStateMachineTest
 {
@@ -119,23 +215,38 @@ class BmsStateMachineTest : public BaseStateMachineTest
         accumulator = App_Accumulator_Create(
             configure_daisy_chain, read_cell_voltages, get_min_cell_voltage,
             get_max_cell_voltage, get_average_cell_voltage, get_pack_voltage,
-            get_segment_0_voltage, get_segment_1_voltage, get_segment_2_voltage,
-            get_segment_3_voltage, get_segment_4_voltage, get_segment_5_voltage,
-            MIN_CELL_VOLTAGE, MAX_CELL_VOLTAGE, MIN_SEGMENT_VOLTAGE,
-            MAX_SEGMENT_VOLTAGE, MIN_PACK_VOLTAGE, MAX_PACK_VOLTAGE);
+            get_segment_voltage, MIN_CELL_VOLTAGE, MAX_CELL_VOLTAGE,
+            MIN_SEGMENT_VOLTAGE, MAX_SEGMENT_VOLTAGE, MIN_PACK_VOLTAGE,
+            MAX_PACK_VOLTAGE);
 
         cell_monitors = App_CellMonitors_Create(
-            read_die_temperatures, get_segment_0_die_temp,
-            get_segment_1_die_temp, get_segment_2_die_temp,
-            get_segment_3_die_temp, get_segment_4_die_temp,
-            get_segment_5_die_temp, get_max_die_temp, MIN_ITMP_DEGC,
-            MAX_ITMP_DEGC, DIE_TEMP_TO_REENABLE_CHARGER_DEGC,
+            read_die_temperatures, get_die_temp, get_max_die_temp,
+            MIN_ITMP_DEGC, MAX_ITMP_DEGC, DIE_TEMP_TO_REENABLE_CHARGER_DEGC,
             DIE_TEMP_TO_REENABLE_CELL_BALANCING_DEGC,
             DIE_TEMP_TO_DISABLE_CELL_BALANCING_DEGC,
             DIE_TEMP_TO_DISABLE_CHARGER_DEGC);
 
-        pre_charge_sequence =
-            App_PreChargeSequence_Create(enable_pre_charge, disable_pre_charge);
+        cell_balancing = App_CellBalancing_Create(
+            write_discharge_cells, get_cell_statistics, get_max_die_temp,
+            BALANCING_THRESHOLD_100UV, DIE_TEMP_TO_THROTTLE_CELL_BALANCING_DEGC,
+            DIE_TEMP_TO_REENABLE_CELL_BALANCING_DEGC,
+            DIE_TEMP_TO_DISABLE_CELL_BALANCING_DEGC);
+
+        soc_estimator = App_SocEstimator_Create(
+            get_and_clear_charge, get_cell_statistics, read_persisted_soc,
+            write_persisted_soc);
+
+        cell_diagnostics = App_CellDiagnostics_Create(
+            read_cell_diagnostic, OPEN_WIRE_THRESHOLD_100UV,
+            ADC_OVERLAP_THRESHOLD_100UV, NUM_OF_CONSECUTIVE_DIAGNOSTIC_RESULTS);
+
+        available_power = App_AvailablePower_Create(
+            get_cell_statistics, get_main_current, read_cell_temperatures,
+            get_min_cell_temperature, get_max_cell_temperature);
+
+        pre_charge_sequence = App_PreChargeSequence_Create(
+            enable_pre_charge, disable_pre_charge,
+            read_tractive_system_voltages, get_pack_voltage, 1000.0f);
 
         airs = App_Airs_Create(
             is_air_positive_closed, is_air_negative_closed, close_air_positive,
@@ -148,7 +259,8 @@ class BmsStateMachineTest : public BaseStateMachineTest
         world = App_BmsWorld_Create(
             can_tx_interface, can_rx_interface, imd, heartbeat_monitor,
             rgb_led_sequence, charger, bms_ok, imd_ok, bspd_ok, accumulator,
-            cell_monitors, airs, pre_charge_sequence, error_table, clock);
+            cell_monitors, cell_balancing, soc_estimator, cell_diagnostics,
+            available_power, airs, pre_charge_sequence, error_table, clock);
 
         // Default to starting the state machine in the `init` state
         state_machine =
@@ -179,21 +291,25 @@ class BmsStateMachineTest : public BaseStateMachineTest
         RESET_FAKE(read_cell_voltages);
         RESET_FAKE(get_average_cell_voltage);
         RESET_FAKE(get_pack_voltage);
-        RESET_FAKE(get_segment_0_voltage);
-        RESET_FAKE(get_segment_1_voltage);
-        RESET_FAKE(get_segment_2_voltage);
-        RESET_FAKE(get_segment_3_voltage);
-        RESET_FAKE(get_segment_4_voltage);
-        RESET_FAKE(get_segment_5_voltage);
-        RESET_FAKE(get_segment_0_die_temp);
-        RESET_FAKE(get_segment_1_die_temp);
-        RESET_FAKE(get_segment_2_die_temp);
-        RESET_FAKE(get_segment_3_die_temp);
-        RESET_FAKE(get_segment_4_die_temp);
-        RESET_FAKE(get_segment_5_die_temp);
+        RESET_FAKE(get_segment_voltage);
+        RESET_FAKE(get_die_temp);
         RESET_FAKE(get_max_die_temp);
+        RESET_FAKE(write_discharge_cells);
+        RESET_FAKE(get_cell_statistics);
+        RESET_FAKE(get_and_clear_charge);
+        RESET_FAKE(read_persisted_soc);
+        RESET_FAKE(write_persisted_soc);
+        RESET_FAKE(read_cell_diagnostic);
+        RESET_FAKE(get_main_current);
+        RESET_FAKE(read_cell_temperatures);
+        RESET_FAKE(get_min_cell_temperature);
+        RESET_FAKE(get_max_cell_temperature);
         RESET_FAKE(is_air_negative_closed);
         RESET_FAKE(is_air_positive_closed);
+        RESET_FAKE(close_air_positive);
+        RESET_FAKE(enable_pre_charge);
+        RESET_FAKE(disable_pre_charge);
+        RESET_FAKE(read_tractive_system_voltages);
 
         // The charger is connected to prevent other tests from entering the
         // fault state from the charge state
@@ -203,10 +319,41 @@ class BmsStateMachineTest : public BaseStateMachineTest
         // tests from entering the fault state
         get_min_cell_voltage_fake.return_val = 4.0f;
         get_max_cell_voltage_fake.return_val = 4.0f;
+
+        // Every cell is at the same voltage, so no cell is balanced unless a
+        // test changes the statistics
+        fake_cell_statistics                   = {};
+        fake_cell_statistics.min               = 40000U;
+        fake_cell_statistics.max               = 40000U;
+        fake_cell_statistics.mean              = 40000U;
+        get_cell_statistics_fake.return_val    = &fake_cell_statistics;
+        write_discharge_cells_fake.custom_fake = RecordDischargeCells;
+
+        // No SoC has been persisted, unless a test persists one
+        read_persisted_soc_fake.return_val = EXIT_CODE_ERROR;
+
+        // No diagnostic result has arrived, unless a test provides them
+        read_cell_diagnostic_fake.return_val = EXIT_CODE_TIMEOUT;
+
+        // Every cell is at 25°C unless a test changes the cell temperatures
+        get_min_cell_temperature_fake.return_val = 250;
+        get_max_cell_temperature_fake.return_val = 250;
+
+        // The tractive system is discharged, and precharges with the nominal
+        // time constant once the precharge relay closes
+        enable_pre_charge_fake.custom_fake  = EnableFakePreCharge;
+        disable_pre_charge_fake.custom_fake = DisableFakePreCharge;
+        read_tractive_system_voltages_fake.custom_fake =
+            ReadFakeTractiveSystemVoltages;
+        is_fake_pre_charge_enabled    = false;
+        fake_pre_charge_time_constant = NOMINAL_PRE_CHARGE_TIME_CONSTANT_S;
+        fake_tractive_system_voltage  = 0.0f;
+        fake_tractive_system_voltages.clear();
     }
 
     void TearDown() override
     {
+        DumpTraceIfFailed(state_machine);
         TearDownObject(world, App_BmsWorld_Destroy);
         TearDownObject(state_machine, App_SharedStateMachine_Destroy);
         TearDownObject(can_tx_interface, App_CanTx_Destroy);
@@ -220,6 +367,10 @@ class BmsStateMachineTest : public BaseStateMachineTest
         TearDownObject(bspd_ok, App_OkStatus_Destroy);
         TearDownObject(accumulator, App_Accumulator_Destroy);
         TearDownObject(cell_monitors, App_CellMonitors_Destroy);
+        TearDownObject(cell_balancing, App_CellBalancing_Destroy);
+        TearDownObject(soc_estimator, App_SocEstimator_Destroy);
+        TearDownObject(cell_diagnostics, App_CellDiagnostics_Destroy);
+        TearDownObject(available_power, App_AvailablePower_Destroy);
         TearDownObject(airs, App_Airs_Destroy);
         TearDownObject(pre_charge_sequence, App_PreChargeSequence_Destroy);
         TearDownObject(error_table, App_SharedErrorTable_Destroy);
@@ -243,41 +394,6 @@ class BmsStateMachineTest : public BaseStateMachineTest
         };
     }
 
-    void CheckInRangeCanSignalsInGivenState(
-        const State *state,
-        float        min_value,
-        float        max_value,
-        float &      fake_value,
-        float (*value_can_signal_getter)(const struct BmsCanTxInterface *),
-        uint8_t (*out_of_range_can_signal_getter)(
-            const struct BmsCanTxInterface *),
-        uint8_t ok_choice,
-        uint8_t underflow_choice,
-        uint8_t overflow_choice)
-    {
-        SetInitialState(state);
-
-        // Normal range
-        fake_value = (min_value + max_value) / 2;
-        LetTimePass(state_machine, 1000);
-        ASSERT_EQ(fake_value, value_can_signal_getter(can_tx_interface));
-        ASSERT_EQ(ok_choice, out_of_range_can_signal_getter(can_tx_interface));
-
-        // Underflow range
-        fake_value =
-            std::nextafter(min_value, std::numeric_limits<float>::lowest());
-        LetTimePass(state_machine, 1000);
-        ASSERT_EQ(
-            underflow_choice, out_of_range_can_signal_getter(can_tx_interface));
-
-        // Overflow range
-        fake_value =
-            std::nextafter(max_value, std::numeric_limits<float>::max());
-        LetTimePass(state_machine, 1000);
-        ASSERT_EQ(
-            overflow_choice, out_of_range_can_signal_getter(can_tx_interface));
-    }
-
     void UpdateClock(
         struct StateMachine *state_machine,
         uint32_t             current_time_ms) override
@@ -291,9 +407,18 @@ class BmsStateMachineTest : public BaseStateMachineTest
         struct StateMachine *state_machine,
         uint32_t             current_time_ms) override
     {
-        // BMS doesn't use any signals currently
         UNUSED(state_machine);
         UNUSED(current_time_ms);
+
+        // Sample the tractive system voltage every 1ms, like ADC1 does
+        if (is_fake_pre_charge_enabled)
+        {
+            fake_tractive_system_voltage +=
+                (get_pack_voltage_fake.return_val -
+                 fake_tractive_system_voltage) *
+                (1.0f - expf(-1e-3f / fake_pre_charge_time_constant));
+        }
+        fake_tractive_system_voltages.push_back(fake_tractive_system_voltage);
     }
 
     struct World *            world;
@@ -309,6 +434,10 @@ class BmsStateMachineTest : public BaseStateMachineTest
     struct OkStatus *         bspd_ok;
     struct Accumulator *      accumulator;
     struct CellMonitors *     cell_monitors;
+    struct CellBalancing *    cell_balancing;
+    struct SocEstimator *     soc_estimator;
+    struct CellDiagnostics *  cell_diagnostics;
+    struct AvailablePower *   available_power;
     struct Airs *             airs;
     struct PreChargeSequence *pre_charge_sequence;
     struct ErrorTable *       error_table;
@@ -758,64 +887,232 @@ TEST_F(BmsStateMachineTest, charger_is_re_enabled_when_itmp_is_in_range)
 }
 
 // BMS-17
-TEST_F(BmsStateMachineTest, check_cell_monitors_can_signals_in_all_states)
-{
-    const State *charge_state = App_GetChargeState();
-
-    CheckInRangeCanSignalsInGivenState(
-        charge_state, MIN_ITMP_DEGC, MAX_ITMP_DEGC,
-        get_segment_0_die_temp_fake.return_val,
-        App_CanTx_GetPeriodicSignal_CELL_MONITOR_0_DIE_TEMPERATURE,
-        App_CanTx_GetPeriodicSignal_CELL_MONITOR_0_DIE_TEMP_OUT_OF_RANGE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_0_DIE_TEMP_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_0_DIE_TEMP_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_0_DIE_TEMP_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    CheckInRangeCanSignalsInGivenState(
-        charge_state, MIN_ITMP_DEGC, MAX_ITMP_DEGC,
-        get_segment_1_die_temp_fake.return_val,
-        App_CanTx_GetPeriodicSignal_CELL_MONITOR_1_DIE_TEMPERATURE,
-        App_CanTx_GetPeriodicSignal_CELL_MONITOR_1_DIE_TEMP_OUT_OF_RANGE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_1_DIE_TEMP_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_1_DIE_TEMP_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_1_DIE_TEMP_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    CheckInRangeCanSignalsInGivenState(
-        charge_state, MIN_ITMP_DEGC, MAX_ITMP_DEGC,
-        get_segment_2_die_temp_fake.return_val,
-        App_CanTx_GetPeriodicSignal_CELL_MONITOR_2_DIE_TEMPERATURE,
-        App_CanTx_GetPeriodicSignal_CELL_MONITOR_2_DIE_TEMP_OUT_OF_RANGE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_2_DIE_TEMP_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_2_DIE_TEMP_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_2_DIE_TEMP_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    CheckInRangeCanSignalsInGivenState(
-        charge_state, MIN_ITMP_DEGC, MAX_ITMP_DEGC,
-        get_segment_3_die_temp_fake.return_val,
-        App_CanTx_GetPeriodicSignal_CELL_MONITOR_3_DIE_TEMPERATURE,
-        App_CanTx_GetPeriodicSignal_CELL_MONITOR_3_DIE_TEMP_OUT_OF_RANGE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_3_DIE_TEMP_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_3_DIE_TEMP_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_3_DIE_TEMP_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    CheckInRangeCanSignalsInGivenState(
-        charge_state, MIN_ITMP_DEGC, MAX_ITMP_DEGC,
-        get_segment_4_die_temp_fake.return_val,
-        App_CanTx_GetPeriodicSignal_CELL_MONITOR_4_DIE_TEMPERATURE,
-        App_CanTx_GetPeriodicSignal_CELL_MONITOR_4_DIE_TEMP_OUT_OF_RANGE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_4_DIE_TEMP_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_4_DIE_TEMP_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_4_DIE_TEMP_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    CheckInRangeCanSignalsInGivenState(
-        charge_state, MIN_ITMP_DEGC, MAX_ITMP_DEGC,
-        get_segment_5_die_temp_fake.return_val,
-        App_CanTx_GetPeriodicSignal_CELL_MONITOR_5_DIE_TEMPERATURE,
-        App_CanTx_GetPeriodicSignal_CELL_MONITOR_5_DIE_TEMP_OUT_OF_RANGE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_5_DIE_TEMP_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_5_DIE_TEMP_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_BMS_NON_CRITICAL_ERRORS_CELL_MONITOR_5_DIE_TEMP_OUT_OF_RANGE_OVERFLOW_CHOICE);
+TEST_F(BmsStateMachineTest, check_cell_monitors_can_signals_in_charge_state)
+{
+    SetInitialState(App_GetChargeState());
+
+    get_die_temp_fake.custom_fake = GetFakeDieTemp;
+
+    // Normal range
+    for (size_t chip = 0U; chip < NUM_OF_CELL_MONITOR_CHIPS; chip++)
+    {
+        fake_die_temps[chip] = (MIN_ITMP_DEGC + MAX_ITMP_DEGC) / 2 + chip;
+    }
+
+    // Each chip's die temperature is sent in turn, one per 1Hz tick
+    bool is_chip_sent[NUM_OF_CELL_MONITOR_CHIPS] = { false };
+    for (size_t tick = 0U; tick < NUM_OF_CELL_MONITOR_CHIPS; tick++)
+    {
+        LetTimePass(state_machine, 1000);
+
+        const size_t chip =
+            App_CanTx_GetPeriodicSignal_CELL_MONITOR_INDEX(can_tx_interface);
+        ASSERT_LT(chip, NUM_OF_CELL_MONITOR_CHIPS);
+        ASSERT_FALSE(is_chip_sent[chip]);
+        is_chip_sent[chip] = true;
+
+        ASSERT_EQ(
+            fake_die_temps[chip],
+            App_CanTx_GetPeriodicSignal_CELL_MONITOR_DIE_TEMPERATURE(
+                can_tx_interface));
+        ASSERT_EQ(
+            CANMSGS_BMS_CELL_MONITOR_DIE_TEMPERATURE_CELL_MONITOR_DIE_TEMP_OUT_OF_RANGE_OK_CHOICE,
+            App_CanTx_GetPeriodicSignal_CELL_MONITOR_DIE_TEMP_OUT_OF_RANGE(
+                can_tx_interface));
+        ASSERT_EQ(
+            0,
+            App_CanTx_GetPeriodicSignal_NUM_CELL_MONITOR_DIE_TEMPS_OUT_OF_RANGE(
+                can_tx_interface));
+    }
+
+    // Underflow range for the first chip and overflow range for the last chip
+    fake_die_temps[0] =
+        std::nextafter(MIN_ITMP_DEGC, std::numeric_limits<float>::lowest());
+    fake_die_temps[NUM_OF_CELL_MONITOR_CHIPS - 1] =
+        std::nextafter(MAX_ITMP_DEGC, std::numeric_limits<float>::max());
+
+    // Every chip is checked on every tick, whichever chip is sent
+    for (size_t tick = 0U; tick < NUM_OF_CELL_MONITOR_CHIPS; tick++)
+    {
+        LetTimePass(state_machine, 1000);
+
+        ASSERT_EQ(
+            2,
+            App_CanTx_GetPeriodicSignal_NUM_CELL_MONITOR_DIE_TEMPS_OUT_OF_RANGE(
+                can_tx_interface));
+
+        const size_t chip =
+            App_CanTx_GetPeriodicSignal_CELL_MONITOR_INDEX(can_tx_interface);
+        if (chip == 0U)
+        {
+            ASSERT_EQ(
+                CANMSGS_BMS_CELL_MONITOR_DIE_TEMPERATURE_CELL_MONITOR_DIE_TEMP_OUT_OF_RANGE_UNDERFLOW_CHOICE,
+                App_CanTx_GetPeriodicSignal_CELL_MONITOR_DIE_TEMP_OUT_OF_RANGE(
+                    can_tx_interface));
+        }
+        else if (chip == NUM_OF_CELL_MONITOR_CHIPS - 1)
+        {
+            ASSERT_EQ(
+                CANMSGS_BMS_CELL_MONITOR_DIE_TEMPERATURE_CELL_MONITOR_DIE_TEMP_OUT_OF_RANGE_OVERFLOW_CHOICE,
+                App_CanTx_GetPeriodicSignal_CELL_MONITOR_DIE_TEMP_OUT_OF_RANGE(
+                    can_tx_interface));
+        }
+    }
 }
+
+TEST_F(BmsStateMachineTest, check_segment_voltages_are_sent_in_all_states)
+{
+    get_segment_voltage_fake.custom_fake = GetFakeSegmentVoltage;
+
+    // Every segment is in range except for the last one
+    for (size_t segment = 0U; segment < NUM_OF_ACCUMULATOR_SEGMENTS; segment++)
+    {
+        fake_segment_voltages[segment] =
+            (MIN_SEGMENT_VOLTAGE + MAX_SEGMENT_VOLTAGE) / 2 + segment;
+    }
+    fake_segment_voltages[NUM_OF_ACCUMULATOR_SEGMENTS - 1] =
+        std::nextafter(MAX_SEGMENT_VOLTAGE, std::numeric_limits<float>::max());
+
+    for (const auto &state : GetAllStates())
+    {
+        SetInitialState(state);
+
+        // Each segment voltage is sent in turn, one per 100Hz tick, so only
+        // one frame is queued per tick however many segments there are
+        bool is_segment_sent[NUM_OF_ACCUMULATOR_SEGMENTS] = { false };
+        for (size_t tick = 0U; tick < NUM_OF_ACCUMULATOR_SEGMENTS; tick++)
+        {
+            LetTimePass(state_machine, 10);
+
+            const size_t segment =
+                App_CanTx_GetPeriodicSignal_SEGMENT_INDEX(can_tx_interface);
+            ASSERT_LT(segment, NUM_OF_ACCUMULATOR_SEGMENTS);
+            ASSERT_FALSE(is_segment_sent[segment]);
+            is_segment_sent[segment] = true;
+
+            ASSERT_EQ(
+                fake_segment_voltages[segment],
+                App_CanTx_GetPeriodicSignal_SEGMENT_VOLTAGE(can_tx_interface));
+            ASSERT_EQ(
+                segment == NUM_OF_ACCUMULATOR_SEGMENTS - 1
+                    ? CANMSGS_BMS_SEGMENT_VOLTAGE_SEGMENT_VOLTAGE_OUT_OF_RANGE_OVERFLOW_CHOICE
+                    : CANMSGS_BMS_SEGMENT_VOLTAGE_SEGMENT_VOLTAGE_OUT_OF_RANGE_OK_CHOICE,
+                App_CanTx_GetPeriodicSignal_SEGMENT_VOLTAGE_OUT_OF_RANGE(
+                    can_tx_interface));
+
+            // Every segment is checked on every tick, whichever is sent
+            ASSERT_EQ(
+                1,
+                App_CanTx_GetPeriodicSignal_NUM_SEGMENT_VOLTAGES_OUT_OF_RANGE(
+                    can_tx_interface));
+        }
+    }
+}
+
+TEST_F(
+    BmsStateMachineTest,
+    cells_are_balanced_between_measurements_in_charge_state)
+{
+    // The 4th cell of the last segment is 20mV above every other cell
+    fake_cell_statistics.max  = 40200U;
+    fake_cell_statistics.mean = 40006U;
+    for (auto &segment : fake_cell_statistics.deltas_from_mean)
+    {
+        std::fill(std::begin(segment), std::end(segment), -6);
+    }
+    fake_cell_statistics.deltas_from_mean[NUM_OF_CELL_MONITOR_CHIPS - 1][3] =
+        194;
+
+    SetInitialState(App_GetChargeState());
+
+    // The cell starts discharging at the start of the balancing period, after
+    // the cell voltages were read
+    LetTimePass(state_machine, 10);
+    ASSERT_EQ(1, read_cell_voltages_fake.call_count);
+    ASSERT_EQ(1, write_discharge_cells_fake.call_count);
+    for (size_t chip = 0U; chip < NUM_OF_CELL_MONITOR_CHIPS; chip++)
+    {
+        ASSERT_EQ(
+            chip == NUM_OF_CELL_MONITOR_CHIPS - 1 ? 1U << 3 : 0U,
+            written_discharge_cells[chip]);
+    }
+
+    // The cell voltages are still read while the cell is discharging
+    LetTimePass(state_machine, 10 * (MAX_BALANCING_DISCHARGE_TICKS - 1));
+    ASSERT_EQ(
+        MAX_BALANCING_DISCHARGE_TICKS,
+        (uint32_t)read_cell_voltages_fake.call_count);
+    ASSERT_EQ(1, write_discharge_cells_fake.call_count);
+
+    LetTimePass(state_machine, 10);
+    ASSERT_EQ(2, write_discharge_cells_fake.call_count);
+    for (uint32_t discharge_cells : written_discharge_cells)
+    {
+        ASSERT_EQ(0U, discharge_cells);
+    }
+
+    // The cell starts discharging again in the next balancing period, and
+    // stops when the charge state is exited
+    LetTimePass(
+        state_machine,
+        10 * (BALANCING_PERIOD_TICKS - MAX_BALANCING_DISCHARGE_TICKS));
+    ASSERT_EQ(3, write_discharge_cells_fake.call_count);
+    ASSERT_EQ(1U << 3, written_discharge_cells[NUM_OF_CELL_MONITOR_CHIPS - 1]);
+
+    is_charger_connected_fake.return_val = false;
+    LetTimePass(state_machine, 10);
+    ASSERT_EQ(
+        App_GetFaultState(),
+        App_SharedStateMachine_GetCurrentState(state_machine));
+    ASSERT_EQ(4, write_discharge_cells_fake.call_count);
+    ASSERT_EQ(0U, written_discharge_cells[NUM_OF_CELL_MONITOR_CHIPS - 1]);
+}
+
+TEST_F(
+    BmsStateMachineTest,
+    discharging_cells_are_checked_against_the_max_cell_voltage_in_charge_state)
+{
+    // The 4th cell of the last segment is 30mV above every other cell, and
+    // reads below the maximum cell voltage
+    const uint16_t cell_voltage = (uint16_t)(MAX_CELL_VOLTAGE * 1e4f) -
+                                  BALANCING_DISCHARGE_VOLTAGE_DROP_100UV / 2U;
+    fake_cell_statistics.max  = cell_voltage;
+    fake_cell_statistics.mean = (uint16_t)(cell_voltage - 300U);
+    for (auto &segment : fake_cell_statistics.deltas_from_mean)
+    {
+        std::fill(std::begin(segment), std::end(segment), 0);
+    }
+    fake_cell_statistics.deltas_from_mean[NUM_OF_CELL_MONITOR_CHIPS - 1][3] =
+        300;
+
+    SetInitialState(App_GetChargeState());
+
+    // The cell reads the same before it discharges, so it is within the
+    // maximum cell voltage
+    LetTimePass(state_machine, 10);
+    ASSERT_EQ(1, write_discharge_cells_fake.call_count);
+    bool is_error_set = true;
+    ASSERT_EQ(
+        EXIT_CODE_OK,
+        App_SharedErrorTable_IsErrorSet(
+            error_table, BMS_AIR_SHUTDOWN_MAX_CELL_VOLTAGE_OUT_OF_RANGE,
+            &is_error_set));
+    ASSERT_FALSE(is_error_set);
+
+    // While the cell discharges, it reads lower than its open-circuit voltage,
+    // which is above the maximum cell voltage
+    LetTimePass(state_machine, 10);
+    ASSERT_EQ(
+        EXIT_CODE_OK,
+        App_SharedErrorTable_IsErrorSet(
+            error_table, BMS_AIR_SHUTDOWN_MAX_CELL_VOLTAGE_OUT_OF_RANGE,
+            &is_error_set));
+    ASSERT_TRUE(is_error_set);
+    ASSERT_EQ(
+        App_GetFaultState(),
+        App_SharedStateMachine_GetCurrentState(state_machine));
+}
+
 // BMS-12
 TEST_F(BmsStateMachineTest, check_transition_from_init_state_to_air_open_state)
 {
@@ -916,4 +1213,227 @@ TEST_F(
         App_CanTx_GetPeriodicSignal_STATE(can_tx_interface));
 }
 
+TEST_F(BmsStateMachineTest, state_of_charge_starts_from_open_circuit_voltage)
+{
+    SetInitialState(App_GetInitState());
+
+    // Every cell is at 4.0V, which is 80% SoC on the open circuit voltage curve
+    LetTimePass(state_machine, 10);
+    ASSERT_EQ(1, read_persisted_soc_fake.call_count);
+    ASSERT_NEAR(
+        80.0f, App_CanTx_GetPeriodicSignal_STATE_OF_CHARGE(can_tx_interface),
+        0.1f);
+
+    // Nothing is persisted until the SoC moves
+    LetTimePass(state_machine, 1000);
+    ASSERT_EQ(1, read_persisted_soc_fake.call_count);
+    ASSERT_EQ(0, write_persisted_soc_fake.call_count);
+}
+
+TEST_F(BmsStateMachineTest, state_of_charge_is_counted_and_persisted)
+{
+    SetInitialState(App_GetDriveState());
+    fake_cell_statistics.mean           = 38200U;
+    fake_persisted_soc                  = 60.0f;
+    read_persisted_soc_fake.custom_fake = ReadFakePersistedSoc;
+
+    // Every cell is at 3.82V, which is 60% SoC on the open circuit voltage
+    // curve, and the persisted SoC agrees with it
+    LetTimePass(state_machine, 10);
+    ASSERT_EQ(
+        60.0f, App_CanTx_GetPeriodicSignal_STATE_OF_CHARGE(can_tx_interface));
+
+    // Discharge 1.5% of the cell group capacity over one second
+    const float charge_per_tick_c =
+        0.015f * CELL_GROUP_CAPACITY_AH * 3600.0f / 100.0f;
+    get_and_clear_charge_fake.return_val = charge_per_tick_c;
+    LetTimePass(state_machine, 1000);
+    get_and_clear_charge_fake.return_val = 0.0f;
+    ASSERT_NEAR(
+        58.5f, App_SocEstimator_GetCoulombCountingSoc(soc_estimator), 0.01f);
+
+    // The SoC has moved more than SOC_PERSIST_DELTA from the persisted SoC, so
+    // it is persisted on the next 1Hz tick
+    LetTimePass(state_machine, 1000);
+    ASSERT_EQ(1, write_persisted_soc_fake.call_count);
+    ASSERT_NEAR(
+        App_CanTx_GetPeriodicSignal_STATE_OF_CHARGE(can_tx_interface),
+        write_persisted_soc_fake.arg0_val, 0.01f);
+}
+
+TEST_F(BmsStateMachineTest, cell_diagnostics_are_accumulated_and_reported)
+{
+    SetInitialState(App_GetDriveState());
+
+    // No diagnostic result has arrived, so every cell is untested
+    LetTimePass(state_machine, 1000);
+    ASSERT_EQ(
+        NUM_OF_CELL_MONITOR_CHIPS * NUM_OF_CELLS_PER_SEGMENT,
+        App_CanTx_GetPeriodicSignal_NUM_UNTESTED_CELLS(can_tx_interface));
+
+    // The pin below the 6th cell of the 0th segment is open, which is sensed
+    // by both the 5th and the 6th cell
+    fake_open_wire_cell                   = 5U;
+    read_cell_diagnostic_fake.custom_fake = ReadFakeCellDiagnostic;
+    LetTimePass(state_machine, 1000);
+    ASSERT_EQ(
+        0U, App_CanTx_GetPeriodicSignal_NUM_UNTESTED_CELLS(can_tx_interface));
+    ASSERT_EQ(
+        2U, App_CanTx_GetPeriodicSignal_NUM_OPEN_WIRE_CELLS(can_tx_interface));
+    ASSERT_EQ(
+        0U,
+        App_CanTx_GetPeriodicSignal_NUM_ADC_MISMATCH_CELLS(can_tx_interface));
+    ASSERT_EQ(
+        CELL_DIAGNOSTIC_STATUS_OPEN_WIRE,
+        App_CellDiagnostics_GetCellStatus(cell_diagnostics, 0U, 4U));
+    ASSERT_EQ(
+        CELL_DIAGNOSTIC_STATUS_OPEN_WIRE,
+        App_CellDiagnostics_GetCellStatus(cell_diagnostics, 0U, 5U));
+    ASSERT_EQ(
+        CELL_DIAGNOSTIC_STATUS_OK,
+        App_CellDiagnostics_GetCellStatus(cell_diagnostics, 0U, 6U));
+}
+
+TEST_F(BmsStateMachineTest, available_power_is_estimated_and_broadcast)
+{
+    SetInitialState(App_GetDriveState());
+
+    // Every cell is at 4.0V and 25°C, so there is power to discharge and regen
+    LetTimePass(state_machine, 10);
+    const uint16_t pulse_discharge_power =
+        App_CanTx_GetPeriodicSignal_PULSE_DISCHARGE_POWER(can_tx_interface);
+    ASSERT_GT(pulse_discharge_power, 0U);
+    ASSERT_GT(
+        pulse_discharge_power,
+        App_CanTx_GetPeriodicSignal_CONTINUOUS_DISCHARGE_POWER(
+            can_tx_interface));
+    ASSERT_GT(
+        App_CanTx_GetPeriodicSignal_CONTINUOUS_REGEN_POWER(can_tx_interface),
+        0U);
+    ASSERT_GT(
+        App_CanTx_GetPeriodicSignal_PULSE_REGEN_POWER(can_tx_interface), 0U);
+
+    // Once the hottest cell is too hot, no power is available
+    get_max_cell_temperature_fake.return_val =
+        (int32_t)(10.0f * DISCHARGE_ZERO_MAX_TEMPERATURE_DEGC);
+    LetTimePass(state_machine, 10);
+    ASSERT_EQ(
+        0U, App_CanTx_GetPeriodicSignal_CONTINUOUS_DISCHARGE_POWER(
+                can_tx_interface));
+    ASSERT_EQ(
+        0U,
+        App_CanTx_GetPeriodicSignal_PULSE_DISCHARGE_POWER(can_tx_interface));
+    ASSERT_EQ(
+        0U,
+        App_CanTx_GetPeriodicSignal_CONTINUOUS_REGEN_POWER(can_tx_interface));
+    ASSERT_EQ(
+        0U, App_CanTx_GetPeriodicSignal_PULSE_REGEN_POWER(can_tx_interface));
+}
+
+TEST_F(BmsStateMachineTest, air_positive_closes_once_tractive_system_precharged)
+{
+    is_air_negative_closed_fake.return_val = true;
+    is_charger_connected_fake.return_val   = false;
+    get_pack_voltage_fake.return_val       = 400.0f;
+    SetInitialState(App_GetPreChargeState());
+    ASSERT_EQ(1U, enable_pre_charge_fake.call_count);
+
+    // AIR+ stays open until the tractive system reaches 95% of the pack
+    // voltage, which takes about 3 time constants
+    const uint32_t pre_charge_time_ms = (uint32_t)(
+        -1000.0f * NOMINAL_PRE_CHARGE_TIME_CONSTANT_S *
+        logf(1.0f - PRE_CHARGE_COMPLETE_VOLTAGE_RATIO));
+    LetTimePass(state_machine, pre_charge_time_ms - 10U);
+    ASSERT_EQ(0U, close_air_positive_fake.call_count);
+    ASSERT_EQ(
+        App_GetPreChargeState(),
+        App_SharedStateMachine_GetCurrentState(state_machine));
+
+    LetTimePass(state_machine, 30U);
+    ASSERT_EQ(1U, close_air_positive_fake.call_count);
+    ASSERT_EQ(1U, disable_pre_charge_fake.call_count);
+    ASSERT_EQ(
+        App_GetDriveState(),
+        App_SharedStateMachine_GetCurrentState(state_machine));
+    ASSERT_FALSE(
+        App_CanTx_GetPeriodicSignal_PRE_CHARGE_FAILED(can_tx_interface));
+}
+
+TEST_F(
+    BmsStateMachineTest,
+    air_positive_closes_if_tractive_system_still_charged)
+{
+    // The AIRs are closed again before the inverters' capacitance discharged
+    is_air_negative_closed_fake.return_val = true;
+    is_charger_connected_fake.return_val   = false;
+    get_pack_voltage_fake.return_val       = 400.0f;
+    fake_tractive_system_voltage           = 390.0f;
+    SetInitialState(App_GetPreChargeState());
+
+    LetTimePass(state_machine, 10U);
+    ASSERT_EQ(1U, close_air_positive_fake.call_count);
+    ASSERT_EQ(
+        App_GetDriveState(),
+        App_SharedStateMachine_GetCurrentState(state_machine));
+    ASSERT_FALSE(
+        App_CanTx_GetPeriodicSignal_PRE_CHARGE_FAILED(can_tx_interface));
+}
+
+TEST_F(BmsStateMachineTest, shorted_precharge_resistor_faults_before_air_closes)
+{
+    is_air_negative_closed_fake.return_val = true;
+    get_pack_voltage_fake.return_val       = 400.0f;
+    fake_pre_charge_time_constant = 0.1f * MIN_PRE_CHARGE_TIME_CONSTANT_S;
+    SetInitialState(App_GetPreChargeState());
+
+    LetTimePass(state_machine, 100U);
+    ASSERT_EQ(0U, close_air_positive_fake.call_count);
+    ASSERT_EQ(1U, disable_pre_charge_fake.call_count);
+    ASSERT_TRUE(
+        App_CanTx_GetPeriodicSignal_PRE_CHARGE_FAILED(can_tx_interface));
+    bool is_error_set = false;
+    ASSERT_EQ(
+        EXIT_CODE_OK,
+        App_SharedErrorTable_IsErrorSet(
+            error_table, BMS_AIR_SHUTDOWN_PRE_CHARGE_FAILED, &is_error_set));
+    ASSERT_TRUE(is_error_set);
+    ASSERT_EQ(
+        App_GetFaultState(),
+        App_SharedStateMachine_GetCurrentState(state_machine));
+}
+
+TEST_F(BmsStateMachineTest, open_precharge_resistor_faults_early)
+{
+    // The tractive system voltage doesn't rise at all, which is caught long
+    // before a fixed precharge time with margin would have run out
+    is_air_negative_closed_fake.return_val = true;
+    get_pack_voltage_fake.return_val       = 400.0f;
+    fake_pre_charge_time_constant          = INFINITY;
+    SetInitialState(App_GetPreChargeState());
+
+    LetTimePass(state_machine, 100U);
+    ASSERT_EQ(0U, close_air_positive_fake.call_count);
+    ASSERT_TRUE(
+        App_CanTx_GetPeriodicSignal_PRE_CHARGE_FAILED(can_tx_interface));
+    ASSERT_EQ(
+        App_GetFaultState(),
+        App_SharedStateMachine_GetCurrentState(state_machine));
+}
+
+TEST_F(BmsStateMachineTest, precharge_stops_once_air_negative_opens)
+{
+    is_air_negative_closed_fake.return_val = true;
+    get_pack_voltage_fake.return_val       = 400.0f;
+    SetInitialState(App_GetPreChargeState());
+    LetTimePass(state_machine, 100U);
+
+    is_air_negative_closed_fake.return_val = false;
+    LetTimePass(state_machine, 10U);
+    ASSERT_EQ(0U, close_air_positive_fake.call_count);
+    ASSERT_EQ(1U, disable_pre_charge_fake.call_count);
+    ASSERT_EQ(
+        App_GetAirOpenState(),
+        App_SharedStateMachine_GetCurrentState(state_machine));
+}
+
 } // namespace StateMachineTest
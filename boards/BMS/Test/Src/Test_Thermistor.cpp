@@ -0,0 +1,226 @@
+#include <chrono>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include "Test_Bms.h"
+
+extern "C"
+{
+#include "Io_Thermistor.h"
+}
+
+// The coefficients of Vishay's R/T characteristic for the NTCALUG03A103G
+static constexpr double VISHAY_A = -14.6567;
+static constexpr double VISHAY_B = 4798.43;
+static constexpr double VISHAY_C = -115219.0;
+static constexpr double VISHAY_D = -3741190.0;
+
+static constexpr double NOMINAL_RESISTANCE_OHMS = 10000.0;
+static constexpr double BIAS_RESISTOR_OHMS      = 10000.0;
+static constexpr double REFERENCE_VOLTAGE       = 3.0;
+static constexpr double KELVIN_OFFSET           = 273.15;
+
+static double GetThermistorResistance(uint16_t raw_thermistor_voltage)
+{
+    const double voltage = raw_thermistor_voltage / 10000.0;
+    return voltage * BIAS_RESISTOR_OHMS / (REFERENCE_VOLTAGE - voltage);
+}
+
+static uint16_t GetRawThermistorVoltage(double thermistor_resistance)
+{
+    return (uint16_t)std::lround(
+        REFERENCE_VOLTAGE * 10000.0 * thermistor_resistance /
+        (thermistor_resistance + BIAS_RESISTOR_OHMS));
+}
+
+static double GetVishayResistance(double temperature)
+{
+    const double t = temperature + KELVIN_OFFSET;
+    return NOMINAL_RESISTANCE_OHMS *
+           std::exp(
+               VISHAY_A + VISHAY_B / t + VISHAY_C / (t * t) +
+               VISHAY_D / (t * t * t));
+}
+
+static double GetVishayTemperature(double thermistor_resistance)
+{
+    // The resistance decreases monotonically with the temperature, so the
+    // characteristic is inverted by bisection
+    double min_temperature = -60.0;
+    double max_temperature = 160.0;
+    for (int i = 0; i < 64; i++)
+    {
+        const double temperature = (min_temperature + max_temperature) / 2.0;
+        if (GetVishayResistance(temperature) > thermistor_resistance)
+        {
+            min_temperature = temperature;
+        }
+        else
+        {
+            max_temperature = temperature;
+        }
+    }
+    return (min_temperature + max_temperature) / 2.0;
+}
+
+TEST(
+    ThermistorTest,
+    temperature_matches_vishay_characteristic_over_operating_range)
+{
+    const uint16_t min_raw_voltage =
+        (uint16_t)(GetRawThermistorVoltage(GetVishayResistance(125.0)) + 1U);
+    const uint16_t max_raw_voltage =
+        (uint16_t)(GetRawThermistorVoltage(GetVishayResistance(-40.0)) - 1U);
+
+    for (uint32_t raw_voltage = min_raw_voltage; raw_voltage <= max_raw_voltage;
+         raw_voltage++)
+    {
+        int32_t temperature;
+        ASSERT_EQ(
+            EXIT_CODE_OK,
+            Io_Thermistor_GetTemperature((uint16_t)raw_voltage, &temperature));
+
+        // At most 0.09°C of interpolation error and 0.05°C of rounding
+        const double expected_temperature = GetVishayTemperature(
+            GetThermistorResistance((uint16_t)raw_voltage));
+        ASSERT_NEAR(expected_temperature, temperature / 10.0, 0.15)
+            << "raw voltage " << raw_voltage;
+    }
+}
+
+TEST(ThermistorTest, temperature_matches_vishay_resistance_table)
+{
+    // Points from Vishay's R/T data for the NTCALUG03A103G, including the ends
+    // of its operating range
+    const std::pair<double, double> resistance_table[] = {
+        { -40.0, 334276.2 }, { -30.0, 176133.8 }, { -20.0, 96761.9 },
+        { -10.0, 55218.5 },  { 0.0, 32624.2 },    { 10.0, 19896.9 },
+        { 25.0, 10000.0 },   { 40.0, 5323.9 },    { 60.0, 2483.8 },
+        { 80.0, 1251.8 },    { 90.0, 911.6 },     { 100.0, 674.1 },
+        { 110.0, 505.7 },    { 125.0, 336.8 },
+    };
+
+    for (const auto &[expected_temperature, resistance] : resistance_table)
+    {
+        int32_t temperature;
+        ASSERT_EQ(
+            EXIT_CODE_OK,
+            Io_Thermistor_GetTemperature(
+                GetRawThermistorVoltage(resistance), &temperature));
+        ASSERT_NEAR(expected_temperature, temperature / 10.0, 0.15);
+    }
+}
+
+TEST(ThermistorTest, temperature_decreases_with_thermistor_voltage)
+{
+    int32_t last_temperature = INT32_MAX;
+    for (uint32_t raw_voltage = 0; raw_voltage <= UINT16_MAX; raw_voltage++)
+    {
+        int32_t temperature;
+        if (Io_Thermistor_GetTemperature((uint16_t)raw_voltage, &temperature) ==
+            EXIT_CODE_OK)
+        {
+            ASSERT_LE(temperature, last_temperature);
+            last_temperature = temperature;
+        }
+    }
+}
+
+TEST(ThermistorTest, shorted_or_disconnected_thermistor_is_out_of_range)
+{
+    int32_t temperature = 0;
+
+    // Shorted thermistor
+    ASSERT_EQ(
+        EXIT_CODE_OUT_OF_RANGE, Io_Thermistor_GetTemperature(0, &temperature));
+    ASSERT_EQ(
+        EXIT_CODE_OUT_OF_RANGE,
+        Io_Thermistor_GetTemperature(
+            GetRawThermistorVoltage(GetVishayResistance(126.0)), &temperature));
+
+    // Disconnected thermistor
+    ASSERT_EQ(
+        EXIT_CODE_OUT_OF_RANGE,
+        Io_Thermistor_GetTemperature(30000, &temperature));
+    ASSERT_EQ(
+        EXIT_CODE_OUT_OF_RANGE,
+        Io_Thermistor_GetTemperature(
+            GetRawThermistorVoltage(GetVishayResistance(-41.0)), &temperature));
+
+    ASSERT_EQ(0, temperature);
+}
+
+TEST(ThermistorTest, benchmark_thermistor_conversion)
+{
+    // The 0-80°C resistance table with 0.5°C resolution that used to be
+    // scanned linearly for every thermistor
+    std::vector<float> resistance_lut;
+    for (int i = 0; i <= 160; i++)
+    {
+        resistance_lut.push_back((float)GetVishayResistance(i * 0.5));
+    }
+
+    std::vector<uint16_t> raw_voltages;
+    for (int i = 0; i < 1024; i++)
+    {
+        raw_voltages.push_back(GetRawThermistorVoltage(
+            GetVishayResistance(0.5 + (i % 159) * 0.5)));
+    }
+
+    constexpr uint32_t num_iterations = 1000000;
+
+    const auto benchmark = [&](auto convert) {
+        volatile int32_t temperature = 0;
+        const auto       start       = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < num_iterations; i++)
+        {
+            temperature = convert(raw_voltages[i % raw_voltages.size()]);
+        }
+        (void)temperature;
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - start)
+                   .count() /
+               num_iterations;
+    };
+
+    const auto table_ns          = benchmark([](uint16_t raw_voltage) {
+        int32_t temperature = 0;
+        Io_Thermistor_GetTemperature(raw_voltage, &temperature);
+        return temperature;
+    });
+    const auto linear_scan_ns    = benchmark([&](uint16_t raw_voltage) {
+        const float gpio_voltage = (float)raw_voltage / 10000.0f;
+        const float resistance =
+            gpio_voltage * 10000.0f / (3.0f - gpio_voltage);
+        size_t index = 0;
+        while (index < resistance_lut.size() - 1 &&
+               resistance < resistance_lut[index])
+        {
+            index++;
+        }
+        return (int32_t)(index * 5);
+    });
+    const auto steinhart_hart_ns = benchmark([](uint16_t raw_voltage) {
+        // Steinhart-Hart coefficients fitted to the thermistor from 0°C to 80°C
+        constexpr float STEINHART_HART_A = 1.1405349049e-03f;
+        constexpr float STEINHART_HART_B = 2.3226910800e-04f;
+        constexpr float STEINHART_HART_C = 9.4946039597e-08f;
+
+        const float gpio_voltage = (float)raw_voltage / 10000.0f;
+        const float ln_r =
+            logf(gpio_voltage * 10000.0f / (3.0f - gpio_voltage));
+        return (int32_t)lroundf(
+            10.0f * (1.0f / (STEINHART_HART_A + STEINHART_HART_B * ln_r +
+                             STEINHART_HART_C * ln_r * ln_r * ln_r) -
+                     (float)KELVIN_OFFSET));
+    });
+
+    RecordProperty("table_ns_per_thermistor", (int)table_ns);
+    RecordProperty("linear_scan_ns_per_thermistor", (int)linear_scan_ns);
+    RecordProperty("steinhart_hart_ns_per_thermistor", (int)steinhart_hart_ns);
+    printf(
+        "Thermistor conversion: table %lld ns, linear scan %lld ns, "
+        "Steinhart-Hart %lld ns\n",
+        (long long)table_ns, (long long)linear_scan_ns,
+        (long long)steinhart_hart_ns);
+}
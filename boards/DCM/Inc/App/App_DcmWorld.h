@@ -10,7 +10,7 @@
 #include "App_Imu.h"
 #include "App_SharedErrorTable.h"
 #include "App_SharedClock.h"
-#include "App_SharedWaitSignal.h"
+#include "App_SharedSignalEngine.h"
 
 struct DcmWorld;
 
@@ -1,8 +1,13 @@
 #pragma once
 #include "App_DcmWorld.h"
+#include "App_SharedStateMachine.h"
 
 struct DcmWorld;
 
 void App_SetPeriodicCanSignals_TorqueRequests(const struct DcmWorld *world);
 
 void App_SetPeriodicCanSignals_Imu(const struct DcmWorld *world);
+
+void App_SetPeriodicCanSignals_StateMachineTrace(
+    struct DcmCanTxInterface * can_tx,
+    const struct StateMachine *state_machine);
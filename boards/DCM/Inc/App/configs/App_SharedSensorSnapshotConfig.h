@@ -0,0 +1,5 @@
+#pragma once
+
+struct DcmWorld;
+
+#define World DcmWorld
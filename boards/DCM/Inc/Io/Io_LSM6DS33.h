@@ -5,12 +5,36 @@
  *
  * The Application Note for this Imu can be found here:
  * https://www.pololu.com/file/0J1088/LSM6DS33-AN4682.pdf
+ *
+ * The Imu batches its samples in its FIFO, and raises INT1 once the FIFO
+ * reaches its watermark. Every INT1 reads the FIFO status and then the FIFO by
+ * DMA, so the FIFO is read from interrupts without involving any task.
  */
 
 #include <stdint.h>
 #include <stm32f3xx_hal.h>
 #include <stdbool.h>
 #include "App_SharedExitCode.h"
+#include "Io_LSM6DS33Fifo.h"
+
+/**
+ * Configure the Imu, and start reading its FIFO whenever it reaches its
+ * watermark
+ * @note This blocks until the Imu is configured, so it must be called before
+ *       the scheduler is started
+ * @param hi2c: The handle of the I2C bus the Imu is on, whose RX DMA channel
+ *              and event and error interrupts must be enabled
+ * @return EXIT_CODE_ERROR if the Imu could not be configured, else
+ *         EXIT_CODE_OK
+ */
+ExitCode Io_LSM6DS33_Init(I2C_HandleTypeDef *hi2c);
+
+/**
+ * Read the FIFO if its watermark interrupt was missed, e.g. because a transfer
+ * failed, which would otherwise stop the Imu from ever interrupting again
+ * @note This must be called periodically from a task
+ */
+void Io_LSM6DS33_CheckForMissedWatermark(void);
 
 /**
  * Get x acceleration from Imu
@@ -29,3 +53,33 @@ float Io_LSM6DS33_GetAccelerationY(void);
  * @return The acceleration (m/s^2) measured on the z-axis.
  */
 float Io_LSM6DS33_GetAccelerationZ(void);
+
+/**
+ * Get angular velocity about the x-axis from Imu
+ * @return The angular velocity (deg/s) measured about the x-axis.
+ */
+float Io_LSM6DS33_GetAngularVelocityX(void);
+
+/**
+ * Get angular velocity about the y-axis from Imu
+ * @return The angular velocity (deg/s) measured about the y-axis.
+ */
+float Io_LSM6DS33_GetAngularVelocityY(void);
+
+/**
+ * Get angular velocity about the z-axis from Imu
+ * @return The angular velocity (deg/s) measured about the z-axis.
+ */
+float Io_LSM6DS33_GetAngularVelocityZ(void);
+
+/**
+ * Take the oldest samples from the stream of every sample the Imu measured,
+ * at the Imu's full output data rate, for vehicle dynamics
+ * @note The stream has a single reader
+ * @param samples: Set to the samples taken from the stream, oldest first
+ * @param max_num_samples: The maximum number of samples to take
+ * @return The number of samples taken from the stream
+ */
+size_t Io_LSM6DS33_ReadSamples(
+    struct LSM6DS33Sample *samples,
+    size_t                 max_num_samples);
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "App_SharedExitCode.h"
+
+// The FIFO status registers, FIFO_STATUS1 to FIFO_STATUS4, are read in one go
+// starting from FIFO_STATUS1 to find out how much data to read from the FIFO
+#define LSM6DS33_FIFO_STATUS1_REGISTER 0x3AU
+#define LSM6DS33_NUM_FIFO_STATUS_REGISTERS 4U
+
+// Reading more than one byte from FIFO_DATA_OUT_L keeps reading the FIFO, as
+// the register address wraps around to FIFO_DATA_OUT_L after FIFO_DATA_OUT_H
+#define LSM6DS33_FIFO_DATA_OUT_L_REGISTER 0x3EU
+
+// Every sample in the FIFO is a 16-bit word for each gyroscope axis, followed
+// by a 16-bit word for each accelerometer axis
+#define LSM6DS33_NUM_FIFO_WORDS_PER_SAMPLE 6U
+#define LSM6DS33_FIFO_SAMPLE_SIZE (2U * LSM6DS33_NUM_FIFO_WORDS_PER_SAMPLE)
+
+enum LSM6DS33Axis
+{
+    LSM6DS33_AXIS_X,
+    LSM6DS33_AXIS_Y,
+    LSM6DS33_AXIS_Z,
+    NUM_LSM6DS33_AXES,
+};
+
+// The output data rate of both the accelerometer and the gyroscope, which is
+// also the rate the samples are written into the FIFO at
+enum LSM6DS33Odr
+{
+    LSM6DS33_ODR_833_HZ,
+    LSM6DS33_ODR_1660_HZ,
+};
+
+enum LSM6DS33AccelerometerFullScale
+{
+    LSM6DS33_ACCELEROMETER_FULL_SCALE_2_G,
+    LSM6DS33_ACCELEROMETER_FULL_SCALE_4_G,
+    LSM6DS33_ACCELEROMETER_FULL_SCALE_8_G,
+    LSM6DS33_ACCELEROMETER_FULL_SCALE_16_G,
+};
+
+enum LSM6DS33GyroscopeFullScale
+{
+    LSM6DS33_GYROSCOPE_FULL_SCALE_245_DPS,
+    LSM6DS33_GYROSCOPE_FULL_SCALE_500_DPS,
+    LSM6DS33_GYROSCOPE_FULL_SCALE_1000_DPS,
+    LSM6DS33_GYROSCOPE_FULL_SCALE_2000_DPS,
+};
+
+// The bus the LSM6DS33's registers are accessed through
+struct LSM6DS33Bus
+{
+    // Write a value into a register, and return true if it was written
+    bool (*write_register)(uint8_t address, uint8_t value);
+
+    // Read consecutive registers starting from the given address, and return
+    // true if they were read
+    bool (*read_registers)(uint8_t address, uint8_t *values, size_t size);
+};
+
+// The calibration of a sensor axis, in the frame of the sensor:
+//     calibrated value = (measured value - offset) * scale
+struct LSM6DS33Calibration
+{
+    float offset;
+    float scale;
+};
+
+// The sensor axis that measures a vehicle axis
+struct LSM6DS33AxisMapping
+{
+    enum LSM6DS33Axis sensor_axis;
+
+    // Whether the sensor axis points the opposite way to the vehicle axis
+    bool is_inverted;
+};
+
+struct LSM6DS33Config
+{
+    enum LSM6DS33Odr                    odr;
+    enum LSM6DS33AccelerometerFullScale accelerometer_full_scale;
+    enum LSM6DS33GyroscopeFullScale     gyroscope_full_scale;
+
+    // The number of samples in the FIFO at which INT1 is raised, and the
+    // maximum number of samples read from the FIFO in one burst
+    size_t watermark_num_samples;
+    size_t max_burst_num_samples;
+
+    // The rate the averaged samples are published at (Hz)
+    uint32_t decimated_rate_hz;
+
+    // The number of samples the stream of samples can hold until it is read,
+    // which must be a power of two
+    size_t stream_num_samples;
+
+    // The calibration of the accelerometer (m/s^2) and gyroscope (deg/s) axes
+    struct LSM6DS33Calibration accelerometer_calibrations[NUM_LSM6DS33_AXES];
+    struct LSM6DS33Calibration gyroscope_calibrations[NUM_LSM6DS33_AXES];
+
+    // The sensor axis that measures each vehicle axis
+    struct LSM6DS33AxisMapping axis_mappings[NUM_LSM6DS33_AXES];
+};
+
+// A calibrated sample, in the frame of the vehicle
+struct LSM6DS33Sample
+{
+    // Acceleration (m/s^2)
+    float acceleration[NUM_LSM6DS33_AXES];
+
+    // Angular velocity (deg/s)
+    float angular_velocity[NUM_LSM6DS33_AXES];
+};
+
+struct LSM6DS33Fifo;
+
+/**
+ * Allocate and initialize the FIFO reader of an LSM6DS33, which parses the
+ * samples read from the FIFO of the LSM6DS33, and publishes them as averaged
+ * samples at the decimated rate and as a stream of every sample
+ * @param config: The configuration of the LSM6DS33, which is copied
+ * @return Pointer to the allocated and initialized FIFO reader
+ */
+struct LSM6DS33Fifo *
+    Io_LSM6DS33Fifo_Create(const struct LSM6DS33Config *config);
+
+/**
+ * Deallocate the memory used by the given FIFO reader
+ * @param fifo: The FIFO reader to deallocate
+ */
+void Io_LSM6DS33Fifo_Destroy(struct LSM6DS33Fifo *fifo);
+
+/**
+ * Configure the LSM6DS33 on the given bus to write both sensors into its FIFO
+ * in continuous mode, and to raise INT1 once the FIFO reaches its watermark
+ * @note The FIFO is emptied, and the FIFO reader is reset to match it
+ * @param fifo: The FIFO reader of the LSM6DS33
+ * @param bus: The bus to access the LSM6DS33's registers through
+ * @return EXIT_CODE_ERROR if the LSM6DS33 didn't identify itself or a register
+ *         couldn't be accessed, else EXIT_CODE_OK
+ */
+ExitCode Io_LSM6DS33Fifo_Configure(
+    struct LSM6DS33Fifo *     fifo,
+    const struct LSM6DS33Bus *bus);
+
+/**
+ * Get the number of bytes to read from FIFO_DATA_OUT_L, given the values of
+ * the FIFO status registers read just before
+ * @param fifo: The FIFO reader of the LSM6DS33
+ * @param fifo_status: The values of FIFO_STATUS1 to FIFO_STATUS4
+ * @return The number of bytes to read into the burst buffer, which is 0 if
+ *         the FIFO is empty
+ */
+size_t Io_LSM6DS33Fifo_GetBurstSize(
+    struct LSM6DS33Fifo *fifo,
+    const uint8_t *      fifo_status);
+
+/**
+ * Get the buffer to read a burst from the FIFO into
+ * @param fifo: The FIFO reader of the LSM6DS33
+ * @return The burst buffer, which holds the maximum burst size
+ */
+uint8_t *Io_LSM6DS33Fifo_GetBurstBuffer(struct LSM6DS33Fifo *fifo);
+
+/**
+ * Parse the burst read into the burst buffer, and publish its samples
+ * @param fifo: The FIFO reader of the LSM6DS33
+ * @param burst_size: The number of bytes read into the burst buffer, as given
+ *                    by Io_LSM6DS33Fifo_GetBurstSize()
+ */
+void Io_LSM6DS33Fifo_ProcessBurst(struct LSM6DS33Fifo *fifo, size_t burst_size);
+
+/**
+ * Check if the FIFO held more data than the latest burst could read
+ * @param fifo: The FIFO reader of the LSM6DS33
+ * @return true if data was left in the FIFO after the latest burst, else false
+ */
+bool Io_LSM6DS33Fifo_HasUnreadData(const struct LSM6DS33Fifo *fifo);
+
+/**
+ * Read the status and then a burst from the FIFO through the given bus, and
+ * publish its samples. This blocks until the bus transfers are done.
+ * @param fifo: The FIFO reader of the LSM6DS33
+ * @param bus: The bus to access the LSM6DS33's registers through
+ * @return EXIT_CODE_ERROR if a register couldn't be read, else EXIT_CODE_OK
+ */
+ExitCode Io_LSM6DS33Fifo_Read(
+    struct LSM6DS33Fifo *     fifo,
+    const struct LSM6DS33Bus *bus);
+
+/**
+ * Get the latest averaged sample, published at the decimated rate
+ * @param fifo: The FIFO reader of the LSM6DS33
+ * @param sample: Set to the latest averaged sample, or all zeros if no
+ *                averaged sample was published yet
+ */
+void Io_LSM6DS33Fifo_GetDecimatedSample(
+    const struct LSM6DS33Fifo *fifo,
+    struct LSM6DS33Sample *    sample);
+
+/**
+ * Take the oldest samples from the stream of every sample read from the FIFO.
+ * The stream has a single reader, and samples are dropped while it is full.
+ * @param fifo: The FIFO reader of the LSM6DS33
+ * @param samples: Set to the samples taken from the stream, oldest first
+ * @param max_num_samples: The maximum number of samples to take
+ * @return The number of samples taken from the stream
+ */
+size_t Io_LSM6DS33Fifo_ReadSamples(
+    struct LSM6DS33Fifo *  fifo,
+    struct LSM6DS33Sample *samples,
+    size_t                 max_num_samples);
+
+/**
+ * Get the number of samples dropped because the stream was full
+ * @param fifo: The FIFO reader of the LSM6DS33
+ * @return The number of samples dropped from the stream
+ */
+uint32_t Io_LSM6DS33Fifo_GetNumDroppedSamples(const struct LSM6DS33Fifo *fifo);
+
+/**
+ * Get the number of bursts that found the LSM6DS33's FIFO had overrun, which
+ * means samples were overwritten before they were read
+ * @param fifo: The FIFO reader of the LSM6DS33
+ * @return The number of FIFO overruns
+ */
+uint32_t Io_LSM6DS33Fifo_GetNumOverruns(const struct LSM6DS33Fifo *fifo);
@@ -15,7 +15,7 @@ struct DcmWorld
     struct Buzzer *           buzzer;
     struct Imu *              imu;
     struct ErrorTable *       error_table;
-    struct WaitSignal *       buzzer_wait_signal;
+    struct SignalEngine *     signal_engine;
     struct Clock *            clock;
 };
 
@@ -49,15 +49,16 @@ struct DcmWorld *App_DcmWorld_Create(
                                                       buzzer_complete_callback,
                                                   .wait_duration_ms =
                                                       BUZZER_ON_DURATION_MS };
-    world->buzzer_wait_signal =
-        App_SharedWaitSignal_Create(0U, is_buzzer_on, world, buzzer_callback);
+    world->signal_engine = App_SharedSignalEngine_Create(0U, world, 1U);
+    App_SharedSignalEngine_AddWaitSignal(
+        world->signal_engine, is_buzzer_on, buzzer_callback);
 
     return world;
 }
 
 void App_DcmWorld_Destroy(struct DcmWorld *world)
 {
-    free(world->buzzer_wait_signal);
+    App_SharedSignalEngine_Destroy(world->signal_engine);
     free(world);
 }
 
@@ -111,7 +112,7 @@ void App_DcmWorld_UpdateWaitSignal(
     const struct DcmWorld *const world,
     uint32_t                     current_ms)
 {
-    App_SharedWaitSignal_Update(world->buzzer_wait_signal, current_ms);
+    App_SharedSignalEngine_Tick(world->signal_engine, current_ms);
 }
 
 struct Clock *App_DcmWorld_GetClock(const struct DcmWorld *const world)
@@ -1,10 +1,53 @@
 #include "App_SharedSetPeriodicCanSignals.h"
 #include "App_SetPeriodicCanSignals.h"
 #include "App_InRangeCheck.h"
+#include "App_SharedMacros.h"
 #include "configs/App_TorqueRequestThresholds.h"
 #include "configs/App_RegenThresholds.h"
+#include "states/App_DriveState.h"
+#include "states/App_FaultState.h"
+#include "states/App_InitState.h"
 
-STATIC_DEFINE_APP_SET_PERIODIC_CAN_SIGNALS_IN_RANGE_CHECK(DcmCanTxInterface)
+STATIC_DEFINE_APP_SET_PERIODIC_CAN_SIGNALS_IN_RANGE_CHECKS(DcmCanTxInterface)
+STATIC_DEFINE_APP_SET_PERIODIC_CAN_SIGNALS_STATE_MACHINE_TRACE(
+    DcmCanTxInterface)
+
+/**
+ * Get the CAN choice used to identify the given state in the state machine
+ * trace, which is the same choice used by the DCM_STATE_MACHINE message
+ * @param state The state to get the CAN choice for
+ * @return The CAN choice for the given state
+ */
+static uint8_t App_GetStateChoice(const struct State *const state)
+{
+    if (state == App_GetInitState())
+    {
+        return CANMSGS_DCM_STATE_MACHINE_STATE_INIT_CHOICE;
+    }
+    else if (state == App_GetDriveState())
+    {
+        return CANMSGS_DCM_STATE_MACHINE_STATE_DRIVE_CHOICE;
+    }
+    else
+    {
+        return CANMSGS_DCM_STATE_MACHINE_STATE_FAULT_CHOICE;
+    }
+}
+
+static const struct InRangeCheckCanSignals imu_can_signals[] = {
+    IN_RANGE_CHECK_CAN_SIGNALS(
+        DCM_NON_CRITICAL_ERRORS,
+        ACCELERATION_X,
+        ACCELERATION_X_OUT_OF_RANGE),
+    IN_RANGE_CHECK_CAN_SIGNALS(
+        DCM_NON_CRITICAL_ERRORS,
+        ACCELERATION_Y,
+        ACCELERATION_Y_OUT_OF_RANGE),
+    IN_RANGE_CHECK_CAN_SIGNALS(
+        DCM_NON_CRITICAL_ERRORS,
+        ACCELERATION_Z,
+        ACCELERATION_Z_OUT_OF_RANGE),
+};
 
 // TODO: Implement PID controller to maintain DC bus power at 80kW
 // #680
@@ -69,30 +112,22 @@ void App_SetPeriodicCanSignals_TorqueRequests(const struct DcmWorld *world)
 
 void App_SetPeriodicCanSignals_Imu(const struct DcmWorld *world)
 {
-    struct Imu *              imu    = App_DcmWorld_GetImu(world);
-    struct DcmCanTxInterface *can_tx = App_DcmWorld_GetCanTx(world);
+    struct Imu *               imu               = App_DcmWorld_GetImu(world);
+    struct InRangeCheck *const in_range_checks[] = {
+        App_Imu_GetAccelerationXInRangeCheck(imu),
+        App_Imu_GetAccelerationYInRangeCheck(imu),
+        App_Imu_GetAccelerationZInRangeCheck(imu),
+    };
 
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, App_Imu_GetAccelerationXInRangeCheck(imu),
-        App_CanTx_SetPeriodicSignal_ACCELERATION_X,
-        App_CanTx_SetPeriodicSignal_ACCELERATION_X_OUT_OF_RANGE,
-        CANMSGS_DCM_NON_CRITICAL_ERRORS_ACCELERATION_X_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_DCM_NON_CRITICAL_ERRORS_ACCELERATION_X_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_DCM_NON_CRITICAL_ERRORS_ACCELERATION_X_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, App_Imu_GetAccelerationYInRangeCheck(imu),
-        App_CanTx_SetPeriodicSignal_ACCELERATION_Y,
-        App_CanTx_SetPeriodicSignal_ACCELERATION_Y_OUT_OF_RANGE,
-        CANMSGS_DCM_NON_CRITICAL_ERRORS_ACCELERATION_Y_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_DCM_NON_CRITICAL_ERRORS_ACCELERATION_Y_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_DCM_NON_CRITICAL_ERRORS_ACCELERATION_Y_OUT_OF_RANGE_OVERFLOW_CHOICE);
+    App_SetPeriodicCanSignals_InRangeChecks(
+        App_DcmWorld_GetCanTx(world), in_range_checks, imu_can_signals,
+        NUM_ELEMENTS_IN_ARRAY(imu_can_signals), NULL);
+}
 
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, App_Imu_GetAccelerationZInRangeCheck(imu),
-        App_CanTx_SetPeriodicSignal_ACCELERATION_Z,
-        App_CanTx_SetPeriodicSignal_ACCELERATION_Z_OUT_OF_RANGE,
-        CANMSGS_DCM_NON_CRITICAL_ERRORS_ACCELERATION_Z_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_DCM_NON_CRITICAL_ERRORS_ACCELERATION_Z_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_DCM_NON_CRITICAL_ERRORS_ACCELERATION_Z_OUT_OF_RANGE_OVERFLOW_CHOICE);
+void App_SetPeriodicCanSignals_StateMachineTrace(
+    struct DcmCanTxInterface *const  can_tx,
+    const struct StateMachine *const state_machine)
+{
+    App_SetPeriodicCanSignals_SharedStateMachineTrace(
+        can_tx, state_machine, App_GetStateChoice);
 }
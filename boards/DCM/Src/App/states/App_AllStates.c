@@ -1,4 +1,5 @@
 #include "states/App_AllStates.h"
+#include "App_SetPeriodicCanSignals.h"
 
 void App_AllStatesRunOnTick1Hz(struct StateMachine *const state_machine)
 {
@@ -7,6 +8,8 @@ void App_AllStatesRunOnTick1Hz(struct StateMachine *const state_machine)
         App_DcmWorld_GetRgbLedSequence(world);
 
     App_SharedRgbLedSequence_Tick(rgb_led_sequence);
+    App_SetPeriodicCanSignals_StateMachineTrace(
+        App_DcmWorld_GetCanTx(world), state_machine);
 }
 
 void App_AllStatesRunOnTick100Hz(struct StateMachine *const state_machine)
@@ -1,26 +1,287 @@
+#include <assert.h>
+#include "main.h"
 #include "Io_LSM6DS33.h"
 
-struct LSM6DS33
+// The Imu's I2C address depends on its SA0 pin, so both addresses are tried
+#define NUM_I2C_ADDRESSES 2U
+#define I2C_TIMEOUT_MS 10U
+
+enum FifoReadState
 {
-    // Acceleration in m/s^2
-    float accel_x;
-    float accel_y;
-    float accel_z;
+    FIFO_READ_IDLE,
+    FIFO_READ_STATUS,
+    FIFO_READ_BURST,
+};
+
+// The FIFO is written at 1.66 kHz and read in bursts of at least 16 samples,
+// which interrupts about every 10 ms and keeps the I2C bus under half busy
+static const struct LSM6DS33Config imu_config = {
+    .odr                      = LSM6DS33_ODR_1660_HZ,
+    .accelerometer_full_scale = LSM6DS33_ACCELEROMETER_FULL_SCALE_8_G,
+    .gyroscope_full_scale     = LSM6DS33_GYROSCOPE_FULL_SCALE_500_DPS,
+    .watermark_num_samples    = 16U,
+    .max_burst_num_samples    = 32U,
+    .decimated_rate_hz        = 100U,
+    .stream_num_samples       = 64U,
+
+    // TODO: Replace with the calibration and mounting of the Imu on the car
+    .accelerometer_calibrations = {
+        { .offset = 0.0f, .scale = 1.0f },
+        { .offset = 0.0f, .scale = 1.0f },
+        { .offset = 0.0f, .scale = 1.0f },
+    },
+    .gyroscope_calibrations = {
+        { .offset = 0.0f, .scale = 1.0f },
+        { .offset = 0.0f, .scale = 1.0f },
+        { .offset = 0.0f, .scale = 1.0f },
+    },
+    .axis_mappings = {
+        { .sensor_axis = LSM6DS33_AXIS_X, .is_inverted = false },
+        { .sensor_axis = LSM6DS33_AXIS_Y, .is_inverted = false },
+        { .sensor_axis = LSM6DS33_AXIS_Z, .is_inverted = false },
+    },
 };
 
-static struct LSM6DS33 lsm_6ds33;
+static const uint16_t i2c_addresses[NUM_I2C_ADDRESSES] = {
+    0x6BU << 1U,
+    0x6AU << 1U,
+};
+
+static I2C_HandleTypeDef *imu_i2c;
+static uint16_t           imu_i2c_address;
+
+static struct LSM6DS33Fifo *       imu_fifo;
+static volatile enum FifoReadState fifo_read_state = FIFO_READ_IDLE;
+static uint8_t fifo_status[LSM6DS33_NUM_FIFO_STATUS_REGISTERS];
+static size_t  burst_size;
+
+/**
+ * Write a register of the Imu, blocking until it is written
+ * @param address: The address of the register to write
+ * @param value: The value to write into the register
+ * @return true if the register was written, else false
+ */
+static bool Io_WriteRegister(uint8_t address, uint8_t value);
+
+/**
+ * Read consecutive registers of the Imu, blocking until they are read
+ * @param address: The address of the first register to read
+ * @param values: Set to the values of the registers
+ * @param size: The number of registers to read
+ * @return true if the registers were read, else false
+ */
+static bool Io_ReadRegisters(uint8_t address, uint8_t *values, size_t size);
+
+/**
+ * Start reading the FIFO status by DMA, which starts reading a burst from the
+ * FIFO once it is done
+ * @note The FIFO read state must have been set to FIFO_READ_STATUS
+ */
+static void Io_StartFifoStatusRead(void);
+
+/**
+ * Check if the FIFO is at or above its watermark, from the level of INT1
+ * @return true if the FIFO is at or above its watermark, else false
+ */
+static bool Io_IsFifoAboveWatermark(void);
+
+static bool Io_WriteRegister(const uint8_t address, uint8_t value)
+{
+    return HAL_I2C_Mem_Write(
+               imu_i2c, imu_i2c_address, address, I2C_MEMADD_SIZE_8BIT, &value,
+               1U, I2C_TIMEOUT_MS) == HAL_OK;
+}
+
+static bool Io_ReadRegisters(
+    const uint8_t  address,
+    uint8_t *const values,
+    const size_t   size)
+{
+    return HAL_I2C_Mem_Read(
+               imu_i2c, imu_i2c_address, address, I2C_MEMADD_SIZE_8BIT, values,
+               (uint16_t)size, I2C_TIMEOUT_MS) == HAL_OK;
+}
+
+static void Io_StartFifoStatusRead(void)
+{
+    // The HAL sends the register address by polling, which only takes a few
+    // bytes' time, before the DMA reads the registers
+    if (HAL_I2C_Mem_Read_DMA(
+            imu_i2c, imu_i2c_address, LSM6DS33_FIFO_STATUS1_REGISTER,
+            I2C_MEMADD_SIZE_8BIT, fifo_status,
+            LSM6DS33_NUM_FIFO_STATUS_REGISTERS) != HAL_OK)
+    {
+        fifo_read_state = FIFO_READ_IDLE;
+    }
+}
+
+static bool Io_IsFifoAboveWatermark(void)
+{
+    return HAL_GPIO_ReadPin(IMU_PIN_1_GPIO_Port, IMU_PIN_1_Pin) == GPIO_PIN_SET;
+}
+
+ExitCode Io_LSM6DS33_Init(I2C_HandleTypeDef *const hi2c)
+{
+    assert(hi2c != NULL);
+    assert(hi2c->hdmarx != NULL);
+
+    imu_i2c  = hi2c;
+    imu_fifo = Io_LSM6DS33Fifo_Create(&imu_config);
+
+    const struct LSM6DS33Bus bus = {
+        .write_register = Io_WriteRegister,
+        .read_registers = Io_ReadRegisters,
+    };
+
+    ExitCode exit_code = EXIT_CODE_ERROR;
+    for (size_t i = 0U; i < NUM_I2C_ADDRESSES && !EXIT_OK(exit_code); i++)
+    {
+        imu_i2c_address = i2c_addresses[i];
+        exit_code       = Io_LSM6DS33Fifo_Configure(imu_fifo, &bus);
+    }
+    RETURN_CODE_IF_EXIT_NOT_OK(exit_code);
+
+    // INT1 is raised on a rising edge of IMU_PIN_1
+    __HAL_GPIO_EXTI_CLEAR_IT(IMU_PIN_1_Pin);
+    HAL_NVIC_SetPriority(EXTI4_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(EXTI4_IRQn);
+
+    return EXIT_CODE_OK;
+}
+
+void Io_LSM6DS33_CheckForMissedWatermark(void)
+{
+    if (imu_i2c == NULL || !Io_IsFifoAboveWatermark())
+    {
+        return;
+    }
+
+    // The FIFO read state is otherwise only changed from interrupts, which
+    // must not start a read of their own in between
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    const bool is_idle = fifo_read_state == FIFO_READ_IDLE;
+    if (is_idle)
+    {
+        fifo_read_state = FIFO_READ_STATUS;
+    }
+    __set_PRIMASK(primask);
+
+    if (is_idle)
+    {
+        Io_StartFifoStatusRead();
+    }
+}
+
+float Io_LSM6DS33_GetAccelerationX(void)
+{
+    struct LSM6DS33Sample sample;
+    Io_LSM6DS33Fifo_GetDecimatedSample(imu_fifo, &sample);
+    return sample.acceleration[LSM6DS33_AXIS_X];
+}
+
+float Io_LSM6DS33_GetAccelerationY(void)
+{
+    struct LSM6DS33Sample sample;
+    Io_LSM6DS33Fifo_GetDecimatedSample(imu_fifo, &sample);
+    return sample.acceleration[LSM6DS33_AXIS_Y];
+}
+
+float Io_LSM6DS33_GetAccelerationZ(void)
+{
+    struct LSM6DS33Sample sample;
+    Io_LSM6DS33Fifo_GetDecimatedSample(imu_fifo, &sample);
+    return sample.acceleration[LSM6DS33_AXIS_Z];
+}
 
-float Io_LSM6DS33_GetAccelerationX()
+float Io_LSM6DS33_GetAngularVelocityX(void)
 {
-    return lsm_6ds33.accel_x;
+    struct LSM6DS33Sample sample;
+    Io_LSM6DS33Fifo_GetDecimatedSample(imu_fifo, &sample);
+    return sample.angular_velocity[LSM6DS33_AXIS_X];
 }
 
-float Io_LSM6DS33_GetAccelerationY()
+float Io_LSM6DS33_GetAngularVelocityY(void)
 {
-    return lsm_6ds33.accel_y;
+    struct LSM6DS33Sample sample;
+    Io_LSM6DS33Fifo_GetDecimatedSample(imu_fifo, &sample);
+    return sample.angular_velocity[LSM6DS33_AXIS_Y];
+}
+
+float Io_LSM6DS33_GetAngularVelocityZ(void)
+{
+    struct LSM6DS33Sample sample;
+    Io_LSM6DS33Fifo_GetDecimatedSample(imu_fifo, &sample);
+    return sample.angular_velocity[LSM6DS33_AXIS_Z];
+}
+
+size_t Io_LSM6DS33_ReadSamples(
+    struct LSM6DS33Sample *const samples,
+    const size_t                 max_num_samples)
+{
+    return Io_LSM6DS33Fifo_ReadSamples(imu_fifo, samples, max_num_samples);
+}
+
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+    if (GPIO_Pin == IMU_PIN_1_Pin && fifo_read_state == FIFO_READ_IDLE)
+    {
+        fifo_read_state = FIFO_READ_STATUS;
+        Io_StartFifoStatusRead();
+    }
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c != imu_i2c)
+    {
+        return;
+    }
+
+    if (fifo_read_state == FIFO_READ_STATUS)
+    {
+        burst_size = Io_LSM6DS33Fifo_GetBurstSize(imu_fifo, fifo_status);
+        if (burst_size == 0U)
+        {
+            fifo_read_state = FIFO_READ_IDLE;
+            return;
+        }
+
+        fifo_read_state = FIFO_READ_BURST;
+        if (HAL_I2C_Mem_Read_DMA(
+                imu_i2c, imu_i2c_address, LSM6DS33_FIFO_DATA_OUT_L_REGISTER,
+                I2C_MEMADD_SIZE_8BIT, Io_LSM6DS33Fifo_GetBurstBuffer(imu_fifo),
+                (uint16_t)burst_size) != HAL_OK)
+        {
+            fifo_read_state = FIFO_READ_IDLE;
+        }
+    }
+    else if (fifo_read_state == FIFO_READ_BURST)
+    {
+        Io_LSM6DS33Fifo_ProcessBurst(imu_fifo, burst_size);
+
+        // INT1 only interrupts on its rising edge, so the FIFO is read again
+        // straight away if it is still at or above its watermark
+        if (Io_LSM6DS33Fifo_HasUnreadData(imu_fifo) ||
+            Io_IsFifoAboveWatermark())
+        {
+            fifo_read_state = FIFO_READ_STATUS;
+            Io_StartFifoStatusRead();
+        }
+        else
+        {
+            fifo_read_state = FIFO_READ_IDLE;
+        }
+    }
 }
 
-float Io_LSM6DS33_GetAccelerationZ()
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
 {
-    return lsm_6ds33.accel_z;
+    if (hi2c == imu_i2c)
+    {
+        // The samples of the failed transfer are lost, and the FIFO is read
+        // again on the next watermark, or by
+        // Io_LSM6DS33_CheckForMissedWatermark
+        fifo_read_state = FIFO_READ_IDLE;
+    }
 }
@@ -0,0 +1,547 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Io_LSM6DS33Fifo.h"
+
+// Register addresses and fields, from the LSM6DS33 datasheet:
+// https://www.pololu.com/file/0J1087/LSM6DS33.pdf
+#define FIFO_CTRL1_REGISTER 0x06U
+#define FIFO_CTRL2_REGISTER 0x07U
+#define FIFO_CTRL3_REGISTER 0x08U
+#define FIFO_CTRL5_REGISTER 0x0AU
+#define INT1_CTRL_REGISTER 0x0DU
+#define WHO_AM_I_REGISTER 0x0FU
+#define CTRL1_XL_REGISTER 0x10U
+#define CTRL2_G_REGISTER 0x11U
+#define CTRL3_C_REGISTER 0x12U
+
+#define WHO_AM_I_VALUE 0x69U
+
+// FIFO_CTRL2
+#define FIFO_THRESHOLD_HIGH_MASK 0x0FU
+
+// FIFO_CTRL3: write every sample of both sensors into the FIFO
+#define FIFO_GYROSCOPE_NO_DECIMATION (0x01U << 3U)
+#define FIFO_ACCELEROMETER_NO_DECIMATION 0x01U
+
+// FIFO_CTRL5
+#define FIFO_ODR_SHIFT 3U
+#define FIFO_MODE_BYPASS 0x00U
+#define FIFO_MODE_CONTINUOUS 0x06U
+
+// INT1_CTRL
+#define INT1_FIFO_THRESHOLD 0x08U
+
+// CTRL1_XL and CTRL2_G
+#define ODR_SHIFT 4U
+#define FULL_SCALE_SHIFT 2U
+
+// CTRL3_C: only update the output registers once both of their bytes were
+// read, and increment the register address when reading several registers
+#define BLOCK_DATA_UPDATE 0x40U
+#define AUTO_INCREMENT 0x04U
+
+// FIFO_STATUS2
+#define FIFO_OVERRUN 0x40U
+#define FIFO_EMPTY 0x10U
+#define FIFO_NUM_UNREAD_WORDS_HIGH_MASK 0x0FU
+
+// FIFO_STATUS4
+#define FIFO_PATTERN_HIGH_MASK 0x03U
+
+// The FIFO holds 8 kB, and its watermark is given in 16-bit words
+#define FIFO_NUM_WORDS 4096U
+
+// The index of the first word of each sensor's axes in a FIFO sample
+#define FIRST_GYROSCOPE_WORD 0U
+#define FIRST_ACCELEROMETER_WORD 3U
+
+static const float STANDARD_GRAVITY_MS2 = 9.80665f;
+
+// The register values of the output data rates, which are the same for the
+// sensors and the FIFO, and the output data rates (Hz)
+static const uint8_t  odr_register_values[] = { 0x07U, 0x08U };
+static const uint32_t odr_frequencies_hz[]  = { 833U, 1666U };
+
+// The register values and sensitivities (mg/LSB) of the accelerometer's full
+// scales, in the order of enum LSM6DS33AccelerometerFullScale
+static const uint8_t accelerometer_full_scale_register_values[] = {
+    0x00U,
+    0x02U,
+    0x03U,
+    0x01U,
+};
+static const float accelerometer_sensitivities_mg[] = {
+    0.061f,
+    0.122f,
+    0.244f,
+    0.488f,
+};
+
+// The register values and sensitivities (mdps/LSB) of the gyroscope's full
+// scales, in the order of enum LSM6DS33GyroscopeFullScale
+static const uint8_t gyroscope_full_scale_register_values[] = {
+    0x00U,
+    0x01U,
+    0x02U,
+    0x03U,
+};
+static const float gyroscope_sensitivities_mdps[] = {
+    8.75f,
+    17.5f,
+    35.0f,
+    70.0f,
+};
+
+struct LSM6DS33Fifo
+{
+    struct LSM6DS33Config config;
+
+    // The calibration and axis mapping of every vehicle axis, folded into the
+    // sensor axis it is measured by and a gain and offset from its raw value
+    size_t source_axes[NUM_LSM6DS33_AXES];
+    float  accelerometer_gains[NUM_LSM6DS33_AXES];
+    float  accelerometer_offsets[NUM_LSM6DS33_AXES];
+    float  gyroscope_gains[NUM_LSM6DS33_AXES];
+    float  gyroscope_offsets[NUM_LSM6DS33_AXES];
+
+    uint8_t *burst_buffer;
+    size_t   max_burst_num_words;
+
+    // The words of the sample being parsed, which may be split across bursts.
+    // The sample is dropped if a burst doesn't start from the word it expects.
+    int16_t words[LSM6DS33_NUM_FIFO_WORDS_PER_SAMPLE];
+    size_t  next_word;
+    bool    is_sample_intact;
+
+    bool     has_unread_data;
+    uint32_t num_overruns;
+
+    // The samples are summed until the next averaged sample is due, which is
+    // once the phase has accumulated the output data rate
+    struct LSM6DS33Sample sum;
+    size_t                num_summed_samples;
+    uint32_t              decimation_phase;
+
+    // The averaged sample is published under a sequence lock: the sequence
+    // number is odd while it is being written, and changes whenever it has
+    // been written, so a reader can tell if it was interrupted by a writer
+    volatile uint32_t sequence;
+    volatile float    decimated_acceleration[NUM_LSM6DS33_AXES];
+    volatile float    decimated_angular_velocity[NUM_LSM6DS33_AXES];
+
+    // The stream has a single writer and a single reader, which each only
+    // advance their own count. The counts wrap around, so the stream must hold
+    // a power of two samples for them to keep indexing the stream in order.
+    struct LSM6DS33Sample *stream;
+    volatile uint32_t      num_written_samples;
+    volatile uint32_t      num_read_samples;
+    volatile uint32_t      num_dropped_samples;
+};
+
+/**
+ * Clear the sample being parsed, the sum of the samples being averaged, and the
+ * state of the latest burst
+ * @param fifo: The FIFO reader to reset
+ */
+static void Io_Reset(struct LSM6DS33Fifo *fifo);
+
+/**
+ * Convert the sample whose words were just parsed, and publish it
+ * @param fifo: The FIFO reader that parsed the sample
+ */
+static void Io_PublishSample(struct LSM6DS33Fifo *fifo);
+
+/**
+ * Add the given sample to the stream, unless the stream is full
+ * @param fifo: The FIFO reader with the stream
+ * @param sample: The sample to add to the stream
+ */
+static void Io_WriteSampleToStream(
+    struct LSM6DS33Fifo *        fifo,
+    const struct LSM6DS33Sample *sample);
+
+/**
+ * Add the given sample to the sum being averaged, and publish the average once
+ * it is due
+ * @param fifo: The FIFO reader with the average
+ * @param sample: The sample to add to the sum
+ */
+static void Io_DecimateSample(
+    struct LSM6DS33Fifo *        fifo,
+    const struct LSM6DS33Sample *sample);
+
+static void Io_Reset(struct LSM6DS33Fifo *const fifo)
+{
+    fifo->next_word        = 0U;
+    fifo->is_sample_intact = true;
+    fifo->has_unread_data  = false;
+
+    memset(&fifo->sum, 0, sizeof(fifo->sum));
+    fifo->num_summed_samples = 0U;
+    fifo->decimation_phase   = 0U;
+}
+
+static void Io_PublishSample(struct LSM6DS33Fifo *const fifo)
+{
+    struct LSM6DS33Sample sample;
+
+    for (size_t i = 0U; i < NUM_LSM6DS33_AXES; i++)
+    {
+        const size_t source_axis = fifo->source_axes[i];
+
+        sample.acceleration[i] =
+            fifo->accelerometer_gains[i] *
+                (float)fifo->words[FIRST_ACCELEROMETER_WORD + source_axis] +
+            fifo->accelerometer_offsets[i];
+        sample.angular_velocity[i] =
+            fifo->gyroscope_gains[i] *
+                (float)fifo->words[FIRST_GYROSCOPE_WORD + source_axis] +
+            fifo->gyroscope_offsets[i];
+    }
+
+    Io_WriteSampleToStream(fifo, &sample);
+    Io_DecimateSample(fifo, &sample);
+}
+
+static void Io_WriteSampleToStream(
+    struct LSM6DS33Fifo *const         fifo,
+    const struct LSM6DS33Sample *const sample)
+{
+    const uint32_t num_written_samples = fifo->num_written_samples;
+
+    if (num_written_samples - fifo->num_read_samples >=
+        fifo->config.stream_num_samples)
+    {
+        fifo->num_dropped_samples++;
+        return;
+    }
+
+    fifo->stream[num_written_samples % fifo->config.stream_num_samples] =
+        *sample;
+    fifo->num_written_samples = num_written_samples + 1U;
+}
+
+static void Io_DecimateSample(
+    struct LSM6DS33Fifo *const         fifo,
+    const struct LSM6DS33Sample *const sample)
+{
+    for (size_t i = 0U; i < NUM_LSM6DS33_AXES; i++)
+    {
+        fifo->sum.acceleration[i] += sample->acceleration[i];
+        fifo->sum.angular_velocity[i] += sample->angular_velocity[i];
+    }
+    fifo->num_summed_samples++;
+
+    // The output data rate is rarely a multiple of the decimated rate, so the
+    // number of samples averaged alternates to keep the decimated rate exact
+    fifo->decimation_phase += fifo->config.decimated_rate_hz;
+    const uint32_t odr_hz = odr_frequencies_hz[fifo->config.odr];
+    if (fifo->decimation_phase < odr_hz)
+    {
+        return;
+    }
+    fifo->decimation_phase -= odr_hz;
+
+    const float scale = 1.0f / (float)fifo->num_summed_samples;
+
+    fifo->sequence++;
+    for (size_t i = 0U; i < NUM_LSM6DS33_AXES; i++)
+    {
+        fifo->decimated_acceleration[i] = fifo->sum.acceleration[i] * scale;
+        fifo->decimated_angular_velocity[i] =
+            fifo->sum.angular_velocity[i] * scale;
+    }
+    fifo->sequence++;
+
+    memset(&fifo->sum, 0, sizeof(fifo->sum));
+    fifo->num_summed_samples = 0U;
+}
+
+struct LSM6DS33Fifo *
+    Io_LSM6DS33Fifo_Create(const struct LSM6DS33Config *const config)
+{
+    assert(config != NULL);
+    assert(config->watermark_num_samples > 0U);
+    assert(
+        config->watermark_num_samples * LSM6DS33_NUM_FIFO_WORDS_PER_SAMPLE <
+        FIFO_NUM_WORDS);
+    assert(config->max_burst_num_samples >= config->watermark_num_samples);
+    assert(config->decimated_rate_hz > 0U);
+    assert(config->decimated_rate_hz <= odr_frequencies_hz[config->odr]);
+    assert(config->stream_num_samples > 0U);
+    assert(
+        (config->stream_num_samples & (config->stream_num_samples - 1U)) == 0U);
+
+    struct LSM6DS33Fifo *const fifo = malloc(sizeof(struct LSM6DS33Fifo));
+    assert(fifo != NULL);
+
+    fifo->config = *config;
+    fifo->max_burst_num_words =
+        config->max_burst_num_samples * LSM6DS33_NUM_FIFO_WORDS_PER_SAMPLE;
+    fifo->burst_buffer = malloc(2U * fifo->max_burst_num_words);
+    fifo->stream =
+        malloc(config->stream_num_samples * sizeof(struct LSM6DS33Sample));
+    assert(fifo->burst_buffer != NULL);
+    assert(fifo->stream != NULL);
+
+    const float accelerometer_sensitivity =
+        accelerometer_sensitivities_mg[config->accelerometer_full_scale] *
+        1e-3f * STANDARD_GRAVITY_MS2;
+    const float gyroscope_sensitivity =
+        gyroscope_sensitivities_mdps[config->gyroscope_full_scale] * 1e-3f;
+
+    for (size_t i = 0U; i < NUM_LSM6DS33_AXES; i++)
+    {
+        const size_t source_axis = config->axis_mappings[i].sensor_axis;
+        assert(source_axis < NUM_LSM6DS33_AXES);
+
+        const float sign = config->axis_mappings[i].is_inverted ? -1.0f : 1.0f;
+        const struct LSM6DS33Calibration *const accelerometer_calibration =
+            &config->accelerometer_calibrations[source_axis];
+        const struct LSM6DS33Calibration *const gyroscope_calibration =
+            &config->gyroscope_calibrations[source_axis];
+
+        fifo->source_axes[i] = source_axis;
+        fifo->accelerometer_gains[i] =
+            sign * accelerometer_sensitivity * accelerometer_calibration->scale;
+        fifo->accelerometer_offsets[i] = -sign *
+                                         accelerometer_calibration->offset *
+                                         accelerometer_calibration->scale;
+        fifo->gyroscope_gains[i] =
+            sign * gyroscope_sensitivity * gyroscope_calibration->scale;
+        fifo->gyroscope_offsets[i] = -sign * gyroscope_calibration->offset *
+                                     gyroscope_calibration->scale;
+
+        fifo->decimated_acceleration[i]     = 0.0f;
+        fifo->decimated_angular_velocity[i] = 0.0f;
+    }
+
+    fifo->num_overruns        = 0U;
+    fifo->sequence            = 0U;
+    fifo->num_written_samples = 0U;
+    fifo->num_read_samples    = 0U;
+    fifo->num_dropped_samples = 0U;
+    Io_Reset(fifo);
+
+    return fifo;
+}
+
+void Io_LSM6DS33Fifo_Destroy(struct LSM6DS33Fifo *const fifo)
+{
+    free(fifo->burst_buffer);
+    free(fifo->stream);
+    free(fifo);
+}
+
+ExitCode Io_LSM6DS33Fifo_Configure(
+    struct LSM6DS33Fifo *const      fifo,
+    const struct LSM6DS33Bus *const bus)
+{
+    uint8_t who_am_i;
+    if (!bus->read_registers(WHO_AM_I_REGISTER, &who_am_i, 1U) ||
+        who_am_i != WHO_AM_I_VALUE)
+    {
+        return EXIT_CODE_ERROR;
+    }
+
+    const struct LSM6DS33Config *const config = &fifo->config;
+    const uint8_t                      odr = odr_register_values[config->odr];
+    const size_t                       watermark_num_words =
+        config->watermark_num_samples * LSM6DS33_NUM_FIFO_WORDS_PER_SAMPLE;
+
+    // The FIFO is emptied by switching it to bypass mode, before the sensors
+    // are configured and it starts filling up again
+    const uint8_t registers[][2] = {
+        { CTRL3_C_REGISTER, BLOCK_DATA_UPDATE | AUTO_INCREMENT },
+        { FIFO_CTRL5_REGISTER, FIFO_MODE_BYPASS },
+        { CTRL1_XL_REGISTER,
+          (uint8_t)(
+              odr << ODR_SHIFT | accelerometer_full_scale_register_values
+                                         [config->accelerometer_full_scale]
+                                     << FULL_SCALE_SHIFT) },
+        { CTRL2_G_REGISTER,
+          (uint8_t)(
+              odr << ODR_SHIFT |
+              gyroscope_full_scale_register_values[config->gyroscope_full_scale]
+                  << FULL_SCALE_SHIFT) },
+        { FIFO_CTRL1_REGISTER, (uint8_t)(watermark_num_words & 0xFFU) },
+        { FIFO_CTRL2_REGISTER,
+          (uint8_t)((watermark_num_words >> 8U) & FIFO_THRESHOLD_HIGH_MASK) },
+        { FIFO_CTRL3_REGISTER,
+          FIFO_GYROSCOPE_NO_DECIMATION | FIFO_ACCELEROMETER_NO_DECIMATION },
+        { INT1_CTRL_REGISTER, INT1_FIFO_THRESHOLD },
+        { FIFO_CTRL5_REGISTER,
+          (uint8_t)(odr << FIFO_ODR_SHIFT | FIFO_MODE_CONTINUOUS) },
+    };
+
+    for (size_t i = 0U; i < sizeof(registers) / sizeof(registers[0]); i++)
+    {
+        if (!bus->write_register(registers[i][0], registers[i][1]))
+        {
+            return EXIT_CODE_ERROR;
+        }
+    }
+
+    Io_Reset(fifo);
+
+    return EXIT_CODE_OK;
+}
+
+size_t Io_LSM6DS33Fifo_GetBurstSize(
+    struct LSM6DS33Fifo *const fifo,
+    const uint8_t *const       fifo_status)
+{
+    if ((fifo_status[1] & FIFO_OVERRUN) != 0U)
+    {
+        fifo->num_overruns++;
+    }
+
+    if ((fifo_status[1] & FIFO_EMPTY) != 0U)
+    {
+        fifo->has_unread_data = false;
+        return 0U;
+    }
+
+    const size_t num_unread_words =
+        (size_t)fifo_status[0] |
+        (size_t)(fifo_status[1] & FIFO_NUM_UNREAD_WORDS_HIGH_MASK) << 8U;
+    const size_t pattern = (size_t)fifo_status[2] |
+                           (size_t)(fifo_status[3] & FIFO_PATTERN_HIGH_MASK)
+                               << 8U;
+
+    // The pattern is the word the FIFO is going to output next. It only skips
+    // ahead of the word the FIFO reader expects if samples were overwritten.
+    if (pattern != fifo->next_word)
+    {
+        fifo->next_word        = pattern % LSM6DS33_NUM_FIFO_WORDS_PER_SAMPLE;
+        fifo->is_sample_intact = fifo->next_word == 0U;
+    }
+
+    const size_t num_burst_words = num_unread_words < fifo->max_burst_num_words
+                                       ? num_unread_words
+                                       : fifo->max_burst_num_words;
+    fifo->has_unread_data = num_unread_words > num_burst_words;
+
+    return 2U * num_burst_words;
+}
+
+uint8_t *Io_LSM6DS33Fifo_GetBurstBuffer(struct LSM6DS33Fifo *const fifo)
+{
+    return fifo->burst_buffer;
+}
+
+void Io_LSM6DS33Fifo_ProcessBurst(
+    struct LSM6DS33Fifo *const fifo,
+    const size_t               burst_size)
+{
+    assert(burst_size <= 2U * fifo->max_burst_num_words);
+
+    for (size_t i = 0U; i + 1U < burst_size; i += 2U)
+    {
+        fifo->words[fifo->next_word] = (int16_t)(
+            (uint16_t)fifo->burst_buffer[i] |
+            (uint16_t)fifo->burst_buffer[i + 1U] << 8U);
+        fifo->next_word++;
+
+        if (fifo->next_word == LSM6DS33_NUM_FIFO_WORDS_PER_SAMPLE)
+        {
+            if (fifo->is_sample_intact)
+            {
+                Io_PublishSample(fifo);
+            }
+            fifo->next_word        = 0U;
+            fifo->is_sample_intact = true;
+        }
+    }
+}
+
+bool Io_LSM6DS33Fifo_HasUnreadData(const struct LSM6DS33Fifo *const fifo)
+{
+    return fifo->has_unread_data;
+}
+
+ExitCode Io_LSM6DS33Fifo_Read(
+    struct LSM6DS33Fifo *const      fifo,
+    const struct LSM6DS33Bus *const bus)
+{
+    uint8_t fifo_status[LSM6DS33_NUM_FIFO_STATUS_REGISTERS];
+    if (!bus->read_registers(
+            LSM6DS33_FIFO_STATUS1_REGISTER, fifo_status,
+            LSM6DS33_NUM_FIFO_STATUS_REGISTERS))
+    {
+        return EXIT_CODE_ERROR;
+    }
+
+    const size_t burst_size = Io_LSM6DS33Fifo_GetBurstSize(fifo, fifo_status);
+    if (burst_size == 0U)
+    {
+        return EXIT_CODE_OK;
+    }
+
+    if (!bus->read_registers(
+            LSM6DS33_FIFO_DATA_OUT_L_REGISTER, fifo->burst_buffer, burst_size))
+    {
+        return EXIT_CODE_ERROR;
+    }
+
+    Io_LSM6DS33Fifo_ProcessBurst(fifo, burst_size);
+
+    return EXIT_CODE_OK;
+}
+
+void Io_LSM6DS33Fifo_GetDecimatedSample(
+    const struct LSM6DS33Fifo *const fifo,
+    struct LSM6DS33Sample *const     sample)
+{
+    // Copy the sample again if it was being written, or was written while it
+    // was being copied. This assumes that the sample is written from an
+    // interrupt that can preempt this function, but not the other way around.
+    uint32_t sequence;
+    do
+    {
+        sequence = fifo->sequence;
+        for (size_t i = 0U; i < NUM_LSM6DS33_AXES; i++)
+        {
+            sample->acceleration[i]     = fifo->decimated_acceleration[i];
+            sample->angular_velocity[i] = fifo->decimated_angular_velocity[i];
+        }
+    } while ((sequence % 2U) != 0U || sequence != fifo->sequence);
+}
+
+size_t Io_LSM6DS33Fifo_ReadSamples(
+    struct LSM6DS33Fifo *const   fifo,
+    struct LSM6DS33Sample *const samples,
+    const size_t                 max_num_samples)
+{
+    const uint32_t num_read_samples = fifo->num_read_samples;
+    size_t num_samples = (size_t)(fifo->num_written_samples - num_read_samples);
+    if (num_samples > max_num_samples)
+    {
+        num_samples = max_num_samples;
+    }
+
+    for (size_t i = 0U; i < num_samples; i++)
+    {
+        samples[i] =
+            fifo->stream
+                [(num_read_samples + i) % fifo->config.stream_num_samples];
+    }
+
+    // Only free the samples once they have been copied, so the writer can't
+    // overwrite them while they are being copied
+    fifo->num_read_samples = num_read_samples + (uint32_t)num_samples;
+
+    return num_samples;
+}
+
+uint32_t
+    Io_LSM6DS33Fifo_GetNumDroppedSamples(const struct LSM6DS33Fifo *const fifo)
+{
+    return fifo->num_dropped_samples;
+}
+
+uint32_t Io_LSM6DS33Fifo_GetNumOverruns(const struct LSM6DS33Fifo *const fifo)
+{
+    return fifo->num_overruns;
+}
@@ -30,6 +30,7 @@
 #include "Io_CanTx.h"
 #include "Io_CanRx.h"
 #include "Io_SharedCan.h"
+#include "Io_SharedCycleCounter.h"
 #include "Io_SharedHardFaultHandler.h"
 #include "Io_StackWaterMark.h"
 #include "Io_SoftwareWatchdog.h"
@@ -66,6 +67,9 @@ ADC_HandleTypeDef hadc1;
 
 CAN_HandleTypeDef hcan;
 
+I2C_HandleTypeDef hi2c1;
+DMA_HandleTypeDef hdma_i2c1_rx;
+
 IWDG_HandleTypeDef hiwdg;
 
 osThreadId          Task1HzHandle;
@@ -100,9 +104,11 @@ struct Clock *            clock;
 /* Private function prototypes -----------------------------------------------*/
 void        SystemClock_Config(void);
 static void MX_GPIO_Init(void);
+static void MX_DMA_Init(void);
 static void MX_ADC1_Init(void);
 static void MX_CAN_Init(void);
 static void MX_IWDG_Init(void);
+static void MX_I2C1_Init(void);
 void        RunTask1Hz(void const *argument);
 void        RunTask1kHz(void const *argument);
 void        RunTaskCanRx(void const *argument);
@@ -160,13 +166,18 @@ int main(void)
 
     /* Initialize all configured peripherals */
     MX_GPIO_Init();
+    MX_DMA_Init();
     MX_ADC1_Init();
     MX_CAN_Init();
     MX_IWDG_Init();
+    MX_I2C1_Init();
     /* USER CODE BEGIN 2 */
     __HAL_DBGMCU_FREEZE_IWDG();
     Io_SharedHardFaultHandler_Init();
 
+    // The accelerations stay at 0 m/s^2 if the Imu doesn't respond
+    Io_LSM6DS33_Init(&hi2c1);
+
     can_tx = App_CanTx_Create(
         Io_CanTx_EnqueueNonPeriodicMsg_DCM_STARTUP,
         Io_CanTx_EnqueueNonPeriodicMsg_DCM_WATCHDOG_TIMEOUT);
@@ -204,6 +215,9 @@ int main(void)
     Io_SoftwareWatchdog_Init(can_tx);
 
     state_machine = App_SharedStateMachine_Create(world, App_GetInitState());
+    Io_SharedCycleCounter_Init();
+    App_SharedStateMachine_SetCycleCounter(
+        state_machine, Io_SharedCycleCounter_GetCycleCount);
 
     struct CanMsgs_dcm_startup_t payload = { .dummy = 0 };
     App_CanTx_SendNonPeriodicMsg_DCM_STARTUP(can_tx, &payload);
@@ -424,6 +438,50 @@ static void MX_CAN_Init(void)
     /* USER CODE END CAN_Init 2 */
 }
 
+/**
+ * @brief I2C1 Initialization Function
+ * @param None
+ * @retval None
+ */
+static void MX_I2C1_Init(void)
+{
+    /* USER CODE BEGIN I2C1_Init 0 */
+
+    /* USER CODE END I2C1_Init 0 */
+
+    /* USER CODE BEGIN I2C1_Init 1 */
+    // I2C1 is clocked by the 8 MHz HSI, and runs the Imu in fast mode (400 kHz)
+    /* USER CODE END I2C1_Init 1 */
+    hi2c1.Instance              = I2C1;
+    hi2c1.Init.Timing           = 0x0000020B;
+    hi2c1.Init.OwnAddress1      = 0;
+    hi2c1.Init.AddressingMode   = I2C_ADDRESSINGMODE_7BIT;
+    hi2c1.Init.DualAddressMode  = I2C_DUALADDRESS_DISABLE;
+    hi2c1.Init.OwnAddress2      = 0;
+    hi2c1.Init.OwnAddress2Masks = I2C_OA2_NOMASK;
+    hi2c1.Init.GeneralCallMode  = I2C_GENERALCALL_DISABLE;
+    hi2c1.Init.NoStretchMode    = I2C_NOSTRETCH_DISABLE;
+    if (HAL_I2C_Init(&hi2c1) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    /** Configure Analogue filter
+     */
+    if (HAL_I2CEx_ConfigAnalogFilter(&hi2c1, I2C_ANALOGFILTER_ENABLE) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    /** Configure Digital filter
+     */
+    if (HAL_I2CEx_ConfigDigitalFilter(&hi2c1, 0) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    /* USER CODE BEGIN I2C1_Init 2 */
+
+    /* USER CODE END I2C1_Init 2 */
+}
+
 /**
  * @brief IWDG Initialization Function
  * @param None
@@ -452,6 +510,20 @@ static void MX_IWDG_Init(void)
     /* USER CODE END IWDG_Init 2 */
 }
 
+/**
+ * Enable DMA controller clock
+ */
+static void MX_DMA_Init(void)
+{
+    /* DMA controller clock enable */
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    /* DMA interrupt init */
+    /* DMA1_Channel7_IRQn interrupt configuration */
+    HAL_NVIC_SetPriority(DMA1_Channel7_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Channel7_IRQn);
+}
+
 /**
  * @brief GPIO Initialization Function
  * @param None
@@ -521,14 +593,6 @@ static void MX_GPIO_Init(void)
     GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING;
     GPIO_InitStruct.Pull = GPIO_NOPULL;
     HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
-
-    /*Configure GPIO pins : PB6 PB7 */
-    GPIO_InitStruct.Pin       = GPIO_PIN_6 | GPIO_PIN_7;
-    GPIO_InitStruct.Mode      = GPIO_MODE_AF_OD;
-    GPIO_InitStruct.Pull      = GPIO_PULLUP;
-    GPIO_InitStruct.Speed     = GPIO_SPEED_FREQ_HIGH;
-    GPIO_InitStruct.Alternate = GPIO_AF4_I2C1;
-    HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
 }
 
 /* USER CODE BEGIN 4 */
@@ -658,6 +722,7 @@ void RunTask100Hz(void const *argument)
     /* Infinite loop */
     for (;;)
     {
+        Io_LSM6DS33_CheckForMissedWatermark();
         App_SharedStateMachine_Tick100Hz(state_machine);
 
         // Watchdog check-in must be the last function called before putting the
@@ -0,0 +1,383 @@
+#include <array>
+#include <deque>
+#include "Test_Dcm.h"
+
+extern "C"
+{
+#include "Io_LSM6DS33Fifo.h"
+}
+
+namespace LSM6DS33FifoTest
+{
+static constexpr float STANDARD_GRAVITY_MS2 = 9.80665f;
+
+// The sensitivities of the full scales used by the tests, from the datasheet
+static constexpr float ACCELEROMETER_8_G_SENSITIVITY_MS2 =
+    0.244e-3f * STANDARD_GRAVITY_MS2;
+static constexpr float GYROSCOPE_500_DPS_SENSITIVITY_DPS = 17.5e-3f;
+
+// The registers of an LSM6DS33 and the words in its FIFO, accessed through a
+// fake bus
+class FakeLSM6DS33
+{
+  public:
+    FakeLSM6DS33()
+    {
+        registers.fill(0U);
+        registers[0x0F] = 0x69U;
+    }
+
+    // Write a sample into the FIFO, as the sensor would
+    void PushSample(
+        const std::array<int16_t, NUM_LSM6DS33_AXES> &gyroscope,
+        const std::array<int16_t, NUM_LSM6DS33_AXES> &accelerometer)
+    {
+        words.insert(words.end(), gyroscope.begin(), gyroscope.end());
+        words.insert(words.end(), accelerometer.begin(), accelerometer.end());
+    }
+
+    // Overwrite the oldest words in the FIFO, as the sensor would on overrun
+    void Overrun(size_t num_words)
+    {
+        words.erase(words.begin(), words.begin() + (long)num_words);
+        pattern = (pattern + num_words) % LSM6DS33_NUM_FIFO_WORDS_PER_SAMPLE;
+        overrun = true;
+    }
+
+    bool WriteRegister(uint8_t address, uint8_t value)
+    {
+        if (fail_writes)
+        {
+            return false;
+        }
+
+        registers[address] = value;
+        return true;
+    }
+
+    bool ReadRegisters(uint8_t address, uint8_t *values, size_t size)
+    {
+        for (size_t i = 0U; i < size; i++)
+        {
+            if (address == LSM6DS33_FIFO_DATA_OUT_L_REGISTER)
+            {
+                // The FIFO outputs the low byte and then the high byte of
+                // every word
+                const uint16_t word = (uint16_t)words.front();
+                values[i]           = (i % 2U == 0U) ? (uint8_t)(word & 0xFFU)
+                                           : (uint8_t)(word >> 8U);
+                if (i % 2U == 1U)
+                {
+                    words.pop_front();
+                    pattern =
+                        (pattern + 1U) % LSM6DS33_NUM_FIFO_WORDS_PER_SAMPLE;
+                }
+            }
+            else
+            {
+                values[i] = ReadRegister((uint8_t)(address + i));
+            }
+        }
+
+        return true;
+    }
+
+    std::array<uint8_t, 128> registers;
+    std::deque<int16_t>      words;
+    bool                     fail_writes = false;
+
+  private:
+    uint8_t ReadRegister(uint8_t address)
+    {
+        switch (address)
+        {
+            case LSM6DS33_FIFO_STATUS1_REGISTER:
+            {
+                return (uint8_t)(words.size() & 0xFFU);
+            }
+            case LSM6DS33_FIFO_STATUS1_REGISTER + 1U:
+            {
+                const uint8_t status = (uint8_t)((words.size() >> 8U) & 0x0FU) |
+                                       (overrun ? 0x40U : 0x00U) |
+                                       (words.empty() ? 0x10U : 0x00U);
+                overrun = false;
+                return status;
+            }
+            case LSM6DS33_FIFO_STATUS1_REGISTER + 2U:
+            {
+                return (uint8_t)(pattern & 0xFFU);
+            }
+            case LSM6DS33_FIFO_STATUS1_REGISTER + 3U:
+            {
+                return (uint8_t)(pattern >> 8U);
+            }
+            default:
+            {
+                return registers[address];
+            }
+        }
+    }
+
+    size_t pattern = 0U;
+    bool   overrun = false;
+};
+
+static FakeLSM6DS33 *fake_lsm6ds33;
+
+static bool WriteRegister(uint8_t address, uint8_t value)
+{
+    return fake_lsm6ds33->WriteRegister(address, value);
+}
+
+static bool ReadRegisters(uint8_t address, uint8_t *values, size_t size)
+{
+    return fake_lsm6ds33->ReadRegisters(address, values, size);
+}
+
+class LSM6DS33FifoTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        fake_lsm6ds33 = &lsm6ds33;
+
+        config.odr                      = LSM6DS33_ODR_1660_HZ;
+        config.accelerometer_full_scale = LSM6DS33_ACCELEROMETER_FULL_SCALE_8_G;
+        config.gyroscope_full_scale     = LSM6DS33_GYROSCOPE_FULL_SCALE_500_DPS;
+        config.watermark_num_samples    = 16U;
+        config.max_burst_num_samples    = 32U;
+        config.decimated_rate_hz        = 100U;
+        config.stream_num_samples       = 64U;
+        for (size_t i = 0U; i < NUM_LSM6DS33_AXES; i++)
+        {
+            config.accelerometer_calibrations[i] = { 0.0f, 1.0f };
+            config.gyroscope_calibrations[i]     = { 0.0f, 1.0f };
+            config.axis_mappings[i] = { (enum LSM6DS33Axis)i, false };
+        }
+    }
+
+    void TearDown() override
+    {
+        if (fifo != NULL)
+        {
+            Io_LSM6DS33Fifo_Destroy(fifo);
+        }
+    }
+
+    void CreateAndConfigure()
+    {
+        fifo = Io_LSM6DS33Fifo_Create(&config);
+        ASSERT_EQ(EXIT_CODE_OK, Io_LSM6DS33Fifo_Configure(fifo, &bus));
+    }
+
+    FakeLSM6DS33             lsm6ds33;
+    const struct LSM6DS33Bus bus    = { WriteRegister, ReadRegisters };
+    struct LSM6DS33Config    config = {};
+    struct LSM6DS33Fifo *    fifo   = NULL;
+};
+
+TEST_F(LSM6DS33FifoTest, configure_fifo_in_continuous_mode_with_watermark)
+{
+    CreateAndConfigure();
+
+    // Block data update and register address auto-increment
+    ASSERT_EQ(0x44U, lsm6ds33.registers[0x12]);
+    // 1.66 kHz, +-8 g
+    ASSERT_EQ(0x8CU, lsm6ds33.registers[0x10]);
+    // 1.66 kHz, 500 dps
+    ASSERT_EQ(0x84U, lsm6ds33.registers[0x11]);
+    // 16 samples of 6 words
+    ASSERT_EQ(96U, lsm6ds33.registers[0x06]);
+    ASSERT_EQ(0U, lsm6ds33.registers[0x07]);
+    // Both sensors without decimation
+    ASSERT_EQ(0x09U, lsm6ds33.registers[0x08]);
+    // FIFO threshold on INT1
+    ASSERT_EQ(0x08U, lsm6ds33.registers[0x0D]);
+    // 1.66 kHz, continuous mode
+    ASSERT_EQ(0x46U, lsm6ds33.registers[0x0A]);
+}
+
+TEST_F(LSM6DS33FifoTest, configure_fails_on_wrong_device_or_bus_error)
+{
+    fifo = Io_LSM6DS33Fifo_Create(&config);
+
+    lsm6ds33.registers[0x0F] = 0x6AU;
+    ASSERT_EQ(EXIT_CODE_ERROR, Io_LSM6DS33Fifo_Configure(fifo, &bus));
+
+    lsm6ds33.registers[0x0F] = 0x69U;
+    lsm6ds33.fail_writes     = true;
+    ASSERT_EQ(EXIT_CODE_ERROR, Io_LSM6DS33Fifo_Configure(fifo, &bus));
+}
+
+TEST_F(LSM6DS33FifoTest, samples_are_calibrated_and_remapped)
+{
+    // The sensor is mounted with its y-axis along the vehicle's x-axis, and its
+    // x-axis opposite to the vehicle's y-axis
+    config.axis_mappings[LSM6DS33_AXIS_X] = { LSM6DS33_AXIS_Y, false };
+    config.axis_mappings[LSM6DS33_AXIS_Y] = { LSM6DS33_AXIS_X, true };
+    config.accelerometer_calibrations[LSM6DS33_AXIS_X] = { 0.5f, 1.0f };
+    config.accelerometer_calibrations[LSM6DS33_AXIS_Z] = { 0.0f, 1.1f };
+    config.gyroscope_calibrations[LSM6DS33_AXIS_Y]     = { 2.0f, 1.0f };
+    CreateAndConfigure();
+
+    lsm6ds33.PushSample({ 100, 200, 300 }, { 1000, 2000, 4000 });
+    ASSERT_EQ(EXIT_CODE_OK, Io_LSM6DS33Fifo_Read(fifo, &bus));
+
+    struct LSM6DS33Sample sample;
+    ASSERT_EQ(1U, Io_LSM6DS33Fifo_ReadSamples(fifo, &sample, 1U));
+
+    ASSERT_FLOAT_EQ(
+        2000 * ACCELEROMETER_8_G_SENSITIVITY_MS2,
+        sample.acceleration[LSM6DS33_AXIS_X]);
+    ASSERT_FLOAT_EQ(
+        -(1000 * ACCELEROMETER_8_G_SENSITIVITY_MS2 - 0.5f),
+        sample.acceleration[LSM6DS33_AXIS_Y]);
+    ASSERT_FLOAT_EQ(
+        4000 * ACCELEROMETER_8_G_SENSITIVITY_MS2 * 1.1f,
+        sample.acceleration[LSM6DS33_AXIS_Z]);
+    ASSERT_FLOAT_EQ(
+        200 * GYROSCOPE_500_DPS_SENSITIVITY_DPS - 2.0f,
+        sample.angular_velocity[LSM6DS33_AXIS_X]);
+    ASSERT_FLOAT_EQ(
+        -100 * GYROSCOPE_500_DPS_SENSITIVITY_DPS,
+        sample.angular_velocity[LSM6DS33_AXIS_Y]);
+    ASSERT_FLOAT_EQ(
+        300 * GYROSCOPE_500_DPS_SENSITIVITY_DPS,
+        sample.angular_velocity[LSM6DS33_AXIS_Z]);
+}
+
+TEST_F(LSM6DS33FifoTest, decimated_samples_average_every_sample_at_100hz)
+{
+    CreateAndConfigure();
+
+    // 1666 Hz isn't a multiple of 100 Hz, so the first average is due on the
+    // 17th sample
+    for (int16_t i = 0; i < 16; i++)
+    {
+        lsm6ds33.PushSample({ 0, 0, 0 }, { i, 0, 0 });
+    }
+    ASSERT_EQ(EXIT_CODE_OK, Io_LSM6DS33Fifo_Read(fifo, &bus));
+
+    struct LSM6DS33Sample sample;
+    Io_LSM6DS33Fifo_GetDecimatedSample(fifo, &sample);
+    ASSERT_EQ(0.0f, sample.acceleration[LSM6DS33_AXIS_X]);
+
+    lsm6ds33.PushSample({ 0, 0, 0 }, { 16, 0, 0 });
+    ASSERT_EQ(EXIT_CODE_OK, Io_LSM6DS33Fifo_Read(fifo, &bus));
+    Io_LSM6DS33Fifo_GetDecimatedSample(fifo, &sample);
+    ASSERT_FLOAT_EQ(
+        8 * ACCELEROMETER_8_G_SENSITIVITY_MS2,
+        sample.acceleration[LSM6DS33_AXIS_X]);
+
+    // Exactly 100 averages are published over a second of samples
+    size_t num_decimated_samples = 1U;
+    float  prev_acceleration     = sample.acceleration[LSM6DS33_AXIS_X];
+    for (int16_t i = 17; i < 1666; i++)
+    {
+        lsm6ds33.PushSample({ 0, 0, 0 }, { i, 0, 0 });
+        ASSERT_EQ(EXIT_CODE_OK, Io_LSM6DS33Fifo_Read(fifo, &bus));
+        Io_LSM6DS33Fifo_GetDecimatedSample(fifo, &sample);
+        if (sample.acceleration[LSM6DS33_AXIS_X] != prev_acceleration)
+        {
+            num_decimated_samples++;
+            prev_acceleration = sample.acceleration[LSM6DS33_AXIS_X];
+        }
+        Io_LSM6DS33Fifo_ReadSamples(fifo, &sample, 1U);
+    }
+    ASSERT_EQ(100U, num_decimated_samples);
+}
+
+TEST_F(LSM6DS33FifoTest, sample_split_across_bursts_is_reassembled)
+{
+    CreateAndConfigure();
+
+    lsm6ds33.PushSample({ 1, 2, 3 }, { 4, 5, 6 });
+    lsm6ds33.PushSample({ 7, 8, 9 }, { 10, 11, 12 });
+
+    // Only a sample and a half were written into the FIFO when it was read
+    const int16_t last_words[] = { 10, 11, 12 };
+    lsm6ds33.words.resize(9U);
+    ASSERT_EQ(EXIT_CODE_OK, Io_LSM6DS33Fifo_Read(fifo, &bus));
+    lsm6ds33.words.insert(lsm6ds33.words.end(), last_words, last_words + 3);
+    ASSERT_EQ(EXIT_CODE_OK, Io_LSM6DS33Fifo_Read(fifo, &bus));
+
+    std::array<struct LSM6DS33Sample, 2> samples;
+    ASSERT_EQ(2U, Io_LSM6DS33Fifo_ReadSamples(fifo, samples.data(), 2U));
+    ASSERT_FLOAT_EQ(
+        8 * GYROSCOPE_500_DPS_SENSITIVITY_DPS,
+        samples[1].angular_velocity[LSM6DS33_AXIS_Y]);
+    ASSERT_FLOAT_EQ(
+        12 * ACCELEROMETER_8_G_SENSITIVITY_MS2,
+        samples[1].acceleration[LSM6DS33_AXIS_Z]);
+}
+
+TEST_F(LSM6DS33FifoTest, sample_cut_by_overrun_is_dropped)
+{
+    CreateAndConfigure();
+
+    lsm6ds33.PushSample({ 1, 2, 3 }, { 4, 5, 6 });
+    lsm6ds33.PushSample({ 7, 8, 9 }, { 10, 11, 12 });
+    lsm6ds33.Overrun(2U);
+    ASSERT_EQ(EXIT_CODE_OK, Io_LSM6DS33Fifo_Read(fifo, &bus));
+
+    std::array<struct LSM6DS33Sample, 2> samples;
+    ASSERT_EQ(1U, Io_LSM6DS33Fifo_ReadSamples(fifo, samples.data(), 2U));
+    ASSERT_FLOAT_EQ(
+        7 * GYROSCOPE_500_DPS_SENSITIVITY_DPS,
+        samples[0].angular_velocity[LSM6DS33_AXIS_X]);
+    ASSERT_EQ(1U, Io_LSM6DS33Fifo_GetNumOverruns(fifo));
+}
+
+TEST_F(LSM6DS33FifoTest, burst_is_limited_to_max_burst_size)
+{
+    CreateAndConfigure();
+
+    for (int16_t i = 0; i < 40; i++)
+    {
+        lsm6ds33.PushSample({ i, 0, 0 }, { 0, 0, 0 });
+    }
+
+    ASSERT_EQ(EXIT_CODE_OK, Io_LSM6DS33Fifo_Read(fifo, &bus));
+    ASSERT_TRUE(Io_LSM6DS33Fifo_HasUnreadData(fifo));
+    ASSERT_EQ(8U * LSM6DS33_NUM_FIFO_WORDS_PER_SAMPLE, lsm6ds33.words.size());
+
+    ASSERT_EQ(EXIT_CODE_OK, Io_LSM6DS33Fifo_Read(fifo, &bus));
+    ASSERT_FALSE(Io_LSM6DS33Fifo_HasUnreadData(fifo));
+    ASSERT_TRUE(lsm6ds33.words.empty());
+}
+
+TEST_F(LSM6DS33FifoTest, full_stream_drops_newest_samples)
+{
+    config.stream_num_samples = 4U;
+    CreateAndConfigure();
+
+    for (int16_t i = 0; i < 6; i++)
+    {
+        lsm6ds33.PushSample({ i, 0, 0 }, { 0, 0, 0 });
+    }
+    ASSERT_EQ(EXIT_CODE_OK, Io_LSM6DS33Fifo_Read(fifo, &bus));
+    ASSERT_EQ(2U, Io_LSM6DS33Fifo_GetNumDroppedSamples(fifo));
+
+    std::array<struct LSM6DS33Sample, 4> samples;
+    ASSERT_EQ(3U, Io_LSM6DS33Fifo_ReadSamples(fifo, samples.data(), 3U));
+    ASSERT_EQ(0.0f, samples[0].angular_velocity[LSM6DS33_AXIS_X]);
+    ASSERT_FLOAT_EQ(
+        2 * GYROSCOPE_500_DPS_SENSITIVITY_DPS,
+        samples[2].angular_velocity[LSM6DS33_AXIS_X]);
+
+    // The stream keeps its order as it wraps around
+    for (int16_t i = 6; i < 9; i++)
+    {
+        lsm6ds33.PushSample({ i, 0, 0 }, { 0, 0, 0 });
+    }
+    ASSERT_EQ(EXIT_CODE_OK, Io_LSM6DS33Fifo_Read(fifo, &bus));
+    ASSERT_EQ(4U, Io_LSM6DS33Fifo_ReadSamples(fifo, samples.data(), 4U));
+    ASSERT_FLOAT_EQ(
+        3 * GYROSCOPE_500_DPS_SENSITIVITY_DPS,
+        samples[0].angular_velocity[LSM6DS33_AXIS_X]);
+    ASSERT_FLOAT_EQ(
+        8 * GYROSCOPE_500_DPS_SENSITIVITY_DPS,
+        samples[3].angular_velocity[LSM6DS33_AXIS_X]);
+}
+
+} // namespace LSM6DS33FifoTest
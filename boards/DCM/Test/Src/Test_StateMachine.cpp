@@ -98,6 +98,7 @@ class DcmStateMachineTest : public BaseStateMachineTest
 
     void TearDown() override
     {
+        DumpTraceIfFailed(state_machine);
         TearDownObject(world, App_DcmWorld_Destroy);
         TearDownObject(state_machine, App_SharedStateMachine_Destroy);
         TearDownObject(can_tx_interface, App_CanTx_Destroy);
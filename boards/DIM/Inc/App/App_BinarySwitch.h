@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
 
 struct BinarySwitch;
 
@@ -24,3 +25,28 @@ void App_BinarySwitch_Destroy(struct BinarySwitch *binary_switch);
  * @return true if the given binary switch is turned on, else false
  */
 bool App_BinarySwitch_IsTurnedOn(const struct BinarySwitch *binary_switch);
+
+/**
+ * Check if the given binary switch was flicked, which is when it was turned
+ * away from where it was and back again within the given time
+ * @note This must be called periodically to catch the changes of the switch
+ * @param binary_switch The binary switch to check if it was flicked
+ * @param current_time_ms The current time, in milliseconds
+ * @param max_flick_time_ms The longest time between the two changes of a flick,
+ *                          in milliseconds
+ * @return true once for every flick of the given binary switch, else false
+ */
+bool App_BinarySwitch_WasFlicked(
+    struct BinarySwitch *binary_switch,
+    uint32_t             current_time_ms,
+    uint32_t             max_flick_time_ms);
+
+/**
+ * Check if the given binary switch is held on, which is where it was last left
+ * for longer than a flick. Unlike App_BinarySwitch_IsTurnedOn(), this doesn't
+ * change while the switch is flicked.
+ * @note This is only updated by App_BinarySwitch_WasFlicked()
+ * @param binary_switch The binary switch to check if it's held on
+ * @return true if the given binary switch is held on, else false
+ */
+bool App_BinarySwitch_IsHeldOn(const struct BinarySwitch *binary_switch);
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "App_SharedExitCode.h"
+#include "App_SharedError.h"
+
+struct DimCanRxInterface;
+struct SevenSegDisplays;
+
+// A page of the dashboard, which shows a single value received over CAN
+struct DashboardPage
+{
+    // Get the value to show from the CAN RX snapshot
+    float (*get_value)(const struct DimCanRxInterface *can_rx_interface);
+
+    // The most digits to show after the decimal point. Fewer are shown if the
+    // value would not fit on the 7-segment displays otherwise.
+    size_t max_num_decimal_places;
+};
+
+struct Dashboard;
+
+/**
+ * Allocate and initialize a dashboard, which shows either the selected page or
+ * the set errors on the given group of 7-segment displays
+ * @param seven_seg_displays The group of 7-segment displays to show the
+ *                           dashboard on
+ * @param pages The pages of the dashboard, which are not copied and must
+ *              outlive the dashboard
+ * @param num_pages The number of pages
+ * @param min_error_display_time_ms The minimum time an error is shown for
+ *                                  before the dashboard shows something else,
+ *                                  unless a more critical error is set
+ * @note This function does __not__ take ownership of the group of 7-segment
+ *       displays passed into it, which must be kept alive for the lifetime of
+ *       the created dashboard
+ * @return A pointer to the created dashboard, whose ownership is given to the
+ *         caller
+ */
+struct Dashboard *App_Dashboard_Create(
+    struct SevenSegDisplays *   seven_seg_displays,
+    const struct DashboardPage *pages,
+    size_t                      num_pages,
+    uint32_t                    min_error_display_time_ms);
+
+/**
+ * Deallocate the memory used by the given dashboard
+ * @param dashboard The dashboard to deallocate
+ */
+void App_Dashboard_Destroy(struct Dashboard *dashboard);
+
+/**
+ * Get the number of pages of the given dashboard
+ * @param dashboard The dashboard to get the number of pages of
+ * @return The number of pages of the given dashboard
+ */
+size_t App_Dashboard_GetNumPages(const struct Dashboard *dashboard);
+
+/**
+ * Select the page the given dashboard shows when no error is shown
+ * @param dashboard The dashboard to select the page of
+ * @param page The index of the page
+ * @return EXIT_CODE_INVALID_ARGS if the given index is out-of-bound
+ */
+ExitCode App_Dashboard_SelectPage(struct Dashboard *dashboard, size_t page);
+
+/**
+ * Get the page the given dashboard shows when no error is shown
+ * @param dashboard The dashboard to get the selected page of
+ * @return The index of the selected page
+ */
+size_t App_Dashboard_GetSelectedPage(const struct Dashboard *dashboard);
+
+/**
+ * Update the given dashboard and show the most important thing on its
+ * 7-segment displays. Errors are shown as their ID plus 500, so they can't be
+ * mistaken for a page. A newly set error is shown for at least the minimum
+ * error display time, even if it clears sooner, and the set errors are shown
+ * in turn from the most critical error to the least critical error. The
+ * 7-segment displays are only set when what they show changes.
+ * @param dashboard The dashboard to tick
+ * @param can_rx_interface The CAN RX interface to get the value of the
+ *                         selected page from
+ * @param errors The errors that are set
+ * @param current_time_ms The current time, in milliseconds
+ */
+void App_Dashboard_Tick(
+    struct Dashboard *              dashboard,
+    const struct DimCanRxInterface *can_rx_interface,
+    const struct ErrorList *        errors,
+    uint32_t                        current_time_ms);
@@ -12,6 +12,7 @@
 #include "App_SharedErrorTable.h"
 #include "App_SharedRgbLed.h"
 #include "App_SharedClock.h"
+#include "App_Dashboard.h"
 
 struct DimWorld;
 
@@ -43,7 +44,8 @@ struct DimWorld *App_DimWorld_Create(
     struct RgbLed *           dim_status_led,
     struct RgbLed *           fsm_status_led,
     struct RgbLed *           pdm_status_led,
-    struct Clock *            clock);
+    struct Clock *            clock,
+    struct Dashboard *        dashboard);
 
 /**
  * Deallocate the memory used by the given world
@@ -188,3 +190,10 @@ struct RgbLed *App_DimWorld_GetPdmStatusLed(const struct DimWorld *world);
  * @return The clock for the given world
  */
 struct Clock *App_DimWorld_GetClock(const struct DimWorld *world);
+
+/**
+ * Get the dashboard for the given world
+ * @param world The world to get dashboard for
+ * @return The dashboard for the given world
+ */
+struct Dashboard *App_DimWorld_GetDashboard(const struct DimWorld *world);
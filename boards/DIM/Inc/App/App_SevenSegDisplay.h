@@ -9,6 +9,9 @@ struct SevenSegHexDigit
     // of displaying "value".
     bool          enabled;
     enum HexDigit value;
+
+    // The decimal point is shown even if "enabled" is false
+    bool decimal_point;
 };
 
 /**
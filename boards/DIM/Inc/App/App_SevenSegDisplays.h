@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "App_SharedExitCode.h"
 
 struct SevenSegDisplay;
@@ -19,7 +20,10 @@ enum
  * @param middle_seven_seg_display The middle 7-segment display
  * @param right_seven_seg_display The right 7-segment display
  * @param display_value_callback The function to call after we display a value
- *                                on the 7-segment displays
+ *                                on the 7-segment displays. It is only called
+ *                                when what the 7-segment displays show changes.
+ * @param set_brightness A function that can be called to set the brightness of
+ *                       the 7-segment displays, from 0 (off) to 1 (full)
  * @note This function does __not__ take ownership of any of the 7-segment
  *       displays passed into it, which means the every interface must be kept
  *       alive for the lifetime of this created group of 7-segment displays
@@ -30,7 +34,8 @@ struct SevenSegDisplays *App_SevenSegDisplays_Create(
     struct SevenSegDisplay *left_seven_seg_display,
     struct SevenSegDisplay *middle_seven_seg_display,
     struct SevenSegDisplay *right_seven_seg_display,
-    void (*display_value_callback)(void));
+    void (*display_value_callback)(void),
+    void (*set_brightness)(float));
 
 /**
  * Deallocate the memory used by the given group of 7-segment displays
@@ -50,9 +55,9 @@ void App_SevenSegDisplays_Destroy(struct SevenSegDisplays *seven_seg_displays);
  *         is not in the range of [0x0-0xF]
  */
 ExitCode App_SevenSegDisplays_SetHexDigits(
-    const struct SevenSegDisplays *seven_seg_displays,
-    const uint8_t                  hex_digits[],
-    size_t                         num_hex_digits);
+    struct SevenSegDisplays *seven_seg_displays,
+    const uint8_t            hex_digits[],
+    size_t                   num_hex_digits);
 
 /**
  * Display an unsigned base-10 value on the given group of 7-segment displays
@@ -65,5 +70,67 @@ ExitCode App_SevenSegDisplays_SetHexDigits(
  * @return EXIT_CODE_INVALID_ARGS if the given value is out-of-bound
  */
 ExitCode App_SevenSegDisplays_SetUnsignedBase10Value(
-    const struct SevenSegDisplays *seven_seg_displays,
-    uint32_t                       value);
+    struct SevenSegDisplays *seven_seg_displays,
+    uint32_t                 value);
+
+/**
+ * Display an unsigned fixed-point value on the given group of 7-segment
+ * displays, with the decimal point after the ones digit. Any other decimal
+ * point is hidden.
+ * @note The value is given as an integer scaled by 10^num_decimal_places, so
+ *       a value of 125 with 1 decimal place is displayed as 12.5
+ * @param seven_seg_displays The group of 7-segment displays to display the
+ *                           fixed-point value on
+ * @param value The unsigned fixed-point value to display
+ * @param num_decimal_places The number of digits after the decimal point
+ * @return EXIT_CODE_INVALID_ARGS if the given value is out-of-bound or there
+ *         are too many decimal places to display
+ */
+ExitCode App_SevenSegDisplays_SetUnsignedFixedPointValue(
+    struct SevenSegDisplays *seven_seg_displays,
+    uint32_t                 value,
+    size_t                   num_decimal_places);
+
+/**
+ * Show or hide the decimal point of one of the given 7-segment displays. The
+ * decimal point is kept when a new value is displayed.
+ * @param seven_seg_displays The group of 7-segment displays
+ * @param display The index of the 7-segment display
+ * @param enabled Whether to show the decimal point
+ * @return EXIT_CODE_INVALID_ARGS if the given index is out-of-bound
+ */
+ExitCode App_SevenSegDisplays_SetDecimalPoint(
+    struct SevenSegDisplays *seven_seg_displays,
+    size_t                   display,
+    bool                     enabled);
+
+/**
+ * Start or stop blinking one of the given 7-segment displays. The blinking is
+ * kept when a new value is displayed.
+ * @param seven_seg_displays The group of 7-segment displays
+ * @param display The index of the 7-segment display
+ * @param enabled Whether to blink the 7-segment display
+ * @return EXIT_CODE_INVALID_ARGS if the given index is out-of-bound
+ */
+ExitCode App_SevenSegDisplays_SetBlinking(
+    struct SevenSegDisplays *seven_seg_displays,
+    size_t                   display,
+    bool                     enabled);
+
+/**
+ * Set the brightness of the given group of 7-segment displays
+ * @param seven_seg_displays The group of 7-segment displays
+ * @param brightness The brightness, from 0 (off) to 1 (full)
+ * @return EXIT_CODE_INVALID_ARGS if the given brightness is not in the range
+ *         of [0-1]
+ */
+ExitCode App_SevenSegDisplays_SetBrightness(
+    struct SevenSegDisplays *seven_seg_displays,
+    float                    brightness);
+
+/**
+ * Advance the blinking of the given group of 7-segment displays. This must be
+ * called at 100Hz.
+ * @param seven_seg_displays The group of 7-segment displays to tick
+ */
+void App_SevenSegDisplays_Tick(struct SevenSegDisplays *seven_seg_displays);
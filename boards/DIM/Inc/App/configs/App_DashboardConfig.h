@@ -0,0 +1,7 @@
+#pragma once
+
+#define DASHBOARD_MIN_ERROR_DISPLAY_TIME_MS 1000U
+
+// Flicking the torque vectoring switch away and back within this time turns
+// the dashboard to its next page
+#define DASHBOARD_PAGE_FLICK_TIME_MS 1000U
@@ -0,0 +1,5 @@
+#pragma once
+
+struct DimWorld;
+
+#define World DimWorld
@@ -1,13 +1,16 @@
 #pragma once
 
+#include <stm32f3xx_hal.h>
+
 /**
- * Get the buffer for DMA controller to write raw ADC values into
- * @return Pointer to the buffer
+ * Initialize the ADC, and start converting the regen paddle voltage by DMA
+ * @param hadc: The handle of the ADC measuring the voltage
  */
-uint16_t *Io_Adc_GetRawAdcValues(void);
+void Io_Adc_Init(ADC_HandleTypeDef *hadc);
 
 /**
- * Get the voltage measured at ADC channel 12
+ * Get the voltage measured at ADC channel 12, averaged over the latest
+ * conversion sets
  * @return The voltage measured at ADC channel 12, in volts
  */
 float Io_Adc_GetChannel12Voltage(void);
@@ -3,17 +3,26 @@
 #include "App_SevenSegDisplay.h"
 
 /**
- * Register SPI bus used to communicate with the 7-segment display hardware
+ * Register SPI bus used to communicate with the 7-segment display hardware,
+ * and start the PWM that dims the 7-segment displays at full brightness
  * @param hspi The SPI bus to register
+ * @param htim The timer whose first channel drives SEVENSEG_DIMMING_3V3
  */
-void Io_SevenSegDisplays_Init(SPI_HandleTypeDef *hspi);
+void Io_SevenSegDisplays_Init(SPI_HandleTypeDef *hspi, TIM_HandleTypeDef *htim);
 
 /**
- * Issue commands to the shift registers controlling the 7-segment displays via
- * the registered SPI bus
+ * Start issuing commands to the shift registers controlling the 7-segment
+ * displays via the registered SPI bus, using DMA. The commands are latched into
+ * the 7-segment displays once the transfer completes.
  */
 void Io_SevenSegDisplays_WriteCommands(void);
 
+/**
+ * Set the brightness of the 7-segment displays
+ * @param brightness The brightness, from 0 (off) to 1 (full)
+ */
+void Io_SevenSegDisplays_SetBrightness(float brightness);
+
 /**
  * Using the given hexadecimal digit, update the command value to send to the
  * left 7-segment display during the next Io_SevenSegDisplays_WriteCommands()
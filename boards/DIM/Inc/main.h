@@ -36,6 +36,8 @@ extern "C"
 #include "Io_SharedErrorHandlerOverride.h"
     /* USER CODE END Includes */
 
+    void HAL_TIM_MspPostInit(TIM_HandleTypeDef *htim);
+
     /* Exported types
      * ------------------------------------------------------------*/
     /* USER CODE BEGIN ET */
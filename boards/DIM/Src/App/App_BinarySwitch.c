@@ -5,6 +5,17 @@
 struct BinarySwitch
 {
     bool (*is_turned_on)(void);
+
+    // Whether the switch was turned on when it was last checked for a flick
+    bool has_been_checked;
+    bool was_turned_on;
+
+    // Whether the switch was turned away from where it was, and when
+    bool     is_flicking;
+    uint32_t flick_start_time_ms;
+
+    // Where the switch was last left for longer than a flick
+    bool is_held_on;
 };
 
 struct BinarySwitch *App_BinarySwitch_Create(bool (*const is_turned_on)(void))
@@ -14,7 +25,12 @@ struct BinarySwitch *App_BinarySwitch_Create(bool (*const is_turned_on)(void))
     struct BinarySwitch *binary_switch = malloc(sizeof(struct BinarySwitch));
     assert(binary_switch != NULL);
 
-    binary_switch->is_turned_on = is_turned_on;
+    binary_switch->is_turned_on        = is_turned_on;
+    binary_switch->has_been_checked    = false;
+    binary_switch->was_turned_on       = false;
+    binary_switch->is_flicking         = false;
+    binary_switch->flick_start_time_ms = 0U;
+    binary_switch->is_held_on          = false;
 
     return binary_switch;
 }
@@ -28,3 +44,56 @@ bool App_BinarySwitch_IsTurnedOn(const struct BinarySwitch *const binary_switch)
 {
     return binary_switch->is_turned_on();
 }
+
+bool App_BinarySwitch_WasFlicked(
+    struct BinarySwitch *const binary_switch,
+    const uint32_t             current_time_ms,
+    const uint32_t             max_flick_time_ms)
+{
+    const bool is_turned_on = binary_switch->is_turned_on();
+
+    // The switch can only be flicked from where it was first seen
+    if (!binary_switch->has_been_checked)
+    {
+        binary_switch->has_been_checked = true;
+        binary_switch->was_turned_on    = is_turned_on;
+        binary_switch->is_held_on       = is_turned_on;
+        return false;
+    }
+
+    // The switch is held where it was turned to once it can no longer be
+    // flicked back in time
+    if (binary_switch->is_flicking &&
+        current_time_ms - binary_switch->flick_start_time_ms >
+            max_flick_time_ms)
+    {
+        binary_switch->is_flicking = false;
+        binary_switch->is_held_on  = binary_switch->was_turned_on;
+    }
+
+    if (is_turned_on == binary_switch->was_turned_on)
+    {
+        return false;
+    }
+
+    binary_switch->was_turned_on = is_turned_on;
+
+    if (binary_switch->is_flicking &&
+        current_time_ms - binary_switch->flick_start_time_ms <=
+            max_flick_time_ms)
+    {
+        binary_switch->is_flicking = false;
+        return true;
+    }
+
+    // The switch may be on its way back, or may stay where it was turned to
+    binary_switch->is_flicking         = true;
+    binary_switch->flick_start_time_ms = current_time_ms;
+
+    return false;
+}
+
+bool App_BinarySwitch_IsHeldOn(const struct BinarySwitch *const binary_switch)
+{
+    return binary_switch->is_held_on;
+}
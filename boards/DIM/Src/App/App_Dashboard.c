@@ -0,0 +1,437 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "App_Dashboard.h"
+#include "App_SevenSegDisplays.h"
+
+// To avoid confusion between pages and error IDs, the 7-segment displays show
+// the error IDs with an offset of 500. For example, if an error ID is 67, it
+// will show up as 567 on the 7-segment displays.
+#define ERROR_ID_OFFSET 500U
+
+// The largest value that can be shown on three 7-segment displays
+#define MAX_DISPLAY_VALUE 999U
+
+// The errors are ranked from the most critical to the least critical. An AIR
+// shutdown error opens the AIRs, so it is ranked before a motor shutdown error.
+enum ErrorRank
+{
+    AIR_SHUTDOWN_ERROR_RANK,
+    MOTOR_SHUTDOWN_ERROR_RANK,
+    NON_CRITICAL_ERROR_RANK,
+};
+
+struct Dashboard
+{
+    struct SevenSegDisplays *   seven_seg_displays;
+    const struct DashboardPage *pages;
+    size_t                      num_pages;
+    uint32_t                    min_error_display_time_ms;
+    size_t                      selected_page;
+
+    // The errors as of the latest tick, indexed by error ID. An error is
+    // pending from when it is set until it is shown for the minimum error
+    // display time, even if it clears in the meantime.
+    bool           is_set[NUM_ERROR_IDS];
+    bool           is_pending[NUM_ERROR_IDS];
+    enum ErrorRank ranks[NUM_ERROR_IDS];
+
+    bool     is_showing_error;
+    uint32_t shown_error_id;
+    uint32_t shown_error_start_time_ms;
+
+    // What the 7-segment displays were last set to
+    bool     has_displayed;
+    uint32_t displayed_value;
+    size_t   displayed_num_decimal_places;
+};
+
+/**
+ * Get the rank of the given error type
+ * @param error_type The error type to get the rank of
+ * @return The rank of the given error type
+ */
+static enum ErrorRank App_GetErrorRank(enum ErrorType error_type);
+
+/**
+ * Check if an error goes before another error when they are shown in turn
+ * @param dashboard The dashboard the errors belong to
+ * @param a The ID of the first error
+ * @param b The ID of the second error
+ * @return true if the first error goes before the second error, else false
+ */
+static bool App_IsErrorBefore(
+    const struct Dashboard *dashboard,
+    uint32_t                a,
+    uint32_t                b);
+
+/**
+ * Record which errors are set, and mark the newly set errors as pending
+ * @param dashboard The dashboard to record the errors in
+ * @param errors The errors that are set
+ */
+static void App_UpdateErrors(
+    struct Dashboard *      dashboard,
+    const struct ErrorList *errors);
+
+/**
+ * Get the most critical pending error of the given dashboard
+ * @param dashboard The dashboard to get the pending error of
+ * @param error_id This will be set to the ID of the most critical pending error
+ * @return true if there is a pending error, else false
+ */
+static bool App_GetMostCriticalPendingError(
+    const struct Dashboard *dashboard,
+    uint32_t *              error_id);
+
+/**
+ * Get the set error to show after the shown error, wrapping around to the most
+ * critical set error
+ * @param dashboard The dashboard to get the set error of
+ * @param error_id This will be set to the ID of the set error to show next
+ * @return true if there is a set error, else false
+ */
+static bool
+    App_GetNextSetError(const struct Dashboard *dashboard, uint32_t *error_id);
+
+/**
+ * Start showing an error on the given dashboard
+ * @param dashboard The dashboard to show the error on
+ * @param error_id The ID of the error to show
+ * @param current_time_ms The current time, in milliseconds
+ */
+static void App_ShowError(
+    struct Dashboard *dashboard,
+    uint32_t          error_id,
+    uint32_t          current_time_ms);
+
+/**
+ * Choose whether the given dashboard shows an error, and which one
+ * @param dashboard The dashboard to choose the shown error of
+ * @param current_time_ms The current time, in milliseconds
+ */
+static void
+    App_UpdateShownError(struct Dashboard *dashboard, uint32_t current_time_ms);
+
+/**
+ * Turn the value of the selected page into a fixed-point value that fits on
+ * the 7-segment displays, with as many decimal places as possible
+ * @param dashboard The dashboard to get the value of the selected page of
+ * @param can_rx_interface The CAN RX interface to get the value from
+ * @param value This will be set to the fixed-point value
+ * @param num_decimal_places This will be set to the number of decimal places
+ */
+static void App_GetPageValue(
+    const struct Dashboard *        dashboard,
+    const struct DimCanRxInterface *can_rx_interface,
+    uint32_t *                      value,
+    size_t *                        num_decimal_places);
+
+static enum ErrorRank App_GetErrorRank(const enum ErrorType error_type)
+{
+    switch (error_type)
+    {
+        case AIR_SHUTDOWN_ERROR:
+            return AIR_SHUTDOWN_ERROR_RANK;
+        case MOTOR_SHUTDOWN_ERROR:
+            return MOTOR_SHUTDOWN_ERROR_RANK;
+        default:
+            return NON_CRITICAL_ERROR_RANK;
+    }
+}
+
+static bool App_IsErrorBefore(
+    const struct Dashboard *const dashboard,
+    const uint32_t                a,
+    const uint32_t                b)
+{
+    // Errors of the same rank are shown in order of their IDs
+    if (dashboard->ranks[a] != dashboard->ranks[b])
+    {
+        return dashboard->ranks[a] < dashboard->ranks[b];
+    }
+
+    return a < b;
+}
+
+static void App_UpdateErrors(
+    struct Dashboard *const       dashboard,
+    const struct ErrorList *const errors)
+{
+    bool is_set[NUM_ERROR_IDS] = { false };
+
+    for (uint32_t i = 0; i < errors->num_errors; i++)
+    {
+        const uint32_t error_id = App_SharedError_GetId(errors->errors[i]);
+
+        is_set[error_id] = true;
+        dashboard->ranks[error_id] =
+            App_GetErrorRank(App_SharedError_GetErrorType(errors->errors[i]));
+    }
+
+    for (uint32_t i = 0; i < NUM_ERROR_IDS; i++)
+    {
+        if (is_set[i] && !dashboard->is_set[i])
+        {
+            dashboard->is_pending[i] = true;
+        }
+
+        dashboard->is_set[i] = is_set[i];
+    }
+}
+
+static bool App_GetMostCriticalPendingError(
+    const struct Dashboard *const dashboard,
+    uint32_t *const               error_id)
+{
+    bool is_found = false;
+
+    for (uint32_t i = 0; i < NUM_ERROR_IDS; i++)
+    {
+        if (dashboard->is_pending[i] &&
+            (!is_found || App_IsErrorBefore(dashboard, i, *error_id)))
+        {
+            *error_id = i;
+            is_found  = true;
+        }
+    }
+
+    return is_found;
+}
+
+static bool App_GetNextSetError(
+    const struct Dashboard *const dashboard,
+    uint32_t *const               error_id)
+{
+    bool     is_next_found  = false;
+    bool     is_first_found = false;
+    uint32_t next_error_id  = 0;
+    uint32_t first_error_id = 0;
+
+    for (uint32_t i = 0; i < NUM_ERROR_IDS; i++)
+    {
+        if (!dashboard->is_set[i])
+        {
+            continue;
+        }
+
+        if (!is_first_found || App_IsErrorBefore(dashboard, i, first_error_id))
+        {
+            first_error_id = i;
+            is_first_found = true;
+        }
+
+        if (dashboard->is_showing_error &&
+            App_IsErrorBefore(dashboard, dashboard->shown_error_id, i) &&
+            (!is_next_found || App_IsErrorBefore(dashboard, i, next_error_id)))
+        {
+            next_error_id = i;
+            is_next_found = true;
+        }
+    }
+
+    *error_id = is_next_found ? next_error_id : first_error_id;
+
+    return is_first_found;
+}
+
+static void App_ShowError(
+    struct Dashboard *const dashboard,
+    const uint32_t          error_id,
+    const uint32_t          current_time_ms)
+{
+    dashboard->is_showing_error          = true;
+    dashboard->shown_error_id            = error_id;
+    dashboard->shown_error_start_time_ms = current_time_ms;
+}
+
+static void App_UpdateShownError(
+    struct Dashboard *const dashboard,
+    const uint32_t          current_time_ms)
+{
+    uint32_t   error_id = 0;
+    const bool has_pending_error =
+        App_GetMostCriticalPendingError(dashboard, &error_id);
+
+    if (dashboard->is_showing_error)
+    {
+        const uint32_t shown_error_id = dashboard->shown_error_id;
+
+        if (current_time_ms - dashboard->shown_error_start_time_ms <
+            dashboard->min_error_display_time_ms)
+        {
+            // Only a more critical error may cut the shown error short, in
+            // which case the shown error stays pending
+            if (has_pending_error &&
+                dashboard->ranks[error_id] < dashboard->ranks[shown_error_id])
+            {
+                App_ShowError(dashboard, error_id, current_time_ms);
+            }
+
+            return;
+        }
+
+        dashboard->is_pending[shown_error_id] = false;
+    }
+
+    if (App_GetMostCriticalPendingError(dashboard, &error_id) ||
+        App_GetNextSetError(dashboard, &error_id))
+    {
+        App_ShowError(dashboard, error_id, current_time_ms);
+    }
+    else
+    {
+        dashboard->is_showing_error = false;
+    }
+}
+
+static void App_GetPageValue(
+    const struct Dashboard *const         dashboard,
+    const struct DimCanRxInterface *const can_rx_interface,
+    uint32_t *const                       value,
+    size_t *const                         num_decimal_places)
+{
+    const struct DashboardPage *const page =
+        &dashboard->pages[dashboard->selected_page];
+
+    float page_value = page->get_value(can_rx_interface);
+
+    // The 7-segment displays can't show a negative value. This also clamps NAN.
+    if (!(page_value > 0.0f))
+    {
+        page_value = 0.0f;
+    }
+
+    float scale         = 1.0f;
+    *num_decimal_places = page->max_num_decimal_places;
+
+    for (size_t i = 0; i < *num_decimal_places; i++)
+    {
+        scale *= 10.0f;
+    }
+
+    // Drop decimal places until the rounded value fits
+    while (*num_decimal_places > 0 &&
+           page_value * scale + 0.5f >= (float)(MAX_DISPLAY_VALUE + 1U))
+    {
+        (*num_decimal_places)--;
+        scale /= 10.0f;
+    }
+
+    const float fixed_point_value = page_value * scale + 0.5f;
+
+    *value = fixed_point_value >= (float)MAX_DISPLAY_VALUE
+                 ? MAX_DISPLAY_VALUE
+                 : (uint32_t)fixed_point_value;
+}
+
+struct Dashboard *App_Dashboard_Create(
+    struct SevenSegDisplays *const    seven_seg_displays,
+    const struct DashboardPage *const pages,
+    const size_t                      num_pages,
+    const uint32_t                    min_error_display_time_ms)
+{
+    assert(seven_seg_displays != NULL);
+    assert(pages != NULL);
+    assert(num_pages > 0);
+
+    for (size_t i = 0; i < num_pages; i++)
+    {
+        assert(pages[i].get_value != NULL);
+        assert(pages[i].max_num_decimal_places < NUM_SEVEN_SEG_DISPLAYS);
+    }
+
+    struct Dashboard *dashboard = malloc(sizeof(struct Dashboard));
+    assert(dashboard != NULL);
+
+    dashboard->seven_seg_displays        = seven_seg_displays;
+    dashboard->pages                     = pages;
+    dashboard->num_pages                 = num_pages;
+    dashboard->min_error_display_time_ms = min_error_display_time_ms;
+    dashboard->selected_page             = 0;
+
+    for (size_t i = 0; i < NUM_ERROR_IDS; i++)
+    {
+        dashboard->is_set[i]     = false;
+        dashboard->is_pending[i] = false;
+        dashboard->ranks[i]      = NON_CRITICAL_ERROR_RANK;
+    }
+
+    dashboard->is_showing_error             = false;
+    dashboard->shown_error_id               = 0;
+    dashboard->shown_error_start_time_ms    = 0;
+    dashboard->has_displayed                = false;
+    dashboard->displayed_value              = 0;
+    dashboard->displayed_num_decimal_places = 0;
+
+    return dashboard;
+}
+
+void App_Dashboard_Destroy(struct Dashboard *const dashboard)
+{
+    free(dashboard);
+}
+
+size_t App_Dashboard_GetNumPages(const struct Dashboard *const dashboard)
+{
+    return dashboard->num_pages;
+}
+
+ExitCode App_Dashboard_SelectPage(
+    struct Dashboard *const dashboard,
+    const size_t            page)
+{
+    if (page >= dashboard->num_pages)
+    {
+        return EXIT_CODE_INVALID_ARGS;
+    }
+
+    dashboard->selected_page = page;
+
+    return EXIT_CODE_OK;
+}
+
+size_t App_Dashboard_GetSelectedPage(const struct Dashboard *const dashboard)
+{
+    return dashboard->selected_page;
+}
+
+void App_Dashboard_Tick(
+    struct Dashboard *const               dashboard,
+    const struct DimCanRxInterface *const can_rx_interface,
+    const struct ErrorList *const         errors,
+    const uint32_t                        current_time_ms)
+{
+    App_UpdateErrors(dashboard, errors);
+    App_UpdateShownError(dashboard, current_time_ms);
+
+    uint32_t value;
+    size_t   num_decimal_places;
+
+    if (dashboard->is_showing_error)
+    {
+        value              = dashboard->shown_error_id + ERROR_ID_OFFSET;
+        num_decimal_places = 0;
+    }
+    else
+    {
+        App_GetPageValue(
+            dashboard, can_rx_interface, &value, &num_decimal_places);
+    }
+
+    if (dashboard->has_displayed && value == dashboard->displayed_value &&
+        num_decimal_places == dashboard->displayed_num_decimal_places)
+    {
+        return;
+    }
+
+    // Only remember what was displayed if it could be displayed, so it is
+    // tried again on the next tick otherwise
+    if (EXIT_OK(App_SevenSegDisplays_SetUnsignedFixedPointValue(
+            dashboard->seven_seg_displays, value, num_decimal_places)))
+    {
+        dashboard->has_displayed                = true;
+        dashboard->displayed_value              = value;
+        dashboard->displayed_num_decimal_places = num_decimal_places;
+    }
+}
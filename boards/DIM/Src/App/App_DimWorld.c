@@ -25,6 +25,7 @@ struct DimWorld
     struct RgbLed *           fsm_status_led;
     struct RgbLed *           pdm_status_led;
     struct Clock *            clock;
+    struct Dashboard *        dashboard;
 };
 
 struct DimWorld *App_DimWorld_Create(
@@ -46,7 +47,8 @@ struct DimWorld *App_DimWorld_Create(
     struct RgbLed *const            dim_status_led,
     struct RgbLed *const            fsm_status_led,
     struct RgbLed *const            pdm_status_led,
-    struct Clock *const             clock)
+    struct Clock *const             clock,
+    struct Dashboard *const         dashboard)
 {
     struct DimWorld *world = (struct DimWorld *)malloc(sizeof(struct DimWorld));
     assert(world != NULL);
@@ -70,6 +72,7 @@ struct DimWorld *App_DimWorld_Create(
     world->fsm_status_led          = fsm_status_led;
     world->pdm_status_led          = pdm_status_led;
     world->clock                   = clock;
+    world->dashboard               = dashboard;
 
     return world;
 }
@@ -184,3 +187,8 @@ struct Clock *App_DimWorld_GetClock(const struct DimWorld *world)
 {
     return world->clock;
 }
+
+struct Dashboard *App_DimWorld_GetDashboard(const struct DimWorld *const world)
+{
+    return world->dashboard;
+}
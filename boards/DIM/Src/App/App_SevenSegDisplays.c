@@ -6,19 +6,200 @@
 #include "App_SevenSegDisplays.h"
 #include "App_SevenSegDisplay.h"
 
+// At 100Hz, a blinking 7-segment display is on for 0.5s and off for 0.5s
+#define BLINK_PERIOD_TICKS 100U
+
 struct SevenSegDisplays
 {
     struct SevenSegDisplay *displays[NUM_SEVEN_SEG_DISPLAYS];
     void (*display_value_callback)(void);
+    void (*set_brightness)(float);
+
+    // What the caller asked to display
+    struct SevenSegHexDigit hex_digits[NUM_SEVEN_SEG_DISPLAYS];
+    bool                    is_blinking[NUM_SEVEN_SEG_DISPLAYS];
+    uint32_t                blink_tick_count;
+
+    // What the 7-segment displays were last set to. The 7-segment displays
+    // are only set again, and the display value callback only called, when
+    // this changes.
+    struct SevenSegHexDigit committed_hex_digits[NUM_SEVEN_SEG_DISPLAYS];
+    bool                    has_committed;
+    float                   brightness;
 };
 
+/**
+ * Check if two hexadecimal digits show the same thing on a 7-segment display
+ * @param a The first hexadecimal digit
+ * @param b The second hexadecimal digit
+ * @return true if the hexadecimal digits show the same thing, else false
+ */
+static bool App_IsSameHexDigit(
+    const struct SevenSegHexDigit *a,
+    const struct SevenSegHexDigit *b);
+
+/**
+ * Set the 7-segment displays to what the caller asked to display, taking the
+ * blinking into account, if it differs from what they were last set to
+ * @param seven_seg_displays The group of 7-segment displays to set
+ */
+static void App_CommitHexDigits(struct SevenSegDisplays *seven_seg_displays);
+
+/**
+ * Set what the caller asked to display on the given group of 7-segment
+ * displays, without setting the 7-segment displays
+ * @param seven_seg_displays The group of 7-segment displays
+ * @param hex_digits The hexadecimal digits to display
+ * @param num_hex_digits The number of hexadecimal digits to display
+ * @return EXIT_CODE_INVALID_ARGS if the hexadecimal digits are invalid, in
+ * which case nothing is set
+ */
+static ExitCode App_StoreHexDigits(
+    struct SevenSegDisplays *seven_seg_displays,
+    const uint8_t            hex_digits[],
+    size_t                   num_hex_digits);
+
+/**
+ * Turn an unsigned base-10 value into individual digits, least significant
+ * digit first
+ * @param value The unsigned base-10 value
+ * @param min_num_digits The minimum number of digits, padded with leading zeros
+ * @param digits The array to write the digits to, which must be able to hold a
+ *               digit for each 7-segment display
+ * @param num_digits This will be set to the number of digits
+ * @return EXIT_CODE_INVALID_ARGS if the value has more digits than there are
+ *         7-segment displays
+ */
+static ExitCode App_GetBase10Digits(
+    uint32_t value,
+    size_t   min_num_digits,
+    uint8_t  digits[],
+    size_t * num_digits);
+
+static ExitCode App_StoreHexDigits(
+    struct SevenSegDisplays *const seven_seg_displays,
+    const uint8_t                  hex_digits[],
+    size_t                         num_hex_digits)
+{
+    if (num_hex_digits > NUM_SEVEN_SEG_DISPLAYS || num_hex_digits == 0)
+    {
+        return EXIT_CODE_INVALID_ARGS;
+    }
+
+    // If any of the input digits is invalid, we don't write anything to the
+    // 7-segment displays at all.
+    for (size_t i = 0; i < num_hex_digits; i++)
+    {
+        if (hex_digits[i] >= NUM_HEX_DIGITS)
+        {
+            return EXIT_CODE_INVALID_ARGS;
+        }
+    }
+
+    for (size_t i = 0; i < NUM_SEVEN_SEG_DISPLAYS; i++)
+    {
+        struct SevenSegHexDigit *hex_digit = &seven_seg_displays->hex_digits[i];
+
+        if (i < num_hex_digits)
+        {
+            hex_digit->enabled = true;
+            hex_digit->value   = hex_digits[i];
+        }
+        else
+        {
+            // We turn off the 7-segment displays with unspecified values. For
+            // example, if the callers wants to write 0xF, we would turn off the
+            // right and middle 7-segment displays.
+            hex_digit->enabled = false;
+            hex_digit->value   = HEX_DIGIT_0;
+        }
+    }
+
+    return EXIT_CODE_OK;
+}
+
+static ExitCode App_GetBase10Digits(
+    uint32_t      value,
+    const size_t  min_num_digits,
+    uint8_t       digits[],
+    size_t *const num_digits)
+{
+    *num_digits = 0;
+
+    // We treat a value of 0 as having 1 digit. The value is out-of-bound if it
+    // has more digits than there are 7-segment displays.
+    do
+    {
+        if (*num_digits == NUM_SEVEN_SEG_DISPLAYS)
+        {
+            return EXIT_CODE_INVALID_ARGS;
+        }
+
+        digits[(*num_digits)++] = (uint8_t)(value % 10);
+        value /= 10;
+    } while (value != 0 || *num_digits < min_num_digits);
+
+    return EXIT_CODE_OK;
+}
+
+static bool App_IsSameHexDigit(
+    const struct SevenSegHexDigit *const a,
+    const struct SevenSegHexDigit *const b)
+{
+    return a->enabled == b->enabled && a->decimal_point == b->decimal_point &&
+           (!a->enabled || a->value == b->value);
+}
+
+static void
+    App_CommitHexDigits(struct SevenSegDisplays *const seven_seg_displays)
+{
+    const bool is_blink_off =
+        seven_seg_displays->blink_tick_count >= BLINK_PERIOD_TICKS / 2U;
+
+    struct SevenSegHexDigit hex_digits[NUM_SEVEN_SEG_DISPLAYS];
+    bool                    is_changed = !seven_seg_displays->has_committed;
+
+    for (size_t i = 0; i < NUM_SEVEN_SEG_DISPLAYS; i++)
+    {
+        hex_digits[i] = seven_seg_displays->hex_digits[i];
+
+        if (seven_seg_displays->is_blinking[i] && is_blink_off)
+        {
+            hex_digits[i].enabled       = false;
+            hex_digits[i].decimal_point = false;
+        }
+
+        is_changed |= !App_IsSameHexDigit(
+            &hex_digits[i], &seven_seg_displays->committed_hex_digits[i]);
+    }
+
+    if (!is_changed)
+    {
+        return;
+    }
+
+    // The 7-segment displays are updated all at once, so every 7-segment
+    // display is set even if only one of them changed
+    for (size_t i = 0; i < NUM_SEVEN_SEG_DISPLAYS; i++)
+    {
+        App_SevenSegDisplay_SetHexDigit(
+            seven_seg_displays->displays[i], hex_digits[i]);
+        seven_seg_displays->committed_hex_digits[i] = hex_digits[i];
+    }
+
+    seven_seg_displays->has_committed = true;
+    seven_seg_displays->display_value_callback();
+}
+
 struct SevenSegDisplays *App_SevenSegDisplays_Create(
     struct SevenSegDisplay *const left_seven_seg_display,
     struct SevenSegDisplay *const middle_seven_seg_display,
     struct SevenSegDisplay *const right_seven_seg_display,
-    void (*const display_value_callback)(void))
+    void (*const display_value_callback)(void),
+    void (*const set_brightness)(float))
 {
     assert(display_value_callback != NULL);
+    assert(set_brightness != NULL);
 
     struct SevenSegDisplays *seven_seg_displays =
         malloc(sizeof(struct SevenSegDisplays));
@@ -32,6 +213,20 @@ struct SevenSegDisplays *App_SevenSegDisplays_Create(
     seven_seg_displays->displays[RIGHT_SEVEN_SEG_DISPLAY] =
         right_seven_seg_display;
     seven_seg_displays->display_value_callback = display_value_callback;
+    seven_seg_displays->set_brightness         = set_brightness;
+
+    for (size_t i = 0; i < NUM_SEVEN_SEG_DISPLAYS; i++)
+    {
+        seven_seg_displays->hex_digits[i].enabled       = false;
+        seven_seg_displays->hex_digits[i].value         = HEX_DIGIT_0;
+        seven_seg_displays->hex_digits[i].decimal_point = false;
+        seven_seg_displays->is_blinking[i]              = false;
+    }
+    seven_seg_displays->blink_tick_count = 0U;
+    seven_seg_displays->has_committed    = false;
+
+    // The brightness is unknown until it is first set
+    seven_seg_displays->brightness = NAN;
 
     return seven_seg_displays;
 }
@@ -43,77 +238,138 @@ void App_SevenSegDisplays_Destroy(
 }
 
 ExitCode App_SevenSegDisplays_SetHexDigits(
-    const struct SevenSegDisplays *const seven_seg_displays,
-    const uint8_t                        hex_digits[],
-    size_t                               num_hex_digits)
+    struct SevenSegDisplays *const seven_seg_displays,
+    const uint8_t                  hex_digits[],
+    size_t                         num_hex_digits)
 {
-    if (num_hex_digits > NUM_SEVEN_SEG_DISPLAYS || num_hex_digits == 0)
+    const ExitCode exit_code =
+        App_StoreHexDigits(seven_seg_displays, hex_digits, num_hex_digits);
+
+    if (exit_code != EXIT_CODE_OK)
+    {
+        return exit_code;
+    }
+
+    App_CommitHexDigits(seven_seg_displays);
+
+    return EXIT_CODE_OK;
+}
+
+ExitCode App_SevenSegDisplays_SetUnsignedBase10Value(
+    struct SevenSegDisplays *const seven_seg_displays,
+    uint32_t                       value)
+{
+    uint8_t digits[NUM_SEVEN_SEG_DISPLAYS];
+    size_t  num_digits;
+
+    const ExitCode exit_code =
+        App_GetBase10Digits(value, 1, digits, &num_digits);
+
+    if (exit_code != EXIT_CODE_OK)
+    {
+        return exit_code;
+    }
+
+    return App_SevenSegDisplays_SetHexDigits(
+        seven_seg_displays, digits, num_digits);
+}
+
+ExitCode App_SevenSegDisplays_SetUnsignedFixedPointValue(
+    struct SevenSegDisplays *const seven_seg_displays,
+    uint32_t                       value,
+    size_t                         num_decimal_places)
+{
+    if (num_decimal_places >= NUM_SEVEN_SEG_DISPLAYS)
     {
         return EXIT_CODE_INVALID_ARGS;
     }
 
-    // If any of the input digits is invalid, we don't write anything to the
-    // 7-segment displays at all.
-    for (size_t i = 0; i < num_hex_digits; i++)
+    uint8_t digits[NUM_SEVEN_SEG_DISPLAYS];
+    size_t  num_digits;
+
+    // Pad with leading zeros so a value below 1 is shown as 0.5 rather than .5
+    ExitCode exit_code =
+        App_GetBase10Digits(value, num_decimal_places + 1, digits, &num_digits);
+
+    if (exit_code == EXIT_CODE_OK)
     {
-        if (hex_digits[i] >= NUM_HEX_DIGITS)
-        {
-            return EXIT_CODE_INVALID_ARGS;
-        }
+        exit_code = App_StoreHexDigits(seven_seg_displays, digits, num_digits);
     }
 
+    if (exit_code != EXIT_CODE_OK)
+    {
+        return exit_code;
+    }
+
+    // The decimal point follows the ones digit, and the digits and the decimal
+    // point are committed together so no mix of old and new is ever shown
     for (size_t i = 0; i < NUM_SEVEN_SEG_DISPLAYS; i++)
     {
-        struct SevenSegHexDigit hex_digit;
+        seven_seg_displays->hex_digits[i].decimal_point =
+            num_decimal_places > 0 && i == num_decimal_places;
+    }
 
-        if (i < num_hex_digits)
-        {
-            hex_digit.enabled = true;
-            hex_digit.value   = hex_digits[i];
-        }
-        else
-        {
-            // We turn off the 7-segment displays with unspecified values. For
-            // example, if the callers wants to write 0xF, we would turn off the
-            // right and middle 7-segment displays.
-            hex_digit.enabled = false;
-        }
+    App_CommitHexDigits(seven_seg_displays);
 
-        App_SevenSegDisplay_SetHexDigit(
-            seven_seg_displays->displays[i], hex_digit);
+    return EXIT_CODE_OK;
+}
+
+ExitCode App_SevenSegDisplays_SetDecimalPoint(
+    struct SevenSegDisplays *const seven_seg_displays,
+    size_t                         display,
+    bool                           enabled)
+{
+    if (display >= NUM_SEVEN_SEG_DISPLAYS)
+    {
+        return EXIT_CODE_INVALID_ARGS;
     }
 
-    seven_seg_displays->display_value_callback();
+    seven_seg_displays->hex_digits[display].decimal_point = enabled;
+    App_CommitHexDigits(seven_seg_displays);
 
     return EXIT_CODE_OK;
 }
 
-ExitCode App_SevenSegDisplays_SetUnsignedBase10Value(
-    const struct SevenSegDisplays *const seven_seg_displays,
-    uint32_t                             value)
+ExitCode App_SevenSegDisplays_SetBlinking(
+    struct SevenSegDisplays *const seven_seg_displays,
+    size_t                         display,
+    bool                           enabled)
 {
-    if (value > pow(10, NUM_SEVEN_SEG_DISPLAYS) - 1)
+    if (display >= NUM_SEVEN_SEG_DISPLAYS)
     {
         return EXIT_CODE_INVALID_ARGS;
     }
 
-    uint8_t digits[NUM_SEVEN_SEG_DISPLAYS];
+    seven_seg_displays->is_blinking[display] = enabled;
+    App_CommitHexDigits(seven_seg_displays);
 
-    // Turn the base-10 value into individual digits. We treat a value of 0
-    // as having 1 digit, which is why num_digits starts counting from 1.
-    for (uint8_t num_digits = 1; num_digits <= NUM_SEVEN_SEG_DISPLAYS;
-         num_digits++)
+    return EXIT_CODE_OK;
+}
+
+ExitCode App_SevenSegDisplays_SetBrightness(
+    struct SevenSegDisplays *const seven_seg_displays,
+    float                          brightness)
+{
+    // This also rejects NAN
+    if (!(brightness >= 0.0f && brightness <= 1.0f))
     {
-        digits[num_digits - 1] = (uint8_t)(value % 10);
-        value /= 10;
+        return EXIT_CODE_INVALID_ARGS;
+    }
 
-        if (value == 0)
-        {
-            App_SevenSegDisplays_SetHexDigits(
-                seven_seg_displays, digits, num_digits);
-            break;
-        }
+    if (brightness != seven_seg_displays->brightness)
+    {
+        seven_seg_displays->set_brightness(brightness);
+        seven_seg_displays->brightness = brightness;
     }
 
     return EXIT_CODE_OK;
 }
+
+void App_SevenSegDisplays_Tick(
+    struct SevenSegDisplays *const seven_seg_displays)
+{
+    seven_seg_displays->blink_tick_count =
+        (seven_seg_displays->blink_tick_count + 1U) % BLINK_PERIOD_TICKS;
+
+    App_CommitHexDigits(seven_seg_displays);
+}
@@ -3,6 +3,24 @@
 #include "App_SharedMacros.h"
 #include "App_SevenSegDisplays.h"
 #include "App_SharedExitCode.h"
+#include "App_SharedSetPeriodicCanSignals.h"
+#include "configs/App_DashboardConfig.h"
+
+STATIC_DEFINE_APP_SET_PERIODIC_CAN_SIGNALS_STATE_MACHINE_TRACE(
+    DimCanTxInterface)
+
+/**
+ * Get the CAN choice used to identify the given state in the state machine
+ * trace, which is the same choice used by the DIM_STATE_MACHINE message
+ * @param state The state to get the CAN choice for
+ * @return The CAN choice for the given state
+ */
+static uint8_t App_GetStateChoice(const struct State *const state)
+{
+    // The drive state is the only state of the DIM
+    UNUSED(state);
+    return CANMSGS_DIM_STATE_MACHINE_STATE_DRIVE_CHOICE;
+}
 
 static void App_SetPeriodicCanSignals_DriveMode(
     struct DimCanTxInterface *can_tx,
@@ -65,12 +83,12 @@ static void App_SetPeriodicCanSignals_DriveMode(
 
 static void App_SetPeriodicCanSignals_BinarySwitch(
     struct DimCanTxInterface *can_tx,
-    struct BinarySwitch *     binary_switch,
+    bool                      is_turned_on,
     void (*can_signal_setter)(struct DimCanTxInterface *, uint8_t value),
     uint8_t on_choice,
     uint8_t off_choice)
 {
-    if (App_BinarySwitch_IsTurnedOn(binary_switch))
+    if (is_turned_on)
     {
         can_signal_setter(can_tx, on_choice);
     }
@@ -95,6 +113,8 @@ static void DriveStateRunOnTick1Hz(struct StateMachine *const state_machine)
         App_DimWorld_GetRgbLedSequence(world);
 
     App_SharedRgbLedSequence_Tick(rgb_led_sequence);
+    App_SetPeriodicCanSignals_SharedStateMachineTrace(
+        App_DimWorld_GetCanTx(world), state_machine, App_GetStateChoice);
 }
 
 static void DriveStateRunOnTick100Hz(struct StateMachine *const state_machine)
@@ -118,6 +138,7 @@ static void DriveStateRunOnTick100Hz(struct StateMachine *const state_machine)
         App_DimWorld_GetTorqueVectoringSwitch(world);
     struct ErrorTable *error_table = App_DimWorld_GetErrorTable(world);
     struct Clock *     clock       = App_DimWorld_GetClock(world);
+    struct Dashboard * dashboard   = App_DimWorld_GetDashboard(world);
 
     uint32_t buffer;
 
@@ -136,6 +157,19 @@ static void DriveStateRunOnTick100Hz(struct StateMachine *const state_machine)
         App_SetPeriodicCanSignals_DriveMode(can_tx, buffer);
     }
 
+    // The DIM has no input to spare for the dashboard, so it is paged by
+    // flicking the torque vectoring switch, which leaves the switch where it
+    // was rather than changing the drive mode
+    if (App_BinarySwitch_WasFlicked(
+            torque_vectoring_switch,
+            App_SharedClock_GetCurrentTimeInMilliseconds(clock),
+            DASHBOARD_PAGE_FLICK_TIME_MS))
+    {
+        App_Dashboard_SelectPage(
+            dashboard, (App_Dashboard_GetSelectedPage(dashboard) + 1U) %
+                           App_Dashboard_GetNumPages(dashboard));
+    }
+
     if (App_CanRx_BMS_IMD_GetSignal_OK_HS(can_rx) ==
         CANMSGS_BMS_IMD_OK_HS_FAULT_CHOICE)
     {
@@ -156,18 +190,21 @@ static void DriveStateRunOnTick100Hz(struct StateMachine *const state_machine)
     }
 
     App_SetPeriodicCanSignals_BinarySwitch(
-        can_tx, start_switch, App_CanTx_SetPeriodicSignal_START_SWITCH,
+        can_tx, App_BinarySwitch_IsTurnedOn(start_switch),
+        App_CanTx_SetPeriodicSignal_START_SWITCH,
         CANMSGS_DIM_SWITCHES_START_SWITCH_ON_CHOICE,
         CANMSGS_DIM_SWITCHES_START_SWITCH_OFF_CHOICE);
 
     App_SetPeriodicCanSignals_BinarySwitch(
-        can_tx, traction_control_switch,
+        can_tx, App_BinarySwitch_IsTurnedOn(traction_control_switch),
         App_CanTx_SetPeriodicSignal_TRACTION_CONTROL_SWITCH,
         CANMSGS_DIM_SWITCHES_START_SWITCH_ON_CHOICE,
         CANMSGS_DIM_SWITCHES_START_SWITCH_OFF_CHOICE);
 
+    // A flick of the torque vectoring switch pages the dashboard, so the
+    // switch is only broadcast where it is held to keep the drive mode steady
     App_SetPeriodicCanSignals_BinarySwitch(
-        can_tx, torque_vectoring_switch,
+        can_tx, App_BinarySwitch_IsHeldOn(torque_vectoring_switch),
         App_CanTx_SetPeriodicSignal_TORQUE_VECTORING_SWITCH,
         CANMSGS_DIM_SWITCHES_START_SWITCH_ON_CHOICE,
         CANMSGS_DIM_SWITCHES_START_SWITCH_OFF_CHOICE);
@@ -211,34 +248,11 @@ static void DriveStateRunOnTick100Hz(struct StateMachine *const state_machine)
     struct ErrorList all_errors;
     App_SharedErrorTable_GetAllErrors(error_table, &all_errors);
 
-    if (all_errors.num_errors == 0)
-    {
-        App_SevenSegDisplays_SetUnsignedBase10Value(
-            seven_seg_displays,
-            (uint32_t)App_CanRx_BMS_STATE_OF_CHARGE_GetSignal_STATE_OF_CHARGE(
-                can_rx));
-    }
-    else
-    {
-        // We want to display each error for one second, so we assume that the
-        // error set will not change much and just associate each second to
-        // a particular error. Errors that are set for less than N seconds,
-        // where N is the number of errors set, may not be displayed.
-        size_t error_index = App_SharedClock_GetCurrentTimeInSeconds(clock) %
-                             all_errors.num_errors;
-        struct Error *error = all_errors.errors[error_index];
-
-        // To avoid confusion between SoC and error IDs, the 7-segment
-        // displays will show the error IDs with an offset of 500. For
-        // example, if an error ID is 67, it will show up as 567 on the
-        // 7-segment displays.
-        const uint32_t error_id             = App_SharedError_GetId(error);
-        const uint32_t ERROR_ID_OFFSET      = 500;
-        const uint32_t error_id_with_offset = error_id + ERROR_ID_OFFSET;
-
-        App_SevenSegDisplays_SetUnsignedBase10Value(
-            seven_seg_displays, error_id_with_offset);
-    }
+    App_Dashboard_Tick(
+        dashboard, can_rx, &all_errors,
+        App_SharedClock_GetCurrentTimeInMilliseconds(clock));
+
+    App_SevenSegDisplays_Tick(seven_seg_displays);
 
     App_SharedHeartbeatMonitor_Tick(heartbeat_monitor);
 }
@@ -1,5 +1,7 @@
 #include <stm32f3xx_hal.h>
 #include <assert.h>
+#include <stdbool.h>
+#include <string.h>
 
 #include "App_SevenSegDisplays.h"
 #include "Io_SevenSegDisplays.h"
@@ -25,20 +27,32 @@ static_assert(HEX_DIGIT_F == 15, "Hex enum must match its numeric value.");
 struct CommandLookupTable
 {
     uint8_t disable;
+    uint8_t decimal_point;
     uint8_t values[NUM_HEX_DIGITS];
 };
 
 static SPI_HandleTypeDef *_hspi;
+static TIM_HandleTypeDef *_htim;
 
 // The 7-segment displays are controlled by sending 8-bit command values to
 // shift registers via SPI
 static uint8_t commands[NUM_SEVEN_SEG_DISPLAYS];
 
+// The commands being sent by DMA, which are copied from the commands so they
+// can't change in the middle of a transfer
+static uint8_t transfer_commands[NUM_SEVEN_SEG_DISPLAYS];
+
+// Set while a transfer is in progress, and when commands are written during a
+// transfer so they are sent once it completes
+static volatile bool is_transfer_busy;
+static volatile bool is_write_pending;
+
 // clang-format off
 static const struct CommandLookupTable command_lookup_table =
 {
-    .disable = 0x0,
-    .values  =
+    .disable       = 0x0,
+    .decimal_point = 0x80,
+    .values        =
     {
         0x3F, // 0x0
         0x06, // 0x1
@@ -60,74 +74,124 @@ static const struct CommandLookupTable command_lookup_table =
 };
 // clang-format on
 
-void Io_SevenSegDisplays_Init(SPI_HandleTypeDef *const hspi)
+/**
+ * Get the command value that displays the given hexadecimal digit
+ * @param hex_digit The hexadecimal digit to display
+ * @return The command value
+ */
+static uint8_t Io_GetCommand(struct SevenSegHexDigit hex_digit);
+
+/**
+ * Copy the commands and start sending them by DMA
+ * @note This must be called with interrupts disabled, or from the SPI
+ *       interrupt
+ */
+static void Io_StartTransfer(void);
+
+static uint8_t Io_GetCommand(struct SevenSegHexDigit hex_digit)
 {
-    _hspi = hspi;
+    uint8_t command = command_lookup_table.disable;
 
-    // RCK pin is normally held low
-    HAL_GPIO_WritePin(
-        SEVENSEG_RCK_3V3_GPIO_Port, SEVENSEG_RCK_3V3_Pin, GPIO_PIN_RESET);
+    if (hex_digit.enabled)
+    {
+        assert(hex_digit.value < NUM_HEX_DIGITS);
 
-    // Full brightness
-    HAL_GPIO_WritePin(
-        SEVENSEG_DIMMING_3V3_GPIO_Port, SEVENSEG_DIMMING_3V3_Pin,
-        GPIO_PIN_RESET);
+        command = command_lookup_table.values[hex_digit.value];
+    }
+
+    if (hex_digit.decimal_point)
+    {
+        command |= command_lookup_table.decimal_point;
+    }
+
+    return command;
 }
 
-void Io_SevenSegDisplays_WriteCommands(void)
+static void Io_StartTransfer(void)
 {
+    memcpy(transfer_commands, commands, sizeof(transfer_commands));
+    is_write_pending = false;
+
     // The 7-segment displays are daisy chained by shifting registers, so we
     // can't update them individually. Instead, we must update the 7-segment
     // displays all at once.
-    HAL_SPI_Transmit(_hspi, commands, NUM_SEVEN_SEG_DISPLAYS, 100U);
+    is_transfer_busy =
+        HAL_SPI_Transmit_DMA(
+            _hspi, transfer_commands, NUM_SEVEN_SEG_DISPLAYS) == HAL_OK;
+}
 
-    // A pulse to RCK transfers data from the shift registers to the storage
-    // registers, completing the write command.
-    HAL_GPIO_TogglePin(SEVENSEG_RCK_3V3_GPIO_Port, SEVENSEG_RCK_3V3_Pin);
-    HAL_GPIO_TogglePin(SEVENSEG_RCK_3V3_GPIO_Port, SEVENSEG_RCK_3V3_Pin);
+void Io_SevenSegDisplays_Init(
+    SPI_HandleTypeDef *const hspi,
+    TIM_HandleTypeDef *const htim)
+{
+    _hspi = hspi;
+    _htim = htim;
+
+    // RCK pin is normally held low
+    HAL_GPIO_WritePin(
+        SEVENSEG_RCK_3V3_GPIO_Port, SEVENSEG_RCK_3V3_Pin, GPIO_PIN_RESET);
+
+    // Full brightness
+    Io_SevenSegDisplays_SetBrightness(1.0f);
+    HAL_TIM_PWM_Start(_htim, TIM_CHANNEL_1);
 }
 
-void Io_SevenSegDisplays_SetLeftHexDigit(struct SevenSegHexDigit hex_digit)
+void Io_SevenSegDisplays_WriteCommands(void)
 {
-    if (hex_digit.enabled == false)
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (is_transfer_busy)
     {
-        commands[LEFT_SEVEN_SEG_DISPLAY] = command_lookup_table.disable;
+        is_write_pending = true;
     }
     else
     {
-        assert(hex_digit.value < NUM_HEX_DIGITS);
-
-        commands[LEFT_SEVEN_SEG_DISPLAY] =
-            command_lookup_table.values[hex_digit.value];
+        Io_StartTransfer();
     }
+
+    __set_PRIMASK(primask);
 }
 
-void Io_SevenSegDisplays_SetMiddleHexDigit(struct SevenSegHexDigit hex_digit)
+void Io_SevenSegDisplays_SetBrightness(float brightness)
 {
-    if (hex_digit.enabled == false)
-    {
-        commands[MIDDLE_SEVEN_SEG_DISPLAY] = command_lookup_table.disable;
-    }
-    else
-    {
-        assert(hex_digit.value < NUM_HEX_DIGITS);
+    // SEVENSEG_DIMMING_3V3 is active low, and the PWM channel's output is
+    // configured as active low, so the duty cycle is the brightness
+    const uint32_t period = __HAL_TIM_GET_AUTORELOAD(_htim) + 1U;
+    __HAL_TIM_SET_COMPARE(
+        _htim, TIM_CHANNEL_1, (uint32_t)(brightness * (float)period));
+}
 
-        commands[MIDDLE_SEVEN_SEG_DISPLAY] =
-            command_lookup_table.values[hex_digit.value];
-    }
+void Io_SevenSegDisplays_SetLeftHexDigit(struct SevenSegHexDigit hex_digit)
+{
+    commands[LEFT_SEVEN_SEG_DISPLAY] = Io_GetCommand(hex_digit);
+}
+
+void Io_SevenSegDisplays_SetMiddleHexDigit(struct SevenSegHexDigit hex_digit)
+{
+    commands[MIDDLE_SEVEN_SEG_DISPLAY] = Io_GetCommand(hex_digit);
 }
 
 void Io_SevenSegDisplays_SetRightHexDigit(struct SevenSegHexDigit hex_digit)
 {
-    if (hex_digit.enabled == false)
+    commands[RIGHT_SEVEN_SEG_DISPLAY] = Io_GetCommand(hex_digit);
+}
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi != _hspi)
     {
-        commands[RIGHT_SEVEN_SEG_DISPLAY] = command_lookup_table.disable;
+        return;
     }
-    else
-    {
-        assert(hex_digit.value < NUM_HEX_DIGITS);
 
-        commands[RIGHT_SEVEN_SEG_DISPLAY] =
-            command_lookup_table.values[hex_digit.value];
+    // A pulse to RCK transfers data from the shift registers to the storage
+    // registers, completing the write command.
+    HAL_GPIO_TogglePin(SEVENSEG_RCK_3V3_GPIO_Port, SEVENSEG_RCK_3V3_Pin);
+    HAL_GPIO_TogglePin(SEVENSEG_RCK_3V3_GPIO_Port, SEVENSEG_RCK_3V3_Pin);
+
+    is_transfer_busy = false;
+    if (is_write_pending)
+    {
+        Io_StartTransfer();
     }
 }
@@ -29,10 +29,12 @@
 #include "App_DimWorld.h"
 #include "App_SevenSegDisplay.h"
 #include "App_SharedStateMachine.h"
+#include "App_SharedMacros.h"
 #include "states/App_DriveState.h"
 #include "configs/App_RotarySwitchConfig.h"
 #include "configs/App_RegenPaddleConfig.h"
 #include "configs/App_HeartbeatMonitorConfig.h"
+#include "configs/App_DashboardConfig.h"
 
 #include "Io_CanTx.h"
 #include "Io_CanRx.h"
@@ -40,6 +42,7 @@
 #include "Io_StackWaterMark.h"
 #include "Io_SevenSegDisplays.h"
 #include "Io_SharedCan.h"
+#include "Io_SharedCycleCounter.h"
 #include "Io_SharedErrorHandlerOverride.h"
 #include "Io_SharedHardFaultHandler.h"
 #include "Io_HeartbeatMonitor.h"
@@ -119,6 +122,28 @@ struct RgbLed *           dim_status_led;
 struct RgbLed *           fsm_status_led;
 struct RgbLed *           pdm_status_led;
 struct Clock *            clock;
+struct Dashboard *        dashboard;
+
+// The pages of the dashboard, in the order of the drive mode switch positions
+static const struct DashboardPage dashboard_pages[] = {
+    {
+        .get_value = App_CanRx_BMS_STATE_OF_CHARGE_GetSignal_STATE_OF_CHARGE,
+        .max_num_decimal_places = 0,
+    },
+    {
+        .get_value = App_CanRx_BMS_ACCUMULATOR_PACK_GetSignal_PACK_VOLTAGE,
+        .max_num_decimal_places = 0,
+    },
+    {
+        .get_value =
+            App_CanRx_BMS_MAX_CELL_MONITOR_GetSignal_MAX_CELL_MONITOR_DIE_TEMPERATURE,
+        .max_num_decimal_places = 1,
+    },
+    {
+        .get_value = App_CanRx_FSM_FLOW_METER_GetSignal_PRIMARY_FLOW_RATE,
+        .max_num_decimal_places = 1,
+    },
+};
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -192,14 +217,12 @@ int main(void)
     /* USER CODE BEGIN 2 */
     __HAL_DBGMCU_FREEZE_IWDG();
 
-    HAL_ADC_Start_DMA(
-        &hadc2, (uint32_t *)Io_Adc_GetRawAdcValues(),
-        hadc2.Init.NbrOfConversion);
+    Io_Adc_Init(&hadc2);
     HAL_TIM_Base_Start(&htim2);
 
     Io_SharedHardFaultHandler_Init();
 
-    Io_SevenSegDisplays_Init(&hspi2);
+    Io_SevenSegDisplays_Init(&hspi2, &htim2);
 
     left_seven_seg_display =
         App_SevenSegDisplay_Create(Io_SevenSegDisplays_SetLeftHexDigit);
@@ -210,7 +233,8 @@ int main(void)
 
     seven_seg_displays = App_SevenSegDisplays_Create(
         left_seven_seg_display, middle_seven_seg_display,
-        right_seven_seg_display, Io_SevenSegDisplays_WriteCommands);
+        right_seven_seg_display, Io_SevenSegDisplays_WriteCommands,
+        Io_SevenSegDisplays_SetBrightness);
 
     can_tx = App_CanTx_Create(
         Io_CanTx_EnqueueNonPeriodicMsg_DIM_STARTUP,
@@ -269,14 +293,22 @@ int main(void)
 
     clock = App_SharedClock_Create();
 
+    dashboard = App_Dashboard_Create(
+        seven_seg_displays, dashboard_pages,
+        NUM_ELEMENTS_IN_ARRAY(dashboard_pages),
+        DASHBOARD_MIN_ERROR_DISPLAY_TIME_MS);
+
     world = App_DimWorld_Create(
         can_tx, can_rx, seven_seg_displays, heartbeat_monitor, regen_paddle,
         rgb_led_sequence, drive_mode_switch, imd_led, bspd_led, start_switch,
         traction_control_switch, torque_vectoring_switch, error_table,
         bms_status_led, dcm_status_led, dim_status_led, fsm_status_led,
-        pdm_status_led, clock);
+        pdm_status_led, clock, dashboard);
 
     state_machine = App_SharedStateMachine_Create(world, App_GetDriveState());
+    Io_SharedCycleCounter_Init();
+    App_SharedStateMachine_SetCycleCounter(
+        state_machine, Io_SharedCycleCounter_GetCycleCount);
 
     Io_StackWaterMark_Init(can_tx);
     Io_SoftwareWatchdog_Init(can_tx);
@@ -570,6 +602,7 @@ static void MX_TIM2_Init(void)
 
     TIM_ClockConfigTypeDef  sClockSourceConfig = { 0 };
     TIM_MasterConfigTypeDef sMasterConfig      = { 0 };
+    TIM_OC_InitTypeDef      sConfigOC          = { 0 };
 
     /* USER CODE BEGIN TIM2_Init 1 */
 
@@ -589,15 +622,28 @@ static void MX_TIM2_Init(void)
     {
         Error_Handler();
     }
+    if (HAL_TIM_PWM_Init(&htim2) != HAL_OK)
+    {
+        Error_Handler();
+    }
     sMasterConfig.MasterOutputTrigger = TIM_TRGO_UPDATE;
     sMasterConfig.MasterSlaveMode     = TIM_MASTERSLAVEMODE_DISABLE;
     if (HAL_TIMEx_MasterConfigSynchronization(&htim2, &sMasterConfig) != HAL_OK)
     {
         Error_Handler();
     }
+    sConfigOC.OCMode     = TIM_OCMODE_PWM1;
+    sConfigOC.Pulse      = 0;
+    sConfigOC.OCPolarity = TIM_OCPOLARITY_LOW;
+    sConfigOC.OCFastMode = TIM_OCFAST_DISABLE;
+    if (HAL_TIM_PWM_ConfigChannel(&htim2, &sConfigOC, TIM_CHANNEL_1) != HAL_OK)
+    {
+        Error_Handler();
+    }
     /* USER CODE BEGIN TIM2_Init 2 */
 
     /* USER CODE END TIM2_Init 2 */
+    HAL_TIM_MspPostInit(&htim2);
 }
 
 /**
@@ -639,7 +685,7 @@ static void MX_GPIO_Init(void)
     HAL_GPIO_WritePin(
         GPIOA,
         DCM_BLUE_Pin | PDM_RED_Pin | DCM_GREEN_Pin | PDM_BLUE_Pin |
-            FSM_GREEN_Pin | BMS_BLUE_Pin | SEVENSEG_DIMMING_3V3_Pin,
+            FSM_GREEN_Pin | BMS_BLUE_Pin,
         GPIO_PIN_RESET);
 
     /*Configure GPIO pin Output Level */
@@ -661,11 +707,10 @@ static void MX_GPIO_Init(void)
 
     /*Configure GPIO pins : DCM_BLUE_Pin DIM_GREEN_Pin DIM_BLUE_Pin PDM_RED_Pin
                              DCM_GREEN_Pin PDM_BLUE_Pin FSM_GREEN_Pin
-       BMS_BLUE_Pin SEVENSEG_DIMMING_3V3_Pin */
+       BMS_BLUE_Pin */
     GPIO_InitStruct.Pin = DCM_BLUE_Pin | DIM_GREEN_Pin | DIM_BLUE_Pin |
                           PDM_RED_Pin | DCM_GREEN_Pin | PDM_BLUE_Pin |
-                          FSM_GREEN_Pin | BMS_BLUE_Pin |
-                          SEVENSEG_DIMMING_3V3_Pin;
+                          FSM_GREEN_Pin | BMS_BLUE_Pin;
     GPIO_InitStruct.Mode  = GPIO_MODE_OUTPUT_PP;
     GPIO_InitStruct.Pull  = GPIO_NOPULL;
     GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
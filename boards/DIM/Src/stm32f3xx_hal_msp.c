@@ -26,6 +26,8 @@
 /* USER CODE END Includes */
 extern DMA_HandleTypeDef hdma_adc2;
 
+void HAL_TIM_MspPostInit(TIM_HandleTypeDef *htim);
+
 /* Private typedef -----------------------------------------------------------*/
 /* USER CODE BEGIN TD */
 
@@ -43,7 +45,7 @@ extern DMA_HandleTypeDef hdma_adc2;
 
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN PV */
-
+DMA_HandleTypeDef hdma_spi2_tx;
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -265,7 +267,24 @@ void HAL_SPI_MspInit(SPI_HandleTypeDef *hspi)
         HAL_NVIC_SetPriority(SPI2_IRQn, 5, 0);
         HAL_NVIC_EnableIRQ(SPI2_IRQn);
         /* USER CODE BEGIN SPI2_MspInit 1 */
+        __HAL_RCC_DMA1_CLK_ENABLE();
+
+        hdma_spi2_tx.Instance                 = DMA1_Channel5;
+        hdma_spi2_tx.Init.Direction           = DMA_MEMORY_TO_PERIPH;
+        hdma_spi2_tx.Init.PeriphInc           = DMA_PINC_DISABLE;
+        hdma_spi2_tx.Init.MemInc              = DMA_MINC_ENABLE;
+        hdma_spi2_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+        hdma_spi2_tx.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+        hdma_spi2_tx.Init.Mode                = DMA_NORMAL;
+        hdma_spi2_tx.Init.Priority            = DMA_PRIORITY_LOW;
+        if (HAL_DMA_Init(&hdma_spi2_tx) != HAL_OK)
+        {
+            Error_Handler();
+        }
+        __HAL_LINKDMA(hspi, hdmatx, hdma_spi2_tx);
 
+        HAL_NVIC_SetPriority(DMA1_Channel5_IRQn, 5, 0);
+        HAL_NVIC_EnableIRQ(DMA1_Channel5_IRQn);
         /* USER CODE END SPI2_MspInit 1 */
     }
 }
@@ -295,7 +314,8 @@ void HAL_SPI_MspDeInit(SPI_HandleTypeDef *hspi)
         /* SPI2 interrupt DeInit */
         HAL_NVIC_DisableIRQ(SPI2_IRQn);
         /* USER CODE BEGIN SPI2_MspDeInit 1 */
-
+        HAL_DMA_DeInit(hspi->hdmatx);
+        HAL_NVIC_DisableIRQ(DMA1_Channel5_IRQn);
         /* USER CODE END SPI2_MspDeInit 1 */
     }
 }
@@ -321,6 +341,32 @@ void HAL_TIM_Base_MspInit(TIM_HandleTypeDef *htim_base)
     }
 }
 
+void HAL_TIM_MspPostInit(TIM_HandleTypeDef *htim)
+{
+    GPIO_InitTypeDef GPIO_InitStruct = { 0 };
+    if (htim->Instance == TIM2)
+    {
+        /* USER CODE BEGIN TIM2_MspPostInit 0 */
+
+        /* USER CODE END TIM2_MspPostInit 0 */
+
+        __HAL_RCC_GPIOA_CLK_ENABLE();
+        /**TIM2 GPIO Configuration
+        PA15     ------> TIM2_CH1
+        */
+        GPIO_InitStruct.Pin       = SEVENSEG_DIMMING_3V3_Pin;
+        GPIO_InitStruct.Mode      = GPIO_MODE_AF_PP;
+        GPIO_InitStruct.Pull      = GPIO_NOPULL;
+        GPIO_InitStruct.Speed     = GPIO_SPEED_FREQ_LOW;
+        GPIO_InitStruct.Alternate = GPIO_AF1_TIM2;
+        HAL_GPIO_Init(SEVENSEG_DIMMING_3V3_GPIO_Port, &GPIO_InitStruct);
+
+        /* USER CODE BEGIN TIM2_MspPostInit 1 */
+
+        /* USER CODE END TIM2_MspPostInit 1 */
+    }
+}
+
 /**
  * @brief TIM_Base MSP De-Initialization
  * This function freeze the hardware resources used in this example
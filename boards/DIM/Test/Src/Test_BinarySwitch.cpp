@@ -33,3 +33,57 @@ TEST_F(BinarySwitchTest, toggle_switch)
     is_turned_on_fake.return_val = false;
     ASSERT_EQ(false, App_BinarySwitch_IsTurnedOn(binary_switch));
 }
+
+TEST_F(BinarySwitchTest, flick_is_turning_the_switch_away_and_back_in_time)
+{
+    is_turned_on_fake.return_val = false;
+    ASSERT_FALSE(App_BinarySwitch_WasFlicked(binary_switch, 0U, 1000U));
+
+    is_turned_on_fake.return_val = true;
+    ASSERT_FALSE(App_BinarySwitch_WasFlicked(binary_switch, 100U, 1000U));
+
+    // The flick is only reported once
+    is_turned_on_fake.return_val = false;
+    ASSERT_TRUE(App_BinarySwitch_WasFlicked(binary_switch, 1100U, 1000U));
+    ASSERT_FALSE(App_BinarySwitch_WasFlicked(binary_switch, 1110U, 1000U));
+
+    // Turning the switch and leaving it there isn't a flick
+    is_turned_on_fake.return_val = true;
+    ASSERT_FALSE(App_BinarySwitch_WasFlicked(binary_switch, 2000U, 1000U));
+    is_turned_on_fake.return_val = false;
+    ASSERT_FALSE(App_BinarySwitch_WasFlicked(binary_switch, 3001U, 1000U));
+
+    // A switch that is first seen turned on is flicked off and back on
+    is_turned_on_fake.return_val = true;
+    ASSERT_TRUE(App_BinarySwitch_WasFlicked(binary_switch, 3500U, 1000U));
+}
+
+TEST_F(BinarySwitchTest, flick_leaves_the_switch_held_where_it_was)
+{
+    is_turned_on_fake.return_val = false;
+    App_BinarySwitch_WasFlicked(binary_switch, 0U, 1000U);
+    ASSERT_FALSE(App_BinarySwitch_IsHeldOn(binary_switch));
+
+    // The switch isn't held on while it may still be flicked back off
+    is_turned_on_fake.return_val = true;
+    App_BinarySwitch_WasFlicked(binary_switch, 100U, 1000U);
+    ASSERT_FALSE(App_BinarySwitch_IsHeldOn(binary_switch));
+    is_turned_on_fake.return_val = false;
+    ASSERT_TRUE(App_BinarySwitch_WasFlicked(binary_switch, 1100U, 1000U));
+    ASSERT_FALSE(App_BinarySwitch_IsHeldOn(binary_switch));
+    App_BinarySwitch_WasFlicked(binary_switch, 5000U, 1000U);
+    ASSERT_FALSE(App_BinarySwitch_IsHeldOn(binary_switch));
+
+    // Turning the switch and leaving it there holds it there
+    is_turned_on_fake.return_val = true;
+    App_BinarySwitch_WasFlicked(binary_switch, 6000U, 1000U);
+    App_BinarySwitch_WasFlicked(binary_switch, 7000U, 1000U);
+    ASSERT_FALSE(App_BinarySwitch_IsHeldOn(binary_switch));
+    App_BinarySwitch_WasFlicked(binary_switch, 7001U, 1000U);
+    ASSERT_TRUE(App_BinarySwitch_IsHeldOn(binary_switch));
+
+    // Nor does flicking it off release it
+    is_turned_on_fake.return_val = false;
+    App_BinarySwitch_WasFlicked(binary_switch, 8000U, 1000U);
+    ASSERT_TRUE(App_BinarySwitch_IsHeldOn(binary_switch));
+}
@@ -0,0 +1,311 @@
+#include "Test_Dim.h"
+
+extern "C"
+{
+#include "App_Dashboard.h"
+#include "App_SevenSegDisplays.h"
+#include "App_SevenSegDisplay.h"
+#include "App_SharedError.h"
+}
+
+namespace DashboardTest
+{
+FAKE_VOID_FUNC(set_right_hex_digit, struct SevenSegHexDigit);
+FAKE_VOID_FUNC(set_middle_hex_digit, struct SevenSegHexDigit);
+FAKE_VOID_FUNC(set_left_hex_digit, struct SevenSegHexDigit);
+FAKE_VOID_FUNC(display_value_callback);
+FAKE_VOID_FUNC(set_brightness, float);
+FAKE_VALUE_FUNC(float, get_first_page_value, const struct DimCanRxInterface *);
+FAKE_VALUE_FUNC(float, get_second_page_value, const struct DimCanRxInterface *);
+
+static constexpr uint32_t MIN_ERROR_DISPLAY_TIME_MS = 1000U;
+
+enum
+{
+    FIRST_PAGE,
+    SECOND_PAGE,
+    NUM_PAGES
+};
+
+static const struct DashboardPage pages[NUM_PAGES] = {
+    { get_first_page_value, 2 },
+    { get_second_page_value, 0 },
+};
+
+// Made-up error IDs, which are valid as long as we have more than 4 errors
+enum
+{
+    NON_CRITICAL_ERROR_ID       = 1,
+    OTHER_NON_CRITICAL_ERROR_ID = 2,
+    MOTOR_SHUTDOWN_ERROR_ID     = 3,
+    AIR_SHUTDOWN_ERROR_ID       = 4,
+    NUM_TEST_ERRORS
+};
+
+class DashboardTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        left_seven_seg_display = App_SevenSegDisplay_Create(set_left_hex_digit);
+        middle_seven_seg_display =
+            App_SevenSegDisplay_Create(set_middle_hex_digit);
+        right_seven_seg_display =
+            App_SevenSegDisplay_Create(set_right_hex_digit);
+        seven_seg_displays = App_SevenSegDisplays_Create(
+            left_seven_seg_display, middle_seven_seg_display,
+            right_seven_seg_display, display_value_callback, set_brightness);
+        dashboard = App_Dashboard_Create(
+            seven_seg_displays, pages, NUM_PAGES, MIN_ERROR_DISPLAY_TIME_MS);
+
+        for (uint32_t id = 0; id < NUM_TEST_ERRORS; id++)
+        {
+            errors[id] = App_SharedError_Create();
+            App_SharedError_SetId(errors[id], id);
+            App_SharedError_SetIsSet(errors[id], false);
+        }
+        App_SharedError_SetErrorType(
+            errors[NON_CRITICAL_ERROR_ID], NON_CRITICAL_ERROR);
+        App_SharedError_SetErrorType(
+            errors[OTHER_NON_CRITICAL_ERROR_ID], NON_CRITICAL_ERROR);
+        App_SharedError_SetErrorType(
+            errors[MOTOR_SHUTDOWN_ERROR_ID], MOTOR_SHUTDOWN_ERROR);
+        App_SharedError_SetErrorType(
+            errors[AIR_SHUTDOWN_ERROR_ID], AIR_SHUTDOWN_ERROR);
+
+        current_time_ms = 0U;
+
+        RESET_FAKE(set_right_hex_digit);
+        RESET_FAKE(set_middle_hex_digit);
+        RESET_FAKE(set_left_hex_digit);
+        RESET_FAKE(display_value_callback);
+        RESET_FAKE(set_brightness);
+        RESET_FAKE(get_first_page_value);
+        RESET_FAKE(get_second_page_value);
+    }
+
+    void TearDown() override
+    {
+        TearDownObject(dashboard, App_Dashboard_Destroy);
+        TearDownObject(seven_seg_displays, App_SevenSegDisplays_Destroy);
+        TearDownObject(left_seven_seg_display, App_SevenSegDisplay_Destroy);
+        TearDownObject(middle_seven_seg_display, App_SevenSegDisplay_Destroy);
+        TearDownObject(right_seven_seg_display, App_SevenSegDisplay_Destroy);
+
+        for (uint32_t id = 0; id < NUM_TEST_ERRORS; id++)
+        {
+            TearDownObject(errors[id], App_SharedError_Destroy);
+        }
+    }
+
+    void SetError(uint32_t id, bool is_set)
+    {
+        App_SharedError_SetIsSet(errors[id], is_set);
+    }
+
+    // Tick the dashboard at 100Hz for the given amount of time
+    void LetTimePass(uint32_t time_ms)
+    {
+        for (uint32_t i = 0; i < time_ms / 10U; i++)
+        {
+            struct ErrorList error_list;
+            error_list.num_errors = 0;
+
+            for (uint32_t id = 0; id < NUM_TEST_ERRORS; id++)
+            {
+                if (App_SharedError_GetIsSet(errors[id]))
+                {
+                    error_list.errors[error_list.num_errors++] = errors[id];
+                }
+            }
+
+            current_time_ms += 10U;
+            App_Dashboard_Tick(dashboard, NULL, &error_list, current_time_ms);
+        }
+    }
+
+    // Get the value shown on the 7-segment displays, ignoring decimal points
+    uint32_t GetShownValue(void)
+    {
+        const struct SevenSegHexDigit digits[NUM_SEVEN_SEG_DISPLAYS] = {
+            set_left_hex_digit_fake.arg0_val,
+            set_middle_hex_digit_fake.arg0_val,
+            set_right_hex_digit_fake.arg0_val,
+        };
+
+        uint32_t value = 0;
+        uint32_t scale = 1;
+        for (size_t i = 0; i < NUM_SEVEN_SEG_DISPLAYS && digits[i].enabled; i++)
+        {
+            value += digits[i].value * scale;
+            scale *= 10;
+        }
+
+        return value;
+    }
+
+    struct SevenSegDisplay * left_seven_seg_display;
+    struct SevenSegDisplay * middle_seven_seg_display;
+    struct SevenSegDisplay * right_seven_seg_display;
+    struct SevenSegDisplays *seven_seg_displays;
+    struct Dashboard *       dashboard;
+    struct Error *           errors[NUM_TEST_ERRORS];
+    uint32_t                 current_time_ms;
+};
+
+TEST_F(DashboardTest, page_is_shown_with_as_many_decimal_places_as_fit)
+{
+    get_first_page_value_fake.return_val = 1.234f;
+    LetTimePass(10);
+    ASSERT_EQ(123, GetShownValue());
+    ASSERT_EQ(true, set_right_hex_digit_fake.arg0_val.decimal_point);
+
+    get_first_page_value_fake.return_val = 12.34f;
+    LetTimePass(10);
+    ASSERT_EQ(123, GetShownValue());
+    ASSERT_EQ(false, set_right_hex_digit_fake.arg0_val.decimal_point);
+    ASSERT_EQ(true, set_middle_hex_digit_fake.arg0_val.decimal_point);
+
+    // 99.96 rounds to 100.0, which does not fit with a decimal place
+    get_first_page_value_fake.return_val = 99.96f;
+    LetTimePass(10);
+    ASSERT_EQ(100, GetShownValue());
+    ASSERT_EQ(false, set_middle_hex_digit_fake.arg0_val.decimal_point);
+    ASSERT_EQ(false, set_left_hex_digit_fake.arg0_val.decimal_point);
+}
+
+TEST_F(DashboardTest, out_of_bound_page_value_is_clamped)
+{
+    get_first_page_value_fake.return_val = -5.0f;
+    LetTimePass(10);
+    ASSERT_EQ(0, GetShownValue());
+
+    get_first_page_value_fake.return_val = 1234.0f;
+    LetTimePass(10);
+    ASSERT_EQ(999, GetShownValue());
+
+    get_first_page_value_fake.return_val = NAN;
+    LetTimePass(10);
+    ASSERT_EQ(0, GetShownValue());
+}
+
+TEST_F(DashboardTest, page_is_only_shown_again_when_its_shown_value_changes)
+{
+    get_first_page_value_fake.return_val = 1.231f;
+    LetTimePass(10);
+    ASSERT_EQ(1, display_value_callback_fake.call_count);
+
+    // 1.234 is shown as 1.23 too
+    get_first_page_value_fake.return_val = 1.234f;
+    LetTimePass(100);
+    ASSERT_EQ(1, display_value_callback_fake.call_count);
+
+    get_first_page_value_fake.return_val = 1.24f;
+    LetTimePass(10);
+    ASSERT_EQ(2, display_value_callback_fake.call_count);
+    ASSERT_EQ(124, GetShownValue());
+}
+
+TEST_F(DashboardTest, selected_page_is_shown)
+{
+    get_first_page_value_fake.return_val  = 1.0f;
+    get_second_page_value_fake.return_val = 42.0f;
+
+    ASSERT_EQ(NUM_PAGES, App_Dashboard_GetNumPages(dashboard));
+    ASSERT_EQ(FIRST_PAGE, App_Dashboard_GetSelectedPage(dashboard));
+    ASSERT_EQ(EXIT_CODE_OK, App_Dashboard_SelectPage(dashboard, SECOND_PAGE));
+    ASSERT_EQ(SECOND_PAGE, App_Dashboard_GetSelectedPage(dashboard));
+
+    LetTimePass(10);
+    ASSERT_EQ(42, GetShownValue());
+    ASSERT_EQ(0, get_first_page_value_fake.call_count);
+
+    ASSERT_EQ(
+        EXIT_CODE_INVALID_ARGS, App_Dashboard_SelectPage(dashboard, NUM_PAGES));
+    ASSERT_EQ(SECOND_PAGE, App_Dashboard_GetSelectedPage(dashboard));
+}
+
+TEST_F(DashboardTest, error_is_shown_instead_of_the_page_with_an_offset)
+{
+    get_first_page_value_fake.return_val = 1.0f;
+    SetError(NON_CRITICAL_ERROR_ID, true);
+
+    LetTimePass(10);
+    ASSERT_EQ(500 + NON_CRITICAL_ERROR_ID, GetShownValue());
+    ASSERT_EQ(false, set_right_hex_digit_fake.arg0_val.decimal_point);
+
+    // The page is shown again once the error clears
+    SetError(NON_CRITICAL_ERROR_ID, false);
+    LetTimePass(MIN_ERROR_DISPLAY_TIME_MS);
+    ASSERT_EQ(100, GetShownValue());
+}
+
+TEST_F(DashboardTest, new_error_is_shown_for_the_minimum_time_even_if_it_clears)
+{
+    SetError(NON_CRITICAL_ERROR_ID, true);
+    LetTimePass(10);
+    SetError(NON_CRITICAL_ERROR_ID, false);
+
+    LetTimePass(MIN_ERROR_DISPLAY_TIME_MS - 10U);
+    ASSERT_EQ(500 + NON_CRITICAL_ERROR_ID, GetShownValue());
+
+    LetTimePass(10);
+    ASSERT_EQ(0, GetShownValue());
+}
+
+TEST_F(DashboardTest, errors_are_shown_in_turn_from_the_most_critical)
+{
+    SetError(NON_CRITICAL_ERROR_ID, true);
+    SetError(MOTOR_SHUTDOWN_ERROR_ID, true);
+    SetError(AIR_SHUTDOWN_ERROR_ID, true);
+
+    const uint32_t expected_error_ids[] = {
+        AIR_SHUTDOWN_ERROR_ID,
+        MOTOR_SHUTDOWN_ERROR_ID,
+        NON_CRITICAL_ERROR_ID,
+        AIR_SHUTDOWN_ERROR_ID,
+    };
+
+    LetTimePass(10);
+    for (uint32_t expected_error_id : expected_error_ids)
+    {
+        ASSERT_EQ(500 + expected_error_id, GetShownValue());
+        LetTimePass(MIN_ERROR_DISPLAY_TIME_MS);
+    }
+}
+
+TEST_F(DashboardTest, more_critical_new_error_cuts_the_shown_error_short)
+{
+    SetError(NON_CRITICAL_ERROR_ID, true);
+    LetTimePass(100);
+    ASSERT_EQ(500 + NON_CRITICAL_ERROR_ID, GetShownValue());
+
+    SetError(AIR_SHUTDOWN_ERROR_ID, true);
+    LetTimePass(10);
+    ASSERT_EQ(500 + AIR_SHUTDOWN_ERROR_ID, GetShownValue());
+
+    // The cut short error is still shown for the minimum time afterwards
+    SetError(NON_CRITICAL_ERROR_ID, false);
+    SetError(AIR_SHUTDOWN_ERROR_ID, false);
+    LetTimePass(MIN_ERROR_DISPLAY_TIME_MS);
+    ASSERT_EQ(500 + NON_CRITICAL_ERROR_ID, GetShownValue());
+}
+
+TEST_F(DashboardTest, less_critical_new_error_waits_for_the_shown_error)
+{
+    SetError(MOTOR_SHUTDOWN_ERROR_ID, true);
+    LetTimePass(100);
+
+    SetError(NON_CRITICAL_ERROR_ID, true);
+    SetError(OTHER_NON_CRITICAL_ERROR_ID, true);
+    LetTimePass(MIN_ERROR_DISPLAY_TIME_MS - 100U);
+    ASSERT_EQ(500 + MOTOR_SHUTDOWN_ERROR_ID, GetShownValue());
+
+    LetTimePass(10);
+    ASSERT_EQ(500 + NON_CRITICAL_ERROR_ID, GetShownValue());
+
+    LetTimePass(MIN_ERROR_DISPLAY_TIME_MS);
+    ASSERT_EQ(500 + OTHER_NON_CRITICAL_ERROR_ID, GetShownValue());
+}
+
+} // namespace DashboardTest
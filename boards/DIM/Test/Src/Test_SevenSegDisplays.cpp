@@ -10,6 +10,7 @@ FAKE_VOID_FUNC(set_right_hex_digit, struct SevenSegHexDigit);
 FAKE_VOID_FUNC(set_middle_hex_digit, struct SevenSegHexDigit);
 FAKE_VOID_FUNC(set_left_hex_digit, struct SevenSegHexDigit);
 FAKE_VOID_FUNC(display_value_callback);
+FAKE_VOID_FUNC(set_brightness, float);
 
 class SevenSegDisplaysTest : public testing::Test
 {
@@ -23,12 +24,13 @@ class SevenSegDisplaysTest : public testing::Test
             App_SevenSegDisplay_Create(set_right_hex_digit);
         seven_seg_displays = App_SevenSegDisplays_Create(
             left_seven_seg_display, middle_seven_seg_display,
-            right_seven_seg_display, display_value_callback);
+            right_seven_seg_display, display_value_callback, set_brightness);
 
         RESET_FAKE(set_right_hex_digit);
         RESET_FAKE(set_middle_hex_digit);
         RESET_FAKE(set_left_hex_digit);
         RESET_FAKE(display_value_callback);
+        RESET_FAKE(set_brightness);
     }
 
     void TearDown() override
@@ -319,3 +321,194 @@ TEST_F(
     ASSERT_EQ(EXIT_CODE_INVALID_ARGS, exit_code);
     ASSERT_EQ(0, display_value_callback_fake.call_count);
 }
+
+TEST_F(SevenSegDisplaysTest, set_largest_unsigned_base10_value_is_invalid)
+{
+    ExitCode exit_code = App_SevenSegDisplays_SetUnsignedBase10Value(
+        seven_seg_displays, UINT32_MAX);
+    ASSERT_EQ(EXIT_CODE_INVALID_ARGS, exit_code);
+    ASSERT_EQ(0, display_value_callback_fake.call_count);
+}
+
+TEST_F(SevenSegDisplaysTest, unchanged_value_does_not_invoke_callback_function)
+{
+    for (size_t i = 0; i < 10; i++)
+    {
+        ExitCode exit_code = App_SevenSegDisplays_SetUnsignedBase10Value(
+            seven_seg_displays, 123);
+        ASSERT_EQ(EXIT_CODE_OK, exit_code);
+        App_SevenSegDisplays_Tick(seven_seg_displays);
+    }
+
+    ASSERT_EQ(1, set_left_hex_digit_fake.call_count);
+    ASSERT_EQ(1, set_middle_hex_digit_fake.call_count);
+    ASSERT_EQ(1, set_right_hex_digit_fake.call_count);
+    ASSERT_EQ(1, display_value_callback_fake.call_count);
+
+    // Changing any one of the digits sets every 7-segment display again
+    App_SevenSegDisplays_SetUnsignedBase10Value(seven_seg_displays, 124);
+    ASSERT_EQ(2, set_left_hex_digit_fake.call_count);
+    ASSERT_EQ(2, set_middle_hex_digit_fake.call_count);
+    ASSERT_EQ(2, set_right_hex_digit_fake.call_count);
+    ASSERT_EQ(2, display_value_callback_fake.call_count);
+    ASSERT_EQ(4, set_left_hex_digit_fake.arg0_val.value);
+}
+
+TEST_F(SevenSegDisplaysTest, decimal_point_is_kept_when_the_value_changes)
+{
+    ASSERT_EQ(
+        EXIT_CODE_OK, App_SevenSegDisplays_SetDecimalPoint(
+                          seven_seg_displays, MIDDLE_SEVEN_SEG_DISPLAY, true));
+    ASSERT_EQ(1, display_value_callback_fake.call_count);
+    ASSERT_EQ(true, set_middle_hex_digit_fake.arg0_val.decimal_point);
+
+    App_SevenSegDisplays_SetUnsignedBase10Value(seven_seg_displays, 12);
+    ASSERT_EQ(2, display_value_callback_fake.call_count);
+    ASSERT_EQ(false, set_left_hex_digit_fake.arg0_val.decimal_point);
+    ASSERT_EQ(true, set_middle_hex_digit_fake.arg0_val.decimal_point);
+    ASSERT_EQ(false, set_right_hex_digit_fake.arg0_val.decimal_point);
+
+    // The decimal point is shown even on a 7-segment display that is off
+    App_SevenSegDisplays_SetUnsignedBase10Value(seven_seg_displays, 1);
+    ASSERT_EQ(false, set_middle_hex_digit_fake.arg0_val.enabled);
+    ASSERT_EQ(true, set_middle_hex_digit_fake.arg0_val.decimal_point);
+
+    ASSERT_EQ(
+        EXIT_CODE_OK, App_SevenSegDisplays_SetDecimalPoint(
+                          seven_seg_displays, MIDDLE_SEVEN_SEG_DISPLAY, false));
+    ASSERT_EQ(false, set_middle_hex_digit_fake.arg0_val.decimal_point);
+}
+
+TEST_F(SevenSegDisplaysTest, blinking_display_is_off_for_half_of_every_second)
+{
+    App_SevenSegDisplays_SetUnsignedBase10Value(seven_seg_displays, 12);
+    ASSERT_EQ(
+        EXIT_CODE_OK, App_SevenSegDisplays_SetBlinking(
+                          seven_seg_displays, LEFT_SEVEN_SEG_DISPLAY, true));
+    ASSERT_EQ(1, display_value_callback_fake.call_count);
+
+    // Tick at 100Hz for 2 seconds, counting the ticks the left 7-segment
+    // display is on
+    size_t num_ticks_on = 0;
+    for (size_t i = 0; i < 200; i++)
+    {
+        App_SevenSegDisplays_Tick(seven_seg_displays);
+        num_ticks_on += set_left_hex_digit_fake.arg0_val.enabled ? 1 : 0;
+
+        // Only the left 7-segment display blinks
+        ASSERT_EQ(true, set_middle_hex_digit_fake.arg0_val.enabled);
+    }
+
+    ASSERT_EQ(100, num_ticks_on);
+
+    // The displays are only set again when the left 7-segment display turns
+    // on or off
+    ASSERT_EQ(5, display_value_callback_fake.call_count);
+
+    ASSERT_EQ(
+        EXIT_CODE_OK, App_SevenSegDisplays_SetBlinking(
+                          seven_seg_displays, LEFT_SEVEN_SEG_DISPLAY, false));
+    for (size_t i = 0; i < 200; i++)
+    {
+        App_SevenSegDisplays_Tick(seven_seg_displays);
+        ASSERT_EQ(true, set_left_hex_digit_fake.arg0_val.enabled);
+    }
+}
+
+TEST_F(SevenSegDisplaysTest, out_of_bound_display_attributes_are_invalid)
+{
+    ASSERT_EQ(
+        EXIT_CODE_INVALID_ARGS,
+        App_SevenSegDisplays_SetDecimalPoint(
+            seven_seg_displays, NUM_SEVEN_SEG_DISPLAYS, true));
+    ASSERT_EQ(
+        EXIT_CODE_INVALID_ARGS,
+        App_SevenSegDisplays_SetBlinking(
+            seven_seg_displays, NUM_SEVEN_SEG_DISPLAYS, true));
+    ASSERT_EQ(0, display_value_callback_fake.call_count);
+}
+
+TEST_F(SevenSegDisplaysTest, brightness_is_only_set_when_it_changes)
+{
+    ASSERT_EQ(
+        EXIT_CODE_OK,
+        App_SevenSegDisplays_SetBrightness(seven_seg_displays, 0.5f));
+    ASSERT_EQ(
+        EXIT_CODE_OK,
+        App_SevenSegDisplays_SetBrightness(seven_seg_displays, 0.5f));
+    ASSERT_EQ(1, set_brightness_fake.call_count);
+    ASSERT_EQ(0.5f, set_brightness_fake.arg0_val);
+
+    ASSERT_EQ(
+        EXIT_CODE_OK,
+        App_SevenSegDisplays_SetBrightness(seven_seg_displays, 1.0f));
+    ASSERT_EQ(2, set_brightness_fake.call_count);
+    ASSERT_EQ(1.0f, set_brightness_fake.arg0_val);
+}
+
+TEST_F(SevenSegDisplaysTest, out_of_bound_brightness_is_invalid)
+{
+    ASSERT_EQ(
+        EXIT_CODE_INVALID_ARGS,
+        App_SevenSegDisplays_SetBrightness(seven_seg_displays, -0.1f));
+    ASSERT_EQ(
+        EXIT_CODE_INVALID_ARGS,
+        App_SevenSegDisplays_SetBrightness(seven_seg_displays, 1.1f));
+    ASSERT_EQ(
+        EXIT_CODE_INVALID_ARGS,
+        App_SevenSegDisplays_SetBrightness(seven_seg_displays, NAN));
+    ASSERT_EQ(0, set_brightness_fake.call_count);
+}
+
+TEST_F(SevenSegDisplaysTest, set_unsigned_fixed_point_value)
+{
+    // 5 with 2 decimal places is shown as 0.05
+    ASSERT_EQ(
+        EXIT_CODE_OK, App_SevenSegDisplays_SetUnsignedFixedPointValue(
+                          seven_seg_displays, 5, 2));
+    ASSERT_EQ(1, display_value_callback_fake.call_count);
+    ASSERT_EQ(true, set_right_hex_digit_fake.arg0_val.enabled);
+    ASSERT_EQ(true, set_right_hex_digit_fake.arg0_val.decimal_point);
+    ASSERT_EQ(0, set_right_hex_digit_fake.arg0_val.value);
+    ASSERT_EQ(true, set_middle_hex_digit_fake.arg0_val.enabled);
+    ASSERT_EQ(false, set_middle_hex_digit_fake.arg0_val.decimal_point);
+    ASSERT_EQ(0, set_middle_hex_digit_fake.arg0_val.value);
+    ASSERT_EQ(false, set_left_hex_digit_fake.arg0_val.decimal_point);
+    ASSERT_EQ(5, set_left_hex_digit_fake.arg0_val.value);
+
+    // 125 with 1 decimal place is shown as 12.5, and the digits and the moved
+    // decimal point are set at once
+    ASSERT_EQ(
+        EXIT_CODE_OK, App_SevenSegDisplays_SetUnsignedFixedPointValue(
+                          seven_seg_displays, 125, 1));
+    ASSERT_EQ(2, display_value_callback_fake.call_count);
+    ASSERT_EQ(false, set_right_hex_digit_fake.arg0_val.decimal_point);
+    ASSERT_EQ(1, set_right_hex_digit_fake.arg0_val.value);
+    ASSERT_EQ(true, set_middle_hex_digit_fake.arg0_val.decimal_point);
+    ASSERT_EQ(2, set_middle_hex_digit_fake.arg0_val.value);
+    ASSERT_EQ(false, set_left_hex_digit_fake.arg0_val.decimal_point);
+    ASSERT_EQ(5, set_left_hex_digit_fake.arg0_val.value);
+
+    // No decimal place clears the decimal point
+    ASSERT_EQ(
+        EXIT_CODE_OK, App_SevenSegDisplays_SetUnsignedFixedPointValue(
+                          seven_seg_displays, 7, 0));
+    ASSERT_EQ(false, set_right_hex_digit_fake.arg0_val.enabled);
+    ASSERT_EQ(false, set_right_hex_digit_fake.arg0_val.decimal_point);
+    ASSERT_EQ(false, set_middle_hex_digit_fake.arg0_val.enabled);
+    ASSERT_EQ(false, set_middle_hex_digit_fake.arg0_val.decimal_point);
+    ASSERT_EQ(false, set_left_hex_digit_fake.arg0_val.decimal_point);
+    ASSERT_EQ(7, set_left_hex_digit_fake.arg0_val.value);
+}
+
+TEST_F(SevenSegDisplaysTest, set_invalid_unsigned_fixed_point_values)
+{
+    ASSERT_EQ(
+        EXIT_CODE_INVALID_ARGS, App_SevenSegDisplays_SetUnsignedFixedPointValue(
+                                    seven_seg_displays, 1000, 1));
+    ASSERT_EQ(
+        EXIT_CODE_INVALID_ARGS,
+        App_SevenSegDisplays_SetUnsignedFixedPointValue(
+            seven_seg_displays, 5, NUM_SEVEN_SEG_DISPLAYS));
+    ASSERT_EQ(0, display_value_callback_fake.call_count);
+}
@@ -15,6 +15,7 @@ extern "C"
 #include "configs/App_RotarySwitchConfig.h"
 #include "configs/App_RegenPaddleConfig.h"
 #include "configs/App_HeartbeatMonitorConfig.h"
+#include "configs/App_DashboardConfig.h"
 }
 
 namespace StateMachineTest
@@ -30,6 +31,7 @@ FAKE_VOID_FUNC(set_right_hex_digit, struct SevenSegHexDigit);
 FAKE_VOID_FUNC(set_middle_hex_digit, struct SevenSegHexDigit);
 FAKE_VOID_FUNC(set_left_hex_digit, struct SevenSegHexDigit);
 FAKE_VOID_FUNC(display_value_callback);
+FAKE_VOID_FUNC(set_brightness, float);
 
 FAKE_VALUE_FUNC(uint32_t, get_current_ms);
 FAKE_VOID_FUNC(
@@ -79,6 +81,11 @@ FAKE_VOID_FUNC(turn_pdm_status_led_green);
 FAKE_VOID_FUNC(turn_pdm_status_led_blue);
 FAKE_VOID_FUNC(turn_off_pdm_status_led);
 
+static const struct DashboardPage dashboard_pages[] = {
+    { App_CanRx_BMS_STATE_OF_CHARGE_GetSignal_STATE_OF_CHARGE, 0 },
+    { App_CanRx_BMS_ACCUMULATOR_PACK_GetSignal_PACK_VOLTAGE, 0 },
+};
+
 class DimStateMachineTest : public BaseStateMachineTest
 {
   protected:
@@ -99,7 +106,7 @@ class DimStateMachineTest : public BaseStateMachineTest
 
         seven_seg_displays = App_SevenSegDisplays_Create(
             left_seven_seg_display, middle_seven_seg_display,
-            right_seven_seg_display, display_value_callback);
+            right_seven_seg_display, display_value_callback, set_brightness);
 
         heartbeat_monitor = App_SharedHeartbeatMonitor_Create(
             get_current_ms, HEARTBEAT_MONITOR_TIMEOUT_PERIOD_MS,
@@ -151,13 +158,18 @@ class DimStateMachineTest : public BaseStateMachineTest
 
         clock = App_SharedClock_Create();
 
+        dashboard = App_Dashboard_Create(
+            seven_seg_displays, dashboard_pages,
+            NUM_ELEMENTS_IN_ARRAY(dashboard_pages),
+            DASHBOARD_MIN_ERROR_DISPLAY_TIME_MS);
+
         world = App_DimWorld_Create(
             can_tx_interface, can_rx_interface, seven_seg_displays,
             heartbeat_monitor, regen_paddle, rgb_led_sequence,
             drive_mode_switch, imd_led, bspd_led, start_switch,
             traction_control_switch, torque_vectoring_switch, error_table,
             bms_status_led, dcm_status_led, dim_status_led, fsm_status_led,
-            pdm_status_led, clock);
+            pdm_status_led, clock, dashboard);
 
         // Default to starting the state machine in the `Drive` state
         state_machine =
@@ -170,6 +182,7 @@ class DimStateMachineTest : public BaseStateMachineTest
         RESET_FAKE(set_middle_hex_digit);
         RESET_FAKE(set_left_hex_digit);
         RESET_FAKE(display_value_callback);
+        RESET_FAKE(set_brightness);
         RESET_FAKE(get_current_ms);
         RESET_FAKE(heartbeat_timeout_callback);
         RESET_FAKE(get_drive_mode_switch_position);
@@ -207,6 +220,7 @@ class DimStateMachineTest : public BaseStateMachineTest
 
     void TearDown() override
     {
+        DumpTraceIfFailed(state_machine);
         TearDownObject(world, App_DimWorld_Destroy);
         TearDownObject(state_machine, App_SharedStateMachine_Destroy);
         TearDownObject(can_tx_interface, App_CanTx_Destroy);
@@ -231,6 +245,7 @@ class DimStateMachineTest : public BaseStateMachineTest
         TearDownObject(fsm_status_led, App_SharedRgbLed_Destroy);
         TearDownObject(pdm_status_led, App_SharedRgbLed_Destroy);
         TearDownObject(clock, App_SharedClock_Destroy);
+        TearDownObject(dashboard, App_Dashboard_Destroy);
     }
 
     void SetInitialState(const struct State *const initial_state)
@@ -284,6 +299,7 @@ class DimStateMachineTest : public BaseStateMachineTest
     struct RgbLed *           fsm_status_led;
     struct RgbLed *           pdm_status_led;
     struct Clock *            clock;
+    struct Dashboard *        dashboard;
 };
 
 // DIM-12
@@ -399,6 +415,52 @@ TEST_F(
     ASSERT_EQ(5, set_right_hex_digit_fake.arg0_val.value);
 }
 
+TEST_F(
+    DimStateMachineTest,
+    check_torque_vectoring_switch_flick_selects_the_page_shown_on_7_seg_displays_in_drive_state)
+{
+    App_CanRx_BMS_STATE_OF_CHARGE_SetSignal_STATE_OF_CHARGE(
+        can_rx_interface, 50.0f);
+    App_CanRx_BMS_ACCUMULATOR_PACK_SetSignal_PACK_VOLTAGE(
+        can_rx_interface, 350.4f);
+
+    // The drive mode switch doesn't change the page
+    get_drive_mode_switch_position_fake.return_val = 1;
+    LetTimePass(state_machine, 10);
+    ASSERT_EQ(0, App_Dashboard_GetSelectedPage(dashboard));
+    ASSERT_EQ(0, set_left_hex_digit_fake.arg0_val.value);
+    ASSERT_EQ(5, set_middle_hex_digit_fake.arg0_val.value);
+    ASSERT_EQ(false, set_right_hex_digit_fake.arg0_val.enabled);
+
+    // Flicking the torque vectoring switch on and back off turns to the next
+    // page
+    torque_vectoring_switch_is_turned_on_fake.return_val = true;
+    LetTimePass(state_machine, 100);
+    torque_vectoring_switch_is_turned_on_fake.return_val = false;
+    LetTimePass(state_machine, 10);
+    ASSERT_EQ(1, App_Dashboard_GetSelectedPage(dashboard));
+    ASSERT_EQ(0, set_left_hex_digit_fake.arg0_val.value);
+    ASSERT_EQ(5, set_middle_hex_digit_fake.arg0_val.value);
+    ASSERT_EQ(3, set_right_hex_digit_fake.arg0_val.value);
+
+    // Turning the switch on and leaving it there doesn't
+    torque_vectoring_switch_is_turned_on_fake.return_val = true;
+    LetTimePass(state_machine, DASHBOARD_PAGE_FLICK_TIME_MS + 10);
+    torque_vectoring_switch_is_turned_on_fake.return_val = false;
+    LetTimePass(state_machine, DASHBOARD_PAGE_FLICK_TIME_MS + 10);
+    ASSERT_EQ(1, App_Dashboard_GetSelectedPage(dashboard));
+
+    // The pages wrap around
+    for (size_t i = 1U; i < App_Dashboard_GetNumPages(dashboard); i++)
+    {
+        torque_vectoring_switch_is_turned_on_fake.return_val = true;
+        LetTimePass(state_machine, 10);
+        torque_vectoring_switch_is_turned_on_fake.return_val = false;
+        LetTimePass(state_machine, 10);
+    }
+    ASSERT_EQ(0, App_Dashboard_GetSelectedPage(dashboard));
+}
+
 TEST_F(
     DimStateMachineTest,
     check_raw_paddle_position_is_broadcasted_over_can_in_drive_state)
@@ -521,13 +583,46 @@ TEST_F(
         CANMSGS_DIM_SWITCHES_START_SWITCH_OFF_CHOICE,
         App_CanTx_GetPeriodicSignal_TORQUE_VECTORING_SWITCH(can_tx_interface));
 
+    // The switch is only broadcast once it is left where it was turned to, as
+    // it may still be flicked back to page the dashboard
     torque_vectoring_switch_is_turned_on_fake.return_val = true;
     LetTimePass(state_machine, 10);
+    ASSERT_EQ(
+        CANMSGS_DIM_SWITCHES_START_SWITCH_OFF_CHOICE,
+        App_CanTx_GetPeriodicSignal_TORQUE_VECTORING_SWITCH(can_tx_interface));
+    LetTimePass(state_machine, DASHBOARD_PAGE_FLICK_TIME_MS + 20);
     ASSERT_EQ(
         CANMSGS_DIM_SWITCHES_START_SWITCH_ON_CHOICE,
         App_CanTx_GetPeriodicSignal_TORQUE_VECTORING_SWITCH(can_tx_interface));
 }
 
+// DIM-4
+TEST_F(
+    DimStateMachineTest,
+    check_torque_vectoring_switch_flick_is_not_broadcasted_over_can_in_drive_state)
+{
+    torque_vectoring_switch_is_turned_on_fake.return_val = false;
+    LetTimePass(state_machine, 10);
+
+    // Flicking the switch on and back off pages the dashboard without ever
+    // broadcasting the switch as on
+    torque_vectoring_switch_is_turned_on_fake.return_val = true;
+    for (uint32_t i = 0U; i < DASHBOARD_PAGE_FLICK_TIME_MS - 10U; i += 10U)
+    {
+        LetTimePass(state_machine, 10);
+        ASSERT_EQ(
+            CANMSGS_DIM_SWITCHES_START_SWITCH_OFF_CHOICE,
+            App_CanTx_GetPeriodicSignal_TORQUE_VECTORING_SWITCH(
+                can_tx_interface));
+    }
+    torque_vectoring_switch_is_turned_on_fake.return_val = false;
+    LetTimePass(state_machine, DASHBOARD_PAGE_FLICK_TIME_MS + 10);
+    ASSERT_EQ(1, App_Dashboard_GetSelectedPage(dashboard));
+    ASSERT_EQ(
+        CANMSGS_DIM_SWITCHES_START_SWITCH_OFF_CHOICE,
+        App_CanTx_GetPeriodicSignal_TORQUE_VECTORING_SWITCH(can_tx_interface));
+}
+
 // DIM-5
 TEST_F(DimStateMachineTest, imd_led_control_in_drive_state)
 {
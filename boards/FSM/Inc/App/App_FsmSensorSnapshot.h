@@ -0,0 +1,14 @@
+#pragma once
+
+#include <stdbool.h>
+
+// The sensor values sampled once at the start of a tick, so every reader
+// during that tick sees the same values
+struct FsmSensorSnapshot
+{
+    float papps_percentage;
+    float sapps_percentage;
+    bool  is_papps_alarm_active;
+    bool  is_sapps_alarm_active;
+    bool  is_brake_actuated;
+};
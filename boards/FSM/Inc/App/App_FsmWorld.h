@@ -7,9 +7,11 @@
 #include "App_SharedRgbLedSequence.h"
 #include "App_SharedBinaryStatus.h"
 #include "App_Brake.h"
-#include "App_SharedSignal.h"
+#include "App_SharedSignalEngine.h"
+#include "App_SharedSensorSnapshot.h"
 #include "App_SharedClock.h"
 #include "App_AcceleratorPedals.h"
+#include "App_FsmSensorSnapshot.h"
 
 struct FsmWorld;
 
@@ -139,7 +141,8 @@ struct RgbLedSequence *
     App_FsmWorld_GetRgbLedSequence(const struct FsmWorld *world);
 
 /**
- * Update the registered signals in the given world
+ * Sample the 1kHz sensor snapshot and update the registered signals in the
+ * given world
  * @note This function should be called periodically. And since the time
  *       resolution of the signal library is in milliseconds, it would make
  *       sense to call this function at 1kHz.
@@ -164,3 +167,27 @@ struct Clock *App_FsmWorld_GetClock(const struct FsmWorld *world);
  */
 struct AcceleratorPedals *
     App_FsmWorld_GetPappsAndSapps(const struct FsmWorld *world);
+
+/**
+ * Publish the last 1kHz sensor snapshot of the given world as its 100Hz sensor
+ * snapshot, without sampling the sensors again
+ * @note This should be called at the start of every 100Hz tick
+ * @param world The world to publish the 100Hz sensor snapshot for
+ */
+void App_FsmWorld_PublishSensorSnapshot100Hz(struct FsmWorld *world);
+
+/**
+ * Get the sensor snapshot sampled at the start of the current 1kHz tick
+ * @param world The world to get the 1kHz sensor snapshot for
+ * @return The 1kHz sensor snapshot for the given world
+ */
+const struct FsmSensorSnapshot *
+    App_FsmWorld_GetSensorSnapshot1kHz(const struct FsmWorld *world);
+
+/**
+ * Get the sensor snapshot published at the start of the current 100Hz tick
+ * @param world The world to get the 100Hz sensor snapshot for
+ * @return The 100Hz sensor snapshot for the given world
+ */
+const struct FsmSensorSnapshot *
+    App_FsmWorld_GetSensorSnapshot100Hz(const struct FsmWorld *world);
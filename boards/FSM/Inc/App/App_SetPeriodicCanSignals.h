@@ -1,6 +1,7 @@
 #pragma once
 
 #include "App_FsmWorld.h"
+#include "App_SharedStateMachine.h"
 
 void App_SetPeriodicSignals_FlowRateInRangeChecks(const struct FsmWorld *world);
 void App_SetPeriodicSignals_WheelSpeedInRangeChecks(
@@ -10,3 +11,7 @@ void App_SetPeriodicSignals_SteeringAngleInRangeCheck(
 void App_SetPeriodicSignals_Brake(const struct FsmWorld *world);
 void App_SetPeriodicSignals_AcceleratorPedal(const struct FsmWorld *world);
 void App_SetPeriodicSignals_MotorShutdownFaults(const struct FsmWorld *world);
+
+void App_SetPeriodicCanSignals_StateMachineTrace(
+    struct FsmCanTxInterface * can_tx,
+    const struct StateMachine *state_machine);
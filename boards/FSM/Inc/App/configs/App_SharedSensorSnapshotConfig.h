@@ -0,0 +1,5 @@
+#pragma once
+
+struct FsmWorld;
+
+#define World FsmWorld
@@ -1,21 +1,24 @@
 #pragma once
 
-#include <stdint.h>
+#include <stm32f3xx_hal.h>
 
 /**
- * Get the buffer for DMA controller to write raw ADC values into
- * @return Pointer to the buffer
+ * Initialize the ADC, and start converting the steering angle and brake
+ * pressure sensor voltages by DMA
+ * @param hadc: The handle of the ADC measuring the voltages
  */
-uint16_t *Io_Adc_GetRawAdcValues(void);
+void Io_Adc_Init(ADC_HandleTypeDef *hadc);
 
 /**
- * Get the voltage measured at ADC channel 1
+ * Get the voltage measured at ADC channel 1, averaged over the latest
+ * conversion sets
  * @return The voltage measured at ADC channel 1, in volts
  */
 float Io_Adc_GetChannel1Voltage(void);
 
 /**
- * Get the voltage measured at ADC channel 3
+ * Get the voltage measured at ADC channel 3, averaged over the latest
+ * conversion sets
  * @return The voltage measured at ADC channel 3, in volts
  */
 float Io_Adc_GetChannel3Voltage(void);
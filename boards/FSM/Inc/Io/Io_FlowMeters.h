@@ -19,27 +19,9 @@ float Io_FlowMeters_GetPrimaryFlowRate(void);
 float Io_FlowMeters_GetSecondaryFlowRate(void);
 
 /**
- * Update the frequency for the primary and secondary flow meter's PWM outputs.
- * @note This function should be called in the input capture callback function.
- * @param htim: The handle of the timer that triggered the input capture
- *              callback function
+ * Update the flow rates from the flow meter pulses captured since they were
+ * last updated
+ * @note This function should be called periodically, before the flow rates are
+ *       read
  */
-void Io_FlowMeters_InputCaptureCallback(TIM_HandleTypeDef *htim);
-
-/**
- * Check if the PWM signal of the primary flow meter is active. If it is
- * inactive (i.e. It has been unplugged or unpowered), set the frequency to NaN.
- *
- * @note This function should be called in the timer overflow interrupt
- *       for the PWM signal of the primary flow meter.
- */
-void Io_FlowMeters_CheckIfPrimaryIsActive(void);
-
-/**
- * Check if the PWM signal of the secondary flow meter is active. If it is
- * inactive (i.e. It has been unplugged or unpowered), set the frequency to NaN.
- *
- * @note This function should be called in the timer overflow interrupt
- *       for the PWM signal of the primary flow meter.
- */
-void Io_FlowMeters_CheckIfSecondaryIsActive(void);
+void Io_FlowMeters_Update(void);
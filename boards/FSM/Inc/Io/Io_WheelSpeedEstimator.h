@@ -0,0 +1,94 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// The number of teeth on the reluctor ring of each wheel
+#define RELUCTOR_RING_TOOTH_COUNT 48U
+
+struct WheelSpeedEstimator;
+
+/**
+ * Allocate and initialize an estimator for the speed of a wheel, from the
+ * timestamps of the reluctor ring teeth passing its wheel speed sensor
+ *
+ * @note The reluctor ring teeth are never spaced perfectly evenly, and the
+ *       wheel hub's runout makes the arc between them vary once per revolution
+ *       too. The estimator learns the arc between every pair of teeth over the
+ *       first revolutions and compensates for it from then on.
+ * @param tire_diameter_m: The diameter of the tire (m)
+ * @param tim_frequency_hz: The frequency of the timer capturing the timestamps
+ * @param tim_auto_reload_reg: Maximum value that the counter can count to
+ * @return Pointer to the allocated and initialized estimator
+ */
+struct WheelSpeedEstimator *Io_WheelSpeedEstimator_Create(
+    float    tire_diameter_m,
+    float    tim_frequency_hz,
+    uint32_t tim_auto_reload_reg);
+
+/**
+ * Deallocate the memory used by the given estimator
+ * @param wheel_speed_estimator: The estimator to deallocate
+ */
+void Io_WheelSpeedEstimator_Destroy(
+    struct WheelSpeedEstimator *wheel_speed_estimator);
+
+/**
+ * Update the estimates from the teeth captured since the last update
+ * @note This function must be called more often than the counter overflows
+ * @param wheel_speed_estimator: The estimator to update
+ * @param tooth_timestamps: The timestamps of the teeth captured since the last
+ *                          update, oldest first
+ * @param num_tooth_timestamps: The number of timestamps in tooth_timestamps
+ * @param counter: The value of the counter after the teeth were captured
+ */
+void Io_WheelSpeedEstimator_Update(
+    struct WheelSpeedEstimator *wheel_speed_estimator,
+    const uint16_t *            tooth_timestamps,
+    size_t                      num_tooth_timestamps,
+    uint32_t                    counter);
+
+/**
+ * Get the wheel speed measured from the latest tooth, for low latency
+ * @param wheel_speed_estimator: The estimator to get the wheel speed from
+ * @return The wheel speed, in km/h
+ */
+float Io_WheelSpeedEstimator_GetSpeedKph(
+    const struct WheelSpeedEstimator *wheel_speed_estimator);
+
+/**
+ * Get the wheel speed averaged over the teeth in the latest filter window, for
+ * telemetry and threshold comparisons
+ * @param wheel_speed_estimator: The estimator to get the wheel speed from
+ * @return The filtered wheel speed, in km/h
+ */
+float Io_WheelSpeedEstimator_GetFilteredSpeedKph(
+    const struct WheelSpeedEstimator *wheel_speed_estimator);
+
+/**
+ * Get the acceleration of the wheel, fitted to the speeds of the teeth in the
+ * latest filter window
+ * @param wheel_speed_estimator: The estimator to get the acceleration from
+ * @return The acceleration of the wheel, in m/s^2
+ */
+float Io_WheelSpeedEstimator_GetAccelerationMps2(
+    const struct WheelSpeedEstimator *wheel_speed_estimator);
+
+/**
+ * Get how much the wheel speed estimates can be trusted
+ * @param wheel_speed_estimator: The estimator to get the quality from
+ * @return The fraction of the teeth detected over the latest revolution, which
+ *         is halved until the tooth spacing has been learned, or 0 if the
+ *         wheel speed isn't being measured
+ */
+float Io_WheelSpeedEstimator_GetQuality(
+    const struct WheelSpeedEstimator *wheel_speed_estimator);
+
+/**
+ * Check if the estimator has learned the spacing of the reluctor ring teeth
+ * @param wheel_speed_estimator: The estimator to check
+ * @return true if the tooth spacing has been learned, else false
+ */
+bool Io_WheelSpeedEstimator_HasLearnedToothSpacing(
+    const struct WheelSpeedEstimator *wheel_speed_estimator);
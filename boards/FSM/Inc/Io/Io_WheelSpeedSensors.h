@@ -12,41 +12,59 @@ void Io_WheelSpeedSensors_Init(
     TIM_HandleTypeDef *htim_right_wheel_speed);
 
 /**
- * Get the wheel speed in km/h from the left wheel speed sensor
+ * Get the filtered wheel speed in km/h from the left wheel speed sensor
  * @return The wheel speed in km/h
  */
 float Io_WheelSpeedSensors_GetLeftSpeedKph(void);
 
 /**
- * Get the wheel speed in km/h from the right wheel speed sensor
+ * Get the filtered wheel speed in km/h from the right wheel speed sensor
  * @return The wheel speed in km/h
  */
 float Io_WheelSpeedSensors_GetRightSpeedKph(void);
 
 /**
- * Update the frequency for the left and right wheel speed sensors.
- * @note This function should be called in the input capture callback function.
- * @param htim The handle of the timer that triggered the input capture callback
- * function
+ * Get the wheel speed in km/h over the latest tooth of the left wheel speed
+ * sensor, which has lower latency but more noise than the filtered wheel speed
+ * @return The wheel speed in km/h
+ */
+float Io_WheelSpeedSensors_GetLeftFastSpeedKph(void);
+
+/**
+ * Get the wheel speed in km/h over the latest tooth of the right wheel speed
+ * sensor, which has lower latency but more noise than the filtered wheel speed
+ * @return The wheel speed in km/h
+ */
+float Io_WheelSpeedSensors_GetRightFastSpeedKph(void);
+
+/**
+ * Get the acceleration of the left wheel in m/s^2
+ * @return The acceleration of the left wheel in m/s^2
+ */
+float Io_WheelSpeedSensors_GetLeftAccelerationMps2(void);
+
+/**
+ * Get the acceleration of the right wheel in m/s^2
+ * @return The acceleration of the right wheel in m/s^2
+ */
+float Io_WheelSpeedSensors_GetRightAccelerationMps2(void);
+
+/**
+ * Get the quality of the left wheel speed, from 0 (not measured) to 1
+ * @return The quality of the left wheel speed
  */
-void Io_WheelSpeedSensors_InputCaptureCallback(TIM_HandleTypeDef *htim);
+float Io_WheelSpeedSensors_GetLeftQuality(void);
 
 /**
- * Check if the PWM signal of the left wheel speed sensor is active. If
- * it is inactive (i.e. It has been unplugged or unpowered), set the frequency
- * to NaN.
- *
- * @note This function should be called in the timer overflow interrupt
- *       for the PWM signal of the left wheel speed sensor.
+ * Get the quality of the right wheel speed, from 0 (not measured) to 1
+ * @return The quality of the right wheel speed
  */
-void Io_WheelSpeedSensors_CheckIfLeftSensorIsActive(void);
+float Io_WheelSpeedSensors_GetRightQuality(void);
 
 /**
- * Check if the PWM signal of the right wheel speed sensor is active. If
- * it is inactive (i.e. It has been unplugged or unpowered), set the frequency
- * to NaN.
- *
- * @note This function should be called in the timer overflow interrupt
- *       for the PWM signal of the right wheel speed sensor.
+ * Update the wheel speeds from the reluctor ring teeth captured since they
+ * were last updated
+ * @note This function should be called periodically, before the wheel speeds
+ *       are read
  */
-void Io_WheelSpeedSensors_CheckIfRightSensorIsActive(void);
+void Io_WheelSpeedSensors_Update(void);
@@ -4,10 +4,7 @@
 
 bool App_AcceleratorPedalSignals_IsPappsAlarmActive(struct FsmWorld *world)
 {
-    struct AcceleratorPedals *papps_and_sapps =
-        App_FsmWorld_GetPappsAndSapps(world);
-
-    return App_AcceleratorPedals_IsPrimaryEncoderAlarmActive(papps_and_sapps);
+    return App_FsmWorld_GetSensorSnapshot1kHz(world)->is_papps_alarm_active;
 }
 
 void App_AcceleratorPedalSignals_PappsAlarmCallback(struct FsmWorld *world)
@@ -22,10 +19,7 @@ void App_AcceleratorPedalSignals_PappsAlarmCallback(struct FsmWorld *world)
 
 bool App_AcceleratorPedalSignals_IsSappsAlarmActive(struct FsmWorld *world)
 {
-    struct AcceleratorPedals *papps_and_sapps =
-        App_FsmWorld_GetPappsAndSapps(world);
-
-    return App_AcceleratorPedals_IsSecondaryEncoderAlarmActive(papps_and_sapps);
+    return App_FsmWorld_GetSensorSnapshot1kHz(world)->is_sapps_alarm_active;
 }
 
 void App_AcceleratorPedalSignals_SappsAlarmCallback(struct FsmWorld *world)
@@ -41,25 +35,18 @@ void App_AcceleratorPedalSignals_SappsAlarmCallback(struct FsmWorld *world)
 bool App_AcceleratorPedalSignals_IsPappsAndSappsAlarmInactive(
     struct FsmWorld *world)
 {
-    struct AcceleratorPedals *papps_and_sapps =
-        App_FsmWorld_GetPappsAndSapps(world);
+    const struct FsmSensorSnapshot *sensors =
+        App_FsmWorld_GetSensorSnapshot1kHz(world);
 
-    return !App_AcceleratorPedals_IsPrimaryEncoderAlarmActive(
-               papps_and_sapps) &&
-           !App_AcceleratorPedals_IsSecondaryEncoderAlarmActive(
-               papps_and_sapps);
+    return !sensors->is_papps_alarm_active && !sensors->is_sapps_alarm_active;
 }
 
 bool App_AcceleratorPedalSignals_HasAppsDisagreement(struct FsmWorld *world)
 {
-    struct AcceleratorPedals *papps_and_sapps =
-        App_FsmWorld_GetPappsAndSapps(world);
-
-    return fabsf(
-               App_AcceleratorPedals_GetPrimaryPedalPercentage(
-                   papps_and_sapps) -
-               App_AcceleratorPedals_GetSecondaryPedalPercentage(
-                   papps_and_sapps)) > 10.0f;
+    const struct FsmSensorSnapshot *sensors =
+        App_FsmWorld_GetSensorSnapshot1kHz(world);
+
+    return fabsf(sensors->papps_percentage - sensors->sapps_percentage) > 10.0f;
 }
 
 bool App_AcceleratorPedalSignals_HasAppsAgreement(struct FsmWorld *world)
@@ -81,23 +68,16 @@ void App_AcceleratorPedalSignals_AppsDisagreementCallback(
 bool App_AcceleratorPedalSignals_HasAppsAndBrakePlausibilityFailure(
     struct FsmWorld *world)
 {
-    struct AcceleratorPedals *papps_and_sapps =
-        App_FsmWorld_GetPappsAndSapps(world);
-    struct Brake *brake = App_FsmWorld_GetBrake(world);
+    const struct FsmSensorSnapshot *sensors =
+        App_FsmWorld_GetSensorSnapshot1kHz(world);
 
-    return App_Brake_IsBrakeActuated(brake) &&
-           App_AcceleratorPedals_GetPrimaryPedalPercentage(papps_and_sapps) >
-               25.0f;
+    return sensors->is_brake_actuated && sensors->papps_percentage > 25.0f;
 }
 
 bool App_AcceleratorPedalSignals_IsAppsAndBrakePlausibilityOk(
     struct FsmWorld *world)
 {
-    struct AcceleratorPedals *papps_and_sapps =
-        App_FsmWorld_GetPappsAndSapps(world);
-
-    return App_AcceleratorPedals_GetPrimaryPedalPercentage(papps_and_sapps) <
-           5.0f;
+    return App_FsmWorld_GetSensorSnapshot1kHz(world)->papps_percentage < 5.0f;
 }
 
 void App_AcceleratorPedalSignals_AppsAndBrakePlausibilityFailureCallback(
@@ -6,9 +6,7 @@ bool App_FlowMetersSignals_IsPrimaryFlowRateBelowThreshold(
     struct InRangeCheck *primary_flow_rate_in_range_check =
         App_FsmWorld_GetPrimaryFlowRateInRangeCheck(world);
 
-    float primary_flow_rate;
-    return App_InRangeCheck_GetValue(
-               primary_flow_rate_in_range_check, &primary_flow_rate) ==
+    return App_InRangeCheck_GetStatus(primary_flow_rate_in_range_check) ==
            VALUE_UNDERFLOW;
 }
 
@@ -18,9 +16,7 @@ bool App_FlowMetersSignals_IsPrimaryFlowRateInRange(
     struct InRangeCheck *primary_flow_rate_in_range_check =
         App_FsmWorld_GetPrimaryFlowRateInRangeCheck(world);
 
-    float primary_flow_rate;
-    return App_InRangeCheck_GetValue(
-               primary_flow_rate_in_range_check, &primary_flow_rate) ==
+    return App_InRangeCheck_GetStatus(primary_flow_rate_in_range_check) ==
            VALUE_IN_RANGE;
 }
 
@@ -30,9 +26,7 @@ bool App_FlowMetersSignals_IsSecondaryFlowRateBelowThreshold(
     struct InRangeCheck *secondary_flow_rate_in_range_check =
         App_FsmWorld_GetSecondaryFlowRateInRangeCheck(world);
 
-    float secondary_flow_rate;
-    return App_InRangeCheck_GetValue(
-               secondary_flow_rate_in_range_check, &secondary_flow_rate) ==
+    return App_InRangeCheck_GetStatus(secondary_flow_rate_in_range_check) ==
            VALUE_UNDERFLOW;
 }
 
@@ -42,9 +36,7 @@ bool App_FlowMetersSignals_IsSecondaryFlowRateInRange(
     struct InRangeCheck *primary_flow_rate_in_range_check =
         App_FsmWorld_GetSecondaryFlowRateInRangeCheck(world);
 
-    float secondary_flow_rate;
-    return App_InRangeCheck_GetValue(
-               primary_flow_rate_in_range_check, &secondary_flow_rate) ==
+    return App_InRangeCheck_GetStatus(primary_flow_rate_in_range_check) ==
            VALUE_IN_RANGE;
 }
 
@@ -1,16 +1,15 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include <assert.h>
-#include <linkedlist.h>
 
 #include "App_FsmWorld.h"
 #include "configs/App_SignalCallbackDurations.h"
 
-struct SignalNode
-{
-    struct Signal *    signal;
-    struct SignalNode *next;
-};
+// The number of signals registered to the world
+#define NUM_SIGNALS 6U
+
+// The number of inputs sampled into each sensor snapshot
+#define NUM_SENSOR_SNAPSHOT_INPUTS 5U
 
 struct FsmWorld
 {
@@ -24,24 +23,76 @@ struct FsmWorld
     struct InRangeCheck *     steering_angle_in_range_check;
     struct Brake *            brake;
     struct RgbLedSequence *   rgb_led_sequence;
-    struct SignalNode *       signals_head;
+    struct SignalEngine *     signal_engine;
+    struct SensorSnapshot *   sensor_snapshot_1kHz;
     struct Clock *            clock;
     struct AcceleratorPedals *papps_and_sapps;
+
+    // The 1kHz sensor snapshot, as it was at the start of the current 100Hz
+    // tick. Only the 100Hz task reads and writes it.
+    struct FsmSensorSnapshot sensor_snapshot_100Hz;
 };
 
+// The functions used to sample each input of the sensor snapshot
+static float App_SamplePappsPercentage(struct FsmWorld *const world)
+{
+    return App_AcceleratorPedals_GetPrimaryPedalPercentage(
+        world->papps_and_sapps);
+}
+
+static float App_SampleSappsPercentage(struct FsmWorld *const world)
+{
+    return App_AcceleratorPedals_GetSecondaryPedalPercentage(
+        world->papps_and_sapps);
+}
+
+static bool App_SampleIsPappsAlarmActive(struct FsmWorld *const world)
+{
+    return App_AcceleratorPedals_IsPrimaryEncoderAlarmActive(
+        world->papps_and_sapps);
+}
+
+static bool App_SampleIsSappsAlarmActive(struct FsmWorld *const world)
+{
+    return App_AcceleratorPedals_IsSecondaryEncoderAlarmActive(
+        world->papps_and_sapps);
+}
+
+static bool App_SampleIsBrakeActuated(struct FsmWorld *const world)
+{
+    return App_Brake_IsBrakeActuated(world->brake);
+}
+
 /**
- * Register a signal to the given world
- * @param world The world to register a signal for
- * @param signal The signal to register to the given world
+ * Create a sensor snapshot with every sensor input of the given world
+ * @param world The world to create a sensor snapshot for
+ * @return The created sensor snapshot, whose ownership is given to the caller
  */
-static void App_RegisterSignal(struct FsmWorld *world, struct Signal *signal)
+static struct SensorSnapshot *
+    App_CreateSensorSnapshot(struct FsmWorld *const world)
 {
-    struct SignalNode *item = malloc(sizeof(struct SignalNode));
-    assert(item != NULL);
-    item->signal = signal;
-    item->next   = NULL;
-
-    SL_APPEND(world->signals_head, item);
+    struct SensorSnapshot *sensor_snapshot = App_SharedSensorSnapshot_Create(
+        world, sizeof(struct FsmSensorSnapshot), NUM_SENSOR_SNAPSHOT_INPUTS);
+
+    App_SharedSensorSnapshot_AddFloatInput(
+        sensor_snapshot, offsetof(struct FsmSensorSnapshot, papps_percentage),
+        App_SamplePappsPercentage);
+    App_SharedSensorSnapshot_AddFloatInput(
+        sensor_snapshot, offsetof(struct FsmSensorSnapshot, sapps_percentage),
+        App_SampleSappsPercentage);
+    App_SharedSensorSnapshot_AddBoolInput(
+        sensor_snapshot,
+        offsetof(struct FsmSensorSnapshot, is_papps_alarm_active),
+        App_SampleIsPappsAlarmActive);
+    App_SharedSensorSnapshot_AddBoolInput(
+        sensor_snapshot,
+        offsetof(struct FsmSensorSnapshot, is_sapps_alarm_active),
+        App_SampleIsSappsAlarmActive);
+    App_SharedSensorSnapshot_AddBoolInput(
+        sensor_snapshot, offsetof(struct FsmSensorSnapshot, is_brake_actuated),
+        App_SampleIsBrakeActuated);
+
+    return sensor_snapshot;
 }
 
 struct FsmWorld *App_FsmWorld_Create(
@@ -93,89 +144,76 @@ struct FsmWorld *App_FsmWorld_Create(
     world->steering_angle_in_range_check    = steering_angle_in_range_check;
     world->brake                            = brake;
     world->rgb_led_sequence                 = rgb_led_sequence;
-    world->signals_head                     = NULL;
     world->clock                            = clock;
     world->papps_and_sapps                  = papps_and_sapps;
 
+    world->signal_engine =
+        App_SharedSignalEngine_Create(0U, world, NUM_SIGNALS);
+    world->sensor_snapshot_1kHz = App_CreateSensorSnapshot(world);
+    App_SharedSensorSnapshot_Copy(
+        world->sensor_snapshot_1kHz, &world->sensor_snapshot_100Hz);
+
     struct SignalCallback papps_callback = {
         .entry_condition_high_duration_ms = PAPPS_ENTRY_HIGH_MS,
         .exit_condition_high_duration_ms  = PAPPS_EXIT_HIGH_MS,
         .function                         = papps_alarm_callback,
     };
-    struct Signal *papps_alarm_signal = App_SharedSignal_Create(
-        0, is_papps_alarm_active, is_papps_and_sapps_alarm_inactive, world,
-        papps_callback);
-    App_RegisterSignal(world, papps_alarm_signal);
+    App_SharedSignalEngine_AddSignal(
+        world->signal_engine, is_papps_alarm_active,
+        is_papps_and_sapps_alarm_inactive, papps_callback);
 
     struct SignalCallback sapps_callback = {
         .entry_condition_high_duration_ms = SAPPS_ENTRY_HIGH_MS,
         .exit_condition_high_duration_ms  = SAPPS_EXIT_HIGH_MS,
         .function                         = sapps_alarm_callback,
     };
-    struct Signal *sapps_alarm_signal = App_SharedSignal_Create(
-        0, is_sapps_alarm_active, is_papps_and_sapps_alarm_inactive, world,
-        sapps_callback);
-    App_RegisterSignal(world, sapps_alarm_signal);
+    App_SharedSignalEngine_AddSignal(
+        world->signal_engine, is_sapps_alarm_active,
+        is_papps_and_sapps_alarm_inactive, sapps_callback);
 
     struct SignalCallback apps_callback = {
         .entry_condition_high_duration_ms = APPS_ENTRY_HIGH_MS,
         .exit_condition_high_duration_ms  = APPS_EXIT_HIGH_MS,
         .function                         = apps_disagreement_callback,
     };
-    struct Signal *apps_disagreement_signal = App_SharedSignal_Create(
-        0, has_apps_disagreement, has_apps_agreement, world, apps_callback);
-    App_RegisterSignal(world, apps_disagreement_signal);
+    App_SharedSignalEngine_AddSignal(
+        world->signal_engine, has_apps_disagreement, has_apps_agreement,
+        apps_callback);
 
     struct SignalCallback apps_and_brake_callback = {
         .entry_condition_high_duration_ms = APPS_AND_BRAKE_ENTRY_HIGH_MS,
         .exit_condition_high_duration_ms  = APPS_AND_BRAKE_EXIT_HIGH_MS,
         .function = apps_and_brake_plausibility_failure_callback,
     };
-    struct Signal *apps_and_brake_plausibility_check_signal =
-        App_SharedSignal_Create(
-            0, has_apps_and_brake_plausibility_failure,
-            is_apps_and_brake_plausibility_ok, world, apps_and_brake_callback);
-    App_RegisterSignal(world, apps_and_brake_plausibility_check_signal);
+    App_SharedSignalEngine_AddSignal(
+        world->signal_engine, has_apps_and_brake_plausibility_failure,
+        is_apps_and_brake_plausibility_ok, apps_and_brake_callback);
 
     struct SignalCallback primary_flow_rate_callback = {
         .entry_condition_high_duration_ms = FLOW_METER_ENTRY_HIGH_MS,
         .exit_condition_high_duration_ms  = FLOW_METER_EXIT_HIGH_MS,
         .function = primary_flow_rate_below_threshold_callback
     };
-    struct Signal *primary_flow_rate_signal = App_SharedSignal_Create(
-        0, is_primary_flow_rate_below_threshold, is_primary_flow_rate_in_range,
-        world, primary_flow_rate_callback);
-    App_RegisterSignal(world, primary_flow_rate_signal);
+    App_SharedSignalEngine_AddSignal(
+        world->signal_engine, is_primary_flow_rate_below_threshold,
+        is_primary_flow_rate_in_range, primary_flow_rate_callback);
 
     struct SignalCallback secondary_flow_rate_callback = {
         .entry_condition_high_duration_ms = FLOW_METER_ENTRY_HIGH_MS,
         .exit_condition_high_duration_ms  = FLOW_METER_EXIT_HIGH_MS,
         .function = secondary_flow_rate_below_threshold_callback
     };
-    struct Signal *secondary_flow_rate_signal = App_SharedSignal_Create(
-        0, is_secondary_flow_rate_below_threshold,
-        is_secondary_flow_rate_in_range, world, secondary_flow_rate_callback);
-    App_RegisterSignal(world, secondary_flow_rate_signal);
+    App_SharedSignalEngine_AddSignal(
+        world->signal_engine, is_secondary_flow_rate_below_threshold,
+        is_secondary_flow_rate_in_range, secondary_flow_rate_callback);
 
     return world;
 }
 
 void App_FsmWorld_Destroy(struct FsmWorld *world)
 {
-    struct SignalNode *node, *tmp;
-
-    SL_FOREACH_SAFE(world->signals_head, node, tmp)
-    {
-        SL_DELETE(world->signals_head, node);
-        free(node->signal);
-        free(node);
-
-        if (world->signals_head == NULL)
-        {
-            break;
-        }
-    }
-
+    App_SharedSignalEngine_Destroy(world->signal_engine);
+    App_SharedSensorSnapshot_Destroy(world->sensor_snapshot_1kHz);
     free(world);
 }
 
@@ -248,15 +286,32 @@ void App_FsmWorld_UpdateSignals(
     const struct FsmWorld *world,
     uint32_t               current_time_ms)
 {
-    struct SignalNode *node_ptr;
-
-    SL_FOREACH(world->signals_head, node_ptr)
-    {
-        App_SharedSignal_Update(node_ptr->signal, current_time_ms);
-    }
+    App_SharedSensorSnapshot_Sample(world->sensor_snapshot_1kHz);
+    App_SharedSignalEngine_Tick(world->signal_engine, current_time_ms);
 }
 
 struct Clock *App_FsmWorld_GetClock(const struct FsmWorld *const world)
 {
     return world->clock;
 }
+
+void App_FsmWorld_PublishSensorSnapshot100Hz(struct FsmWorld *const world)
+{
+    // The 1kHz task may sample the sensors in the middle of the copy, which
+    // App_SharedSensorSnapshot_Copy() retries, so the inputs are never sampled
+    // twice per millisecond
+    App_SharedSensorSnapshot_Copy(
+        world->sensor_snapshot_1kHz, &world->sensor_snapshot_100Hz);
+}
+
+const struct FsmSensorSnapshot *
+    App_FsmWorld_GetSensorSnapshot1kHz(const struct FsmWorld *const world)
+{
+    return App_SharedSensorSnapshot_Get(world->sensor_snapshot_1kHz);
+}
+
+const struct FsmSensorSnapshot *
+    App_FsmWorld_GetSensorSnapshot100Hz(const struct FsmWorld *const world)
+{
+    return &world->sensor_snapshot_100Hz;
+}
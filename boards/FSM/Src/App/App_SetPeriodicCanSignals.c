@@ -1,93 +1,121 @@
+#include "App_SharedMacros.h"
 #include "App_SharedSetPeriodicCanSignals.h"
 #include "App_SetPeriodicCanSignals.h"
+#include "states/App_AirClosedState.h"
+#include "states/App_AirOpenState.h"
+
+STATIC_DEFINE_APP_SET_PERIODIC_CAN_SIGNALS_IN_RANGE_CHECKS(FsmCanTxInterface)
+STATIC_DEFINE_APP_SET_PERIODIC_CAN_SIGNALS_STATE_MACHINE_TRACE(
+    FsmCanTxInterface)
+
+/**
+ * Get the CAN choice used to identify the given state in the state machine
+ * trace, which is the same choice used by the FSM_STATE_MACHINE message
+ * @param state The state to get the CAN choice for
+ * @return The CAN choice for the given state
+ */
+static uint8_t App_GetStateChoice(const struct State *const state)
+{
+    if (state == App_GetAirOpenState())
+    {
+        return CANMSGS_FSM_STATE_MACHINE_STATE_AIR_OPEN_CHOICE;
+    }
+    else
+    {
+        return CANMSGS_FSM_STATE_MACHINE_STATE_AIR_CLOSED_CHOICE;
+    }
+}
 
-STATIC_DEFINE_APP_SET_PERIODIC_CAN_SIGNALS_IN_RANGE_CHECK(FsmCanTxInterface)
+static const struct InRangeCheckCanSignals flow_rate_can_signals[] = {
+    IN_RANGE_CHECK_CAN_SIGNALS(
+        FSM_NON_CRITICAL_ERRORS,
+        PRIMARY_FLOW_RATE,
+        PRIMARY_FLOW_RATE_OUT_OF_RANGE),
+    IN_RANGE_CHECK_CAN_SIGNALS(
+        FSM_NON_CRITICAL_ERRORS,
+        SECONDARY_FLOW_RATE,
+        SECONDARY_FLOW_RATE_OUT_OF_RANGE),
+};
+
+static const struct InRangeCheckCanSignals wheel_speed_can_signals[] = {
+    IN_RANGE_CHECK_CAN_SIGNALS(
+        FSM_NON_CRITICAL_ERRORS,
+        LEFT_WHEEL_SPEED,
+        LEFT_WHEEL_SPEED_OUT_OF_RANGE),
+    IN_RANGE_CHECK_CAN_SIGNALS(
+        FSM_NON_CRITICAL_ERRORS,
+        RIGHT_WHEEL_SPEED,
+        RIGHT_WHEEL_SPEED_OUT_OF_RANGE),
+};
+
+static const struct InRangeCheckCanSignals steering_angle_can_signals[] = {
+    IN_RANGE_CHECK_CAN_SIGNALS(
+        FSM_NON_CRITICAL_ERRORS,
+        STEERING_ANGLE,
+        STEERING_ANGLE_OUT_OF_RANGE),
+};
+
+static const struct InRangeCheckCanSignals brake_pressure_can_signals[] = {
+    IN_RANGE_CHECK_CAN_SIGNALS(
+        FSM_NON_CRITICAL_ERRORS,
+        BRAKE_PRESSURE,
+        BRAKE_PRESSURE_OUT_OF_RANGE),
+};
 
 void App_SetPeriodicSignals_FlowRateInRangeChecks(const struct FsmWorld *world)
 {
-    struct FsmCanTxInterface *can_tx = App_FsmWorld_GetCanTx(world);
-
-    struct InRangeCheck *primary_flow_rate_in_range_check =
-        App_FsmWorld_GetPrimaryFlowRateInRangeCheck(world);
-    struct InRangeCheck *secondary_flow_rate_in_range_check =
-        App_FsmWorld_GetSecondaryFlowRateInRangeCheck(world);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, primary_flow_rate_in_range_check,
-        App_CanTx_SetPeriodicSignal_PRIMARY_FLOW_RATE,
-        App_CanTx_SetPeriodicSignal_PRIMARY_FLOW_RATE_OUT_OF_RANGE,
-        CANMSGS_FSM_NON_CRITICAL_ERRORS_PRIMARY_FLOW_RATE_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_FSM_NON_CRITICAL_ERRORS_PRIMARY_FLOW_RATE_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_FSM_NON_CRITICAL_ERRORS_PRIMARY_FLOW_RATE_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, secondary_flow_rate_in_range_check,
-        App_CanTx_SetPeriodicSignal_SECONDARY_FLOW_RATE,
-        App_CanTx_SetPeriodicSignal_SECONDARY_FLOW_RATE_OUT_OF_RANGE,
-        CANMSGS_FSM_NON_CRITICAL_ERRORS_SECONDARY_FLOW_RATE_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_FSM_NON_CRITICAL_ERRORS_SECONDARY_FLOW_RATE_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_FSM_NON_CRITICAL_ERRORS_SECONDARY_FLOW_RATE_OUT_OF_RANGE_OVERFLOW_CHOICE);
+    struct InRangeCheck *const in_range_checks[] = {
+        App_FsmWorld_GetPrimaryFlowRateInRangeCheck(world),
+        App_FsmWorld_GetSecondaryFlowRateInRangeCheck(world),
+    };
+
+    App_SetPeriodicCanSignals_InRangeChecks(
+        App_FsmWorld_GetCanTx(world), in_range_checks, flow_rate_can_signals,
+        NUM_ELEMENTS_IN_ARRAY(flow_rate_can_signals), NULL);
 }
 
 void App_SetPeriodicSignals_WheelSpeedInRangeChecks(
     const struct FsmWorld *world)
 {
-    struct FsmCanTxInterface *can_tx = App_FsmWorld_GetCanTx(world);
-
-    struct InRangeCheck *left_wheel_speed_in_range_check =
-        App_FsmWorld_GetLeftWheelSpeedInRangeCheck(world);
-    struct InRangeCheck *right_wheel_speed_in_range_check =
-        App_FsmWorld_GetRightWheelSpeedInRangeCheck(world);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, left_wheel_speed_in_range_check,
-        App_CanTx_SetPeriodicSignal_LEFT_WHEEL_SPEED,
-        App_CanTx_SetPeriodicSignal_LEFT_WHEEL_SPEED_OUT_OF_RANGE,
-        CANMSGS_FSM_NON_CRITICAL_ERRORS_LEFT_WHEEL_SPEED_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_FSM_NON_CRITICAL_ERRORS_LEFT_WHEEL_SPEED_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_FSM_NON_CRITICAL_ERRORS_LEFT_WHEEL_SPEED_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, right_wheel_speed_in_range_check,
-        App_CanTx_SetPeriodicSignal_RIGHT_WHEEL_SPEED,
-        App_CanTx_SetPeriodicSignal_RIGHT_WHEEL_SPEED_OUT_OF_RANGE,
-        CANMSGS_FSM_NON_CRITICAL_ERRORS_RIGHT_WHEEL_SPEED_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_FSM_NON_CRITICAL_ERRORS_RIGHT_WHEEL_SPEED_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_FSM_NON_CRITICAL_ERRORS_RIGHT_WHEEL_SPEED_OUT_OF_RANGE_OVERFLOW_CHOICE);
+    struct InRangeCheck *const in_range_checks[] = {
+        App_FsmWorld_GetLeftWheelSpeedInRangeCheck(world),
+        App_FsmWorld_GetRightWheelSpeedInRangeCheck(world),
+    };
+
+    App_SetPeriodicCanSignals_InRangeChecks(
+        App_FsmWorld_GetCanTx(world), in_range_checks, wheel_speed_can_signals,
+        NUM_ELEMENTS_IN_ARRAY(wheel_speed_can_signals), NULL);
 }
 
 void App_SetPeriodicSignals_SteeringAngleInRangeCheck(
     const struct FsmWorld *world)
 {
-    struct FsmCanTxInterface *can_tx = App_FsmWorld_GetCanTx(world);
-
-    struct InRangeCheck *steering_angle_in_range_check =
-        App_FsmWorld_GetSteeringAngleInRangeCheck(world);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, steering_angle_in_range_check,
-        App_CanTx_SetPeriodicSignal_STEERING_ANGLE,
-        App_CanTx_SetPeriodicSignal_STEERING_ANGLE_OUT_OF_RANGE,
-        CANMSGS_FSM_NON_CRITICAL_ERRORS_STEERING_ANGLE_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_FSM_NON_CRITICAL_ERRORS_STEERING_ANGLE_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_FSM_NON_CRITICAL_ERRORS_STEERING_ANGLE_OUT_OF_RANGE_OVERFLOW_CHOICE);
+    struct InRangeCheck *const in_range_checks[] = {
+        App_FsmWorld_GetSteeringAngleInRangeCheck(world),
+    };
+
+    App_SetPeriodicCanSignals_InRangeChecks(
+        App_FsmWorld_GetCanTx(world), in_range_checks,
+        steering_angle_can_signals,
+        NUM_ELEMENTS_IN_ARRAY(steering_angle_can_signals), NULL);
 }
 
 void App_SetPeriodicSignals_Brake(const struct FsmWorld *world)
 {
     struct FsmCanTxInterface *can_tx = App_FsmWorld_GetCanTx(world);
 
-    struct Brake *brake = App_FsmWorld_GetBrake(world);
+    struct Brake *                  brake = App_FsmWorld_GetBrake(world);
+    const struct FsmSensorSnapshot *sensors =
+        App_FsmWorld_GetSensorSnapshot100Hz(world);
 
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, App_Brake_GetPressureInRangeCheck(brake),
-        App_CanTx_SetPeriodicSignal_BRAKE_PRESSURE,
-        App_CanTx_SetPeriodicSignal_BRAKE_PRESSURE_OUT_OF_RANGE,
-        CANMSGS_FSM_NON_CRITICAL_ERRORS_BRAKE_PRESSURE_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_FSM_NON_CRITICAL_ERRORS_BRAKE_PRESSURE_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_FSM_NON_CRITICAL_ERRORS_BRAKE_PRESSURE_OUT_OF_RANGE_OVERFLOW_CHOICE);
+    struct InRangeCheck *const in_range_checks[] = {
+        App_Brake_GetPressureInRangeCheck(brake),
+    };
+    App_SetPeriodicCanSignals_InRangeChecks(
+        can_tx, in_range_checks, brake_pressure_can_signals,
+        NUM_ELEMENTS_IN_ARRAY(brake_pressure_can_signals), NULL);
 
-    if (App_Brake_IsBrakeActuated(brake))
+    if (sensors->is_brake_actuated)
     {
         App_CanTx_SetPeriodicSignal_BRAKE_IS_ACTUATED(
             can_tx, CANMSGS_FSM_BRAKE_BRAKE_IS_ACTUATED_TRUE_CHOICE);
@@ -116,27 +144,22 @@ void App_SetPeriodicSignals_AcceleratorPedal(const struct FsmWorld *world)
 {
     struct FsmCanTxInterface *can_tx = App_FsmWorld_GetCanTx(world);
 
-    struct Brake *            brake = App_FsmWorld_GetBrake(world);
-    struct AcceleratorPedals *papps_and_sapps =
-        App_FsmWorld_GetPappsAndSapps(world);
-
-    const float papps_pedal_percentage =
-        App_AcceleratorPedals_GetPrimaryPedalPercentage(papps_and_sapps);
+    const struct FsmSensorSnapshot *sensors =
+        App_FsmWorld_GetSensorSnapshot100Hz(world);
 
     App_CanTx_SetPeriodicSignal_PAPPS_MAPPED_PEDAL_PERCENTAGE(
-        can_tx, papps_pedal_percentage);
+        can_tx, sensors->papps_percentage);
     App_CanTx_SetPeriodicSignal_SAPPS_MAPPED_PEDAL_PERCENTAGE(
-        can_tx,
-        App_AcceleratorPedals_GetSecondaryPedalPercentage(papps_and_sapps));
+        can_tx, sensors->sapps_percentage);
 
-    if (App_Brake_IsBrakeActuated(brake))
+    if (sensors->is_brake_actuated)
     {
         App_CanTx_SetPeriodicSignal_MAPPED_PEDAL_PERCENTAGE(can_tx, 0.0f);
     }
     else
     {
         App_CanTx_SetPeriodicSignal_MAPPED_PEDAL_PERCENTAGE(
-            can_tx, papps_pedal_percentage);
+            can_tx, sensors->papps_percentage);
     }
 }
 
@@ -163,3 +186,11 @@ void App_SetPeriodicSignals_MotorShutdownFaults(const struct FsmWorld *world)
         can_tx,
         CANMSGS_FSM_MOTOR_SHUTDOWN_ERRORS_SECONDARY_FLOW_RATE_HAS_UNDERFLOW_FALSE_CHOICE);
 }
+
+void App_SetPeriodicCanSignals_StateMachineTrace(
+    struct FsmCanTxInterface *const  can_tx,
+    const struct StateMachine *const state_machine)
+{
+    App_SetPeriodicCanSignals_SharedStateMachineTrace(
+        can_tx, state_machine, App_GetStateChoice);
+}
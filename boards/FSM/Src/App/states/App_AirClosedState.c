@@ -20,6 +20,8 @@ static void AirClosedStateRunOnTick1Hz(struct StateMachine *const state_machine)
 static void
     AirClosedStateRunOnTick100Hz(struct StateMachine *const state_machine)
 {
+    App_AllStatesRunOnTick100Hz(state_machine);
+
     struct FsmWorld *world = App_SharedStateMachine_GetWorld(state_machine);
     struct FsmCanRxInterface *can_rx = App_FsmWorld_GetCanRx(world);
 
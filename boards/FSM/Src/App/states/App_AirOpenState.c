@@ -19,6 +19,8 @@ static void AirOpenStateRunOnTick1Hz(struct StateMachine *const state_machine)
 
 static void AirOpenStateRunOnTick100Hz(struct StateMachine *const state_machine)
 {
+    App_AllStatesRunOnTick100Hz(state_machine);
+
     struct FsmWorld *world = App_SharedStateMachine_GetWorld(state_machine);
     struct FsmCanRxInterface *can_rx = App_FsmWorld_GetCanRx(world);
 
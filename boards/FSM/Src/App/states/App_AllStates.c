@@ -1,4 +1,5 @@
 #include "states/App_AllStates.h"
+#include "App_SetPeriodicCanSignals.h"
 
 void App_AllStatesRunOnTick1Hz(struct StateMachine *const state_machine)
 {
@@ -7,4 +8,15 @@ void App_AllStatesRunOnTick1Hz(struct StateMachine *const state_machine)
         App_FsmWorld_GetRgbLedSequence(world);
 
     App_SharedRgbLedSequence_Tick(rgb_led_sequence);
+    App_SetPeriodicCanSignals_StateMachineTrace(
+        App_FsmWorld_GetCanTx(world), state_machine);
+}
+
+void App_AllStatesRunOnTick100Hz(struct StateMachine *const state_machine)
+{
+    struct FsmWorld *world = App_SharedStateMachine_GetWorld(state_machine);
+
+    // Publish the sensor snapshot first so every reader in this tick sees the
+    // same values
+    App_FsmWorld_PublishSensorSnapshot100Hz(world);
 }
@@ -1,5 +1,4 @@
-#include <stm32f3xx.h>
-#include "Io_SharedAdc.h"
+#include "Io_SharedDmaAdc.h"
 #include "Io_Adc.h"
 
 // In STM32 terminology, each ADC pin corresponds to an ADC channel (See:
@@ -10,12 +9,12 @@
 // For example, suppose we are measuring ADC channel 2, 4, and 7, which have
 // rank 3, 1, and 2 respectively. The ADC will measure the channel 4, then
 // channel 7, and finally channel 2. This order is important because it
-// determines the order in which the DMA writes data to our raw_adc_values
-// buffer.
+// determines the order in which the DMA writes each conversion set into the
+// buffer of raw ADC values.
 //
-// The following enum is used to index into raw_adc_values, which means it must
-// be ordered in ascending ranks. If we were writing an enum for the earlier
-// example, it would look like:
+// The following enum is used to index into each conversion set, which means it
+// must be ordered in ascending ranks. If we were writing an enum for the
+// earlier example, it would look like:
 //
 // enum
 // {
@@ -31,28 +30,40 @@ enum
     NUM_ADC_CHANNELS
 };
 
-static uint16_t raw_adc_values[NUM_ADC_CHANNELS];
-static float    adc_voltages[NUM_ADC_CHANNELS];
+// The number of conversion sets converted at a time. The ADC is triggered at
+// ADC_FREQUENCY, so the channels are updated at a quarter of that.
+#define NUM_CONVERSION_SETS 4U
+
+static const struct AdcChannelConfig channel_configs[NUM_ADC_CHANNELS] = {
+    [CHANNEL_1] = { .oversampling_ratio = 4U, .gain = 1.0f, .offset = 0.0f },
+    [CHANNEL_3] = { .oversampling_ratio = 4U, .gain = 1.0f, .offset = 0.0f },
+};
+
+static struct DmaAdc *adc;
+
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    UNUSED(hadc);
+    Io_SharedDmaAdc_ConvertFirstHalf(adc);
+}
 
 void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
 {
-    adc_voltages[CHANNEL_1] = Io_SharedAdc_ConvertRawAdcValueToVoltage(
-        hadc, raw_adc_values[CHANNEL_1]);
-    adc_voltages[CHANNEL_3] = Io_SharedAdc_ConvertRawAdcValueToVoltage(
-        hadc, raw_adc_values[CHANNEL_3]);
+    UNUSED(hadc);
+    Io_SharedDmaAdc_ConvertSecondHalf(adc);
 }
 
-uint16_t *Io_Adc_GetRawAdcValues(void)
+void Io_Adc_Init(ADC_HandleTypeDef *const hadc)
 {
-    return raw_adc_values;
+    adc = Io_SharedDmaAdc_Create(hadc, NUM_CONVERSION_SETS, channel_configs);
 }
 
 float Io_Adc_GetChannel1Voltage(void)
 {
-    return adc_voltages[CHANNEL_1];
+    return Io_SharedDmaAdc_GetValue(adc, CHANNEL_1);
 }
 
 float Io_Adc_GetChannel3Voltage(void)
 {
-    return adc_voltages[CHANNEL_3];
+    return Io_SharedDmaAdc_GetValue(adc, CHANNEL_3);
 }
@@ -1,57 +1,41 @@
 #include <assert.h>
 #include "main.h"
-#include "Io_SharedFreqOnlyPwmInput.h"
+#include "Io_SharedDmaInputCapture.h"
 #include "Io_FlowMeters.h"
 
-static struct FreqOnlyPwmInput *primary_flow_meter, *secondary_flow_meter;
+// The flow meter frequency is averaged over this window at high flow rates, and
+// measured from a single period at low flow rates
+static const float AVERAGING_WINDOW_S = 0.05f;
+
+// There is considered to be no flow below this flow meter frequency
+static const float MIN_FLOW_METER_FREQUENCY_HZ = 2.0f;
+
+static struct DmaInputCapture *primary_flow_meter, *secondary_flow_meter;
 
 void Io_FlowMeters_Init(TIM_HandleTypeDef *htim)
 {
     assert(htim != NULL);
 
-    primary_flow_meter = Io_SharedFreqOnlyPwmInput_Create(
+    primary_flow_meter = Io_SharedDmaInputCapture_Create(
         htim, TIMx_FREQUENCY / TIM4_PRESCALER, TIM_CHANNEL_1,
-        TIM4_AUTO_RELOAD_REG, HAL_TIM_ACTIVE_CHANNEL_1);
-    secondary_flow_meter = Io_SharedFreqOnlyPwmInput_Create(
+        TIM4_AUTO_RELOAD_REG, AVERAGING_WINDOW_S, MIN_FLOW_METER_FREQUENCY_HZ);
+    secondary_flow_meter = Io_SharedDmaInputCapture_Create(
         htim, TIMx_FREQUENCY / TIM4_PRESCALER, TIM_CHANNEL_2,
-        TIM4_AUTO_RELOAD_REG, HAL_TIM_ACTIVE_CHANNEL_2);
+        TIM4_AUTO_RELOAD_REG, AVERAGING_WINDOW_S, MIN_FLOW_METER_FREQUENCY_HZ);
 }
 
 float Io_FlowMeters_GetPrimaryFlowRate(void)
 {
-    return Io_SharedFreqOnlyPwmInput_GetFrequency(primary_flow_meter) / 7.5f;
+    return Io_SharedDmaInputCapture_GetFrequency(primary_flow_meter) / 7.5f;
 }
 
 float Io_FlowMeters_GetSecondaryFlowRate(void)
 {
-    return Io_SharedFreqOnlyPwmInput_GetFrequency(secondary_flow_meter) / 7.5f;
-}
-
-void Io_FlowMeters_InputCaptureCallback(TIM_HandleTypeDef *htim)
-{
-    if (htim == Io_SharedFreqOnlyPwmInput_GetTimerHandle(primary_flow_meter) &&
-        htim->Channel ==
-            Io_SharedFreqOnlyPwmInput_GetTimerActiveChannel(primary_flow_meter))
-    {
-        Io_SharedFreqOnlyPwmInput_Tick(primary_flow_meter);
-    }
-
-    else if (
-        htim ==
-            Io_SharedFreqOnlyPwmInput_GetTimerHandle(secondary_flow_meter) &&
-        htim->Channel == Io_SharedFreqOnlyPwmInput_GetTimerActiveChannel(
-                             secondary_flow_meter))
-    {
-        Io_SharedFreqOnlyPwmInput_Tick(secondary_flow_meter);
-    }
-}
-
-void Io_FlowMeters_CheckIfPrimaryIsActive(void)
-{
-    Io_SharedFreqOnlyPwmInput_CheckIfPwmIsActive(primary_flow_meter);
+    return Io_SharedDmaInputCapture_GetFrequency(secondary_flow_meter) / 7.5f;
 }
 
-void Io_FlowMeters_CheckIfSecondaryIsActive(void)
+void Io_FlowMeters_Update(void)
 {
-    Io_SharedFreqOnlyPwmInput_CheckIfPwmIsActive(secondary_flow_meter);
+    Io_SharedDmaInputCapture_Update(primary_flow_meter);
+    Io_SharedDmaInputCapture_Update(secondary_flow_meter);
 }
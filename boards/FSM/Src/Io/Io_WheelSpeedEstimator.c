@@ -0,0 +1,556 @@
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include "Io_WheelSpeedEstimator.h"
+
+// Note: Unit for length is measured in metres unless specified
+static const float MPS_TO_KPH_CONVERSION_FACTOR = 3.6f;
+
+// The filtered wheel speed and the acceleration are fitted to the teeth within
+// this window, or to the latest few teeth if fewer teeth fall in it (s)
+static const float  FILTER_WINDOW_S        = 0.1f;
+static const size_t MIN_NUM_FILTERED_TEETH = 3U;
+
+// The wheel is considered stopped if no tooth has been captured for the
+// period of this tooth frequency
+static const float MIN_TOOTH_FREQUENCY_HZ = 2.0f;
+
+// A tooth period at least this many times longer than predicted from the last
+// tooth period is taken as missing teeth, unless more teeth would be missing
+// than the wheel speed sensor plausibly skips in a row
+static const float  MISSING_TOOTH_PERIOD_RATIO = 1.5f;
+static const size_t MAX_NUM_MISSING_TEETH      = 3U;
+
+// The tooth spacing is averaged over this many revolutions before it is used,
+// then keeps adapting at the minimum learning rate
+static const size_t NUM_LEARNING_REVOLUTIONS        = 4U;
+static const float  MIN_TOOTH_SPACING_LEARNING_RATE = 0.05f;
+
+// The tooth spacing isn't learned from revolutions where the wheel speed
+// changed by more than this fraction between their halves
+static const float MAX_LEARNING_SPEED_CHANGE = 0.2f;
+#define NUM_TOOTH_EVENTS (RELUCTOR_RING_TOOTH_COUNT + 1U)
+
+struct ToothEvent
+{
+    // The time the tooth was captured, in timer ticks
+    uint32_t time;
+
+    // The position of the tooth on the reluctor ring
+    size_t position;
+
+    // The number of teeth that passed since the previous tooth event, which is
+    // more than 1 if teeth were missed, or 0 if there is no previous event
+    size_t num_teeth;
+};
+
+struct WheelSpeedEstimator
+{
+    float    tim_frequency_hz;
+    uint32_t counter_period;
+    float    nominal_tooth_arc;
+    uint32_t filter_window_ticks;
+    uint32_t max_tooth_period_ticks;
+
+    // The counter extended to 32 bits, so tooth times can be compared across
+    // counter overflows
+    uint32_t prev_counter;
+    uint32_t current_time;
+
+    // A ring of the latest tooth events, with a full revolution of periods
+    struct ToothEvent tooth_events[NUM_TOOTH_EVENTS];
+    size_t            latest_event;
+    size_t            num_tooth_events;
+    size_t            num_consecutive_single_teeth;
+    size_t            position;
+
+    // The arc between every tooth and the tooth before it, relative to the
+    // nominal arc between teeth
+    float  tooth_spacings[RELUCTOR_RING_TOOTH_COUNT];
+    size_t num_tooth_spacing_samples;
+
+    float speed_mps;
+    float filtered_speed_mps;
+    float acceleration_mps2;
+    float quality;
+};
+
+/**
+ * Get the tooth event the given number of events before the latest event
+ * @param wheel_speed_estimator: The estimator to get the tooth event from
+ * @param age: The number of events before the latest event
+ * @return The tooth event the given number of events before the latest event
+ */
+static const struct ToothEvent *Io_GetToothEvent(
+    const struct WheelSpeedEstimator *wheel_speed_estimator,
+    size_t                            age);
+
+/**
+ * Get the arc covered by the given number of teeth up to the given position,
+ * compensated for the tooth spacing once it has been learned
+ * @param wheel_speed_estimator: The estimator to get the arc for
+ * @param position: The position of the last tooth
+ * @param num_teeth: The number of teeth
+ * @return The arc covered by the teeth (m)
+ */
+static float Io_GetToothArc(
+    const struct WheelSpeedEstimator *wheel_speed_estimator,
+    size_t                            position,
+    size_t                            num_teeth);
+
+/**
+ * Add a tooth captured at the given time to the ring of tooth events
+ * @param wheel_speed_estimator: The estimator to add the tooth to
+ * @param time: The time the tooth was captured, in timer ticks
+ */
+static void Io_AddTooth(
+    struct WheelSpeedEstimator *wheel_speed_estimator,
+    uint32_t                    time);
+
+/**
+ * Learn the spacing of the tooth in the middle of the latest revolution, from
+ * its period relative to the period of the revolution. Taking the tooth in the
+ * middle cancels out the change in period from a constant acceleration.
+ * @param wheel_speed_estimator: The estimator to learn the tooth spacing for
+ */
+static void
+    Io_LearnToothSpacing(struct WheelSpeedEstimator *wheel_speed_estimator);
+
+/**
+ * Update the wheel speeds, acceleration and quality from the ring of tooth
+ * events
+ * @param wheel_speed_estimator: The estimator to update the estimates for
+ */
+static void
+    Io_UpdateEstimates(struct WheelSpeedEstimator *wheel_speed_estimator);
+
+static const struct ToothEvent *Io_GetToothEvent(
+    const struct WheelSpeedEstimator *const wheel_speed_estimator,
+    const size_t                            age)
+{
+    return &wheel_speed_estimator->tooth_events
+                [(wheel_speed_estimator->latest_event + NUM_TOOTH_EVENTS -
+                  age) %
+                 NUM_TOOTH_EVENTS];
+}
+
+static float Io_GetToothArc(
+    const struct WheelSpeedEstimator *const wheel_speed_estimator,
+    const size_t                            position,
+    const size_t                            num_teeth)
+{
+    if (!Io_WheelSpeedEstimator_HasLearnedToothSpacing(wheel_speed_estimator))
+    {
+        return (float)num_teeth * wheel_speed_estimator->nominal_tooth_arc;
+    }
+
+    float tooth_spacing = 0.0f;
+    for (size_t i = 0U; i < num_teeth; i++)
+    {
+        tooth_spacing += wheel_speed_estimator->tooth_spacings
+                             [(position + RELUCTOR_RING_TOOTH_COUNT - i) %
+                              RELUCTOR_RING_TOOTH_COUNT];
+    }
+    return tooth_spacing * wheel_speed_estimator->nominal_tooth_arc;
+}
+
+static void Io_AddTooth(
+    struct WheelSpeedEstimator *const wheel_speed_estimator,
+    const uint32_t                    time)
+{
+    size_t num_teeth = 0U;
+
+    if (wheel_speed_estimator->num_tooth_events > 0U)
+    {
+        const struct ToothEvent *const latest_event =
+            Io_GetToothEvent(wheel_speed_estimator, 0U);
+        const uint32_t period = time - latest_event->time;
+
+        // Teeth captured twice can't be told apart
+        if (period == 0U)
+        {
+            return;
+        }
+
+        if (period < wheel_speed_estimator->max_tooth_period_ticks)
+        {
+            num_teeth = 1U;
+        }
+        else
+        {
+            // The wheel had stopped, so this tooth only marks the start of the
+            // next period
+            wheel_speed_estimator->num_tooth_events = 0U;
+        }
+
+        if (num_teeth == 1U && latest_event->num_teeth > 0U)
+        {
+            // Predict the period of the next tooth from the speed over the
+            // latest tooth period, and its spacing
+            const uint32_t latest_period =
+                latest_event->time -
+                Io_GetToothEvent(wheel_speed_estimator, 1U)->time;
+            const float predicted_period =
+                (float)latest_period *
+                Io_GetToothArc(
+                    wheel_speed_estimator,
+                    (latest_event->position + 1U) % RELUCTOR_RING_TOOTH_COUNT,
+                    1U) /
+                Io_GetToothArc(
+                    wheel_speed_estimator, latest_event->position,
+                    latest_event->num_teeth);
+            const float period_ratio = (float)period / predicted_period;
+
+            if (period_ratio >= MISSING_TOOTH_PERIOD_RATIO &&
+                period_ratio < (float)MAX_NUM_MISSING_TEETH + 1.5f)
+            {
+                num_teeth = (size_t)(period_ratio + 0.5f);
+            }
+        }
+    }
+
+    // The teeth keep being counted while the wheel is stopped, so the learned
+    // tooth spacing still lines up with the teeth once it starts again
+    wheel_speed_estimator->position =
+        (wheel_speed_estimator->position + (num_teeth > 0U ? num_teeth : 1U)) %
+        RELUCTOR_RING_TOOTH_COUNT;
+
+    wheel_speed_estimator->latest_event =
+        (wheel_speed_estimator->latest_event + 1U) % NUM_TOOTH_EVENTS;
+    struct ToothEvent *const tooth_event =
+        &wheel_speed_estimator
+             ->tooth_events[wheel_speed_estimator->latest_event];
+    tooth_event->time      = time;
+    tooth_event->position  = wheel_speed_estimator->position;
+    tooth_event->num_teeth = num_teeth;
+
+    if (wheel_speed_estimator->num_tooth_events < NUM_TOOTH_EVENTS)
+    {
+        wheel_speed_estimator->num_tooth_events++;
+    }
+
+    if (num_teeth == 1U)
+    {
+        wheel_speed_estimator->num_consecutive_single_teeth++;
+    }
+    else
+    {
+        wheel_speed_estimator->num_consecutive_single_teeth = 0U;
+    }
+
+    if (wheel_speed_estimator->num_consecutive_single_teeth >=
+        RELUCTOR_RING_TOOTH_COUNT)
+    {
+        Io_LearnToothSpacing(wheel_speed_estimator);
+    }
+}
+
+static void Io_LearnToothSpacing(
+    struct WheelSpeedEstimator *const wheel_speed_estimator)
+{
+    const size_t             middle_age = RELUCTOR_RING_TOOTH_COUNT / 2U;
+    const struct ToothEvent *middle_event =
+        Io_GetToothEvent(wheel_speed_estimator, middle_age);
+
+    const uint32_t revolution_start_time =
+        Io_GetToothEvent(wheel_speed_estimator, RELUCTOR_RING_TOOTH_COUNT)
+            ->time;
+    const uint32_t revolution_end_time =
+        Io_GetToothEvent(wheel_speed_estimator, 0U)->time;
+    const uint32_t revolution_period =
+        revolution_end_time - revolution_start_time;
+
+    // The middle tooth only cancels out the change in period to first order,
+    // so revolutions where the wheel speed changed too much are skipped
+    const float half_revolution_period_ratio =
+        (float)(revolution_end_time - middle_event->time) /
+        (float)(middle_event->time - revolution_start_time);
+    if (fabsf(half_revolution_period_ratio - 1.0f) > MAX_LEARNING_SPEED_CHANGE)
+    {
+        return;
+    }
+    const uint32_t middle_period =
+        middle_event->time -
+        Io_GetToothEvent(wheel_speed_estimator, middle_age + 1U)->time;
+    const float tooth_spacing = (float)RELUCTOR_RING_TOOTH_COUNT *
+                                (float)middle_period / (float)revolution_period;
+
+    // Average the tooth spacing evenly over the learning revolutions, so every
+    // revolution is weighed the same while the tooth spacing is being learned
+    const size_t num_revolutions =
+        wheel_speed_estimator->num_tooth_spacing_samples /
+        RELUCTOR_RING_TOOTH_COUNT;
+    const float learning_rate = fmaxf(
+        1.0f / (float)(num_revolutions + 1U), MIN_TOOTH_SPACING_LEARNING_RATE);
+
+    float *const learned_tooth_spacing =
+        &wheel_speed_estimator->tooth_spacings[middle_event->position];
+    *learned_tooth_spacing +=
+        learning_rate * (tooth_spacing - *learned_tooth_spacing);
+    wheel_speed_estimator->num_tooth_spacing_samples++;
+
+    // Once a revolution, keep the tooth spacings summing to a full revolution
+    if (middle_event->position == 0U)
+    {
+        float sum_of_tooth_spacings = 0.0f;
+        for (size_t i = 0U; i < RELUCTOR_RING_TOOTH_COUNT; i++)
+        {
+            sum_of_tooth_spacings += wheel_speed_estimator->tooth_spacings[i];
+        }
+        for (size_t i = 0U; i < RELUCTOR_RING_TOOTH_COUNT; i++)
+        {
+            wheel_speed_estimator->tooth_spacings[i] *=
+                (float)RELUCTOR_RING_TOOTH_COUNT / sum_of_tooth_spacings;
+        }
+    }
+}
+
+static void
+    Io_UpdateEstimates(struct WheelSpeedEstimator *const wheel_speed_estimator)
+{
+    const struct ToothEvent *const latest_event =
+        Io_GetToothEvent(wheel_speed_estimator, 0U);
+
+    if (wheel_speed_estimator->num_tooth_events < 2U ||
+        latest_event->num_teeth == 0U)
+    {
+        wheel_speed_estimator->speed_mps          = 0.0f;
+        wheel_speed_estimator->filtered_speed_mps = 0.0f;
+        wheel_speed_estimator->acceleration_mps2  = 0.0f;
+        wheel_speed_estimator->quality            = 0.0f;
+        return;
+    }
+
+    const float tim_frequency_hz = wheel_speed_estimator->tim_frequency_hz;
+
+    // Fit a line to the speeds over each tooth period within the filter
+    // window, against the middle of each tooth period
+    size_t num_filtered_teeth = 0U;
+    float  filtered_arc       = 0.0f;
+    float  sum_t = 0.0f, sum_v = 0.0f, sum_tt = 0.0f, sum_tv = 0.0f;
+    float  latest_tooth_t = 0.0f;
+    size_t age            = 0U;
+    for (; age + 1U < wheel_speed_estimator->num_tooth_events; age++)
+    {
+        const struct ToothEvent *const tooth_event =
+            Io_GetToothEvent(wheel_speed_estimator, age);
+        const struct ToothEvent *const prev_tooth_event =
+            Io_GetToothEvent(wheel_speed_estimator, age + 1U);
+
+        if (tooth_event->num_teeth == 0U ||
+            (num_filtered_teeth >= MIN_NUM_FILTERED_TEETH &&
+             latest_event->time - prev_tooth_event->time >
+                 wheel_speed_estimator->filter_window_ticks))
+        {
+            break;
+        }
+
+        const float arc = Io_GetToothArc(
+            wheel_speed_estimator, tooth_event->position,
+            tooth_event->num_teeth);
+        const float period =
+            (float)(tooth_event->time - prev_tooth_event->time) /
+            tim_frequency_hz;
+        const float t = -(
+            (float)(latest_event->time - tooth_event->time) / tim_frequency_hz +
+            period / 2.0f);
+        const float v = arc / period;
+
+        if (age == 0U)
+        {
+            latest_tooth_t                   = t;
+            wheel_speed_estimator->speed_mps = v;
+        }
+
+        filtered_arc += arc;
+        sum_t += t;
+        sum_v += v;
+        sum_tt += t * t;
+        sum_tv += t * v;
+        num_filtered_teeth++;
+    }
+
+    const float filtered_period =
+        (float)(latest_event->time -
+                Io_GetToothEvent(wheel_speed_estimator, age)->time) /
+        tim_frequency_hz;
+    wheel_speed_estimator->filtered_speed_mps = filtered_arc / filtered_period;
+
+    const float n           = (float)num_filtered_teeth;
+    const float denominator = n * sum_tt - sum_t * sum_t;
+    wheel_speed_estimator->acceleration_mps2 =
+        (num_filtered_teeth >= MIN_NUM_FILTERED_TEETH && denominator > 0.0f)
+            ? (n * sum_tv - sum_t * sum_v) / denominator
+            : 0.0f;
+
+    // The speed over the latest tooth period lags behind by half of it, and
+    // the time since the latest tooth. Extrapolate it to the current time so
+    // it keeps up with the wheel when the tooth periods are long.
+    const uint32_t time_since_latest_tooth =
+        wheel_speed_estimator->current_time - latest_event->time;
+    wheel_speed_estimator->speed_mps = fmaxf(
+        wheel_speed_estimator->speed_mps +
+            wheel_speed_estimator->acceleration_mps2 *
+                ((float)time_since_latest_tooth / tim_frequency_hz -
+                 latest_tooth_t),
+        0.0f);
+
+    // The wheel can't have turned past the next teeth since the latest tooth,
+    // even if the wheel speed sensor is about to miss some of them. Bounding
+    // the wheel speed by it makes the wheel speed follow the wheel as it slows
+    // down to a stop, instead of holding the speed over the latest period.
+    if (time_since_latest_tooth > 0U)
+    {
+        const size_t max_num_teeth = MAX_NUM_MISSING_TEETH + 1U;
+        const float  max_speed_mps =
+            Io_GetToothArc(
+                wheel_speed_estimator,
+                (latest_event->position + max_num_teeth) %
+                    RELUCTOR_RING_TOOTH_COUNT,
+                max_num_teeth) *
+            tim_frequency_hz / (float)time_since_latest_tooth;
+        wheel_speed_estimator->speed_mps =
+            fminf(wheel_speed_estimator->speed_mps, max_speed_mps);
+        wheel_speed_estimator->filtered_speed_mps =
+            fminf(wheel_speed_estimator->filtered_speed_mps, max_speed_mps);
+    }
+
+    size_t num_detected_teeth = 0U;
+    size_t num_passed_teeth   = 0U;
+    for (size_t i = 0U; i + 1U < wheel_speed_estimator->num_tooth_events; i++)
+    {
+        const size_t num_teeth =
+            Io_GetToothEvent(wheel_speed_estimator, i)->num_teeth;
+        if (num_teeth == 0U)
+        {
+            break;
+        }
+        num_detected_teeth++;
+        num_passed_teeth += num_teeth;
+    }
+    wheel_speed_estimator->quality =
+        (float)num_detected_teeth / (float)num_passed_teeth;
+    if (!Io_WheelSpeedEstimator_HasLearnedToothSpacing(wheel_speed_estimator))
+    {
+        wheel_speed_estimator->quality /= 2.0f;
+    }
+}
+
+struct WheelSpeedEstimator *Io_WheelSpeedEstimator_Create(
+    const float    tire_diameter_m,
+    const float    tim_frequency_hz,
+    const uint32_t tim_auto_reload_reg)
+{
+    assert(tire_diameter_m > 0.0f);
+    assert(tim_frequency_hz > 0.0f);
+
+    struct WheelSpeedEstimator *const wheel_speed_estimator =
+        malloc(sizeof(struct WheelSpeedEstimator));
+    assert(wheel_speed_estimator != NULL);
+
+    wheel_speed_estimator->tim_frequency_hz = tim_frequency_hz;
+    wheel_speed_estimator->counter_period   = tim_auto_reload_reg + 1U;
+    wheel_speed_estimator->nominal_tooth_arc =
+        (float)M_PI * tire_diameter_m / (float)RELUCTOR_RING_TOOTH_COUNT;
+    wheel_speed_estimator->filter_window_ticks =
+        (uint32_t)(FILTER_WINDOW_S * tim_frequency_hz);
+    wheel_speed_estimator->max_tooth_period_ticks =
+        (uint32_t)(tim_frequency_hz / MIN_TOOTH_FREQUENCY_HZ);
+
+    // A stopped wheel can only be told apart from the counter overflowing if
+    // the longest tooth period is shorter than the period of the counter
+    assert(
+        wheel_speed_estimator->max_tooth_period_ticks <
+        wheel_speed_estimator->counter_period);
+
+    wheel_speed_estimator->prev_counter                 = 0U;
+    wheel_speed_estimator->current_time                 = 0U;
+    wheel_speed_estimator->latest_event                 = 0U;
+    wheel_speed_estimator->num_tooth_events             = 0U;
+    wheel_speed_estimator->num_consecutive_single_teeth = 0U;
+    wheel_speed_estimator->position                     = 0U;
+    wheel_speed_estimator->num_tooth_spacing_samples    = 0U;
+    for (size_t i = 0U; i < RELUCTOR_RING_TOOTH_COUNT; i++)
+    {
+        wheel_speed_estimator->tooth_spacings[i] = 1.0f;
+    }
+
+    wheel_speed_estimator->speed_mps          = 0.0f;
+    wheel_speed_estimator->filtered_speed_mps = 0.0f;
+    wheel_speed_estimator->acceleration_mps2  = 0.0f;
+    wheel_speed_estimator->quality            = 0.0f;
+
+    return wheel_speed_estimator;
+}
+
+void Io_WheelSpeedEstimator_Destroy(
+    struct WheelSpeedEstimator *const wheel_speed_estimator)
+{
+    free(wheel_speed_estimator);
+}
+
+void Io_WheelSpeedEstimator_Update(
+    struct WheelSpeedEstimator *const wheel_speed_estimator,
+    const uint16_t *const             tooth_timestamps,
+    const size_t                      num_tooth_timestamps,
+    const uint32_t                    counter)
+{
+    const uint32_t counter_period = wheel_speed_estimator->counter_period;
+
+    wheel_speed_estimator->current_time +=
+        (counter + counter_period - wheel_speed_estimator->prev_counter) %
+        counter_period;
+    wheel_speed_estimator->prev_counter = counter;
+
+    for (size_t i = 0U; i < num_tooth_timestamps; i++)
+    {
+        const uint32_t age =
+            (counter + counter_period - tooth_timestamps[i]) % counter_period;
+        Io_AddTooth(
+            wheel_speed_estimator, wheel_speed_estimator->current_time - age);
+    }
+
+    if (wheel_speed_estimator->num_tooth_events > 0U &&
+        wheel_speed_estimator->current_time -
+                Io_GetToothEvent(wheel_speed_estimator, 0U)->time >=
+            wheel_speed_estimator->max_tooth_period_ticks)
+    {
+        // The wheel has stopped
+        wheel_speed_estimator->num_tooth_events             = 0U;
+        wheel_speed_estimator->num_consecutive_single_teeth = 0U;
+    }
+
+    Io_UpdateEstimates(wheel_speed_estimator);
+}
+
+float Io_WheelSpeedEstimator_GetSpeedKph(
+    const struct WheelSpeedEstimator *const wheel_speed_estimator)
+{
+    return MPS_TO_KPH_CONVERSION_FACTOR * wheel_speed_estimator->speed_mps;
+}
+
+float Io_WheelSpeedEstimator_GetFilteredSpeedKph(
+    const struct WheelSpeedEstimator *const wheel_speed_estimator)
+{
+    return MPS_TO_KPH_CONVERSION_FACTOR *
+           wheel_speed_estimator->filtered_speed_mps;
+}
+
+float Io_WheelSpeedEstimator_GetAccelerationMps2(
+    const struct WheelSpeedEstimator *const wheel_speed_estimator)
+{
+    return wheel_speed_estimator->acceleration_mps2;
+}
+
+float Io_WheelSpeedEstimator_GetQuality(
+    const struct WheelSpeedEstimator *const wheel_speed_estimator)
+{
+    return wheel_speed_estimator->quality;
+}
+
+bool Io_WheelSpeedEstimator_HasLearnedToothSpacing(
+    const struct WheelSpeedEstimator *const wheel_speed_estimator)
+{
+    return wheel_speed_estimator->num_tooth_spacing_samples >=
+           NUM_LEARNING_REVOLUTIONS * RELUCTOR_RING_TOOTH_COUNT;
+}
@@ -1,18 +1,45 @@
 #include <assert.h>
-#include <math.h>
 #include "Io_WheelSpeedSensors.h"
-#include "Io_SharedFreqOnlyPwmInput.h"
+#include "Io_WheelSpeedEstimator.h"
+#include "Io_SharedDmaInputCapture.h"
 #include "main.h"
 
 // Note: Unit for length is measured in metres unless specified
-static const float  MPS_TO_KPH_CONVERSION_FACTOR = 3.6f;
-static const size_t RELUCTOR_RING_TOOTH_COUNT    = 48;
-static const float  TIRE_DIAMETER                = 0.4572f;
-static const float  ARC_LENGTH_PER_RELUCTOR_TOOTH =
-    (float)(((float)M_PI * TIRE_DIAMETER) / (float)RELUCTOR_RING_TOOTH_COUNT);
+static const float TIRE_DIAMETER = 0.4572f;
 
-static struct FreqOnlyPwmInput *left_wheel_speed_sensor,
+// The wheel speeds are estimated from every reluctor ring tooth, so the
+// reluctor ring frequency estimated by the DMA input capture isn't used
+static const float AVERAGING_WINDOW_S             = 0.05f;
+static const float MIN_RELUCTOR_RING_FREQUENCY_HZ = 2.0f;
+
+static struct DmaInputCapture *left_wheel_speed_sensor,
     *right_wheel_speed_sensor;
+static struct WheelSpeedEstimator *left_wheel_speed_estimator,
+    *right_wheel_speed_estimator;
+
+/**
+ * Update the estimator of a wheel speed from the teeth captured by its wheel
+ * speed sensor since it was last updated
+ * @param wheel_speed_sensor: The wheel speed sensor to read the teeth from
+ * @param wheel_speed_estimator: The estimator to update
+ */
+static void Io_UpdateWheelSpeedEstimator(
+    struct DmaInputCapture *    wheel_speed_sensor,
+    struct WheelSpeedEstimator *wheel_speed_estimator);
+
+static void Io_UpdateWheelSpeedEstimator(
+    struct DmaInputCapture *const     wheel_speed_sensor,
+    struct WheelSpeedEstimator *const wheel_speed_estimator)
+{
+    uint16_t tooth_timestamps[NUM_DMA_CAPTURED_TIMESTAMPS];
+    uint32_t counter;
+
+    const size_t num_tooth_timestamps = Io_SharedDmaInputCapture_ReadTimestamps(
+        wheel_speed_sensor, tooth_timestamps, NUM_DMA_CAPTURED_TIMESTAMPS,
+        &counter);
+    Io_WheelSpeedEstimator_Update(
+        wheel_speed_estimator, tooth_timestamps, num_tooth_timestamps, counter);
+}
 
 void Io_WheelSpeedSensors_Init(
     TIM_HandleTypeDef *htim_left_wheel_speed_sensor,
@@ -21,53 +48,69 @@ void Io_WheelSpeedSensors_Init(
     assert(htim_left_wheel_speed_sensor != NULL);
     assert(htim_right_wheel_speed_sensor != NULL);
 
-    left_wheel_speed_sensor = Io_SharedFreqOnlyPwmInput_Create(
+    left_wheel_speed_sensor = Io_SharedDmaInputCapture_Create(
         htim_left_wheel_speed_sensor, TIMx_FREQUENCY / TIM16_PRESCALER,
-        TIM_CHANNEL_1, TIM16_AUTO_RELOAD_REG, HAL_TIM_ACTIVE_CHANNEL_1);
+        TIM_CHANNEL_1, TIM16_AUTO_RELOAD_REG, AVERAGING_WINDOW_S,
+        MIN_RELUCTOR_RING_FREQUENCY_HZ);
+    left_wheel_speed_estimator = Io_WheelSpeedEstimator_Create(
+        TIRE_DIAMETER, TIMx_FREQUENCY / TIM16_PRESCALER, TIM16_AUTO_RELOAD_REG);
 
-    right_wheel_speed_sensor = Io_SharedFreqOnlyPwmInput_Create(
+    right_wheel_speed_sensor = Io_SharedDmaInputCapture_Create(
         htim_right_wheel_speed_sensor, TIMx_FREQUENCY / TIM17_PRESCALER,
-        TIM_CHANNEL_1, TIM17_AUTO_RELOAD_REG, HAL_TIM_ACTIVE_CHANNEL_1);
+        TIM_CHANNEL_1, TIM17_AUTO_RELOAD_REG, AVERAGING_WINDOW_S,
+        MIN_RELUCTOR_RING_FREQUENCY_HZ);
+    right_wheel_speed_estimator = Io_WheelSpeedEstimator_Create(
+        TIRE_DIAMETER, TIMx_FREQUENCY / TIM17_PRESCALER, TIM17_AUTO_RELOAD_REG);
 }
 
 float Io_WheelSpeedSensors_GetLeftSpeedKph(void)
 {
-    return MPS_TO_KPH_CONVERSION_FACTOR * ARC_LENGTH_PER_RELUCTOR_TOOTH *
-           Io_SharedFreqOnlyPwmInput_GetFrequency(left_wheel_speed_sensor);
+    return Io_WheelSpeedEstimator_GetFilteredSpeedKph(
+        left_wheel_speed_estimator);
 }
 
 float Io_WheelSpeedSensors_GetRightSpeedKph(void)
 {
-    return MPS_TO_KPH_CONVERSION_FACTOR * ARC_LENGTH_PER_RELUCTOR_TOOTH *
-           Io_SharedFreqOnlyPwmInput_GetFrequency(right_wheel_speed_sensor);
+    return Io_WheelSpeedEstimator_GetFilteredSpeedKph(
+        right_wheel_speed_estimator);
+}
+
+float Io_WheelSpeedSensors_GetLeftFastSpeedKph(void)
+{
+    return Io_WheelSpeedEstimator_GetSpeedKph(left_wheel_speed_estimator);
+}
+
+float Io_WheelSpeedSensors_GetRightFastSpeedKph(void)
+{
+    return Io_WheelSpeedEstimator_GetSpeedKph(right_wheel_speed_estimator);
+}
+
+float Io_WheelSpeedSensors_GetLeftAccelerationMps2(void)
+{
+    return Io_WheelSpeedEstimator_GetAccelerationMps2(
+        left_wheel_speed_estimator);
+}
+
+float Io_WheelSpeedSensors_GetRightAccelerationMps2(void)
+{
+    return Io_WheelSpeedEstimator_GetAccelerationMps2(
+        right_wheel_speed_estimator);
 }
 
-void Io_WheelSpeedSensors_InputCaptureCallback(TIM_HandleTypeDef *htim)
+float Io_WheelSpeedSensors_GetLeftQuality(void)
 {
-    if (htim ==
-            Io_SharedFreqOnlyPwmInput_GetTimerHandle(left_wheel_speed_sensor) &&
-        htim->Channel == Io_SharedFreqOnlyPwmInput_GetTimerActiveChannel(
-                             left_wheel_speed_sensor))
-    {
-        Io_SharedFreqOnlyPwmInput_Tick(left_wheel_speed_sensor);
-    }
-
-    else if (
-        htim == Io_SharedFreqOnlyPwmInput_GetTimerHandle(
-                    right_wheel_speed_sensor) &&
-        htim->Channel == Io_SharedFreqOnlyPwmInput_GetTimerActiveChannel(
-                             right_wheel_speed_sensor))
-    {
-        Io_SharedFreqOnlyPwmInput_Tick(right_wheel_speed_sensor);
-    }
+    return Io_WheelSpeedEstimator_GetQuality(left_wheel_speed_estimator);
 }
 
-void Io_WheelSpeedSensors_CheckIfRightSensorIsActive(void)
+float Io_WheelSpeedSensors_GetRightQuality(void)
 {
-    Io_SharedFreqOnlyPwmInput_CheckIfPwmIsActive(right_wheel_speed_sensor);
+    return Io_WheelSpeedEstimator_GetQuality(right_wheel_speed_estimator);
 }
 
-void Io_WheelSpeedSensors_CheckIfLeftSensorIsActive(void)
+void Io_WheelSpeedSensors_Update(void)
 {
-    Io_SharedFreqOnlyPwmInput_CheckIfPwmIsActive(left_wheel_speed_sensor);
+    Io_UpdateWheelSpeedEstimator(
+        left_wheel_speed_sensor, left_wheel_speed_estimator);
+    Io_UpdateWheelSpeedEstimator(
+        right_wheel_speed_sensor, right_wheel_speed_estimator);
 }
@@ -30,6 +30,7 @@
 #include "Io_CanRx.h"
 #include "Io_SharedSoftwareWatchdog.h"
 #include "Io_SharedCan.h"
+#include "Io_SharedCycleCounter.h"
 #include "Io_SharedHardFaultHandler.h"
 #include "Io_StackWaterMark.h"
 #include "Io_SoftwareWatchdog.h"
@@ -87,6 +88,10 @@ TIM_HandleTypeDef htim3;
 TIM_HandleTypeDef htim4;
 TIM_HandleTypeDef htim16;
 TIM_HandleTypeDef htim17;
+DMA_HandleTypeDef hdma_tim4_ch1;
+DMA_HandleTypeDef hdma_tim4_ch2;
+DMA_HandleTypeDef hdma_tim16_ch1_up;
+DMA_HandleTypeDef hdma_tim17_ch1_up;
 
 osThreadId          Task1HzHandle;
 uint32_t            Task1HzBuffer[TASK1HZ_STACK_SIZE];
@@ -204,9 +209,7 @@ int main(void)
     /* USER CODE BEGIN 2 */
     __HAL_DBGMCU_FREEZE_IWDG();
 
-    HAL_ADC_Start_DMA(
-        &hadc2, (uint32_t *)Io_Adc_GetRawAdcValues(),
-        hadc2.Init.NbrOfConversion);
+    Io_Adc_Init(&hadc2);
     HAL_TIM_Base_Start(&htim3);
 
     Io_SharedHardFaultHandler_Init();
@@ -291,6 +294,9 @@ int main(void)
         App_FlowMetersSignals_SecondaryFlowRateBelowThresholdCallback);
 
     state_machine = App_SharedStateMachine_Create(world, App_GetAirOpenState());
+    Io_SharedCycleCounter_Init();
+    App_SharedStateMachine_SetCycleCounter(
+        state_machine, Io_SharedCycleCounter_GetCycleCount);
 
     Io_StackWaterMark_Init(can_tx);
     Io_SoftwareWatchdog_Init(can_tx);
@@ -825,9 +831,22 @@ static void MX_TIM17_Init(void)
 static void MX_DMA_Init(void)
 {
     /* DMA controller clock enable */
+    __HAL_RCC_DMA1_CLK_ENABLE();
     __HAL_RCC_DMA2_CLK_ENABLE();
 
     /* DMA interrupt init */
+    /* DMA1_Channel1_IRQn interrupt configuration */
+    HAL_NVIC_SetPriority(DMA1_Channel1_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+    /* DMA1_Channel3_IRQn interrupt configuration */
+    HAL_NVIC_SetPriority(DMA1_Channel3_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Channel3_IRQn);
+    /* DMA1_Channel4_IRQn interrupt configuration */
+    HAL_NVIC_SetPriority(DMA1_Channel4_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Channel4_IRQn);
+    /* DMA1_Channel7_IRQn interrupt configuration */
+    HAL_NVIC_SetPriority(DMA1_Channel7_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Channel7_IRQn);
     /* DMA2_Channel1_IRQn interrupt configuration */
     HAL_NVIC_SetPriority(DMA2_Channel1_IRQn, 5, 0);
     HAL_NVIC_EnableIRQ(DMA2_Channel1_IRQn);
@@ -1032,6 +1051,8 @@ void RunTask100Hz(void const *argument)
     /* Infinite loop */
     for (;;)
     {
+        Io_FlowMeters_Update();
+        Io_WheelSpeedSensors_Update();
         App_SharedStateMachine_Tick100Hz(state_machine);
 
         // Watchdog check-in must be the last function called before putting
@@ -1053,19 +1074,7 @@ void RunTask100Hz(void const *argument)
 void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
 {
     /* USER CODE BEGIN Callback 0 */
-    if (htim->Instance == TIM4)
-    {
-        Io_FlowMeters_CheckIfPrimaryIsActive();
-        Io_FlowMeters_CheckIfSecondaryIsActive();
-    }
-    else if (htim->Instance == TIM16)
-    {
-        Io_WheelSpeedSensors_CheckIfLeftSensorIsActive();
-    }
-    else if (htim->Instance == TIM17)
-    {
-        Io_WheelSpeedSensors_CheckIfRightSensorIsActive();
-    }
+
     /* USER CODE END Callback 0 */
     if (htim->Instance == TIM6)
     {
@@ -26,6 +26,14 @@
 /* USER CODE END Includes */
 extern DMA_HandleTypeDef hdma_adc2;
 
+extern DMA_HandleTypeDef hdma_tim4_ch1;
+
+extern DMA_HandleTypeDef hdma_tim4_ch2;
+
+extern DMA_HandleTypeDef hdma_tim16_ch1_up;
+
+extern DMA_HandleTypeDef hdma_tim17_ch1_up;
+
 /* Private typedef -----------------------------------------------------------*/
 /* USER CODE BEGIN TD */
 
@@ -340,6 +348,27 @@ void HAL_TIM_Base_MspInit(TIM_HandleTypeDef *htim_base)
         GPIO_InitStruct.Alternate = GPIO_AF1_TIM16;
         HAL_GPIO_Init(FL_WHEEL_SPEED_GPIO_Port, &GPIO_InitStruct);
 
+        /* TIM16 DMA Init */
+        /* TIM16_CH1_UP Init */
+        hdma_tim16_ch1_up.Instance                 = DMA1_Channel3;
+        hdma_tim16_ch1_up.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+        hdma_tim16_ch1_up.Init.PeriphInc           = DMA_PINC_DISABLE;
+        hdma_tim16_ch1_up.Init.MemInc              = DMA_MINC_ENABLE;
+        hdma_tim16_ch1_up.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+        hdma_tim16_ch1_up.Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+        hdma_tim16_ch1_up.Init.Mode                = DMA_CIRCULAR;
+        hdma_tim16_ch1_up.Init.Priority            = DMA_PRIORITY_LOW;
+        if (HAL_DMA_Init(&hdma_tim16_ch1_up) != HAL_OK)
+        {
+            Error_Handler();
+        }
+
+        /* Several peripheral DMA handle pointers point to the same DMA handle.
+         Be aware that there is only one channel to perform all the requested
+         DMAs. */
+        __HAL_LINKDMA(htim_base, hdma[TIM_DMA_ID_CC1], hdma_tim16_ch1_up);
+        __HAL_LINKDMA(htim_base, hdma[TIM_DMA_ID_UPDATE], hdma_tim16_ch1_up);
+
         /* TIM16 interrupt Init */
         HAL_NVIC_SetPriority(TIM1_UP_TIM16_IRQn, 5, 0);
         HAL_NVIC_EnableIRQ(TIM1_UP_TIM16_IRQn);
@@ -366,6 +395,29 @@ void HAL_TIM_Base_MspInit(TIM_HandleTypeDef *htim_base)
         GPIO_InitStruct.Alternate = GPIO_AF10_TIM17;
         HAL_GPIO_Init(FR_WHEEL_SPEED_GPIO_Port, &GPIO_InitStruct);
 
+        /* TIM17 DMA Init */
+        /* TIM17_CH1_UP Init */
+        hdma_tim17_ch1_up.Instance                 = DMA1_Channel7;
+        hdma_tim17_ch1_up.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+        hdma_tim17_ch1_up.Init.PeriphInc           = DMA_PINC_DISABLE;
+        hdma_tim17_ch1_up.Init.MemInc              = DMA_MINC_ENABLE;
+        hdma_tim17_ch1_up.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+        hdma_tim17_ch1_up.Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+        hdma_tim17_ch1_up.Init.Mode                = DMA_CIRCULAR;
+        hdma_tim17_ch1_up.Init.Priority            = DMA_PRIORITY_LOW;
+        if (HAL_DMA_Init(&hdma_tim17_ch1_up) != HAL_OK)
+        {
+            Error_Handler();
+        }
+
+        __HAL_DMA_REMAP_CHANNEL_ENABLE(HAL_REMAPDMA_TIM17_DMA1_CH7);
+
+        /* Several peripheral DMA handle pointers point to the same DMA handle.
+         Be aware that there is only one channel to perform all the requested
+         DMAs. */
+        __HAL_LINKDMA(htim_base, hdma[TIM_DMA_ID_CC1], hdma_tim17_ch1_up);
+        __HAL_LINKDMA(htim_base, hdma[TIM_DMA_ID_UPDATE], hdma_tim17_ch1_up);
+
         /* TIM17 interrupt Init */
         HAL_NVIC_SetPriority(TIM1_TRG_COM_TIM17_IRQn, 5, 0);
         HAL_NVIC_EnableIRQ(TIM1_TRG_COM_TIM17_IRQn);
@@ -404,6 +456,39 @@ void HAL_TIM_IC_MspInit(TIM_HandleTypeDef *htim_ic)
         GPIO_InitStruct.Alternate = GPIO_AF10_TIM4;
         HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
 
+        /* TIM4 DMA Init */
+        /* TIM4_CH1 Init */
+        hdma_tim4_ch1.Instance                 = DMA1_Channel1;
+        hdma_tim4_ch1.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+        hdma_tim4_ch1.Init.PeriphInc           = DMA_PINC_DISABLE;
+        hdma_tim4_ch1.Init.MemInc              = DMA_MINC_ENABLE;
+        hdma_tim4_ch1.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+        hdma_tim4_ch1.Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+        hdma_tim4_ch1.Init.Mode                = DMA_CIRCULAR;
+        hdma_tim4_ch1.Init.Priority            = DMA_PRIORITY_LOW;
+        if (HAL_DMA_Init(&hdma_tim4_ch1) != HAL_OK)
+        {
+            Error_Handler();
+        }
+
+        __HAL_LINKDMA(htim_ic, hdma[TIM_DMA_ID_CC1], hdma_tim4_ch1);
+
+        /* TIM4_CH2 Init */
+        hdma_tim4_ch2.Instance                 = DMA1_Channel4;
+        hdma_tim4_ch2.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+        hdma_tim4_ch2.Init.PeriphInc           = DMA_PINC_DISABLE;
+        hdma_tim4_ch2.Init.MemInc              = DMA_MINC_ENABLE;
+        hdma_tim4_ch2.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+        hdma_tim4_ch2.Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+        hdma_tim4_ch2.Init.Mode                = DMA_CIRCULAR;
+        hdma_tim4_ch2.Init.Priority            = DMA_PRIORITY_LOW;
+        if (HAL_DMA_Init(&hdma_tim4_ch2) != HAL_OK)
+        {
+            Error_Handler();
+        }
+
+        __HAL_LINKDMA(htim_ic, hdma[TIM_DMA_ID_CC2], hdma_tim4_ch2);
+
         /* TIM4 interrupt Init */
         HAL_NVIC_SetPriority(TIM4_IRQn, 5, 0);
         HAL_NVIC_EnableIRQ(TIM4_IRQn);
@@ -511,6 +596,10 @@ void HAL_TIM_Base_MspDeInit(TIM_HandleTypeDef *htim_base)
         */
         HAL_GPIO_DeInit(FL_WHEEL_SPEED_GPIO_Port, FL_WHEEL_SPEED_Pin);
 
+        /* TIM16 DMA DeInit */
+        HAL_DMA_DeInit(htim_base->hdma[TIM_DMA_ID_CC1]);
+        HAL_DMA_DeInit(htim_base->hdma[TIM_DMA_ID_UPDATE]);
+
         /* TIM16 interrupt DeInit */
         /* USER CODE BEGIN TIM16:TIM1_UP_TIM16_IRQn disable */
         /**
@@ -537,6 +626,10 @@ void HAL_TIM_Base_MspDeInit(TIM_HandleTypeDef *htim_base)
         */
         HAL_GPIO_DeInit(FR_WHEEL_SPEED_GPIO_Port, FR_WHEEL_SPEED_Pin);
 
+        /* TIM17 DMA DeInit */
+        HAL_DMA_DeInit(htim_base->hdma[TIM_DMA_ID_CC1]);
+        HAL_DMA_DeInit(htim_base->hdma[TIM_DMA_ID_UPDATE]);
+
         /* TIM17 interrupt DeInit */
         /* USER CODE BEGIN TIM17:TIM1_TRG_COM_TIM17_IRQn disable */
         /**
@@ -574,6 +667,10 @@ void HAL_TIM_IC_MspDeInit(TIM_HandleTypeDef *htim_ic)
         */
         HAL_GPIO_DeInit(GPIOA, FLOW1_BUFF_Pin | FLOW2_BUFF_Pin);
 
+        /* TIM4 DMA DeInit */
+        HAL_DMA_DeInit(htim_ic->hdma[TIM_DMA_ID_CC1]);
+        HAL_DMA_DeInit(htim_ic->hdma[TIM_DMA_ID_CC2]);
+
         /* TIM4 interrupt DeInit */
         HAL_NVIC_DisableIRQ(TIM4_IRQn);
         /* USER CODE BEGIN TIM4_MspDeInit 1 */
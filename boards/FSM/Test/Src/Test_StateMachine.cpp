@@ -166,6 +166,7 @@ class FsmStateMachineTest : public BaseStateMachineTest
 
     void TearDown() override
     {
+        DumpTraceIfFailed(state_machine);
         TearDownObject(world, App_FsmWorld_Destroy);
         TearDownObject(state_machine, App_SharedStateMachine_Destroy);
         TearDownObject(can_tx_interface, App_CanTx_Destroy);
@@ -0,0 +1,306 @@
+#include <cmath>
+#include <random>
+#include <vector>
+#include "Test_Fsm.h"
+
+extern "C"
+{
+#include "Io_WheelSpeedEstimator.h"
+}
+
+namespace WheelSpeedEstimatorTest
+{
+static constexpr float    TIRE_DIAMETER_M     = 0.4572f;
+static constexpr float    TIM_FREQUENCY_HZ    = 65573.0f;
+static constexpr uint32_t TIM_AUTO_RELOAD_REG = 0xFFFF;
+static constexpr double   UPDATE_PERIOD_S     = 0.01;
+static constexpr double   SIMULATION_STEP_S   = 1e-5;
+static constexpr double   CIRCUMFERENCE_M     = M_PI * TIRE_DIAMETER_M;
+
+// A wheel whose reluctor ring teeth are unevenly spaced, and whose hub has
+// runout, captured by a 16-bit timer
+class ToothTrain
+{
+  public:
+    ToothTrain(double spacing_error, double runout)
+    {
+        std::mt19937                           random_engine{ 42 };
+        std::uniform_real_distribution<double> error{ -spacing_error,
+                                                      spacing_error };
+
+        // The fraction of the revolution at which each tooth passes the wheel
+        // speed sensor
+        double total_spacing = 0.0;
+        for (size_t i = 0U; i < RELUCTOR_RING_TOOTH_COUNT; i++)
+        {
+            total_spacing += 1.0 + error(random_engine);
+            tooth_fractions[i] = total_spacing;
+        }
+        for (size_t i = 0U; i < RELUCTOR_RING_TOOTH_COUNT; i++)
+        {
+            tooth_fractions[i] = tooth_fractions[i] / total_spacing +
+                                 runout * std::sin(
+                                              2.0 * M_PI * (double)i /
+                                              RELUCTOR_RING_TOOTH_COUNT);
+        }
+    }
+
+    // Run the wheel for the given time, and return the timestamps of the teeth
+    // captured in between
+    std::vector<uint16_t> Run(double duration_s)
+    {
+        std::vector<uint16_t> timestamps;
+        const double          end_time_s = time_s + duration_s;
+
+        while (time_s < end_time_s)
+        {
+            time_s += SIMULATION_STEP_S;
+            speed_mps = std::fmax(
+                0.0, speed_mps + acceleration_mps2 * SIMULATION_STEP_S);
+            distance_m += speed_mps * SIMULATION_STEP_S;
+
+            while (distance_m >= GetToothDistance(num_teeth))
+            {
+                if (missing_tooth_interval == 0U ||
+                    num_teeth % missing_tooth_interval != 0U)
+                {
+                    timestamps.push_back((uint16_t)GetCounter());
+                }
+                num_teeth++;
+            }
+        }
+        return timestamps;
+    }
+
+    uint32_t GetCounter(void) const
+    {
+        return (uint32_t)(time_s * TIM_FREQUENCY_HZ) %
+               (TIM_AUTO_RELOAD_REG + 1U);
+    }
+
+    double speed_mps              = 0.0;
+    double acceleration_mps2      = 0.0;
+    size_t missing_tooth_interval = 0U;
+
+  private:
+    double GetToothDistance(size_t tooth) const
+    {
+        return CIRCUMFERENCE_M *
+               ((double)(tooth / RELUCTOR_RING_TOOTH_COUNT) +
+                tooth_fractions[tooth % RELUCTOR_RING_TOOTH_COUNT]);
+    }
+
+    double tooth_fractions[RELUCTOR_RING_TOOTH_COUNT];
+    double time_s     = 0.0;
+    double distance_m = 0.0;
+    size_t num_teeth  = 0U;
+};
+
+class WheelSpeedEstimatorTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        wheel_speed_estimator = Io_WheelSpeedEstimator_Create(
+            TIRE_DIAMETER_M, TIM_FREQUENCY_HZ, TIM_AUTO_RELOAD_REG);
+    }
+
+    void TearDown() override
+    {
+        TearDownObject(wheel_speed_estimator, Io_WheelSpeedEstimator_Destroy);
+    }
+
+    // Run the wheel for one update period, then update the estimates
+    void Update(void)
+    {
+        const std::vector<uint16_t> timestamps = wheel.Run(UPDATE_PERIOD_S);
+        Io_WheelSpeedEstimator_Update(
+            wheel_speed_estimator, timestamps.data(), timestamps.size(),
+            wheel.GetCounter());
+    }
+
+    void Run(double duration_s)
+    {
+        for (double t = 0.0; t < duration_s - 1e-9; t += UPDATE_PERIOD_S)
+        {
+            Update();
+        }
+    }
+
+    // Run the wheel for the given time, and get the largest relative errors of
+    // the fast and filtered wheel speeds
+    void GetMaxSpeedErrors(
+        double duration_s,
+        float &max_speed_error,
+        float &max_filtered_speed_error)
+    {
+        max_speed_error          = 0.0f;
+        max_filtered_speed_error = 0.0f;
+        for (double t = 0.0; t < duration_s - 1e-9; t += UPDATE_PERIOD_S)
+        {
+            Update();
+            const float speed_kph = 3.6f * (float)wheel.speed_mps;
+            max_speed_error       = std::fmax(
+                max_speed_error,
+                std::fabs(
+                    Io_WheelSpeedEstimator_GetSpeedKph(wheel_speed_estimator) -
+                    speed_kph) /
+                    speed_kph);
+            max_filtered_speed_error = std::fmax(
+                max_filtered_speed_error,
+                std::fabs(
+                    Io_WheelSpeedEstimator_GetFilteredSpeedKph(
+                        wheel_speed_estimator) -
+                    speed_kph) /
+                    speed_kph);
+        }
+    }
+
+    ToothTrain                  wheel{ 0.05, 0.002 };
+    struct WheelSpeedEstimator *wheel_speed_estimator;
+};
+
+TEST_F(WheelSpeedEstimatorTest, speed_is_zero_while_stationary)
+{
+    Run(1.0);
+    ASSERT_EQ(0.0f, Io_WheelSpeedEstimator_GetSpeedKph(wheel_speed_estimator));
+    ASSERT_EQ(
+        0.0f,
+        Io_WheelSpeedEstimator_GetFilteredSpeedKph(wheel_speed_estimator));
+    ASSERT_EQ(0.0f, Io_WheelSpeedEstimator_GetQuality(wheel_speed_estimator));
+}
+
+TEST_F(WheelSpeedEstimatorTest, compensates_tooth_spacing_after_learning)
+{
+    float max_speed_error, max_filtered_speed_error;
+
+    // The unevenly spaced teeth make the speed over every tooth noisy until
+    // their spacing has been learned
+    wheel.speed_mps = 60.0 / 3.6;
+    GetMaxSpeedErrors(0.3, max_speed_error, max_filtered_speed_error);
+    ASSERT_FALSE(
+        Io_WheelSpeedEstimator_HasLearnedToothSpacing(wheel_speed_estimator));
+    ASSERT_GT(max_speed_error, 0.03f);
+    ASSERT_NEAR(
+        0.5f, Io_WheelSpeedEstimator_GetQuality(wheel_speed_estimator), 1e-6f);
+
+    Run(0.5);
+    ASSERT_TRUE(
+        Io_WheelSpeedEstimator_HasLearnedToothSpacing(wheel_speed_estimator));
+
+    GetMaxSpeedErrors(1.0, max_speed_error, max_filtered_speed_error);
+    ASSERT_LT(max_speed_error, 0.02f);
+    ASSERT_LT(max_filtered_speed_error, 0.005f);
+    ASSERT_NEAR(
+        1.0f, Io_WheelSpeedEstimator_GetQuality(wheel_speed_estimator), 1e-6f);
+}
+
+TEST_F(WheelSpeedEstimatorTest, measures_low_speed_without_quantisation)
+{
+    wheel.speed_mps = 3.0 / 3.6;
+    Run(10.0);
+    ASSERT_TRUE(
+        Io_WheelSpeedEstimator_HasLearnedToothSpacing(wheel_speed_estimator));
+
+    float max_speed_error, max_filtered_speed_error;
+    GetMaxSpeedErrors(1.0, max_speed_error, max_filtered_speed_error);
+    ASSERT_LT(max_speed_error, 0.01f);
+    ASSERT_LT(max_filtered_speed_error, 0.005f);
+}
+
+TEST_F(WheelSpeedEstimatorTest, bridges_missing_teeth)
+{
+    wheel.speed_mps = 80.0 / 3.6;
+    Run(1.0);
+
+    // The wheel speed sensor misses every tenth tooth
+    wheel.missing_tooth_interval = 10U;
+    float max_speed_error, max_filtered_speed_error;
+    GetMaxSpeedErrors(1.0, max_speed_error, max_filtered_speed_error);
+    ASSERT_LT(max_speed_error, 0.03f);
+    ASSERT_LT(max_filtered_speed_error, 0.01f);
+    ASSERT_NEAR(
+        0.9f, Io_WheelSpeedEstimator_GetQuality(wheel_speed_estimator), 0.03f);
+
+    wheel.missing_tooth_interval = 0U;
+    Run(0.5);
+    ASSERT_NEAR(
+        1.0f, Io_WheelSpeedEstimator_GetQuality(wheel_speed_estimator), 1e-6f);
+}
+
+TEST_F(WheelSpeedEstimatorTest, measures_acceleration)
+{
+    wheel.speed_mps         = 20.0 / 3.6;
+    wheel.acceleration_mps2 = 4.0;
+    Run(1.0);
+
+    for (int i = 0; i < 100; i++)
+    {
+        Update();
+        ASSERT_NEAR(
+            4.0f,
+            Io_WheelSpeedEstimator_GetAccelerationMps2(wheel_speed_estimator),
+            0.4f);
+        ASSERT_NEAR(
+            3.6f * wheel.speed_mps,
+            Io_WheelSpeedEstimator_GetSpeedKph(wheel_speed_estimator),
+            0.02f * 3.6f * wheel.speed_mps);
+
+        // The filtered wheel speed lags by about half the filter window
+        ASSERT_NEAR(
+            3.6f * (wheel.speed_mps - 4.0 * 0.05),
+            Io_WheelSpeedEstimator_GetFilteredSpeedKph(wheel_speed_estimator),
+            0.005f * 3.6f * wheel.speed_mps);
+    }
+}
+
+TEST_F(WheelSpeedEstimatorTest, follows_wheel_to_a_stop_and_back)
+{
+    wheel.speed_mps = 20.0 / 3.6;
+    Run(2.0);
+
+    wheel.acceleration_mps2 = -5.0;
+    while (wheel.speed_mps > 0.0)
+    {
+        Update();
+        if (wheel.speed_mps > 1.0 / 3.6)
+        {
+            ASSERT_NEAR(
+                3.6f * wheel.speed_mps,
+                Io_WheelSpeedEstimator_GetSpeedKph(wheel_speed_estimator),
+                0.5f);
+        }
+    }
+
+    // The wheel speed decreases steadily once the wheel has stopped, instead
+    // of holding the speed over the last tooth period
+    float prev_speed_kph =
+        Io_WheelSpeedEstimator_GetSpeedKph(wheel_speed_estimator);
+    for (int i = 0; i < 60; i++)
+    {
+        Update();
+        const float speed_kph =
+            Io_WheelSpeedEstimator_GetSpeedKph(wheel_speed_estimator);
+        ASSERT_LE(speed_kph, prev_speed_kph);
+        prev_speed_kph = speed_kph;
+    }
+    ASSERT_EQ(0.0f, Io_WheelSpeedEstimator_GetSpeedKph(wheel_speed_estimator));
+    ASSERT_EQ(
+        0.0f,
+        Io_WheelSpeedEstimator_GetFilteredSpeedKph(wheel_speed_estimator));
+    ASSERT_EQ(
+        0.0f,
+        Io_WheelSpeedEstimator_GetAccelerationMps2(wheel_speed_estimator));
+
+    // The learned tooth spacing still lines up with the teeth once the wheel
+    // starts turning again
+    wheel.acceleration_mps2 = 0.0;
+    wheel.speed_mps         = 30.0 / 3.6;
+    Run(0.1);
+    float max_speed_error, max_filtered_speed_error;
+    GetMaxSpeedErrors(0.5, max_speed_error, max_filtered_speed_error);
+    ASSERT_LT(max_speed_error, 0.02f);
+    ASSERT_LT(max_filtered_speed_error, 0.005f);
+}
+
+} // namespace WheelSpeedEstimatorTest
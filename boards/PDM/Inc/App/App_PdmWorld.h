@@ -6,6 +6,8 @@
 #include "App_SharedHeartbeatMonitor.h"
 #include "App_SharedRgbLedSequence.h"
 #include "App_LowVoltageBattery.h"
+#include "App_PowerSequencer.h"
+#include "App_ThermalFuses.h"
 #include "App_SharedClock.h"
 
 struct PdmWorld;
@@ -35,6 +37,8 @@ struct PdmWorld *App_PdmWorld_Create(
     struct HeartbeatMonitor * heartbeat_monitor,
     struct RgbLedSequence *   rgb_led_sequence,
     struct LowVoltageBattery *low_voltage_battery,
+    struct PowerSequencer *   power_sequencer,
+    struct ThermalFuses *     thermal_fuses,
     struct Clock *            clock);
 
 /**
@@ -158,6 +162,21 @@ struct RgbLedSequence *
 struct LowVoltageBattery *
     App_PdmWorld_GetLowVoltageBattery(const struct PdmWorld *world);
 
+/**
+ * Get the power sequencer for the given world
+ * @param world The world to get power sequencer for
+ * @return The power sequencer for the given world
+ */
+struct PowerSequencer *
+    App_PdmWorld_GetPowerSequencer(const struct PdmWorld *world);
+
+/**
+ * Get the thermal fuses for the given world
+ * @param world The world to get thermal fuses for
+ * @return The thermal fuses for the given world
+ */
+struct ThermalFuses *App_PdmWorld_GetThermalFuses(const struct PdmWorld *world);
+
 /**
  * Get the clock for the given world
  * @param world The world to get clock for
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// The step doesn't wait for another step to be ready
+#define POWER_SEQUENCE_NO_DEPENDENCY SIZE_MAX
+
+// A load powered up by the power sequence, and when it is considered ready
+struct PowerSequenceStep
+{
+    void (*enable)(void);
+    void (*disable)(void);
+
+    // Get the load's current in amps, or NAN if it can't be measured
+    float (*get_current)(void);
+
+    // The index of an earlier step that must be ready before this step is
+    // enabled, or POWER_SEQUENCE_NO_DEPENDENCY
+    size_t dependency;
+
+    // The largest current the load may draw while it powers up, in amps
+    float max_inrush_current;
+
+    // The load is ready once its current has stayed at or below the settled
+    // current for the settle time
+    float    settled_current;
+    uint32_t settle_time_ms;
+
+    // The load is disabled if it isn't ready this long after it was enabled
+    uint32_t timeout_ms;
+};
+
+enum PowerSequenceState
+{
+    POWER_SEQUENCE_IDLE,
+    POWER_SEQUENCE_IN_PROGRESS,
+    POWER_SEQUENCE_READY,
+    POWER_SEQUENCE_FAULT,
+};
+
+enum PowerSequenceStepState
+{
+    POWER_SEQUENCE_STEP_OFF,
+    POWER_SEQUENCE_STEP_SETTLING,
+    POWER_SEQUENCE_STEP_READY,
+    POWER_SEQUENCE_STEP_FAULT,
+
+    // The load was enabled, and is disabled until its thermal fuse cools down
+    POWER_SEQUENCE_STEP_TRIPPED,
+};
+
+struct PowerSequencer;
+
+/**
+ * Allocate and initialize a power sequencer, which enables the loads in the
+ * given steps as soon as their dependencies are ready and their inrush
+ * current fits in the current budget
+ * @note A step that is still settling reserves its maximum inrush current or
+ *       its measured current, whichever is larger, while a ready step only
+ *       reserves its measured current
+ * @param steps The steps of the power sequence, which are not copied and must
+ *              outlive the power sequencer
+ * @param num_steps The number of steps in the power sequence
+ * @param current_budget The largest total current the loads may draw while
+ *                       they power up, in amps
+ * @return The created power sequencer, whose ownership is given to the caller
+ */
+struct PowerSequencer *App_PowerSequencer_Create(
+    const struct PowerSequenceStep *steps,
+    size_t                          num_steps,
+    float                           current_budget);
+
+/**
+ * Deallocate the memory used by the given power sequencer
+ * @param power_sequencer The power sequencer to deallocate
+ */
+void App_PowerSequencer_Destroy(struct PowerSequencer *power_sequencer);
+
+/**
+ * Disable every load, and start the power sequence from its first step
+ * @param power_sequencer The power sequencer to start
+ * @param current_time_ms The current time, in milliseconds
+ */
+void App_PowerSequencer_Start(
+    struct PowerSequencer *power_sequencer,
+    uint32_t               current_time_ms);
+
+/**
+ * Measure the current of every enabled load, mark the loads that settled as
+ * ready, and enable the loads that can be powered up
+ * @param power_sequencer The power sequencer to tick
+ * @param current_time_ms The current time, in milliseconds
+ */
+void App_PowerSequencer_Tick(
+    struct PowerSequencer *power_sequencer,
+    uint32_t               current_time_ms);
+
+/**
+ * Set whether the thermal fuse of a step of the given power sequence is
+ * tripped. The power sequencer is the only owner of the loads' outputs, so a
+ * tripped load is disabled here and is never enabled by anything else.
+ * @note A load that trips while it is settling or once it is ready is powered
+ *       up again, within the current budget, once its fuse is no longer
+ *       tripped. A load whose fuse latches is faulted.
+ * @param power_sequencer The power sequencer the step belongs to
+ * @param step The index of the step
+ * @param is_tripped Whether the step's thermal fuse is tripped, and retries
+ *                   once it cools down
+ * @param is_latched Whether the step's thermal fuse is latched, as it has run
+ *                   out of retries
+ */
+void App_PowerSequencer_SetStepTripped(
+    struct PowerSequencer *power_sequencer,
+    size_t                 step,
+    bool                   is_tripped,
+    bool                   is_latched);
+
+/**
+ * Get the state of the given power sequence
+ * @param power_sequencer The power sequencer to get the state of
+ * @return POWER_SEQUENCE_READY once every load is ready, or
+ *         POWER_SEQUENCE_FAULT once every load is either ready or faulted.
+ *         The sequence is back in progress while a tripped load waits to be
+ *         powered up again.
+ */
+enum PowerSequenceState
+    App_PowerSequencer_GetState(const struct PowerSequencer *power_sequencer);
+
+/**
+ * Get the state of a step of the given power sequence
+ * @param power_sequencer The power sequencer to get the step state of
+ * @param step The index of the step
+ * @return The state of the step
+ */
+enum PowerSequenceStepState App_PowerSequencer_GetStepState(
+    const struct PowerSequencer *power_sequencer,
+    size_t                       step);
+
+/**
+ * Get the time the given power sequence took to bring every load up
+ * @param power_sequencer The power sequencer to get the time to ready of
+ * @return The time from the start of the sequence until every load was first
+ *         ready or faulted, or until the latest tick if the sequence hasn't
+ *         finished yet, in milliseconds
+ */
+uint32_t App_PowerSequencer_GetTimeToReadyMs(
+    const struct PowerSequencer *power_sequencer);
+
+/**
+ * Get the largest total current measured while the given power sequence ran
+ * @param power_sequencer The power sequencer to get the peak current of
+ * @return The largest total current of the enabled loads, in amps
+ */
+float App_PowerSequencer_GetPeakCurrent(
+    const struct PowerSequencer *power_sequencer);
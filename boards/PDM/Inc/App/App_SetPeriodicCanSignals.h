@@ -1,8 +1,15 @@
 #pragma once
 
 #include "App_PdmWorld.h"
+#include "App_SharedStateMachine.h"
 
 void App_SetPeriodicCanSignals_CurrentInRangeChecks(
     const struct PdmWorld *world);
 void App_SetPeriodicCanSignals_VoltageInRangeChecks(
     const struct PdmWorld *world);
+void App_SetPeriodicCanSignals_PowerSequencer(const struct PdmWorld *world);
+void App_SetPeriodicCanSignals_ThermalFuses(const struct PdmWorld *world);
+
+void App_SetPeriodicCanSignals_StateMachineTrace(
+    struct PdmCanTxInterface * can_tx,
+    const struct StateMachine *state_machine);
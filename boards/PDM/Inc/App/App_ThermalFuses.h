@@ -0,0 +1,115 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// An output channel protected by a thermal fuse, which models the heating of
+// the channel's wire and fuse from the square of its current. The thermal fuse
+// only reports whether the channel is tripped, and whoever owns the channel's
+// output disables it.
+struct ThermalFuseConfig
+{
+    // The current the channel may draw indefinitely without tripping, in amps
+    float rated_current;
+
+    // The I²t of the wire or fuse, in A²s. The thermal time constant is the I²t
+    // divided by the square of the rated current.
+    float i2t_rating;
+
+    // The thermal load at which the channel is reported as soft tripped, as a
+    // fraction of the thermal load it trips at
+    float soft_trip_load;
+
+    // Once tripped, the channel may be enabled again when its thermal load
+    // cools down to the retry load, as a fraction of the thermal load it trips
+    // at
+    float retry_load;
+
+    // The number of times a tripped channel may be enabled again before it
+    // stays latched off
+    uint32_t max_num_retries;
+};
+
+enum ThermalFuseState
+{
+    THERMAL_FUSE_OK,
+    THERMAL_FUSE_SOFT_TRIPPED,
+    THERMAL_FUSE_TRIPPED,
+    THERMAL_FUSE_LATCHED,
+};
+
+struct ThermalFuses;
+
+/**
+ * Allocate and initialize a set of thermal fuses, one for each channel
+ * @param configs The configs of every channel, which are not copied and must
+ *                outlive the thermal fuses
+ * @param num_channels The number of channels
+ * @param sample_period_s The time between the current samples of a channel, in
+ *                        seconds
+ * @return The created thermal fuses, whose ownership is given to the caller
+ */
+struct ThermalFuses *App_ThermalFuses_Create(
+    const struct ThermalFuseConfig *configs,
+    size_t                          num_channels,
+    float                           sample_period_s);
+
+/**
+ * Deallocate the memory used by the given thermal fuses
+ * @param thermal_fuses The thermal fuses to deallocate
+ */
+void App_ThermalFuses_Destroy(struct ThermalFuses *thermal_fuses);
+
+/**
+ * Integrate a block of current samples of every channel into their thermal
+ * loads, and record which channels tripped
+ * @note This is meant to be called from the ADC's interrupt, so it only
+ *       records the trips, and App_ThermalFuses_Tick reports them
+ * @param thermal_fuses The thermal fuses to integrate the samples into
+ * @param currents The currents of every channel for each sample, oldest sample
+ *                 first, in amps
+ * @param num_samples The number of samples of each channel
+ */
+void App_ThermalFuses_ProcessSamples(
+    struct ThermalFuses *thermal_fuses,
+    const float *        currents,
+    size_t               num_samples);
+
+/**
+ * Mark the channels that tripped as tripped, or as latched once they are out of
+ * retries, clear the trip of the tripped channels that cooled down, and update
+ * the state of every channel
+ * @param thermal_fuses The thermal fuses to tick
+ */
+void App_ThermalFuses_Tick(struct ThermalFuses *thermal_fuses);
+
+/**
+ * Get the thermal load of a channel of the given thermal fuses
+ * @param thermal_fuses The thermal fuses to get the thermal load of
+ * @param channel The index of the channel
+ * @return The thermal load of the channel, as a fraction of the thermal load
+ *         it trips at
+ */
+float App_ThermalFuses_GetThermalLoad(
+    const struct ThermalFuses *thermal_fuses,
+    size_t                     channel);
+
+/**
+ * Get the state of a channel of the given thermal fuses
+ * @param thermal_fuses The thermal fuses to get the state of
+ * @param channel The index of the channel
+ * @return The state of the channel as of the latest tick
+ */
+enum ThermalFuseState App_ThermalFuses_GetState(
+    const struct ThermalFuses *thermal_fuses,
+    size_t                     channel);
+
+/**
+ * Get the number of times a channel of the given thermal fuses tripped
+ * @param thermal_fuses The thermal fuses to get the number of trips of
+ * @param channel The index of the channel
+ * @return The number of times the channel tripped as of the latest tick
+ */
+uint32_t App_ThermalFuses_GetNumTrips(
+    const struct ThermalFuses *thermal_fuses,
+    size_t                     channel);
@@ -0,0 +1,10 @@
+#pragma once
+
+// The largest total current the loads may draw while they power up
+#define POWER_SEQUENCE_CURRENT_BUDGET 3.0f
+
+#define AUX1_MAX_INRUSH_CURRENT 2.0f
+#define AUX2_MAX_INRUSH_CURRENT 2.0f
+
+#define POWER_SEQUENCE_SETTLE_TIME_MS 20U
+#define POWER_SEQUENCE_TIMEOUT_MS 500U
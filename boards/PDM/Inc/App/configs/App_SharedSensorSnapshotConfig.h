@@ -0,0 +1,5 @@
+#pragma once
+
+struct PdmWorld;
+
+#define World PdmWorld
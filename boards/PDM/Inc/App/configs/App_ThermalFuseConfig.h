@@ -0,0 +1,22 @@
+#pragma once
+
+// The I²t of the Aux1 and Aux2 wiring, which sets how long the channels may
+// carry more than their rated current
+#define AUX1_I2T_RATING 2.0f
+#define AUX2_I2T_RATING 2.0f
+
+// The thermal loads the channels are reported as soft tripped at, and are
+// enabled again at after tripping, as fractions of the trip load
+#define THERMAL_FUSE_SOFT_TRIP_LOAD 0.8f
+#define THERMAL_FUSE_RETRY_LOAD 0.5f
+
+#define THERMAL_FUSE_MAX_NUM_RETRIES 3U
+
+// The index of each channel in the table of thermal fuse configs, which is
+// also the index of the channel's step in the power sequence
+enum ThermalFuseChannel
+{
+    THERMAL_FUSE_AUX1,
+    THERMAL_FUSE_AUX2,
+    NUM_THERMAL_FUSE_CHANNELS
+};
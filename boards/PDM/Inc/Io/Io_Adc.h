@@ -1,12 +1,15 @@
 #pragma once
 
-#include <stdint.h>
+#include <stm32f3xx_hal.h>
 
 /**
- * Get the buffer for DMA controller to write raw ADC values into
- * @return Pointer to the buffer
+ * Initialize ADC1, and start converting every voltage and current sense voltage
+ * by DMA
+ * @note The conversions are triggered by TIM2, which must be started after
+ *       this is called
+ * @param hadc1: The handle of ADC1
  */
-uint16_t *Io_Adc_GetRawAdcValues(void);
+void Io_Adc_Init(ADC_HandleTypeDef *hadc1);
 
 /**
  * Get the voltage measured at ADC channel 1
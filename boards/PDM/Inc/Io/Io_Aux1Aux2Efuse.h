@@ -36,7 +36,8 @@ void Io_Aux1Aux2Efuse_DisableAux2(void);
  * Get the value of the Aux1Aux2 efuse's status register for the Aux1Aux2 efuse.
  * @param channel_status Pointer to the Aux1 and Aux2 channel's status
  * @return EXIT_CODE_OK if the read was successful,
- *         else EXIT_CODE_TIMEOUT if the SPI read timed-out
+ *         else EXIT_CODE_TIMEOUT if the register wasn't read by the latest
+ *         transfer
  */
 ExitCode Io_Aux1Aux2Efuse_GetStatus(enum Efuse_Status *channel_status);
 
@@ -45,7 +46,8 @@ ExitCode Io_Aux1Aux2Efuse_GetStatus(enum Efuse_Status *channel_status);
  * @note Reading from the fault register reset's non-latchable faults
  * @param aux1_fault_status Pointer to the Aux 1 fault status
  * @return EXIT_CODE_OK if the read was successful,
- *         else EXIT_CODE_TIMEOUT if the SPI read timed-out
+ *         else EXIT_CODE_TIMEOUT if the register wasn't read by the latest
+ *         transfer
  */
 ExitCode Io_Aux1Aux2Efuse_GetAux1Faults(enum Efuse_Fault *aux1_fault_status);
 
@@ -54,7 +56,8 @@ ExitCode Io_Aux1Aux2Efuse_GetAux1Faults(enum Efuse_Fault *aux1_fault_status);
  * @note Reading from the fault register reset's non-latchable faults
  * @param aux2_fault_status Pointer to the Aux 2 fault status
  * @return EXIT_CODE_OK if the read was successful,
- *         else EXIT_CODE_TIMEOUT if the SPI read timed-out
+ *         else EXIT_CODE_TIMEOUT if the register wasn't read by the latest
+ *         transfer
  */
 ExitCode Io_Aux1Aux2Efuse_GetAux2Faults(enum Efuse_Fault *aux2_fault_status);
 
@@ -98,6 +101,7 @@ float Io_Aux1Aux2Efuse_GetAux2Current(void);
  *                  -RETRY_CONFIG
  *                  -CONFR_CONFIG
  *                  -OCR_LOW_CURRENT_SENSE_CONFIG
+ * @note This blocks until the registers of every efuse are transferred
  * @return EXIT_CODE_OK if the configuration was successful,
  *         else EXIT_CODE_TIMEOUT if one of the SPI writes timed-out
  */
@@ -1,5 +1,40 @@
 #pragma once
 
+#include <stddef.h>
+
+// The currents that are sampled at the frequency of the ADC's trigger, in the
+// order they are passed to the sampled currents callback
+enum SampledCurrent
+{
+    SAMPLED_CURRENT_AUX1,
+    SAMPLED_CURRENT_AUX2,
+    NUM_SAMPLED_CURRENTS
+};
+
+/**
+ * Set the function to call with every block of sampled currents
+ * @note The callback is called from the ADC's DMA interrupt, so it must be
+ *       short, and it must be set before the ADC's trigger is started
+ * @param callback: The function to call with the sampled currents of every
+ *                  enum SampledCurrent for each sample, oldest first, in amps,
+ *                  and the number of samples
+ */
+void Io_CurrentSense_SetSampledCurrentsCallback(
+    void (*callback)(const float *currents, size_t num_samples));
+
+/**
+ * Convert a block of current sense voltages into currents in place, and pass
+ * them to the sampled currents callback
+ * @note This is called by Io_Adc from the ADC's DMA interrupt
+ * @param current_sense_voltages: The current sense voltages of every enum
+ *                                SampledCurrent for each sample, oldest
+ *                                first, in volts
+ * @param num_samples: The number of samples
+ */
+void Io_CurrentSense_SampleCurrents(
+    float *current_sense_voltages,
+    size_t num_samples);
+
 /**
  * Get the auxiliary 1 current, in amps
  * @return The auxiliary 1 current, in amps
@@ -3,7 +3,14 @@
  * @Settings Efuse max SPI transfer rate: 8MHz
  *           SPI Clock Polarity: 0 (SCK low-level idle state)
  *           SPI Clock Phase: 2nd edge (slave samples MOSI on SCK falling edge)
+ *           SPI Data Size: 16 bits
  *           Slave Select: Active Low (must be toggled between SPI messages)
+ *
+ * Registers are not accessed over SPI when they are written or read. Writes
+ * go into a shadow of each register, and reads return the value read by the
+ * latest transfer. Io_Efuse_StartTransfer() then sends every changed register
+ * and reads every register that was ever read, for all efuses on the SPI bus
+ * at once, by DMA.
  */
 #pragma once
 
@@ -11,6 +18,7 @@
 #include <stdbool.h>
 #include "main.h"
 #include "App_SharedExitCode.h"
+#include "Io_EfuseManager.h"
 
 struct Efuse_Context;
 
@@ -20,7 +28,8 @@ struct Efuse_Context;
  * measured current for channel 0
  * @param get_channel_1_current A function that can be called to get the
  * measured current for channel 1
- * @param hspi Handle to the SPI peripheral used for the efuse
+ * @param hspi Handle to the SPI peripheral used for the efuse, which must be
+ * the same for every efuse and have its TX and RX DMA channels linked
  * @param chip_select_port Handle to efuse's chip-select GPIO port
  * @param chip_select_port Handle to efuse's chip-select GPIO pin
  * @param fsob_port Handle to efuse's fail-safe output GPIO port
@@ -92,8 +101,8 @@ void Io_Efuse_DisableChannel1(const struct Efuse_Context *const efuse);
  *                  CSNS_FUNCTION_CURRENT_SUM - Current sensing for summed
  * channels (for Parallel mode)
  * @param efuse Pointer to the efuse structure for the efuse being configured
- * @return EXIT_CODE_OK if the channel configuration was successful
- *         EXIT_CODE_TIMEOUT if one of the SPI writes timed-out
+ * @note The configuration is sent to the efuse by the next transfer
+ * @return EXIT_CODE_OK
  */
 ExitCode Io_Efuse_ConfigureChannelMonitoring(
     uint8_t                     monitoring_function,
@@ -101,6 +110,7 @@ ExitCode Io_Efuse_ConfigureChannelMonitoring(
 
 /**
  * Exit fail-safe mode and disable the watchdog timer for the given efuse.
+ * @note This blocks until the registers of every efuse are transferred
  * @param efuse Pointer to the efuse structure for the efuse being configured
  * @return EXIT_CODE_OK if the efuse exited fail-safe mode
  *         EXIT_CODE_TIMEOUT if the one of the SPI writes timed-out
@@ -134,24 +144,27 @@ void Io_Efuse_DelatchFaults(const struct Efuse_Context *const efuse);
 /**
  * Get the channel 0 current reading in Amps [A] for the given efuse.
  * @param efuse Pointer to the given efuse
- * @return The channel 0 current if the current was measured, else NAN
+ * @return The channel 0 current if the current was measured, else NAN, which
+ * includes until the next transfer selects channel 0's current sense
  */
 float Io_Efuse_GetChannel0Current(struct Efuse_Context *const efuse);
 
 /**
  * Get the channel 1 current reading in Amps [A] for the given efuse.
  * @param efuse Pointer to the given efuse
- * @return The channel 1 current if the current was measured, else NAN
+ * @return The channel 1 current if the current was measured, else NAN, which
+ * includes until the next transfer selects channel 1's current sense
  */
 float Io_Efuse_GetChannel1Current(struct Efuse_Context *const efuse);
 
 /**
  * Write data to a specific serial input register on the given efuse.
+ * @note The register is sent to the efuse by the next transfer, and only if
+ * its value changed
  * @param register_address Serial input register being written to
  * @param register_value The value being written to the serial input register
  * @param efuse Pointer to efuse structure being written to
- * @return EXIT_CODE_OK if the write was successful
- *         EXIT_CODE_TIMEOUT if the SPI write timed-out
+ * @return EXIT_CODE_OK
  */
 ExitCode Io_Efuse_WriteRegister(
     uint8_t                     register_address,
@@ -160,13 +173,32 @@ ExitCode Io_Efuse_WriteRegister(
 
 /**
  * Read data from a specific serial output register for the given efuse.
+ * @note The register is read by every transfer from now on
  * @param register_address Serial output register being read from
  * @param register_value The value read back from the serial output register
+ * by the latest transfer
  * @param efuse Pointer to efuse structure being read from
  * @return EXIT_CODE_OK if the read was successful
- *         EXIT_CODE_TIMEOUT if the SPI read timed-out
+ *         EXIT_CODE_TIMEOUT if the register hasn't been read yet, or the
+ *         latest transfer failed
  */
 ExitCode Io_Efuse_ReadRegister(
     uint8_t                     register_address,
     uint16_t *                  register_value,
     struct Efuse_Context *const efuse);
+
+/**
+ * Start transferring the registers of every efuse by DMA, which writes every
+ * register that changed and reads every register that was ever read.
+ * @note This must be called periodically from a task, and does nothing while
+ * the previous transfer is still in progress
+ */
+void Io_Efuse_StartTransfer(void);
+
+/**
+ * Transfer the registers of every efuse, blocking until they are transferred.
+ * @return EXIT_CODE_OK if the transfer was successful
+ *         EXIT_CODE_TIMEOUT if an SPI transfer timed-out, or a transfer
+ *         started by Io_Efuse_StartTransfer() is still in progress
+ */
+ExitCode Io_Efuse_TransferRegisters(void);
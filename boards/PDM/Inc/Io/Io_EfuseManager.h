@@ -0,0 +1,169 @@
+#pragma once
+
+/**
+ * Register cache and SPI transaction list for the 22XS4200 efuses sharing one
+ * SPI bus
+ *
+ * Every serial input register written to an efuse is kept in a shadow, and
+ * is only sent to the efuse while it differs from what the efuse was last
+ * sent. The serial output registers that are polled are read into a cache
+ * once per transaction, which covers every efuse on the bus.
+ *
+ * The efuse clocks out the serial output register selected by the previous
+ * STATR_s frame during the next frame, so reads are pipelined: polling N
+ * registers takes N frames rather than 2N. Every transaction ends by
+ * selecting STATR, so the status of each efuse is clocked out for free by
+ * the first frame of the next transaction.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "App_SharedExitCode.h"
+
+// Both the serial input and serial output registers have 4-bit addresses
+#define EFUSE_NUM_REGISTERS 16U
+
+// At most every register is written and every register is read, plus the
+// frame that clocks out the last register read
+#define EFUSE_MAX_NUM_FRAMES_PER_EFUSE (2U * EFUSE_NUM_REGISTERS + 1U)
+
+// The frame's response isn't a known serial output register
+#define EFUSE_NO_REGISTER 0xFFU
+
+// A 16-bit SPI frame exchanged with one efuse
+struct EfuseFrame
+{
+    // The index of the efuse whose chip select is asserted for the frame
+    size_t efuse;
+
+    // The frame sent to the efuse, and set to the frame received from it
+    uint16_t tx_data;
+    uint16_t rx_data;
+
+    // The serial output register clocked out during the frame, or
+    // EFUSE_NO_REGISTER if it isn't known
+    uint8_t response_address;
+};
+
+struct EfuseManager;
+
+/**
+ * Allocate and initialize the register cache of the efuses on an SPI bus
+ * @param num_efuses: The number of efuses on the SPI bus
+ * @return Pointer to the allocated and initialized register cache
+ */
+struct EfuseManager *Io_EfuseManager_Create(size_t num_efuses);
+
+/**
+ * Deallocate the memory used by the given register cache
+ * @param manager: The register cache to deallocate
+ */
+void Io_EfuseManager_Destroy(struct EfuseManager *manager);
+
+/**
+ * Write a serial input register of an efuse into its shadow. The register is
+ * sent to the efuse by the next transaction, unless it is unchanged.
+ * @note This must not be called while a transaction is ended
+ * @param manager: The register cache of the efuses
+ * @param efuse: The index of the efuse to write
+ * @param register_address: The serial input register to write, which must
+ *                          not be STATR_s
+ * @param register_value: The value to write into the register
+ */
+void Io_EfuseManager_WriteRegister(
+    struct EfuseManager *manager,
+    size_t               efuse,
+    uint8_t              register_address,
+    uint16_t             register_value);
+
+/**
+ * Get the value written into the shadow of a serial input register
+ * @param manager: The register cache of the efuses
+ * @param efuse: The index of the efuse
+ * @param register_address: The serial input register
+ * @return The value last written into the register, or 0 if it was never
+ *         written
+ */
+uint16_t Io_EfuseManager_GetWrittenRegister(
+    const struct EfuseManager *manager,
+    size_t                     efuse,
+    uint8_t                    register_address);
+
+/**
+ * Check if a serial input register is yet to be sent to the efuse
+ * @param manager: The register cache of the efuses
+ * @param efuse: The index of the efuse
+ * @param register_address: The serial input register
+ * @return true if the register's shadow hasn't been sent to the efuse by a
+ *         successful transaction, else false
+ */
+bool Io_EfuseManager_IsRegisterPending(
+    const struct EfuseManager *manager,
+    size_t                     efuse,
+    uint8_t                    register_address);
+
+/**
+ * Read a serial output register of an efuse in every transaction from now on
+ * @param manager: The register cache of the efuses
+ * @param efuse: The index of the efuse to read
+ * @param register_address: The serial output register to read
+ */
+void Io_EfuseManager_PollRegister(
+    struct EfuseManager *manager,
+    size_t               efuse,
+    uint8_t              register_address);
+
+/**
+ * Get the value of a serial output register read by the latest transaction
+ * @param manager: The register cache of the efuses
+ * @param efuse: The index of the efuse
+ * @param register_address: The serial output register
+ * @param register_value: Set to the register's value, without the
+ *                        normal-mode status bit
+ * @return EXIT_CODE_TIMEOUT if the register hasn't been read since it was
+ *         polled or since a transaction last failed, else EXIT_CODE_OK
+ */
+ExitCode Io_EfuseManager_ReadRegister(
+    const struct EfuseManager *manager,
+    size_t                     efuse,
+    uint8_t                    register_address,
+    uint16_t *                 register_value);
+
+/**
+ * Set the watchdog-in bit of the next frame sent to an efuse, after which it
+ * keeps alternating on every frame
+ * @param manager: The register cache of the efuses
+ * @param efuse: The index of the efuse
+ */
+void Io_EfuseManager_ResetWatchdogBit(
+    struct EfuseManager *manager,
+    size_t               efuse);
+
+/**
+ * Build the frames of a transaction, which sends every pending serial input
+ * register and reads every polled serial output register of every efuse
+ * @note The frames of each efuse must be exchanged in order, each with its
+ *       own chip select pulse
+ * @param manager: The register cache of the efuses
+ * @return The number of frames in the transaction, which may be 0
+ */
+size_t Io_EfuseManager_BeginTransaction(struct EfuseManager *manager);
+
+/**
+ * Get the frames of the transaction that was begun
+ * @param manager: The register cache of the efuses
+ * @return The frames to exchange with the efuses, in order
+ */
+struct EfuseFrame *Io_EfuseManager_GetFrames(struct EfuseManager *manager);
+
+/**
+ * End the transaction that was begun, and cache the registers it read
+ * @param manager: The register cache of the efuses
+ * @param is_successful: Whether every frame was exchanged. If not, the
+ *                       registers it wrote are sent again by the next
+ *                       transaction, and no register it read is cached.
+ */
+void Io_EfuseManager_EndTransaction(
+    struct EfuseManager *manager,
+    bool                 is_successful);
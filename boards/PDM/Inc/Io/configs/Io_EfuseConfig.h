@@ -8,7 +8,7 @@
 #define EFUSE_ADDR_MASK 0xFU
 #define EFUSE_ADDR_SHIFT 0x0AU
 #define EFUSE_SI_DATA_MASK 0x1FFU
-#define EFUSE_SO_DATA_MASK 0xFF // Ignore Normal-Mode status bit (bit 9)
+#define EFUSE_SO_DATA_MASK 0x1FFU // Ignore Normal-Mode status bit (bit 9)
 
 #define WATCHDOG_BIT (1U << 15U)
 #define PARITY_BIT (1U << 14U)
@@ -21,6 +21,8 @@ struct PdmWorld
     struct HeartbeatMonitor * heartbeat_monitor;
     struct RgbLedSequence *   rgb_led_sequence;
     struct LowVoltageBattery *low_voltage_battery;
+    struct PowerSequencer *   power_sequencer;
+    struct ThermalFuses *     thermal_fuses;
     struct Clock *            clock;
 };
 
@@ -40,6 +42,8 @@ struct PdmWorld *App_PdmWorld_Create(
     struct HeartbeatMonitor *const  heartbeat_monitor,
     struct RgbLedSequence *const    rgb_led_sequence,
     struct LowVoltageBattery *const low_voltage_battery,
+    struct PowerSequencer *const    power_sequencer,
+    struct ThermalFuses *const      thermal_fuses,
     struct Clock *const             clock)
 {
     struct PdmWorld *world = (struct PdmWorld *)malloc(sizeof(struct PdmWorld));
@@ -64,6 +68,8 @@ struct PdmWorld *App_PdmWorld_Create(
     world->heartbeat_monitor   = heartbeat_monitor;
     world->rgb_led_sequence    = rgb_led_sequence;
     world->low_voltage_battery = low_voltage_battery;
+    world->power_sequencer     = power_sequencer;
+    world->thermal_fuses       = thermal_fuses;
     world->clock               = clock;
 
     return world;
@@ -164,6 +170,18 @@ struct LowVoltageBattery *
     return world->low_voltage_battery;
 }
 
+struct PowerSequencer *
+    App_PdmWorld_GetPowerSequencer(const struct PdmWorld *const world)
+{
+    return world->power_sequencer;
+}
+
+struct ThermalFuses *
+    App_PdmWorld_GetThermalFuses(const struct PdmWorld *const world)
+{
+    return world->thermal_fuses;
+}
+
 struct Clock *App_PdmWorld_GetClock(const struct PdmWorld *const world)
 {
     return world->clock;
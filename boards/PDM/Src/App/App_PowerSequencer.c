@@ -0,0 +1,376 @@
+#include <stdlib.h>
+#include <assert.h>
+#include <math.h>
+#include "App_PowerSequencer.h"
+
+struct PowerSequenceStepStatus
+{
+    enum PowerSequenceStepState state;
+    uint32_t                    enable_time_ms;
+
+    // Whether the load's thermal fuse is tripped, which keeps it disabled
+    bool is_tripped;
+
+    // When the load's current last rose above its settled current
+    uint32_t unsettled_time_ms;
+};
+
+struct PowerSequencer
+{
+    const struct PowerSequenceStep *steps;
+    struct PowerSequenceStepStatus *statuses;
+    size_t                          num_steps;
+    float                           current_budget;
+
+    enum PowerSequenceState state;
+    bool                    has_finished;
+    uint32_t                start_time_ms;
+    uint32_t                time_to_ready_ms;
+    float                   peak_current;
+};
+
+/**
+ * Mark a settling load as ready once it has settled, or as faulted once it has
+ * timed out
+ * @param power_sequencer The power sequencer the step belongs to
+ * @param step The index of the settling step
+ * @param current The load's measured current, in amps
+ * @param current_time_ms The current time, in milliseconds
+ * @return The current reserved by the load, in amps
+ */
+static float App_SettleStep(
+    struct PowerSequencer *power_sequencer,
+    size_t                 step,
+    float                  current,
+    uint32_t               current_time_ms);
+
+/**
+ * Enable a load if its dependency is ready and its inrush current fits in the
+ * current left in the budget, or mark it as faulted if it never can be
+ * @param power_sequencer The power sequencer the step belongs to
+ * @param step The index of the step that is off
+ * @param current_time_ms The current time, in milliseconds
+ * @param committed_current The current reserved by the enabled loads, in amps
+ * @param is_any_step_settling Whether any load is settling, which may free up
+ *                             some of the budget
+ * @return The current reserved by the load, in amps
+ */
+static float App_TryEnableStep(
+    struct PowerSequencer *power_sequencer,
+    size_t                 step,
+    uint32_t               current_time_ms,
+    float                  committed_current,
+    bool                   is_any_step_settling);
+
+static float App_SettleStep(
+    struct PowerSequencer *const power_sequencer,
+    const size_t                 step,
+    const float                  current,
+    const uint32_t               current_time_ms)
+{
+    const struct PowerSequenceStep *const config =
+        &power_sequencer->steps[step];
+    struct PowerSequenceStepStatus *const status =
+        &power_sequencer->statuses[step];
+
+    if (isnan(current) || current > config->settled_current)
+    {
+        status->unsettled_time_ms = current_time_ms;
+    }
+    else if (
+        current_time_ms - status->unsettled_time_ms >= config->settle_time_ms)
+    {
+        status->state = POWER_SEQUENCE_STEP_READY;
+        return current;
+    }
+
+    if (current_time_ms - status->enable_time_ms >= config->timeout_ms)
+    {
+        config->disable();
+        status->state = POWER_SEQUENCE_STEP_FAULT;
+        return 0.0f;
+    }
+
+    // Until it settles the load may still draw up to its inrush current
+    return isnan(current) ? config->max_inrush_current
+                          : fmaxf(current, config->max_inrush_current);
+}
+
+static float App_TryEnableStep(
+    struct PowerSequencer *const power_sequencer,
+    const size_t                 step,
+    const uint32_t               current_time_ms,
+    const float                  committed_current,
+    const bool                   is_any_step_settling)
+{
+    const struct PowerSequenceStep *const config =
+        &power_sequencer->steps[step];
+    struct PowerSequenceStepStatus *const status =
+        &power_sequencer->statuses[step];
+
+    // A load isn't enabled until its thermal fuse has cooled down
+    if (status->is_tripped)
+    {
+        return 0.0f;
+    }
+
+    if (config->dependency != POWER_SEQUENCE_NO_DEPENDENCY)
+    {
+        const enum PowerSequenceStepState dependency_state =
+            power_sequencer->statuses[config->dependency].state;
+
+        if (dependency_state == POWER_SEQUENCE_STEP_FAULT)
+        {
+            status->state = POWER_SEQUENCE_STEP_FAULT;
+            return 0.0f;
+        }
+        if (dependency_state != POWER_SEQUENCE_STEP_READY)
+        {
+            return 0.0f;
+        }
+    }
+
+    if (committed_current + config->max_inrush_current >
+        power_sequencer->current_budget)
+    {
+        // The ready loads alone leave too little of the budget for the inrush
+        if (!is_any_step_settling)
+        {
+            status->state = POWER_SEQUENCE_STEP_FAULT;
+        }
+        return 0.0f;
+    }
+
+    config->enable();
+    status->state             = POWER_SEQUENCE_STEP_SETTLING;
+    status->enable_time_ms    = current_time_ms;
+    status->unsettled_time_ms = current_time_ms;
+
+    return config->max_inrush_current;
+}
+
+struct PowerSequencer *App_PowerSequencer_Create(
+    const struct PowerSequenceStep *const steps,
+    const size_t                          num_steps,
+    const float                           current_budget)
+{
+    assert(steps != NULL);
+    assert(num_steps > 0U);
+
+    for (size_t i = 0U; i < num_steps; i++)
+    {
+        // Each step may only depend on an earlier step, so the dependencies
+        // can't form a cycle
+        assert(
+            steps[i].dependency == POWER_SEQUENCE_NO_DEPENDENCY ||
+            steps[i].dependency < i);
+        assert(steps[i].max_inrush_current <= current_budget);
+    }
+
+    struct PowerSequencer *const power_sequencer =
+        malloc(sizeof(struct PowerSequencer));
+    assert(power_sequencer != NULL);
+
+    power_sequencer->statuses =
+        calloc(num_steps, sizeof(struct PowerSequenceStepStatus));
+    assert(power_sequencer->statuses != NULL);
+
+    power_sequencer->steps            = steps;
+    power_sequencer->num_steps        = num_steps;
+    power_sequencer->current_budget   = current_budget;
+    power_sequencer->state            = POWER_SEQUENCE_IDLE;
+    power_sequencer->has_finished     = false;
+    power_sequencer->start_time_ms    = 0U;
+    power_sequencer->time_to_ready_ms = 0U;
+    power_sequencer->peak_current     = 0.0f;
+
+    return power_sequencer;
+}
+
+void App_PowerSequencer_Destroy(struct PowerSequencer *const power_sequencer)
+{
+    free(power_sequencer->statuses);
+    free(power_sequencer);
+}
+
+void App_PowerSequencer_Start(
+    struct PowerSequencer *const power_sequencer,
+    const uint32_t               current_time_ms)
+{
+    for (size_t i = 0U; i < power_sequencer->num_steps; i++)
+    {
+        power_sequencer->steps[i].disable();
+        power_sequencer->statuses[i].state = POWER_SEQUENCE_STEP_OFF;
+    }
+
+    power_sequencer->state            = POWER_SEQUENCE_IN_PROGRESS;
+    power_sequencer->has_finished     = false;
+    power_sequencer->start_time_ms    = current_time_ms;
+    power_sequencer->time_to_ready_ms = 0U;
+    power_sequencer->peak_current     = 0.0f;
+}
+
+void App_PowerSequencer_Tick(
+    struct PowerSequencer *const power_sequencer,
+    const uint32_t               current_time_ms)
+{
+    // The loads stay under the power sequencer once the sequence finishes, so
+    // a load whose thermal fuse cools down is powered up again like any other
+    if (power_sequencer->state == POWER_SEQUENCE_IDLE)
+    {
+        return;
+    }
+
+    float measured_current     = 0.0f;
+    float committed_current    = 0.0f;
+    bool  is_any_step_settling = false;
+
+    for (size_t i = 0U; i < power_sequencer->num_steps; i++)
+    {
+        const struct PowerSequenceStep *const config =
+            &power_sequencer->steps[i];
+        struct PowerSequenceStepStatus *const status =
+            &power_sequencer->statuses[i];
+
+        if (status->state != POWER_SEQUENCE_STEP_SETTLING &&
+            status->state != POWER_SEQUENCE_STEP_READY)
+        {
+            continue;
+        }
+
+        const float current = config->get_current();
+        measured_current += isnan(current) ? 0.0f : current;
+
+        if (status->state == POWER_SEQUENCE_STEP_SETTLING)
+        {
+            committed_current +=
+                App_SettleStep(power_sequencer, i, current, current_time_ms);
+            is_any_step_settling |=
+                status->state == POWER_SEQUENCE_STEP_SETTLING;
+        }
+        else
+        {
+            // A load that can't be measured is assumed to draw its inrush
+            committed_current +=
+                isnan(current) ? config->max_inrush_current : current;
+        }
+    }
+
+    power_sequencer->peak_current =
+        fmaxf(power_sequencer->peak_current, measured_current);
+
+    // Enable every load that fits in the budget in the same tick, in the order
+    // of the table
+    bool is_any_step_off = false;
+    bool is_any_fault    = false;
+
+    for (size_t i = 0U; i < power_sequencer->num_steps; i++)
+    {
+        struct PowerSequenceStepStatus *const status =
+            &power_sequencer->statuses[i];
+
+        if (status->state == POWER_SEQUENCE_STEP_OFF)
+        {
+            committed_current += App_TryEnableStep(
+                power_sequencer, i, current_time_ms, committed_current,
+                is_any_step_settling);
+        }
+
+        is_any_step_settling |= status->state == POWER_SEQUENCE_STEP_SETTLING;
+        is_any_step_off |= status->state == POWER_SEQUENCE_STEP_OFF ||
+                           status->state == POWER_SEQUENCE_STEP_TRIPPED;
+        is_any_fault |= status->state == POWER_SEQUENCE_STEP_FAULT;
+    }
+
+    if (is_any_step_settling || is_any_step_off)
+    {
+        power_sequencer->state = POWER_SEQUENCE_IN_PROGRESS;
+    }
+    else
+    {
+        power_sequencer->state =
+            is_any_fault ? POWER_SEQUENCE_FAULT : POWER_SEQUENCE_READY;
+    }
+
+    // Only the first time the loads come up is reported, not their recovery
+    // from a thermal fuse trip
+    if (!power_sequencer->has_finished)
+    {
+        power_sequencer->time_to_ready_ms =
+            current_time_ms - power_sequencer->start_time_ms;
+        power_sequencer->has_finished =
+            power_sequencer->state != POWER_SEQUENCE_IN_PROGRESS;
+    }
+}
+
+void App_PowerSequencer_SetStepTripped(
+    struct PowerSequencer *const power_sequencer,
+    const size_t                 step,
+    const bool                   is_tripped,
+    const bool                   is_latched)
+{
+    assert(step < power_sequencer->num_steps);
+
+    struct PowerSequenceStepStatus *const status =
+        &power_sequencer->statuses[step];
+
+    const bool was_tripped = status->is_tripped;
+    status->is_tripped     = is_tripped || is_latched;
+
+    // The load is disabled whatever its state, as it may have been enabled
+    // before the power sequence started
+    if (status->is_tripped && !was_tripped)
+    {
+        power_sequencer->steps[step].disable();
+    }
+
+    if (is_latched)
+    {
+        // The thermal fuse has run out of retries, so the load is never
+        // powered up again
+        status->state = POWER_SEQUENCE_STEP_FAULT;
+    }
+    else if (is_tripped)
+    {
+        // A load that trips its fuse while it powers up is retried like one
+        // that trips once it is ready, until its fuse runs out of retries
+        if (status->state == POWER_SEQUENCE_STEP_SETTLING ||
+            status->state == POWER_SEQUENCE_STEP_READY)
+        {
+            status->state = POWER_SEQUENCE_STEP_TRIPPED;
+        }
+    }
+    else if (status->state == POWER_SEQUENCE_STEP_TRIPPED)
+    {
+        // The load is powered up again within the current budget, and has to
+        // settle again before it is ready
+        status->state = POWER_SEQUENCE_STEP_OFF;
+    }
+}
+
+enum PowerSequenceState App_PowerSequencer_GetState(
+    const struct PowerSequencer *const power_sequencer)
+{
+    return power_sequencer->state;
+}
+
+enum PowerSequenceStepState App_PowerSequencer_GetStepState(
+    const struct PowerSequencer *const power_sequencer,
+    const size_t                       step)
+{
+    assert(step < power_sequencer->num_steps);
+
+    return power_sequencer->statuses[step].state;
+}
+
+uint32_t App_PowerSequencer_GetTimeToReadyMs(
+    const struct PowerSequencer *const power_sequencer)
+{
+    return power_sequencer->time_to_ready_ms;
+}
+
+float App_PowerSequencer_GetPeakCurrent(
+    const struct PowerSequencer *const power_sequencer)
+{
+    return power_sequencer->peak_current;
+}
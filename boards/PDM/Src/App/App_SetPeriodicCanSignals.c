@@ -1,117 +1,227 @@
+#include <stdint.h>
+#include "App_SharedMacros.h"
 #include "App_SharedSetPeriodicCanSignals.h"
 #include "App_SetPeriodicCanSignals.h"
+#include "configs/App_ThermalFuseConfig.h"
+#include "states/App_AirClosedState.h"
+#include "states/App_AirOpenState.h"
+#include "states/App_InitState.h"
 
-STATIC_DEFINE_APP_SET_PERIODIC_CAN_SIGNALS_IN_RANGE_CHECK(PdmCanTxInterface)
+STATIC_DEFINE_APP_SET_PERIODIC_CAN_SIGNALS_IN_RANGE_CHECKS(PdmCanTxInterface)
+STATIC_DEFINE_APP_SET_PERIODIC_CAN_SIGNALS_STATE_MACHINE_TRACE(
+    PdmCanTxInterface)
+
+/**
+ * Get the CAN choice used to identify the given state in the state machine
+ * trace, which is the same choice used by the PDM_STATE_MACHINE message
+ * @param state The state to get the CAN choice for
+ * @return The CAN choice for the given state
+ */
+static uint8_t App_GetStateChoice(const struct State *const state)
+{
+    if (state == App_GetInitState())
+    {
+        return CANMSGS_PDM_STATE_MACHINE_STATE_INIT_CHOICE;
+    }
+    else if (state == App_GetAirOpenState())
+    {
+        return CANMSGS_PDM_STATE_MACHINE_STATE_AIR_OPEN_CHOICE;
+    }
+    else
+    {
+        return CANMSGS_PDM_STATE_MACHINE_STATE_AIR_CLOSED_CHOICE;
+    }
+}
+
+/**
+ * Get the CAN choice for the given power sequence state
+ * @param state The power sequence state to get the CAN choice for
+ * @return The CAN choice for the given power sequence state
+ */
+static uint8_t App_GetPowerSequenceStateChoice(enum PowerSequenceState state);
+
+static uint8_t
+    App_GetPowerSequenceStateChoice(const enum PowerSequenceState state)
+{
+    switch (state)
+    {
+        case POWER_SEQUENCE_IDLE:
+            return CANMSGS_PDM_POWER_SEQUENCE_POWER_SEQUENCE_STATE_IDLE_CHOICE;
+        case POWER_SEQUENCE_IN_PROGRESS:
+            return CANMSGS_PDM_POWER_SEQUENCE_POWER_SEQUENCE_STATE_IN_PROGRESS_CHOICE;
+        case POWER_SEQUENCE_READY:
+            return CANMSGS_PDM_POWER_SEQUENCE_POWER_SEQUENCE_STATE_READY_CHOICE;
+        case POWER_SEQUENCE_FAULT:
+        default:
+            return CANMSGS_PDM_POWER_SEQUENCE_POWER_SEQUENCE_STATE_FAULT_CHOICE;
+    }
+}
+
+/**
+ * Get the CAN choice for the given thermal fuse state, which is the same for
+ * the Aux1 and Aux2 thermal fuse state signals
+ * @param state The thermal fuse state to get the CAN choice for
+ * @return The CAN choice for the given thermal fuse state
+ */
+static uint8_t App_GetThermalFuseStateChoice(enum ThermalFuseState state);
+
+/**
+ * Get the CAN signal value for the given thermal load
+ * @param thermal_load The thermal load, as a fraction of the trip load
+ * @return The thermal load as a percentage, saturated to the signal's range
+ */
+static uint8_t App_GetThermalLoadPercentage(float thermal_load);
+
+static uint8_t App_GetThermalFuseStateChoice(const enum ThermalFuseState state)
+{
+    switch (state)
+    {
+        case THERMAL_FUSE_OK:
+            return CANMSGS_PDM_THERMAL_FUSES_AUX1_THERMAL_FUSE_STATE_OK_CHOICE;
+        case THERMAL_FUSE_SOFT_TRIPPED:
+            return CANMSGS_PDM_THERMAL_FUSES_AUX1_THERMAL_FUSE_STATE_SOFT_TRIPPED_CHOICE;
+        case THERMAL_FUSE_TRIPPED:
+            return CANMSGS_PDM_THERMAL_FUSES_AUX1_THERMAL_FUSE_STATE_TRIPPED_CHOICE;
+        case THERMAL_FUSE_LATCHED:
+        default:
+            return CANMSGS_PDM_THERMAL_FUSES_AUX1_THERMAL_FUSE_STATE_LATCHED_CHOICE;
+    }
+}
+
+static uint8_t App_GetThermalLoadPercentage(const float thermal_load)
+{
+    const float percentage = thermal_load * 100.0f;
+
+    if (percentage >= (float)UINT8_MAX)
+    {
+        return UINT8_MAX;
+    }
+
+    return percentage > 0.0f ? (uint8_t)percentage : 0U;
+}
+
+static const struct InRangeCheckCanSignals current_can_signals[] = {
+    IN_RANGE_CHECK_CAN_SIGNALS(
+        PDM_NON_CRITICAL_ERRORS,
+        AUXILIARY1_CURRENT,
+        AUX1_CURRENT_OUT_OF_RANGE),
+    IN_RANGE_CHECK_CAN_SIGNALS(
+        PDM_NON_CRITICAL_ERRORS,
+        AUXILIARY2_CURRENT,
+        AUX2_CURRENT_OUT_OF_RANGE),
+    IN_RANGE_CHECK_CAN_SIGNALS(
+        PDM_NON_CRITICAL_ERRORS,
+        LEFT_INVERTER_CURRENT,
+        LEFT_INVERTER_CURRENT_OUT_OF_RANGE),
+    IN_RANGE_CHECK_CAN_SIGNALS(
+        PDM_NON_CRITICAL_ERRORS,
+        RIGHT_INVERTER_CURRENT,
+        RIGHT_INVERTER_CURRENT_OUT_OF_RANGE),
+    IN_RANGE_CHECK_CAN_SIGNALS(
+        PDM_NON_CRITICAL_ERRORS,
+        ENERGY_METER_CURRENT,
+        ENERGY_METER_CURRENT_OUT_OF_RANGE),
+    IN_RANGE_CHECK_CAN_SIGNALS(
+        PDM_NON_CRITICAL_ERRORS,
+        CAN_CURRENT,
+        CAN_CURRENT_OUT_OF_RANGE),
+    IN_RANGE_CHECK_CAN_SIGNALS(
+        PDM_NON_CRITICAL_ERRORS,
+        AIR_SHUTDOWN_CURRENT,
+        AIR_SHUTDOWN_CURRENT_OUT_OF_RANGE),
+};
+
+static const struct InRangeCheckCanSignals voltage_can_signals[] = {
+    IN_RANGE_CHECK_CAN_SIGNALS(
+        PDM_NON_CRITICAL_ERRORS,
+        VBAT,
+        VBAT_VOLTAGE_OUT_OF_RANGE),
+    IN_RANGE_CHECK_CAN_SIGNALS(
+        PDM_NON_CRITICAL_ERRORS,
+        _24_V_AUX,
+        _24_V_AUX_VOLTAGE_OUT_OF_RANGE),
+    IN_RANGE_CHECK_CAN_SIGNALS(
+        PDM_NON_CRITICAL_ERRORS,
+        _24_V_ACC,
+        _24_V_ACC_VOLTAGE_OUT_OF_RANGE),
+};
 
 void App_SetPeriodicCanSignals_CurrentInRangeChecks(
     const struct PdmWorld *world)
 {
-    struct PdmCanTxInterface *can_tx = App_PdmWorld_GetCanTx(world);
-
-    struct InRangeCheck *aux1_current_in_range_check =
-        App_PdmWorld_GetAux1CurrentInRangeCheck(world);
-    struct InRangeCheck *aux2_current_in_range_check =
-        App_PdmWorld_GetAux2CurrentInRangeCheck(world);
-    struct InRangeCheck *left_inverter_current_in_range_check =
-        App_PdmWorld_GetLeftInverterCurrentInRangeCheck(world);
-    struct InRangeCheck *right_inverter_current_in_range_check =
-        App_PdmWorld_GetRightInverterCurrentInRangeCheck(world);
-    struct InRangeCheck *energy_meter_current_in_range_check =
-        App_PdmWorld_GetEnergyMeterCurrentInRangeCheck(world);
-    struct InRangeCheck *can_current_in_range_check =
-        App_PdmWorld_GetCanCurrentInRangeCheck(world);
-    struct InRangeCheck *air_shutdown_current_in_range_check =
-        App_PdmWorld_GetAirShutdownCurrentInRangeCheck(world);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, aux1_current_in_range_check,
-        App_CanTx_SetPeriodicSignal_AUXILIARY1_CURRENT,
-        App_CanTx_SetPeriodicSignal_AUX1_CURRENT_OUT_OF_RANGE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_AUX1_CURRENT_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_AUX1_CURRENT_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_AUX1_CURRENT_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, aux2_current_in_range_check,
-        App_CanTx_SetPeriodicSignal_AUXILIARY2_CURRENT,
-        App_CanTx_SetPeriodicSignal_AUX2_CURRENT_OUT_OF_RANGE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_AUX2_CURRENT_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_AUX2_CURRENT_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_AUX2_CURRENT_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, left_inverter_current_in_range_check,
-        App_CanTx_SetPeriodicSignal_LEFT_INVERTER_CURRENT,
-        App_CanTx_SetPeriodicSignal_LEFT_INVERTER_CURRENT_OUT_OF_RANGE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_LEFT_INVERTER_CURRENT_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_LEFT_INVERTER_CURRENT_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_LEFT_INVERTER_CURRENT_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, right_inverter_current_in_range_check,
-        App_CanTx_SetPeriodicSignal_RIGHT_INVERTER_CURRENT,
-        App_CanTx_SetPeriodicSignal_RIGHT_INVERTER_CURRENT_OUT_OF_RANGE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_RIGHT_INVERTER_CURRENT_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_RIGHT_INVERTER_CURRENT_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_RIGHT_INVERTER_CURRENT_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, energy_meter_current_in_range_check,
-        App_CanTx_SetPeriodicSignal_ENERGY_METER_CURRENT,
-        App_CanTx_SetPeriodicSignal_ENERGY_METER_CURRENT_OUT_OF_RANGE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_ENERGY_METER_CURRENT_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_ENERGY_METER_CURRENT_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_ENERGY_METER_CURRENT_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, can_current_in_range_check,
-        App_CanTx_SetPeriodicSignal_CAN_CURRENT,
-        App_CanTx_SetPeriodicSignal_CAN_CURRENT_OUT_OF_RANGE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_CAN_CURRENT_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_CAN_CURRENT_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_CAN_CURRENT_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, air_shutdown_current_in_range_check,
-        App_CanTx_SetPeriodicSignal_AIR_SHUTDOWN_CURRENT,
-        App_CanTx_SetPeriodicSignal_AIR_SHUTDOWN_CURRENT_OUT_OF_RANGE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_AIR_SHUTDOWN_CURRENT_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_AIR_SHUTDOWN_CURRENT_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_AIR_SHUTDOWN_CURRENT_OUT_OF_RANGE_OVERFLOW_CHOICE);
+    struct InRangeCheck *const in_range_checks[] = {
+        App_PdmWorld_GetAux1CurrentInRangeCheck(world),
+        App_PdmWorld_GetAux2CurrentInRangeCheck(world),
+        App_PdmWorld_GetLeftInverterCurrentInRangeCheck(world),
+        App_PdmWorld_GetRightInverterCurrentInRangeCheck(world),
+        App_PdmWorld_GetEnergyMeterCurrentInRangeCheck(world),
+        App_PdmWorld_GetCanCurrentInRangeCheck(world),
+        App_PdmWorld_GetAirShutdownCurrentInRangeCheck(world),
+    };
+
+    App_SetPeriodicCanSignals_InRangeChecks(
+        App_PdmWorld_GetCanTx(world), in_range_checks, current_can_signals,
+        NUM_ELEMENTS_IN_ARRAY(current_can_signals), NULL);
 }
 
 void App_SetPeriodicCanSignals_VoltageInRangeChecks(
     const struct PdmWorld *world)
 {
-    struct PdmCanTxInterface *can_tx = App_PdmWorld_GetCanTx(world);
-
-    struct InRangeCheck *vbat_voltage_in_range_check =
-        App_PdmWorld_GetVbatVoltageInRangeCheck(world);
-    struct InRangeCheck *_24v_aux_voltage_in_range_check =
-        App_PdmWorld_Get24vAuxVoltageInRangeCheck(world);
-    struct InRangeCheck *_24v_acc_voltage_in_range_check =
-        App_PdmWorld_Get24vAccVoltageInRangeCheck(world);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, vbat_voltage_in_range_check, App_CanTx_SetPeriodicSignal_VBAT,
-        App_CanTx_SetPeriodicSignal_VBAT_VOLTAGE_OUT_OF_RANGE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_VBAT_VOLTAGE_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_VBAT_VOLTAGE_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS_VBAT_VOLTAGE_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, _24v_aux_voltage_in_range_check,
-        App_CanTx_SetPeriodicSignal__24_V_AUX,
-        App_CanTx_SetPeriodicSignal__24_V_AUX_VOLTAGE_OUT_OF_RANGE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS__24_V_AUX_VOLTAGE_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS__24_V_AUX_VOLTAGE_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS__24_V_AUX_VOLTAGE_OUT_OF_RANGE_OVERFLOW_CHOICE);
-
-    App_SetPeriodicCanSignals_InRangeCheck(
-        can_tx, _24v_acc_voltage_in_range_check,
-        App_CanTx_SetPeriodicSignal__24_V_ACC,
-        App_CanTx_SetPeriodicSignal__24_V_ACC_VOLTAGE_OUT_OF_RANGE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS__24_V_ACC_VOLTAGE_OUT_OF_RANGE_OK_CHOICE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS__24_V_ACC_VOLTAGE_OUT_OF_RANGE_UNDERFLOW_CHOICE,
-        CANMSGS_PDM_NON_CRITICAL_ERRORS__24_V_ACC_VOLTAGE_OUT_OF_RANGE_OVERFLOW_CHOICE);
+    struct InRangeCheck *const in_range_checks[] = {
+        App_PdmWorld_GetVbatVoltageInRangeCheck(world),
+        App_PdmWorld_Get24vAuxVoltageInRangeCheck(world),
+        App_PdmWorld_Get24vAccVoltageInRangeCheck(world),
+    };
+
+    App_SetPeriodicCanSignals_InRangeChecks(
+        App_PdmWorld_GetCanTx(world), in_range_checks, voltage_can_signals,
+        NUM_ELEMENTS_IN_ARRAY(voltage_can_signals), NULL);
+}
+
+void App_SetPeriodicCanSignals_PowerSequencer(const struct PdmWorld *world)
+{
+    struct PdmCanTxInterface *const    can_tx = App_PdmWorld_GetCanTx(world);
+    const struct PowerSequencer *const power_sequencer =
+        App_PdmWorld_GetPowerSequencer(world);
+
+    App_CanTx_SetPeriodicSignal_POWER_SEQUENCE_STATE(
+        can_tx, App_GetPowerSequenceStateChoice(
+                    App_PowerSequencer_GetState(power_sequencer)));
+
+    // Saturate rather than wrap if the sequence takes longer than the signal
+    // can represent
+    const uint32_t time_to_ready_ms =
+        App_PowerSequencer_GetTimeToReadyMs(power_sequencer);
+    App_CanTx_SetPeriodicSignal_POWER_SEQUENCE_TIME_TO_READY(
+        can_tx,
+        (uint16_t)(
+            time_to_ready_ms > UINT16_MAX ? UINT16_MAX : time_to_ready_ms));
+}
+
+void App_SetPeriodicCanSignals_ThermalFuses(const struct PdmWorld *world)
+{
+    struct PdmCanTxInterface *const  can_tx = App_PdmWorld_GetCanTx(world);
+    const struct ThermalFuses *const thermal_fuses =
+        App_PdmWorld_GetThermalFuses(world);
+
+    App_CanTx_SetPeriodicSignal_AUX1_THERMAL_LOAD(
+        can_tx, App_GetThermalLoadPercentage(App_ThermalFuses_GetThermalLoad(
+                    thermal_fuses, THERMAL_FUSE_AUX1)));
+    App_CanTx_SetPeriodicSignal_AUX2_THERMAL_LOAD(
+        can_tx, App_GetThermalLoadPercentage(App_ThermalFuses_GetThermalLoad(
+                    thermal_fuses, THERMAL_FUSE_AUX2)));
+    App_CanTx_SetPeriodicSignal_AUX1_THERMAL_FUSE_STATE(
+        can_tx, App_GetThermalFuseStateChoice(App_ThermalFuses_GetState(
+                    thermal_fuses, THERMAL_FUSE_AUX1)));
+    App_CanTx_SetPeriodicSignal_AUX2_THERMAL_FUSE_STATE(
+        can_tx, App_GetThermalFuseStateChoice(App_ThermalFuses_GetState(
+                    thermal_fuses, THERMAL_FUSE_AUX2)));
+}
+
+void App_SetPeriodicCanSignals_StateMachineTrace(
+    struct PdmCanTxInterface *const  can_tx,
+    const struct StateMachine *const state_machine)
+{
+    App_SetPeriodicCanSignals_SharedStateMachineTrace(
+        can_tx, state_machine, App_GetStateChoice);
 }
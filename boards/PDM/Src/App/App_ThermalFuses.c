@@ -0,0 +1,206 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <math.h>
+#include "App_ThermalFuses.h"
+
+// The per-channel state is laid out as a struct of arrays, so the integration
+// of a block of samples is a tight loop with no branches. The arrays written by
+// App_ThermalFuses_ProcessSamples are only read by the other functions, which
+// are called from a different context.
+struct ThermalFuses
+{
+    const struct ThermalFuseConfig *configs;
+    size_t                          num_channels;
+
+    // The fraction of the distance to its steady-state value that the thermal
+    // load covers in a sample period, and the inverse of the square of the
+    // rated current of every channel
+    float *alphas;
+    float *inverse_rated_currents_squared;
+
+    // Written by App_ThermalFuses_ProcessSamples
+    volatile float *   thermal_loads;
+    volatile uint32_t *num_trip_events;
+    bool *             is_over_limit;
+
+    // Written by App_ThermalFuses_Tick
+    uint32_t *             num_handled_trip_events;
+    uint32_t *             num_retries;
+    enum ThermalFuseState *states;
+};
+
+struct ThermalFuses *App_ThermalFuses_Create(
+    const struct ThermalFuseConfig *const configs,
+    const size_t                          num_channels,
+    const float                           sample_period_s)
+{
+    assert(configs != NULL);
+    assert(num_channels > 0U);
+    assert(sample_period_s > 0.0f);
+
+    struct ThermalFuses *const thermal_fuses =
+        malloc(sizeof(struct ThermalFuses));
+    assert(thermal_fuses != NULL);
+
+    thermal_fuses->alphas = malloc(num_channels * sizeof(float));
+    thermal_fuses->inverse_rated_currents_squared =
+        malloc(num_channels * sizeof(float));
+    thermal_fuses->thermal_loads   = calloc(num_channels, sizeof(float));
+    thermal_fuses->num_trip_events = calloc(num_channels, sizeof(uint32_t));
+    thermal_fuses->is_over_limit   = calloc(num_channels, sizeof(bool));
+    thermal_fuses->num_handled_trip_events =
+        calloc(num_channels, sizeof(uint32_t));
+    thermal_fuses->num_retries = calloc(num_channels, sizeof(uint32_t));
+    thermal_fuses->states = calloc(num_channels, sizeof(enum ThermalFuseState));
+    assert(thermal_fuses->alphas != NULL);
+    assert(thermal_fuses->inverse_rated_currents_squared != NULL);
+    assert(thermal_fuses->thermal_loads != NULL);
+    assert(thermal_fuses->num_trip_events != NULL);
+    assert(thermal_fuses->is_over_limit != NULL);
+    assert(thermal_fuses->num_handled_trip_events != NULL);
+    assert(thermal_fuses->num_retries != NULL);
+    assert(thermal_fuses->states != NULL);
+
+    for (size_t i = 0U; i < num_channels; i++)
+    {
+        assert(configs[i].rated_current > 0.0f);
+        assert(configs[i].i2t_rating > 0.0f);
+        assert(configs[i].retry_load < configs[i].soft_trip_load);
+        assert(configs[i].soft_trip_load < 1.0f);
+
+        const float rated_current_squared =
+            configs[i].rated_current * configs[i].rated_current;
+        const float time_constant_s =
+            configs[i].i2t_rating / rated_current_squared;
+
+        // The thermal load is a first-order low-pass filter of the square of
+        // the current, normalized so a constant rated current settles at a
+        // thermal load of 1
+        thermal_fuses->alphas[i] =
+            1.0f - expf(-sample_period_s / time_constant_s);
+        thermal_fuses->inverse_rated_currents_squared[i] =
+            1.0f / rated_current_squared;
+        thermal_fuses->states[i] = THERMAL_FUSE_OK;
+    }
+
+    thermal_fuses->configs      = configs;
+    thermal_fuses->num_channels = num_channels;
+
+    return thermal_fuses;
+}
+
+void App_ThermalFuses_Destroy(struct ThermalFuses *const thermal_fuses)
+{
+    free(thermal_fuses->alphas);
+    free(thermal_fuses->inverse_rated_currents_squared);
+    free((float *)thermal_fuses->thermal_loads);
+    free((uint32_t *)thermal_fuses->num_trip_events);
+    free(thermal_fuses->is_over_limit);
+    free(thermal_fuses->num_handled_trip_events);
+    free(thermal_fuses->num_retries);
+    free(thermal_fuses->states);
+    free(thermal_fuses);
+}
+
+void App_ThermalFuses_ProcessSamples(
+    struct ThermalFuses *const thermal_fuses,
+    const float *const         currents,
+    const size_t               num_samples)
+{
+    const size_t num_channels = thermal_fuses->num_channels;
+
+    for (size_t i = 0U; i < num_channels; i++)
+    {
+        const float alpha = thermal_fuses->alphas[i];
+        const float inverse_rated_current_squared =
+            thermal_fuses->inverse_rated_currents_squared[i];
+
+        float    thermal_load    = thermal_fuses->thermal_loads[i];
+        bool     is_over_limit   = thermal_fuses->is_over_limit[i];
+        uint32_t num_trip_events = 0U;
+
+        for (size_t sample = 0U; sample < num_samples; sample++)
+        {
+            const float current = currents[sample * num_channels + i];
+
+            thermal_load +=
+                alpha * (current * current * inverse_rated_current_squared -
+                         thermal_load);
+
+            // Every sample is checked, so a spike that trips the channel is
+            // caught even if the thermal load has cooled down by the end of
+            // the block. A trip is only counted when the thermal load rises
+            // over the limit.
+            const bool was_over_limit = is_over_limit;
+            is_over_limit             = thermal_load >= 1.0f;
+            num_trip_events += (uint32_t)(is_over_limit && !was_over_limit);
+        }
+
+        thermal_fuses->thermal_loads[i] = thermal_load;
+        thermal_fuses->is_over_limit[i] = is_over_limit;
+        thermal_fuses->num_trip_events[i] += num_trip_events;
+    }
+}
+
+void App_ThermalFuses_Tick(struct ThermalFuses *const thermal_fuses)
+{
+    for (size_t i = 0U; i < thermal_fuses->num_channels; i++)
+    {
+        const struct ThermalFuseConfig *const config =
+            &thermal_fuses->configs[i];
+        const float    thermal_load        = thermal_fuses->thermal_loads[i];
+        const uint32_t num_trip_events     = thermal_fuses->num_trip_events[i];
+        enum ThermalFuseState *const state = &thermal_fuses->states[i];
+
+        if (num_trip_events != thermal_fuses->num_handled_trip_events[i])
+        {
+            thermal_fuses->num_handled_trip_events[i] = num_trip_events;
+
+            *state = thermal_fuses->num_retries[i] < config->max_num_retries
+                         ? THERMAL_FUSE_TRIPPED
+                         : THERMAL_FUSE_LATCHED;
+        }
+        else if (*state == THERMAL_FUSE_TRIPPED)
+        {
+            if (thermal_load <= config->retry_load)
+            {
+                thermal_fuses->num_retries[i]++;
+                *state = THERMAL_FUSE_OK;
+            }
+        }
+        else if (*state != THERMAL_FUSE_LATCHED)
+        {
+            *state = thermal_load >= config->soft_trip_load
+                         ? THERMAL_FUSE_SOFT_TRIPPED
+                         : THERMAL_FUSE_OK;
+        }
+    }
+}
+
+float App_ThermalFuses_GetThermalLoad(
+    const struct ThermalFuses *const thermal_fuses,
+    const size_t                     channel)
+{
+    assert(channel < thermal_fuses->num_channels);
+
+    return thermal_fuses->thermal_loads[channel];
+}
+
+enum ThermalFuseState App_ThermalFuses_GetState(
+    const struct ThermalFuses *const thermal_fuses,
+    const size_t                     channel)
+{
+    assert(channel < thermal_fuses->num_channels);
+
+    return thermal_fuses->states[channel];
+}
+
+uint32_t App_ThermalFuses_GetNumTrips(
+    const struct ThermalFuses *const thermal_fuses,
+    const size_t                     channel)
+{
+    assert(channel < thermal_fuses->num_channels);
+
+    return thermal_fuses->num_handled_trip_events[channel];
+}
@@ -1,4 +1,6 @@
 #include "states/App_AllStates.h"
+#include "App_SetPeriodicCanSignals.h"
+#include "configs/App_ThermalFuseConfig.h"
 
 void App_AllStatesRunOnTick1Hz(struct StateMachine *const state_machine)
 {
@@ -7,6 +9,8 @@ void App_AllStatesRunOnTick1Hz(struct StateMachine *const state_machine)
         App_PdmWorld_GetRgbLedSequence(world);
 
     App_SharedRgbLedSequence_Tick(rgb_led_sequence);
+    App_SetPeriodicCanSignals_StateMachineTrace(
+        App_PdmWorld_GetCanTx(world), state_machine);
 }
 
 void App_AllStatesRunOnTick100Hz(struct StateMachine *const state_machine)
@@ -15,6 +19,27 @@ void App_AllStatesRunOnTick100Hz(struct StateMachine *const state_machine)
     struct PdmCanTxInterface *can_tx = App_PdmWorld_GetCanTx(world);
     struct LowVoltageBattery *low_voltage_battery =
         App_PdmWorld_GetLowVoltageBattery(world);
+    struct PowerSequencer *power_sequencer =
+        App_PdmWorld_GetPowerSequencer(world);
+    struct ThermalFuses *thermal_fuses = App_PdmWorld_GetThermalFuses(world);
+    struct Clock *       clock         = App_PdmWorld_GetClock(world);
+
+    // The power sequencer owns the outputs, so the thermal fuses only tell it
+    // which channels are tripped before it decides which loads to power up
+    App_ThermalFuses_Tick(thermal_fuses);
+    for (size_t i = 0U; i < NUM_THERMAL_FUSE_CHANNELS; i++)
+    {
+        const enum ThermalFuseState state =
+            App_ThermalFuses_GetState(thermal_fuses, i);
+        App_PowerSequencer_SetStepTripped(
+            power_sequencer, i, state == THERMAL_FUSE_TRIPPED,
+            state == THERMAL_FUSE_LATCHED);
+    }
+    App_SetPeriodicCanSignals_ThermalFuses(world);
+
+    App_PowerSequencer_Tick(
+        power_sequencer, App_SharedClock_GetCurrentTimeInMilliseconds(clock));
+    App_SetPeriodicCanSignals_PowerSequencer(world);
 
     if (App_LowVoltageBattery_HasChargeFault(low_voltage_battery))
     {
@@ -12,6 +12,13 @@ static void InitStateRunOnEntry(struct StateMachine *const state_machine)
     struct PdmCanTxInterface *can_tx_interface = App_PdmWorld_GetCanTx(world);
     App_CanTx_SetPeriodicSignal_STATE(
         can_tx_interface, CANMSGS_PDM_STATE_MACHINE_STATE_INIT_CHOICE);
+
+    // Bring the loads up in the order of the power sequence table rather
+    // than all at once, so their inrush currents don't trip the efuses
+    struct Clock *clock = App_PdmWorld_GetClock(world);
+    App_PowerSequencer_Start(
+        App_PdmWorld_GetPowerSequencer(world),
+        App_SharedClock_GetCurrentTimeInMilliseconds(clock));
 }
 
 static void InitStateRunOnTick1Hz(struct StateMachine *const state_machine)
@@ -1,6 +1,6 @@
-#include <stm32f3xx.h>
-#include "Io_SharedAdc.h"
+#include "Io_SharedDmaAdc.h"
 #include "Io_Adc.h"
+#include "Io_CurrentSense.h"
 
 // In STM32 terminology, each ADC pin corresponds to an ADC channel (See:
 // ADCEx_channels). If there are multiple ADC channels being measured, the ADC
@@ -10,19 +10,19 @@
 // For example, suppose we are measuring ADC channel 2, 4, and 7, which have
 // rank 3, 1, and 2 respectively. The ADC will measure the channel 4, then
 // channel 7, and finally channel 2. This order is important because it
-// determines the order in which the DMA writes data to our raw_adc_values
-// buffer.
+// determines the order in which the DMA writes each conversion set into the
+// buffer of raw ADC values.
 //
-// The following enum is used to index into raw_adc_values, which means it must
-// be ordered in ascending ranks. If we were writing an enum for the earlier
-// example, it would look like:
+// The following enum is used to index into each conversion set, which means it
+// must be ordered in ascending ranks. If we were writing an enum for the
+// earlier example, it would look like:
 //
 // enum
 // {
 //     CHANNEL_4, // Rank 1
 //     CHANNEL_7, // Rank 2
 //     CHANNEL_2, // Rank 3
-//     NUM_ADC_CHANNELS,
+//     NUM_ADC1_CHANNELS,
 // };
 enum
 {
@@ -33,66 +33,121 @@ enum
     CHANNEL_7,
     CHANNEL_8,
     CHANNEL_9,
-    NUM_ADC_CHANNELS
+    NUM_ADC1_CHANNELS
 };
 
-static uint16_t raw_adc_values[NUM_ADC_CHANNELS];
-static float    adc_voltages[NUM_ADC_CHANNELS];
+// The number of conversion sets converted at a time. Every conversion set is
+// passed on as a current sample, while the voltages are averaged over all of
+// them.
+#define NUM_CONVERSION_SETS 10U
+
+static const struct AdcChannelConfig channel_configs[NUM_ADC1_CHANNELS] = {
+    [CHANNEL_1] = { .oversampling_ratio = NUM_CONVERSION_SETS,
+                    .gain               = 1.0f,
+                    .offset             = 0.0f },
+    [CHANNEL_2] = { .oversampling_ratio = NUM_CONVERSION_SETS,
+                    .gain               = 1.0f,
+                    .offset             = 0.0f },
+    [CHANNEL_3] = { .oversampling_ratio = NUM_CONVERSION_SETS,
+                    .gain               = 1.0f,
+                    .offset             = 0.0f },
+    [CHANNEL_6] = { .oversampling_ratio = NUM_CONVERSION_SETS,
+                    .gain               = 1.0f,
+                    .offset             = 0.0f },
+    [CHANNEL_7] = { .oversampling_ratio = NUM_CONVERSION_SETS,
+                    .gain               = 1.0f,
+                    .offset             = 0.0f },
+    [CHANNEL_8] = { .oversampling_ratio = NUM_CONVERSION_SETS,
+                    .gain               = 1.0f,
+                    .offset             = 0.0f },
+    [CHANNEL_9] = { .oversampling_ratio = NUM_CONVERSION_SETS,
+                    .gain               = 1.0f,
+                    .offset             = 0.0f },
+};
+
+static struct DmaAdc *adc1;
+
+/**
+ * Pass the current sense voltages of every conversion set on to be sampled as
+ * currents
+ * @param adc_voltages: The voltages of every channel for each conversion set
+ * @param num_conversion_sets: The number of conversion sets
+ */
+static void Io_SampleCurrentSenseVoltages(
+    const float *adc_voltages,
+    size_t       num_conversion_sets);
+
+static void Io_SampleCurrentSenseVoltages(
+    const float *const adc_voltages,
+    const size_t       num_conversion_sets)
+{
+    float current_sense_voltages[NUM_CONVERSION_SETS][NUM_SAMPLED_CURRENTS];
+
+    for (size_t set = 0U; set < num_conversion_sets; set++)
+    {
+        const float *const set_voltages =
+            &adc_voltages[set * NUM_ADC1_CHANNELS];
+
+        current_sense_voltages[set][SAMPLED_CURRENT_AUX1] =
+            set_voltages[CHANNEL_6];
+        current_sense_voltages[set][SAMPLED_CURRENT_AUX2] =
+            set_voltages[CHANNEL_7];
+    }
+
+    Io_CurrentSense_SampleCurrents(
+        &current_sense_voltages[0][0], num_conversion_sets);
+}
+
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    UNUSED(hadc);
+    Io_SharedDmaAdc_ConvertFirstHalf(adc1);
+}
 
 void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
 {
-    adc_voltages[CHANNEL_1] = Io_SharedAdc_ConvertRawAdcValueToVoltage(
-        hadc, raw_adc_values[CHANNEL_1]);
-    adc_voltages[CHANNEL_2] = Io_SharedAdc_ConvertRawAdcValueToVoltage(
-        hadc, raw_adc_values[CHANNEL_2]);
-    adc_voltages[CHANNEL_3] = Io_SharedAdc_ConvertRawAdcValueToVoltage(
-        hadc, raw_adc_values[CHANNEL_3]);
-    adc_voltages[CHANNEL_6] = Io_SharedAdc_ConvertRawAdcValueToVoltage(
-        hadc, raw_adc_values[CHANNEL_6]);
-    adc_voltages[CHANNEL_7] = Io_SharedAdc_ConvertRawAdcValueToVoltage(
-        hadc, raw_adc_values[CHANNEL_7]);
-    adc_voltages[CHANNEL_8] = Io_SharedAdc_ConvertRawAdcValueToVoltage(
-        hadc, raw_adc_values[CHANNEL_8]);
-    adc_voltages[CHANNEL_9] = Io_SharedAdc_ConvertRawAdcValueToVoltage(
-        hadc, raw_adc_values[CHANNEL_9]);
+    UNUSED(hadc);
+    Io_SharedDmaAdc_ConvertSecondHalf(adc1);
 }
 
-uint16_t *Io_Adc_GetRawAdcValues(void)
+void Io_Adc_Init(ADC_HandleTypeDef *const hadc1)
 {
-    return raw_adc_values;
+    adc1 = Io_SharedDmaAdc_Create(hadc1, NUM_CONVERSION_SETS, channel_configs);
+    Io_SharedDmaAdc_SetConversionSetsCallback(
+        adc1, Io_SampleCurrentSenseVoltages);
 }
 
 float Io_Adc_GetChannel1Voltage(void)
 {
-    return adc_voltages[CHANNEL_1];
+    return Io_SharedDmaAdc_GetValue(adc1, CHANNEL_1);
 }
 
 float Io_Adc_GetChannel2Voltage(void)
 {
-    return adc_voltages[CHANNEL_2];
+    return Io_SharedDmaAdc_GetValue(adc1, CHANNEL_2);
 }
 
 float Io_Adc_GetChannel3Voltage(void)
 {
-    return adc_voltages[CHANNEL_3];
+    return Io_SharedDmaAdc_GetValue(adc1, CHANNEL_3);
 }
 
 float Io_Adc_GetChannel6Voltage(void)
 {
-    return adc_voltages[CHANNEL_6];
+    return Io_SharedDmaAdc_GetValue(adc1, CHANNEL_6);
 }
 
 float Io_Adc_GetChannel7Voltage(void)
 {
-    return adc_voltages[CHANNEL_7];
+    return Io_SharedDmaAdc_GetValue(adc1, CHANNEL_7);
 }
 
 float Io_Adc_GetChannel8Voltage(void)
 {
-    return adc_voltages[CHANNEL_8];
+    return Io_SharedDmaAdc_GetValue(adc1, CHANNEL_8);
 }
 
 float Io_Adc_GetChannel9Voltage(void)
 {
-    return adc_voltages[CHANNEL_9];
+    return Io_SharedDmaAdc_GetValue(adc1, CHANNEL_9);
 }
@@ -102,5 +102,5 @@ ExitCode Io_Aux1Aux2Efuse_ConfigureEfuse(void)
     RETURN_CODE_IF_EXIT_NOT_OK(Io_Efuse_WriteRegister(
         SI_OCR_1_ADDR, OCR_LOW_CURRENT_SENSE_CONFIG, aux1_aux2_efuse));
 
-    return EXIT_CODE_OK;
+    return Io_Efuse_TransferRegisters();
 }
@@ -2,20 +2,42 @@
 #include "Io_Adc.h"
 #include "main.h"
 
-float Io_CurrentSense_GetAux1Current(void)
+// Current = ADC Voltage * Current Gain Ratio
+#define LOW_CURRENT_SENSE_GAIN_RATIO 500.0f
+
+static void (
+    *sampled_currents_callback)(const float *currents, size_t num_samples);
+
+void Io_CurrentSense_SetSampledCurrentsCallback(
+    void (*const callback)(const float *currents, size_t num_samples))
+{
+    sampled_currents_callback = callback;
+}
+
+void Io_CurrentSense_SampleCurrents(
+    float *const current_sense_voltages,
+    const size_t num_samples)
 {
-    // Aux1 Current = ADC Voltage * Current Gain Ratio
+    // Aux1 and Aux2 share the same current gain ratio
+    for (size_t i = 0U; i < num_samples * NUM_SAMPLED_CURRENTS; i++)
+    {
+        current_sense_voltages[i] *= LOW_CURRENT_SENSE_GAIN_RATIO;
+    }
 
-    const float LOW_CURRENT_SENSE_GAIN_RATIO = 500.0f;
-    return (Io_Adc_GetChannel6Voltage() * LOW_CURRENT_SENSE_GAIN_RATIO);
+    if (sampled_currents_callback != NULL)
+    {
+        sampled_currents_callback(current_sense_voltages, num_samples);
+    }
 }
 
-float Io_CurrentSense_GetAux2Current(void)
+float Io_CurrentSense_GetAux1Current(void)
 {
-    // Aux2 Current = ADC Voltage * Current Gain Ratio
+    return Io_Adc_GetChannel6Voltage() * LOW_CURRENT_SENSE_GAIN_RATIO;
+}
 
-    const float LOW_CURRENT_SENSE_GAIN_RATIO = 500.0f;
-    return (Io_Adc_GetChannel7Voltage() * LOW_CURRENT_SENSE_GAIN_RATIO);
+float Io_CurrentSense_GetAux2Current(void)
+{
+    return Io_Adc_GetChannel7Voltage() * LOW_CURRENT_SENSE_GAIN_RATIO;
 }
 
 float Io_CurrentSense_GetLeftInverterCurrent(void)
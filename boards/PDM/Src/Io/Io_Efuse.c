@@ -4,14 +4,17 @@
 #include "Io_Efuse.h"
 #include "configs/Io_EfuseConfig.h"
 
+// The efuses on the PDM share one SPI bus, each with its own chip select
+#define MAX_NUM_EFUSES 4U
+#define SPI_TIMEOUT_MS 100U
+
 struct Efuse_Context
 {
     float (*get_channel_0_current)(void);
     float (*get_channel_1_current)(void);
 
-    SPI_HandleTypeDef *spi_handle;
-    GPIO_TypeDef *     nss_port;
-    uint16_t           nss_pin;
+    // The index of the efuse in the register cache of the SPI bus
+    size_t index;
 
     GPIO_TypeDef *fsob_port;
     uint16_t      fsob_pin;
@@ -24,129 +27,53 @@ struct Efuse_Context
     uint16_t      channel_0_pin;
     GPIO_TypeDef *channel_1_port;
     uint16_t      channel_1_pin;
-
-    // The current state of the watchdog-in bit (bit 15). If the watchdog is
-    // enabled its state must be alternated at least once within the watchdog
-    // timeout period.
-    bool wdin_bit_to_set;
 };
 
-/**
- * Calculate the parity of the SPI command to be sent to the efuse and
- * set/clear the parity bit. Using the XOR sum of bits method taken from:
- * https://en.wikipedia.org/wiki/Parity_bit#Parity
- * @param spi_command Original SPI command without the parity bit set/cleared
- */
-static void Io_Efuse_CalculateParityBit(uint16_t *serial_data_input);
+static SPI_HandleTypeDef *  efuse_spi_handle;
+static struct EfuseManager *efuse_manager;
+static size_t               num_efuses;
+static GPIO_TypeDef *       nss_ports[MAX_NUM_EFUSES];
+static uint16_t             nss_pins[MAX_NUM_EFUSES];
+
+static struct EfuseFrame *efuse_frames;
+static size_t             num_efuse_frames;
+static size_t             efuse_frame_index;
+static volatile bool      is_transfer_busy;
 
 /**
- * Write SPI data to efuse in blocking mode
- * @param tx_data Pointer to data being sent to the efuse
- * @param efuse_spi_handle Handle to the efuse's SPI peripheral
- * @param nss_port Handle to the GPIO port of the efuse's NSS pin
- * @param nss_pin Efuse's GPIO NSS pin
- * @return EXIT_CODE_OK if the write was successful
- *         EXIT_CODE_TIMEOUT if the SPI write timed-out
+ * Start exchanging the current frame of the transaction by DMA
+ * @return true if the DMA transfer was started, else false
  */
-static ExitCode Io_Efuse_WriteToEfuse(
-    uint16_t *         tx_data,
-    SPI_HandleTypeDef *efuse_spi_handle,
-    GPIO_TypeDef *     nss_port,
-    uint16_t           nss_pin);
+static bool Io_Efuse_StartFrameTransfer(void);
 
 /**
- * Read SPI data from efuse in blocking mode
- * @param tx_data Pointer to data being sent to the efuse
- * @param rx_data Pointer to data being received from the efuse
- * @param efuse_spi_handle Handle to the efuse's SPI peripheral
- * @param nss_port Handle to the GPIO port of the efuse's NSS pin
- * @param nss_pin Efuse's GPIO NSS pin
- * @return EXIT_CODE_OK if the read was successful
- *         EXIT_CODE_TIMEOUT if the SPI read timed-out
+ * End the transaction started by Io_Efuse_StartTransfer()
+ * @param is_successful: Whether every frame of the transaction was exchanged
  */
-static ExitCode Io_Efuse_ReadFromEfuse(
-    uint16_t *         tx_data,
-    uint16_t *         rx_data,
-    SPI_HandleTypeDef *efuse_spi_handle,
-    GPIO_TypeDef *     nss_port,
-    uint16_t           nss_pin);
-
-static void Io_Efuse_CalculateParityBit(uint16_t *serial_data_input)
-{
-    uint16_t _serial_data_input = *serial_data_input;
-    bool     parity_bit;
-
-    for (parity_bit = 0; _serial_data_input > 0; _serial_data_input >>= 1)
-    {
-        parity_bit ^= READ_BIT(_serial_data_input, 1U);
-    }
-
-    if (parity_bit)
-    {
-        SET_BIT_UINT16(*serial_data_input, PARITY_BIT);
-    }
-    else
-    {
-        CLEAR_BIT_UINT16(*serial_data_input, PARITY_BIT);
-    }
-}
+static void Io_Efuse_EndTransfer(bool is_successful);
 
-static ExitCode Io_Efuse_WriteToEfuse(
-    uint16_t *         tx_data,
-    SPI_HandleTypeDef *efuse_spi_handle,
-    GPIO_TypeDef *     nss_port,
-    uint16_t           nss_pin)
+static bool Io_Efuse_StartFrameTransfer(void)
 {
-    HAL_StatusTypeDef status = HAL_OK;
-
-    HAL_GPIO_WritePin(nss_port, nss_pin, GPIO_PIN_RESET);
-    status = HAL_SPI_TransmitReceive(
-        efuse_spi_handle, (uint8_t *)tx_data, (uint8_t *)tx_data, 1U, 100U);
-    HAL_GPIO_WritePin(nss_port, nss_pin, GPIO_PIN_SET);
+    struct EfuseFrame *const frame = &efuse_frames[efuse_frame_index];
 
-    if (status != HAL_OK)
+    HAL_GPIO_WritePin(
+        nss_ports[frame->efuse], nss_pins[frame->efuse], GPIO_PIN_RESET);
+    if (HAL_SPI_TransmitReceive_DMA(
+            efuse_spi_handle, (uint8_t *)&frame->tx_data,
+            (uint8_t *)&frame->rx_data, 1U) != HAL_OK)
     {
-        return EXIT_CODE_TIMEOUT;
+        HAL_GPIO_WritePin(
+            nss_ports[frame->efuse], nss_pins[frame->efuse], GPIO_PIN_SET);
+        return false;
     }
 
-    return EXIT_CODE_OK;
+    return true;
 }
 
-static ExitCode Io_Efuse_ReadFromEfuse(
-    uint16_t *         tx_data,
-    uint16_t *         rx_data,
-    SPI_HandleTypeDef *efuse_spi_handle,
-    GPIO_TypeDef *     nss_port,
-    uint16_t           nss_pin)
+static void Io_Efuse_EndTransfer(const bool is_successful)
 {
-    // Send the command stored in tx_data to the status register, to read the
-    // data from the register address specified in tx_data
-    HAL_GPIO_WritePin(nss_port, nss_pin, GPIO_PIN_RESET);
-    HAL_StatusTypeDef status = HAL_SPI_TransmitReceive(
-        efuse_spi_handle, (uint8_t *)tx_data, (uint8_t *)rx_data, 1U, 100U);
-    HAL_GPIO_WritePin(nss_port, nss_pin, GPIO_PIN_SET);
-
-    if (status != HAL_OK)
-    {
-        return EXIT_CODE_TIMEOUT;
-    }
-
-    // Receive data from the register address specified in tx_data by sending
-    // dummy data
-    *tx_data = 0xFFFF;
-    // The data read from the register specified in tx_data is stored in rx_data
-    // after the SPI transfer
-    HAL_GPIO_WritePin(nss_port, nss_pin, GPIO_PIN_RESET);
-    status = HAL_SPI_TransmitReceive(
-        efuse_spi_handle, (uint8_t *)tx_data, (uint8_t *)rx_data, 1U, 100U);
-    HAL_GPIO_WritePin(nss_port, nss_pin, GPIO_PIN_SET);
-
-    if (status != HAL_OK)
-    {
-        return EXIT_CODE_TIMEOUT;
-    }
-
-    return EXIT_CODE_OK;
+    Io_EfuseManager_EndTransaction(efuse_manager, is_successful);
+    is_transfer_busy = false;
 }
 
 struct Efuse_Context *Io_Efuse_Create(
@@ -167,15 +94,22 @@ struct Efuse_Context *Io_Efuse_Create(
     uint16_t                 channel_1_pin)
 {
     assert(spi_handle != NULL);
+    assert(spi_handle->hdmatx != NULL && spi_handle->hdmarx != NULL);
+    assert(efuse_spi_handle == NULL || efuse_spi_handle == spi_handle);
+    assert(num_efuses < MAX_NUM_EFUSES);
+
+    if (efuse_manager == NULL)
+    {
+        efuse_spi_handle = spi_handle;
+        efuse_manager    = Io_EfuseManager_Create(MAX_NUM_EFUSES);
+    }
 
     struct Efuse_Context *efuse_context = malloc(sizeof(struct Efuse_Context));
     assert(efuse_context != NULL);
 
     efuse_context->get_channel_0_current = get_channel_0_current;
     efuse_context->get_channel_1_current = get_channel_1_current;
-    efuse_context->spi_handle            = spi_handle;
-    efuse_context->nss_port              = nss_port;
-    efuse_context->nss_pin               = nss_pin;
+    efuse_context->index                 = num_efuses;
     efuse_context->fsob_port             = fsob_port;
     efuse_context->fsob_pin              = fsob_pin;
     efuse_context->fsb_port              = fsb_port;
@@ -186,7 +120,14 @@ struct Efuse_Context *Io_Efuse_Create(
     efuse_context->channel_0_pin         = channel_0_pin;
     efuse_context->channel_1_port        = channel_1_port;
     efuse_context->channel_1_pin         = channel_1_pin;
-    efuse_context->wdin_bit_to_set       = true;
+
+    nss_ports[num_efuses] = nss_port;
+    nss_pins[num_efuses]  = nss_pin;
+    num_efuses++;
+
+    // The status is read by every transaction
+    Io_EfuseManager_PollRegister(
+        efuse_manager, efuse_context->index, SO_STATR_ADDR);
 
     return efuse_context;
 }
@@ -219,11 +160,10 @@ ExitCode Io_Efuse_ConfigureChannelMonitoring(
     uint8_t                     monitoring_function,
     struct Efuse_Context *const efuse)
 {
-    uint16_t register_value;
-
-    // Read the original contents of the GCR Register
-    RETURN_CODE_IF_EXIT_NOT_OK(
-        Io_Efuse_ReadRegister(SI_GCR_ADDR, &register_value, efuse));
+    // Modify the shadow of the GCR Register, which is only sent to the efuse
+    // if the monitoring configuration changed
+    uint16_t register_value = Io_EfuseManager_GetWrittenRegister(
+        efuse_manager, efuse->index, SI_GCR_ADDR);
 
     // Clear the previous monitoring configuration
     CLEAR_BIT_UINT16(register_value, (CSNS1_EN_MASK | CSNS0_EN_MASK));
@@ -233,25 +173,19 @@ ExitCode Io_Efuse_ConfigureChannelMonitoring(
         register_value,
         (monitoring_function & (CSNS1_EN_MASK | CSNS0_EN_MASK)));
 
-    // Write back new monitoring configuration to the efuse
-    RETURN_CODE_IF_EXIT_NOT_OK(
-        Io_Efuse_WriteRegister(SI_GCR_ADDR, register_value, efuse));
-
-    return EXIT_CODE_OK;
+    return Io_Efuse_WriteRegister(SI_GCR_ADDR, register_value, efuse);
 }
 
 ExitCode Io_Efuse_ExitFailSafeMode(struct Efuse_Context *const efuse)
 {
-    // Set the WDIN bit (15th bit) to exit out of fail-safe mode. The parity bit
-    // (14th bit) will automatically be set in Io_Efuse_WriteRegister.
-    efuse->wdin_bit_to_set = true;
-
-    RETURN_CODE_IF_EXIT_NOT_OK(
-        Io_Efuse_WriteRegister(SI_STATR_0_ADDR, 0x0000, efuse));
+    // Set the WDIN bit (15th bit) of the next frame to exit out of fail-safe
+    // mode. The parity bit (14th bit) will automatically be set.
+    Io_EfuseManager_ResetWatchdogBit(efuse_manager, efuse->index);
 
     // Disable the watchdog timer
     RETURN_CODE_IF_EXIT_NOT_OK(
         Io_Efuse_WriteRegister(SI_GCR_ADDR, GCR_CONFIG, efuse));
+    RETURN_CODE_IF_EXIT_NOT_OK(Io_Efuse_TransferRegisters());
 
     // Check if the the efuse is still in fail-safe mode
     if (Io_Efuse_IsEfuseInFailSafeMode(efuse))
@@ -292,10 +226,12 @@ void Io_Efuse_DelatchFaults(const struct Efuse_Context *const efuse)
 
 float Io_Efuse_GetChannel0Current(struct Efuse_Context *const efuse)
 {
-    if (Io_Efuse_ConfigureChannelMonitoring(CSNS_FUNCTION_CURRENT_CH0, efuse) !=
-        EXIT_CODE_OK)
+    Io_Efuse_ConfigureChannelMonitoring(CSNS_FUNCTION_CURRENT_CH0, efuse);
+    if (Io_EfuseManager_IsRegisterPending(
+            efuse_manager, efuse->index, SI_GCR_ADDR))
     {
-        // Return NAN if selecting the current sense channel fails
+        // Return NAN until the current sense channel is selected by the next
+        // transfer
         return NAN;
     }
 
@@ -312,10 +248,12 @@ float Io_Efuse_GetChannel0Current(struct Efuse_Context *const efuse)
 
 float Io_Efuse_GetChannel1Current(struct Efuse_Context *const efuse)
 {
-    if (Io_Efuse_ConfigureChannelMonitoring(CSNS_FUNCTION_CURRENT_CH1, efuse) !=
-        EXIT_CODE_OK)
+    Io_Efuse_ConfigureChannelMonitoring(CSNS_FUNCTION_CURRENT_CH1, efuse);
+    if (Io_EfuseManager_IsRegisterPending(
+            efuse_manager, efuse->index, SI_GCR_ADDR))
     {
-        // Return NAN if selecting the current sense channel fails
+        // Return NAN until the current sense channel is selected by the next
+        // transfer
         return NAN;
     }
 
@@ -335,66 +273,120 @@ ExitCode Io_Efuse_WriteRegister(
     uint16_t                    register_value,
     struct Efuse_Context *const efuse)
 {
-    // Place the register address into bits 10->13
-    uint16_t tx_data =
-        (uint16_t)(((register_address & EFUSE_ADDR_MASK) << EFUSE_ADDR_SHIFT));
+    // The shadow is also modified when a transfer ends, from the SPI
+    // interrupts
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    Io_EfuseManager_WriteRegister(
+        efuse_manager, efuse->index, register_address, register_value);
+    __set_PRIMASK(primask);
 
-    // Place register value to be written into bits 0->8
-    tx_data = (uint16_t)(tx_data | (register_value & EFUSE_SI_DATA_MASK));
+    return EXIT_CODE_OK;
+}
 
-    // Invert watchdog bit state (Note: It is safe to do so even if the watchdog
-    // is disabled)
-    if (efuse->wdin_bit_to_set)
+ExitCode Io_Efuse_ReadRegister(
+    uint8_t                     register_address,
+    uint16_t *                  register_value,
+    struct Efuse_Context *const efuse)
+{
+    Io_EfuseManager_PollRegister(efuse_manager, efuse->index, register_address);
+
+    return Io_EfuseManager_ReadRegister(
+        efuse_manager, efuse->index, register_address, register_value);
+}
+
+void Io_Efuse_StartTransfer(void)
+{
+    if (efuse_manager == NULL || is_transfer_busy)
     {
-        SET_BIT_UINT16(tx_data, WATCHDOG_BIT);
+        return;
     }
-    else
+
+    // The shadows may be written from any task
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    num_efuse_frames = Io_EfuseManager_BeginTransaction(efuse_manager);
+    __set_PRIMASK(primask);
+
+    efuse_frames      = Io_EfuseManager_GetFrames(efuse_manager);
+    efuse_frame_index = 0U;
+
+    if (num_efuse_frames == 0U)
     {
-        CLEAR_BIT_UINT16(tx_data, WATCHDOG_BIT);
+        Io_EfuseManager_EndTransaction(efuse_manager, true);
+        return;
     }
 
-    // Invert watchdog bit state for next write
-    efuse->wdin_bit_to_set = !efuse->wdin_bit_to_set;
-    Io_Efuse_CalculateParityBit(&tx_data);
-
-    return Io_Efuse_WriteToEfuse(
-        &tx_data, efuse->spi_handle, efuse->nss_port, efuse->nss_pin);
+    is_transfer_busy = true;
+    if (!Io_Efuse_StartFrameTransfer())
+    {
+        Io_Efuse_EndTransfer(false);
+    }
 }
 
-ExitCode Io_Efuse_ReadRegister(
-    uint8_t                     register_address,
-    uint16_t *                  register_value,
-    struct Efuse_Context *const efuse)
+ExitCode Io_Efuse_TransferRegisters(void)
 {
-    // Place the Status Register address into bits 10->13
-    uint16_t tx_data =
-        (uint16_t)((SI_STATR_0_ADDR & EFUSE_ADDR_MASK) << EFUSE_ADDR_SHIFT);
-
-    // Shift bit 3 of the address (SOA3: the channel number) to the 13th bit
-    tx_data = (uint16_t)(
-        tx_data | ((register_address & SOA3_MASK) << EFUSE_ADDR_SHIFT) |
-        (register_address & (SOA2_MASK | SOA1_MASK | SOA0_MASK)));
-
-    // Invert watchdog bit state (Note: It is safe to do so even if the watchdog
-    // is disabled)
-    if (efuse->wdin_bit_to_set)
+    assert(efuse_manager != NULL);
+
+    if (is_transfer_busy)
+    {
+        return EXIT_CODE_TIMEOUT;
+    }
+
+    const size_t num_frames = Io_EfuseManager_BeginTransaction(efuse_manager);
+    struct EfuseFrame *const frames = Io_EfuseManager_GetFrames(efuse_manager);
+
+    HAL_StatusTypeDef status = HAL_OK;
+    for (size_t i = 0U; i < num_frames && status == HAL_OK; i++)
     {
-        SET_BIT_UINT16(tx_data, WATCHDOG_BIT);
+        HAL_GPIO_WritePin(
+            nss_ports[frames[i].efuse], nss_pins[frames[i].efuse],
+            GPIO_PIN_RESET);
+        status = HAL_SPI_TransmitReceive(
+            efuse_spi_handle, (uint8_t *)&frames[i].tx_data,
+            (uint8_t *)&frames[i].rx_data, 1U, SPI_TIMEOUT_MS);
+        HAL_GPIO_WritePin(
+            nss_ports[frames[i].efuse], nss_pins[frames[i].efuse],
+            GPIO_PIN_SET);
     }
-    else
+
+    Io_EfuseManager_EndTransaction(efuse_manager, status == HAL_OK);
+
+    return status == HAL_OK ? EXIT_CODE_OK : EXIT_CODE_TIMEOUT;
+}
+
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi != efuse_spi_handle || !is_transfer_busy)
     {
-        CLEAR_BIT_UINT16(tx_data, WATCHDOG_BIT);
+        return;
     }
 
-    // Invert watchdog bit state for next write
-    efuse->wdin_bit_to_set = !efuse->wdin_bit_to_set;
-    Io_Efuse_CalculateParityBit(&tx_data);
-    ExitCode exit_code = Io_Efuse_ReadFromEfuse(
-        &tx_data, register_value, efuse->spi_handle, efuse->nss_port,
-        efuse->nss_pin);
+    // The efuse only latches a frame on the rising edge of its chip select
+    const struct EfuseFrame *const frame = &efuse_frames[efuse_frame_index];
+    HAL_GPIO_WritePin(
+        nss_ports[frame->efuse], nss_pins[frame->efuse], GPIO_PIN_SET);
 
-    // Only return register contents and clear bits 9->15
-    *register_value = READ_BIT(*register_value, EFUSE_SO_DATA_MASK);
+    efuse_frame_index++;
+    if (efuse_frame_index == num_efuse_frames)
+    {
+        Io_Efuse_EndTransfer(true);
+    }
+    else if (!Io_Efuse_StartFrameTransfer())
+    {
+        Io_Efuse_EndTransfer(false);
+    }
+}
 
-    return exit_code;
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi != efuse_spi_handle || !is_transfer_busy)
+    {
+        return;
+    }
+
+    const struct EfuseFrame *const frame = &efuse_frames[efuse_frame_index];
+    HAL_GPIO_WritePin(
+        nss_ports[frame->efuse], nss_pins[frame->efuse], GPIO_PIN_SET);
+    Io_Efuse_EndTransfer(false);
 }
@@ -0,0 +1,379 @@
+#include <assert.h>
+#include <stdlib.h>
+#include "Io_EfuseManager.h"
+#include "configs/Io_EfuseConfig.h"
+
+struct EfuseRegisters
+{
+    // The shadows of the serial input registers, and a bit for each register
+    // that was written, that is yet to be sent, or that is being sent
+    uint16_t written_registers[EFUSE_NUM_REGISTERS];
+    uint16_t written_mask;
+    uint16_t pending_mask;
+    uint16_t in_flight_mask;
+
+    // The cache of the serial output registers, and a bit for each register
+    // that is read by every transaction, or that is cached
+    uint16_t read_registers[EFUSE_NUM_REGISTERS];
+    uint16_t polled_mask;
+    uint16_t read_mask;
+
+    // The serial output register the efuse clocks out during the next frame
+    uint8_t next_response_address;
+
+    // The state of the watchdog-in bit (bit 15) of the next frame. If the
+    // watchdog is enabled its state must be alternated at least once within
+    // the watchdog timeout period.
+    bool watchdog_bit;
+};
+
+struct EfuseManager
+{
+    size_t                 num_efuses;
+    struct EfuseRegisters *efuses;
+
+    struct EfuseFrame *frames;
+    size_t             num_frames;
+    bool               is_transaction_begun;
+};
+
+/**
+ * Calculate the parity bit that makes the number of set bits in the frame
+ * even, by XOR-folding the frame down to a nibble and looking up its parity
+ * @param frame: The frame without its parity bit
+ * @return true if the parity bit must be set, else false
+ */
+static bool Io_CalculateParityBit(uint16_t frame);
+
+/**
+ * Add a frame to the transaction, setting its watchdog-in and parity bits
+ * @param manager: The register cache of the efuses
+ * @param efuse: The index of the efuse the frame is sent to
+ * @param frame: The address and data bits of the frame
+ * @param response_address: The serial output register clocked out during
+ *                          the frame, or EFUSE_NO_REGISTER
+ */
+static void Io_AddFrame(
+    struct EfuseManager *manager,
+    size_t               efuse,
+    uint16_t             frame,
+    uint8_t              response_address);
+
+/**
+ * Get the frame that writes a serial input register
+ * @param register_address: The serial input register to write
+ * @param register_value: The value to write into the register
+ * @return The address and data bits of the frame
+ */
+static uint16_t
+    Io_GetWriteFrame(uint8_t register_address, uint16_t register_value);
+
+/**
+ * Get the STATR_s frame that selects the serial output register clocked out
+ * during the next frame
+ * @param register_address: The serial output register to select
+ * @return The address and data bits of the frame
+ */
+static uint16_t Io_GetReadFrame(uint8_t register_address);
+
+static bool Io_CalculateParityBit(const uint16_t frame)
+{
+    uint32_t folded_frame = frame;
+    folded_frame ^= folded_frame >> 8U;
+    folded_frame ^= folded_frame >> 4U;
+
+    // Bit n of 0x6996 is the parity of the nibble n
+    return ((0x6996U >> (folded_frame & 0xFU)) & 1U) != 0U;
+}
+
+static void Io_AddFrame(
+    struct EfuseManager *const manager,
+    const size_t               efuse,
+    uint16_t                   frame,
+    const uint8_t              response_address)
+{
+    assert(
+        manager->num_frames <
+        manager->num_efuses * EFUSE_MAX_NUM_FRAMES_PER_EFUSE);
+
+    struct EfuseRegisters *const registers = &manager->efuses[efuse];
+
+    // It is safe to alternate the watchdog-in bit even if the watchdog is
+    // disabled
+    if (registers->watchdog_bit)
+    {
+        SET_BIT_UINT16(frame, WATCHDOG_BIT);
+    }
+    registers->watchdog_bit = !registers->watchdog_bit;
+
+    if (Io_CalculateParityBit(frame))
+    {
+        SET_BIT_UINT16(frame, PARITY_BIT);
+    }
+
+    struct EfuseFrame *const efuse_frame =
+        &manager->frames[manager->num_frames++];
+    efuse_frame->efuse            = efuse;
+    efuse_frame->tx_data          = frame;
+    efuse_frame->rx_data          = 0U;
+    efuse_frame->response_address = response_address;
+}
+
+static uint16_t Io_GetWriteFrame(
+    const uint8_t  register_address,
+    const uint16_t register_value)
+{
+    // Place the register address into bits 10->13 and the register value into
+    // bits 0->8
+    return (uint16_t)(
+        ((register_address & EFUSE_ADDR_MASK) << EFUSE_ADDR_SHIFT) |
+        (register_value & EFUSE_SI_DATA_MASK));
+}
+
+static uint16_t Io_GetReadFrame(const uint8_t register_address)
+{
+    // Bit 3 of the address (SOA3: the channel number) selects between STATR_0
+    // and STATR_1, and bits 0->2 are the frame's data
+    return (uint16_t)(
+        (((SI_STATR_0_ADDR | (register_address & SOA3_MASK)) & EFUSE_ADDR_MASK)
+         << EFUSE_ADDR_SHIFT) |
+        (register_address & (SOA2_MASK | SOA1_MASK | SOA0_MASK)));
+}
+
+struct EfuseManager *Io_EfuseManager_Create(const size_t num_efuses)
+{
+    assert(num_efuses > 0U);
+
+    struct EfuseManager *const manager = malloc(sizeof(struct EfuseManager));
+    assert(manager != NULL);
+
+    manager->efuses = calloc(num_efuses, sizeof(struct EfuseRegisters));
+    assert(manager->efuses != NULL);
+
+    manager->frames = malloc(
+        num_efuses * EFUSE_MAX_NUM_FRAMES_PER_EFUSE *
+        sizeof(struct EfuseFrame));
+    assert(manager->frames != NULL);
+
+    manager->num_efuses           = num_efuses;
+    manager->num_frames           = 0U;
+    manager->is_transaction_begun = false;
+
+    for (size_t i = 0U; i < num_efuses; i++)
+    {
+        manager->efuses[i].next_response_address = EFUSE_NO_REGISTER;
+        manager->efuses[i].watchdog_bit          = true;
+    }
+
+    return manager;
+}
+
+void Io_EfuseManager_Destroy(struct EfuseManager *const manager)
+{
+    free(manager->frames);
+    free(manager->efuses);
+    free(manager);
+}
+
+void Io_EfuseManager_WriteRegister(
+    struct EfuseManager *const manager,
+    const size_t               efuse,
+    const uint8_t              register_address,
+    const uint16_t             register_value)
+{
+    assert(efuse < manager->num_efuses);
+    assert(register_address < EFUSE_NUM_REGISTERS);
+
+    // STATR_s frames select a serial output register rather than write one
+    assert(
+        register_address != SI_STATR_0_ADDR &&
+        register_address != SI_STATR_1_ADDR);
+
+    struct EfuseRegisters *const registers = &manager->efuses[efuse];
+    const uint16_t register_bit            = (uint16_t)(1U << register_address);
+    const uint16_t masked_value =
+        (uint16_t)(register_value & EFUSE_SI_DATA_MASK);
+
+    const bool is_unchanged =
+        (registers->written_mask & register_bit) != 0U &&
+        registers->written_registers[register_address] == masked_value;
+    if (is_unchanged)
+    {
+        return;
+    }
+
+    registers->written_registers[register_address] = masked_value;
+    SET_BIT_UINT16(registers->written_mask, register_bit);
+    SET_BIT_UINT16(registers->pending_mask, register_bit);
+}
+
+uint16_t Io_EfuseManager_GetWrittenRegister(
+    const struct EfuseManager *const manager,
+    const size_t                     efuse,
+    const uint8_t                    register_address)
+{
+    assert(efuse < manager->num_efuses);
+    assert(register_address < EFUSE_NUM_REGISTERS);
+
+    return manager->efuses[efuse].written_registers[register_address];
+}
+
+bool Io_EfuseManager_IsRegisterPending(
+    const struct EfuseManager *const manager,
+    const size_t                     efuse,
+    const uint8_t                    register_address)
+{
+    assert(efuse < manager->num_efuses);
+    assert(register_address < EFUSE_NUM_REGISTERS);
+
+    const struct EfuseRegisters *const registers = &manager->efuses[efuse];
+
+    return ((registers->pending_mask | registers->in_flight_mask) &
+            (1U << register_address)) != 0U;
+}
+
+void Io_EfuseManager_PollRegister(
+    struct EfuseManager *const manager,
+    const size_t               efuse,
+    const uint8_t              register_address)
+{
+    assert(efuse < manager->num_efuses);
+    assert(register_address < EFUSE_NUM_REGISTERS);
+
+    SET_BIT_UINT16(
+        manager->efuses[efuse].polled_mask, (1U << register_address));
+}
+
+ExitCode Io_EfuseManager_ReadRegister(
+    const struct EfuseManager *const manager,
+    const size_t                     efuse,
+    const uint8_t                    register_address,
+    uint16_t *const                  register_value)
+{
+    assert(efuse < manager->num_efuses);
+    assert(register_address < EFUSE_NUM_REGISTERS);
+
+    const struct EfuseRegisters *const registers = &manager->efuses[efuse];
+
+    if ((registers->read_mask & (1U << register_address)) == 0U)
+    {
+        return EXIT_CODE_TIMEOUT;
+    }
+
+    *register_value = registers->read_registers[register_address];
+
+    return EXIT_CODE_OK;
+}
+
+void Io_EfuseManager_ResetWatchdogBit(
+    struct EfuseManager *const manager,
+    const size_t               efuse)
+{
+    assert(efuse < manager->num_efuses);
+
+    manager->efuses[efuse].watchdog_bit = true;
+}
+
+size_t Io_EfuseManager_BeginTransaction(struct EfuseManager *const manager)
+{
+    assert(!manager->is_transaction_begun);
+
+    manager->num_frames           = 0U;
+    manager->is_transaction_begun = true;
+
+    for (size_t efuse = 0U; efuse < manager->num_efuses; efuse++)
+    {
+        struct EfuseRegisters *const registers = &manager->efuses[efuse];
+
+        // The first frame clocks out the register selected by the previous
+        // transaction, while a frame following a write clocks out a register
+        // that isn't tracked
+        uint8_t response_address = registers->next_response_address;
+
+        registers->in_flight_mask = registers->pending_mask;
+        registers->pending_mask   = 0U;
+
+        for (uint8_t address = 0U; address < EFUSE_NUM_REGISTERS; address++)
+        {
+            if (registers->in_flight_mask & (1U << address))
+            {
+                Io_AddFrame(
+                    manager, efuse,
+                    Io_GetWriteFrame(
+                        address, registers->written_registers[address]),
+                    response_address);
+                response_address = EFUSE_NO_REGISTER;
+            }
+        }
+
+        for (uint8_t address = 0U; address < EFUSE_NUM_REGISTERS; address++)
+        {
+            // STATR is already clocked out by the first frame if the previous
+            // transaction selected it
+            const bool is_read_by_first_frame =
+                address == SO_STATR_ADDR &&
+                registers->next_response_address == SO_STATR_ADDR;
+
+            if ((registers->polled_mask & (1U << address)) &&
+                !is_read_by_first_frame)
+            {
+                Io_AddFrame(
+                    manager, efuse, Io_GetReadFrame(address), response_address);
+                response_address = address;
+            }
+        }
+
+        // Clock out the last register read, and select STATR for the first
+        // frame of the next transaction
+        if (registers->in_flight_mask != 0U || registers->polled_mask != 0U)
+        {
+            Io_AddFrame(
+                manager, efuse, Io_GetReadFrame(SO_STATR_ADDR),
+                response_address);
+            registers->next_response_address = SO_STATR_ADDR;
+        }
+    }
+
+    return manager->num_frames;
+}
+
+struct EfuseFrame *Io_EfuseManager_GetFrames(struct EfuseManager *const manager)
+{
+    return manager->frames;
+}
+
+void Io_EfuseManager_EndTransaction(
+    struct EfuseManager *const manager,
+    const bool                 is_successful)
+{
+    assert(manager->is_transaction_begun);
+
+    for (size_t i = 0U; i < manager->num_frames && is_successful; i++)
+    {
+        const struct EfuseFrame *const frame = &manager->frames[i];
+        if (frame->response_address != EFUSE_NO_REGISTER)
+        {
+            struct EfuseRegisters *const registers =
+                &manager->efuses[frame->efuse];
+            registers->read_registers[frame->response_address] =
+                (uint16_t)(frame->rx_data & EFUSE_SO_DATA_MASK);
+            SET_BIT_UINT16(
+                registers->read_mask, (1U << frame->response_address));
+        }
+    }
+
+    for (size_t efuse = 0U; efuse < manager->num_efuses; efuse++)
+    {
+        struct EfuseRegisters *const registers = &manager->efuses[efuse];
+        if (!is_successful)
+        {
+            SET_BIT_UINT16(registers->pending_mask, registers->in_flight_mask);
+            registers->read_mask             = 0U;
+            registers->next_response_address = EFUSE_NO_REGISTER;
+        }
+        registers->in_flight_mask = 0U;
+    }
+
+    manager->num_frames           = 0U;
+    manager->is_transaction_begun = false;
+}
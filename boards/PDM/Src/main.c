@@ -30,23 +30,30 @@
 #include "Io_CanRx.h"
 #include "Io_SharedSoftwareWatchdog.h"
 #include "Io_SharedCan.h"
+#include "Io_SharedCycleCounter.h"
 #include "Io_SharedHardFaultHandler.h"
 #include "Io_StackWaterMark.h"
 #include "Io_SoftwareWatchdog.h"
 #include "Io_VoltageSense.h"
 #include "Io_CurrentSense.h"
+#include "Io_Adc.h"
 #include "Io_HeartbeatMonitor.h"
 #include "Io_RgbLedSequence.h"
 #include "Io_LT3650.h"
 #include "Io_LTC3786.h"
+#include "Io_Efuse.h"
+#include "Io_Aux1Aux2Efuse.h"
 
 #include "App_PdmWorld.h"
 #include "App_SharedConstants.h"
+#include "App_SharedMacros.h"
 #include "App_SharedStateMachine.h"
 #include "states/App_InitState.h"
 #include "configs/App_CurrentLimits.h"
 #include "configs/App_VoltageLimits.h"
 #include "configs/App_HeartbeatMonitorConfig.h"
+#include "configs/App_PowerSequenceConfig.h"
+#include "configs/App_ThermalFuseConfig.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -73,6 +80,8 @@ IWDG_HandleTypeDef hiwdg;
 
 SPI_HandleTypeDef hspi2;
 
+TIM_HandleTypeDef htim2;
+
 osThreadId          Task1HzHandle;
 uint32_t            Task1HzBuffer[TASK1HZ_STACK_SIZE];
 osStaticThreadDef_t Task1HzControlBlock;
@@ -106,7 +115,68 @@ struct InRangeCheck *     air_shutdown_current_in_range_check;
 struct HeartbeatMonitor * heartbeat_monitor;
 struct RgbLedSequence *   rgb_led_sequence;
 struct LowVoltageBattery *low_voltage_battery;
+struct PowerSequencer *   power_sequencer;
+struct ThermalFuses *     thermal_fuses;
 struct Clock *            clock;
+
+// The loads are powered up as soon as their dependencies are ready and their
+// inrush current fits in the current budget. The power sequencer is the only
+// owner of the outputs, and disables a channel when its thermal fuse trips.
+static const struct PowerSequenceStep power_sequence[] = {
+    [THERMAL_FUSE_AUX1] =
+        {
+            .enable             = Io_Aux1Aux2Efuse_EnableAux1,
+            .disable            = Io_Aux1Aux2Efuse_DisableAux1,
+            .get_current        = Io_CurrentSense_GetAux1Current,
+            .dependency         = POWER_SEQUENCE_NO_DEPENDENCY,
+            .max_inrush_current = AUX1_MAX_INRUSH_CURRENT,
+            .settled_current    = AUX1_MAX_CURRENT,
+            .settle_time_ms     = POWER_SEQUENCE_SETTLE_TIME_MS,
+            .timeout_ms         = POWER_SEQUENCE_TIMEOUT_MS,
+        },
+    [THERMAL_FUSE_AUX2] =
+        {
+            .enable             = Io_Aux1Aux2Efuse_EnableAux2,
+            .disable            = Io_Aux1Aux2Efuse_DisableAux2,
+            .get_current        = Io_CurrentSense_GetAux2Current,
+            .dependency         = POWER_SEQUENCE_NO_DEPENDENCY,
+            .max_inrush_current = AUX2_MAX_INRUSH_CURRENT,
+            .settled_current    = AUX2_MAX_CURRENT,
+            .settle_time_ms     = POWER_SEQUENCE_SETTLE_TIME_MS,
+            .timeout_ms         = POWER_SEQUENCE_TIMEOUT_MS,
+        },
+};
+
+// The sampled currents are passed straight on to the thermal fuses, so their
+// channels must be in the same order
+static_assert(
+    (size_t)SAMPLED_CURRENT_AUX1 == (size_t)THERMAL_FUSE_AUX1 &&
+        (size_t)SAMPLED_CURRENT_AUX2 == (size_t)THERMAL_FUSE_AUX2 &&
+        (size_t)NUM_SAMPLED_CURRENTS == (size_t)NUM_THERMAL_FUSE_CHANNELS,
+    "The sampled currents must match the thermal fuse channels");
+static_assert(
+    NUM_ELEMENTS_IN_ARRAY(power_sequence) == NUM_THERMAL_FUSE_CHANNELS,
+    "Every thermal fuse channel must have a step in the power sequence");
+
+static const struct ThermalFuseConfig
+    thermal_fuse_configs[NUM_THERMAL_FUSE_CHANNELS] = {
+        [THERMAL_FUSE_AUX1] =
+            {
+                .rated_current   = AUX1_MAX_CURRENT,
+                .i2t_rating      = AUX1_I2T_RATING,
+                .soft_trip_load  = THERMAL_FUSE_SOFT_TRIP_LOAD,
+                .retry_load      = THERMAL_FUSE_RETRY_LOAD,
+                .max_num_retries = THERMAL_FUSE_MAX_NUM_RETRIES,
+            },
+        [THERMAL_FUSE_AUX2] =
+            {
+                .rated_current   = AUX2_MAX_CURRENT,
+                .i2t_rating      = AUX2_I2T_RATING,
+                .soft_trip_load  = THERMAL_FUSE_SOFT_TRIP_LOAD,
+                .retry_load      = THERMAL_FUSE_RETRY_LOAD,
+                .max_num_retries = THERMAL_FUSE_MAX_NUM_RETRIES,
+            },
+    };
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -116,6 +186,7 @@ static void MX_CAN_Init(void);
 static void MX_SPI2_Init(void);
 static void MX_ADC1_Init(void);
 static void MX_IWDG_Init(void);
+static void MX_TIM2_Init(void);
 void        RunTask1Hz(void const *argument);
 void        RunTask1kHz(void const *argument);
 void        RunTaskCanRx(void const *argument);
@@ -126,6 +197,7 @@ void        RunTask100Hz(void const *argument);
 
 static void CanRxQueueOverflowCallBack(size_t overflow_count);
 static void CanTxQueueOverflowCallBack(size_t overflow_count);
+static void SampledCurrentsCallback(const float *currents, size_t num_samples);
 
 /* USER CODE END PFP */
 
@@ -142,6 +214,11 @@ static void CanTxQueueOverflowCallBack(size_t overflow_count)
     App_CanTx_SetPeriodicSignal_TX_OVERFLOW_COUNT(can_tx, overflow_count);
 }
 
+static void SampledCurrentsCallback(const float *currents, size_t num_samples)
+{
+    App_ThermalFuses_ProcessSamples(thermal_fuses, currents, num_samples);
+}
+
 /* USER CODE END 0 */
 
 /**
@@ -178,6 +255,7 @@ int main(void)
     MX_SPI2_Init();
     MX_ADC1_Init();
     MX_IWDG_Init();
+    MX_TIM2_Init();
     /* USER CODE BEGIN 2 */
     __HAL_DBGMCU_FREEZE_IWDG();
     Io_SharedHardFaultHandler_Init();
@@ -235,6 +313,22 @@ int main(void)
     low_voltage_battery =
         App_LowVoltageBattery_Create(Io_LT3650_HasFault, Io_LTC3786_HasFault);
 
+    Io_Aux1Aux2Efuse_Init(&hspi2);
+    Io_Aux1Aux2Efuse_ConfigureEfuse();
+
+    power_sequencer = App_PowerSequencer_Create(
+        power_sequence, NUM_ELEMENTS_IN_ARRAY(power_sequence),
+        POWER_SEQUENCE_CURRENT_BUDGET);
+
+    // Every current sample is integrated into the thermal fuses as soon as
+    // the ADC's trigger is started
+    thermal_fuses = App_ThermalFuses_Create(
+        thermal_fuse_configs, NUM_THERMAL_FUSE_CHANNELS,
+        1.0f / ADC_TRIGGER_FREQUENCY);
+    Io_CurrentSense_SetSampledCurrentsCallback(SampledCurrentsCallback);
+    Io_Adc_Init(&hadc1);
+    HAL_TIM_Base_Start(&htim2);
+
     clock = App_SharedClock_Create();
 
     world = App_PdmWorld_Create(
@@ -245,9 +339,13 @@ int main(void)
         right_inverter_current_in_range_check,
         energy_meter_current_in_range_check, can_current_in_range_check,
         air_shutdown_current_in_range_check, heartbeat_monitor,
-        rgb_led_sequence, low_voltage_battery, clock);
+        rgb_led_sequence, low_voltage_battery, power_sequencer, thermal_fuses,
+        clock);
 
     state_machine = App_SharedStateMachine_Create(world, App_GetInitState());
+    Io_SharedCycleCounter_Init();
+    App_SharedStateMachine_SetCycleCounter(
+        state_machine, Io_SharedCycleCounter_GetCycleCount);
 
     Io_SoftwareWatchdog_Init(can_tx);
     Io_StackWaterMark_Init(can_tx);
@@ -396,15 +494,15 @@ static void MX_ADC1_Init(void)
     hadc1.Instance                   = ADC1;
     hadc1.Init.ClockPrescaler        = ADC_CLOCK_ASYNC_DIV1;
     hadc1.Init.Resolution            = ADC_RESOLUTION_12B;
-    hadc1.Init.ScanConvMode          = ADC_SCAN_DISABLE;
+    hadc1.Init.ScanConvMode          = ADC_SCAN_ENABLE;
     hadc1.Init.ContinuousConvMode    = DISABLE;
     hadc1.Init.DiscontinuousConvMode = DISABLE;
-    hadc1.Init.ExternalTrigConvEdge  = ADC_EXTERNALTRIGCONVEDGE_NONE;
-    hadc1.Init.ExternalTrigConv      = ADC_SOFTWARE_START;
+    hadc1.Init.ExternalTrigConvEdge  = ADC_EXTERNALTRIGCONVEDGE_RISING;
+    hadc1.Init.ExternalTrigConv      = ADC_EXTERNALTRIGCONV_T2_TRGO;
     hadc1.Init.DataAlign             = ADC_DATAALIGN_RIGHT;
-    hadc1.Init.NbrOfConversion       = 1;
-    hadc1.Init.DMAContinuousRequests = DISABLE;
-    hadc1.Init.EOCSelection          = ADC_EOC_SINGLE_CONV;
+    hadc1.Init.NbrOfConversion       = 7;
+    hadc1.Init.DMAContinuousRequests = ENABLE;
+    hadc1.Init.EOCSelection          = ADC_EOC_SEQ_CONV;
     hadc1.Init.LowPowerAutoWait      = DISABLE;
     hadc1.Init.Overrun               = ADC_OVR_DATA_OVERWRITTEN;
     if (HAL_ADC_Init(&hadc1) != HAL_OK)
@@ -423,13 +521,61 @@ static void MX_ADC1_Init(void)
     sConfig.Channel      = ADC_CHANNEL_1;
     sConfig.Rank         = ADC_REGULAR_RANK_1;
     sConfig.SingleDiff   = ADC_SINGLE_ENDED;
-    sConfig.SamplingTime = ADC_SAMPLETIME_1CYCLE_5;
+    sConfig.SamplingTime = ADC_SAMPLETIME_61CYCLES_5;
     sConfig.OffsetNumber = ADC_OFFSET_NONE;
     sConfig.Offset       = 0;
     if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) != HAL_OK)
     {
         Error_Handler();
     }
+    /** Configure Regular Channel
+     */
+    sConfig.Channel = ADC_CHANNEL_2;
+    sConfig.Rank    = ADC_REGULAR_RANK_2;
+    if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    /** Configure Regular Channel
+     */
+    sConfig.Channel = ADC_CHANNEL_3;
+    sConfig.Rank    = ADC_REGULAR_RANK_3;
+    if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    /** Configure Regular Channel
+     */
+    sConfig.Channel = ADC_CHANNEL_6;
+    sConfig.Rank    = ADC_REGULAR_RANK_4;
+    if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    /** Configure Regular Channel
+     */
+    sConfig.Channel = ADC_CHANNEL_7;
+    sConfig.Rank    = ADC_REGULAR_RANK_5;
+    if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    /** Configure Regular Channel
+     */
+    sConfig.Channel = ADC_CHANNEL_8;
+    sConfig.Rank    = ADC_REGULAR_RANK_6;
+    if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    /** Configure Regular Channel
+     */
+    sConfig.Channel = ADC_CHANNEL_9;
+    sConfig.Rank    = ADC_REGULAR_RANK_7;
+    if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) != HAL_OK)
+    {
+        Error_Handler();
+    }
     /* USER CODE BEGIN ADC1_Init 2 */
 
     /* USER CODE END ADC1_Init 2 */
@@ -517,11 +663,11 @@ static void MX_SPI2_Init(void)
     hspi2.Instance               = SPI2;
     hspi2.Init.Mode              = SPI_MODE_MASTER;
     hspi2.Init.Direction         = SPI_DIRECTION_2LINES;
-    hspi2.Init.DataSize          = SPI_DATASIZE_4BIT;
+    hspi2.Init.DataSize          = SPI_DATASIZE_16BIT;
     hspi2.Init.CLKPolarity       = SPI_POLARITY_LOW;
-    hspi2.Init.CLKPhase          = SPI_PHASE_1EDGE;
+    hspi2.Init.CLKPhase          = SPI_PHASE_2EDGE;
     hspi2.Init.NSS               = SPI_NSS_SOFT;
-    hspi2.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_2;
+    hspi2.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_8;
     hspi2.Init.FirstBit          = SPI_FIRSTBIT_MSB;
     hspi2.Init.TIMode            = SPI_TIMODE_DISABLE;
     hspi2.Init.CRCCalculation    = SPI_CRCCALCULATION_DISABLE;
@@ -537,6 +683,50 @@ static void MX_SPI2_Init(void)
     /* USER CODE END SPI2_Init 2 */
 }
 
+/**
+ * @brief TIM2 Initialization Function
+ * @param None
+ * @retval None
+ */
+static void MX_TIM2_Init(void)
+{
+    /* USER CODE BEGIN TIM2_Init 0 */
+
+    /* USER CODE END TIM2_Init 0 */
+
+    TIM_ClockConfigTypeDef  sClockSourceConfig = { 0 };
+    TIM_MasterConfigTypeDef sMasterConfig      = { 0 };
+
+    /* USER CODE BEGIN TIM2_Init 1 */
+
+    /* USER CODE END TIM2_Init 1 */
+    htim2.Instance         = TIM2;
+    htim2.Init.Prescaler   = TIM2_PRESCALER - 1;
+    htim2.Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim2.Init.Period =
+        (TIMx_FREQUENCY / TIM2_PRESCALER) / ADC_TRIGGER_FREQUENCY - 1;
+    htim2.Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
+    htim2.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+    if (HAL_TIM_Base_Init(&htim2) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    sClockSourceConfig.ClockSource = TIM_CLOCKSOURCE_INTERNAL;
+    if (HAL_TIM_ConfigClockSource(&htim2, &sClockSourceConfig) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    sMasterConfig.MasterOutputTrigger = TIM_TRGO_UPDATE;
+    sMasterConfig.MasterSlaveMode     = TIM_MASTERSLAVEMODE_DISABLE;
+    if (HAL_TIMEx_MasterConfigSynchronization(&htim2, &sMasterConfig) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    /* USER CODE BEGIN TIM2_Init 2 */
+
+    /* USER CODE END TIM2_Init 2 */
+}
+
 /**
  * @brief GPIO Initialization Function
  * @param None
@@ -806,6 +996,7 @@ void RunTask100Hz(void const *argument)
     for (;;)
     {
         App_SharedStateMachine_Tick100Hz(state_machine);
+        Io_Efuse_StartTransfer();
 
         // Watchdog check-in must be the last function called before putting the
         // task to sleep.
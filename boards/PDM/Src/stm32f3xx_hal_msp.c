@@ -42,7 +42,9 @@
 
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN PV */
-
+DMA_HandleTypeDef hdma_adc1;
+DMA_HandleTypeDef hdma_spi2_rx;
+DMA_HandleTypeDef hdma_spi2_tx;
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -120,7 +122,26 @@ void HAL_ADC_MspInit(ADC_HandleTypeDef *hadc)
         HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
 
         /* USER CODE BEGIN ADC1_MspInit 1 */
-
+        __HAL_RCC_DMA1_CLK_ENABLE();
+
+        // The DMA writes the conversion sets into a double buffer, and
+        // interrupts once each half of it is full
+        hdma_adc1.Instance                 = DMA1_Channel1;
+        hdma_adc1.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+        hdma_adc1.Init.PeriphInc           = DMA_PINC_DISABLE;
+        hdma_adc1.Init.MemInc              = DMA_MINC_ENABLE;
+        hdma_adc1.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+        hdma_adc1.Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+        hdma_adc1.Init.Mode                = DMA_CIRCULAR;
+        hdma_adc1.Init.Priority            = DMA_PRIORITY_LOW;
+        if (HAL_DMA_Init(&hdma_adc1) != HAL_OK)
+        {
+            Error_Handler();
+        }
+        __HAL_LINKDMA(hadc, DMA_Handle, hdma_adc1);
+
+        HAL_NVIC_SetPriority(DMA1_Channel1_IRQn, 5, 0);
+        HAL_NVIC_EnableIRQ(DMA1_Channel1_IRQn);
         /* USER CODE END ADC1_MspInit 1 */
     }
 }
@@ -159,7 +180,8 @@ void HAL_ADC_MspDeInit(ADC_HandleTypeDef *hadc)
             VBAT_SENSE_Pin | _24V_ACC_SENSE_Pin | _24V_BOOST_OUT_SENSE_Pin);
 
         /* USER CODE BEGIN ADC1_MspDeInit 1 */
-
+        HAL_DMA_DeInit(hadc->DMA_Handle);
+        HAL_NVIC_DisableIRQ(DMA1_Channel1_IRQn);
         /* USER CODE END ADC1_MspDeInit 1 */
     }
 }
@@ -269,7 +291,42 @@ void HAL_SPI_MspInit(SPI_HandleTypeDef *hspi)
         HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
 
         /* USER CODE BEGIN SPI2_MspInit 1 */
-
+        __HAL_RCC_DMA1_CLK_ENABLE();
+
+        hdma_spi2_rx.Instance                 = DMA1_Channel4;
+        hdma_spi2_rx.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+        hdma_spi2_rx.Init.PeriphInc           = DMA_PINC_DISABLE;
+        hdma_spi2_rx.Init.MemInc              = DMA_MINC_ENABLE;
+        hdma_spi2_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+        hdma_spi2_rx.Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+        hdma_spi2_rx.Init.Mode                = DMA_NORMAL;
+        hdma_spi2_rx.Init.Priority            = DMA_PRIORITY_LOW;
+        if (HAL_DMA_Init(&hdma_spi2_rx) != HAL_OK)
+        {
+            Error_Handler();
+        }
+        __HAL_LINKDMA(hspi, hdmarx, hdma_spi2_rx);
+
+        hdma_spi2_tx.Instance                 = DMA1_Channel5;
+        hdma_spi2_tx.Init.Direction           = DMA_MEMORY_TO_PERIPH;
+        hdma_spi2_tx.Init.PeriphInc           = DMA_PINC_DISABLE;
+        hdma_spi2_tx.Init.MemInc              = DMA_MINC_ENABLE;
+        hdma_spi2_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+        hdma_spi2_tx.Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+        hdma_spi2_tx.Init.Mode                = DMA_NORMAL;
+        hdma_spi2_tx.Init.Priority            = DMA_PRIORITY_LOW;
+        if (HAL_DMA_Init(&hdma_spi2_tx) != HAL_OK)
+        {
+            Error_Handler();
+        }
+        __HAL_LINKDMA(hspi, hdmatx, hdma_spi2_tx);
+
+        HAL_NVIC_SetPriority(DMA1_Channel4_IRQn, 5, 0);
+        HAL_NVIC_EnableIRQ(DMA1_Channel4_IRQn);
+        HAL_NVIC_SetPriority(DMA1_Channel5_IRQn, 5, 0);
+        HAL_NVIC_EnableIRQ(DMA1_Channel5_IRQn);
+        HAL_NVIC_SetPriority(SPI2_IRQn, 5, 0);
+        HAL_NVIC_EnableIRQ(SPI2_IRQn);
         /* USER CODE END SPI2_MspInit 1 */
     }
 }
@@ -303,6 +360,48 @@ void HAL_SPI_MspDeInit(SPI_HandleTypeDef *hspi)
     }
 }
 
+/**
+ * @brief TIM_Base MSP Initialization
+ * This function configures the hardware resources used in this example
+ * @param htim_base: TIM_Base handle pointer
+ * @retval None
+ */
+void HAL_TIM_Base_MspInit(TIM_HandleTypeDef *htim_base)
+{
+    if (htim_base->Instance == TIM2)
+    {
+        /* USER CODE BEGIN TIM2_MspInit 0 */
+
+        /* USER CODE END TIM2_MspInit 0 */
+        /* Peripheral clock enable */
+        __HAL_RCC_TIM2_CLK_ENABLE();
+        /* USER CODE BEGIN TIM2_MspInit 1 */
+
+        /* USER CODE END TIM2_MspInit 1 */
+    }
+}
+
+/**
+ * @brief TIM_Base MSP De-Initialization
+ * This function freeze the hardware resources used in this example
+ * @param htim_base: TIM_Base handle pointer
+ * @retval None
+ */
+void HAL_TIM_Base_MspDeInit(TIM_HandleTypeDef *htim_base)
+{
+    if (htim_base->Instance == TIM2)
+    {
+        /* USER CODE BEGIN TIM2_MspDeInit 0 */
+
+        /* USER CODE END TIM2_MspDeInit 0 */
+        /* Peripheral clock disable */
+        __HAL_RCC_TIM2_CLK_DISABLE();
+        /* USER CODE BEGIN TIM2_MspDeInit 1 */
+
+        /* USER CODE END TIM2_MspDeInit 1 */
+    }
+}
+
 /* USER CODE BEGIN 1 */
 
 /* USER CODE END 1 */
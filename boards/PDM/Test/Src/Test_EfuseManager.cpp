@@ -0,0 +1,360 @@
+#include <array>
+#include <vector>
+#include "Test_Pdm.h"
+
+extern "C"
+{
+#include "Io_EfuseManager.h"
+#include "configs/Io_EfuseConfig.h"
+}
+
+namespace EfuseManagerTest
+{
+// The SPI bus runs at 4.5 MHz, and every frame is followed by its chip select
+// being raised and the next frame's DMA transfer being started
+static constexpr float    SPI_BIT_RATE_HZ        = 4.5e6f;
+static constexpr float    CHIP_SELECT_OVERHEAD_S = 2e-6f;
+static constexpr float    SPI_FRAME_DURATION_S   = 16.0f / SPI_BIT_RATE_HZ;
+static constexpr uint16_t NORMAL_MODE_BIT        = 1U << 9U;
+static constexpr size_t   NUM_EFUSES             = 4U;
+static constexpr size_t   LEGACY_FRAMES_PER_READ = 2U;
+
+// The serial registers of a 22XS4200, exchanging one frame at a time
+class FakeEfuse
+{
+  public:
+    FakeEfuse()
+    {
+        input_registers.fill(0U);
+        output_registers.fill(0U);
+        num_writes.fill(0U);
+    }
+
+    uint16_t Exchange(uint16_t frame)
+    {
+        num_frames++;
+
+        // The efuse ignores a frame with odd parity
+        if (__builtin_popcount(frame) % 2 != 0)
+        {
+            num_parity_errors++;
+            return 0U;
+        }
+
+        const bool watchdog_bit = (frame & WATCHDOG_BIT) != 0U;
+        if (num_frames > 1U && watchdog_bit == previous_watchdog_bit)
+        {
+            num_watchdog_errors++;
+        }
+        previous_watchdog_bit = watchdog_bit;
+
+        // The register selected by the previous STATR_s frame is clocked out
+        const uint16_t response =
+            (uint16_t)(output_registers[selected_address] | NORMAL_MODE_BIT);
+
+        const uint8_t address = (frame >> EFUSE_ADDR_SHIFT) & EFUSE_ADDR_MASK;
+        if ((address & ~SOA3_MASK) == SI_STATR_0_ADDR)
+        {
+            selected_address = (uint8_t)(
+                (address & SOA3_MASK) |
+                (frame & (SOA2_MASK | SOA1_MASK | SOA0_MASK)));
+        }
+        else
+        {
+            input_registers[address] = frame & EFUSE_SI_DATA_MASK;
+            num_writes[address]++;
+            selected_address = SO_STATR_ADDR;
+        }
+
+        return response;
+    }
+
+    std::array<uint16_t, EFUSE_NUM_REGISTERS> input_registers;
+    std::array<uint16_t, EFUSE_NUM_REGISTERS> output_registers;
+    std::array<size_t, EFUSE_NUM_REGISTERS>   num_writes;
+    size_t                                    num_frames          = 0U;
+    size_t                                    num_parity_errors   = 0U;
+    size_t                                    num_watchdog_errors = 0U;
+
+  private:
+    uint8_t selected_address      = SO_STATR_ADDR;
+    bool    previous_watchdog_bit = false;
+};
+
+class EfuseManagerTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        manager = Io_EfuseManager_Create(NUM_EFUSES);
+        efuses.assign(NUM_EFUSES, FakeEfuse());
+    }
+
+    void TearDown() override
+    {
+        TearDownObject(manager, Io_EfuseManager_Destroy);
+    }
+
+    // Exchange the frames of a transaction, failing it after the given number
+    // of frames, and return the time the SPI bus was busy
+    float RunTransaction(size_t num_frames_until_failure = SIZE_MAX)
+    {
+        const size_t num_frames = Io_EfuseManager_BeginTransaction(manager);
+        struct EfuseFrame *const frames = Io_EfuseManager_GetFrames(manager);
+
+        float  spi_time = 0.0f;
+        size_t i        = 0U;
+        for (; i < num_frames && i < num_frames_until_failure; i++)
+        {
+            frames[i].rx_data =
+                efuses[frames[i].efuse].Exchange(frames[i].tx_data);
+            spi_time += SPI_FRAME_DURATION_S + CHIP_SELECT_OVERHEAD_S;
+        }
+
+        last_num_frames = num_frames;
+        Io_EfuseManager_EndTransaction(manager, i == num_frames);
+
+        return spi_time;
+    }
+
+    void PollStatusAndFaults(size_t efuse)
+    {
+        Io_EfuseManager_PollRegister(manager, efuse, SO_STATR_ADDR);
+        Io_EfuseManager_PollRegister(manager, efuse, SO_FAULTR_0_ADDR);
+        Io_EfuseManager_PollRegister(manager, efuse, SO_FAULTR_1_ADDR);
+    }
+
+    uint16_t ReadRegister(size_t efuse, uint8_t register_address)
+    {
+        uint16_t register_value = 0U;
+        EXPECT_EQ(
+            EXIT_CODE_OK,
+            Io_EfuseManager_ReadRegister(
+                manager, efuse, register_address, &register_value));
+        return register_value;
+    }
+
+    struct EfuseManager *  manager;
+    std::vector<FakeEfuse> efuses;
+    size_t                 last_num_frames = 0U;
+};
+
+TEST_F(EfuseManagerTest, first_transaction_writes_and_reads_registers)
+{
+    Io_EfuseManager_WriteRegister(manager, 0U, SI_GCR_ADDR, GCR_CONFIG);
+    Io_EfuseManager_WriteRegister(manager, 0U, SI_CONFR_0_ADDR, CONFR_CONFIG);
+    Io_EfuseManager_PollRegister(manager, 0U, SO_STATR_ADDR);
+    Io_EfuseManager_PollRegister(manager, 0U, SO_FAULTR_0_ADDR);
+    efuses[0].output_registers[SO_STATR_ADDR]    = SO_POR_MASK;
+    efuses[0].output_registers[SO_FAULTR_0_ADDR] = SO_OC_S_MASK;
+
+    uint16_t register_value;
+    ASSERT_EQ(
+        EXIT_CODE_TIMEOUT, Io_EfuseManager_ReadRegister(
+                               manager, 0U, SO_STATR_ADDR, &register_value));
+
+    RunTransaction();
+
+    // Two writes, two reads, and the frame clocking out the last read
+    ASSERT_EQ(5U, last_num_frames);
+    ASSERT_EQ(GCR_CONFIG, efuses[0].input_registers[SI_GCR_ADDR]);
+    ASSERT_EQ(CONFR_CONFIG, efuses[0].input_registers[SI_CONFR_0_ADDR]);
+    ASSERT_FALSE(Io_EfuseManager_IsRegisterPending(manager, 0U, SI_GCR_ADDR));
+
+    // The normal-mode status bit is not part of the register
+    ASSERT_EQ(SO_POR_MASK, ReadRegister(0U, SO_STATR_ADDR));
+    ASSERT_EQ(SO_OC_S_MASK, ReadRegister(0U, SO_FAULTR_0_ADDR));
+
+    // The other efuses have nothing to transfer
+    for (size_t efuse = 1U; efuse < NUM_EFUSES; efuse++)
+    {
+        ASSERT_EQ(0U, efuses[efuse].num_frames);
+    }
+}
+
+TEST_F(EfuseManagerTest, unchanged_register_is_not_sent_again)
+{
+    Io_EfuseManager_WriteRegister(manager, 0U, SI_GCR_ADDR, GCR_CONFIG);
+    RunTransaction();
+
+    Io_EfuseManager_WriteRegister(manager, 0U, SI_GCR_ADDR, GCR_CONFIG);
+    ASSERT_FALSE(Io_EfuseManager_IsRegisterPending(manager, 0U, SI_GCR_ADDR));
+    RunTransaction();
+    ASSERT_EQ(0U, last_num_frames);
+    ASSERT_EQ(1U, efuses[0].num_writes[SI_GCR_ADDR]);
+
+    Io_EfuseManager_WriteRegister(
+        manager, 0U, SI_GCR_ADDR, GCR_CONFIG | CSNS_FUNCTION_CURRENT_CH0);
+    ASSERT_TRUE(Io_EfuseManager_IsRegisterPending(manager, 0U, SI_GCR_ADDR));
+    RunTransaction();
+    ASSERT_EQ(2U, efuses[0].num_writes[SI_GCR_ADDR]);
+    ASSERT_EQ(
+        GCR_CONFIG | CSNS_FUNCTION_CURRENT_CH0,
+        efuses[0].input_registers[SI_GCR_ADDR]);
+}
+
+TEST_F(EfuseManagerTest, reads_of_every_efuse_are_pipelined)
+{
+    for (size_t efuse = 0U; efuse < NUM_EFUSES; efuse++)
+    {
+        PollStatusAndFaults(efuse);
+    }
+    RunTransaction();
+
+    for (uint16_t tick = 0U; tick < 10U; tick++)
+    {
+        for (size_t efuse = 0U; efuse < NUM_EFUSES; efuse++)
+        {
+            efuses[efuse].output_registers[SO_STATR_ADDR] =
+                (uint16_t)(tick + efuse);
+            efuses[efuse].output_registers[SO_FAULTR_0_ADDR] =
+                (uint16_t)(0x10U + tick + efuse);
+            efuses[efuse].output_registers[SO_FAULTR_1_ADDR] =
+                (uint16_t)(0x100U + tick + efuse);
+        }
+
+        RunTransaction();
+
+        // STATR is clocked out by the first frame, having been selected by
+        // the previous transaction, so each efuse takes one frame per read
+        ASSERT_EQ(3U * NUM_EFUSES, last_num_frames);
+        for (size_t efuse = 0U; efuse < NUM_EFUSES; efuse++)
+        {
+            ASSERT_EQ(tick + efuse, ReadRegister(efuse, SO_STATR_ADDR));
+            ASSERT_EQ(
+                0x10U + tick + efuse, ReadRegister(efuse, SO_FAULTR_0_ADDR));
+            ASSERT_EQ(
+                0x100U + tick + efuse, ReadRegister(efuse, SO_FAULTR_1_ADDR));
+        }
+    }
+}
+
+TEST_F(EfuseManagerTest, watchdog_bit_alternates_and_parity_is_even)
+{
+    for (size_t efuse = 0U; efuse < NUM_EFUSES; efuse++)
+    {
+        PollStatusAndFaults(efuse);
+    }
+
+    for (uint16_t tick = 0U; tick < 100U; tick++)
+    {
+        Io_EfuseManager_WriteRegister(
+            manager, tick % NUM_EFUSES, SI_OCR_0_ADDR, tick);
+        RunTransaction();
+    }
+
+    for (const FakeEfuse &efuse : efuses)
+    {
+        ASSERT_EQ(0U, efuse.num_parity_errors);
+        ASSERT_EQ(0U, efuse.num_watchdog_errors);
+    }
+
+    // The first frame after resetting the watchdog-in bit has it set, even if
+    // the previous frame had it set too
+    for (size_t i = 0U; i < 2U; i++)
+    {
+        Io_EfuseManager_ResetWatchdogBit(manager, 0U);
+        Io_EfuseManager_WriteRegister(
+            manager, 0U, SI_GCR_ADDR, (uint16_t)(GCR_CONFIG + i));
+        const size_t num_frames = Io_EfuseManager_BeginTransaction(manager);
+        struct EfuseFrame *const frames = Io_EfuseManager_GetFrames(manager);
+        ASSERT_GT(num_frames, 0U);
+        ASSERT_EQ(0U, frames[0].efuse);
+        ASSERT_EQ(GCR_CONFIG + i, frames[0].tx_data & EFUSE_SI_DATA_MASK);
+        ASSERT_TRUE(frames[0].tx_data & WATCHDOG_BIT);
+        Io_EfuseManager_EndTransaction(manager, true);
+    }
+}
+
+TEST_F(EfuseManagerTest, failed_transaction_resends_writes_and_rereads)
+{
+    PollStatusAndFaults(0U);
+    RunTransaction();
+    efuses[0].output_registers[SO_STATR_ADDR] = SO_UV_MASK;
+
+    Io_EfuseManager_WriteRegister(manager, 0U, SI_GCR_ADDR, GCR_CONFIG);
+    RunTransaction(1U);
+
+    uint16_t register_value;
+    ASSERT_EQ(
+        EXIT_CODE_TIMEOUT, Io_EfuseManager_ReadRegister(
+                               manager, 0U, SO_FAULTR_0_ADDR, &register_value));
+    ASSERT_TRUE(Io_EfuseManager_IsRegisterPending(manager, 0U, SI_GCR_ADDR));
+
+    // It isn't known which register the efuse clocks out next, so STATR is
+    // selected again
+    RunTransaction();
+    ASSERT_EQ(5U, last_num_frames);
+    ASSERT_EQ(2U, efuses[0].num_writes[SI_GCR_ADDR]);
+    ASSERT_FALSE(Io_EfuseManager_IsRegisterPending(manager, 0U, SI_GCR_ADDR));
+    ASSERT_EQ(SO_UV_MASK, ReadRegister(0U, SO_STATR_ADDR));
+    ASSERT_EQ(0U, ReadRegister(0U, SO_FAULTR_1_ADDR));
+}
+
+TEST_F(EfuseManagerTest, register_written_during_transaction_stays_pending)
+{
+    Io_EfuseManager_WriteRegister(manager, 0U, SI_GCR_ADDR, GCR_CONFIG);
+    const size_t num_frames         = Io_EfuseManager_BeginTransaction(manager);
+    struct EfuseFrame *const frames = Io_EfuseManager_GetFrames(manager);
+
+    Io_EfuseManager_WriteRegister(
+        manager, 0U, SI_GCR_ADDR, GCR_CONFIG | CSNS_FUNCTION_CURRENT_CH1);
+
+    for (size_t i = 0U; i < num_frames; i++)
+    {
+        frames[i].rx_data = efuses[0].Exchange(frames[i].tx_data);
+    }
+    Io_EfuseManager_EndTransaction(manager, true);
+
+    ASSERT_TRUE(Io_EfuseManager_IsRegisterPending(manager, 0U, SI_GCR_ADDR));
+    RunTransaction();
+    ASSERT_EQ(
+        GCR_CONFIG | CSNS_FUNCTION_CURRENT_CH1,
+        efuses[0].input_registers[SI_GCR_ADDR]);
+}
+
+TEST_F(EfuseManagerTest, spi_time_per_tick)
+{
+    // Every efuse's status and faults are polled, and the current sense of
+    // each efuse alternates between its channels every tick
+    for (size_t efuse = 0U; efuse < NUM_EFUSES; efuse++)
+    {
+        Io_EfuseManager_WriteRegister(manager, efuse, SI_GCR_ADDR, GCR_CONFIG);
+        PollStatusAndFaults(efuse);
+    }
+    RunTransaction();
+
+    const size_t num_ticks      = 100U;
+    float        total_spi_time = 0.0f;
+    for (size_t tick = 0U; tick < num_ticks; tick++)
+    {
+        for (size_t efuse = 0U; efuse < NUM_EFUSES; efuse++)
+        {
+            Io_EfuseManager_WriteRegister(
+                manager, efuse, SI_GCR_ADDR,
+                (tick % 2U) ? GCR_CONFIG | CSNS_FUNCTION_CURRENT_CH1
+                            : GCR_CONFIG | CSNS_FUNCTION_CURRENT_CH0);
+        }
+        total_spi_time += RunTransaction();
+    }
+    const float spi_time_per_tick = total_spi_time / (float)num_ticks;
+
+    // Reading the GCR back, modifying it and writing it, and reading the
+    // status and faults, with every read taking two frames
+    const size_t legacy_num_frames_per_tick =
+        NUM_EFUSES *
+        (LEGACY_FRAMES_PER_READ + 1U + 3U * LEGACY_FRAMES_PER_READ);
+    const float legacy_spi_time_per_tick =
+        (float)legacy_num_frames_per_tick *
+        (SPI_FRAME_DURATION_S + CHIP_SELECT_OVERHEAD_S);
+
+    RecordProperty("spi_time_per_tick_us", (int)(spi_time_per_tick * 1e6f));
+    RecordProperty(
+        "legacy_spi_time_per_tick_us", (int)(legacy_spi_time_per_tick * 1e6f));
+
+    // One write, two reads and the frame clocking out the last read
+    ASSERT_EQ(4U * NUM_EFUSES, last_num_frames);
+    ASSERT_LT(spi_time_per_tick, 0.5f * legacy_spi_time_per_tick);
+}
+
+} // namespace EfuseManagerTest
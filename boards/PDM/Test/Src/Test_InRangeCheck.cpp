@@ -25,6 +25,15 @@ class InRangeCheckTest : public testing::Test
         TearDownObject(in_range_check, App_InRangeCheck_Destroy);
     }
 
+    // Evaluate the given in-range check for one tick, and get its value
+    enum InRangeCheck_Status EvaluateAndGetValue(
+        struct InRangeCheck *in_range_check_to_evaluate,
+        float *              value)
+    {
+        App_InRangeCheck_Evaluate(in_range_check_to_evaluate);
+        return App_InRangeCheck_GetValue(in_range_check_to_evaluate, value);
+    }
+
     struct InRangeCheck *in_range_check;
 
     const float DEFAULT_IN_RANGE_CHECK_MIN_VALUE = 5.0f;
@@ -38,8 +47,7 @@ TEST_F(InRangeCheckTest, value_in_range)
     get_value_fake.return_val =
         (DEFAULT_IN_RANGE_CHECK_MIN_VALUE + DEFAULT_IN_RANGE_CHECK_MAX_VALUE) /
         2.0f;
-    ASSERT_EQ(
-        VALUE_IN_RANGE, App_InRangeCheck_GetValue(in_range_check, &value));
+    ASSERT_EQ(VALUE_IN_RANGE, EvaluateAndGetValue(in_range_check, &value));
     ASSERT_EQ(get_value_fake.return_val, value);
 }
 
@@ -49,14 +57,12 @@ TEST_F(InRangeCheckTest, value_underflow)
 
     // The range is inclusive, so the minimum value should not trigger an error
     get_value_fake.return_val = DEFAULT_IN_RANGE_CHECK_MIN_VALUE;
-    ASSERT_EQ(
-        VALUE_IN_RANGE, App_InRangeCheck_GetValue(in_range_check, &value));
+    ASSERT_EQ(VALUE_IN_RANGE, EvaluateAndGetValue(in_range_check, &value));
     ASSERT_EQ(get_value_fake.return_val, value);
 
     get_value_fake.return_val = std::nextafter(
         DEFAULT_IN_RANGE_CHECK_MIN_VALUE, std::numeric_limits<float>::min());
-    ASSERT_EQ(
-        VALUE_UNDERFLOW, App_InRangeCheck_GetValue(in_range_check, &value));
+    ASSERT_EQ(VALUE_UNDERFLOW, EvaluateAndGetValue(in_range_check, &value));
     ASSERT_EQ(get_value_fake.return_val, value);
 }
 
@@ -66,17 +72,42 @@ TEST_F(InRangeCheckTest, value_overflow)
 
     // The range is inclusive, so the maximum value should not trigger an error
     get_value_fake.return_val = DEFAULT_IN_RANGE_CHECK_MAX_VALUE;
-    ASSERT_EQ(
-        VALUE_IN_RANGE, App_InRangeCheck_GetValue(in_range_check, &value));
+    ASSERT_EQ(VALUE_IN_RANGE, EvaluateAndGetValue(in_range_check, &value));
     ASSERT_EQ(get_value_fake.return_val, value);
 
     get_value_fake.return_val = std::nextafter(
         DEFAULT_IN_RANGE_CHECK_MAX_VALUE, std::numeric_limits<float>::max());
-    ASSERT_EQ(
-        VALUE_OVERFLOW, App_InRangeCheck_GetValue(in_range_check, &value));
+    ASSERT_EQ(VALUE_OVERFLOW, EvaluateAndGetValue(in_range_check, &value));
     ASSERT_EQ(get_value_fake.return_val, value);
 }
 
+TEST_F(InRangeCheckTest, value_and_status_are_only_sampled_by_evaluate)
+{
+    float value;
+
+    get_value_fake.return_val = DEFAULT_IN_RANGE_CHECK_MAX_VALUE + 1.0f;
+    App_InRangeCheck_Evaluate(in_range_check);
+    ASSERT_EQ(1, get_value_fake.call_count);
+
+    // Reading the in-range check any number of times neither samples the value
+    // again nor counts towards the debounce
+    get_value_fake.return_val = DEFAULT_IN_RANGE_CHECK_MIN_VALUE;
+    for (int i = 0; i < 3; i++)
+    {
+        ASSERT_EQ(
+            VALUE_OVERFLOW, App_InRangeCheck_GetValue(in_range_check, &value));
+        ASSERT_EQ(DEFAULT_IN_RANGE_CHECK_MAX_VALUE + 1.0f, value);
+        ASSERT_EQ(VALUE_OVERFLOW, App_InRangeCheck_GetStatus(in_range_check));
+    }
+    ASSERT_EQ(1, get_value_fake.call_count);
+
+    App_InRangeCheck_Evaluate(in_range_check);
+    ASSERT_EQ(
+        VALUE_IN_RANGE, App_InRangeCheck_GetValue(in_range_check, &value));
+    ASSERT_EQ(DEFAULT_IN_RANGE_CHECK_MIN_VALUE, value);
+    ASSERT_EQ(2, get_value_fake.call_count);
+}
+
 TEST_F(InRangeCheckTest, invalid_min_and_max)
 {
 #ifdef NDEBUG
@@ -96,3 +127,102 @@ TEST_F(InRangeCheckTest, invalid_min_and_max)
         App_InRangeCheck_Create(get_value, min_value, max_value), "");
 #endif
 }
+
+TEST_F(InRangeCheckTest, hysteresis_delays_return_to_range)
+{
+    const float          hysteresis = 0.2f;
+    struct InRangeCheck *in_range_check_with_hysteresis =
+        App_InRangeCheck_CreateWithDebounce(
+            get_value, DEFAULT_IN_RANGE_CHECK_MIN_VALUE,
+            DEFAULT_IN_RANGE_CHECK_MAX_VALUE, hysteresis, 0);
+    float value;
+
+    get_value_fake.return_val = DEFAULT_IN_RANGE_CHECK_MIN_VALUE - 0.1f;
+    ASSERT_EQ(
+        VALUE_UNDERFLOW,
+        EvaluateAndGetValue(in_range_check_with_hysteresis, &value));
+
+    // Back inside the range, but not past the hysteresis yet
+    get_value_fake.return_val = DEFAULT_IN_RANGE_CHECK_MIN_VALUE + 0.1f;
+    ASSERT_EQ(
+        VALUE_UNDERFLOW,
+        EvaluateAndGetValue(in_range_check_with_hysteresis, &value));
+    ASSERT_EQ(get_value_fake.return_val, value);
+
+    get_value_fake.return_val = DEFAULT_IN_RANGE_CHECK_MIN_VALUE + 0.3f;
+    ASSERT_EQ(
+        VALUE_IN_RANGE,
+        EvaluateAndGetValue(in_range_check_with_hysteresis, &value));
+
+    get_value_fake.return_val = DEFAULT_IN_RANGE_CHECK_MAX_VALUE + 0.1f;
+    ASSERT_EQ(
+        VALUE_OVERFLOW,
+        EvaluateAndGetValue(in_range_check_with_hysteresis, &value));
+
+    get_value_fake.return_val = DEFAULT_IN_RANGE_CHECK_MAX_VALUE - 0.1f;
+    ASSERT_EQ(
+        VALUE_OVERFLOW,
+        EvaluateAndGetValue(in_range_check_with_hysteresis, &value));
+
+    get_value_fake.return_val = DEFAULT_IN_RANGE_CHECK_MAX_VALUE - 0.3f;
+    ASSERT_EQ(
+        VALUE_IN_RANGE,
+        EvaluateAndGetValue(in_range_check_with_hysteresis, &value));
+
+    TearDownObject(in_range_check_with_hysteresis, App_InRangeCheck_Destroy);
+}
+
+TEST_F(InRangeCheckTest, debounce_requires_consecutive_samples)
+{
+    const uint32_t       num_debounce_samples = 3;
+    struct InRangeCheck *in_range_check_with_debounce =
+        App_InRangeCheck_CreateWithDebounce(
+            get_value, DEFAULT_IN_RANGE_CHECK_MIN_VALUE,
+            DEFAULT_IN_RANGE_CHECK_MAX_VALUE, 0.0f, num_debounce_samples);
+    float value;
+
+    const float in_range_value =
+        (DEFAULT_IN_RANGE_CHECK_MIN_VALUE + DEFAULT_IN_RANGE_CHECK_MAX_VALUE) /
+        2.0f;
+    const float overflow_value = DEFAULT_IN_RANGE_CHECK_MAX_VALUE + 1.0f;
+
+    // A glitch shorter than the debounce is never reported
+    get_value_fake.return_val = overflow_value;
+    for (uint32_t i = 0; i < num_debounce_samples - 1; i++)
+    {
+        ASSERT_EQ(
+            VALUE_IN_RANGE,
+            EvaluateAndGetValue(in_range_check_with_debounce, &value));
+        ASSERT_EQ(overflow_value, value);
+    }
+    get_value_fake.return_val = in_range_value;
+    ASSERT_EQ(
+        VALUE_IN_RANGE,
+        EvaluateAndGetValue(in_range_check_with_debounce, &value));
+
+    // The glitch above must not count towards the next overflow
+    get_value_fake.return_val = overflow_value;
+    for (uint32_t i = 0; i < num_debounce_samples - 1; i++)
+    {
+        ASSERT_EQ(
+            VALUE_IN_RANGE,
+            EvaluateAndGetValue(in_range_check_with_debounce, &value));
+    }
+    ASSERT_EQ(
+        VALUE_OVERFLOW,
+        EvaluateAndGetValue(in_range_check_with_debounce, &value));
+
+    // Returning to the range is debounced as well
+    get_value_fake.return_val = in_range_value;
+    for (uint32_t i = 0; i < num_debounce_samples - 1; i++)
+    {
+        ASSERT_EQ(
+            VALUE_OVERFLOW,
+            EvaluateAndGetValue(in_range_check_with_debounce, &value));
+    }
+    ASSERT_EQ(
+        VALUE_IN_RANGE,
+        EvaluateAndGetValue(in_range_check_with_debounce, &value));
+
+    TearDownObject(in_range_check_with_debounce, App_InRangeCheck_Destroy);
+}
@@ -0,0 +1,464 @@
+#include <math.h>
+#include "Test_Pdm.h"
+
+extern "C"
+{
+#include "App_PowerSequencer.h"
+}
+
+namespace PowerSequencerTest
+{
+// A load that draws its inrush current for a while after it is enabled, and
+// then its steady-state current
+struct SimulatedLoad
+{
+    bool     is_enabled;
+    uint32_t enable_time_ms;
+    float    inrush_current;
+    uint32_t inrush_duration_ms;
+    float    steady_state_current;
+};
+
+static uint32_t      current_time_ms;
+static SimulatedLoad loads[3];
+
+static void EnableLoad(size_t load)
+{
+    loads[load].is_enabled     = true;
+    loads[load].enable_time_ms = current_time_ms;
+}
+
+static float GetLoadCurrent(size_t load)
+{
+    if (!loads[load].is_enabled)
+    {
+        return 0.0f;
+    }
+
+    return current_time_ms - loads[load].enable_time_ms <
+                   loads[load].inrush_duration_ms
+               ? loads[load].inrush_current
+               : loads[load].steady_state_current;
+}
+
+static void EnableLoad0(void)
+{
+    EnableLoad(0U);
+}
+
+static void EnableLoad1(void)
+{
+    EnableLoad(1U);
+}
+
+static void EnableLoad2(void)
+{
+    EnableLoad(2U);
+}
+
+static void DisableLoad0(void)
+{
+    loads[0].is_enabled = false;
+}
+
+static void DisableLoad1(void)
+{
+    loads[1].is_enabled = false;
+}
+
+static void DisableLoad2(void)
+{
+    loads[2].is_enabled = false;
+}
+
+static float GetLoad0Current(void)
+{
+    return GetLoadCurrent(0U);
+}
+
+static float GetLoad1Current(void)
+{
+    return GetLoadCurrent(1U);
+}
+
+static float GetLoad2Current(void)
+{
+    return GetLoadCurrent(2U);
+}
+
+static float GetUnmeasurableCurrent(void)
+{
+    return NAN;
+}
+
+class PowerSequencerTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        current_time_ms = 0U;
+
+        for (size_t i = 0U; i < 3U; i++)
+        {
+            loads[i] = { false, 0U, 2.0f, 50U, 0.5f };
+
+            steps[i] = {
+                i == 0U ? EnableLoad0 : i == 1U ? EnableLoad1 : EnableLoad2,
+                i == 0U ? DisableLoad0 : i == 1U ? DisableLoad1 : DisableLoad2,
+                i == 0U ? GetLoad0Current
+                        : i == 1U ? GetLoad1Current : GetLoad2Current,
+                POWER_SEQUENCE_NO_DEPENDENCY,
+                2.0f,
+                1.0f,
+                20U,
+                500U,
+            };
+        }
+
+        power_sequencer = NULL;
+    }
+
+    void TearDown() override
+    {
+        TearDownObject(power_sequencer, App_PowerSequencer_Destroy);
+    }
+
+    void CreateAndStart(float current_budget)
+    {
+        power_sequencer = App_PowerSequencer_Create(steps, 3U, current_budget);
+        App_PowerSequencer_Start(power_sequencer, current_time_ms);
+    }
+
+    // Tick every 10ms, as the 100Hz task does, until the sequence finishes
+    void RunUntilFinished(void)
+    {
+        while (App_PowerSequencer_GetState(power_sequencer) ==
+                   POWER_SEQUENCE_IN_PROGRESS &&
+               current_time_ms < 10000U)
+        {
+            App_PowerSequencer_Tick(power_sequencer, current_time_ms);
+
+            float total_current = 0.0f;
+            for (size_t i = 0U; i < 3U; i++)
+            {
+                total_current += GetLoadCurrent(i);
+            }
+            peak_current = fmaxf(peak_current, total_current);
+
+            current_time_ms += 10U;
+        }
+    }
+
+    struct PowerSequencer *  power_sequencer;
+    struct PowerSequenceStep steps[3];
+    float                    peak_current = 0.0f;
+};
+
+TEST_F(PowerSequencerTest, loads_are_off_until_started)
+{
+    power_sequencer = App_PowerSequencer_Create(steps, 3U, 10.0f);
+
+    App_PowerSequencer_Tick(power_sequencer, 0U);
+
+    ASSERT_EQ(
+        POWER_SEQUENCE_IDLE, App_PowerSequencer_GetState(power_sequencer));
+    for (size_t i = 0U; i < 3U; i++)
+    {
+        ASSERT_FALSE(loads[i].is_enabled);
+    }
+}
+
+TEST_F(PowerSequencerTest, loads_are_enabled_together_if_the_budget_allows)
+{
+    CreateAndStart(6.0f);
+
+    App_PowerSequencer_Tick(power_sequencer, current_time_ms);
+
+    for (size_t i = 0U; i < 3U; i++)
+    {
+        ASSERT_TRUE(loads[i].is_enabled);
+        ASSERT_EQ(
+            POWER_SEQUENCE_STEP_SETTLING,
+            App_PowerSequencer_GetStepState(power_sequencer, i));
+    }
+
+    RunUntilFinished();
+
+    ASSERT_EQ(
+        POWER_SEQUENCE_READY, App_PowerSequencer_GetState(power_sequencer));
+
+    // The inrush is last measured at 40ms, and the loads have settled for 20ms
+    // after that
+    ASSERT_EQ(60U, App_PowerSequencer_GetTimeToReadyMs(power_sequencer));
+}
+
+TEST_F(PowerSequencerTest, inrush_never_exceeds_the_current_budget)
+{
+    CreateAndStart(3.5f);
+
+    RunUntilFinished();
+
+    ASSERT_EQ(
+        POWER_SEQUENCE_READY, App_PowerSequencer_GetState(power_sequencer));
+    ASSERT_LE(peak_current, 3.5f);
+    ASSERT_FLOAT_EQ(
+        peak_current, App_PowerSequencer_GetPeakCurrent(power_sequencer));
+}
+
+TEST_F(PowerSequencerTest, load_is_enabled_once_the_budget_frees_up)
+{
+    // Only one inrush fits in the budget at a time, but a settled load leaves
+    // room for the next inrush
+    CreateAndStart(3.0f);
+
+    App_PowerSequencer_Tick(power_sequencer, current_time_ms);
+
+    ASSERT_TRUE(loads[0].is_enabled);
+    ASSERT_FALSE(loads[1].is_enabled);
+    ASSERT_FALSE(loads[2].is_enabled);
+
+    RunUntilFinished();
+
+    ASSERT_EQ(
+        POWER_SEQUENCE_READY, App_PowerSequencer_GetState(power_sequencer));
+    ASSERT_EQ(180U, App_PowerSequencer_GetTimeToReadyMs(power_sequencer));
+}
+
+TEST_F(PowerSequencerTest, load_waits_for_its_dependency)
+{
+    steps[2].dependency = 0U;
+    CreateAndStart(10.0f);
+
+    App_PowerSequencer_Tick(power_sequencer, current_time_ms);
+
+    ASSERT_TRUE(loads[0].is_enabled);
+    ASSERT_TRUE(loads[1].is_enabled);
+    ASSERT_FALSE(loads[2].is_enabled);
+
+    RunUntilFinished();
+
+    ASSERT_EQ(
+        POWER_SEQUENCE_READY, App_PowerSequencer_GetState(power_sequencer));
+    ASSERT_EQ(120U, App_PowerSequencer_GetTimeToReadyMs(power_sequencer));
+}
+
+TEST_F(PowerSequencerTest, load_that_never_settles_is_disabled)
+{
+    loads[1].inrush_duration_ms = UINT32_MAX;
+    steps[2].dependency         = 1U;
+    CreateAndStart(10.0f);
+
+    RunUntilFinished();
+
+    ASSERT_EQ(
+        POWER_SEQUENCE_FAULT, App_PowerSequencer_GetState(power_sequencer));
+    ASSERT_EQ(
+        POWER_SEQUENCE_STEP_READY,
+        App_PowerSequencer_GetStepState(power_sequencer, 0U));
+    ASSERT_EQ(
+        POWER_SEQUENCE_STEP_FAULT,
+        App_PowerSequencer_GetStepState(power_sequencer, 1U));
+    ASSERT_FALSE(loads[1].is_enabled);
+
+    // The load that depends on the faulted load is never enabled
+    ASSERT_EQ(
+        POWER_SEQUENCE_STEP_FAULT,
+        App_PowerSequencer_GetStepState(power_sequencer, 2U));
+    ASSERT_FALSE(loads[2].is_enabled);
+}
+
+TEST_F(PowerSequencerTest, unmeasurable_load_never_settles)
+{
+    steps[0].get_current = GetUnmeasurableCurrent;
+    CreateAndStart(10.0f);
+
+    RunUntilFinished();
+
+    ASSERT_EQ(
+        POWER_SEQUENCE_STEP_FAULT,
+        App_PowerSequencer_GetStepState(power_sequencer, 0U));
+    ASSERT_EQ(
+        POWER_SEQUENCE_FAULT, App_PowerSequencer_GetState(power_sequencer));
+}
+
+TEST_F(PowerSequencerTest, load_that_can_never_fit_in_the_budget_is_faulted)
+{
+    // Load 0 settles at more current than expected, leaving too little of the
+    // budget for any other inrush
+    loads[0].steady_state_current = 1.0f;
+    loads[0].inrush_duration_ms   = 0U;
+    CreateAndStart(2.5f);
+
+    RunUntilFinished();
+
+    ASSERT_EQ(
+        POWER_SEQUENCE_STEP_READY,
+        App_PowerSequencer_GetStepState(power_sequencer, 0U));
+    ASSERT_EQ(
+        POWER_SEQUENCE_STEP_FAULT,
+        App_PowerSequencer_GetStepState(power_sequencer, 1U));
+    ASSERT_EQ(
+        POWER_SEQUENCE_FAULT, App_PowerSequencer_GetState(power_sequencer));
+}
+
+TEST_F(PowerSequencerTest, load_that_trips_its_fuse_while_settling_is_retried)
+{
+    CreateAndStart(10.0f);
+    App_PowerSequencer_Tick(power_sequencer, current_time_ms);
+    ASSERT_TRUE(loads[0].is_enabled);
+
+    App_PowerSequencer_SetStepTripped(power_sequencer, 0U, true, false);
+
+    ASSERT_FALSE(loads[0].is_enabled);
+    ASSERT_EQ(
+        POWER_SEQUENCE_STEP_TRIPPED,
+        App_PowerSequencer_GetStepState(power_sequencer, 0U));
+
+    // The fuse retries the load once it cools down, as it does for a load that
+    // trips once it is ready
+    App_PowerSequencer_SetStepTripped(power_sequencer, 0U, false, false);
+    App_PowerSequencer_Tick(power_sequencer, current_time_ms);
+    ASSERT_TRUE(loads[0].is_enabled);
+    ASSERT_EQ(
+        POWER_SEQUENCE_STEP_SETTLING,
+        App_PowerSequencer_GetStepState(power_sequencer, 0U));
+
+    RunUntilFinished();
+
+    ASSERT_EQ(
+        POWER_SEQUENCE_READY, App_PowerSequencer_GetState(power_sequencer));
+}
+
+TEST_F(PowerSequencerTest, load_whose_fuse_latches_is_faulted)
+{
+    CreateAndStart(10.0f);
+    App_PowerSequencer_Tick(power_sequencer, current_time_ms);
+
+    // The load trips while settling, and its fuse runs out of retries on the
+    // next trip
+    App_PowerSequencer_SetStepTripped(power_sequencer, 0U, true, false);
+    App_PowerSequencer_SetStepTripped(power_sequencer, 0U, false, false);
+    App_PowerSequencer_Tick(power_sequencer, current_time_ms);
+    ASSERT_TRUE(loads[0].is_enabled);
+
+    App_PowerSequencer_SetStepTripped(power_sequencer, 0U, false, true);
+
+    ASSERT_FALSE(loads[0].is_enabled);
+    ASSERT_EQ(
+        POWER_SEQUENCE_STEP_FAULT,
+        App_PowerSequencer_GetStepState(power_sequencer, 0U));
+
+    RunUntilFinished();
+
+    ASSERT_FALSE(loads[0].is_enabled);
+    ASSERT_EQ(
+        POWER_SEQUENCE_STEP_FAULT,
+        App_PowerSequencer_GetStepState(power_sequencer, 0U));
+    ASSERT_EQ(
+        POWER_SEQUENCE_FAULT, App_PowerSequencer_GetState(power_sequencer));
+}
+
+TEST_F(PowerSequencerTest, ready_load_whose_fuse_latches_is_faulted)
+{
+    CreateAndStart(6.0f);
+    RunUntilFinished();
+    ASSERT_EQ(
+        POWER_SEQUENCE_READY, App_PowerSequencer_GetState(power_sequencer));
+
+    // A fuse that latches while tripped keeps the load disabled for good
+    App_PowerSequencer_SetStepTripped(power_sequencer, 1U, true, false);
+    App_PowerSequencer_SetStepTripped(power_sequencer, 1U, false, true);
+    App_PowerSequencer_Tick(power_sequencer, current_time_ms);
+
+    ASSERT_FALSE(loads[1].is_enabled);
+    ASSERT_EQ(
+        POWER_SEQUENCE_STEP_FAULT,
+        App_PowerSequencer_GetStepState(power_sequencer, 1U));
+    ASSERT_EQ(
+        POWER_SEQUENCE_FAULT, App_PowerSequencer_GetState(power_sequencer));
+}
+
+TEST_F(
+    PowerSequencerTest,
+    tripped_load_is_powered_up_again_once_its_fuse_clears)
+{
+    CreateAndStart(6.0f);
+    RunUntilFinished();
+    ASSERT_EQ(
+        POWER_SEQUENCE_READY, App_PowerSequencer_GetState(power_sequencer));
+
+    App_PowerSequencer_SetStepTripped(power_sequencer, 1U, true, false);
+
+    ASSERT_FALSE(loads[1].is_enabled);
+    ASSERT_EQ(
+        POWER_SEQUENCE_STEP_TRIPPED,
+        App_PowerSequencer_GetStepState(power_sequencer, 1U));
+
+    // The load stays disabled while its fuse is tripped
+    for (size_t i = 0U; i < 10U; i++)
+    {
+        App_PowerSequencer_Tick(power_sequencer, current_time_ms);
+        current_time_ms += 10U;
+    }
+    ASSERT_FALSE(loads[1].is_enabled);
+    ASSERT_EQ(
+        POWER_SEQUENCE_IN_PROGRESS,
+        App_PowerSequencer_GetState(power_sequencer));
+
+    // Once the fuse clears, the load has to settle again before it is ready
+    App_PowerSequencer_SetStepTripped(power_sequencer, 1U, false, false);
+    App_PowerSequencer_Tick(power_sequencer, current_time_ms);
+    ASSERT_TRUE(loads[1].is_enabled);
+    ASSERT_EQ(
+        POWER_SEQUENCE_STEP_SETTLING,
+        App_PowerSequencer_GetStepState(power_sequencer, 1U));
+
+    RunUntilFinished();
+
+    ASSERT_EQ(
+        POWER_SEQUENCE_READY, App_PowerSequencer_GetState(power_sequencer));
+
+    // Only the first power up is reported
+    ASSERT_EQ(60U, App_PowerSequencer_GetTimeToReadyMs(power_sequencer));
+}
+
+TEST_F(PowerSequencerTest, load_is_not_enabled_while_its_fuse_is_tripped)
+{
+    power_sequencer     = App_PowerSequencer_Create(steps, 3U, 10.0f);
+    loads[2].is_enabled = true;
+
+    // The load is disabled even before the sequence starts
+    App_PowerSequencer_SetStepTripped(power_sequencer, 2U, true, false);
+    ASSERT_FALSE(loads[2].is_enabled);
+
+    App_PowerSequencer_Start(power_sequencer, current_time_ms);
+    App_PowerSequencer_Tick(power_sequencer, current_time_ms);
+
+    ASSERT_TRUE(loads[0].is_enabled);
+    ASSERT_TRUE(loads[1].is_enabled);
+    ASSERT_FALSE(loads[2].is_enabled);
+    ASSERT_EQ(
+        POWER_SEQUENCE_STEP_OFF,
+        App_PowerSequencer_GetStepState(power_sequencer, 2U));
+}
+
+TEST_F(PowerSequencerTest, start_restarts_the_sequence)
+{
+    CreateAndStart(6.0f);
+    RunUntilFinished();
+
+    App_PowerSequencer_Start(power_sequencer, current_time_ms);
+
+    ASSERT_EQ(
+        POWER_SEQUENCE_IN_PROGRESS,
+        App_PowerSequencer_GetState(power_sequencer));
+    for (size_t i = 0U; i < 3U; i++)
+    {
+        ASSERT_FALSE(loads[i].is_enabled);
+        ASSERT_EQ(
+            POWER_SEQUENCE_STEP_OFF,
+            App_PowerSequencer_GetStepState(power_sequencer, i));
+    }
+}
+
+} // namespace PowerSequencerTest
@@ -13,6 +13,7 @@ extern "C"
 #include "configs/App_VoltageLimits.h"
 #include "configs/App_CurrentLimits.h"
 #include "configs/App_HeartbeatMonitorConfig.h"
+#include "configs/App_ThermalFuseConfig.h"
 }
 
 namespace StateMachineTest
@@ -54,6 +55,54 @@ FAKE_VOID_FUNC(turn_on_blue_led);
 FAKE_VALUE_FUNC(bool, do_low_voltage_battery_have_charge_fault);
 FAKE_VALUE_FUNC(bool, do_low_voltage_battery_have_boost_controller_fault);
 
+FAKE_VOID_FUNC(enable_aux1);
+FAKE_VOID_FUNC(disable_aux1);
+FAKE_VOID_FUNC(enable_aux2);
+FAKE_VOID_FUNC(disable_aux2);
+
+// Aux2 is powered up once Aux1 is ready
+static const struct PowerSequenceStep
+    power_sequence[NUM_THERMAL_FUSE_CHANNELS] = {
+        {
+            enable_aux1,
+            disable_aux1,
+            GetAux1Current,
+            POWER_SEQUENCE_NO_DEPENDENCY,
+            AUX1_MAX_CURRENT,
+            AUX1_MAX_CURRENT,
+            20U,
+            500U,
+        },
+        {
+            enable_aux2,
+            disable_aux2,
+            GetAux2Current,
+            THERMAL_FUSE_AUX1,
+            AUX2_MAX_CURRENT,
+            AUX2_MAX_CURRENT,
+            20U,
+            500U,
+        },
+    };
+
+static const struct ThermalFuseConfig
+    thermal_fuse_configs[NUM_THERMAL_FUSE_CHANNELS] = {
+        {
+            AUX1_MAX_CURRENT,
+            AUX1_I2T_RATING,
+            THERMAL_FUSE_SOFT_TRIP_LOAD,
+            THERMAL_FUSE_RETRY_LOAD,
+            THERMAL_FUSE_MAX_NUM_RETRIES,
+        },
+        {
+            AUX2_MAX_CURRENT,
+            AUX2_I2T_RATING,
+            THERMAL_FUSE_SOFT_TRIP_LOAD,
+            THERMAL_FUSE_RETRY_LOAD,
+            THERMAL_FUSE_MAX_NUM_RETRIES,
+        },
+    };
+
 class PdmStateMachineTest : public BaseStateMachineTest
 {
   protected:
@@ -112,6 +161,13 @@ class PdmStateMachineTest : public BaseStateMachineTest
             do_low_voltage_battery_have_charge_fault,
             do_low_voltage_battery_have_boost_controller_fault);
 
+        power_sequencer = App_PowerSequencer_Create(
+            power_sequence, NUM_ELEMENTS_IN_ARRAY(power_sequence),
+            fmaxf(AUX1_MAX_CURRENT, AUX2_MAX_CURRENT));
+
+        thermal_fuses = App_ThermalFuses_Create(
+            thermal_fuse_configs, NUM_THERMAL_FUSE_CHANNELS, 0.0005f);
+
         clock = App_SharedClock_Create();
 
         world = App_PdmWorld_Create(
@@ -122,7 +178,8 @@ class PdmStateMachineTest : public BaseStateMachineTest
             right_inverter_current_in_range_check,
             energy_meter_current_in_range_check, can_current_in_range_check,
             air_shutdown_current_in_range_check, heartbeat_monitor,
-            rgb_led_sequence, low_voltage_battery, clock);
+            rgb_led_sequence, low_voltage_battery, power_sequencer,
+            thermal_fuses, clock);
 
         // Default to starting the state machine in the `init` state
         state_machine =
@@ -150,10 +207,15 @@ class PdmStateMachineTest : public BaseStateMachineTest
         RESET_FAKE(turn_on_blue_led);
         RESET_FAKE(do_low_voltage_battery_have_charge_fault);
         RESET_FAKE(do_low_voltage_battery_have_boost_controller_fault);
+        RESET_FAKE(enable_aux1);
+        RESET_FAKE(disable_aux1);
+        RESET_FAKE(enable_aux2);
+        RESET_FAKE(disable_aux2);
     }
 
     void TearDown() override
     {
+        DumpTraceIfFailed(state_machine);
         TearDownObject(world, App_PdmWorld_Destroy);
         TearDownObject(can_tx_interface, App_CanTx_Destroy);
         TearDownObject(can_rx_interface, App_CanRx_Destroy);
@@ -177,6 +239,8 @@ class PdmStateMachineTest : public BaseStateMachineTest
         TearDownObject(rgb_led_sequence, App_SharedRgbLedSequence_Destroy);
         TearDownObject(state_machine, App_SharedStateMachine_Destroy);
         TearDownObject(low_voltage_battery, App_LowVoltageBattery_Destroy);
+        TearDownObject(power_sequencer, App_PowerSequencer_Destroy);
+        TearDownObject(thermal_fuses, App_ThermalFuses_Destroy);
         TearDownObject(clock, App_SharedClock_Destroy);
     }
 
@@ -362,6 +426,8 @@ class PdmStateMachineTest : public BaseStateMachineTest
     struct HeartbeatMonitor * heartbeat_monitor;
     struct RgbLedSequence *   rgb_led_sequence;
     struct LowVoltageBattery *low_voltage_battery;
+    struct PowerSequencer *   power_sequencer;
+    struct ThermalFuses *     thermal_fuses;
     struct Clock *            clock;
 };
 
@@ -375,6 +441,74 @@ TEST_F(PdmStateMachineTest, check_init_state_is_broadcasted_over_can)
         App_CanTx_GetPeriodicSignal_STATE(can_tx_interface));
 }
 
+TEST_F(PdmStateMachineTest, power_sequence_is_started_in_init_state)
+{
+    SetInitialState(App_GetInitState());
+
+    ASSERT_EQ(1, disable_aux1_fake.call_count);
+    ASSERT_EQ(0, enable_aux1_fake.call_count);
+
+    LetTimePass(state_machine, 100);
+
+    ASSERT_EQ(1, enable_aux1_fake.call_count);
+    ASSERT_EQ(1, enable_aux2_fake.call_count);
+    ASSERT_EQ(
+        CANMSGS_PDM_POWER_SEQUENCE_POWER_SEQUENCE_STATE_READY_CHOICE,
+        App_CanTx_GetPeriodicSignal_POWER_SEQUENCE_STATE(can_tx_interface));
+}
+
+TEST_F(
+    PdmStateMachineTest,
+    thermal_fuse_trip_while_powering_up_is_an_inrush_fault)
+{
+    SetInitialState(App_GetInitState());
+    LetTimePass(state_machine, 10);
+    ASSERT_EQ(1, enable_aux1_fake.call_count);
+
+    // Aux1's inrush trips its thermal fuse before it settles
+    float currents[1000][NUM_THERMAL_FUSE_CHANNELS] = {};
+    for (size_t i = 0U; i < 1000U; i++)
+    {
+        currents[i][THERMAL_FUSE_AUX1] = 10.0f * AUX1_MAX_CURRENT;
+    }
+    App_ThermalFuses_ProcessSamples(thermal_fuses, &currents[0][0], 1000U);
+
+    LetTimePass(state_machine, 100);
+
+    // Aux1 is disabled once by the start of the sequence and once by the trip,
+    // and neither it nor Aux2, which depends on it, is enabled again
+    ASSERT_EQ(2, disable_aux1_fake.call_count);
+    ASSERT_EQ(1, enable_aux1_fake.call_count);
+    ASSERT_EQ(0, enable_aux2_fake.call_count);
+    ASSERT_EQ(
+        CANMSGS_PDM_POWER_SEQUENCE_POWER_SEQUENCE_STATE_FAULT_CHOICE,
+        App_CanTx_GetPeriodicSignal_POWER_SEQUENCE_STATE(can_tx_interface));
+}
+
+TEST_F(PdmStateMachineTest, thermal_fuse_trip_disables_the_channel)
+{
+    SetInitialState(App_GetAirOpenState());
+
+    // Aux2 draws several times its rated current for long enough to trip
+    float currents[1000][NUM_THERMAL_FUSE_CHANNELS] = {};
+    for (size_t i = 0U; i < 1000U; i++)
+    {
+        currents[i][THERMAL_FUSE_AUX2] = 10.0f * AUX2_MAX_CURRENT;
+    }
+    App_ThermalFuses_ProcessSamples(thermal_fuses, &currents[0][0], 1000U);
+
+    LetTimePass(state_machine, 10);
+
+    ASSERT_EQ(1, disable_aux2_fake.call_count);
+    ASSERT_EQ(0, disable_aux1_fake.call_count);
+    ASSERT_EQ(
+        CANMSGS_PDM_THERMAL_FUSES_AUX2_THERMAL_FUSE_STATE_TRIPPED_CHOICE,
+        App_CanTx_GetPeriodicSignal_AUX2_THERMAL_FUSE_STATE(can_tx_interface));
+    ASSERT_EQ(
+        CANMSGS_PDM_THERMAL_FUSES_AUX1_THERMAL_FUSE_STATE_OK_CHOICE,
+        App_CanTx_GetPeriodicSignal_AUX1_THERMAL_FUSE_STATE(can_tx_interface));
+}
+
 // PDM-21
 TEST_F(PdmStateMachineTest, check_air_open_state_is_broadcasted_over_can)
 {
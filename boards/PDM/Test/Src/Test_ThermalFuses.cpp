@@ -0,0 +1,219 @@
+#include <math.h>
+#include "Test_Pdm.h"
+
+extern "C"
+{
+#include "App_ThermalFuses.h"
+}
+
+namespace ThermalFusesTest
+{
+// Sampled at 2kHz, in blocks of 10 samples
+static constexpr float  SAMPLE_PERIOD_S = 0.0005f;
+static constexpr size_t BLOCK_SIZE      = 10U;
+
+static constexpr float RATED_CURRENT = 2.0f;
+static constexpr float I2T_RATING    = 4.0f;
+static constexpr float TIME_CONSTANT_S =
+    I2T_RATING / (RATED_CURRENT * RATED_CURRENT);
+
+enum
+{
+    CHANNEL_A,
+    CHANNEL_B,
+    NUM_CHANNELS
+};
+
+class ThermalFusesTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        for (size_t i = 0U; i < NUM_CHANNELS; i++)
+        {
+            configs[i] = {
+                RATED_CURRENT, I2T_RATING, 0.8f, 0.5f, 2U,
+            };
+        }
+
+        thermal_fuses = NULL;
+    }
+
+    void TearDown() override
+    {
+        TearDownObject(thermal_fuses, App_ThermalFuses_Destroy);
+    }
+
+    void Create(void)
+    {
+        thermal_fuses =
+            App_ThermalFuses_Create(configs, NUM_CHANNELS, SAMPLE_PERIOD_S);
+    }
+
+    // Whether the owner of the channel's output, which only disables it while
+    // its thermal fuse is tripped, keeps it enabled
+    bool IsEnabled(size_t channel)
+    {
+        const enum ThermalFuseState state =
+            App_ThermalFuses_GetState(thermal_fuses, channel);
+
+        return state != THERMAL_FUSE_TRIPPED && state != THERMAL_FUSE_LATCHED;
+    }
+
+    // Process a block of samples in which each enabled channel draws the given
+    // current, and tick as the 100Hz task does after every second block
+    void ProcessBlock(float current_a, float current_b)
+    {
+        const bool is_channel_a_enabled = IsEnabled(CHANNEL_A);
+        const bool is_channel_b_enabled = IsEnabled(CHANNEL_B);
+
+        float currents[BLOCK_SIZE][NUM_CHANNELS];
+        for (size_t sample = 0U; sample < BLOCK_SIZE; sample++)
+        {
+            currents[sample][CHANNEL_A] =
+                is_channel_a_enabled ? current_a : 0.0f;
+            currents[sample][CHANNEL_B] =
+                is_channel_b_enabled ? current_b : 0.0f;
+        }
+
+        App_ThermalFuses_ProcessSamples(
+            thermal_fuses, &currents[0][0], BLOCK_SIZE);
+
+        if (++num_blocks % 2U == 0U)
+        {
+            App_ThermalFuses_Tick(thermal_fuses);
+        }
+    }
+
+    // Process blocks until channel A's state changes to the given state
+    float RunUntilState(
+        enum ThermalFuseState state,
+        float                 current_a,
+        float                 max_time_s)
+    {
+        float time_s = 0.0f;
+        while (App_ThermalFuses_GetState(thermal_fuses, CHANNEL_A) != state &&
+               time_s < max_time_s)
+        {
+            ProcessBlock(current_a, 0.0f);
+            time_s += SAMPLE_PERIOD_S * (float)BLOCK_SIZE;
+        }
+
+        return time_s;
+    }
+
+    struct ThermalFuses *    thermal_fuses;
+    struct ThermalFuseConfig configs[NUM_CHANNELS];
+    size_t                   num_blocks = 0U;
+};
+
+TEST_F(ThermalFusesTest, rated_current_never_trips)
+{
+    Create();
+
+    RunUntilState(THERMAL_FUSE_TRIPPED, RATED_CURRENT, 20.0f);
+
+    ASSERT_EQ(
+        THERMAL_FUSE_SOFT_TRIPPED,
+        App_ThermalFuses_GetState(thermal_fuses, CHANNEL_A));
+    ASSERT_TRUE(IsEnabled(CHANNEL_A));
+    ASSERT_LT(App_ThermalFuses_GetThermalLoad(thermal_fuses, CHANNEL_A), 1.0f);
+}
+
+TEST_F(ThermalFusesTest, overcurrent_trips_after_the_i2t_trip_time)
+{
+    Create();
+
+    const float current = 2.0f * RATED_CURRENT;
+    const float time_s  = RunUntilState(THERMAL_FUSE_TRIPPED, current, 10.0f);
+
+    // The thermal load rises as (I / I_rated)² * (1 - e^(-t / tau)), so it
+    // reaches 1 at t = -tau * ln(1 - (I_rated / I)²). The trip is acted on by
+    // the next tick, up to 10ms later.
+    const float trip_time_s =
+        -TIME_CONSTANT_S *
+        logf(1.0f - (RATED_CURRENT / current) * (RATED_CURRENT / current));
+    ASSERT_NEAR(trip_time_s, time_s, 0.01f);
+    ASSERT_FALSE(IsEnabled(CHANNEL_A));
+    ASSERT_EQ(1U, App_ThermalFuses_GetNumTrips(thermal_fuses, CHANNEL_A));
+
+    // The other channel is unaffected
+    ASSERT_TRUE(IsEnabled(CHANNEL_B));
+    ASSERT_EQ(
+        THERMAL_FUSE_OK, App_ThermalFuses_GetState(thermal_fuses, CHANNEL_B));
+}
+
+TEST_F(ThermalFusesTest, short_spike_within_a_block_is_caught)
+{
+    configs[CHANNEL_A].i2t_rating = 0.004f;
+    Create();
+
+    // A single sample spike that heats the channel over its limit, followed by
+    // no current, so the thermal load has cooled down by the end of the block
+    float currents[BLOCK_SIZE][NUM_CHANNELS] = {};
+    currents[0][CHANNEL_A]                   = 5.0f * RATED_CURRENT;
+    App_ThermalFuses_ProcessSamples(thermal_fuses, &currents[0][0], BLOCK_SIZE);
+    ASSERT_LT(App_ThermalFuses_GetThermalLoad(thermal_fuses, CHANNEL_A), 1.0f);
+
+    App_ThermalFuses_Tick(thermal_fuses);
+
+    ASSERT_EQ(
+        THERMAL_FUSE_TRIPPED,
+        App_ThermalFuses_GetState(thermal_fuses, CHANNEL_A));
+    ASSERT_FALSE(IsEnabled(CHANNEL_A));
+}
+
+TEST_F(ThermalFusesTest, soft_trip_is_reported_before_the_trip)
+{
+    Create();
+
+    RunUntilState(THERMAL_FUSE_SOFT_TRIPPED, 2.0f * RATED_CURRENT, 10.0f);
+
+    ASSERT_TRUE(IsEnabled(CHANNEL_A));
+    ASSERT_GE(App_ThermalFuses_GetThermalLoad(thermal_fuses, CHANNEL_A), 0.8f);
+
+    // The soft trip clears once the channel cools down
+    RunUntilState(THERMAL_FUSE_OK, 0.0f, 10.0f);
+
+    ASSERT_EQ(
+        THERMAL_FUSE_OK, App_ThermalFuses_GetState(thermal_fuses, CHANNEL_A));
+    ASSERT_LT(App_ThermalFuses_GetThermalLoad(thermal_fuses, CHANNEL_A), 0.8f);
+}
+
+TEST_F(ThermalFusesTest, trip_is_cleared_once_the_channel_cools_down)
+{
+    Create();
+
+    RunUntilState(THERMAL_FUSE_TRIPPED, 2.0f * RATED_CURRENT, 10.0f);
+    ASSERT_FALSE(IsEnabled(CHANNEL_A));
+
+    // The channel draws no current while it is disabled
+    RunUntilState(THERMAL_FUSE_OK, 2.0f * RATED_CURRENT, 10.0f);
+
+    ASSERT_TRUE(IsEnabled(CHANNEL_A));
+    ASSERT_LE(App_ThermalFuses_GetThermalLoad(thermal_fuses, CHANNEL_A), 0.5f);
+}
+
+TEST_F(ThermalFusesTest, channel_latches_off_once_it_runs_out_of_retries)
+{
+    Create();
+
+    // The channel trips again after each of its 2 retries
+    for (size_t i = 0U; i < 2U; i++)
+    {
+        RunUntilState(THERMAL_FUSE_TRIPPED, 2.0f * RATED_CURRENT, 10.0f);
+        RunUntilState(THERMAL_FUSE_OK, 2.0f * RATED_CURRENT, 10.0f);
+        ASSERT_TRUE(IsEnabled(CHANNEL_A));
+    }
+
+    RunUntilState(THERMAL_FUSE_LATCHED, 2.0f * RATED_CURRENT, 10.0f);
+    RunUntilState(THERMAL_FUSE_OK, 2.0f * RATED_CURRENT, 10.0f);
+
+    ASSERT_EQ(
+        THERMAL_FUSE_LATCHED,
+        App_ThermalFuses_GetState(thermal_fuses, CHANNEL_A));
+    ASSERT_FALSE(IsEnabled(CHANNEL_A));
+    ASSERT_EQ(3U, App_ThermalFuses_GetNumTrips(thermal_fuses, CHANNEL_A));
+}
+
+} // namespace ThermalFusesTest
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stddef.h>
+#include <stdint.h>
 #include "App_SharedExitCode.h"
 
 struct InRangeCheck;
@@ -24,6 +26,44 @@ struct InRangeCheck *App_InRangeCheck_Create(
     float min_value,
     float max_value);
 
+/**
+ * Allocate and initialize an in-range check to check whether a value is in
+ * the given min/max range, with hysteresis and debounce on the reported status
+ * @get_value A function that can be called to get the value
+ * @min_value Minimum value in the range, inclusive
+ * @max_value Maximum value in the range, inclusive
+ * @hysteresis After an underflow, the value must rise above
+ *             min_value + hysteresis before it is in range again. After an
+ *             overflow, the value must fall below max_value - hysteresis
+ *             before it is in range again.
+ * @num_debounce_samples The number of consecutive samples a new status must be
+ *                       seen for before it is reported. 0 and 1 both report
+ *                       every new status immediately.
+ * @return The created in-range check, whose ownership is given to the caller
+ */
+struct InRangeCheck *App_InRangeCheck_CreateWithDebounce(
+    float (*get_value)(void),
+    float    min_value,
+    float    max_value,
+    float    hysteresis,
+    uint32_t num_debounce_samples);
+
+/**
+ * Allocate and initialize an in-range check to check whether one of a number
+ * of identical values, such as the voltage of an accumulator segment, is in
+ * the given min/max range
+ * @get_value A function that can be called to get the value at an index
+ * @index The index of the value to check, which is passed to get_value
+ * @min_value Minimum value in the range, inclusive
+ * @max_value Maximum value in the range, inclusive
+ * @return The created in-range check, whose ownership is given to the caller
+ */
+struct InRangeCheck *App_InRangeCheck_CreateForIndex(
+    float (*get_value)(size_t index),
+    size_t index,
+    float  min_value,
+    float  max_value);
+
 /**
  * Deallocate the memory used by the given in-range check
  * @param in_range_check The in-range check to deallocate
@@ -31,7 +71,16 @@ struct InRangeCheck *App_InRangeCheck_Create(
 void App_InRangeCheck_Destroy(struct InRangeCheck *in_range_check);
 
 /**
- * Get the value for the given in-range check
+ * Sample the value of the given in-range check and update its status
+ * @note This should be called once per tick, by the task that owns the given
+ *       in-range check. Every call counts as one sample towards its debounce.
+ * @param in_range_check The in-range check to evaluate
+ */
+void App_InRangeCheck_Evaluate(struct InRangeCheck *in_range_check);
+
+/**
+ * Get the value for the given in-range check, as of the last time it was
+ * evaluated
  * @note Even if the value is out-of-range, this function still writes the value
  *       to the provided buffer. It is up the the caller to use the return value
  *       to determine whether the value in the buffer is in range.
@@ -43,5 +92,15 @@ void App_InRangeCheck_Destroy(struct InRangeCheck *in_range_check);
  *         VALUE_OVERFLOW if the value is above the specified range
  */
 enum InRangeCheck_Status App_InRangeCheck_GetValue(
-    const struct InRangeCheck *const in_range_check,
-    float *                          returned_value);
+    const struct InRangeCheck *in_range_check,
+    float *                    returned_value);
+
+/**
+ * Get the status for the given in-range check, as of the last time it was
+ * evaluated
+ * @param in_range_check The in-range check to get the status for
+ * @return The status of the given in-range check (See:
+ *         `App_InRangeCheck_GetValue()`)
+ */
+enum InRangeCheck_Status
+    App_InRangeCheck_GetStatus(const struct InRangeCheck *in_range_check);
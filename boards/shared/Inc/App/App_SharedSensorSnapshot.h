@@ -0,0 +1,109 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "configs/App_SharedSensorSnapshotConfig.h"
+
+#ifndef World
+#error "Please define the 'World' type"
+#endif
+
+struct SensorSnapshot;
+
+/**
+ * Allocate and initialize a sensor snapshot. A sensor snapshot samples every
+ * registered input once into a plain struct, so code running during the rest
+ * of a tick can read a consistent set of values without going through any
+ * function pointers. The snapshot is double-buffered: sampling writes to one
+ * buffer and then publishes it, so the last published snapshot is never
+ * modified while it is being sampled.
+ * @param world The world passed to every input's sample function
+ * @param snapshot_size The size of the struct holding a snapshot, in bytes
+ * @param max_num_inputs The maximum number of inputs that can be added
+ * @return The created sensor snapshot, whose ownership is given to the caller
+ */
+struct SensorSnapshot *App_SharedSensorSnapshot_Create(
+    struct World *world,
+    size_t        snapshot_size,
+    uint32_t      max_num_inputs);
+
+/**
+ * Deallocate the memory used by the given sensor snapshot
+ * @param sensor_snapshot The sensor snapshot to deallocate
+ */
+void App_SharedSensorSnapshot_Destroy(struct SensorSnapshot *sensor_snapshot);
+
+/**
+ * Add a float input to the given sensor snapshot
+ * @param sensor_snapshot The sensor snapshot to add an input to
+ * @param offset The offset of the float to sample into, in bytes, from the
+ *               start of the snapshot struct (See: `offsetof`)
+ * @param sample The function to call to sample the input
+ */
+void App_SharedSensorSnapshot_AddFloatInput(
+    struct SensorSnapshot *sensor_snapshot,
+    size_t                 offset,
+    float (*sample)(struct World *));
+
+/**
+ * Add a bool input to the given sensor snapshot
+ * @param sensor_snapshot The sensor snapshot to add an input to
+ * @param offset The offset of the bool to sample into, in bytes, from the
+ *               start of the snapshot struct (See: `offsetof`)
+ * @param sample The function to call to sample the input
+ */
+void App_SharedSensorSnapshot_AddBoolInput(
+    struct SensorSnapshot *sensor_snapshot,
+    size_t                 offset,
+    bool (*sample)(struct World *));
+
+/**
+ * Add a uint32_t input to the given sensor snapshot
+ * @param sensor_snapshot The sensor snapshot to add an input to
+ * @param offset The offset of the uint32_t to sample into, in bytes, from the
+ *               start of the snapshot struct (See: `offsetof`)
+ * @param sample The function to call to sample the input
+ */
+void App_SharedSensorSnapshot_AddUint32Input(
+    struct SensorSnapshot *sensor_snapshot,
+    size_t                 offset,
+    uint32_t (*sample)(struct World *));
+
+/**
+ * Sample every input of the given sensor snapshot once and publish the result
+ * @note This should be called at the start of the tick that reads from the
+ *       snapshot
+ * @param sensor_snapshot The sensor snapshot to sample
+ */
+void App_SharedSensorSnapshot_Sample(struct SensorSnapshot *sensor_snapshot);
+
+/**
+ * Get the last published snapshot of the given sensor snapshot
+ * @note The returned snapshot stays valid until the snapshot is sampled twice
+ *       more, so this should only be used by the task that samples it. Other
+ *       tasks should use `App_SharedSensorSnapshot_Copy()`.
+ * @param sensor_snapshot The sensor snapshot to get the snapshot from
+ * @return The last published snapshot
+ */
+const void *
+    App_SharedSensorSnapshot_Get(const struct SensorSnapshot *sensor_snapshot);
+
+/**
+ * Copy the last published snapshot of the given sensor snapshot. The copy is
+ * consistent even if the snapshot is sampled by a higher priority task while
+ * it is being copied.
+ * @param sensor_snapshot The sensor snapshot to copy the snapshot from
+ * @param destination The struct to copy the snapshot into
+ */
+void App_SharedSensorSnapshot_Copy(
+    const struct SensorSnapshot *sensor_snapshot,
+    void *                       destination);
+
+/**
+ * Get the number of times the given sensor snapshot has been sampled
+ * @param sensor_snapshot The sensor snapshot to get the number of samples for
+ * @return The number of times the given sensor snapshot has been sampled
+ */
+uint32_t App_SharedSensorSnapshot_GetNumSamples(
+    const struct SensorSnapshot *sensor_snapshot);
@@ -1,39 +1,93 @@
 #pragma once
 
-#define STATIC_DEFINE_APP_SET_PERIODIC_CAN_SIGNALS_IN_RANGE_CHECK(             \
-    CAN_TX_INTERFACE)                                                          \
-    static enum InRangeCheck_Status App_SetPeriodicCanSignals_InRangeCheck(    \
-        struct CAN_TX_INTERFACE *  can_tx,                                     \
-        const struct InRangeCheck *in_range_check,                             \
-        void (*const can_signal_setter)(struct CAN_TX_INTERFACE *, float),     \
-        void (*const out_of_range_setter)(struct CAN_TX_INTERFACE *, uint8_t), \
-        uint8_t ok_choice, uint8_t underflow_choice, uint8_t overflow_choice)  \
-    {                                                                          \
-        float                    value;                                        \
-        enum InRangeCheck_Status status =                                      \
-            App_InRangeCheck_GetValue(in_range_check, &value);                 \
-                                                                               \
-        switch (status)                                                        \
-        {                                                                      \
-            case VALUE_IN_RANGE:                                               \
-            {                                                                  \
-                out_of_range_setter(can_tx, ok_choice);                        \
-            }                                                                  \
-            break;                                                             \
-            case VALUE_UNDERFLOW:                                              \
-            {                                                                  \
-                out_of_range_setter(can_tx, underflow_choice);                 \
-            }                                                                  \
-            break;                                                             \
-            case VALUE_OVERFLOW:                                               \
-            {                                                                  \
-                out_of_range_setter(can_tx, overflow_choice);                  \
-            }                                                                  \
-            break;                                                             \
-        }                                                                      \
-                                                                               \
-        can_signal_setter(can_tx, value);                                      \
-        return status;                                                         \
+#include <stddef.h>
+#include <stdint.h>
+#include "App_InRangeCheck.h"
+
+// The CAN choices of an out-of-range signal for each in-range check status
+struct InRangeCheckCanChoices
+{
+    uint8_t ok_choice;
+    uint8_t underflow_choice;
+    uint8_t overflow_choice;
+};
+
+// Fill in the CAN choices of an out-of-range signal from the signal names in
+// the DBC, so the OK/UNDERFLOW/OVERFLOW choices always match its value table.
+// The limits of the in-range checks aren't taken from the DBC.
+#define IN_RANGE_CHECK_CAN_CHOICES(MSG, OUT_OF_RANGE_SIGNAL)          \
+    {                                                                 \
+        CANMSGS_##MSG##_##OUT_OF_RANGE_SIGNAL##_OK_CHOICE,            \
+            CANMSGS_##MSG##_##OUT_OF_RANGE_SIGNAL##_UNDERFLOW_CHOICE, \
+            CANMSGS_##MSG##_##OUT_OF_RANGE_SIGNAL##_OVERFLOW_CHOICE   \
+    }
+
+// The CAN signals to set for an in-range check. Use
+// IN_RANGE_CHECK_CAN_SIGNALS() to fill this in from the signal names in the
+// DBC.
+#define IN_RANGE_CHECK_CAN_SIGNALS(MSG, VALUE_SIGNAL, OUT_OF_RANGE_SIGNAL) \
+    {                                                                      \
+        App_CanTx_SetPeriodicSignal_##VALUE_SIGNAL,                        \
+            App_CanTx_SetPeriodicSignal_##OUT_OF_RANGE_SIGNAL,             \
+            IN_RANGE_CHECK_CAN_CHOICES(MSG, OUT_OF_RANGE_SIGNAL)           \
+    }
+
+// Define a table-driven setter that evaluates every in-range check in a table
+// in a single loop, which should be the only place they are evaluated. If
+// statuses isn't NULL, the status of each in-range check is written to it.
+// App_GetOutOfRangeChoice() is also defined, for in-range checks sent in
+// messages of their own.
+#define STATIC_DEFINE_APP_SET_PERIODIC_CAN_SIGNALS_IN_RANGE_CHECKS(        \
+    CAN_TX_INTERFACE)                                                      \
+    struct InRangeCheckCanSignals                                          \
+    {                                                                      \
+        void (*value_setter)(struct CAN_TX_INTERFACE *, float);            \
+        void (*out_of_range_setter)(struct CAN_TX_INTERFACE *, uint8_t);   \
+        struct InRangeCheckCanChoices choices;                             \
+    };                                                                     \
+                                                                           \
+    static uint8_t App_GetOutOfRangeChoice(                                \
+        const struct InRangeCheckCanChoices *choices,                      \
+        enum InRangeCheck_Status             status)                       \
+    {                                                                      \
+        if (status == VALUE_UNDERFLOW)                                     \
+        {                                                                  \
+            return choices->underflow_choice;                              \
+        }                                                                  \
+        else if (status == VALUE_OVERFLOW)                                 \
+        {                                                                  \
+            return choices->overflow_choice;                               \
+        }                                                                  \
+        else                                                               \
+        {                                                                  \
+            return choices->ok_choice;                                     \
+        }                                                                  \
+    }                                                                      \
+                                                                           \
+    static void App_SetPeriodicCanSignals_InRangeChecks(                   \
+        struct CAN_TX_INTERFACE *            can_tx,                       \
+        struct InRangeCheck *const *         in_range_checks,              \
+        const struct InRangeCheckCanSignals *can_signals,                  \
+        size_t num_in_range_checks, enum InRangeCheck_Status *statuses)    \
+    {                                                                      \
+        for (size_t i = 0U; i < num_in_range_checks; i++)                  \
+        {                                                                  \
+            App_InRangeCheck_Evaluate(in_range_checks[i]);                 \
+                                                                           \
+            float                          value;                          \
+            const enum InRangeCheck_Status status =                        \
+                App_InRangeCheck_GetValue(in_range_checks[i], &value);     \
+                                                                           \
+            can_signals[i].out_of_range_setter(                            \
+                can_tx,                                                    \
+                App_GetOutOfRangeChoice(&can_signals[i].choices, status)); \
+            can_signals[i].value_setter(can_tx, value);                    \
+                                                                           \
+            if (statuses != NULL)                                          \
+            {                                                              \
+                statuses[i] = status;                                      \
+            }                                                              \
+        }                                                                  \
     }
 
 #define STATIC_DEFINE_APP_SET_PERIODIC_CAN_SIGNALS_BINARY_STATUS(            \
@@ -53,3 +107,51 @@
             can_signal_setter(can_tx, off_choice);                           \
         }                                                                    \
     }
+
+// Define a setter that publishes a summary of the transition trace of a state
+// machine, and the 100Hz tick durations of its current state. The board's DBC
+// must define the signals of BMS_STATE_MACHINE_TRACE,
+// BMS_STATE_MACHINE_TRANSITION_TICK and BMS_STATE_MACHINE_TICK_DURATIONS under
+// the same names, and get_state_choice must return the CAN choice of a state
+// in the board's STATE_MACHINE message.
+#define STATIC_DEFINE_APP_SET_PERIODIC_CAN_SIGNALS_STATE_MACHINE_TRACE(      \
+    CAN_TX_INTERFACE)                                                        \
+    static void App_SetPeriodicCanSignals_SharedStateMachineTrace(           \
+        struct CAN_TX_INTERFACE *  can_tx,                                   \
+        const struct StateMachine *state_machine,                            \
+        uint8_t (*const get_state_choice)(const struct State *))             \
+    {                                                                        \
+        App_CanTx_SetPeriodicSignal_NUM_STATE_TRANSITIONS(                   \
+            can_tx, (uint16_t)App_SharedStateMachine_GetNumTransitions(      \
+                        state_machine));                                     \
+                                                                             \
+        struct StateTransition transition;                                   \
+        if (EXIT_OK(App_SharedStateMachine_GetTransition(                    \
+                state_machine, 0U, &transition)))                            \
+        {                                                                    \
+            App_CanTx_SetPeriodicSignal_LAST_TRANSITION_PREVIOUS_STATE(      \
+                can_tx, get_state_choice(transition.previous_state));        \
+            App_CanTx_SetPeriodicSignal_LAST_TRANSITION_NEXT_STATE(          \
+                can_tx, get_state_choice(transition.next_state));            \
+            App_CanTx_SetPeriodicSignal_LAST_TRANSITION_TIME(                \
+                can_tx, transition.timestamp_ms);                            \
+            App_CanTx_SetPeriodicSignal_LAST_TRANSITION_TICK_RATE(           \
+                can_tx,                                                      \
+                transition.tick_rate == STATE_MACHINE_TICK_1HZ ? 1U : 100U); \
+            App_CanTx_SetPeriodicSignal_LAST_TRANSITION_TICK_COUNT(          \
+                can_tx, transition.tick_count);                              \
+        }                                                                    \
+                                                                             \
+        struct StateTickStatistics statistics;                               \
+        if (EXIT_OK(App_SharedStateMachine_GetTickStatistics(                \
+                state_machine,                                               \
+                App_SharedStateMachine_GetCurrentState(state_machine),       \
+                STATE_MACHINE_TICK_100HZ, &statistics)))                     \
+        {                                                                    \
+            App_CanTx_SetPeriodicSignal_MAX_TICK_100_HZ_DURATION(            \
+                can_tx, statistics.max_duration);                            \
+            App_CanTx_SetPeriodicSignal_MEAN_TICK_100_HZ_DURATION(           \
+                can_tx,                                                      \
+                App_SharedStateMachine_GetMeanTickDuration(&statistics));    \
+        }                                                                    \
+    }
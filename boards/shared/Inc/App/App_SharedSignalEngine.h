@@ -0,0 +1,133 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "configs/App_SharedSignalConfig.h"
+
+#ifndef World
+#error "Please define the 'World' type"
+#endif
+
+struct SignalEngine;
+
+struct SignalCallback
+{
+    // How long the signal's entry condition must be continuously high for, in
+    // milliseconds, before the callback function is triggered
+    uint32_t entry_condition_high_duration_ms;
+
+    // How long the signal's exit condition signal must be continuously high
+    // for, in milliseconds, before the callback function is no longer triggered
+    uint32_t exit_condition_high_duration_ms;
+
+    // The callback function
+    void (*function)(struct World *);
+};
+
+struct WaitSignalCallback
+{
+    // Wait duration before the callback function is called
+    uint32_t wait_duration_ms;
+
+    // The callback function to call when the wait has completed
+    void (*function)(struct World *);
+};
+
+/**
+ * Allocate and initialize a signal engine. A signal engine holds many signals
+ * and wait signals, evaluates their conditions once per tick, and keeps their
+ * pending debounce deadlines in a timer wheel with one slot per signal, so
+ * deadlines are found without checking every signal.
+ * @param initial_time_ms The initial time, in milliseconds, used to initialize
+ *                        the internal state of the signal engine
+ * @param world The world passed to every condition and callback function
+ * @param max_num_signals The maximum number of signals and wait signals that
+ *                        can be added to the signal engine
+ * @return The created signal engine, whose ownership is given to the caller
+ */
+struct SignalEngine *App_SharedSignalEngine_Create(
+    uint32_t      initial_time_ms,
+    struct World *world,
+    uint32_t      max_num_signals);
+
+/**
+ * Deallocate the memory used by the given signal engine
+ * @param signal_engine The signal engine to deallocate
+ */
+void App_SharedSignalEngine_Destroy(struct SignalEngine *signal_engine);
+
+/**
+ * Add a signal to the given signal engine. Once the entry condition has been
+ * continuously high for `entry_condition_high_duration_ms`, the callback
+ * function is triggered and called on every tick, until the exit condition has
+ * been continuously high for `exit_condition_high_duration_ms`.
+ * @param signal_engine The signal engine to add a signal to
+ * @param is_entry_condition_high A function that can be called to check if the
+ * entry condition for the signal is high
+ * @param is_exit_condition_high A function that can be called to check if the
+ * exit condition for the signal is high
+ * @param callback The signal callback for the signal
+ * @return The ID of the added signal, used to query the signal
+ */
+uint32_t App_SharedSignalEngine_AddSignal(
+    struct SignalEngine *signal_engine,
+    bool (*is_entry_condition_high)(struct World *),
+    bool (*is_exit_condition_high)(struct World *),
+    struct SignalCallback callback);
+
+/**
+ * Add a wait signal to the given signal engine. A wait signal starts waiting
+ * on the first tick it is high, and calls its callback function once, on the
+ * first tick after it has waited for one less than `wait_duration_ms`. The
+ * wait signal isn't checked while it is waiting.
+ * @param signal_engine The signal engine to add a wait signal to
+ * @param is_high A function that can be called to check if the wait signal is
+ * high
+ * @param callback The signal callback for the wait signal. The wait duration
+ *                 must be greater than 0.
+ * @return The ID of the added wait signal, used to query the wait signal
+ */
+uint32_t App_SharedSignalEngine_AddWaitSignal(
+    struct SignalEngine *signal_engine,
+    bool (*is_high)(struct World *),
+    struct WaitSignalCallback callback);
+
+/**
+ * Get the number of signals and wait signals added to the given signal engine
+ * @param signal_engine The signal engine to get the number of signals from
+ * @return The number of signals and wait signals in the given signal engine
+ */
+uint32_t App_SharedSignalEngine_GetNumSignals(
+    const struct SignalEngine *signal_engine);
+
+/**
+ * Check if the callback function for the given signal is triggered
+ * @param signal_engine The signal engine the signal was added to
+ * @param signal_id The ID of the signal to check
+ * @return true if the callback function is triggered, false if it is not
+ */
+bool App_SharedSignalEngine_IsCallbackTriggered(
+    const struct SignalEngine *signal_engine,
+    uint32_t                   signal_id);
+
+/**
+ * Check if the given wait signal is waiting
+ * @param signal_engine The signal engine the wait signal was added to
+ * @param wait_signal_id The ID of the wait signal to check
+ * @return true if the wait signal is waiting, false if it is not
+ */
+bool App_SharedSignalEngine_IsWaiting(
+    const struct SignalEngine *signal_engine,
+    uint32_t                   wait_signal_id);
+
+/**
+ * Update every signal and wait signal in the given signal engine
+ * @note The signals are updated in the order they were added. Each signal calls
+ * its condition functions once (wait signals only while they aren't waiting)
+ * and then its callback function, if it is triggered or its wait is over.
+ * @param signal_engine The signal engine to update
+ * @param current_time_ms The current time, in milliseconds
+ */
+void App_SharedSignalEngine_Tick(
+    struct SignalEngine *signal_engine,
+    uint32_t             current_time_ms);
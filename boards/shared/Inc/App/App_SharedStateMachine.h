@@ -1,9 +1,25 @@
 #pragma once
 
+#include <stdint.h>
+#ifndef __arm__
+#include <stdio.h>
+#endif
+#include "App_SharedExitCode.h"
 #include "configs/App_SharedStateMachineConfig.h"
 
 #define MAX_STATE_NAME_LENGTH 16
 
+// The number of most recent state transitions kept in the transition trace
+#define STATE_MACHINE_TRANSITION_TRACE_SIZE 16U
+
+// The maximum number of distinct states that tick durations are recorded for
+#define STATE_MACHINE_MAX_NUM_TRACED_STATES 8U
+
+// Tick durations are binned by floor(log2(duration)). Bin 0 also holds zero
+// durations, and the last bin holds every duration that is too long for the
+// other bins.
+#define STATE_MACHINE_NUM_TICK_DURATION_BINS 24U
+
 #ifndef World
 #error "Please define the 'World' type"
 #endif
@@ -20,6 +36,45 @@ struct State
     void (*run_on_exit)(struct StateMachine *state_machine);
 };
 
+enum StateMachineTickRate
+{
+    STATE_MACHINE_TICK_1HZ,
+    STATE_MACHINE_TICK_100HZ,
+    NUM_STATE_MACHINE_TICK_RATES,
+};
+
+struct StateTransition
+{
+    // The state that was exited
+    const struct State *previous_state;
+
+    // The state that was entered
+    const struct State *next_state;
+
+    // When the transition happened, in milliseconds
+    uint32_t timestamp_ms;
+
+    // The tick function that requested the transition, and how many times that
+    // tick function had been run (including the triggering tick)
+    enum StateMachineTickRate tick_rate;
+    uint32_t                  tick_count;
+};
+
+struct StateTickStatistics
+{
+    // The number of tick durations recorded
+    uint32_t num_samples;
+
+    // Tick durations, in the units of the cycle counter set with
+    // App_SharedStateMachine_SetCycleCounter
+    uint32_t min_duration;
+    uint32_t max_duration;
+    uint64_t total_duration;
+
+    // Histogram of tick durations (See: STATE_MACHINE_NUM_TICK_DURATION_BINS)
+    uint32_t histogram[STATE_MACHINE_NUM_TICK_DURATION_BINS];
+};
+
 /**
  * Create a state machine with the given world
  * @param world A world that will be used by the state machine for all of it's
@@ -76,3 +131,76 @@ void App_SharedStateMachine_Tick1Hz(struct StateMachine *state_machine);
  * @param state_machine The state machine to tick
  */
 void App_SharedStateMachine_Tick100Hz(struct StateMachine *state_machine);
+
+/**
+ * Set the cycle counter used to measure the tick durations of the given state
+ * machine. Tick durations are not recorded until a cycle counter is set.
+ * @param state_machine The state machine to set the cycle counter of
+ * @param get_cycle_count A function returning the value of a free-running
+ *                        counter, of which only the difference between two
+ *                        readings is used
+ */
+void App_SharedStateMachine_SetCycleCounter(
+    struct StateMachine *state_machine,
+    uint32_t (*get_cycle_count)(void));
+
+/**
+ * Get the number of state transitions the given state machine has made since
+ * it was created. This may be larger than the number of transitions kept in
+ * the transition trace.
+ * @param state_machine The state machine to get the number of transitions for
+ * @return The number of state transitions made by the given state machine
+ */
+uint32_t App_SharedStateMachine_GetNumTransitions(
+    const struct StateMachine *state_machine);
+
+/**
+ * Get a state transition from the transition trace of the given state machine
+ * @param state_machine The state machine to get the state transition from
+ * @param index How far back in the trace to look, where 0 is the most recent
+ *              transition
+ * @param transition This will be set to the requested state transition
+ * @return EXIT_CODE_OK if the transition was written to the given buffer
+ *         EXIT_CODE_OUT_OF_RANGE if the trace doesn't hold a transition at the
+ *         given index
+ */
+ExitCode App_SharedStateMachine_GetTransition(
+    const struct StateMachine *state_machine,
+    uint32_t                   index,
+    struct StateTransition *   transition);
+
+/**
+ * Get the tick duration statistics of the given state
+ * @param state_machine The state machine that ticked the given state
+ * @param state The state to get tick duration statistics for
+ * @param tick_rate The tick function to get tick duration statistics for
+ * @param statistics This will be set to the tick duration statistics
+ * @return EXIT_CODE_OK if the statistics were written to the given buffer
+ *         EXIT_CODE_INVALID_ARGS if the tick durations of the given state have
+ *         never been recorded by the given state machine
+ */
+ExitCode App_SharedStateMachine_GetTickStatistics(
+    const struct StateMachine * state_machine,
+    const struct State *        state,
+    enum StateMachineTickRate   tick_rate,
+    struct StateTickStatistics *statistics);
+
+/**
+ * Get the mean tick duration from the given tick duration statistics
+ * @param statistics The tick duration statistics to get the mean from
+ * @return The mean tick duration, in cycle counter units
+ */
+uint32_t App_SharedStateMachine_GetMeanTickDuration(
+    const struct StateTickStatistics *statistics);
+
+#ifndef __arm__
+/**
+ * Print the transition trace and tick duration statistics of the given state
+ * machine in a human-readable format
+ * @param state_machine The state machine to print the trace for
+ * @param stream The stream to print to
+ */
+void App_SharedStateMachine_DumpTrace(
+    const struct StateMachine *state_machine,
+    FILE *                     stream);
+#endif
@@ -2,8 +2,19 @@
 
 #include <stm32f3xx.h>
 
+/**
+ * Get the voltage of the least significant bit of the raw ADC values measured
+ * by the given ADC handle
+ * @param hadc ADC handle
+ * @return The voltage of the least significant bit of the raw ADC values
+ */
+float Io_SharedAdc_GetVoltagePerLsb(const ADC_HandleTypeDef *hadc);
+
 /**
  * Convert the given raw ADC value measured by the given ADC handle into voltage
+ * @note This looks up the resolution of the ADC on every call. Prefer
+ *       Io_SharedDmaAdc, which scales the raw ADC values by factors computed
+ *       once at initialization.
  * @param hadc ADC handle
  * @param raw_adc_value Raw ADC value
  * @return The voltage converted from the given raw ADC value
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct AdcConversions;
+
+// The conversion of an ADC channel's raw ADC values into its value
+struct AdcChannelConfig
+{
+    // The number of the latest conversion sets that the raw ADC values of this
+    // channel are averaged over. It must be between 1 and the number of
+    // conversion sets converted at a time.
+    size_t oversampling_ratio;
+
+    // The value of this channel is given by:
+    //
+    //     value = gain x voltage + offset
+    //
+    // where voltage is the averaged voltage measured by the ADC. Use a gain of
+    // 1 and an offset of 0 to get the voltage measured by the ADC.
+    float gain;
+    float offset;
+};
+
+/**
+ * Allocate and initialize the conversions of raw ADC values into the values of
+ * the given ADC channels
+ *
+ * @note The raw ADC values are converted a number of conversion sets at a
+ *       time, where each conversion set holds one raw ADC value per channel in
+ *       the order of the channels' ranks. The voltage per LSB, averaging and
+ *       per-channel gain are folded into a single scale factor per channel
+ *       here, so converting the raw ADC values takes one multiply-add per
+ *       channel.
+ * @param num_channels: The number of channels in every conversion set
+ * @param num_conversion_sets: The number of conversion sets converted at a time
+ * @param voltage_per_lsb: The voltage of the least significant bit of the raw
+ *                         ADC values (V)
+ * @param channel_configs: The configuration of every channel, in the order of
+ *                         the channels' ranks
+ * @return Pointer to the allocated and initialized conversions
+ */
+struct AdcConversions *Io_SharedAdcConversions_Create(
+    size_t                         num_channels,
+    size_t                         num_conversion_sets,
+    float                          voltage_per_lsb,
+    const struct AdcChannelConfig *channel_configs);
+
+/**
+ * Deallocate the memory used by the given conversions
+ * @param adc_conversions: The conversions to deallocate
+ */
+void Io_SharedAdcConversions_Destroy(struct AdcConversions *adc_conversions);
+
+/**
+ * Convert the given conversion sets into the values of every channel, and
+ * publish them in one go
+ * @note This function is meant to be called from the ADC interrupt, while the
+ *       given conversion sets aren't being written to by the DMA
+ * @param adc_conversions: The conversions to convert the raw ADC values with
+ * @param raw_adc_values: The conversion sets to convert, oldest first
+ */
+void Io_SharedAdcConversions_Convert(
+    struct AdcConversions *  adc_conversions,
+    const volatile uint16_t *raw_adc_values);
+
+/**
+ * Convert every one of the given conversion sets into the values of every
+ * channel, without averaging them
+ * @note Unlike Io_SharedAdcConversions_Convert, this doesn't publish the
+ *       values, so it is meant for processing every sample of a channel
+ * @param adc_conversions: The conversions to convert the raw ADC values with
+ * @param raw_adc_values: The conversion sets to convert, oldest first
+ * @param values: Set to the values of every channel for each conversion set,
+ *                in the same order as the raw ADC values
+ */
+void Io_SharedAdcConversions_ConvertEachSet(
+    const struct AdcConversions *adc_conversions,
+    const volatile uint16_t *    raw_adc_values,
+    float *                      values);
+
+/**
+ * Get the value of the given channel from the latest converted conversion sets
+ * @param adc_conversions: The conversions to get the value from
+ * @param channel: The index of the channel, in the order of the channels' ranks
+ * @return The value of the given channel, or 0 if no conversion sets have been
+ *         converted yet
+ */
+float Io_SharedAdcConversions_GetValue(
+    const struct AdcConversions *adc_conversions,
+    size_t                       channel);
+
+/**
+ * Copy the values of every channel from the latest converted conversion sets,
+ * all of which are from the same conversion sets even if new conversion sets
+ * are converted while they are being copied
+ * @param adc_conversions: The conversions to get the values from
+ * @param values: The array to copy the values into, which must hold a value
+ *                for every channel
+ */
+void Io_SharedAdcConversions_GetValues(
+    const struct AdcConversions *adc_conversions,
+    float *                      values);
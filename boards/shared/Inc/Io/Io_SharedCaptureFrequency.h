@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct CaptureFrequency;
+
+/**
+ * Allocate and initialize an estimator for the frequency of a PWM input, from
+ * the timestamps of its rising edges captured by a 16-bit timer into a
+ * circular buffer
+ *
+ * @note The frequency is averaged over as many periods as fit in the given
+ *       averaging window, so it is averaged over many periods at high
+ *       frequencies and measured from the latest period at low frequencies
+ * @param tim_frequency_hz: The frequency of the timer capturing the timestamps
+ * @param tim_auto_reload_reg: Maximum value that the counter can count to
+ * @param averaging_window_s: The time to average the frequency over (s)
+ * @param min_frequency_hz: The lowest frequency that can be measured. If no
+ *                          rising edge has been captured for as long as its
+ *                          period, the PWM input is considered inactive (i.e.
+ *                          DC signal) and its frequency is 0Hz. Its period
+ *                          must be shorter than the period of the counter.
+ * @return Pointer to the allocated and initialized estimator
+ */
+struct CaptureFrequency *Io_SharedCaptureFrequency_Create(
+    float    tim_frequency_hz,
+    uint32_t tim_auto_reload_reg,
+    float    averaging_window_s,
+    float    min_frequency_hz);
+
+/**
+ * Deallocate the memory used by the given estimator
+ * @param capture_frequency: The estimator to deallocate
+ */
+void Io_SharedCaptureFrequency_Destroy(
+    struct CaptureFrequency *capture_frequency);
+
+/**
+ * Update the frequency from the timestamps captured since the last update
+ * @note This function must be called more often than the counter overflows,
+ *       and before the buffer fills up with timestamps captured since the last
+ *       update
+ * @param capture_frequency: The estimator to update
+ * @param timestamps: The circular buffer of captured timestamps
+ * @param num_timestamps: The number of timestamps the buffer can hold
+ * @param write_index: The index the next timestamp will be captured into
+ * @param counter: The current value of the counter
+ */
+void Io_SharedCaptureFrequency_Update(
+    struct CaptureFrequency *capture_frequency,
+    const volatile uint16_t *timestamps,
+    size_t                   num_timestamps,
+    size_t                   write_index,
+    uint32_t                 counter);
+
+/**
+ * Get the frequency estimated by the given estimator
+ * @param capture_frequency: The estimator to get the frequency from
+ * @return The frequency of the PWM input, in Hz
+ */
+float Io_SharedCaptureFrequency_GetFrequency(
+    const struct CaptureFrequency *capture_frequency);
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Enable the DWT cycle counter, which counts the CPU cycles since it was
+ * enabled and wraps around every 2^32 cycles
+ */
+void Io_SharedCycleCounter_Init(void);
+
+/**
+ * Get the current value of the DWT cycle counter. Only the difference between
+ * two readings is meaningful, since the counter is free-running.
+ * @return The current CPU cycle count
+ */
+uint32_t Io_SharedCycleCounter_GetCycleCount(void);
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stm32f3xx_hal.h>
+#include "Io_SharedAdcConversions.h"
+
+struct DmaAdc;
+
+/**
+ * Allocate and initialize an ADC whose conversions are written into a double
+ * buffer by DMA, and start its conversions
+ *
+ * @note The DMA writes one half of the buffer while the other half is
+ *       converted, so the raw ADC values are never read while they are being
+ *       written. Each half holds the given number of conversion sets, which
+ *       decimates the values of the channels to the frequency of the ADC's
+ *       trigger over the number of conversion sets.
+ * @note The given ADC must be initialized with DMA continuous requests, and its
+ *       DMA channel must be linked to it and initialized in circular mode with
+ *       halfword transfers from the peripheral to memory
+ * @param hadc: The handle of the ADC
+ * @param num_conversion_sets: The number of conversion sets in each half of
+ *                             the buffer
+ * @param channel_configs: The configuration of every channel of the ADC, in
+ *                         the order of the channels' ranks
+ * @return Pointer to the allocated and initialized ADC
+ */
+struct DmaAdc *Io_SharedDmaAdc_Create(
+    ADC_HandleTypeDef *            hadc,
+    size_t                         num_conversion_sets,
+    const struct AdcChannelConfig *channel_configs);
+
+/**
+ * Check if the given ADC handle is the handle of the given ADC
+ * @param dma_adc: The ADC to check
+ * @param hadc: The ADC handle to check
+ * @return true if the given ADC handle is the handle of the given ADC, else
+ *         false
+ */
+bool Io_SharedDmaAdc_IsHandle(
+    const struct DmaAdc *    dma_adc,
+    const ADC_HandleTypeDef *hadc);
+
+/**
+ * Set the function to call with the values of every conversion set, each time
+ * a half of the buffer is converted
+ * @note The callback is called from the ADC's DMA interrupt, so it must be
+ *       short. This is meant for processing every sample of a channel, rather
+ *       than the averaged values.
+ * @note This must be called before the ADC's trigger is started
+ * @param dma_adc: The ADC to set the callback for
+ * @param callback: The function to call with the values of every channel for
+ *                  each conversion set, oldest first, and the number of
+ *                  conversion sets
+ */
+void Io_SharedDmaAdc_SetConversionSetsCallback(
+    struct DmaAdc *dma_adc,
+    void (*callback)(const float *values, size_t num_conversion_sets));
+
+/**
+ * Convert the conversion sets in the first half of the buffer, which the DMA
+ * has just finished writing
+ * @note This function must be called from HAL_ADC_ConvHalfCpltCallback
+ * @param dma_adc: The ADC to convert the conversion sets for
+ */
+void Io_SharedDmaAdc_ConvertFirstHalf(struct DmaAdc *dma_adc);
+
+/**
+ * Convert the conversion sets in the second half of the buffer, which the DMA
+ * has just finished writing
+ * @note This function must be called from HAL_ADC_ConvCpltCallback
+ * @param dma_adc: The ADC to convert the conversion sets for
+ */
+void Io_SharedDmaAdc_ConvertSecondHalf(struct DmaAdc *dma_adc);
+
+/**
+ * Get the value of the given channel from the latest converted conversion sets
+ * @param dma_adc: The ADC to get the value from
+ * @param channel: The index of the channel, in the order of the channels' ranks
+ * @return The value of the given channel
+ */
+float Io_SharedDmaAdc_GetValue(const struct DmaAdc *dma_adc, size_t channel);
+
+/**
+ * Copy the values of every channel, all from the same converted conversion sets
+ * @note This function must not be called from an interrupt that can preempt
+ *       the ADC's DMA interrupt
+ * @param dma_adc: The ADC to get the values from
+ * @param values: The array to copy the values into, which must hold a value
+ *                for every channel
+ */
+void Io_SharedDmaAdc_GetValues(const struct DmaAdc *dma_adc, float *values);
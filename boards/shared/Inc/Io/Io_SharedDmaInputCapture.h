@@ -0,0 +1,73 @@
+#pragma once
+
+#include <stm32f3xx_hal.h>
+
+// The number of rising edges the DMA can capture between two updates. This
+// must cover the highest frequency measured over the longest update period.
+#define NUM_DMA_CAPTURED_TIMESTAMPS 64U
+
+struct DmaInputCapture;
+
+/**
+ * Allocate and initialize a PWM input whose rising edges are captured by the
+ * given (hardware) timer, and written into a circular buffer by DMA. Unlike
+ * the frequency-only PWM input, no interrupt is taken per rising edge. The
+ * frequency is estimated from the captured rising edges whenever the PWM input
+ * is updated.
+ *
+ * @note The given timer must be initialized with Input Capture Direct Mode,
+ *       and the DMA channel of the given timer channel must be linked to the
+ *       timer and initialized in circular mode with halfword transfers from
+ *       the peripheral to memory
+ * @param htim: The handle of the timer measuring the PWM input
+ * @param tim_frequency_hz: The frequency of the timer measuring the PWM input
+ * @param tim_channel: The timer channel measuring the PWM input
+ * @param tim_auto_reload_reg: Maximum value that the counter can count to
+ * @param averaging_window_s: The time to average the frequency over (s)
+ * @param min_frequency_hz: The lowest frequency that can be measured, below
+ *                          which the PWM input is considered inactive
+ * @return Pointer to the allocated and initialized PWM input
+ */
+struct DmaInputCapture *Io_SharedDmaInputCapture_Create(
+    TIM_HandleTypeDef *htim,
+    float              tim_frequency_hz,
+    uint32_t           tim_channel,
+    uint32_t           tim_auto_reload_reg,
+    float              averaging_window_s,
+    float              min_frequency_hz);
+
+/**
+ * Update the frequency for the given PWM input from the rising edges captured
+ * since it was last updated
+ * @note This function must be called periodically, more often than the timer
+ *       overflows
+ * @param pwm_input: The PWM input to update
+ */
+void Io_SharedDmaInputCapture_Update(struct DmaInputCapture *pwm_input);
+
+/**
+ * Read the timestamps of the rising edges captured since they were last read,
+ * for PWM inputs that need every rising edge instead of their frequency
+ * @note This is independent of the frequency updated by
+ *       Io_SharedDmaInputCapture_Update, and must also be called more often
+ *       than the timer overflows
+ * @param pwm_input: The PWM input to read the timestamps for
+ * @param timestamps: The array to read the timestamps into, oldest first
+ * @param max_num_timestamps: The number of timestamps the array can hold
+ * @param counter: Set to the value of the counter after the rising edges read
+ *                 were captured
+ * @return The number of timestamps read
+ */
+size_t Io_SharedDmaInputCapture_ReadTimestamps(
+    struct DmaInputCapture *pwm_input,
+    uint16_t *              timestamps,
+    size_t                  max_num_timestamps,
+    uint32_t *              counter);
+
+/**
+ * Get the frequency for the given PWM input
+ * @param pwm_input: The PWM input to get frequency for
+ * @return The frequency for the given PWM input
+ */
+float Io_SharedDmaInputCapture_GetFrequency(
+    const struct DmaInputCapture *pwm_input);
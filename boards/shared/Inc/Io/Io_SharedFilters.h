@@ -1,25 +1,275 @@
 /**
  * @brief Shared library with filters for digital signal processing
+ *
+ * Every filter keeps its state between calls, and filters a block of samples
+ * at a time so a whole DMA buffer can be filtered in one call. A single sample
+ * is filtered as a block of one. The output may be the same array as the
+ * input.
+ *
+ * Every filter comes in a float variant and a Q15 variant. Q15 samples are
+ * signed 16-bit fixed-point numbers with 15 fractional bits (i.e. -1.0 to
+ * 1.0 - 2^-15), although raw ADC values can be filtered as Q15 samples as is.
+ * The Q15 variants saturate instead of wrapping around.
  */
 #pragma once
 
-#include <stm32f3xx_hal.h>
-#include <arm_math.h>
+#include <stddef.h>
+#include <stdint.h>
 
 /**
- * @brief Apply low pass filter on a given array of values based on the
- *        implementation described here:
- *        https://en.wikipedia.org/wiki/Low-pass_filter#Discrete-time_realization
+ * First-order low pass filter, or exponential moving average, described here:
+ * https://en.wikipedia.org/wiki/Low-pass_filter#Discrete-time_realization
+ *
+ *     y[n] = y[n-1] + alpha * (x[n] - y[n-1]), alpha = dt / (RC + dt)
+ *
+ * The output starts at the first input sample instead of 0.
+ */
+struct EmaFilter;
+struct EmaFilterQ15;
+
+/**
+ * Cascade of biquad filters in direct form I. Each stage is given by the
+ * coefficients { b0, b1, b2, a1, a2 }, with the feedback coefficients negated
+ * as in CMSIS-DSP:
+ *
+ *     y[n] = b0 * x[n] + b1 * x[n-1] + b2 * x[n-2] + a1 * y[n-1] + a2 * y[n-2]
+ *
+ * The Q15 coefficients are scaled down by 2^post_shift, so coefficients of up
+ * to 2^post_shift in magnitude can be represented, and every stage's output is
+ * scaled back up by 2^post_shift.
+ */
+struct BiquadCascade;
+struct BiquadCascadeQ15;
+
+/**
+ * FIR filter followed by a decimator, which only computes the filter's output
+ * for every decimation_factor-th input sample. The first output is computed
+ * once decimation_factor input samples have been filtered.
+ */
+struct FirDecimator;
+struct FirDecimatorQ15;
+
+/**
+ * Moving median over a window of the latest input samples, which rejects
+ * spikes shorter than half of the window. Until the window is full, the median
+ * is taken over the input samples so far.
+ */
+struct MovingMedian;
+struct MovingMedianQ15;
+
+/**
+ * Rate limiter, which limits how much the output can rise or fall between two
+ * samples. The output starts at the first input sample.
+ */
+struct RateLimiter;
+struct RateLimiterQ15;
+
+/**
+ * Allocate and initialize a first-order low pass filter
+ * @param sampling_time_s Sampling time interval of the input samples (s)
+ * @param rc RC time constant (s)
+ * @return Pointer to the allocated and initialized filter
+ */
+struct EmaFilter *
+    Io_SharedFilters_CreateEmaFilter(float sampling_time_s, float rc);
+
+/**
+ * Allocate and initialize a first-order low pass filter for Q15 samples
+ * @param sampling_time_s Sampling time interval of the input samples (s)
+ * @param rc RC time constant (s)
+ * @return Pointer to the allocated and initialized filter
+ */
+struct EmaFilterQ15 *
+    Io_SharedFilters_CreateEmaFilterQ15(float sampling_time_s, float rc);
+
+/**
+ * Allocate and initialize a biquad cascade
+ * @param num_stages Number of biquad stages
+ * @param coefficients The coefficients { b0, b1, b2, a1, a2 } of every stage,
+ *                     which are copied
+ * @return Pointer to the allocated and initialized filter
+ */
+struct BiquadCascade *Io_SharedFilters_CreateBiquadCascade(
+    size_t       num_stages,
+    const float *coefficients);
+
+/**
+ * Allocate and initialize a biquad cascade for Q15 samples
+ * @param num_stages Number of biquad stages
+ * @param coefficients The Q15 coefficients { b0, b1, b2, a1, a2 } of every
+ *                     stage, scaled down by 2^post_shift, which are copied
+ * @param post_shift The number of bits the coefficients are scaled down by
+ * @return Pointer to the allocated and initialized filter
+ */
+struct BiquadCascadeQ15 *Io_SharedFilters_CreateBiquadCascadeQ15(
+    size_t         num_stages,
+    const int16_t *coefficients,
+    uint8_t        post_shift);
+
+/**
+ * Allocate and initialize a FIR decimator
+ * @param num_taps Number of FIR filter taps
+ * @param coefficients The FIR filter coefficients, in the order they multiply
+ *                     the newest to the oldest input sample, which are copied
+ * @param decimation_factor The number of input samples per output sample
+ * @return Pointer to the allocated and initialized filter
+ */
+struct FirDecimator *Io_SharedFilters_CreateFirDecimator(
+    size_t       num_taps,
+    const float *coefficients,
+    size_t       decimation_factor);
+
+/**
+ * Allocate and initialize a FIR decimator for Q15 samples
+ * @param num_taps Number of FIR filter taps
+ * @param coefficients The Q15 FIR filter coefficients, in the order they
+ *                     multiply the newest to the oldest input sample, which are
+ *                     copied
+ * @param decimation_factor The number of input samples per output sample
+ * @return Pointer to the allocated and initialized filter
+ */
+struct FirDecimatorQ15 *Io_SharedFilters_CreateFirDecimatorQ15(
+    size_t         num_taps,
+    const int16_t *coefficients,
+    size_t         decimation_factor);
+
+/**
+ * Allocate and initialize a moving median
+ * @param window_size Number of input samples to take the median over, which
+ *                    must be odd
+ * @return Pointer to the allocated and initialized filter
+ */
+struct MovingMedian *Io_SharedFilters_CreateMovingMedian(size_t window_size);
+
+/**
+ * Allocate and initialize a moving median for Q15 samples
+ * @param window_size Number of input samples to take the median over, which
+ *                    must be odd
+ * @return Pointer to the allocated and initialized filter
+ */
+struct MovingMedianQ15 *
+    Io_SharedFilters_CreateMovingMedianQ15(size_t window_size);
+
+/**
+ * Allocate and initialize a rate limiter
+ * @param sampling_time_s Sampling time interval of the input samples (s)
+ * @param max_rise_rate The maximum rate the output can rise at, in units of
+ *                      the samples per second
+ * @param max_fall_rate The maximum rate the output can fall at, in units of
+ *                      the samples per second
+ * @return Pointer to the allocated and initialized filter
+ */
+struct RateLimiter *Io_SharedFilters_CreateRateLimiter(
+    float sampling_time_s,
+    float max_rise_rate,
+    float max_fall_rate);
+
+/**
+ * Allocate and initialize a rate limiter for Q15 samples
+ * @param max_rise_per_sample The maximum the output can rise by per sample
+ * @param max_fall_per_sample The maximum the output can fall by per sample
+ * @return Pointer to the allocated and initialized filter
+ */
+struct RateLimiterQ15 *Io_SharedFilters_CreateRateLimiterQ15(
+    uint16_t max_rise_per_sample,
+    uint16_t max_fall_per_sample);
+
+/**
+ * Deallocate the memory used by the given filter
+ * @param filter The filter to deallocate
+ */
+void Io_SharedFilters_DestroyEmaFilter(struct EmaFilter *filter);
+void Io_SharedFilters_DestroyEmaFilterQ15(struct EmaFilterQ15 *filter);
+void Io_SharedFilters_DestroyBiquadCascade(struct BiquadCascade *filter);
+void Io_SharedFilters_DestroyBiquadCascadeQ15(struct BiquadCascadeQ15 *filter);
+void Io_SharedFilters_DestroyFirDecimator(struct FirDecimator *filter);
+void Io_SharedFilters_DestroyFirDecimatorQ15(struct FirDecimatorQ15 *filter);
+void Io_SharedFilters_DestroyMovingMedian(struct MovingMedian *filter);
+void Io_SharedFilters_DestroyMovingMedianQ15(struct MovingMedianQ15 *filter);
+void Io_SharedFilters_DestroyRateLimiter(struct RateLimiter *filter);
+void Io_SharedFilters_DestroyRateLimiterQ15(struct RateLimiterQ15 *filter);
+
+/**
+ * Clear the state of the given filter, as if no samples had been filtered
+ * @param filter The filter to reset
+ */
+void Io_SharedFilters_ResetEmaFilter(struct EmaFilter *filter);
+void Io_SharedFilters_ResetEmaFilterQ15(struct EmaFilterQ15 *filter);
+void Io_SharedFilters_ResetBiquadCascade(struct BiquadCascade *filter);
+void Io_SharedFilters_ResetBiquadCascadeQ15(struct BiquadCascadeQ15 *filter);
+void Io_SharedFilters_ResetFirDecimator(struct FirDecimator *filter);
+void Io_SharedFilters_ResetFirDecimatorQ15(struct FirDecimatorQ15 *filter);
+void Io_SharedFilters_ResetMovingMedian(struct MovingMedian *filter);
+void Io_SharedFilters_ResetMovingMedianQ15(struct MovingMedianQ15 *filter);
+void Io_SharedFilters_ResetRateLimiter(struct RateLimiter *filter);
+void Io_SharedFilters_ResetRateLimiterQ15(struct RateLimiterQ15 *filter);
+
+/**
+ * Filter a block of samples with the given filter
+ * @param filter The filter to filter the samples with
  * @param input Pointer to an array of input samples
- * @param output Pointer to an array of output samples
- * @param num_samples Number of samples
- * @param sampling_time Sampling time interval for input and output samples
- *                      in seconds
- * @param rc RC time constant
- */
-void Io_SharedFilters_LowPassFilter(
-    float32_t *input,
-    float32_t *output,
-    uint32_t   num_of_samples,
-    float32_t  sampling_time,
-    float32_t  rc);
+ * @param output Pointer to an array of output samples, which may be the same
+ *               array as the input samples
+ * @param num_samples Number of input samples
+ */
+void Io_SharedFilters_ApplyEmaFilter(
+    struct EmaFilter *filter,
+    const float *     input,
+    float *           output,
+    size_t            num_samples);
+void Io_SharedFilters_ApplyEmaFilterQ15(
+    struct EmaFilterQ15 *filter,
+    const int16_t *      input,
+    int16_t *            output,
+    size_t               num_samples);
+void Io_SharedFilters_ApplyBiquadCascade(
+    struct BiquadCascade *filter,
+    const float *         input,
+    float *               output,
+    size_t                num_samples);
+void Io_SharedFilters_ApplyBiquadCascadeQ15(
+    struct BiquadCascadeQ15 *filter,
+    const int16_t *          input,
+    int16_t *                output,
+    size_t                   num_samples);
+void Io_SharedFilters_ApplyMovingMedian(
+    struct MovingMedian *filter,
+    const float *        input,
+    float *              output,
+    size_t               num_samples);
+void Io_SharedFilters_ApplyMovingMedianQ15(
+    struct MovingMedianQ15 *filter,
+    const int16_t *         input,
+    int16_t *               output,
+    size_t                  num_samples);
+void Io_SharedFilters_ApplyRateLimiter(
+    struct RateLimiter *filter,
+    const float *       input,
+    float *             output,
+    size_t              num_samples);
+void Io_SharedFilters_ApplyRateLimiterQ15(
+    struct RateLimiterQ15 *filter,
+    const int16_t *        input,
+    int16_t *              output,
+    size_t                 num_samples);
+
+/**
+ * Filter and decimate a block of samples with the given FIR decimator
+ * @param filter The filter to filter the samples with
+ * @param input Pointer to an array of input samples
+ * @param output Pointer to an array of output samples, which may be the same
+ *               array as the input samples. It must hold at least
+ *               num_samples / decimation_factor + 1 samples.
+ * @param num_samples Number of input samples
+ * @return The number of output samples
+ */
+size_t Io_SharedFilters_ApplyFirDecimator(
+    struct FirDecimator *filter,
+    const float *        input,
+    float *              output,
+    size_t               num_samples);
+size_t Io_SharedFilters_ApplyFirDecimatorQ15(
+    struct FirDecimatorQ15 *filter,
+    const int16_t *         input,
+    int16_t *               output,
+    size_t                  num_samples);
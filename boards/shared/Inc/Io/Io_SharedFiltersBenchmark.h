@@ -0,0 +1,41 @@
+#pragma once
+
+// The number of samples filtered per block by the benchmark
+#define FILTERS_BENCHMARK_BLOCK_SIZE 64U
+
+// The cost of filtering one sample with each filter, in cycle counter units.
+// The cycle counter is the DWT cycle counter on ARM and a nanosecond
+// monotonic clock on x86.
+struct FiltersBenchmarkResults
+{
+    float ema_filter;
+    float ema_filter_q15;
+
+    // 2 stages
+    float biquad_cascade;
+    float biquad_cascade_q15;
+
+    // 16 taps, decimated by 4
+    float fir_decimator;
+    float fir_decimator_q15;
+
+    // Window of 5 samples
+    float moving_median;
+    float moving_median_q15;
+
+    float rate_limiter;
+    float rate_limiter_q15;
+};
+
+/**
+ * Measure the cost of filtering one sample with each of the shared filters,
+ * filtering blocks of FILTERS_BENCHMARK_BLOCK_SIZE samples at a time
+ * @note On ARM, this should be run with interrupts disabled (e.g. from the
+ *       debugger before the scheduler starts), so the measurements don't
+ *       include the time spent in interrupts
+ * @param num_blocks The number of blocks to filter with each filter
+ * @param results Set to the cost of filtering one sample with each filter
+ */
+void Io_SharedFiltersBenchmark_Run(
+    unsigned int                    num_blocks,
+    struct FiltersBenchmarkResults *results);
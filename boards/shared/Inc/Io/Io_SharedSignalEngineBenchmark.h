@@ -0,0 +1,34 @@
+#pragma once
+
+// The number of signals added to the signal engine by the benchmark, which is
+// well beyond what any board registers today
+#define SIGNAL_ENGINE_BENCHMARK_NUM_SIGNALS 128U
+
+// The cost of one signal engine tick, in cycle counter units. The cycle counter
+// is the DWT cycle counter on ARM and a nanosecond monotonic clock on x86.
+struct SignalEngineBenchmarkResults
+{
+    // Every signal is idle, and none of them is debouncing
+    float idle_signals;
+
+    // One in eight signals has its entry condition high, so it is debouncing
+    // and then triggered
+    float active_signals;
+
+    // One in eight wait signals is high, so it keeps waiting and calling its
+    // callback function
+    float active_wait_signals;
+};
+
+/**
+ * Measure the cost of ticking a signal engine holding
+ * SIGNAL_ENGINE_BENCHMARK_NUM_SIGNALS signals or wait signals
+ * @note On ARM, this should be run with interrupts disabled (e.g. from the
+ *       debugger before the scheduler starts), so the measurements don't
+ *       include the time spent in interrupts
+ * @param num_ticks The number of ticks to measure for each signal engine
+ * @param results Set to the cost of one tick of each signal engine
+ */
+void Io_SharedSignalEngineBenchmark_Run(
+    unsigned int                         num_ticks,
+    struct SignalEngineBenchmarkResults *results);
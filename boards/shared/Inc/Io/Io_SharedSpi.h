@@ -113,3 +113,32 @@ HAL_StatusTypeDef Io_SharedSpi_TransmitWithoutNssToggle(
     const struct SharedSpi *spi_interface,
     uint8_t *               tx_buffer,
     uint16_t                tx_buffer_size);
+
+/**
+ * Start a full-duplex DMA transfer with the device connected to the given SPI
+ * interface. The NSS pin is set low until the transfer completes, after which
+ * the caller must set it high again from its SPI transfer complete callback.
+ * @param spi_interface The given SPI interface.
+ * @param tx_buffer A pointer to the data buffer containing the data transmitted
+ * to the device connected to the SPI interface.
+ * @param rx_buffer A pointer to the data buffer that stores the data received
+ * from the device connected to the SPI interface.
+ * @param buffer_size The number of bytes transmitted and received, which is the
+ * size of both the tx_buffer and the rx_buffer.
+ * @note Both buffers must stay valid until the transfer completes.
+ * @return The HAL status of starting the DMA transfer. If the transfer could
+ * not be started, the NSS pin is set high again before returning.
+ */
+HAL_StatusTypeDef Io_SharedSpi_TransmitAndReceiveDma(
+    const struct SharedSpi *spi_interface,
+    uint8_t *               tx_buffer,
+    uint8_t *               rx_buffer,
+    uint16_t                buffer_size);
+
+/**
+ * Get the HAL SPI handle of the given SPI interface.
+ * @param spi_interface The given SPI interface.
+ * @return The HAL SPI handle of the given SPI interface.
+ */
+SPI_HandleTypeDef *
+    Io_SharedSpi_GetSpiHandle(const struct SharedSpi *spi_interface);
@@ -5,25 +5,135 @@
 
 struct InRangeCheck
 {
+    // Only one of get_value and get_indexed_value is set
     float (*get_value)(void);
-    float min_value;
-    float max_value;
+    float (*get_indexed_value)(size_t);
+    size_t   index;
+    float    min_value;
+    float    max_value;
+    float    hysteresis;
+    uint32_t num_debounce_samples;
+
+    // The value sampled by the last evaluation
+    float value;
+
+    // The status last reported, and the status waiting to be debounced
+    enum InRangeCheck_Status status;
+    enum InRangeCheck_Status pending_status;
+    uint32_t                 num_pending_samples;
 };
 
+/**
+ * Get the status of the given value, without debounce
+ * @param in_range_check The in-range check to get the status for
+ * @param value The value to get the status for
+ * @return The status of the given value, taking the hysteresis around the
+ *         status last reported by the given in-range check into account
+ */
+static enum InRangeCheck_Status
+    App_GetStatus(const struct InRangeCheck *const in_range_check, float value)
+{
+    // Only move the limit that the value has to cross to get back in range
+    float min_value = in_range_check->min_value;
+    float max_value = in_range_check->max_value;
+
+    if (in_range_check->status == VALUE_UNDERFLOW)
+    {
+        min_value += in_range_check->hysteresis;
+    }
+    else if (in_range_check->status == VALUE_OVERFLOW)
+    {
+        max_value -= in_range_check->hysteresis;
+    }
+
+    if (value < min_value)
+    {
+        return VALUE_UNDERFLOW;
+    }
+    else if (value > max_value)
+    {
+        return VALUE_OVERFLOW;
+    }
+    else
+    {
+        return VALUE_IN_RANGE;
+    }
+}
+
+/**
+ * Allocate an in-range check without a function to get its value
+ * @param min_value Minimum value in the range, inclusive
+ * @param max_value Maximum value in the range, inclusive
+ * @param hysteresis The hysteresis around the range, see
+ *                   App_InRangeCheck_CreateWithDebounce()
+ * @param num_debounce_samples The number of consecutive samples a new status
+ *                             must be seen for before it is reported
+ * @return The allocated in-range check
+ */
+static struct InRangeCheck *App_AllocateInRangeCheck(
+    float    min_value,
+    float    max_value,
+    float    hysteresis,
+    uint32_t num_debounce_samples)
+{
+    assert(min_value <= max_value);
+    assert(hysteresis >= 0.0f);
+
+    struct InRangeCheck *in_range_check = malloc(sizeof(struct InRangeCheck));
+    assert(in_range_check != NULL);
+
+    in_range_check->get_value            = NULL;
+    in_range_check->get_indexed_value    = NULL;
+    in_range_check->index                = 0U;
+    in_range_check->min_value            = min_value;
+    in_range_check->max_value            = max_value;
+    in_range_check->hysteresis           = hysteresis;
+    in_range_check->num_debounce_samples = num_debounce_samples;
+    in_range_check->value                = 0.0f;
+    in_range_check->status               = VALUE_IN_RANGE;
+    in_range_check->pending_status       = VALUE_IN_RANGE;
+    in_range_check->num_pending_samples  = 0U;
+
+    return in_range_check;
+}
+
 struct InRangeCheck *App_InRangeCheck_Create(
     float (*const get_value)(void),
     float min_value,
     float max_value)
 {
-    assert(get_value != NULL);
-    assert(min_value <= max_value);
+    return App_InRangeCheck_CreateWithDebounce(
+        get_value, min_value, max_value, 0.0f, 0U);
+}
 
-    struct InRangeCheck *in_range_check = malloc(sizeof(struct InRangeCheck));
-    assert(in_range_check != NULL);
+struct InRangeCheck *App_InRangeCheck_CreateWithDebounce(
+    float (*const get_value)(void),
+    float    min_value,
+    float    max_value,
+    float    hysteresis,
+    uint32_t num_debounce_samples)
+{
+    assert(get_value != NULL);
 
+    struct InRangeCheck *in_range_check = App_AllocateInRangeCheck(
+        min_value, max_value, hysteresis, num_debounce_samples);
     in_range_check->get_value = get_value;
-    in_range_check->min_value = min_value;
-    in_range_check->max_value = max_value;
+
+    return in_range_check;
+}
+
+struct InRangeCheck *App_InRangeCheck_CreateForIndex(
+    float (*const get_value)(size_t),
+    size_t index,
+    float  min_value,
+    float  max_value)
+{
+    assert(get_value != NULL);
+
+    struct InRangeCheck *in_range_check =
+        App_AllocateInRangeCheck(min_value, max_value, 0.0f, 0U);
+    in_range_check->get_indexed_value = get_value;
+    in_range_check->index             = index;
 
     return in_range_check;
 }
@@ -33,27 +143,50 @@ void App_InRangeCheck_Destroy(struct InRangeCheck *const in_range_check)
     free(in_range_check);
 }
 
-enum InRangeCheck_Status App_InRangeCheck_GetValue(
-    const struct InRangeCheck *const in_range_check,
-    float *                          returned_value)
+void App_InRangeCheck_Evaluate(struct InRangeCheck *const in_range_check)
 {
-    const float              value  = in_range_check->get_value();
-    enum InRangeCheck_Status status = VALUE_IN_RANGE;
+    const float value =
+        in_range_check->get_value != NULL
+            ? in_range_check->get_value()
+            : in_range_check->get_indexed_value(in_range_check->index);
+    const enum InRangeCheck_Status status =
+        App_GetStatus(in_range_check, value);
 
-    if (value < in_range_check->min_value)
-    {
-        status = VALUE_UNDERFLOW;
-    }
-    else if (value > in_range_check->max_value)
+    if (status == in_range_check->status)
     {
-        status = VALUE_OVERFLOW;
+        in_range_check->num_pending_samples = 0U;
     }
     else
     {
-        status = VALUE_IN_RANGE;
+        if (status != in_range_check->pending_status)
+        {
+            in_range_check->pending_status      = status;
+            in_range_check->num_pending_samples = 0U;
+        }
+        in_range_check->num_pending_samples++;
+
+        if (in_range_check->num_pending_samples >=
+            in_range_check->num_debounce_samples)
+        {
+            in_range_check->status              = status;
+            in_range_check->num_pending_samples = 0U;
+        }
     }
 
-    *returned_value = value;
+    in_range_check->value = value;
+}
+
+enum InRangeCheck_Status App_InRangeCheck_GetValue(
+    const struct InRangeCheck *const in_range_check,
+    float *                          returned_value)
+{
+    *returned_value = in_range_check->value;
 
-    return status;
+    return in_range_check->status;
+}
+
+enum InRangeCheck_Status
+    App_InRangeCheck_GetStatus(const struct InRangeCheck *const in_range_check)
+{
+    return in_range_check->status;
 }
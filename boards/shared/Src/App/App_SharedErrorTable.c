@@ -29,20 +29,20 @@ struct ErrorTable *App_SharedErrorTable_Create(void)
     INIT_ERROR(BMS_NON_CRITICAL_STACK_WATERMARK_ABOVE_THRESHOLD_TASKCANRX, BMS, NON_CRITICAL_ERROR);
     INIT_ERROR(BMS_NON_CRITICAL_STACK_WATERMARK_ABOVE_THRESHOLD_TASKCANTX, BMS, NON_CRITICAL_ERROR);
     INIT_ERROR(BMS_NON_CRITICAL_WATCHDOG_TIMEOUT, BMS, NON_CRITICAL_ERROR);
-    INIT_ERROR(BMS_NON_CRITICAL_SEGMENT_0_VOLTAGE_OUT_OF_RANGE, BMS, NON_CRITICAL_ERROR);
-    INIT_ERROR(BMS_NON_CRITICAL_SEGMENT_1_VOLTAGE_OUT_OF_RANGE, BMS, NON_CRITICAL_ERROR);
-    INIT_ERROR(BMS_NON_CRITICAL_SEGMENT_2_VOLTAGE_OUT_OF_RANGE, BMS, NON_CRITICAL_ERROR);
-    INIT_ERROR(BMS_NON_CRITICAL_SEGMENT_3_VOLTAGE_OUT_OF_RANGE, BMS, NON_CRITICAL_ERROR);
-    INIT_ERROR(BMS_NON_CRITICAL_SEGMENT_4_VOLTAGE_OUT_OF_RANGE, BMS, NON_CRITICAL_ERROR);
-    INIT_ERROR(BMS_NON_CRITICAL_SEGMENT_5_VOLTAGE_OUT_OF_RANGE, BMS, NON_CRITICAL_ERROR);
+    INIT_ERROR(BMS_NON_CRITICAL_NUM_SEGMENT_VOLTAGES_OUT_OF_RANGE, BMS, NON_CRITICAL_ERROR);
+    INIT_ERROR(BMS_NON_CRITICAL_RESERVED_ERROR_ID_6, BMS, NON_CRITICAL_ERROR);
+    INIT_ERROR(BMS_NON_CRITICAL_RESERVED_ERROR_ID_7, BMS, NON_CRITICAL_ERROR);
+    INIT_ERROR(BMS_NON_CRITICAL_RESERVED_ERROR_ID_8, BMS, NON_CRITICAL_ERROR);
+    INIT_ERROR(BMS_NON_CRITICAL_RESERVED_ERROR_ID_9, BMS, NON_CRITICAL_ERROR);
+    INIT_ERROR(BMS_NON_CRITICAL_RESERVED_ERROR_ID_10, BMS, NON_CRITICAL_ERROR);
     INIT_ERROR(BMS_NON_CRITICAL_PACK_VOLTAGE_OUT_OF_RANGE, BMS, NON_CRITICAL_ERROR);
     INIT_ERROR(BMS_NON_CRITICAL_AVERAGE_CELL_VOLTAGE_OUT_OF_RANGE, BMS, NON_CRITICAL_ERROR);
-    INIT_ERROR(BMS_NON_CRITICAL_CELL_MONITOR_0_DIE_TEMP_OUT_OF_RANGE, BMS, NON_CRITICAL_ERROR);
-    INIT_ERROR(BMS_NON_CRITICAL_CELL_MONITOR_1_DIE_TEMP_OUT_OF_RANGE, BMS, NON_CRITICAL_ERROR);
-    INIT_ERROR(BMS_NON_CRITICAL_CELL_MONITOR_2_DIE_TEMP_OUT_OF_RANGE, BMS, NON_CRITICAL_ERROR);
-    INIT_ERROR(BMS_NON_CRITICAL_CELL_MONITOR_3_DIE_TEMP_OUT_OF_RANGE, BMS, NON_CRITICAL_ERROR);
-    INIT_ERROR(BMS_NON_CRITICAL_CELL_MONITOR_4_DIE_TEMP_OUT_OF_RANGE, BMS, NON_CRITICAL_ERROR);
-    INIT_ERROR(BMS_NON_CRITICAL_CELL_MONITOR_5_DIE_TEMP_OUT_OF_RANGE, BMS, NON_CRITICAL_ERROR);
+    INIT_ERROR(BMS_NON_CRITICAL_NUM_CELL_MONITOR_DIE_TEMPS_OUT_OF_RANGE, BMS, NON_CRITICAL_ERROR);
+    INIT_ERROR(BMS_NON_CRITICAL_RESERVED_ERROR_ID_14, BMS, NON_CRITICAL_ERROR);
+    INIT_ERROR(BMS_NON_CRITICAL_RESERVED_ERROR_ID_15, BMS, NON_CRITICAL_ERROR);
+    INIT_ERROR(BMS_NON_CRITICAL_RESERVED_ERROR_ID_16, BMS, NON_CRITICAL_ERROR);
+    INIT_ERROR(BMS_NON_CRITICAL_RESERVED_ERROR_ID_17, BMS, NON_CRITICAL_ERROR);
+    INIT_ERROR(BMS_NON_CRITICAL_RESERVED_ERROR_ID_18, BMS, NON_CRITICAL_ERROR);
     INIT_ERROR(BMS_NON_CRITICAL_ITMP_CHARGER_HAS_OVERFLOW, BMS, NON_CRITICAL_ERROR);
 
     INIT_ERROR(DCM_NON_CRITICAL_STACK_WATERMARK_ABOVE_THRESHOLD_TASK1HZ, DCM, NON_CRITICAL_ERROR);
@@ -99,6 +99,7 @@ struct ErrorTable *App_SharedErrorTable_Create(void)
     INIT_ERROR(BMS_AIR_SHUTDOWN_CHARGER_DISCONNECTED_IN_CHARGE_STATE, BMS, AIR_SHUTDOWN_ERROR);
     INIT_ERROR(BMS_AIR_SHUTDOWN_MAX_CELL_VOLTAGE_OUT_OF_RANGE, BMS, AIR_SHUTDOWN_ERROR);
     INIT_ERROR(BMS_AIR_SHUTDOWN_MIN_CELL_VOLTAGE_OUT_OF_RANGE, BMS, AIR_SHUTDOWN_ERROR);
+    INIT_ERROR(BMS_AIR_SHUTDOWN_PRE_CHARGE_FAILED, BMS, AIR_SHUTDOWN_ERROR);
     INIT_ERROR(DCM_AIR_SHUTDOWN_DUMMY_AIR_SHUTDOWN, DCM, AIR_SHUTDOWN_ERROR);
     INIT_ERROR(DIM_AIR_SHUTDOWN_DUMMY_AIR_SHUTDOWN, DIM, AIR_SHUTDOWN_ERROR);
     INIT_ERROR(FSM_AIR_SHUTDOWN_DUMMY_AIR_SHUTDOWN, FSM, AIR_SHUTDOWN_ERROR);
@@ -0,0 +1,239 @@
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "App_SharedSensorSnapshot.h"
+
+// The inputs of each type are kept in their own arrays, so sampling is a tight
+// loop per type rather than a switch on the type of every input
+struct FloatInputs
+{
+    uint32_t num_inputs;
+    size_t * offsets;
+    float (**samples)(struct World *);
+};
+
+struct BoolInputs
+{
+    uint32_t num_inputs;
+    size_t * offsets;
+    bool (**samples)(struct World *);
+};
+
+struct Uint32Inputs
+{
+    uint32_t num_inputs;
+    size_t * offsets;
+    uint32_t (**samples)(struct World *);
+};
+
+struct SensorSnapshot
+{
+    struct World *world;
+    size_t        snapshot_size;
+    uint32_t      max_num_inputs;
+
+    struct FloatInputs  float_inputs;
+    struct BoolInputs   bool_inputs;
+    struct Uint32Inputs uint32_inputs;
+
+    // The snapshot published after the n-th sample is buffers[n % 2]
+    uint8_t *         buffers[2];
+    volatile uint32_t num_samples;
+};
+
+/**
+ * Allocate an array with the given number of elements
+ * @param num_elements The number of elements in the array
+ * @param element_size The size of each element, in bytes
+ * @return The allocated array, whose ownership is given to the caller
+ */
+static void *App_AllocateArray(size_t num_elements, size_t element_size)
+{
+    void *array = calloc(num_elements, element_size);
+    assert(array != NULL);
+
+    return array;
+}
+
+/**
+ * Get the total number of inputs added to the given sensor snapshot
+ * @param sensor_snapshot The sensor snapshot to get the number of inputs for
+ * @return The total number of inputs added to the given sensor snapshot
+ */
+static uint32_t
+    App_GetNumInputs(const struct SensorSnapshot *const sensor_snapshot)
+{
+    return sensor_snapshot->float_inputs.num_inputs +
+           sensor_snapshot->bool_inputs.num_inputs +
+           sensor_snapshot->uint32_inputs.num_inputs;
+}
+
+struct SensorSnapshot *App_SharedSensorSnapshot_Create(
+    struct World *const world,
+    size_t              snapshot_size,
+    uint32_t            max_num_inputs)
+{
+    struct SensorSnapshot *sensor_snapshot =
+        malloc(sizeof(struct SensorSnapshot));
+    assert(sensor_snapshot != NULL);
+
+    sensor_snapshot->world          = world;
+    sensor_snapshot->snapshot_size  = snapshot_size;
+    sensor_snapshot->max_num_inputs = max_num_inputs;
+
+    sensor_snapshot->float_inputs.num_inputs = 0U;
+    sensor_snapshot->float_inputs.offsets =
+        App_AllocateArray(max_num_inputs, sizeof(size_t));
+    sensor_snapshot->float_inputs.samples = App_AllocateArray(
+        max_num_inputs, sizeof(*sensor_snapshot->float_inputs.samples));
+
+    sensor_snapshot->bool_inputs.num_inputs = 0U;
+    sensor_snapshot->bool_inputs.offsets =
+        App_AllocateArray(max_num_inputs, sizeof(size_t));
+    sensor_snapshot->bool_inputs.samples = App_AllocateArray(
+        max_num_inputs, sizeof(*sensor_snapshot->bool_inputs.samples));
+
+    sensor_snapshot->uint32_inputs.num_inputs = 0U;
+    sensor_snapshot->uint32_inputs.offsets =
+        App_AllocateArray(max_num_inputs, sizeof(size_t));
+    sensor_snapshot->uint32_inputs.samples = App_AllocateArray(
+        max_num_inputs, sizeof(*sensor_snapshot->uint32_inputs.samples));
+
+    sensor_snapshot->buffers[0]  = App_AllocateArray(1U, snapshot_size);
+    sensor_snapshot->buffers[1]  = App_AllocateArray(1U, snapshot_size);
+    sensor_snapshot->num_samples = 0U;
+
+    return sensor_snapshot;
+}
+
+void App_SharedSensorSnapshot_Destroy(struct SensorSnapshot *sensor_snapshot)
+{
+    free(sensor_snapshot->float_inputs.offsets);
+    free(sensor_snapshot->float_inputs.samples);
+    free(sensor_snapshot->bool_inputs.offsets);
+    free(sensor_snapshot->bool_inputs.samples);
+    free(sensor_snapshot->uint32_inputs.offsets);
+    free(sensor_snapshot->uint32_inputs.samples);
+    free(sensor_snapshot->buffers[0]);
+    free(sensor_snapshot->buffers[1]);
+    free(sensor_snapshot);
+}
+
+void App_SharedSensorSnapshot_AddFloatInput(
+    struct SensorSnapshot *const sensor_snapshot,
+    size_t                       offset,
+    float (*sample)(struct World *))
+{
+    assert(App_GetNumInputs(sensor_snapshot) < sensor_snapshot->max_num_inputs);
+    assert(offset + sizeof(float) <= sensor_snapshot->snapshot_size);
+
+    struct FloatInputs *const inputs = &sensor_snapshot->float_inputs;
+
+    inputs->offsets[inputs->num_inputs] = offset;
+    inputs->samples[inputs->num_inputs] = sample;
+    inputs->num_inputs++;
+}
+
+void App_SharedSensorSnapshot_AddBoolInput(
+    struct SensorSnapshot *const sensor_snapshot,
+    size_t                       offset,
+    bool (*sample)(struct World *))
+{
+    assert(App_GetNumInputs(sensor_snapshot) < sensor_snapshot->max_num_inputs);
+    assert(offset + sizeof(bool) <= sensor_snapshot->snapshot_size);
+
+    struct BoolInputs *const inputs = &sensor_snapshot->bool_inputs;
+
+    inputs->offsets[inputs->num_inputs] = offset;
+    inputs->samples[inputs->num_inputs] = sample;
+    inputs->num_inputs++;
+}
+
+void App_SharedSensorSnapshot_AddUint32Input(
+    struct SensorSnapshot *const sensor_snapshot,
+    size_t                       offset,
+    uint32_t (*sample)(struct World *))
+{
+    assert(App_GetNumInputs(sensor_snapshot) < sensor_snapshot->max_num_inputs);
+    assert(offset + sizeof(uint32_t) <= sensor_snapshot->snapshot_size);
+
+    struct Uint32Inputs *const inputs = &sensor_snapshot->uint32_inputs;
+
+    inputs->offsets[inputs->num_inputs] = offset;
+    inputs->samples[inputs->num_inputs] = sample;
+    inputs->num_inputs++;
+}
+
+void App_SharedSensorSnapshot_Sample(
+    struct SensorSnapshot *const sensor_snapshot)
+{
+    struct World *const world       = sensor_snapshot->world;
+    const uint32_t      num_samples = sensor_snapshot->num_samples;
+
+    // Sample into the buffer that isn't currently published
+    uint8_t *const buffer = sensor_snapshot->buffers[(num_samples + 1U) % 2U];
+
+    const struct FloatInputs *const float_inputs =
+        &sensor_snapshot->float_inputs;
+    for (uint32_t i = 0U; i < float_inputs->num_inputs; i++)
+    {
+        const float value = float_inputs->samples[i](world);
+        memcpy(&buffer[float_inputs->offsets[i]], &value, sizeof(value));
+    }
+
+    const struct BoolInputs *const bool_inputs = &sensor_snapshot->bool_inputs;
+    for (uint32_t i = 0U; i < bool_inputs->num_inputs; i++)
+    {
+        const bool value = bool_inputs->samples[i](world);
+        memcpy(&buffer[bool_inputs->offsets[i]], &value, sizeof(value));
+    }
+
+    const struct Uint32Inputs *const uint32_inputs =
+        &sensor_snapshot->uint32_inputs;
+    for (uint32_t i = 0U; i < uint32_inputs->num_inputs; i++)
+    {
+        const uint32_t value = uint32_inputs->samples[i](world);
+        memcpy(&buffer[uint32_inputs->offsets[i]], &value, sizeof(value));
+    }
+
+    // Publish the buffer only once every input has been sampled. The fence
+    // keeps the compiler (and the CPU) from moving the writes to the buffer
+    // past the write publishing it.
+    atomic_thread_fence(memory_order_release);
+    sensor_snapshot->num_samples = num_samples + 1U;
+}
+
+const void *App_SharedSensorSnapshot_Get(
+    const struct SensorSnapshot *const sensor_snapshot)
+{
+    return sensor_snapshot->buffers[sensor_snapshot->num_samples % 2U];
+}
+
+void App_SharedSensorSnapshot_Copy(
+    const struct SensorSnapshot *const sensor_snapshot,
+    void *const                        destination)
+{
+    uint32_t num_samples;
+
+    // The published buffer is only sampled into again two samples later, but
+    // retry whenever a sample was published during the copy to keep this
+    // simple to reason about. The fences keep the copy between the two reads
+    // of the number of samples, since memcpy() isn't ordered with respect to
+    // volatile accesses.
+    do
+    {
+        num_samples = sensor_snapshot->num_samples;
+        atomic_thread_fence(memory_order_acquire);
+        memcpy(
+            destination, sensor_snapshot->buffers[num_samples % 2U],
+            sensor_snapshot->snapshot_size);
+        atomic_thread_fence(memory_order_acquire);
+    } while (sensor_snapshot->num_samples != num_samples);
+}
+
+uint32_t App_SharedSensorSnapshot_GetNumSamples(
+    const struct SensorSnapshot *const sensor_snapshot)
+{
+    return sensor_snapshot->num_samples;
+}
@@ -0,0 +1,575 @@
+#include <assert.h>
+#include <stdlib.h>
+#include "App_SharedSignalEngine.h"
+
+#define NO_SIGNAL UINT32_MAX
+
+// The entry condition (or the wait signal) was observed to be high last tick
+#define FLAG_ENTRY_HIGH (1U << 0U)
+// The exit condition was observed to be high last tick
+#define FLAG_EXIT_HIGH (1U << 1U)
+// The callback function is triggered (or the wait signal is waiting)
+#define FLAG_ACTIVE (1U << 2U)
+// A deadline for the signal is held in the timer wheel
+#define FLAG_TIMER_ARMED (1U << 3U)
+// The deadline for the signal was reached, and was taken out of the timer wheel
+#define FLAG_DEADLINE_REACHED (1U << 4U)
+
+enum SignalType
+{
+    SIGNAL_TYPE_SIGNAL,
+    SIGNAL_TYPE_WAIT_SIGNAL,
+};
+
+struct SignalEngine
+{
+    // The world passed to every condition and callback function
+    struct World *world;
+
+    uint32_t max_num_signals;
+    uint32_t num_signals;
+
+    // The time of the last tick, in milliseconds
+    uint32_t last_tick_ms;
+
+    // The signal's properties are stored as a struct of arrays, indexed by the
+    // signal ID, so each pass over the signals only touches what it needs
+    uint8_t *types;
+    uint8_t *flags;
+    bool (**is_entry_condition_high)(struct World *);
+    bool (**is_exit_condition_high)(struct World *);
+    void (**callback_functions)(struct World *);
+    uint32_t *entry_condition_high_durations_ms;
+    uint32_t *exit_condition_high_durations_ms;
+
+    // The last time the entry and exit conditions were observed to be low
+    // before they went high, in milliseconds
+    uint32_t *entry_last_times_low_ms;
+    uint32_t *exit_last_times_low_ms;
+
+    // Armed deadlines are kept in a doubly linked list per timer wheel slot.
+    // The timer wheel has one slot per signal, rounded up to a power of two.
+    uint32_t *deadlines_ms;
+    uint32_t *next_timers;
+    uint32_t *previous_timers;
+    uint32_t *timer_wheel;
+    uint32_t  timer_wheel_slot_mask;
+};
+
+/**
+ * Allocate an array with the given number of elements
+ * @param num_elements The number of elements in the array
+ * @param element_size The size of each element, in bytes
+ * @return The allocated array, whose ownership is given to the caller
+ */
+static void *App_AllocateArray(size_t num_elements, size_t element_size)
+{
+    void *array = calloc(num_elements, element_size);
+    assert(array != NULL);
+
+    return array;
+}
+
+/**
+ * Check if the given amount of time has passed since the given start time
+ * @param start_time_ms The start time, in milliseconds
+ * @param duration_ms The duration, in milliseconds
+ * @param current_time_ms The current time, in milliseconds
+ * @return true if the duration has passed, else false
+ */
+static bool App_HasDurationPassed(
+    uint32_t start_time_ms,
+    uint32_t duration_ms,
+    uint32_t current_time_ms)
+{
+    return current_time_ms - start_time_ms >= duration_ms;
+}
+
+/**
+ * Insert a deadline for the given signal into the timer wheel
+ * @param signal_engine The signal engine holding the signal
+ * @param signal_id The ID of the signal to arm a deadline for
+ * @param deadline_ms The deadline, in milliseconds, which must be later than
+ *                    the current tick
+ */
+static void App_ArmTimer(
+    struct SignalEngine *const signal_engine,
+    uint32_t                   signal_id,
+    uint32_t                   deadline_ms)
+{
+    uint32_t *const slot =
+        &signal_engine
+             ->timer_wheel[deadline_ms & signal_engine->timer_wheel_slot_mask];
+
+    signal_engine->deadlines_ms[signal_id]    = deadline_ms;
+    signal_engine->previous_timers[signal_id] = NO_SIGNAL;
+    signal_engine->next_timers[signal_id]     = *slot;
+
+    if (*slot != NO_SIGNAL)
+    {
+        signal_engine->previous_timers[*slot] = signal_id;
+    }
+
+    *slot = signal_id;
+    signal_engine->flags[signal_id] |= FLAG_TIMER_ARMED;
+}
+
+/**
+ * Remove the deadline for the given signal from the timer wheel, if there is
+ * one
+ * @param signal_engine The signal engine holding the signal
+ * @param signal_id The ID of the signal to disarm the deadline for
+ */
+static void App_DisarmTimer(
+    struct SignalEngine *const signal_engine,
+    uint32_t                   signal_id)
+{
+    if ((signal_engine->flags[signal_id] & FLAG_TIMER_ARMED) == 0U)
+    {
+        return;
+    }
+
+    const uint32_t previous = signal_engine->previous_timers[signal_id];
+    const uint32_t next     = signal_engine->next_timers[signal_id];
+
+    if (previous == NO_SIGNAL)
+    {
+        signal_engine->timer_wheel
+            [signal_engine->deadlines_ms[signal_id] &
+             signal_engine->timer_wheel_slot_mask] = next;
+    }
+    else
+    {
+        signal_engine->next_timers[previous] = next;
+    }
+
+    if (next != NO_SIGNAL)
+    {
+        signal_engine->previous_timers[next] = previous;
+    }
+
+    signal_engine->flags[signal_id] &= (uint8_t)~FLAG_TIMER_ARMED;
+}
+
+/**
+ * Trigger the callback function of the given signal
+ * @param signal_engine The signal engine holding the signal
+ * @param signal_id The ID of the signal to trigger
+ */
+static void App_TriggerSignal(
+    struct SignalEngine *const signal_engine,
+    uint32_t                   signal_id)
+{
+    App_DisarmTimer(signal_engine, signal_id);
+    signal_engine->callback_functions[signal_id](signal_engine->world);
+    signal_engine->flags[signal_id] |= FLAG_ACTIVE;
+}
+
+/**
+ * Stop triggering the callback function of the given signal
+ * @param signal_engine The signal engine holding the signal
+ * @param signal_id The ID of the signal to stop triggering
+ */
+static void App_UntriggerSignal(
+    struct SignalEngine *const signal_engine,
+    uint32_t                   signal_id)
+{
+    App_DisarmTimer(signal_engine, signal_id);
+    signal_engine->flags[signal_id] &= (uint8_t)~FLAG_ACTIVE;
+}
+
+/**
+ * Keep track of the last time a condition of the given signal was observed to
+ * be low before it went high
+ * @param signal_engine The signal engine holding the signal
+ * @param signal_id The ID of the signal to track the condition for
+ * @param is_high If the condition is high
+ * @param high_flag The flag used to keep track of the condition
+ * @param last_times_low_ms The last times the condition was observed low
+ */
+static void App_TrackCondition(
+    struct SignalEngine *const signal_engine,
+    uint32_t                   signal_id,
+    bool                       is_high,
+    uint8_t                    high_flag,
+    uint32_t *const            last_times_low_ms)
+{
+    if (!is_high)
+    {
+        signal_engine->flags[signal_id] &= (uint8_t)~high_flag;
+    }
+    else if ((signal_engine->flags[signal_id] & high_flag) == 0U)
+    {
+        // Only the rising edge is recorded, the condition was last observed to
+        // be low on the previous tick
+        signal_engine->flags[signal_id] |= high_flag;
+        last_times_low_ms[signal_id] = signal_engine->last_tick_ms;
+    }
+}
+
+/**
+ * Evaluate a condition of the given signal and arm or disarm the deadline that
+ * depends on it
+ * @param signal_engine The signal engine holding the signal
+ * @param signal_id The ID of the signal to evaluate the condition for
+ * @param is_high If the condition is high
+ * @param high_flag The flag used to keep track of the condition
+ * @param last_times_low_ms The last times the condition was observed low
+ * @param duration_ms How long the condition must be high for, in milliseconds
+ * @param current_time_ms The current time, in milliseconds
+ * @return true if the deadline for the condition has been reached, else false
+ */
+static bool App_UpdateCondition(
+    struct SignalEngine *const signal_engine,
+    uint32_t                   signal_id,
+    bool                       is_high,
+    uint8_t                    high_flag,
+    uint32_t *const            last_times_low_ms,
+    uint32_t                   duration_ms,
+    uint32_t                   current_time_ms)
+{
+    App_TrackCondition(
+        signal_engine, signal_id, is_high, high_flag, last_times_low_ms);
+
+    if (!is_high)
+    {
+        App_DisarmTimer(signal_engine, signal_id);
+        signal_engine->flags[signal_id] &= (uint8_t)~FLAG_DEADLINE_REACHED;
+
+        return duration_ms == 0U;
+    }
+
+    if ((signal_engine->flags[signal_id] & FLAG_DEADLINE_REACHED) != 0U)
+    {
+        // The condition stayed high until the deadline taken out of the timer
+        // wheel this tick
+        signal_engine->flags[signal_id] &= (uint8_t)~FLAG_DEADLINE_REACHED;
+
+        return true;
+    }
+
+    if ((signal_engine->flags[signal_id] & FLAG_TIMER_ARMED) != 0U)
+    {
+        // The timer wheel will handle the deadline
+        return false;
+    }
+
+    if (App_HasDurationPassed(
+            last_times_low_ms[signal_id], duration_ms, current_time_ms))
+    {
+        return true;
+    }
+
+    App_ArmTimer(
+        signal_engine, signal_id, last_times_low_ms[signal_id] + duration_ms);
+
+    return false;
+}
+
+/**
+ * Advance the timer wheel up to the current time, and take every deadline that
+ * has been reached out of it. The signals are only handled once their
+ * conditions have been evaluated for the current tick.
+ * @param signal_engine The signal engine to advance the timer wheel for
+ * @param current_time_ms The current time, in milliseconds
+ */
+static void App_AdvanceTimerWheel(
+    struct SignalEngine *const signal_engine,
+    uint32_t                   current_time_ms)
+{
+    uint32_t num_slots = current_time_ms - signal_engine->last_tick_ms;
+    if (num_slots > signal_engine->timer_wheel_slot_mask + 1U)
+    {
+        num_slots = signal_engine->timer_wheel_slot_mask + 1U;
+    }
+
+    for (uint32_t slot = 1U; slot <= num_slots; slot++)
+    {
+        uint32_t signal_id = signal_engine->timer_wheel
+                                 [(signal_engine->last_tick_ms + slot) &
+                                  signal_engine->timer_wheel_slot_mask];
+
+        while (signal_id != NO_SIGNAL)
+        {
+            const uint32_t next_signal_id =
+                signal_engine->next_timers[signal_id];
+
+            // Deadlines more than one revolution away share the slot
+            if ((int32_t)(
+                    current_time_ms - signal_engine->deadlines_ms[signal_id]) >=
+                0)
+            {
+                App_DisarmTimer(signal_engine, signal_id);
+                signal_engine->flags[signal_id] |= FLAG_DEADLINE_REACHED;
+            }
+
+            signal_id = next_signal_id;
+        }
+    }
+}
+
+/**
+ * Evaluate the conditions of the given wait signal, and call its callback
+ * function if its wait is over
+ * @param signal_engine The signal engine holding the wait signal
+ * @param wait_signal_id The ID of the wait signal to update
+ * @param current_time_ms The current time, in milliseconds
+ */
+static void App_UpdateWaitSignal(
+    struct SignalEngine *const signal_engine,
+    uint32_t                   wait_signal_id,
+    uint32_t                   current_time_ms)
+{
+    const uint8_t flags = signal_engine->flags[wait_signal_id];
+
+    if ((flags & FLAG_DEADLINE_REACHED) != 0U)
+    {
+        signal_engine->flags[wait_signal_id] =
+            (uint8_t)(flags & ~(FLAG_DEADLINE_REACHED | FLAG_ACTIVE));
+        signal_engine->callback_functions[wait_signal_id](signal_engine->world);
+    }
+    // The wait signal isn't checked while a wait is in progress
+    else if (
+        (flags & FLAG_ACTIVE) == 0U &&
+        signal_engine->is_entry_condition_high[wait_signal_id](
+            signal_engine->world))
+    {
+        const uint32_t wait_duration_ms =
+            signal_engine->entry_condition_high_durations_ms[wait_signal_id];
+
+        // The callback function is triggered on the first tick after the wait
+        // signal has waited for one less than the wait duration
+        signal_engine->flags[wait_signal_id] |= FLAG_ACTIVE;
+        App_ArmTimer(
+            signal_engine, wait_signal_id,
+            current_time_ms +
+                (wait_duration_ms > 1U ? wait_duration_ms - 1U : 1U));
+    }
+}
+
+/**
+ * Evaluate the conditions of the given signal, and call its callback function
+ * if it is triggered
+ * @param signal_engine The signal engine holding the signal
+ * @param signal_id The ID of the signal to update
+ * @param current_time_ms The current time, in milliseconds
+ */
+static void App_UpdateSignal(
+    struct SignalEngine *const signal_engine,
+    uint32_t                   signal_id,
+    uint32_t                   current_time_ms)
+{
+    struct World *const world = signal_engine->world;
+
+    const bool is_entry_condition_high =
+        signal_engine->is_entry_condition_high[signal_id](world);
+    const bool is_exit_condition_high =
+        signal_engine->is_exit_condition_high[signal_id](world);
+
+    if ((signal_engine->flags[signal_id] & FLAG_ACTIVE) == 0U)
+    {
+        // Only the active condition may hold a deadline in the timer wheel
+        App_TrackCondition(
+            signal_engine, signal_id, is_exit_condition_high, FLAG_EXIT_HIGH,
+            signal_engine->exit_last_times_low_ms);
+
+        if (App_UpdateCondition(
+                signal_engine, signal_id, is_entry_condition_high,
+                FLAG_ENTRY_HIGH, signal_engine->entry_last_times_low_ms,
+                signal_engine->entry_condition_high_durations_ms[signal_id],
+                current_time_ms))
+        {
+            App_TriggerSignal(signal_engine, signal_id);
+        }
+    }
+    else
+    {
+        App_TrackCondition(
+            signal_engine, signal_id, is_entry_condition_high, FLAG_ENTRY_HIGH,
+            signal_engine->entry_last_times_low_ms);
+
+        if (App_UpdateCondition(
+                signal_engine, signal_id, is_exit_condition_high,
+                FLAG_EXIT_HIGH, signal_engine->exit_last_times_low_ms,
+                signal_engine->exit_condition_high_durations_ms[signal_id],
+                current_time_ms))
+        {
+            App_UntriggerSignal(signal_engine, signal_id);
+        }
+        else
+        {
+            signal_engine->callback_functions[signal_id](world);
+        }
+    }
+}
+
+struct SignalEngine *App_SharedSignalEngine_Create(
+    uint32_t            initial_time_ms,
+    struct World *const world,
+    uint32_t            max_num_signals)
+{
+    struct SignalEngine *signal_engine = malloc(sizeof(struct SignalEngine));
+    assert(signal_engine != NULL);
+
+    signal_engine->world           = world;
+    signal_engine->max_num_signals = max_num_signals;
+    signal_engine->num_signals     = 0U;
+    signal_engine->last_tick_ms    = initial_time_ms;
+
+    signal_engine->types = App_AllocateArray(max_num_signals, sizeof(uint8_t));
+    signal_engine->flags = App_AllocateArray(max_num_signals, sizeof(uint8_t));
+    signal_engine->is_entry_condition_high = App_AllocateArray(
+        max_num_signals, sizeof(*signal_engine->is_entry_condition_high));
+    signal_engine->is_exit_condition_high = App_AllocateArray(
+        max_num_signals, sizeof(*signal_engine->is_exit_condition_high));
+    signal_engine->callback_functions = App_AllocateArray(
+        max_num_signals, sizeof(*signal_engine->callback_functions));
+    signal_engine->entry_condition_high_durations_ms =
+        App_AllocateArray(max_num_signals, sizeof(uint32_t));
+    signal_engine->exit_condition_high_durations_ms =
+        App_AllocateArray(max_num_signals, sizeof(uint32_t));
+    signal_engine->entry_last_times_low_ms =
+        App_AllocateArray(max_num_signals, sizeof(uint32_t));
+    signal_engine->exit_last_times_low_ms =
+        App_AllocateArray(max_num_signals, sizeof(uint32_t));
+    signal_engine->deadlines_ms =
+        App_AllocateArray(max_num_signals, sizeof(uint32_t));
+    signal_engine->next_timers =
+        App_AllocateArray(max_num_signals, sizeof(uint32_t));
+    signal_engine->previous_timers =
+        App_AllocateArray(max_num_signals, sizeof(uint32_t));
+
+    uint32_t num_timer_wheel_slots = 1U;
+    while (num_timer_wheel_slots < max_num_signals)
+    {
+        num_timer_wheel_slots <<= 1U;
+    }
+    signal_engine->timer_wheel =
+        App_AllocateArray(num_timer_wheel_slots, sizeof(uint32_t));
+    signal_engine->timer_wheel_slot_mask = num_timer_wheel_slots - 1U;
+
+    for (uint32_t i = 0U; i < num_timer_wheel_slots; i++)
+    {
+        signal_engine->timer_wheel[i] = NO_SIGNAL;
+    }
+
+    return signal_engine;
+}
+
+void App_SharedSignalEngine_Destroy(struct SignalEngine *signal_engine)
+{
+    free(signal_engine->types);
+    free(signal_engine->flags);
+    free(signal_engine->is_entry_condition_high);
+    free(signal_engine->is_exit_condition_high);
+    free(signal_engine->callback_functions);
+    free(signal_engine->entry_condition_high_durations_ms);
+    free(signal_engine->exit_condition_high_durations_ms);
+    free(signal_engine->entry_last_times_low_ms);
+    free(signal_engine->exit_last_times_low_ms);
+    free(signal_engine->deadlines_ms);
+    free(signal_engine->next_timers);
+    free(signal_engine->previous_timers);
+    free(signal_engine->timer_wheel);
+    free(signal_engine);
+}
+
+uint32_t App_SharedSignalEngine_AddSignal(
+    struct SignalEngine *const signal_engine,
+    bool (*is_entry_condition_high)(struct World *),
+    bool (*is_exit_condition_high)(struct World *),
+    struct SignalCallback callback)
+{
+    assert(signal_engine->num_signals < signal_engine->max_num_signals);
+
+    const uint32_t signal_id = signal_engine->num_signals++;
+
+    signal_engine->types[signal_id]                   = SIGNAL_TYPE_SIGNAL;
+    signal_engine->flags[signal_id]                   = 0U;
+    signal_engine->is_entry_condition_high[signal_id] = is_entry_condition_high;
+    signal_engine->is_exit_condition_high[signal_id]  = is_exit_condition_high;
+    signal_engine->callback_functions[signal_id]      = callback.function;
+    signal_engine->entry_condition_high_durations_ms[signal_id] =
+        callback.entry_condition_high_duration_ms;
+    signal_engine->exit_condition_high_durations_ms[signal_id] =
+        callback.exit_condition_high_duration_ms;
+    signal_engine->entry_last_times_low_ms[signal_id] =
+        signal_engine->last_tick_ms;
+    signal_engine->exit_last_times_low_ms[signal_id] =
+        signal_engine->last_tick_ms;
+
+    return signal_id;
+}
+
+uint32_t App_SharedSignalEngine_AddWaitSignal(
+    struct SignalEngine *const signal_engine,
+    bool (*is_high)(struct World *),
+    struct WaitSignalCallback callback)
+{
+    assert(signal_engine->num_signals < signal_engine->max_num_signals);
+    assert(callback.wait_duration_ms > 0U);
+
+    const uint32_t wait_signal_id = signal_engine->num_signals++;
+
+    signal_engine->types[wait_signal_id] = SIGNAL_TYPE_WAIT_SIGNAL;
+    signal_engine->flags[wait_signal_id] = 0U;
+    signal_engine->is_entry_condition_high[wait_signal_id] = is_high;
+    signal_engine->is_exit_condition_high[wait_signal_id]  = NULL;
+    signal_engine->callback_functions[wait_signal_id]      = callback.function;
+    signal_engine->entry_condition_high_durations_ms[wait_signal_id] =
+        callback.wait_duration_ms;
+    signal_engine->exit_condition_high_durations_ms[wait_signal_id] = 0U;
+    signal_engine->entry_last_times_low_ms[wait_signal_id] =
+        signal_engine->last_tick_ms;
+    signal_engine->exit_last_times_low_ms[wait_signal_id] =
+        signal_engine->last_tick_ms;
+
+    return wait_signal_id;
+}
+
+uint32_t App_SharedSignalEngine_GetNumSignals(
+    const struct SignalEngine *const signal_engine)
+{
+    return signal_engine->num_signals;
+}
+
+bool App_SharedSignalEngine_IsCallbackTriggered(
+    const struct SignalEngine *const signal_engine,
+    uint32_t                         signal_id)
+{
+    assert(signal_id < signal_engine->num_signals);
+    assert(signal_engine->types[signal_id] == SIGNAL_TYPE_SIGNAL);
+
+    return (signal_engine->flags[signal_id] & FLAG_ACTIVE) != 0U;
+}
+
+bool App_SharedSignalEngine_IsWaiting(
+    const struct SignalEngine *const signal_engine,
+    uint32_t                         wait_signal_id)
+{
+    assert(wait_signal_id < signal_engine->num_signals);
+    assert(signal_engine->types[wait_signal_id] == SIGNAL_TYPE_WAIT_SIGNAL);
+
+    return (signal_engine->flags[wait_signal_id] & FLAG_ACTIVE) != 0U;
+}
+
+void App_SharedSignalEngine_Tick(
+    struct SignalEngine *const signal_engine,
+    uint32_t                   current_time_ms)
+{
+    App_AdvanceTimerWheel(signal_engine, current_time_ms);
+
+    for (uint32_t i = 0U; i < signal_engine->num_signals; i++)
+    {
+        if (signal_engine->types[i] == SIGNAL_TYPE_WAIT_SIGNAL)
+        {
+            App_UpdateWaitSignal(signal_engine, i, current_time_ms);
+        }
+        else
+        {
+            App_UpdateSignal(signal_engine, i, current_time_ms);
+        }
+    }
+
+    signal_engine->last_tick_ms = current_time_ms;
+}
@@ -5,9 +5,13 @@
 #ifdef __arm__
 #include <FreeRTOS.h>
 #include <semphr.h>
+#include <task.h>
 #elif __unix__ || __APPLE__
+#include <inttypes.h>
 #include <pthread.h>
+#include <time.h>
 #elif _WIN32
+#include <inttypes.h>
 #include <windows.h>
 #else
 #error "Could not determine what CPU this is being compiled for."
@@ -15,31 +19,245 @@
 
 #include "App_SharedStateMachine.h"
 
+struct TracedState
+{
+    const struct State *       state;
+    struct StateTickStatistics statistics[NUM_STATE_MACHINE_TICK_RATES];
+};
+
 struct StateMachine
 {
     const struct State *next_state;
     const struct State *current_state;
     struct World *      world;
+
+    // How many times each tick function has been run
+    uint32_t tick_counts[NUM_STATE_MACHINE_TICK_RATES];
+
+    // Ring buffer of the most recent state transitions
+    struct StateTransition transitions[STATE_MACHINE_TRANSITION_TRACE_SIZE];
+    uint32_t               num_transitions;
+
+    // Tick duration statistics for every state this state machine has ticked
+    struct TracedState traced_states[STATE_MACHINE_MAX_NUM_TRACED_STATES];
+    uint32_t           num_traced_states;
+
+    // Tick durations are only recorded once a cycle counter is set
+    uint32_t (*get_cycle_count)(void);
+
+    // The trace is guarded by its own mutex rather than the state tick mutex,
+    // so it can be read from inside a tick function
 #ifdef __arm__
     StaticSemaphore_t state_tick_mutex_storage;
     SemaphoreHandle_t state_tick_mutex;
+    StaticSemaphore_t trace_mutex_storage;
+    SemaphoreHandle_t trace_mutex;
 #elif __unix__ || __APPLE__
     pthread_mutex_t state_tick_mutex;
+    pthread_mutex_t trace_mutex;
 #elif _WIN32
     HANDLE state_tick_mutex;
+    HANDLE trace_mutex;
 #endif
 };
 
+/**
+ * Take the mutex guarding the trace of the given state machine
+ * @param state_machine The state machine to take the trace mutex of
+ */
+static void App_LockTrace(const struct StateMachine *const state_machine)
+{
+#ifdef __arm__
+    xSemaphoreTake(state_machine->trace_mutex, portMAX_DELAY);
+#elif __unix__ || __APPLE__
+    // Taking the mutex doesn't change the trace, so readers of a const state
+    // machine may take it too
+    pthread_mutex_lock((pthread_mutex_t *)&(state_machine->trace_mutex));
+#elif _WIN32
+    WaitForSingleObject(state_machine->trace_mutex, INFINITE);
+#endif
+}
+
+/**
+ * Give back the mutex guarding the trace of the given state machine
+ * @param state_machine The state machine to give back the trace mutex of
+ */
+static void App_UnlockTrace(const struct StateMachine *const state_machine)
+{
+#ifdef __arm__
+    xSemaphoreGive(state_machine->trace_mutex);
+#elif __unix__ || __APPLE__
+    pthread_mutex_unlock((pthread_mutex_t *)&(state_machine->trace_mutex));
+#elif _WIN32
+    ReleaseMutex(state_machine->trace_mutex);
+#endif
+}
+
+/**
+ * Get the current time used to timestamp state transitions
+ * @return The current time, in milliseconds
+ */
+static uint32_t App_GetTimestampMs(void)
+{
+#ifdef __arm__
+    return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+#elif __unix__ || __APPLE__
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)(
+        (uint64_t)now.tv_sec * 1000ULL + (uint64_t)now.tv_nsec / 1000000ULL);
+#elif _WIN32
+    return (uint32_t)GetTickCount();
+#endif
+}
+
+/**
+ * Get the tick duration statistics of the given state, and start tracing the
+ * given state if it isn't already traced
+ * @param state_machine The state machine to get the tick duration statistics
+ *                      from
+ * @param state The state to get the tick duration statistics for
+ * @return The tick duration statistics for every tick rate of the given state,
+ *         or NULL if there is no room left to trace the given state
+ */
+static struct StateTickStatistics *App_GetOrCreateTickStatistics(
+    struct StateMachine *const state_machine,
+    const struct State *const  state)
+{
+    for (uint32_t i = 0U; i < state_machine->num_traced_states; i++)
+    {
+        if (state_machine->traced_states[i].state == state)
+        {
+            return state_machine->traced_states[i].statistics;
+        }
+    }
+
+    if (state_machine->num_traced_states >= STATE_MACHINE_MAX_NUM_TRACED_STATES)
+    {
+        return NULL;
+    }
+
+    struct TracedState *traced_state =
+        &state_machine->traced_states[state_machine->num_traced_states++];
+    traced_state->state = state;
+    for (size_t i = 0U; i < NUM_STATE_MACHINE_TICK_RATES; i++)
+    {
+        traced_state->statistics[i].min_duration = UINT32_MAX;
+    }
+
+    return traced_state->statistics;
+}
+
+/**
+ * Record a tick duration for the given state
+ * @param state_machine The state machine that ticked the given state
+ * @param state The state that was ticked
+ * @param tick_rate The tick function that was run
+ * @param duration How long the tick function took, in cycle counter units
+ */
+static void App_RecordTickDuration(
+    struct StateMachine *const      state_machine,
+    const struct State *const       state,
+    const enum StateMachineTickRate tick_rate,
+    const uint32_t                  duration)
+{
+    struct StateTickStatistics *all_statistics =
+        App_GetOrCreateTickStatistics(state_machine, state);
+
+    if (all_statistics == NULL)
+    {
+        return;
+    }
+
+    struct StateTickStatistics *statistics = &all_statistics[tick_rate];
+
+    statistics->num_samples++;
+    statistics->total_duration += duration;
+
+    if (duration < statistics->min_duration)
+    {
+        statistics->min_duration = duration;
+    }
+
+    if (duration > statistics->max_duration)
+    {
+        statistics->max_duration = duration;
+    }
+
+    uint32_t bin =
+        (duration == 0U) ? 0U : 31U - (uint32_t)__builtin_clz(duration);
+
+    if (bin >= STATE_MACHINE_NUM_TICK_DURATION_BINS)
+    {
+        bin = STATE_MACHINE_NUM_TICK_DURATION_BINS - 1U;
+    }
+
+    statistics->histogram[bin]++;
+}
+
+/**
+ * Record a state transition in the transition trace of the given state machine
+ * @param state_machine The state machine that transitioned
+ * @param tick_rate The tick function that requested the transition
+ */
+static void App_RecordTransition(
+    struct StateMachine *const      state_machine,
+    const enum StateMachineTickRate tick_rate)
+{
+    struct StateTransition *transition =
+        &state_machine->transitions
+             [state_machine->num_transitions %
+              STATE_MACHINE_TRANSITION_TRACE_SIZE];
+
+    transition->previous_state = state_machine->current_state;
+    transition->next_state     = state_machine->next_state;
+    transition->timestamp_ms   = App_GetTimestampMs();
+    transition->tick_rate      = tick_rate;
+    transition->tick_count     = state_machine->tick_counts[tick_rate];
+
+    state_machine->num_transitions++;
+}
+
+/**
+ * Get a state transition from the transition trace of the given state machine,
+ * whose trace mutex must be taken
+ * @param state_machine The state machine to get the state transition from
+ * @param index How far back in the trace to look, where 0 is the most recent
+ *              transition
+ * @param transition This will be set to the requested state transition
+ * @return EXIT_CODE_OUT_OF_RANGE if the trace doesn't hold a transition at the
+ *         given index
+ */
+static ExitCode App_GetTransition(
+    const struct StateMachine *const state_machine,
+    uint32_t                         index,
+    struct StateTransition *const    transition)
+{
+    if (index >= state_machine->num_transitions ||
+        index >= STATE_MACHINE_TRANSITION_TRACE_SIZE)
+    {
+        return EXIT_CODE_OUT_OF_RANGE;
+    }
+
+    const uint32_t newest = state_machine->num_transitions - 1U;
+    *transition           = state_machine->transitions
+                      [(newest - index) % STATE_MACHINE_TRANSITION_TRACE_SIZE];
+
+    return EXIT_CODE_OK;
+}
+
 /**
  * Run the given tick function over the given state machine if the tick function
  * is not null
  *
  * @param state_machine The state machine to run the tick function over
  * @param tick_function The tick function to run over the state machine
+ * @param tick_rate The tick rate of the given tick function
  */
-void App_SharedStateMachine_RunStateTickFunctionIfNotNull(
+static void App_SharedStateMachine_RunStateTickFunctionIfNotNull(
     struct StateMachine *const state_machine,
-    void (*tick_function)(struct StateMachine *))
+    void (*tick_function)(struct StateMachine *),
+    const enum StateMachineTickRate tick_rate)
 {
     if (tick_function == NULL)
     {
@@ -55,8 +273,28 @@ void App_SharedStateMachine_RunStateTickFunctionIfNotNull(
     WaitForSingleObject(state_machine->state_tick_mutex, INFINITE);
 #endif
 
+    uint32_t (*const get_cycle_count)(void) = state_machine->get_cycle_count;
+    const uint32_t tick_start =
+        get_cycle_count != NULL ? get_cycle_count() : 0U;
+
     tick_function(state_machine);
 
+    const uint32_t tick_end = get_cycle_count != NULL ? get_cycle_count() : 0U;
+
+    App_LockTrace(state_machine);
+    state_machine->tick_counts[tick_rate]++;
+    if (get_cycle_count != NULL)
+    {
+        App_RecordTickDuration(
+            state_machine, state_machine->current_state, tick_rate,
+            tick_end - tick_start);
+    }
+    if (state_machine->next_state != state_machine->current_state)
+    {
+        App_RecordTransition(state_machine, tick_rate);
+    }
+    App_UnlockTrace(state_machine);
+
     // Check if we should transition states
     if (state_machine->next_state != state_machine->current_state)
     {
@@ -83,7 +321,7 @@ struct StateMachine *App_SharedStateMachine_Create(
     const struct State *initial_state)
 {
     struct StateMachine *state_machine =
-        (struct StateMachine *)malloc(sizeof(struct StateMachine));
+        (struct StateMachine *)calloc(1, sizeof(struct StateMachine));
     assert(state_machine != NULL);
 
     state_machine->world = world;
@@ -94,10 +332,14 @@ struct StateMachine *App_SharedStateMachine_Create(
 #ifdef __arm__
     state_machine->state_tick_mutex =
         xSemaphoreCreateMutexStatic(&(state_machine->state_tick_mutex_storage));
+    state_machine->trace_mutex =
+        xSemaphoreCreateMutexStatic(&(state_machine->trace_mutex_storage));
 #elif __unix__ || __APPLE__
     pthread_mutex_init(&(state_machine->state_tick_mutex), NULL);
+    pthread_mutex_init(&(state_machine->trace_mutex), NULL);
 #elif _WIN32
     state_machine->state_tick_mutex = CreateMutex(NULL, FALSE, NULL);
+    state_machine->trace_mutex      = CreateMutex(NULL, FALSE, NULL);
 #endif
 
     return state_machine;
@@ -130,11 +372,148 @@ struct World *App_SharedStateMachine_GetWorld(
 void App_SharedStateMachine_Tick1Hz(struct StateMachine *const state_machine)
 {
     App_SharedStateMachine_RunStateTickFunctionIfNotNull(
-        state_machine, state_machine->current_state->run_on_tick_1Hz);
+        state_machine, state_machine->current_state->run_on_tick_1Hz,
+        STATE_MACHINE_TICK_1HZ);
 }
 
 void App_SharedStateMachine_Tick100Hz(struct StateMachine *const state_machine)
 {
     App_SharedStateMachine_RunStateTickFunctionIfNotNull(
-        state_machine, state_machine->current_state->run_on_tick_100Hz);
+        state_machine, state_machine->current_state->run_on_tick_100Hz,
+        STATE_MACHINE_TICK_100HZ);
+}
+
+void App_SharedStateMachine_SetCycleCounter(
+    struct StateMachine *const state_machine,
+    uint32_t (*const get_cycle_count)(void))
+{
+    App_LockTrace(state_machine);
+    state_machine->get_cycle_count = get_cycle_count;
+    App_UnlockTrace(state_machine);
+}
+
+uint32_t App_SharedStateMachine_GetNumTransitions(
+    const struct StateMachine *const state_machine)
+{
+    App_LockTrace(state_machine);
+    const uint32_t num_transitions = state_machine->num_transitions;
+    App_UnlockTrace(state_machine);
+
+    return num_transitions;
 }
+
+ExitCode App_SharedStateMachine_GetTransition(
+    const struct StateMachine *const state_machine,
+    uint32_t                         index,
+    struct StateTransition *const    transition)
+{
+    App_LockTrace(state_machine);
+    const ExitCode exit_code =
+        App_GetTransition(state_machine, index, transition);
+    App_UnlockTrace(state_machine);
+
+    return exit_code;
+}
+
+ExitCode App_SharedStateMachine_GetTickStatistics(
+    const struct StateMachine *const  state_machine,
+    const struct State *const         state,
+    enum StateMachineTickRate         tick_rate,
+    struct StateTickStatistics *const statistics)
+{
+    ExitCode exit_code = EXIT_CODE_INVALID_ARGS;
+
+    App_LockTrace(state_machine);
+    for (uint32_t i = 0U; i < state_machine->num_traced_states; i++)
+    {
+        if (state_machine->traced_states[i].state == state)
+        {
+            *statistics = state_machine->traced_states[i].statistics[tick_rate];
+            exit_code   = EXIT_CODE_OK;
+            break;
+        }
+    }
+    App_UnlockTrace(state_machine);
+
+    return exit_code;
+}
+
+uint32_t App_SharedStateMachine_GetMeanTickDuration(
+    const struct StateTickStatistics *const statistics)
+{
+    if (statistics->num_samples == 0U)
+    {
+        return 0U;
+    }
+
+    return (uint32_t)(statistics->total_duration / statistics->num_samples);
+}
+
+#ifndef __arm__
+void App_SharedStateMachine_DumpTrace(
+    const struct StateMachine *const state_machine,
+    FILE *const                      stream)
+{
+    static const char *tick_rate_names[NUM_STATE_MACHINE_TICK_RATES] = {
+        [STATE_MACHINE_TICK_1HZ]   = "1Hz",
+        [STATE_MACHINE_TICK_100HZ] = "100Hz",
+    };
+
+    App_LockTrace(state_machine);
+
+    fprintf(
+        stream, "State transitions (%" PRIu32 " total, newest first):\n",
+        state_machine->num_transitions);
+
+    struct StateTransition transition;
+    for (uint32_t i = 0U;
+         EXIT_OK(App_GetTransition(state_machine, i, &transition)); i++)
+    {
+        fprintf(
+            stream, "  t=%" PRIu32 "ms %s -> %s (%s tick #%" PRIu32 ")\n",
+            transition.timestamp_ms, transition.previous_state->name,
+            transition.next_state->name, tick_rate_names[transition.tick_rate],
+            transition.tick_count);
+    }
+
+    fprintf(stream, "Tick durations:\n");
+    for (uint32_t i = 0U; i < state_machine->num_traced_states; i++)
+    {
+        const struct TracedState *traced_state =
+            &state_machine->traced_states[i];
+
+        for (size_t j = 0U; j < NUM_STATE_MACHINE_TICK_RATES; j++)
+        {
+            const struct StateTickStatistics *statistics =
+                &traced_state->statistics[j];
+
+            if (statistics->num_samples == 0U)
+            {
+                continue;
+            }
+
+            fprintf(
+                stream,
+                "  %s %s: n=%" PRIu32 " min=%" PRIu32 " max=%" PRIu32
+                " mean=%" PRIu32 "\n",
+                traced_state->state->name, tick_rate_names[j],
+                statistics->num_samples, statistics->min_duration,
+                statistics->max_duration,
+                App_SharedStateMachine_GetMeanTickDuration(statistics));
+
+            for (size_t bin = 0U; bin < STATE_MACHINE_NUM_TICK_DURATION_BINS;
+                 bin++)
+            {
+                if (statistics->histogram[bin] != 0U)
+                {
+                    fprintf(
+                        stream, "    [2^%zu, 2^%zu): %" PRIu32 "\n", bin,
+                        bin + 1U, statistics->histogram[bin]);
+                }
+            }
+        }
+    }
+
+    App_UnlockTrace(state_machine);
+}
+#endif
@@ -1,11 +1,9 @@
 #include "App_SharedConstants.h"
 #include "Io_SharedAdc.h"
 
-float Io_SharedAdc_ConvertRawAdcValueToVoltage(
-    ADC_HandleTypeDef *hadc,
-    uint16_t           raw_adc_value)
+float Io_SharedAdc_GetVoltagePerLsb(const ADC_HandleTypeDef *const hadc)
 {
-    uint32_t full_scale;
+    uint32_t full_scale = MAX_12_BITS_VALUE;
 
     switch (hadc->Init.Resolution)
     {
@@ -43,5 +41,12 @@ float Io_SharedAdc_ConvertRawAdcValueToVoltage(
     //   with 12-bit resolution, it will be 2^12 -1 = 4095 or with 8-bit
     //   resolution, 2^8 - 1 = 255.
 
-    return (3.3f * raw_adc_value) / (float)full_scale;
+    return 3.3f / (float)full_scale;
+}
+
+float Io_SharedAdc_ConvertRawAdcValueToVoltage(
+    ADC_HandleTypeDef *hadc,
+    uint16_t           raw_adc_value)
+{
+    return Io_SharedAdc_GetVoltagePerLsb(hadc) * (float)raw_adc_value;
 }
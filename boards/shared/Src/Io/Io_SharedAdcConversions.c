@@ -0,0 +1,155 @@
+#include <assert.h>
+#include <stdlib.h>
+#include "Io_SharedAdcConversions.h"
+
+struct AdcConversions
+{
+    size_t num_channels;
+    size_t num_conversion_sets;
+
+    // The index of the first conversion set averaged for every channel, and
+    // the scale factor from the sum of its raw ADC values to its value
+    size_t *first_averaged_sets;
+    float * scales;
+    float * offsets;
+
+    // The scale factor from a single raw ADC value of every channel to its
+    // value
+    float *set_scales;
+
+    // The values are published under a sequence lock: the sequence number is
+    // odd while the values are being written, and changes whenever they have
+    // been written, so a reader can tell if it was interrupted by a writer
+    volatile uint32_t sequence;
+    volatile float *  values;
+};
+
+struct AdcConversions *Io_SharedAdcConversions_Create(
+    const size_t                         num_channels,
+    const size_t                         num_conversion_sets,
+    const float                          voltage_per_lsb,
+    const struct AdcChannelConfig *const channel_configs)
+{
+    assert(num_channels > 0U);
+    assert(num_conversion_sets > 0U);
+    assert(channel_configs != NULL);
+
+    struct AdcConversions *const adc_conversions =
+        malloc(sizeof(struct AdcConversions));
+    assert(adc_conversions != NULL);
+
+    adc_conversions->first_averaged_sets =
+        malloc(num_channels * sizeof(size_t));
+    adc_conversions->scales     = malloc(num_channels * sizeof(float));
+    adc_conversions->offsets    = malloc(num_channels * sizeof(float));
+    adc_conversions->set_scales = malloc(num_channels * sizeof(float));
+    adc_conversions->values     = calloc(num_channels, sizeof(float));
+    assert(adc_conversions->first_averaged_sets != NULL);
+    assert(adc_conversions->scales != NULL);
+    assert(adc_conversions->offsets != NULL);
+    assert(adc_conversions->set_scales != NULL);
+    assert(adc_conversions->values != NULL);
+
+    adc_conversions->num_channels        = num_channels;
+    adc_conversions->num_conversion_sets = num_conversion_sets;
+    adc_conversions->sequence            = 0U;
+
+    for (size_t i = 0U; i < num_channels; i++)
+    {
+        const size_t oversampling_ratio = channel_configs[i].oversampling_ratio;
+        assert(oversampling_ratio > 0U);
+        assert(oversampling_ratio <= num_conversion_sets);
+
+        adc_conversions->first_averaged_sets[i] =
+            num_conversion_sets - oversampling_ratio;
+        adc_conversions->scales[i] = voltage_per_lsb * channel_configs[i].gain /
+                                     (float)oversampling_ratio;
+        adc_conversions->offsets[i] = channel_configs[i].offset;
+        adc_conversions->set_scales[i] =
+            voltage_per_lsb * channel_configs[i].gain;
+    }
+
+    return adc_conversions;
+}
+
+void Io_SharedAdcConversions_Destroy(
+    struct AdcConversions *const adc_conversions)
+{
+    free(adc_conversions->first_averaged_sets);
+    free(adc_conversions->scales);
+    free(adc_conversions->offsets);
+    free(adc_conversions->set_scales);
+    free((float *)adc_conversions->values);
+    free(adc_conversions);
+}
+
+void Io_SharedAdcConversions_Convert(
+    struct AdcConversions *const   adc_conversions,
+    const volatile uint16_t *const raw_adc_values)
+{
+    const size_t num_channels = adc_conversions->num_channels;
+
+    adc_conversions->sequence++;
+
+    for (size_t i = 0U; i < num_channels; i++)
+    {
+        uint32_t sum = 0U;
+        for (size_t set = adc_conversions->first_averaged_sets[i];
+             set < adc_conversions->num_conversion_sets; set++)
+        {
+            sum += raw_adc_values[set * num_channels + i];
+        }
+
+        adc_conversions->values[i] = adc_conversions->scales[i] * (float)sum +
+                                     adc_conversions->offsets[i];
+    }
+
+    adc_conversions->sequence++;
+}
+
+void Io_SharedAdcConversions_ConvertEachSet(
+    const struct AdcConversions *const adc_conversions,
+    const volatile uint16_t *const     raw_adc_values,
+    float *const                       values)
+{
+    const size_t num_channels = adc_conversions->num_channels;
+
+    for (size_t set = 0U; set < adc_conversions->num_conversion_sets; set++)
+    {
+        for (size_t i = 0U; i < num_channels; i++)
+        {
+            const size_t index = set * num_channels + i;
+            values[index] =
+                adc_conversions->set_scales[i] * (float)raw_adc_values[index] +
+                adc_conversions->offsets[i];
+        }
+    }
+}
+
+float Io_SharedAdcConversions_GetValue(
+    const struct AdcConversions *const adc_conversions,
+    const size_t                       channel)
+{
+    assert(channel < adc_conversions->num_channels);
+
+    // A single value is written in one go, so it can't be torn
+    return adc_conversions->values[channel];
+}
+
+void Io_SharedAdcConversions_GetValues(
+    const struct AdcConversions *const adc_conversions,
+    float *const                       values)
+{
+    // Copy the values again if they were being written, or were written while
+    // they were being copied. This assumes that the values are written from an
+    // interrupt that can preempt this function, but not the other way around.
+    uint32_t sequence;
+    do
+    {
+        sequence = adc_conversions->sequence;
+        for (size_t i = 0U; i < adc_conversions->num_channels; i++)
+        {
+            values[i] = adc_conversions->values[i];
+        }
+    } while ((sequence % 2U) != 0U || sequence != adc_conversions->sequence);
+}
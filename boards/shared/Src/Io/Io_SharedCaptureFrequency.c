@@ -0,0 +1,226 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "Io_SharedCaptureFrequency.h"
+
+struct CaptureFrequency
+{
+    float frequency_hz;
+
+    float    tim_frequency_hz;
+    uint32_t counter_period;
+    uint32_t averaging_window_ticks;
+    uint32_t max_edge_gap_ticks;
+
+    // Whether a rising edge has been captured since the PWM input was last
+    // inactive, which the periods of the next rising edges are measured from
+    bool has_reference_edge;
+
+    // The index of the next timestamp to be read from the circular buffer, and
+    // the number of timestamps before it that are consecutive rising edges
+    size_t read_index;
+    size_t num_valid_timestamps;
+
+    uint32_t prev_counter;
+    uint32_t ticks_since_last_edge;
+};
+
+/**
+ * Get the number of timer ticks from one timestamp to another, accounting for
+ * the counter overflowing in between
+ * @param capture_frequency: The estimator the timestamps were captured for
+ * @param from: The earlier timestamp
+ * @param to: The later timestamp
+ * @return The number of timer ticks from one timestamp to the other
+ */
+static uint32_t Io_GetTicksBetween(
+    const struct CaptureFrequency *capture_frequency,
+    uint32_t                       from,
+    uint32_t                       to);
+
+/**
+ * Estimate the frequency from the rising edges captured within the averaging
+ * window before the latest rising edge
+ * @param capture_frequency: The estimator to estimate the frequency for
+ * @param timestamps: The circular buffer of captured timestamps
+ * @param num_timestamps: The number of timestamps the buffer can hold
+ * @param latest_index: The index of the latest captured timestamp
+ */
+static void Io_EstimateFrequency(
+    struct CaptureFrequency *capture_frequency,
+    const volatile uint16_t *timestamps,
+    size_t                   num_timestamps,
+    size_t                   latest_index);
+
+static uint32_t Io_GetTicksBetween(
+    const struct CaptureFrequency *const capture_frequency,
+    const uint32_t                       from,
+    const uint32_t                       to)
+{
+    return (to + capture_frequency->counter_period - from) %
+           capture_frequency->counter_period;
+}
+
+static void Io_EstimateFrequency(
+    struct CaptureFrequency *const capture_frequency,
+    const volatile uint16_t *const timestamps,
+    const size_t                   num_timestamps,
+    const size_t                   latest_index)
+{
+    size_t   num_periods = 0U;
+    uint32_t num_ticks   = 0U;
+    size_t   index       = latest_index;
+
+    // Always measure at least the latest period, then average in the periods
+    // before it for as long as they fit in the averaging window
+    while (num_periods + 1U < capture_frequency->num_valid_timestamps)
+    {
+        const size_t prev_index =
+            (index + num_timestamps - 1U) % num_timestamps;
+        const uint32_t period_ticks = Io_GetTicksBetween(
+            capture_frequency, timestamps[prev_index], timestamps[index]);
+
+        if (num_periods > 0U && num_ticks + period_ticks >
+                                    capture_frequency->averaging_window_ticks)
+        {
+            break;
+        }
+
+        num_ticks += period_ticks;
+        num_periods++;
+        index = prev_index;
+    }
+
+    // Consecutive rising edges with the same timestamp can only be captured
+    // when the PWM frequency is too high for the timer to resolve
+    if (num_periods > 0U && num_ticks > 0U)
+    {
+        capture_frequency->frequency_hz = (float)num_periods *
+                                          capture_frequency->tim_frequency_hz /
+                                          (float)num_ticks;
+    }
+}
+
+struct CaptureFrequency *Io_SharedCaptureFrequency_Create(
+    const float    tim_frequency_hz,
+    const uint32_t tim_auto_reload_reg,
+    const float    averaging_window_s,
+    const float    min_frequency_hz)
+{
+    assert(tim_frequency_hz > 0.0f);
+    assert(averaging_window_s >= 0.0f);
+    assert(min_frequency_hz > 0.0f);
+
+    struct CaptureFrequency *const capture_frequency =
+        malloc(sizeof(struct CaptureFrequency));
+    assert(capture_frequency != NULL);
+
+    capture_frequency->frequency_hz     = 0.0f;
+    capture_frequency->tim_frequency_hz = tim_frequency_hz;
+    capture_frequency->counter_period   = tim_auto_reload_reg + 1U;
+    capture_frequency->averaging_window_ticks =
+        (uint32_t)(averaging_window_s * tim_frequency_hz);
+    capture_frequency->max_edge_gap_ticks =
+        (uint32_t)(tim_frequency_hz / min_frequency_hz);
+    capture_frequency->has_reference_edge    = false;
+    capture_frequency->read_index            = 0U;
+    capture_frequency->num_valid_timestamps  = 0U;
+    capture_frequency->prev_counter          = 0U;
+    capture_frequency->ticks_since_last_edge = 0U;
+
+    // The period between two rising edges can only be told apart from the
+    // counter overflowing if it is shorter than the period of the counter
+    assert(
+        capture_frequency->max_edge_gap_ticks <
+        capture_frequency->counter_period);
+
+    return capture_frequency;
+}
+
+void Io_SharedCaptureFrequency_Destroy(
+    struct CaptureFrequency *const capture_frequency)
+{
+    free(capture_frequency);
+}
+
+void Io_SharedCaptureFrequency_Update(
+    struct CaptureFrequency *const capture_frequency,
+    const volatile uint16_t *const timestamps,
+    const size_t                   num_timestamps,
+    const size_t                   write_index,
+    const uint32_t                 counter)
+{
+    assert(num_timestamps > 1U);
+    assert(write_index < num_timestamps);
+
+    const uint32_t ticks_since_last_update = Io_GetTicksBetween(
+        capture_frequency, capture_frequency->prev_counter, counter);
+    capture_frequency->prev_counter = counter;
+
+    const size_t num_new_timestamps =
+        (write_index + num_timestamps - capture_frequency->read_index) %
+        num_timestamps;
+
+    if (num_new_timestamps == 0U)
+    {
+        if (!capture_frequency->has_reference_edge)
+        {
+            return;
+        }
+
+        capture_frequency->ticks_since_last_edge += ticks_since_last_update;
+
+        if (capture_frequency->ticks_since_last_edge >=
+            capture_frequency->max_edge_gap_ticks)
+        {
+            // The PWM input is likely inactive (i.e. DC signal), and the next
+            // rising edge can't be told apart from the counter overflowing
+            capture_frequency->frequency_hz         = 0.0f;
+            capture_frequency->has_reference_edge   = false;
+            capture_frequency->num_valid_timestamps = 0U;
+        }
+        else if (
+            (float)capture_frequency->ticks_since_last_edge *
+                capture_frequency->frequency_hz >
+            capture_frequency->tim_frequency_hz)
+        {
+            // The current period is at least as long as the time since the
+            // last rising edge, so the frequency follows the PWM input as it
+            // slows down instead of holding the last measured period
+            capture_frequency->frequency_hz =
+                capture_frequency->tim_frequency_hz /
+                (float)capture_frequency->ticks_since_last_edge;
+        }
+        return;
+    }
+
+    if (!capture_frequency->has_reference_edge)
+    {
+        // The first rising edge only marks the start of the next period
+        capture_frequency->has_reference_edge   = true;
+        capture_frequency->num_valid_timestamps = 0U;
+    }
+
+    // Only the latest half of the buffer is averaged over, so the timestamps
+    // can't be overwritten by new rising edges while they are read
+    capture_frequency->num_valid_timestamps += num_new_timestamps;
+    if (capture_frequency->num_valid_timestamps > num_timestamps / 2U)
+    {
+        capture_frequency->num_valid_timestamps = num_timestamps / 2U;
+    }
+    capture_frequency->read_index = write_index;
+
+    const size_t latest_index =
+        (write_index + num_timestamps - 1U) % num_timestamps;
+    capture_frequency->ticks_since_last_edge = Io_GetTicksBetween(
+        capture_frequency, timestamps[latest_index], counter);
+
+    Io_EstimateFrequency(
+        capture_frequency, timestamps, num_timestamps, latest_index);
+}
+
+float Io_SharedCaptureFrequency_GetFrequency(
+    const struct CaptureFrequency *const capture_frequency)
+{
+    return capture_frequency->frequency_hz;
+}
@@ -0,0 +1,13 @@
+#include <stm32f3xx.h>
+#include "Io_SharedCycleCounter.h"
+
+void Io_SharedCycleCounter_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t Io_SharedCycleCounter_GetCycleCount(void)
+{
+    return DWT->CYCCNT;
+}
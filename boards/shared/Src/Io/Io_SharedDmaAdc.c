@@ -0,0 +1,131 @@
+#include <assert.h>
+#include <stdlib.h>
+#include "Io_SharedAdc.h"
+#include "Io_SharedDmaAdc.h"
+
+struct DmaAdc
+{
+    ADC_HandleTypeDef *hadc;
+
+    // The double buffer of conversion sets written by the DMA, and the number
+    // of raw ADC values in each half of it
+    volatile uint16_t *raw_adc_values;
+    size_t             num_raw_adc_values_per_half;
+    size_t             num_conversion_sets;
+
+    struct AdcConversions *adc_conversions;
+
+    // The values of every conversion set in the half of the buffer that was
+    // converted last, for the conversion sets callback
+    float *conversion_set_values;
+    void (*conversion_sets_callback)(
+        const float *values,
+        size_t       num_conversion_sets);
+};
+
+/**
+ * Convert the conversion sets in one half of the buffer
+ * @param dma_adc: The ADC to convert the conversion sets for
+ * @param raw_adc_values: The half of the buffer to convert
+ */
+static void Io_ConvertHalf(
+    struct DmaAdc *          dma_adc,
+    const volatile uint16_t *raw_adc_values);
+
+static void Io_ConvertHalf(
+    struct DmaAdc *const           dma_adc,
+    const volatile uint16_t *const raw_adc_values)
+{
+    Io_SharedAdcConversions_Convert(dma_adc->adc_conversions, raw_adc_values);
+
+    if (dma_adc->conversion_sets_callback != NULL)
+    {
+        Io_SharedAdcConversions_ConvertEachSet(
+            dma_adc->adc_conversions, raw_adc_values,
+            dma_adc->conversion_set_values);
+        dma_adc->conversion_sets_callback(
+            dma_adc->conversion_set_values, dma_adc->num_conversion_sets);
+    }
+}
+
+struct DmaAdc *Io_SharedDmaAdc_Create(
+    ADC_HandleTypeDef *const             hadc,
+    const size_t                         num_conversion_sets,
+    const struct AdcChannelConfig *const channel_configs)
+{
+    assert(hadc != NULL);
+    assert(hadc->DMA_Handle != NULL);
+
+    struct DmaAdc *const dma_adc = malloc(sizeof(struct DmaAdc));
+    assert(dma_adc != NULL);
+
+    const size_t num_channels = hadc->Init.NbrOfConversion;
+
+    dma_adc->hadc                        = hadc;
+    dma_adc->num_raw_adc_values_per_half = num_conversion_sets * num_channels;
+    dma_adc->num_conversion_sets         = num_conversion_sets;
+    dma_adc->conversion_set_values       = NULL;
+    dma_adc->conversion_sets_callback    = NULL;
+    dma_adc->raw_adc_values =
+        calloc(2U * dma_adc->num_raw_adc_values_per_half, sizeof(uint16_t));
+    assert(dma_adc->raw_adc_values != NULL);
+
+    dma_adc->adc_conversions = Io_SharedAdcConversions_Create(
+        num_channels, num_conversion_sets, Io_SharedAdc_GetVoltagePerLsb(hadc),
+        channel_configs);
+
+    HAL_ADC_Start_DMA(
+        hadc, (uint32_t *)dma_adc->raw_adc_values,
+        2U * dma_adc->num_raw_adc_values_per_half);
+
+    return dma_adc;
+}
+
+bool Io_SharedDmaAdc_IsHandle(
+    const struct DmaAdc *const     dma_adc,
+    const ADC_HandleTypeDef *const hadc)
+{
+    return dma_adc->hadc == hadc;
+}
+
+void Io_SharedDmaAdc_SetConversionSetsCallback(
+    struct DmaAdc *const dma_adc,
+    void (*const callback)(const float *values, size_t num_conversion_sets))
+{
+    assert(callback != NULL);
+
+    if (dma_adc->conversion_set_values == NULL)
+    {
+        dma_adc->conversion_set_values =
+            malloc(dma_adc->num_raw_adc_values_per_half * sizeof(float));
+        assert(dma_adc->conversion_set_values != NULL);
+    }
+
+    dma_adc->conversion_sets_callback = callback;
+}
+
+void Io_SharedDmaAdc_ConvertFirstHalf(struct DmaAdc *const dma_adc)
+{
+    Io_ConvertHalf(dma_adc, dma_adc->raw_adc_values);
+}
+
+void Io_SharedDmaAdc_ConvertSecondHalf(struct DmaAdc *const dma_adc)
+{
+    Io_ConvertHalf(
+        dma_adc,
+        &dma_adc->raw_adc_values[dma_adc->num_raw_adc_values_per_half]);
+}
+
+float Io_SharedDmaAdc_GetValue(
+    const struct DmaAdc *const dma_adc,
+    const size_t               channel)
+{
+    return Io_SharedAdcConversions_GetValue(dma_adc->adc_conversions, channel);
+}
+
+void Io_SharedDmaAdc_GetValues(
+    const struct DmaAdc *const dma_adc,
+    float *const               values)
+{
+    Io_SharedAdcConversions_GetValues(dma_adc->adc_conversions, values);
+}
@@ -0,0 +1,142 @@
+#include <assert.h>
+#include <stdlib.h>
+#include "Io_SharedDmaInputCapture.h"
+#include "Io_SharedCaptureFrequency.h"
+
+struct DmaInputCapture
+{
+    TIM_HandleTypeDef *htim;
+    DMA_HandleTypeDef *hdma;
+
+    volatile uint16_t timestamps[NUM_DMA_CAPTURED_TIMESTAMPS];
+    size_t            timestamp_read_index;
+
+    struct CaptureFrequency *capture_frequency;
+};
+
+/**
+ * Get the index the DMA will capture the next timestamp into
+ * @param pwm_input: The PWM input to get the index for
+ * @return The index the DMA will capture the next timestamp into
+ */
+static size_t Io_GetWriteIndex(const struct DmaInputCapture *pwm_input);
+
+static size_t Io_GetWriteIndex(const struct DmaInputCapture *const pwm_input)
+{
+    // The DMA counts down the number of transfers left before it wraps around
+    // to the start of the buffer
+    return (NUM_DMA_CAPTURED_TIMESTAMPS -
+            __HAL_DMA_GET_COUNTER(pwm_input->hdma)) %
+           NUM_DMA_CAPTURED_TIMESTAMPS;
+}
+
+struct DmaInputCapture *Io_SharedDmaInputCapture_Create(
+    TIM_HandleTypeDef *const htim,
+    const float              tim_frequency_hz,
+    const uint32_t           tim_channel,
+    const uint32_t           tim_auto_reload_reg,
+    const float              averaging_window_s,
+    const float              min_frequency_hz)
+{
+    assert(htim != NULL);
+
+    struct DmaInputCapture *const pwm_input =
+        malloc(sizeof(struct DmaInputCapture));
+    assert(pwm_input != NULL);
+
+    uint16_t tim_dma_id          = TIM_DMA_ID_CC1;
+    uint32_t tim_dma_source      = TIM_DMA_CC1;
+    uint32_t capture_compare_reg = (uint32_t)&htim->Instance->CCR1;
+
+    switch (tim_channel)
+    {
+        case TIM_CHANNEL_2:
+        {
+            tim_dma_id          = TIM_DMA_ID_CC2;
+            tim_dma_source      = TIM_DMA_CC2;
+            capture_compare_reg = (uint32_t)&htim->Instance->CCR2;
+        }
+        break;
+        case TIM_CHANNEL_3:
+        {
+            tim_dma_id          = TIM_DMA_ID_CC3;
+            tim_dma_source      = TIM_DMA_CC3;
+            capture_compare_reg = (uint32_t)&htim->Instance->CCR3;
+        }
+        break;
+        case TIM_CHANNEL_4:
+        {
+            tim_dma_id          = TIM_DMA_ID_CC4;
+            tim_dma_source      = TIM_DMA_CC4;
+            capture_compare_reg = (uint32_t)&htim->Instance->CCR4;
+        }
+        break;
+        default:
+        {
+            assert(tim_channel == TIM_CHANNEL_1);
+        }
+        break;
+    }
+
+    pwm_input->htim                 = htim;
+    pwm_input->timestamp_read_index = 0U;
+    pwm_input->hdma                 = htim->hdma[tim_dma_id];
+    assert(pwm_input->hdma != NULL);
+    assert(pwm_input->hdma->Init.Mode == DMA_CIRCULAR);
+
+    pwm_input->capture_frequency = Io_SharedCaptureFrequency_Create(
+        tim_frequency_hz, tim_auto_reload_reg, averaging_window_s,
+        min_frequency_hz);
+
+    // The DMA transfers the captured counter value into the circular buffer on
+    // every rising edge, without interrupting the CPU
+    HAL_DMA_Start(
+        pwm_input->hdma, capture_compare_reg, (uint32_t)pwm_input->timestamps,
+        NUM_DMA_CAPTURED_TIMESTAMPS);
+    __HAL_TIM_ENABLE_DMA(htim, tim_dma_source);
+    TIM_CCxChannelCmd(htim->Instance, tim_channel, TIM_CCx_ENABLE);
+    __HAL_TIM_ENABLE(htim);
+
+    return pwm_input;
+}
+
+void Io_SharedDmaInputCapture_Update(struct DmaInputCapture *const pwm_input)
+{
+    // The counter is read after the DMA, so every rising edge captured into the
+    // buffer is older than the counter value
+    const size_t   write_index = Io_GetWriteIndex(pwm_input);
+    const uint32_t counter     = __HAL_TIM_GET_COUNTER(pwm_input->htim);
+
+    Io_SharedCaptureFrequency_Update(
+        pwm_input->capture_frequency, pwm_input->timestamps,
+        NUM_DMA_CAPTURED_TIMESTAMPS, write_index, counter);
+}
+
+size_t Io_SharedDmaInputCapture_ReadTimestamps(
+    struct DmaInputCapture *const pwm_input,
+    uint16_t *const               timestamps,
+    const size_t                  max_num_timestamps,
+    uint32_t *const               counter)
+{
+    const size_t write_index = Io_GetWriteIndex(pwm_input);
+    *counter                 = __HAL_TIM_GET_COUNTER(pwm_input->htim);
+
+    size_t num_timestamps = 0U;
+    while (pwm_input->timestamp_read_index != write_index &&
+           num_timestamps < max_num_timestamps)
+    {
+        timestamps[num_timestamps++] =
+            pwm_input->timestamps[pwm_input->timestamp_read_index];
+        pwm_input->timestamp_read_index =
+            (pwm_input->timestamp_read_index + 1U) %
+            NUM_DMA_CAPTURED_TIMESTAMPS;
+    }
+
+    return num_timestamps;
+}
+
+float Io_SharedDmaInputCapture_GetFrequency(
+    const struct DmaInputCapture *const pwm_input)
+{
+    return Io_SharedCaptureFrequency_GetFrequency(pwm_input->capture_frequency);
+}
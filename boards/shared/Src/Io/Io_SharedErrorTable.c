@@ -24,23 +24,23 @@ static void Io_ProcessBmsNonCriticalErrorMsg(
     SET_ERROR(
         error_table, BMS_NON_CRITICAL_WATCHDOG_TIMEOUT, data->watchdog_timeout);
     SET_ERROR(
-        error_table, BMS_NON_CRITICAL_SEGMENT_0_VOLTAGE_OUT_OF_RANGE,
-        data->segment_0_voltage_out_of_range);
+        error_table, BMS_NON_CRITICAL_NUM_SEGMENT_VOLTAGES_OUT_OF_RANGE,
+        data->num_segment_voltages_out_of_range > 0U);
     SET_ERROR(
-        error_table, BMS_NON_CRITICAL_SEGMENT_1_VOLTAGE_OUT_OF_RANGE,
-        data->segment_1_voltage_out_of_range);
+        error_table, BMS_NON_CRITICAL_RESERVED_ERROR_ID_6,
+        data->reserved_error_id_6);
     SET_ERROR(
-        error_table, BMS_NON_CRITICAL_SEGMENT_2_VOLTAGE_OUT_OF_RANGE,
-        data->segment_2_voltage_out_of_range);
+        error_table, BMS_NON_CRITICAL_RESERVED_ERROR_ID_7,
+        data->reserved_error_id_7);
     SET_ERROR(
-        error_table, BMS_NON_CRITICAL_SEGMENT_3_VOLTAGE_OUT_OF_RANGE,
-        data->segment_3_voltage_out_of_range);
+        error_table, BMS_NON_CRITICAL_RESERVED_ERROR_ID_8,
+        data->reserved_error_id_8);
     SET_ERROR(
-        error_table, BMS_NON_CRITICAL_SEGMENT_4_VOLTAGE_OUT_OF_RANGE,
-        data->segment_4_voltage_out_of_range);
+        error_table, BMS_NON_CRITICAL_RESERVED_ERROR_ID_9,
+        data->reserved_error_id_9);
     SET_ERROR(
-        error_table, BMS_NON_CRITICAL_SEGMENT_5_VOLTAGE_OUT_OF_RANGE,
-        data->segment_5_voltage_out_of_range);
+        error_table, BMS_NON_CRITICAL_RESERVED_ERROR_ID_10,
+        data->reserved_error_id_10);
     SET_ERROR(
         error_table, BMS_NON_CRITICAL_PACK_VOLTAGE_OUT_OF_RANGE,
         data->pack_voltage_out_of_range);
@@ -48,23 +48,23 @@ static void Io_ProcessBmsNonCriticalErrorMsg(
         error_table, BMS_NON_CRITICAL_AVERAGE_CELL_VOLTAGE_OUT_OF_RANGE,
         data->average_cell_voltage_out_of_range);
     SET_ERROR(
-        error_table, BMS_NON_CRITICAL_CELL_MONITOR_0_DIE_TEMP_OUT_OF_RANGE,
-        data->cell_monitor_0_die_temp_out_of_range);
+        error_table, BMS_NON_CRITICAL_NUM_CELL_MONITOR_DIE_TEMPS_OUT_OF_RANGE,
+        data->num_cell_monitor_die_temps_out_of_range > 0U);
     SET_ERROR(
-        error_table, BMS_NON_CRITICAL_CELL_MONITOR_1_DIE_TEMP_OUT_OF_RANGE,
-        data->cell_monitor_1_die_temp_out_of_range);
+        error_table, BMS_NON_CRITICAL_RESERVED_ERROR_ID_14,
+        data->reserved_error_id_14);
     SET_ERROR(
-        error_table, BMS_NON_CRITICAL_CELL_MONITOR_2_DIE_TEMP_OUT_OF_RANGE,
-        data->cell_monitor_2_die_temp_out_of_range);
+        error_table, BMS_NON_CRITICAL_RESERVED_ERROR_ID_15,
+        data->reserved_error_id_15);
     SET_ERROR(
-        error_table, BMS_NON_CRITICAL_CELL_MONITOR_3_DIE_TEMP_OUT_OF_RANGE,
-        data->cell_monitor_3_die_temp_out_of_range);
+        error_table, BMS_NON_CRITICAL_RESERVED_ERROR_ID_16,
+        data->reserved_error_id_16);
     SET_ERROR(
-        error_table, BMS_NON_CRITICAL_CELL_MONITOR_4_DIE_TEMP_OUT_OF_RANGE,
-        data->cell_monitor_4_die_temp_out_of_range);
+        error_table, BMS_NON_CRITICAL_RESERVED_ERROR_ID_17,
+        data->reserved_error_id_17);
     SET_ERROR(
-        error_table, BMS_NON_CRITICAL_CELL_MONITOR_5_DIE_TEMP_OUT_OF_RANGE,
-        data->cell_monitor_5_die_temp_out_of_range);
+        error_table, BMS_NON_CRITICAL_RESERVED_ERROR_ID_18,
+        data->reserved_error_id_18);
     SET_ERROR(
         error_table, BMS_NON_CRITICAL_ITMP_CHARGER_HAS_OVERFLOW,
         data->itmp_charger_has_overflow);
@@ -238,6 +238,9 @@ static void Io_ProcessBmsAirShutdownErrorMsg(
     SET_ERROR(
         error_table, BMS_AIR_SHUTDOWN_MAX_CELL_VOLTAGE_OUT_OF_RANGE,
         data->max_cell_voltage_out_of_range);
+    SET_ERROR(
+        error_table, BMS_AIR_SHUTDOWN_PRE_CHARGE_FAILED,
+        data->pre_charge_failed);
 }
 
 static void Io_ProcessDcmAirShutdownErrorMsg(
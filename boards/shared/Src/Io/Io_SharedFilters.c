@@ -1,24 +1,848 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
 #include "Io_SharedFilters.h"
-#include "arm_math.h"
 
-void Io_SharedFilters_LowPassFilter(
-    float32_t *input,
-    float32_t *output,
-    uint32_t   num_of_samples,
-    float32_t  sampling_time,
-    float32_t  rc)
+// The number of coefficients, and the number of state variables, per biquad
+#define NUM_BIQUAD_COEFFICIENTS 5U
+#define NUM_BIQUAD_STATES 4U
+
+struct EmaFilter
+{
+    float smoothing_factor;
+    float output;
+    bool  has_output;
+};
+
+struct EmaFilterQ15
+{
+    int16_t smoothing_factor;
+
+    // The output is kept with 16 more fractional bits than the samples, so
+    // small differences between the input and the output aren't lost
+    int32_t output;
+    bool    has_output;
+};
+
+struct BiquadCascade
+{
+    size_t num_stages;
+    float *coefficients;
+
+    // { x[n-1], x[n-2], y[n-1], y[n-2] } of every stage
+    float *states;
+};
+
+struct BiquadCascadeQ15
+{
+    size_t   num_stages;
+    int16_t *coefficients;
+    uint8_t  post_shift;
+    int16_t *states;
+};
+
+struct FirDecimator
+{
+    size_t num_taps;
+    float *coefficients;
+    size_t decimation_factor;
+
+    // The latest input samples, which are written twice, num_taps samples
+    // apart, so the latest num_taps samples are always contiguous. They start
+    // at the write index, which is where the oldest sample is.
+    float *states;
+    size_t write_index;
+
+    // The number of input samples since the latest output sample
+    size_t num_samples_since_output;
+};
+
+struct FirDecimatorQ15
+{
+    size_t   num_taps;
+    int16_t *coefficients;
+    size_t   decimation_factor;
+    int16_t *states;
+    size_t   write_index;
+    size_t   num_samples_since_output;
+};
+
+struct MovingMedian
+{
+    size_t window_size;
+
+    // The input samples in the window in the order they were filtered, and in
+    // ascending order
+    float *samples;
+    float *sorted_samples;
+    size_t num_samples;
+    size_t oldest_index;
+};
+
+struct MovingMedianQ15
+{
+    size_t   window_size;
+    int16_t *samples;
+    int16_t *sorted_samples;
+    size_t   num_samples;
+    size_t   oldest_index;
+};
+
+struct RateLimiter
+{
+    float max_rise_per_sample;
+    float max_fall_per_sample;
+    float output;
+    bool  has_output;
+};
+
+struct RateLimiterQ15
+{
+    int32_t max_rise_per_sample;
+    int32_t max_fall_per_sample;
+    int16_t output;
+    bool    has_output;
+};
+
+/**
+ * Saturate the given value to the range of Q15 samples
+ * @param value The value to saturate
+ * @return The saturated value
+ */
+static int16_t Io_SaturateQ15(int64_t value);
+
+/**
+ * Insert the given sample into the sorted samples of a moving median, and
+ * remove the oldest sample from them once the window is full
+ * @param filter The moving median to insert the sample into
+ * @param sample The sample to insert
+ */
+static void
+    Io_InsertMovingMedianSample(struct MovingMedian *filter, float sample);
+
+/**
+ * Insert the given sample into the sorted samples of a moving median for Q15
+ * samples, and remove the oldest sample from them once the window is full
+ * @param filter The moving median to insert the sample into
+ * @param sample The sample to insert
+ */
+static void Io_InsertMovingMedianSampleQ15(
+    struct MovingMedianQ15 *filter,
+    int16_t                 sample);
+
+static int16_t Io_SaturateQ15(const int64_t value)
+{
+    if (value > INT16_MAX)
+    {
+        return INT16_MAX;
+    }
+    if (value < INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+    return (int16_t)value;
+}
+
+static void Io_InsertMovingMedianSample(
+    struct MovingMedian *const filter,
+    const float                sample)
+{
+    size_t num_sorted = filter->num_samples;
+
+    if (num_sorted == filter->window_size)
+    {
+        // Remove the oldest sample, and replace it with the new sample
+        const float oldest = filter->samples[filter->oldest_index];
+        size_t      i      = 0U;
+        while (filter->sorted_samples[i] != oldest)
+        {
+            i++;
+        }
+        memmove(
+            &filter->sorted_samples[i], &filter->sorted_samples[i + 1U],
+            (num_sorted - i - 1U) * sizeof(float));
+        num_sorted--;
+
+        filter->samples[filter->oldest_index] = sample;
+        filter->oldest_index =
+            (filter->oldest_index + 1U) % filter->window_size;
+    }
+    else
+    {
+        filter->samples[filter->num_samples] = sample;
+        filter->num_samples++;
+    }
+
+    size_t i = num_sorted;
+    while (i > 0U && filter->sorted_samples[i - 1U] > sample)
+    {
+        filter->sorted_samples[i] = filter->sorted_samples[i - 1U];
+        i--;
+    }
+    filter->sorted_samples[i] = sample;
+}
+
+static void Io_InsertMovingMedianSampleQ15(
+    struct MovingMedianQ15 *const filter,
+    const int16_t                 sample)
+{
+    size_t num_sorted = filter->num_samples;
+
+    if (num_sorted == filter->window_size)
+    {
+        const int16_t oldest = filter->samples[filter->oldest_index];
+        size_t        i      = 0U;
+        while (filter->sorted_samples[i] != oldest)
+        {
+            i++;
+        }
+        memmove(
+            &filter->sorted_samples[i], &filter->sorted_samples[i + 1U],
+            (num_sorted - i - 1U) * sizeof(int16_t));
+        num_sorted--;
+
+        filter->samples[filter->oldest_index] = sample;
+        filter->oldest_index =
+            (filter->oldest_index + 1U) % filter->window_size;
+    }
+    else
+    {
+        filter->samples[filter->num_samples] = sample;
+        filter->num_samples++;
+    }
+
+    size_t i = num_sorted;
+    while (i > 0U && filter->sorted_samples[i - 1U] > sample)
+    {
+        filter->sorted_samples[i] = filter->sorted_samples[i - 1U];
+        i--;
+    }
+    filter->sorted_samples[i] = sample;
+}
+
+struct EmaFilter *Io_SharedFilters_CreateEmaFilter(
+    const float sampling_time_s,
+    const float rc)
+{
+    assert(sampling_time_s > 0.0f);
+    assert(rc >= 0.0f);
+
+    struct EmaFilter *const filter = malloc(sizeof(struct EmaFilter));
+    assert(filter != NULL);
+
+    filter->smoothing_factor = sampling_time_s / (rc + sampling_time_s);
+    Io_SharedFilters_ResetEmaFilter(filter);
+
+    return filter;
+}
+
+struct EmaFilterQ15 *Io_SharedFilters_CreateEmaFilterQ15(
+    const float sampling_time_s,
+    const float rc)
+{
+    assert(sampling_time_s > 0.0f);
+    assert(rc >= 0.0f);
+
+    struct EmaFilterQ15 *const filter = malloc(sizeof(struct EmaFilterQ15));
+    assert(filter != NULL);
+
+    filter->smoothing_factor = Io_SaturateQ15(
+        (int64_t)(32768.0f * sampling_time_s / (rc + sampling_time_s) + 0.5f));
+    Io_SharedFilters_ResetEmaFilterQ15(filter);
+
+    return filter;
+}
+
+struct BiquadCascade *Io_SharedFilters_CreateBiquadCascade(
+    const size_t       num_stages,
+    const float *const coefficients)
+{
+    assert(num_stages > 0U);
+    assert(coefficients != NULL);
+
+    struct BiquadCascade *const filter = malloc(sizeof(struct BiquadCascade));
+    assert(filter != NULL);
+
+    filter->num_stages = num_stages;
+    filter->coefficients =
+        malloc(num_stages * NUM_BIQUAD_COEFFICIENTS * sizeof(float));
+    filter->states = malloc(num_stages * NUM_BIQUAD_STATES * sizeof(float));
+    assert(filter->coefficients != NULL);
+    assert(filter->states != NULL);
+
+    memcpy(
+        filter->coefficients, coefficients,
+        num_stages * NUM_BIQUAD_COEFFICIENTS * sizeof(float));
+    Io_SharedFilters_ResetBiquadCascade(filter);
+
+    return filter;
+}
+
+struct BiquadCascadeQ15 *Io_SharedFilters_CreateBiquadCascadeQ15(
+    const size_t         num_stages,
+    const int16_t *const coefficients,
+    const uint8_t        post_shift)
+{
+    assert(num_stages > 0U);
+    assert(coefficients != NULL);
+    assert(post_shift < 15U);
+
+    struct BiquadCascadeQ15 *const filter =
+        malloc(sizeof(struct BiquadCascadeQ15));
+    assert(filter != NULL);
+
+    filter->num_stages = num_stages;
+    filter->post_shift = post_shift;
+    filter->coefficients =
+        malloc(num_stages * NUM_BIQUAD_COEFFICIENTS * sizeof(int16_t));
+    filter->states = malloc(num_stages * NUM_BIQUAD_STATES * sizeof(int16_t));
+    assert(filter->coefficients != NULL);
+    assert(filter->states != NULL);
+
+    memcpy(
+        filter->coefficients, coefficients,
+        num_stages * NUM_BIQUAD_COEFFICIENTS * sizeof(int16_t));
+    Io_SharedFilters_ResetBiquadCascadeQ15(filter);
+
+    return filter;
+}
+
+struct FirDecimator *Io_SharedFilters_CreateFirDecimator(
+    const size_t       num_taps,
+    const float *const coefficients,
+    const size_t       decimation_factor)
+{
+    assert(num_taps > 0U);
+    assert(coefficients != NULL);
+    assert(decimation_factor > 0U);
+
+    struct FirDecimator *const filter = malloc(sizeof(struct FirDecimator));
+    assert(filter != NULL);
+
+    filter->num_taps          = num_taps;
+    filter->decimation_factor = decimation_factor;
+    filter->coefficients      = malloc(num_taps * sizeof(float));
+    filter->states            = malloc(2U * num_taps * sizeof(float));
+    assert(filter->coefficients != NULL);
+    assert(filter->states != NULL);
+
+    memcpy(filter->coefficients, coefficients, num_taps * sizeof(float));
+    Io_SharedFilters_ResetFirDecimator(filter);
+
+    return filter;
+}
+
+struct FirDecimatorQ15 *Io_SharedFilters_CreateFirDecimatorQ15(
+    const size_t         num_taps,
+    const int16_t *const coefficients,
+    const size_t         decimation_factor)
+{
+    assert(num_taps > 0U);
+    assert(coefficients != NULL);
+    assert(decimation_factor > 0U);
+
+    struct FirDecimatorQ15 *const filter =
+        malloc(sizeof(struct FirDecimatorQ15));
+    assert(filter != NULL);
+
+    filter->num_taps          = num_taps;
+    filter->decimation_factor = decimation_factor;
+    filter->coefficients      = malloc(num_taps * sizeof(int16_t));
+    filter->states            = malloc(2U * num_taps * sizeof(int16_t));
+    assert(filter->coefficients != NULL);
+    assert(filter->states != NULL);
+
+    memcpy(filter->coefficients, coefficients, num_taps * sizeof(int16_t));
+    Io_SharedFilters_ResetFirDecimatorQ15(filter);
+
+    return filter;
+}
+
+struct MovingMedian *
+    Io_SharedFilters_CreateMovingMedian(const size_t window_size)
+{
+    assert(window_size % 2U == 1U);
+
+    struct MovingMedian *const filter = malloc(sizeof(struct MovingMedian));
+    assert(filter != NULL);
+
+    filter->window_size    = window_size;
+    filter->samples        = malloc(window_size * sizeof(float));
+    filter->sorted_samples = malloc(window_size * sizeof(float));
+    assert(filter->samples != NULL);
+    assert(filter->sorted_samples != NULL);
+
+    Io_SharedFilters_ResetMovingMedian(filter);
+
+    return filter;
+}
+
+struct MovingMedianQ15 *
+    Io_SharedFilters_CreateMovingMedianQ15(const size_t window_size)
+{
+    assert(window_size % 2U == 1U);
+
+    struct MovingMedianQ15 *const filter =
+        malloc(sizeof(struct MovingMedianQ15));
+    assert(filter != NULL);
+
+    filter->window_size    = window_size;
+    filter->samples        = malloc(window_size * sizeof(int16_t));
+    filter->sorted_samples = malloc(window_size * sizeof(int16_t));
+    assert(filter->samples != NULL);
+    assert(filter->sorted_samples != NULL);
+
+    Io_SharedFilters_ResetMovingMedianQ15(filter);
+
+    return filter;
+}
+
+struct RateLimiter *Io_SharedFilters_CreateRateLimiter(
+    const float sampling_time_s,
+    const float max_rise_rate,
+    const float max_fall_rate)
+{
+    assert(sampling_time_s > 0.0f);
+    assert(max_rise_rate >= 0.0f);
+    assert(max_fall_rate >= 0.0f);
+
+    struct RateLimiter *const filter = malloc(sizeof(struct RateLimiter));
+    assert(filter != NULL);
+
+    filter->max_rise_per_sample = max_rise_rate * sampling_time_s;
+    filter->max_fall_per_sample = max_fall_rate * sampling_time_s;
+    Io_SharedFilters_ResetRateLimiter(filter);
+
+    return filter;
+}
+
+struct RateLimiterQ15 *Io_SharedFilters_CreateRateLimiterQ15(
+    const uint16_t max_rise_per_sample,
+    const uint16_t max_fall_per_sample)
+{
+    struct RateLimiterQ15 *const filter = malloc(sizeof(struct RateLimiterQ15));
+    assert(filter != NULL);
+
+    filter->max_rise_per_sample = max_rise_per_sample;
+    filter->max_fall_per_sample = max_fall_per_sample;
+    Io_SharedFilters_ResetRateLimiterQ15(filter);
+
+    return filter;
+}
+
+void Io_SharedFilters_DestroyEmaFilter(struct EmaFilter *const filter)
+{
+    free(filter);
+}
+
+void Io_SharedFilters_DestroyEmaFilterQ15(struct EmaFilterQ15 *const filter)
 {
-    float32_t smoothing_factor;
+    free(filter);
+}
+
+void Io_SharedFilters_DestroyBiquadCascade(struct BiquadCascade *const filter)
+{
+    free(filter->coefficients);
+    free(filter->states);
+    free(filter);
+}
+
+void Io_SharedFilters_DestroyBiquadCascadeQ15(
+    struct BiquadCascadeQ15 *const filter)
+{
+    free(filter->coefficients);
+    free(filter->states);
+    free(filter);
+}
+
+void Io_SharedFilters_DestroyFirDecimator(struct FirDecimator *const filter)
+{
+    free(filter->coefficients);
+    free(filter->states);
+    free(filter);
+}
+
+void Io_SharedFilters_DestroyFirDecimatorQ15(
+    struct FirDecimatorQ15 *const filter)
+{
+    free(filter->coefficients);
+    free(filter->states);
+    free(filter);
+}
+
+void Io_SharedFilters_DestroyMovingMedian(struct MovingMedian *const filter)
+{
+    free(filter->samples);
+    free(filter->sorted_samples);
+    free(filter);
+}
+
+void Io_SharedFilters_DestroyMovingMedianQ15(
+    struct MovingMedianQ15 *const filter)
+{
+    free(filter->samples);
+    free(filter->sorted_samples);
+    free(filter);
+}
+
+void Io_SharedFilters_DestroyRateLimiter(struct RateLimiter *const filter)
+{
+    free(filter);
+}
+
+void Io_SharedFilters_DestroyRateLimiterQ15(struct RateLimiterQ15 *const filter)
+{
+    free(filter);
+}
+
+void Io_SharedFilters_ResetEmaFilter(struct EmaFilter *const filter)
+{
+    filter->output     = 0.0f;
+    filter->has_output = false;
+}
+
+void Io_SharedFilters_ResetEmaFilterQ15(struct EmaFilterQ15 *const filter)
+{
+    filter->output     = 0;
+    filter->has_output = false;
+}
+
+void Io_SharedFilters_ResetBiquadCascade(struct BiquadCascade *const filter)
+{
+    memset(
+        filter->states, 0,
+        filter->num_stages * NUM_BIQUAD_STATES * sizeof(float));
+}
+
+void Io_SharedFilters_ResetBiquadCascadeQ15(
+    struct BiquadCascadeQ15 *const filter)
+{
+    memset(
+        filter->states, 0,
+        filter->num_stages * NUM_BIQUAD_STATES * sizeof(int16_t));
+}
+
+void Io_SharedFilters_ResetFirDecimator(struct FirDecimator *const filter)
+{
+    memset(filter->states, 0, 2U * filter->num_taps * sizeof(float));
+    filter->write_index              = 0U;
+    filter->num_samples_since_output = 0U;
+}
+
+void Io_SharedFilters_ResetFirDecimatorQ15(struct FirDecimatorQ15 *const filter)
+{
+    memset(filter->states, 0, 2U * filter->num_taps * sizeof(int16_t));
+    filter->write_index              = 0U;
+    filter->num_samples_since_output = 0U;
+}
+
+void Io_SharedFilters_ResetMovingMedian(struct MovingMedian *const filter)
+{
+    filter->num_samples  = 0U;
+    filter->oldest_index = 0U;
+}
+
+void Io_SharedFilters_ResetMovingMedianQ15(struct MovingMedianQ15 *const filter)
+{
+    filter->num_samples  = 0U;
+    filter->oldest_index = 0U;
+}
+
+void Io_SharedFilters_ResetRateLimiter(struct RateLimiter *const filter)
+{
+    filter->output     = 0.0f;
+    filter->has_output = false;
+}
+
+void Io_SharedFilters_ResetRateLimiterQ15(struct RateLimiterQ15 *const filter)
+{
+    filter->output     = 0;
+    filter->has_output = false;
+}
+
+void Io_SharedFilters_ApplyEmaFilter(
+    struct EmaFilter *const filter,
+    const float *const      input,
+    float *const            output,
+    const size_t            num_samples)
+{
+    if (num_samples > 0U && !filter->has_output)
+    {
+        filter->output     = input[0];
+        filter->has_output = true;
+    }
+
+    // The change from one filter output to the next is proportional to the
+    // difference between the previous output and the next input
+    float y = filter->output;
+    for (size_t i = 0U; i < num_samples; i++)
+    {
+        y += filter->smoothing_factor * (input[i] - y);
+        output[i] = y;
+    }
+    filter->output = y;
+}
+
+void Io_SharedFilters_ApplyEmaFilterQ15(
+    struct EmaFilterQ15 *const filter,
+    const int16_t *const       input,
+    int16_t *const             output,
+    const size_t               num_samples)
+{
+    if (num_samples > 0U && !filter->has_output)
+    {
+        filter->output     = (int32_t)input[0] * 65536;
+        filter->has_output = true;
+    }
+
+    int32_t y = filter->output;
+    for (size_t i = 0U; i < num_samples; i++)
+    {
+        const int64_t difference = (int64_t)input[i] * 65536 - y;
+        y += (int32_t)((filter->smoothing_factor * difference) >> 15);
+
+        // Round to the nearest output sample
+        output[i] = Io_SaturateQ15(((int64_t)y + 32768) >> 16);
+    }
+    filter->output = y;
+}
+
+void Io_SharedFilters_ApplyBiquadCascade(
+    struct BiquadCascade *const filter,
+    const float *const          input,
+    float *const                output,
+    const size_t                num_samples)
+{
+    const float *in = input;
+
+    for (size_t stage = 0U; stage < filter->num_stages; stage++)
+    {
+        const float *const b =
+            &filter->coefficients[stage * NUM_BIQUAD_COEFFICIENTS];
+        float *const state = &filter->states[stage * NUM_BIQUAD_STATES];
+        float        x1 = state[0], x2 = state[1], y1 = state[2], y2 = state[3];
+
+        // Every stage filters the whole block in place after the first, which
+        // keeps the state of each stage in registers for the whole block
+        for (size_t i = 0U; i < num_samples; i++)
+        {
+            const float x = in[i];
+            const float y =
+                b[0] * x + b[1] * x1 + b[2] * x2 + b[3] * y1 + b[4] * y2;
+            x2        = x1;
+            x1        = x;
+            y2        = y1;
+            y1        = y;
+            output[i] = y;
+        }
+
+        state[0] = x1;
+        state[1] = x2;
+        state[2] = y1;
+        state[3] = y2;
+        in       = output;
+    }
+}
+
+void Io_SharedFilters_ApplyBiquadCascadeQ15(
+    struct BiquadCascadeQ15 *const filter,
+    const int16_t *const           input,
+    int16_t *const                 output,
+    const size_t                   num_samples)
+{
+    const int16_t *in    = input;
+    const int32_t  shift = 15 - (int32_t)filter->post_shift;
+
+    for (size_t stage = 0U; stage < filter->num_stages; stage++)
+    {
+        const int16_t *const b =
+            &filter->coefficients[stage * NUM_BIQUAD_COEFFICIENTS];
+        int16_t *const state = &filter->states[stage * NUM_BIQUAD_STATES];
+        int16_t x1 = state[0], x2 = state[1], y1 = state[2], y2 = state[3];
+
+        for (size_t i = 0U; i < num_samples; i++)
+        {
+            const int16_t x   = in[i];
+            const int64_t acc = (int64_t)b[0] * x + (int64_t)b[1] * x1 +
+                                (int64_t)b[2] * x2 + (int64_t)b[3] * y1 +
+                                (int64_t)b[4] * y2;
+
+            // Round to the nearest output sample
+            const int16_t y =
+                Io_SaturateQ15((acc + ((int64_t)1 << (shift - 1))) >> shift);
+            x2        = x1;
+            x1        = x;
+            y2        = y1;
+            y1        = y;
+            output[i] = y;
+        }
+
+        state[0] = x1;
+        state[1] = x2;
+        state[2] = y1;
+        state[3] = y2;
+        in       = output;
+    }
+}
+
+size_t Io_SharedFilters_ApplyFirDecimator(
+    struct FirDecimator *const filter,
+    const float *const         input,
+    float *const               output,
+    const size_t               num_samples)
+{
+    const size_t num_taps    = filter->num_taps;
+    size_t       num_outputs = 0U;
+
+    for (size_t i = 0U; i < num_samples; i++)
+    {
+        filter->states[filter->write_index]            = input[i];
+        filter->states[filter->write_index + num_taps] = input[i];
+        filter->write_index = (filter->write_index + 1U) % num_taps;
+        filter->num_samples_since_output++;
+
+        if (filter->num_samples_since_output == filter->decimation_factor)
+        {
+            // The newest input sample is at the end of the window
+            const float *const newest =
+                &filter->states[filter->write_index + num_taps - 1U];
+            float sum = 0.0f;
+            for (size_t tap = 0U; tap < num_taps; tap++)
+            {
+                sum += filter->coefficients[tap] * *(newest - tap);
+            }
+
+            output[num_outputs++]            = sum;
+            filter->num_samples_since_output = 0U;
+        }
+    }
 
-    smoothing_factor = sampling_time / (rc + sampling_time);
+    return num_outputs;
+}
+
+size_t Io_SharedFilters_ApplyFirDecimatorQ15(
+    struct FirDecimatorQ15 *const filter,
+    const int16_t *const          input,
+    int16_t *const                output,
+    const size_t                  num_samples)
+{
+    const size_t num_taps    = filter->num_taps;
+    size_t       num_outputs = 0U;
+
+    for (size_t i = 0U; i < num_samples; i++)
+    {
+        filter->states[filter->write_index]            = input[i];
+        filter->states[filter->write_index + num_taps] = input[i];
+        filter->write_index = (filter->write_index + 1U) % num_taps;
+        filter->num_samples_since_output++;
+
+        if (filter->num_samples_since_output == filter->decimation_factor)
+        {
+            const int16_t *const newest =
+                &filter->states[filter->write_index + num_taps - 1U];
+            int64_t sum = 0;
+            for (size_t tap = 0U; tap < num_taps; tap++)
+            {
+                sum += (int64_t)filter->coefficients[tap] * *(newest - tap);
+            }
+
+            output[num_outputs++] = Io_SaturateQ15((sum + 16384) >> 15);
+            filter->num_samples_since_output = 0U;
+        }
+    }
+
+    return num_outputs;
+}
+
+void Io_SharedFilters_ApplyMovingMedian(
+    struct MovingMedian *const filter,
+    const float *const         input,
+    float *const               output,
+    const size_t               num_samples)
+{
+    for (size_t i = 0U; i < num_samples; i++)
+    {
+        Io_InsertMovingMedianSample(filter, input[i]);
+        output[i] = filter->sorted_samples[filter->num_samples / 2U];
+    }
+}
+
+void Io_SharedFilters_ApplyMovingMedianQ15(
+    struct MovingMedianQ15 *const filter,
+    const int16_t *const          input,
+    int16_t *const                output,
+    const size_t                  num_samples)
+{
+    for (size_t i = 0U; i < num_samples; i++)
+    {
+        Io_InsertMovingMedianSampleQ15(filter, input[i]);
+        output[i] = filter->sorted_samples[filter->num_samples / 2U];
+    }
+}
+
+void Io_SharedFilters_ApplyRateLimiter(
+    struct RateLimiter *const filter,
+    const float *const        input,
+    float *const              output,
+    const size_t              num_samples)
+{
+    if (num_samples > 0U && !filter->has_output)
+    {
+        filter->output     = input[0];
+        filter->has_output = true;
+    }
+
+    float y = filter->output;
+    for (size_t i = 0U; i < num_samples; i++)
+    {
+        const float change = input[i] - y;
+        if (change > filter->max_rise_per_sample)
+        {
+            y += filter->max_rise_per_sample;
+        }
+        else if (change < -filter->max_fall_per_sample)
+        {
+            y -= filter->max_fall_per_sample;
+        }
+        else
+        {
+            y = input[i];
+        }
+        output[i] = y;
+    }
+    filter->output = y;
+}
+
+void Io_SharedFilters_ApplyRateLimiterQ15(
+    struct RateLimiterQ15 *const filter,
+    const int16_t *const         input,
+    int16_t *const               output,
+    const size_t                 num_samples)
+{
+    if (num_samples > 0U && !filter->has_output)
+    {
+        filter->output     = input[0];
+        filter->has_output = true;
+    }
 
-    // The pseudo-code for this LPF implementation is as follows:
-    // y[i] = y[i-1] + SmoothingFactor * ( x[i] - y[i-1] ), where y =
-    // output, x = input. That is, the change from one filter output
-    // to the next is proportional to the difference between the previous
-    // output and the next input.
-    for (uint32_t i = 0; i < num_of_samples; i++)
+    int16_t y = filter->output;
+    for (size_t i = 0U; i < num_samples; i++)
     {
-        output[i] = output[i] + smoothing_factor * (input[i] - output[i]);
+        const int32_t change = (int32_t)input[i] - y;
+        if (change > filter->max_rise_per_sample)
+        {
+            y = (int16_t)(y + filter->max_rise_per_sample);
+        }
+        else if (change < -filter->max_fall_per_sample)
+        {
+            y = (int16_t)(y - filter->max_fall_per_sample);
+        }
+        else
+        {
+            y = input[i];
+        }
+        output[i] = y;
     }
+    filter->output = y;
 }
@@ -0,0 +1,265 @@
+#include <assert.h>
+#include <stdint.h>
+
+#ifdef __arm__
+#include "Io_SharedCycleCounter.h"
+#elif __unix__ || __APPLE__
+#include <time.h>
+#elif _WIN32
+#include <windows.h>
+#else
+#error "Could not determine what CPU this is being compiled for."
+#endif
+
+#include "Io_SharedFilters.h"
+#include "Io_SharedFiltersBenchmark.h"
+
+// Second-order Butterworth low pass filters with a cutoff at a tenth of the
+// sampling frequency, in the coefficient format of the biquad cascades. The Q15
+// coefficients are scaled down by 2^1.
+static const float biquad_coefficients[] = {
+    0.067455f, 0.134911f, 0.067455f, 1.142981f, -0.412802f,
+    0.067455f, 0.134911f, 0.067455f, 1.142981f, -0.412802f,
+};
+static const int16_t biquad_coefficients_q15[] = {
+    1105, 2210, 1105, 18727, -6763, 1105, 2210, 1105, 18727, -6763,
+};
+
+// Moving average over 16 samples
+#define NUM_FIR_TAPS 16U
+static const float fir_coefficients[NUM_FIR_TAPS] = {
+    0.0625f, 0.0625f, 0.0625f, 0.0625f, 0.0625f, 0.0625f, 0.0625f, 0.0625f,
+    0.0625f, 0.0625f, 0.0625f, 0.0625f, 0.0625f, 0.0625f, 0.0625f, 0.0625f,
+};
+static const int16_t fir_coefficients_q15[NUM_FIR_TAPS] = {
+    2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048,
+    2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048,
+};
+
+static float   input_block[FILTERS_BENCHMARK_BLOCK_SIZE];
+static float   output_block[FILTERS_BENCHMARK_BLOCK_SIZE];
+static int16_t input_block_q15[FILTERS_BENCHMARK_BLOCK_SIZE];
+static int16_t output_block_q15[FILTERS_BENCHMARK_BLOCK_SIZE];
+
+/**
+ * Enable the cycle counter used to measure the cost of the filters
+ */
+static void Io_EnableCycleCounter(void);
+
+/**
+ * Get the current value of the cycle counter. The counter is free-running and
+ * wraps around, so only the difference between two readings is meaningful.
+ * @return The CPU cycle count on ARM, or a nanosecond timestamp on x86
+ */
+static uint32_t Io_GetCycleCount(void);
+
+/**
+ * Measure the cost of filtering one sample by filtering the benchmark's blocks
+ * with the given function
+ * @param apply_filter The function filtering a block with the given filter
+ * @param filter The filter to filter the blocks with
+ * @param num_blocks The number of blocks to filter
+ * @return The cost of filtering one sample, in cycle counter units
+ */
+static float Io_MeasureCostPerSample(
+    void (*apply_filter)(void *),
+    void *       filter,
+    unsigned int num_blocks);
+
+/**
+ * Filter the benchmark's block with the given filter
+ * @param filter The filter to filter the block with
+ */
+static void Io_ApplyEmaFilter(void *filter);
+static void Io_ApplyEmaFilterQ15(void *filter);
+static void Io_ApplyBiquadCascade(void *filter);
+static void Io_ApplyBiquadCascadeQ15(void *filter);
+static void Io_ApplyFirDecimator(void *filter);
+static void Io_ApplyFirDecimatorQ15(void *filter);
+static void Io_ApplyMovingMedian(void *filter);
+static void Io_ApplyMovingMedianQ15(void *filter);
+static void Io_ApplyRateLimiter(void *filter);
+static void Io_ApplyRateLimiterQ15(void *filter);
+
+static void Io_EnableCycleCounter(void)
+{
+#ifdef __arm__
+    Io_SharedCycleCounter_Init();
+#endif
+}
+
+static uint32_t Io_GetCycleCount(void)
+{
+#ifdef __arm__
+    return Io_SharedCycleCounter_GetCycleCount();
+#elif __unix__ || __APPLE__
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)(
+        (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec);
+#elif _WIN32
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (uint32_t)counter.QuadPart;
+#endif
+}
+
+static float Io_MeasureCostPerSample(
+    void (*const apply_filter)(void *),
+    void *const        filter,
+    const unsigned int num_blocks)
+{
+    uint64_t total_cost = 0U;
+
+    for (unsigned int i = 0U; i < num_blocks; i++)
+    {
+        const uint32_t start = Io_GetCycleCount();
+        apply_filter(filter);
+        total_cost += Io_GetCycleCount() - start;
+    }
+
+    return (float)total_cost /
+           (float)(num_blocks * FILTERS_BENCHMARK_BLOCK_SIZE);
+}
+
+static void Io_ApplyEmaFilter(void *const filter)
+{
+    Io_SharedFilters_ApplyEmaFilter(
+        filter, input_block, output_block, FILTERS_BENCHMARK_BLOCK_SIZE);
+}
+
+static void Io_ApplyEmaFilterQ15(void *const filter)
+{
+    Io_SharedFilters_ApplyEmaFilterQ15(
+        filter, input_block_q15, output_block_q15,
+        FILTERS_BENCHMARK_BLOCK_SIZE);
+}
+
+static void Io_ApplyBiquadCascade(void *const filter)
+{
+    Io_SharedFilters_ApplyBiquadCascade(
+        filter, input_block, output_block, FILTERS_BENCHMARK_BLOCK_SIZE);
+}
+
+static void Io_ApplyBiquadCascadeQ15(void *const filter)
+{
+    Io_SharedFilters_ApplyBiquadCascadeQ15(
+        filter, input_block_q15, output_block_q15,
+        FILTERS_BENCHMARK_BLOCK_SIZE);
+}
+
+static void Io_ApplyFirDecimator(void *const filter)
+{
+    Io_SharedFilters_ApplyFirDecimator(
+        filter, input_block, output_block, FILTERS_BENCHMARK_BLOCK_SIZE);
+}
+
+static void Io_ApplyFirDecimatorQ15(void *const filter)
+{
+    Io_SharedFilters_ApplyFirDecimatorQ15(
+        filter, input_block_q15, output_block_q15,
+        FILTERS_BENCHMARK_BLOCK_SIZE);
+}
+
+static void Io_ApplyMovingMedian(void *const filter)
+{
+    Io_SharedFilters_ApplyMovingMedian(
+        filter, input_block, output_block, FILTERS_BENCHMARK_BLOCK_SIZE);
+}
+
+static void Io_ApplyMovingMedianQ15(void *const filter)
+{
+    Io_SharedFilters_ApplyMovingMedianQ15(
+        filter, input_block_q15, output_block_q15,
+        FILTERS_BENCHMARK_BLOCK_SIZE);
+}
+
+static void Io_ApplyRateLimiter(void *const filter)
+{
+    Io_SharedFilters_ApplyRateLimiter(
+        filter, input_block, output_block, FILTERS_BENCHMARK_BLOCK_SIZE);
+}
+
+static void Io_ApplyRateLimiterQ15(void *const filter)
+{
+    Io_SharedFilters_ApplyRateLimiterQ15(
+        filter, input_block_q15, output_block_q15,
+        FILTERS_BENCHMARK_BLOCK_SIZE);
+}
+
+void Io_SharedFiltersBenchmark_Run(
+    const unsigned int                    num_blocks,
+    struct FiltersBenchmarkResults *const results)
+{
+    assert(num_blocks > 0U);
+
+    Io_EnableCycleCounter();
+
+    // Filter a noisy square wave, so the moving medians and the rate limiters
+    // take every branch
+    uint32_t noise = 1U;
+    for (uint32_t i = 0U; i < FILTERS_BENCHMARK_BLOCK_SIZE; i++)
+    {
+        noise              = noise * 1664525U + 1013904223U;
+        const int16_t step = (i / 8U) % 2U == 0U ? 8192 : -8192;
+        input_block_q15[i] = (int16_t)(step + (int16_t)(noise >> 22) - 512);
+        input_block[i]     = (float)input_block_q15[i] / 32768.0f;
+    }
+
+    struct EmaFilter *const ema_filter =
+        Io_SharedFilters_CreateEmaFilter(0.001f, 0.01f);
+    struct EmaFilterQ15 *const ema_filter_q15 =
+        Io_SharedFilters_CreateEmaFilterQ15(0.001f, 0.01f);
+    results->ema_filter =
+        Io_MeasureCostPerSample(Io_ApplyEmaFilter, ema_filter, num_blocks);
+    results->ema_filter_q15 = Io_MeasureCostPerSample(
+        Io_ApplyEmaFilterQ15, ema_filter_q15, num_blocks);
+    Io_SharedFilters_DestroyEmaFilter(ema_filter);
+    Io_SharedFilters_DestroyEmaFilterQ15(ema_filter_q15);
+
+    struct BiquadCascade *const biquad_cascade =
+        Io_SharedFilters_CreateBiquadCascade(2U, biquad_coefficients);
+    struct BiquadCascadeQ15 *const biquad_cascade_q15 =
+        Io_SharedFilters_CreateBiquadCascadeQ15(
+            2U, biquad_coefficients_q15, 1U);
+    results->biquad_cascade = Io_MeasureCostPerSample(
+        Io_ApplyBiquadCascade, biquad_cascade, num_blocks);
+    results->biquad_cascade_q15 = Io_MeasureCostPerSample(
+        Io_ApplyBiquadCascadeQ15, biquad_cascade_q15, num_blocks);
+    Io_SharedFilters_DestroyBiquadCascade(biquad_cascade);
+    Io_SharedFilters_DestroyBiquadCascadeQ15(biquad_cascade_q15);
+
+    struct FirDecimator *const fir_decimator =
+        Io_SharedFilters_CreateFirDecimator(NUM_FIR_TAPS, fir_coefficients, 4U);
+    struct FirDecimatorQ15 *const fir_decimator_q15 =
+        Io_SharedFilters_CreateFirDecimatorQ15(
+            NUM_FIR_TAPS, fir_coefficients_q15, 4U);
+    results->fir_decimator = Io_MeasureCostPerSample(
+        Io_ApplyFirDecimator, fir_decimator, num_blocks);
+    results->fir_decimator_q15 = Io_MeasureCostPerSample(
+        Io_ApplyFirDecimatorQ15, fir_decimator_q15, num_blocks);
+    Io_SharedFilters_DestroyFirDecimator(fir_decimator);
+    Io_SharedFilters_DestroyFirDecimatorQ15(fir_decimator_q15);
+
+    struct MovingMedian *const moving_median =
+        Io_SharedFilters_CreateMovingMedian(5U);
+    struct MovingMedianQ15 *const moving_median_q15 =
+        Io_SharedFilters_CreateMovingMedianQ15(5U);
+    results->moving_median = Io_MeasureCostPerSample(
+        Io_ApplyMovingMedian, moving_median, num_blocks);
+    results->moving_median_q15 = Io_MeasureCostPerSample(
+        Io_ApplyMovingMedianQ15, moving_median_q15, num_blocks);
+    Io_SharedFilters_DestroyMovingMedian(moving_median);
+    Io_SharedFilters_DestroyMovingMedianQ15(moving_median_q15);
+
+    struct RateLimiter *const rate_limiter =
+        Io_SharedFilters_CreateRateLimiter(0.001f, 100.0f, 100.0f);
+    struct RateLimiterQ15 *const rate_limiter_q15 =
+        Io_SharedFilters_CreateRateLimiterQ15(3277U, 3277U);
+    results->rate_limiter =
+        Io_MeasureCostPerSample(Io_ApplyRateLimiter, rate_limiter, num_blocks);
+    results->rate_limiter_q15 = Io_MeasureCostPerSample(
+        Io_ApplyRateLimiterQ15, rate_limiter_q15, num_blocks);
+    Io_SharedFilters_DestroyRateLimiter(rate_limiter);
+    Io_SharedFilters_DestroyRateLimiterQ15(rate_limiter_q15);
+}
@@ -0,0 +1,164 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __arm__
+#include "Io_SharedCycleCounter.h"
+#elif __unix__ || __APPLE__
+#include <time.h>
+#elif _WIN32
+#include <windows.h>
+#else
+#error "Could not determine what CPU this is being compiled for."
+#endif
+
+#include "App_SharedSignalEngine.h"
+#include "Io_SharedSignalEngineBenchmark.h"
+
+// One in this many signals has its entry condition high
+#define ACTIVE_SIGNAL_PERIOD 8U
+
+// The number of times a callback function was called, so the calls can't be
+// optimized out
+static volatile uint32_t num_callbacks;
+
+/**
+ * Enable the cycle counter used to measure the cost of the signal engine
+ */
+static void Io_EnableCycleCounter(void);
+
+/**
+ * Get the current value of the cycle counter. The counter is free-running and
+ * wraps around, so only the difference between two readings is meaningful.
+ * @return The CPU cycle count on ARM, or a nanosecond timestamp on x86
+ */
+static uint32_t Io_GetCycleCount(void);
+
+/**
+ * Measure the cost of one tick of the given signal engine
+ * @param signal_engine The signal engine to tick
+ * @param num_ticks The number of ticks to measure
+ * @return The cost of one tick, in cycle counter units
+ */
+static float Io_MeasureCostPerTick(
+    struct SignalEngine *signal_engine,
+    unsigned int         num_ticks);
+
+/**
+ * The condition functions of the benchmark's signals
+ * @return Whether the condition is high
+ */
+static bool Io_IsHigh(struct World *world);
+static bool Io_IsLow(struct World *world);
+
+/**
+ * The callback function of the benchmark's signals
+ */
+static void Io_Callback(struct World *world);
+
+static void Io_EnableCycleCounter(void)
+{
+#ifdef __arm__
+    Io_SharedCycleCounter_Init();
+#endif
+}
+
+static uint32_t Io_GetCycleCount(void)
+{
+#ifdef __arm__
+    return Io_SharedCycleCounter_GetCycleCount();
+#elif __unix__ || __APPLE__
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)(
+        (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec);
+#elif _WIN32
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (uint32_t)counter.QuadPart;
+#endif
+}
+
+static float Io_MeasureCostPerTick(
+    struct SignalEngine *const signal_engine,
+    const unsigned int         num_ticks)
+{
+    uint64_t total_cost = 0U;
+
+    for (unsigned int i = 0U; i < num_ticks; i++)
+    {
+        const uint32_t start = Io_GetCycleCount();
+        App_SharedSignalEngine_Tick(signal_engine, i + 1U);
+        total_cost += Io_GetCycleCount() - start;
+    }
+
+    return (float)total_cost / (float)num_ticks;
+}
+
+static bool Io_IsHigh(struct World *const world)
+{
+    (void)world;
+    return true;
+}
+
+static bool Io_IsLow(struct World *const world)
+{
+    (void)world;
+    return false;
+}
+
+static void Io_Callback(struct World *const world)
+{
+    (void)world;
+    num_callbacks++;
+}
+
+void Io_SharedSignalEngineBenchmark_Run(
+    const unsigned int                         num_ticks,
+    struct SignalEngineBenchmarkResults *const results)
+{
+    assert(num_ticks > 0U);
+
+    Io_EnableCycleCounter();
+
+    struct SignalEngine *const idle_signals = App_SharedSignalEngine_Create(
+        0U, NULL, SIGNAL_ENGINE_BENCHMARK_NUM_SIGNALS);
+    struct SignalEngine *const active_signals = App_SharedSignalEngine_Create(
+        0U, NULL, SIGNAL_ENGINE_BENCHMARK_NUM_SIGNALS);
+    struct SignalEngine *const active_wait_signals =
+        App_SharedSignalEngine_Create(
+            0U, NULL, SIGNAL_ENGINE_BENCHMARK_NUM_SIGNALS);
+
+    const struct SignalCallback signal_callback = {
+        .entry_condition_high_duration_ms = 50U,
+        .exit_condition_high_duration_ms  = 50U,
+        .function                         = Io_Callback,
+    };
+    const struct WaitSignalCallback wait_signal_callback = {
+        .wait_duration_ms = 50U,
+        .function         = Io_Callback,
+    };
+
+    for (uint32_t i = 0U; i < SIGNAL_ENGINE_BENCHMARK_NUM_SIGNALS; i++)
+    {
+        const bool is_active = i % ACTIVE_SIGNAL_PERIOD == 0U;
+
+        App_SharedSignalEngine_AddSignal(
+            idle_signals, Io_IsLow, Io_IsLow, signal_callback);
+        App_SharedSignalEngine_AddSignal(
+            active_signals, is_active ? Io_IsHigh : Io_IsLow, Io_IsLow,
+            signal_callback);
+        App_SharedSignalEngine_AddWaitSignal(
+            active_wait_signals, is_active ? Io_IsHigh : Io_IsLow,
+            wait_signal_callback);
+    }
+
+    results->idle_signals   = Io_MeasureCostPerTick(idle_signals, num_ticks);
+    results->active_signals = Io_MeasureCostPerTick(active_signals, num_ticks);
+    results->active_wait_signals =
+        Io_MeasureCostPerTick(active_wait_signals, num_ticks);
+
+    App_SharedSignalEngine_Destroy(idle_signals);
+    App_SharedSignalEngine_Destroy(active_signals);
+    App_SharedSignalEngine_Destroy(active_wait_signals);
+}
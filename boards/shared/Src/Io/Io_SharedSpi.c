@@ -130,3 +130,26 @@ HAL_StatusTypeDef Io_SharedSpi_TransmitWithoutNssToggle(
         spi_interface->spi_handle, tx_data, tx_buffer_size,
         spi_interface->timeout_ms);
 }
+
+HAL_StatusTypeDef Io_SharedSpi_TransmitAndReceiveDma(
+    const struct SharedSpi *const spi_interface,
+    uint8_t *                     tx_buffer,
+    uint8_t *                     rx_buffer,
+    uint16_t                      buffer_size)
+{
+    Io_SharedSpi_SetNssLow(spi_interface);
+    HAL_StatusTypeDef status = HAL_SPI_TransmitReceive_DMA(
+        spi_interface->spi_handle, tx_buffer, rx_buffer, buffer_size);
+    if (status != HAL_OK)
+    {
+        Io_SharedSpi_SetNssHigh(spi_interface);
+    }
+
+    return status;
+}
+
+SPI_HandleTypeDef *
+    Io_SharedSpi_GetSpiHandle(const struct SharedSpi *const spi_interface)
+{
+    return spi_interface->spi_handle;
+}
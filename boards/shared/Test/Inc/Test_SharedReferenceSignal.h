@@ -1,28 +1,18 @@
 #pragma once
 
+// A standalone signal, updated by checking its conditions against the time
+// they were last observed to be low. It is only used as a reference for how the
+// signals in App_SharedSignalEngine should behave.
+
 #include <stdbool.h>
 #include <stdint.h>
-#include "configs/App_SharedSignalConfig.h"
-
-#ifndef World
-#error "Please define the 'World' type"
-#endif
-
-struct Signal;
 
-struct SignalCallback
+extern "C"
 {
-    // How long the signal's entry condition must be continuously high for, in
-    // milliseconds, before the callback function is triggered
-    uint32_t entry_condition_high_duration_ms;
-
-    // How long the signal's exit condition signal must be continuously high
-    // for, in milliseconds, before the callback function is no longer triggered
-    uint32_t exit_condition_high_duration_ms;
+#include "App_SharedSignalEngine.h"
+}
 
-    // The callback function
-    void (*function)(struct World *);
-};
+struct Signal;
 
 /**
  * Allocate and initialize a signal
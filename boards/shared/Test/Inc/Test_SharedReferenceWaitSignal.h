@@ -1,23 +1,17 @@
 #pragma once
 
+// A standalone wait signal. It is only used as a reference for how the wait
+// signals in App_SharedSignalEngine should behave.
+
 #include <stdint.h>
 #include <stdbool.h>
-#include "configs/App_SharedSignalConfig.h"
-
-#ifndef World
-#error "Please define the 'World' type"
-#endif
 
-struct WaitSignal;
-
-struct WaitSignalCallback
+extern "C"
 {
-    // Wait duration before the callback function is called
-    uint32_t wait_duration_ms;
+#include "App_SharedSignalEngine.h"
+}
 
-    // The callback function to call when the wait has completed
-    void (*function)(struct World *);
-};
+struct WaitSignal;
 
 /**
  * Allocate and initialize a wait signal
@@ -0,0 +1,5 @@
+#pragma once
+
+struct TestWorld;
+
+#define World TestWorld
@@ -0,0 +1,167 @@
+#include "Test_Shared.h"
+
+extern "C"
+{
+#include "Io_SharedAdcConversions.h"
+}
+
+namespace AdcConversionsTest
+{
+static constexpr float  VOLTAGE_PER_LSB     = 3.3f / 4095.0f;
+static constexpr size_t NUM_CONVERSION_SETS = 4U;
+
+enum
+{
+    CHANNEL_A,
+    CHANNEL_B,
+    CHANNEL_C,
+    NUM_CHANNELS
+};
+
+class AdcConversionsTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        // { oversampling_ratio, gain, offset } of every channel
+        const struct AdcChannelConfig channel_configs[NUM_CHANNELS] = {
+            { 1U, 1.0f, 0.0f },                  // CHANNEL_A
+            { NUM_CONVERSION_SETS, 1.0f, 0.0f }, // CHANNEL_B
+            { 2U, 500.0f, -10.0f },              // CHANNEL_C
+        };
+
+        adc_conversions = Io_SharedAdcConversions_Create(
+            NUM_CHANNELS, NUM_CONVERSION_SETS, VOLTAGE_PER_LSB,
+            channel_configs);
+    }
+
+    void TearDown() override
+    {
+        TearDownObject(adc_conversions, Io_SharedAdcConversions_Destroy);
+    }
+
+    float GetValue(size_t channel)
+    {
+        return Io_SharedAdcConversions_GetValue(adc_conversions, channel);
+    }
+
+    struct AdcConversions *adc_conversions;
+};
+
+TEST_F(AdcConversionsTest, values_are_zero_before_first_conversion)
+{
+    float values[NUM_CHANNELS] = { 1.0f, 1.0f, 1.0f };
+    Io_SharedAdcConversions_GetValues(adc_conversions, values);
+
+    for (size_t i = 0U; i < NUM_CHANNELS; i++)
+    {
+        ASSERT_EQ(0.0f, GetValue(i));
+        ASSERT_EQ(0.0f, values[i]);
+    }
+}
+
+TEST_F(AdcConversionsTest, converts_full_scale_to_reference_voltage)
+{
+    const volatile uint16_t raw_adc_values[NUM_CONVERSION_SETS]
+                                          [NUM_CHANNELS] = {
+                                              { 4095U, 4095U, 0U },
+                                              { 4095U, 4095U, 0U },
+                                              { 4095U, 4095U, 0U },
+                                              { 4095U, 4095U, 0U },
+                                          };
+    Io_SharedAdcConversions_Convert(adc_conversions, &raw_adc_values[0][0]);
+
+    ASSERT_NEAR(3.3f, GetValue(CHANNEL_A), 1e-5f);
+    ASSERT_NEAR(3.3f, GetValue(CHANNEL_B), 1e-5f);
+    ASSERT_NEAR(-10.0f, GetValue(CHANNEL_C), 1e-5f);
+}
+
+TEST_F(AdcConversionsTest, oversampling_averages_latest_conversion_sets)
+{
+    // The conversion sets are interleaved, so each channel is read with a
+    // stride of the number of channels
+    const volatile uint16_t raw_adc_values[NUM_CONVERSION_SETS]
+                                          [NUM_CHANNELS] = {
+                                              { 100U, 100U, 100U },
+                                              { 200U, 200U, 200U },
+                                              { 300U, 300U, 300U },
+                                              { 400U, 400U, 400U },
+                                          };
+    Io_SharedAdcConversions_Convert(adc_conversions, &raw_adc_values[0][0]);
+
+    // Without oversampling, only the latest conversion set is used
+    ASSERT_NEAR(400.0f * VOLTAGE_PER_LSB, GetValue(CHANNEL_A), 1e-5f);
+
+    // Averaged over every conversion set
+    ASSERT_NEAR(250.0f * VOLTAGE_PER_LSB, GetValue(CHANNEL_B), 1e-5f);
+
+    // Averaged over the latest two conversion sets, then scaled
+    ASSERT_NEAR(
+        500.0f * 350.0f * VOLTAGE_PER_LSB - 10.0f, GetValue(CHANNEL_C), 1e-3f);
+}
+
+TEST_F(AdcConversionsTest, latest_conversion_replaces_values)
+{
+    const volatile uint16_t first_raw_adc_values[NUM_CONVERSION_SETS]
+                                                [NUM_CHANNELS] = {
+                                                    { 1000U, 1000U, 1000U },
+                                                    { 1000U, 1000U, 1000U },
+                                                    { 1000U, 1000U, 1000U },
+                                                    { 1000U, 1000U, 1000U },
+                                                };
+    const volatile uint16_t second_raw_adc_values[NUM_CONVERSION_SETS]
+                                                 [NUM_CHANNELS] = {
+                                                     { 2000U, 2000U, 2000U },
+                                                     { 2000U, 2000U, 2000U },
+                                                     { 2000U, 2000U, 2000U },
+                                                     { 2000U, 2000U, 2000U },
+                                                 };
+    Io_SharedAdcConversions_Convert(
+        adc_conversions, &first_raw_adc_values[0][0]);
+    Io_SharedAdcConversions_Convert(
+        adc_conversions, &second_raw_adc_values[0][0]);
+
+    float values[NUM_CHANNELS];
+    Io_SharedAdcConversions_GetValues(adc_conversions, values);
+
+    for (size_t i = 0U; i < NUM_CHANNELS; i++)
+    {
+        ASSERT_EQ(GetValue(i), values[i]);
+    }
+    ASSERT_NEAR(2000.0f * VOLTAGE_PER_LSB, values[CHANNEL_A], 1e-5f);
+    ASSERT_NEAR(2000.0f * VOLTAGE_PER_LSB, values[CHANNEL_B], 1e-5f);
+    ASSERT_NEAR(
+        500.0f * 2000.0f * VOLTAGE_PER_LSB - 10.0f, values[CHANNEL_C], 1e-3f);
+}
+
+TEST_F(AdcConversionsTest, each_conversion_set_is_converted_without_averaging)
+{
+    const volatile uint16_t raw_adc_values[NUM_CONVERSION_SETS]
+                                          [NUM_CHANNELS] = {
+                                              { 100U, 100U, 100U },
+                                              { 200U, 200U, 200U },
+                                              { 300U, 300U, 300U },
+                                              { 400U, 400U, 400U },
+                                          };
+    float values[NUM_CONVERSION_SETS][NUM_CHANNELS];
+    Io_SharedAdcConversions_ConvertEachSet(
+        adc_conversions, &raw_adc_values[0][0], &values[0][0]);
+
+    for (size_t set = 0U; set < NUM_CONVERSION_SETS; set++)
+    {
+        const float raw_adc_value = 100.0f * (float)(set + 1U);
+
+        ASSERT_NEAR(
+            raw_adc_value * VOLTAGE_PER_LSB, values[set][CHANNEL_A], 1e-5f);
+        ASSERT_NEAR(
+            raw_adc_value * VOLTAGE_PER_LSB, values[set][CHANNEL_B], 1e-5f);
+        ASSERT_NEAR(
+            500.0f * raw_adc_value * VOLTAGE_PER_LSB - 10.0f,
+            values[set][CHANNEL_C], 1e-3f);
+    }
+
+    // The averaged values aren't published
+    ASSERT_EQ(0.0f, GetValue(CHANNEL_B));
+}
+
+} // namespace AdcConversionsTest
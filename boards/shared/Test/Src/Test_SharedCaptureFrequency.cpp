@@ -0,0 +1,175 @@
+#include <cmath>
+#include "Test_Shared.h"
+
+extern "C"
+{
+#include "Io_SharedCaptureFrequency.h"
+}
+
+namespace CaptureFrequencyTest
+{
+static constexpr float    TIM_FREQUENCY_HZ    = 65573.0f;
+static constexpr uint32_t TIM_AUTO_RELOAD_REG = 0xFFFF;
+static constexpr float    AVERAGING_WINDOW_S  = 0.05f;
+static constexpr float    MIN_FREQUENCY_HZ    = 2.0f;
+static constexpr size_t   NUM_TIMESTAMPS      = 64U;
+static constexpr double   UPDATE_PERIOD_S     = 0.01;
+
+// A 16-bit timer capturing the rising edges of a PWM input into a circular
+// buffer by DMA
+class CapturingTimer
+{
+  public:
+    // Set the periods of the PWM input, which alternate between the given
+    // periods to emulate jitter. A period of 0 stops the PWM input.
+    void SetPeriods(double period_s, double other_period_s)
+    {
+        periods_s[0] = period_s;
+        periods_s[1] = other_period_s;
+        if (period_s > 0.0 && next_edge_s <= time_s)
+        {
+            next_edge_s = time_s + period_s;
+        }
+    }
+
+    void SetPeriod(double period_s) { SetPeriods(period_s, period_s); }
+
+    // Let the given time pass, capturing every rising edge in between
+    void Run(double duration_s)
+    {
+        const double end_time_s = time_s + duration_s;
+        while (periods_s[0] > 0.0 && next_edge_s <= end_time_s)
+        {
+            timestamps[write_index] = (uint16_t)GetCounter(next_edge_s);
+            write_index             = (write_index + 1U) % NUM_TIMESTAMPS;
+            next_edge_s += periods_s[num_edges++ % 2U];
+        }
+        time_s = end_time_s;
+    }
+
+    uint32_t GetCounter(void) const { return GetCounter(time_s); }
+
+    volatile uint16_t timestamps[NUM_TIMESTAMPS] = {};
+    size_t            write_index                = 0U;
+
+  private:
+    static uint32_t GetCounter(double t)
+    {
+        return (uint32_t)(t * TIM_FREQUENCY_HZ) % (TIM_AUTO_RELOAD_REG + 1U);
+    }
+
+    double time_s       = 0.0;
+    double next_edge_s  = 0.0;
+    double periods_s[2] = { 0.0, 0.0 };
+    size_t num_edges    = 0U;
+};
+
+class CaptureFrequencyTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        capture_frequency = Io_SharedCaptureFrequency_Create(
+            TIM_FREQUENCY_HZ, TIM_AUTO_RELOAD_REG, AVERAGING_WINDOW_S,
+            MIN_FREQUENCY_HZ);
+    }
+
+    void TearDown() override
+    {
+        TearDownObject(capture_frequency, Io_SharedCaptureFrequency_Destroy);
+    }
+
+    // Run the timer for the given time, updating the frequency periodically
+    void Run(double duration_s)
+    {
+        for (double t = 0.0; t < duration_s - 1e-9; t += UPDATE_PERIOD_S)
+        {
+            timer.Run(UPDATE_PERIOD_S);
+            Io_SharedCaptureFrequency_Update(
+                capture_frequency, timer.timestamps, NUM_TIMESTAMPS,
+                timer.write_index, timer.GetCounter());
+        }
+    }
+
+    float GetFrequency(void)
+    {
+        return Io_SharedCaptureFrequency_GetFrequency(capture_frequency);
+    }
+
+    CapturingTimer           timer;
+    struct CaptureFrequency *capture_frequency;
+};
+
+TEST_F(CaptureFrequencyTest, frequency_is_zero_without_rising_edges)
+{
+    Run(2.0);
+    ASSERT_EQ(0.0f, GetFrequency());
+}
+
+TEST_F(CaptureFrequencyTest, measures_high_frequency_across_counter_overflows)
+{
+    // The rising edges are captured for longer than the counter's period
+    timer.SetPeriod(1.0 / 450.0);
+    Run(3.0);
+    ASSERT_NEAR(450.0f, GetFrequency(), 0.001f * 450.0f);
+}
+
+TEST_F(CaptureFrequencyTest, measures_low_frequency_from_a_single_period)
+{
+    // Fewer than one rising edge is captured per update
+    timer.SetPeriod(1.0 / 4.0);
+    Run(2.0);
+    ASSERT_NEAR(4.0f, GetFrequency(), 0.001f * 4.0f);
+}
+
+TEST_F(CaptureFrequencyTest, averages_periods_within_the_window)
+{
+    // The periods jitter between 3ms and 4ms, which averages to 3.5ms
+    timer.SetPeriods(0.003, 0.004);
+    for (int i = 0; i < 100; i++)
+    {
+        Run(UPDATE_PERIOD_S);
+        ASSERT_NEAR(1.0f / 0.0035f, GetFrequency(), 0.03f / 0.0035f);
+    }
+}
+
+TEST_F(CaptureFrequencyTest, follows_input_as_it_slows_down)
+{
+    timer.SetPeriod(1.0 / 10.0);
+    Run(1.0);
+    ASSERT_NEAR(10.0f, GetFrequency(), 0.01f);
+
+    // Once the time since the last rising edge exceeds the last period, the
+    // frequency can be no higher than one over that time
+    timer.SetPeriod(0.0);
+    Run(0.2);
+    ASSERT_LE(GetFrequency(), 1.0f / 0.19f);
+    ASSERT_GT(GetFrequency(), 0.0f);
+}
+
+TEST_F(CaptureFrequencyTest, detects_input_becoming_inactive)
+{
+    timer.SetPeriod(1.0 / 100.0);
+    Run(1.0);
+    ASSERT_NEAR(100.0f, GetFrequency(), 0.1f);
+
+    // The input stops. The frequency is only 0Hz once no rising edge has been
+    // captured for the period of the lowest measurable frequency.
+    timer.SetPeriod(0.0);
+    Run(1.0 / MIN_FREQUENCY_HZ - 2.0 * UPDATE_PERIOD_S);
+    ASSERT_GT(GetFrequency(), 0.0f);
+    Run(2.0 * UPDATE_PERIOD_S);
+    ASSERT_EQ(0.0f, GetFrequency());
+
+    // The input stays inactive for longer than the counter's period, so the
+    // first rising edge it comes back with only marks the start of a period
+    Run(3.0);
+    ASSERT_EQ(0.0f, GetFrequency());
+    timer.SetPeriod(1.0 / 20.0);
+    Run(0.06);
+    ASSERT_EQ(0.0f, GetFrequency());
+    Run(0.1);
+    ASSERT_NEAR(20.0f, GetFrequency(), 0.02f);
+}
+
+} // namespace CaptureFrequencyTest
@@ -0,0 +1,349 @@
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "Test_Shared.h"
+
+extern "C"
+{
+#include "Io_SharedFilters.h"
+#include "Io_SharedFiltersBenchmark.h"
+}
+
+namespace FiltersTest
+{
+static constexpr float SAMPLING_TIME_S = 0.001f;
+
+// Second-order Butterworth low pass filter with a cutoff at a tenth of the
+// sampling frequency, as { b0, b1, b2, a1, a2 } with a1 and a2 negated
+static constexpr double BUTTERWORTH[5] = { 0.067455, 0.134911, 0.067455,
+                                           1.142981, -0.412802 };
+
+static int16_t ToQ15(double value)
+{
+    return (int16_t)std::lround(value * 32768.0);
+}
+
+// A noisy sine wave, so every filter is tested against a signal with content
+// across the spectrum
+static std::vector<float> GetTestSignal(size_t num_samples)
+{
+    std::vector<float> signal(num_samples);
+    uint32_t           noise = 1U;
+    for (size_t i = 0U; i < num_samples; i++)
+    {
+        noise     = noise * 1664525U + 1013904223U;
+        signal[i] = 0.5f * std::sin(0.05f * (float)i) +
+                    0.1f * ((float)(noise >> 16) / 65536.0f - 0.5f);
+    }
+    return signal;
+}
+
+static std::vector<int16_t> ToQ15(const std::vector<float> &signal)
+{
+    std::vector<int16_t> signal_q15(signal.size());
+    for (size_t i = 0U; i < signal.size(); i++)
+    {
+        signal_q15[i] = ToQ15(signal[i]);
+    }
+    return signal_q15;
+}
+
+TEST(FiltersTest, ema_filter_matches_reference_step_response)
+{
+    const float       rc    = 0.009f;
+    const double      alpha = 0.001 / (0.009 + 0.001);
+    struct EmaFilter *filter =
+        Io_SharedFilters_CreateEmaFilter(SAMPLING_TIME_S, rc);
+
+    // The output starts at the first input sample, instead of rising from 0
+    float output;
+    float input = 0.2f;
+    Io_SharedFilters_ApplyEmaFilter(filter, &input, &output, 1U);
+    ASSERT_EQ(0.2f, output);
+
+    // y[n] = 1 - 0.8 * (1 - alpha)^(n + 1)
+    std::vector<float> step(100U, 1.0f);
+    Io_SharedFilters_ApplyEmaFilter(
+        filter, step.data(), step.data(), step.size());
+    for (size_t i = 0U; i < step.size(); i++)
+    {
+        ASSERT_NEAR(1.0 - 0.8 * std::pow(1.0 - alpha, i + 1), step[i], 1e-5);
+    }
+
+    Io_SharedFilters_ResetEmaFilter(filter);
+    Io_SharedFilters_ApplyEmaFilter(filter, &input, &output, 1U);
+    ASSERT_EQ(0.2f, output);
+
+    Io_SharedFilters_DestroyEmaFilter(filter);
+}
+
+TEST(FiltersTest, ema_filter_q15_matches_float)
+{
+    const std::vector<float> signal     = GetTestSignal(500U);
+    std::vector<int16_t>     signal_q15 = ToQ15(signal);
+    std::vector<float>       output(signal.size());
+    struct EmaFilter *       filter =
+        Io_SharedFilters_CreateEmaFilter(SAMPLING_TIME_S, 0.02f);
+    struct EmaFilterQ15 *filter_q15 =
+        Io_SharedFilters_CreateEmaFilterQ15(SAMPLING_TIME_S, 0.02f);
+
+    Io_SharedFilters_ApplyEmaFilter(
+        filter, signal.data(), output.data(), signal.size());
+    Io_SharedFilters_ApplyEmaFilterQ15(
+        filter_q15, signal_q15.data(), signal_q15.data(), signal_q15.size());
+    for (size_t i = 0U; i < signal.size(); i++)
+    {
+        ASSERT_NEAR(output[i], (float)signal_q15[i] / 32768.0f, 2e-3f);
+    }
+
+    // A small input doesn't get lost to the Q15 filter's precision
+    Io_SharedFilters_ResetEmaFilterQ15(filter_q15);
+    std::vector<int16_t> step(2000U, 1000);
+    step[0] = 0;
+    Io_SharedFilters_ApplyEmaFilterQ15(
+        filter_q15, step.data(), step.data(), step.size());
+    ASSERT_EQ(1000, step.back());
+
+    Io_SharedFilters_DestroyEmaFilter(filter);
+    Io_SharedFilters_DestroyEmaFilterQ15(filter_q15);
+}
+
+TEST(FiltersTest, biquad_cascade_matches_reference_response_across_blocks)
+{
+    float coefficients[10];
+    for (size_t i = 0U; i < 10U; i++)
+    {
+        coefficients[i] = (float)BUTTERWORTH[i % 5U];
+    }
+    struct BiquadCascade *filter =
+        Io_SharedFilters_CreateBiquadCascade(2U, coefficients);
+
+    // Filter the signal twice with the reference difference equation
+    const std::vector<float> signal = GetTestSignal(300U);
+    std::vector<double>      reference(signal.begin(), signal.end());
+    for (size_t stage = 0U; stage < 2U; stage++)
+    {
+        double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0;
+        for (double &sample : reference)
+        {
+            const double y = BUTTERWORTH[0] * sample + BUTTERWORTH[1] * x1 +
+                             BUTTERWORTH[2] * x2 + BUTTERWORTH[3] * y1 +
+                             BUTTERWORTH[4] * y2;
+            x2     = x1;
+            x1     = sample;
+            y2     = y1;
+            y1     = y;
+            sample = y;
+        }
+    }
+
+    // The state carries over between blocks of different sizes
+    std::vector<float> output(signal);
+    size_t             offset = 0U;
+    for (size_t block_size : { 1U, 7U, 64U, 100U, 128U })
+    {
+        Io_SharedFilters_ApplyBiquadCascade(
+            filter, &output[offset], &output[offset], block_size);
+        offset += block_size;
+    }
+    ASSERT_EQ(signal.size(), offset);
+
+    for (size_t i = 0U; i < signal.size(); i++)
+    {
+        ASSERT_NEAR(reference[i], output[i], 1e-5);
+    }
+
+    Io_SharedFilters_DestroyBiquadCascade(filter);
+}
+
+TEST(FiltersTest, biquad_cascade_q15_matches_float)
+{
+    float   coefficients[5];
+    int16_t coefficients_q15[5];
+    for (size_t i = 0U; i < 5U; i++)
+    {
+        coefficients[i] = (float)BUTTERWORTH[i];
+
+        // a1 is greater than 1, so the coefficients are scaled down by 2^1
+        coefficients_q15[i] = ToQ15(BUTTERWORTH[i] / 2.0);
+    }
+    struct BiquadCascade *filter =
+        Io_SharedFilters_CreateBiquadCascade(1U, coefficients);
+    struct BiquadCascadeQ15 *filter_q15 =
+        Io_SharedFilters_CreateBiquadCascadeQ15(1U, coefficients_q15, 1U);
+
+    const std::vector<float> signal     = GetTestSignal(500U);
+    std::vector<int16_t>     signal_q15 = ToQ15(signal);
+    std::vector<float>       output(signal.size());
+    Io_SharedFilters_ApplyBiquadCascade(
+        filter, signal.data(), output.data(), signal.size());
+    Io_SharedFilters_ApplyBiquadCascadeQ15(
+        filter_q15, signal_q15.data(), signal_q15.data(), signal_q15.size());
+
+    for (size_t i = 0U; i < signal.size(); i++)
+    {
+        ASSERT_NEAR(output[i], (float)signal_q15[i] / 32768.0f, 2e-3f);
+    }
+
+    // The DC gain is 1
+    std::vector<int16_t> dc(200U, 16384);
+    Io_SharedFilters_ApplyBiquadCascadeQ15(
+        filter_q15, dc.data(), dc.data(), dc.size());
+    ASSERT_NEAR(16384, dc.back(), 16);
+
+    Io_SharedFilters_DestroyBiquadCascade(filter);
+    Io_SharedFilters_DestroyBiquadCascadeQ15(filter_q15);
+}
+
+TEST(FiltersTest, fir_decimator_matches_reference_response_across_blocks)
+{
+    const float          coefficients[4] = { 0.4f, 0.3f, 0.2f, 0.1f };
+    struct FirDecimator *filter =
+        Io_SharedFilters_CreateFirDecimator(4U, coefficients, 3U);
+
+    const std::vector<float> signal = GetTestSignal(100U);
+    std::vector<float>       output(signal.size());
+
+    // The decimation carries over between blocks that aren't multiples of the
+    // decimation factor
+    size_t num_outputs = 0U;
+    size_t offset      = 0U;
+    for (size_t block_size : { 2U, 5U, 1U, 64U, 28U })
+    {
+        num_outputs += Io_SharedFilters_ApplyFirDecimator(
+            filter, &signal[offset], &output[num_outputs], block_size);
+        offset += block_size;
+    }
+    ASSERT_EQ(signal.size(), offset);
+    ASSERT_EQ(33U, num_outputs);
+
+    // The first output is computed from the first 3 input samples, with the
+    // samples before them taken as 0
+    for (size_t i = 0U; i < num_outputs; i++)
+    {
+        const size_t newest    = 3U * i + 2U;
+        double       reference = 0.0;
+        for (size_t tap = 0U; tap < 4U && tap <= newest; tap++)
+        {
+            reference += coefficients[tap] * signal[newest - tap];
+        }
+        ASSERT_NEAR(reference, output[i], 1e-6);
+    }
+
+    Io_SharedFilters_DestroyFirDecimator(filter);
+}
+
+TEST(FiltersTest, fir_decimator_q15_filters_in_place)
+{
+    const int16_t           coefficients_q15[4] = { 8192, 8192, 8192, 8192 };
+    struct FirDecimatorQ15 *filter_q15 =
+        Io_SharedFilters_CreateFirDecimatorQ15(4U, coefficients_q15, 4U);
+
+    // Averages every 4 raw ADC values into one
+    std::vector<int16_t> samples     = { 100,  200,  300,  400,  1000, 1000,
+                                     1000, 1001, 4095, 4095, 4095, 4095 };
+    const size_t         num_outputs = Io_SharedFilters_ApplyFirDecimatorQ15(
+        filter_q15, samples.data(), samples.data(), samples.size());
+    ASSERT_EQ(3U, num_outputs);
+    ASSERT_EQ(250, samples[0]);
+    ASSERT_EQ(1000, samples[1]);
+    ASSERT_EQ(4095, samples[2]);
+
+    Io_SharedFilters_DestroyFirDecimatorQ15(filter_q15);
+}
+
+TEST(FiltersTest, moving_median_rejects_spikes)
+{
+    struct MovingMedian *   filter = Io_SharedFilters_CreateMovingMedian(5U);
+    struct MovingMedianQ15 *filter_q15 =
+        Io_SharedFilters_CreateMovingMedianQ15(5U);
+
+    // Spikes of up to 2 samples are rejected, while the ramp after them goes
+    // through 2 samples late
+    const std::vector<float> input = { 1.0f, 2.0f, 90.0f, 3.0f, -80.0f, -70.0f,
+                                       4.0f, 5.0f, 6.0f,  7.0f, 7.0f,   7.0f };
+    const std::vector<float> expected = { 1.0f, 2.0f, 2.0f, 3.0f, 2.0f, 2.0f,
+                                          3.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f };
+    std::vector<float>       output(input.size());
+    std::vector<int16_t>     output_q15(input.size());
+    for (size_t i = 0U; i < input.size(); i++)
+    {
+        output_q15[i] = (int16_t)(100.0f * input[i]);
+    }
+
+    Io_SharedFilters_ApplyMovingMedian(
+        filter, input.data(), output.data(), input.size());
+    Io_SharedFilters_ApplyMovingMedianQ15(
+        filter_q15, output_q15.data(), output_q15.data(), output_q15.size());
+    for (size_t i = 0U; i < input.size(); i++)
+    {
+        ASSERT_EQ(expected[i], output[i]);
+        ASSERT_EQ((int16_t)(100.0f * expected[i]), output_q15[i]);
+    }
+
+    Io_SharedFilters_DestroyMovingMedian(filter);
+    Io_SharedFilters_DestroyMovingMedianQ15(filter_q15);
+}
+
+TEST(FiltersTest, rate_limiter_limits_rise_and_fall)
+{
+    // Rises by at most 0.1 per sample, and falls by at most 0.3 per sample
+    struct RateLimiter *filter =
+        Io_SharedFilters_CreateRateLimiter(SAMPLING_TIME_S, 100.0f, 300.0f);
+    struct RateLimiterQ15 *filter_q15 =
+        Io_SharedFilters_CreateRateLimiterQ15(100U, 300U);
+
+    const std::vector<float> input    = { 0.0f,  1.0f,  1.0f,  1.0f,
+                                       0.35f, -1.0f, -1.0f, 0.0f };
+    const std::vector<float> expected = { 0.0f,  0.1f,  0.2f,   0.3f,
+                                          0.35f, 0.05f, -0.25f, -0.15f };
+    std::vector<float>       output(input.size());
+    std::vector<int16_t>     output_q15(input.size());
+    for (size_t i = 0U; i < input.size(); i++)
+    {
+        output_q15[i] = (int16_t)std::lround(1000.0f * input[i]);
+    }
+
+    Io_SharedFilters_ApplyRateLimiter(
+        filter, input.data(), output.data(), input.size());
+    Io_SharedFilters_ApplyRateLimiterQ15(
+        filter_q15, output_q15.data(), output_q15.data(), output_q15.size());
+    for (size_t i = 0U; i < input.size(); i++)
+    {
+        ASSERT_NEAR(expected[i], output[i], 1e-6f);
+        ASSERT_EQ((int16_t)std::lround(1000.0f * expected[i]), output_q15[i]);
+    }
+
+    Io_SharedFilters_DestroyRateLimiter(filter);
+    Io_SharedFilters_DestroyRateLimiterQ15(filter_q15);
+}
+
+TEST(FiltersTest, benchmark_measures_cost_per_sample)
+{
+    struct FiltersBenchmarkResults results;
+    Io_SharedFiltersBenchmark_Run(1000U, &results);
+
+    // On x86 the cost is in nanoseconds per sample, which is only printed for
+    // comparison. Run the benchmark on the target for cycles per sample.
+    const std::pair<const char *, float> costs[] = {
+        { "ema_filter", results.ema_filter },
+        { "ema_filter_q15", results.ema_filter_q15 },
+        { "biquad_cascade", results.biquad_cascade },
+        { "biquad_cascade_q15", results.biquad_cascade_q15 },
+        { "fir_decimator", results.fir_decimator },
+        { "fir_decimator_q15", results.fir_decimator_q15 },
+        { "moving_median", results.moving_median },
+        { "moving_median_q15", results.moving_median_q15 },
+        { "rate_limiter", results.rate_limiter },
+        { "rate_limiter_q15", results.rate_limiter_q15 },
+    };
+    for (const auto &cost : costs)
+    {
+        ASSERT_GE(cost.second, 0.0f);
+        RecordProperty(cost.first, std::to_string(cost.second));
+        printf("%-20s %8.2f ns/sample\n", cost.first, (double)cost.second);
+    }
+}
+
+} // namespace FiltersTest
@@ -1,6 +1,6 @@
 #include <assert.h>
 #include <stdlib.h>
-#include "App_SharedSignal.h"
+#include "Test_SharedReferenceSignal.h"
 
 struct Signal
 {
@@ -43,7 +43,7 @@ struct Signal *App_SharedSignal_Create(
     struct World *        world,
     struct SignalCallback callback)
 {
-    struct Signal *signal = malloc(sizeof(struct Signal));
+    struct Signal *signal = (struct Signal *)malloc(sizeof(struct Signal));
     assert(signal != NULL);
 
     signal->is_callback_triggered   = false;
@@ -1,6 +1,6 @@
 #include <assert.h>
 #include <stdlib.h>
-#include "App_SharedWaitSignal.h"
+#include "Test_SharedReferenceWaitSignal.h"
 
 struct WaitSignal
 {
@@ -26,7 +26,8 @@ struct WaitSignal *App_SharedWaitSignal_Create(
     struct World *const       world,
     struct WaitSignalCallback callback)
 {
-    struct WaitSignal *wait_signal = malloc(sizeof(struct WaitSignal));
+    struct WaitSignal *wait_signal =
+        (struct WaitSignal *)malloc(sizeof(struct WaitSignal));
     assert(wait_signal != NULL);
 
     wait_signal->is_waiting        = false;
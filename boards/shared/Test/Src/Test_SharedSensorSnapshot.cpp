@@ -0,0 +1,121 @@
+#include <cstddef>
+#include "Test_Shared.h"
+
+extern "C"
+{
+#include "App_SharedSensorSnapshot.h"
+}
+
+FAKE_VALUE_FUNC(float, sample_float, struct World *);
+FAKE_VALUE_FUNC(bool, sample_bool, struct World *);
+FAKE_VALUE_FUNC(uint32_t, sample_uint32, struct World *);
+
+struct TestSnapshot
+{
+    float    float_value;
+    bool     bool_value;
+    uint32_t uint32_value;
+};
+
+class SharedSensorSnapshotTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        sensor_snapshot = App_SharedSensorSnapshot_Create(
+            world, sizeof(struct TestSnapshot), 3);
+        App_SharedSensorSnapshot_AddFloatInput(
+            sensor_snapshot, offsetof(struct TestSnapshot, float_value),
+            sample_float);
+        App_SharedSensorSnapshot_AddBoolInput(
+            sensor_snapshot, offsetof(struct TestSnapshot, bool_value),
+            sample_bool);
+        App_SharedSensorSnapshot_AddUint32Input(
+            sensor_snapshot, offsetof(struct TestSnapshot, uint32_value),
+            sample_uint32);
+
+        RESET_FAKE(sample_float);
+        RESET_FAKE(sample_bool);
+        RESET_FAKE(sample_uint32);
+    }
+
+    void TearDown() override
+    {
+        TearDownObject(sensor_snapshot, App_SharedSensorSnapshot_Destroy);
+    }
+
+    const struct TestSnapshot *GetSnapshot()
+    {
+        return (const struct TestSnapshot *)App_SharedSensorSnapshot_Get(
+            sensor_snapshot);
+    }
+
+    struct TestWorld *     world = nullptr;
+    struct SensorSnapshot *sensor_snapshot;
+};
+
+TEST_F(SharedSensorSnapshotTest, snapshot_is_zero_before_first_sample)
+{
+    ASSERT_EQ(0, App_SharedSensorSnapshot_GetNumSamples(sensor_snapshot));
+    ASSERT_EQ(0.0f, GetSnapshot()->float_value);
+    ASSERT_FALSE(GetSnapshot()->bool_value);
+    ASSERT_EQ(0, GetSnapshot()->uint32_value);
+}
+
+TEST_F(SharedSensorSnapshotTest, every_input_is_sampled_once_per_sample)
+{
+    sample_float_fake.return_val  = 1.5f;
+    sample_bool_fake.return_val   = true;
+    sample_uint32_fake.return_val = 42;
+
+    App_SharedSensorSnapshot_Sample(sensor_snapshot);
+
+    ASSERT_EQ(1, sample_float_fake.call_count);
+    ASSERT_EQ(1, sample_bool_fake.call_count);
+    ASSERT_EQ(1, sample_uint32_fake.call_count);
+    ASSERT_EQ(1, App_SharedSensorSnapshot_GetNumSamples(sensor_snapshot));
+
+    // Reading the snapshot doesn't sample the inputs again
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_EQ(1.5f, GetSnapshot()->float_value);
+        ASSERT_TRUE(GetSnapshot()->bool_value);
+        ASSERT_EQ(42, GetSnapshot()->uint32_value);
+    }
+    ASSERT_EQ(1, sample_float_fake.call_count);
+    ASSERT_EQ(1, sample_bool_fake.call_count);
+    ASSERT_EQ(1, sample_uint32_fake.call_count);
+}
+
+TEST_F(
+    SharedSensorSnapshotTest,
+    published_snapshot_is_not_modified_by_the_next_sample)
+{
+    sample_float_fake.return_val = 1.0f;
+    App_SharedSensorSnapshot_Sample(sensor_snapshot);
+    const struct TestSnapshot *first_snapshot = GetSnapshot();
+
+    sample_float_fake.return_val = 2.0f;
+    App_SharedSensorSnapshot_Sample(sensor_snapshot);
+    const struct TestSnapshot *second_snapshot = GetSnapshot();
+
+    ASSERT_NE(first_snapshot, second_snapshot);
+    ASSERT_EQ(1.0f, first_snapshot->float_value);
+    ASSERT_EQ(2.0f, second_snapshot->float_value);
+}
+
+TEST_F(SharedSensorSnapshotTest, copy_returns_last_published_snapshot)
+{
+    for (uint32_t i = 1; i <= 5; i++)
+    {
+        sample_uint32_fake.return_val = i;
+        sample_bool_fake.return_val   = i % 2 == 0;
+        App_SharedSensorSnapshot_Sample(sensor_snapshot);
+
+        struct TestSnapshot copy;
+        App_SharedSensorSnapshot_Copy(sensor_snapshot, &copy);
+
+        ASSERT_EQ(i, copy.uint32_value);
+        ASSERT_EQ(i % 2 == 0, copy.bool_value);
+    }
+}
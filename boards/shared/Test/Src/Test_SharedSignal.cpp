@@ -1,9 +1,5 @@
 #include "Test_Shared.h"
-
-extern "C"
-{
-#include "App_SharedSignal.h"
-}
+#include "Test_SharedReferenceSignal.h"
 
 FAKE_VALUE_FUNC(bool, is_entry_high, struct World *);
 FAKE_VALUE_FUNC(bool, is_exit_high, struct World *);
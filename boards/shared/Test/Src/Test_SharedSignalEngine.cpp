@@ -0,0 +1,252 @@
+#include <array>
+#include <random>
+#include <utility>
+#include "Test_Shared.h"
+#include "Test_SharedReferenceSignal.h"
+#include "Test_SharedReferenceWaitSignal.h"
+
+extern "C"
+{
+#include "App_SharedSignalEngine.h"
+#include "Io_SharedSignalEngineBenchmark.h"
+}
+
+// Enough signals to be well beyond what any board registers today
+static constexpr size_t NUM_SIGNALS = 128;
+
+static std::array<bool, NUM_SIGNALS>     entry_conditions;
+static std::array<bool, NUM_SIGNALS>     exit_conditions;
+static std::array<uint32_t, NUM_SIGNALS> engine_callback_counts;
+static std::array<uint32_t, NUM_SIGNALS> reference_callback_counts;
+
+// Every signal needs its own condition and callback functions, since they are
+// only given the world
+template <size_t I> bool is_entry_high(struct World *)
+{
+    return entry_conditions[I];
+}
+
+template <size_t I> bool is_exit_high(struct World *)
+{
+    return exit_conditions[I];
+}
+
+template <size_t I> void engine_callback(struct World *)
+{
+    engine_callback_counts[I]++;
+}
+
+template <size_t I> void reference_callback(struct World *)
+{
+    reference_callback_counts[I]++;
+}
+
+struct SignalFunctions
+{
+    bool (*is_entry_high)(struct World *);
+    bool (*is_exit_high)(struct World *);
+    void (*engine_callback)(struct World *);
+    void (*reference_callback)(struct World *);
+};
+
+template <size_t... I>
+static constexpr std::array<SignalFunctions, NUM_SIGNALS>
+    MakeSignalFunctions(std::index_sequence<I...>)
+{
+    return { { { is_entry_high<I>, is_exit_high<I>, engine_callback<I>,
+                 reference_callback<I> }... } };
+}
+
+static constexpr std::array<SignalFunctions, NUM_SIGNALS> signal_functions =
+    MakeSignalFunctions(std::make_index_sequence<NUM_SIGNALS>());
+
+class SharedSignalEngineTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        entry_conditions.fill(false);
+        exit_conditions.fill(false);
+        engine_callback_counts.fill(0);
+        reference_callback_counts.fill(0);
+
+        signal_engine =
+            App_SharedSignalEngine_Create(start_ms, world, NUM_SIGNALS);
+    }
+
+    void TearDown() override
+    {
+        TearDownObject(signal_engine, App_SharedSignalEngine_Destroy);
+
+        for (struct Signal *&signal : signals)
+        {
+            TearDownObject(signal, App_SharedSignal_Destroy);
+        }
+        signals.clear();
+
+        for (struct WaitSignal *&wait_signal : wait_signals)
+        {
+            TearDownObject(wait_signal, App_SharedWaitSignal_Destroy);
+        }
+        wait_signals.clear();
+    }
+
+    // Add a signal to the engine, along with a standalone signal used as a
+    // reference for how the signal in the engine should behave
+    void AddSignal(size_t index, struct SignalCallback callback)
+    {
+        callback.function = signal_functions[index].engine_callback;
+        App_SharedSignalEngine_AddSignal(
+            signal_engine, signal_functions[index].is_entry_high,
+            signal_functions[index].is_exit_high, callback);
+
+        callback.function = signal_functions[index].reference_callback;
+        signals.push_back(App_SharedSignal_Create(
+            start_ms, signal_functions[index].is_entry_high,
+            signal_functions[index].is_exit_high, world, callback));
+    }
+
+    void AddWaitSignal(size_t index, struct WaitSignalCallback callback)
+    {
+        callback.function = signal_functions[index].engine_callback;
+        App_SharedSignalEngine_AddWaitSignal(
+            signal_engine, signal_functions[index].is_entry_high, callback);
+
+        callback.function = signal_functions[index].reference_callback;
+        wait_signals.push_back(App_SharedWaitSignal_Create(
+            start_ms, signal_functions[index].is_entry_high, world, callback));
+    }
+
+    const uint32_t                   start_ms = 1000;
+    struct TestWorld *               world    = nullptr;
+    struct SignalEngine *            signal_engine;
+    std::vector<struct Signal *>     signals;
+    std::vector<struct WaitSignal *> wait_signals;
+};
+
+TEST_F(SharedSignalEngineTest, signals_behave_like_standalone_signals)
+{
+    std::mt19937                            rng(1234);
+    std::uniform_int_distribution<uint32_t> duration_distribution(0, 300);
+    std::bernoulli_distribution             toggle_distribution(0.01);
+
+    for (size_t i = 0; i < NUM_SIGNALS; i++)
+    {
+        AddSignal(
+            i, { duration_distribution(rng), duration_distribution(rng),
+                 nullptr });
+    }
+
+    // Skip a few milliseconds now and then to make sure late ticks still
+    // reach every deadline, including ones more than a revolution away
+    uint32_t current_ms = start_ms;
+    for (uint32_t tick = 0; tick < 20000; tick++)
+    {
+        current_ms += (tick % 1000 == 999) ? 500 : 1;
+
+        for (size_t i = 0; i < NUM_SIGNALS; i++)
+        {
+            if (toggle_distribution(rng))
+            {
+                entry_conditions[i] = !entry_conditions[i];
+            }
+            if (toggle_distribution(rng))
+            {
+                exit_conditions[i] = !exit_conditions[i];
+            }
+        }
+
+        App_SharedSignalEngine_Tick(signal_engine, current_ms);
+        for (struct Signal *signal : signals)
+        {
+            App_SharedSignal_Update(signal, current_ms);
+        }
+
+        for (size_t i = 0; i < NUM_SIGNALS; i++)
+        {
+            ASSERT_EQ(
+                App_SharedSignal_IsCallbackTriggered(signals[i]),
+                App_SharedSignalEngine_IsCallbackTriggered(
+                    signal_engine, (uint32_t)i))
+                << "signal " << i << " at " << current_ms << "ms";
+            ASSERT_EQ(reference_callback_counts[i], engine_callback_counts[i])
+                << "signal " << i << " at " << current_ms << "ms";
+        }
+    }
+}
+
+TEST_F(SharedSignalEngineTest, wait_signals_behave_like_standalone_wait_signals)
+{
+    std::mt19937                            rng(5678);
+    std::uniform_int_distribution<uint32_t> duration_distribution(1, 300);
+    std::bernoulli_distribution             toggle_distribution(0.02);
+
+    for (size_t i = 0; i < NUM_SIGNALS; i++)
+    {
+        AddWaitSignal(i, { duration_distribution(rng), nullptr });
+    }
+
+    uint32_t current_ms = start_ms;
+    for (uint32_t tick = 0; tick < 20000; tick++)
+    {
+        current_ms++;
+
+        for (size_t i = 0; i < NUM_SIGNALS; i++)
+        {
+            if (toggle_distribution(rng))
+            {
+                entry_conditions[i] = !entry_conditions[i];
+            }
+        }
+
+        App_SharedSignalEngine_Tick(signal_engine, current_ms);
+        for (struct WaitSignal *wait_signal : wait_signals)
+        {
+            App_SharedWaitSignal_Update(wait_signal, current_ms);
+        }
+
+        for (size_t i = 0; i < NUM_SIGNALS; i++)
+        {
+            ASSERT_EQ(
+                App_SharedWaitSignal_IsWaiting(wait_signals[i]),
+                App_SharedSignalEngine_IsWaiting(signal_engine, (uint32_t)i))
+                << "wait signal " << i << " at " << current_ms << "ms";
+            ASSERT_EQ(reference_callback_counts[i], engine_callback_counts[i])
+                << "wait signal " << i << " at " << current_ms << "ms";
+        }
+    }
+}
+
+TEST_F(SharedSignalEngineTest, signals_and_wait_signals_can_share_an_engine)
+{
+    AddSignal(0, { 10, 10, nullptr });
+    AddWaitSignal(1, { 10, nullptr });
+    ASSERT_EQ(2, App_SharedSignalEngine_GetNumSignals(signal_engine));
+
+    entry_conditions[0] = true;
+    entry_conditions[1] = true;
+
+    uint32_t current_ms = start_ms;
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        App_SharedSignalEngine_Tick(signal_engine, ++current_ms);
+    }
+
+    ASSERT_TRUE(App_SharedSignalEngine_IsCallbackTriggered(signal_engine, 0));
+    ASSERT_EQ(1, engine_callback_counts[0]);
+    ASSERT_FALSE(App_SharedSignalEngine_IsWaiting(signal_engine, 1));
+    ASSERT_EQ(1, engine_callback_counts[1]);
+}
+
+TEST(SignalEngineBenchmarkTest, benchmark_measures_cost_per_tick)
+{
+    struct SignalEngineBenchmarkResults results;
+    Io_SharedSignalEngineBenchmark_Run(100U, &results);
+
+    // On x86 the cost is in nanoseconds per tick, which isn't meaningful for
+    // the boards. Build the benchmark into the Arm binaries with
+    // SIGNAL_ENGINE_BENCHMARK to measure it in cycles per tick.
+    ASSERT_GE(results.idle_signals, 0.0f);
+    ASSERT_GE(results.active_signals, 0.0f);
+    ASSERT_GE(results.active_wait_signals, 0.0f);
+}
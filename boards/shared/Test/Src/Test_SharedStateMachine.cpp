@@ -18,6 +18,7 @@ FAKE_VOID_FUNC(state_B_tick_1kHz, struct StateMachine *);
 FAKE_VOID_FUNC(state_B_exit, struct StateMachine *);
 FAKE_VOID_FUNC(state_C_entry, struct StateMachine *);
 FAKE_VOID_FUNC(state_C_exit, struct StateMachine *);
+FAKE_VALUE_FUNC(uint32_t, get_cycle_count);
 
 static struct State state_A;
 static struct State state_B;
@@ -54,6 +55,7 @@ class SharedStateMachineTest : public testing::Test
         RESET_FAKE(state_B_tick_1Hz);
         RESET_FAKE(state_B_tick_1kHz);
         RESET_FAKE(state_B_exit);
+        RESET_FAKE(get_cycle_count);
     }
 
     void TearDown() override
@@ -72,6 +74,15 @@ class SharedStateMachineTest : public testing::Test
             App_SharedStateMachine_GetCurrentState(state_machine));
     }
 
+    // The cycle counter is read before and after every tick, and the n-th tick
+    // takes n cycles
+    static uint32_t GetFakeCycleCount(void)
+    {
+        const uint32_t tick        = (get_cycle_count_fake.call_count - 1) / 2;
+        const bool     is_tick_end = get_cycle_count_fake.call_count % 2 == 0;
+        return 100 * tick + (is_tick_end ? tick + 1 : 0);
+    }
+
     // We provide our own implementation of the 1hz tick for state_A
     // here so that we can simulate a state transition in a tick
     static void state_A_tick_1Hz(struct StateMachine *state_machine)
@@ -111,3 +122,146 @@ TEST_F(SharedStateMachineTest, check_that_null_tick_functions_dont_deadlock)
     App_SharedStateMachine_Tick1Hz(state_machine);
     App_SharedStateMachine_Tick1Hz(state_machine);
 }
+
+TEST_F(SharedStateMachineTest, check_that_state_transitions_are_traced)
+{
+    SetInitialState(&state_A);
+
+    struct StateTransition transition;
+    ASSERT_EQ(0, App_SharedStateMachine_GetNumTransitions(state_machine));
+    ASSERT_EQ(
+        EXIT_CODE_OUT_OF_RANGE,
+        App_SharedStateMachine_GetTransition(state_machine, 0, &transition));
+
+    App_SharedStateMachine_Tick100Hz(state_machine);
+    App_SharedStateMachine_Tick1Hz(state_machine);
+
+    ASSERT_EQ(1, App_SharedStateMachine_GetNumTransitions(state_machine));
+    ASSERT_EQ(
+        EXIT_CODE_OK,
+        App_SharedStateMachine_GetTransition(state_machine, 0, &transition));
+    ASSERT_EQ(&state_A, transition.previous_state);
+    ASSERT_EQ(&state_B, transition.next_state);
+    ASSERT_EQ(STATE_MACHINE_TICK_1HZ, transition.tick_rate);
+    ASSERT_EQ(1, transition.tick_count);
+    ASSERT_EQ(
+        EXIT_CODE_OUT_OF_RANGE,
+        App_SharedStateMachine_GetTransition(state_machine, 1, &transition));
+}
+
+TEST_F(
+    SharedStateMachineTest,
+    check_that_transition_trace_only_keeps_most_recent_transitions)
+{
+    const uint32_t num_transitions = 2 * STATE_MACHINE_TRANSITION_TRACE_SIZE;
+
+    for (uint32_t i = 0; i < num_transitions; i++)
+    {
+        // Each state_A 1Hz tick transitions to state_B, so we go back to
+        // state_A in between ticks
+        App_SharedStateMachine_SetNextState(state_machine, &state_A);
+        App_SharedStateMachine_Tick100Hz(state_machine);
+        App_SharedStateMachine_Tick1Hz(state_machine);
+    }
+
+    // The first transition was state_A -> state_A, which is not a transition
+    ASSERT_EQ(
+        2 * num_transitions - 1,
+        App_SharedStateMachine_GetNumTransitions(state_machine));
+
+    struct StateTransition transition;
+    for (uint32_t i = 0; i < STATE_MACHINE_TRANSITION_TRACE_SIZE; i++)
+    {
+        ASSERT_EQ(
+            EXIT_CODE_OK, App_SharedStateMachine_GetTransition(
+                              state_machine, i, &transition));
+        if (i % 2 == 0)
+        {
+            ASSERT_EQ(&state_B, transition.next_state);
+            ASSERT_EQ(STATE_MACHINE_TICK_1HZ, transition.tick_rate);
+            ASSERT_EQ(num_transitions - i / 2, transition.tick_count);
+        }
+        else
+        {
+            ASSERT_EQ(&state_A, transition.next_state);
+            ASSERT_EQ(STATE_MACHINE_TICK_100HZ, transition.tick_rate);
+        }
+    }
+    ASSERT_EQ(
+        EXIT_CODE_OUT_OF_RANGE,
+        App_SharedStateMachine_GetTransition(
+            state_machine, STATE_MACHINE_TRANSITION_TRACE_SIZE, &transition));
+}
+
+TEST_F(SharedStateMachineTest, check_that_tick_durations_are_recorded_per_state)
+{
+    SetInitialState(&state_B);
+    App_SharedStateMachine_SetCycleCounter(state_machine, get_cycle_count);
+
+    struct StateTickStatistics statistics_100Hz;
+    struct StateTickStatistics statistics_1Hz;
+    ASSERT_EQ(
+        EXIT_CODE_INVALID_ARGS,
+        App_SharedStateMachine_GetTickStatistics(
+            state_machine, &state_A, STATE_MACHINE_TICK_100HZ,
+            &statistics_100Hz));
+
+    get_cycle_count_fake.custom_fake = GetFakeCycleCount;
+
+    const uint32_t num_ticks = 10;
+    for (uint32_t i = 0; i < num_ticks; i++)
+    {
+        App_SharedStateMachine_Tick100Hz(state_machine);
+    }
+    App_SharedStateMachine_Tick1Hz(state_machine);
+
+    ASSERT_EQ(
+        EXIT_CODE_OK, App_SharedStateMachine_GetTickStatistics(
+                          state_machine, &state_B, STATE_MACHINE_TICK_100HZ,
+                          &statistics_100Hz));
+    ASSERT_EQ(
+        EXIT_CODE_OK,
+        App_SharedStateMachine_GetTickStatistics(
+            state_machine, &state_B, STATE_MACHINE_TICK_1HZ, &statistics_1Hz));
+    ASSERT_EQ(num_ticks, statistics_100Hz.num_samples);
+    ASSERT_EQ(1, statistics_1Hz.num_samples);
+
+    ASSERT_EQ(1, statistics_100Hz.min_duration);
+    ASSERT_EQ(num_ticks, statistics_100Hz.max_duration);
+    ASSERT_EQ(5, App_SharedStateMachine_GetMeanTickDuration(&statistics_100Hz));
+    ASSERT_EQ(num_ticks + 1, statistics_1Hz.min_duration);
+    ASSERT_EQ(num_ticks + 1, statistics_1Hz.max_duration);
+
+    // Durations are binned by their most significant bit: 1 | 2-3 | 4-7 | 8-15
+    ASSERT_EQ(1, statistics_100Hz.histogram[0]);
+    ASSERT_EQ(2, statistics_100Hz.histogram[1]);
+    ASSERT_EQ(4, statistics_100Hz.histogram[2]);
+    ASSERT_EQ(3, statistics_100Hz.histogram[3]);
+
+    // State C has no tick functions, so its tick durations are never recorded
+    SetInitialState(&state_C);
+    App_SharedStateMachine_SetCycleCounter(state_machine, get_cycle_count);
+    App_SharedStateMachine_Tick100Hz(state_machine);
+    ASSERT_EQ(
+        EXIT_CODE_INVALID_ARGS,
+        App_SharedStateMachine_GetTickStatistics(
+            state_machine, &state_C, STATE_MACHINE_TICK_100HZ,
+            &statistics_100Hz));
+}
+
+TEST_F(
+    SharedStateMachineTest,
+    check_that_tick_durations_are_not_recorded_without_a_cycle_counter)
+{
+    SetInitialState(&state_B);
+
+    App_SharedStateMachine_Tick100Hz(state_machine);
+    App_SharedStateMachine_Tick1Hz(state_machine);
+
+    struct StateTickStatistics statistics;
+    ASSERT_EQ(
+        EXIT_CODE_INVALID_ARGS,
+        App_SharedStateMachine_GetTickStatistics(
+            state_machine, &state_B, STATE_MACHINE_TICK_100HZ, &statistics));
+    ASSERT_EQ(0, get_cycle_count_fake.call_count);
+}
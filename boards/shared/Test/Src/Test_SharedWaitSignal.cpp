@@ -1,9 +1,5 @@
 #include "Test_Shared.h"
-
-extern "C"
-{
-#include "App_SharedWaitSignal.h"
-}
+#include "Test_SharedReferenceWaitSignal.h"
 
 FAKE_VALUE_FUNC(bool, is_wait_high, struct World *);
 FAKE_VOID_FUNC(wait_callback_function, struct World *);
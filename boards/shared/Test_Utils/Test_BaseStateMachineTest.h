@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdio>
 #include <gtest/gtest.h>
 
 extern "C"
@@ -66,5 +67,16 @@ class BaseStateMachineTest : public testing::Test
             UpdateClock(state_machine, ++current_time_ms);
         }
     }
+
+    // Print the state machine's recent transitions and tick durations if the
+    // test has failed, to show how it got to the state it failed in
+    void DumpTraceIfFailed(const struct StateMachine *state_machine)
+    {
+        if (HasFailure() && state_machine != NULL)
+        {
+            App_SharedStateMachine_DumpTrace(state_machine, stdout);
+        }
+    }
+
     uint32_t current_time_ms;
 };